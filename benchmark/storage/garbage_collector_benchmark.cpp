@@ -11,9 +11,9 @@ namespace terrier {
 class GarbageCollectorBenchmark : public benchmark::Fixture {
  public:
   void StartGC(transaction::TimestampManager *const timestamp_manager,
-               transaction::TransactionManager *const txn_manager) {
+               transaction::TransactionManager *const txn_manager, const uint32_t num_gc_threads) {
     gc_ = new storage::GarbageCollector(common::ManagedPointer(timestamp_manager), DISABLED,
-                                        common::ManagedPointer(txn_manager), DISABLED);
+                                        common::ManagedPointer(txn_manager), DISABLED, num_gc_threads);
     run_gc_ = true;
     gc_thread_ = std::thread([this] { GCThreadLoop(); });
   }
@@ -51,8 +51,8 @@ class GarbageCollectorBenchmark : public benchmark::Fixture {
   }
 };
 
-// Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC and profile how long
-// the unlinking stage takes for those txns
+// Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC with the given
+// number of threads and profile how long the unlinking stage takes for those txns
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &state) {
   // NOLINTNEXTLINE
@@ -61,7 +61,8 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &stat
     LargeDataTableBenchmarkObject tested({8, 8, 8}, initial_table_size_, txn_length_, update_select_ratio_,
                                          &block_store_, &buffer_pool_, &generator_, true);
     gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()), DISABLED,
-                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED);
+                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED,
+                                        static_cast<uint32_t>(state.range(0)));
 
     // clean up insert txn
     gc_->PerformGarbageCollection();
@@ -91,8 +92,8 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &stat
   state.SetItemsProcessed(state.iterations() * num_txns_);
 }
 
-// Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC and profile how long
-// the deallocation stage takes for those txns
+// Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC with the given
+// number of threads and profile how long the deallocation stage takes for those txns
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ReclaimTime)(benchmark::State &state) {
   // NOLINTNEXTLINE
@@ -101,7 +102,8 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ReclaimTime)(benchmark::State &sta
     LargeDataTableBenchmarkObject tested({8, 8, 8}, initial_table_size_, txn_length_, update_select_ratio_,
                                          &block_store_, &buffer_pool_, &generator_, true);
     gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()), DISABLED,
-                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED);
+                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED,
+                                        static_cast<uint32_t>(state.range(0)));
 
     // clean up insert txn
     gc_->PerformGarbageCollection();
@@ -131,9 +133,9 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ReclaimTime)(benchmark::State &sta
 }
 
 /**
- * Run a large number of updates on a small table to generate contention with the GC. Measure the number of transactions
- * that the GC managed to free during the workload by subtracting the number of "lagging" transactions that still
- * remained to be cleaned up by the GC after the workload was done running.
+ * Run a large number of updates on a small table to generate contention with the GC, which runs with the given number
+ * of threads. Measure the number of transactions that the GC managed to free during the workload by subtracting the
+ * number of "lagging" transactions that still remained to be cleaned up by the GC after the workload was done running.
  */
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &state) {
@@ -142,7 +144,7 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &
   for (auto _ : state) {
     LargeDataTableBenchmarkObject tested({8, 8, 8}, 100, txn_length_, update_select_ratio_, &block_store_,
                                          &buffer_pool_, &generator_, true);
-    StartGC(tested.GetTimestampManager(), tested.GetTxnManager());
+    StartGC(tested.GetTimestampManager(), tested.GetTxnManager(), static_cast<uint32_t>(state.range(0)));
     uint64_t elapsed_ms;
     {
       common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
@@ -154,13 +156,23 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &
   state.SetItemsProcessed(state.iterations() * num_txns_ - lag_count);
 }
 
-BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, UnlinkTime)->Unit(benchmark::kMillisecond)->UseManualTime()->MinTime(1);
+// The argument is the number of GC threads
+BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, UnlinkTime)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(1)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
-    ->MinTime(1);
+    ->MinTime(1)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, HighContention)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
-    ->MinTime(2);
+    ->MinTime(2)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
 }  // namespace terrier
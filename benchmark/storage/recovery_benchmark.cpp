@@ -71,7 +71,8 @@ class RecoveryBenchmark : public benchmark::Fixture {
       storage::DiskLogProvider log_provider(terrier::BenchmarkConfig::logfile_path.data());
       storage::RecoveryManager recovery_manager(
           common::ManagedPointer<storage::AbstractLogProvider>(&log_provider), recovery_catalog, recovery_txn_manager,
-          recovery_deferred_action_manager, recovery_thread_registry, recovery_block_store);
+          recovery_deferred_action_manager, recovery_thread_registry, recovery_block_store,
+          BenchmarkConfig::num_threads);
 
       uint64_t elapsed_ms;
       {
@@ -222,7 +223,8 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, IndexRecovery)(benchmark::State &state) {
     storage::DiskLogProvider log_provider(terrier::BenchmarkConfig::logfile_path.data());
     storage::RecoveryManager recovery_manager(common::ManagedPointer<storage::AbstractLogProvider>(&log_provider),
                                               recovery_catalog, recovery_txn_manager, recovery_deferred_action_manager,
-                                              recovery_thread_registry, recovery_block_store);
+                                              recovery_thread_registry, recovery_block_store,
+                                              BenchmarkConfig::num_threads);
 
     uint64_t elapsed_ms;
     {
@@ -0,0 +1,80 @@
+// Perform using hash join, with a runtime filter on the probe side:
+//
+// SELECT t1.col_a, t1'.col_a FROM test_1 AS t1, test_1 AS t1'
+// WHERE t1.col_a = t1'.col_a AND t1.col_a < 500
+//
+// Should output 500 (number of matches)
+
+struct State {
+  table: JoinHashTable
+  num_matches: int64
+}
+
+struct BuildRow {
+  key: Integer
+}
+
+fun setUpState(execCtx: *ExecutionContext, state: *State) -> nil {
+  @joinHTInit(&state.table, @execCtxGetMem(execCtx), @sizeOf(BuildRow))
+  state.num_matches = 0
+}
+
+fun tearDownState(state: *State) -> nil {
+  @joinHTFree(&state.table)
+}
+
+fun checkKey(execCtx: *ExecutionContext, vec: *ProjectedColumnsIterator, tuple: *BuildRow) -> bool {
+  return @pciGetInt(vec, 0) == tuple.key
+}
+
+fun pipeline_1(execCtx: *ExecutionContext, state: *State) -> nil {
+  var jht: *JoinHashTable = &state.table
+  var tvi: TableVectorIterator
+  var col_oids : [1]uint32
+  col_oids[0] = 1
+  @tableIterInitBind(&tvi, execCtx, "test_1", col_oids)
+  for (@tableIterAdvance(&tvi)) {
+    var vec = @tableIterGetPCI(&tvi)
+    for (; @pciHasNext(vec); @pciAdvance(vec)) {
+      var key = @pciGetInt(vec, 0)
+      if (key < 500) {
+        var elem : *BuildRow = @ptrCast(*BuildRow, @joinHTInsert(jht, @hash(key)))
+        elem.key = key
+        @joinHTAddFilterKey(jht, key)
+      }
+    }
+  }
+  @tableIterClose(&tvi)
+}
+
+fun pipeline_2(execCtx: *ExecutionContext, state: *State) -> nil {
+  var tvi: TableVectorIterator
+  var col_oids : [1]uint32
+  col_oids[0] = 1
+  @tableIterInitBind(&tvi, execCtx, "test_1", col_oids)
+  for (@tableIterAdvance(&tvi)) {
+    var vec = @tableIterGetPCI(&tvi)
+    // Only probe the tuples that can find a match
+    @filterJoin(vec, 0, 4, &state.table)
+    for (; @pciHasNextFiltered(vec); @pciAdvanceFiltered(vec)) {
+      var hash_val = @hash(@pciGetInt(vec, 0))
+      var hti: JoinHashTableIterator
+      for (@joinHTIterInit(&hti, &state.table, hash_val); @joinHTIterHasNext(&hti, checkKey, execCtx, vec); ) {
+        state.num_matches = state.num_matches + 1
+      }
+      @joinHTIterClose(&hti)
+    }
+  }
+  @tableIterClose(&tvi)
+}
+
+fun main(execCtx: *ExecutionContext) -> int64 {
+  var state: State
+  setUpState(execCtx, &state)
+  pipeline_1(execCtx, &state)
+  @joinHTBuild(&state.table)
+  pipeline_2(execCtx, &state)
+  var ret = state.num_matches
+  tearDownState(&state)
+  return ret
+}
@@ -88,7 +88,9 @@ fun main(execCtx: *ExecutionContext) -> int {
   @tlsReset(&tls, @sizeOf(ThreadState_1), _1_pipelineWorker_InitThreadState, _1_pipelineWorker_TearDownThreadState, execCtx)
 
   // Parallel scan
- @iterateTableParallel("test_1", &state, &tls, _1_pipelineWorker)
+  var col_oids: [1]uint32
+  col_oids[0] = 1 // colA
+  @iterateTableParallel("test_1", col_oids, &state, execCtx, &tls, _1_pipelineWorker)
 
   // ---- Pipeline 1 End ---- //
   var off: uint32 = 0
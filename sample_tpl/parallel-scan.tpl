@@ -59,7 +59,10 @@ fun main(execCtx: *ExecutionContext) -> int {
   @tlsReset(&tls, @sizeOf(ThreadState_1), _1_pipelineWorker_InitThreadState, _1_pipelineWorker_TearDownThreadState, execCtx)
 
   // Now scan
-  @iterateTableParallel("test_1", &state, &tls, _1_pipelineWorker)
+  var state: State
+  var col_oids: [1]uint32
+  col_oids[0] = 1 // colA
+  @iterateTableParallel("test_1", col_oids, &state, execCtx, &tls, _1_pipelineWorker)
 
   // Pipeline 2
 
@@ -0,0 +1,25 @@
+fun main() -> int64 {
+  var str = @stringToSql("The quick brown fox")
+
+  if (!(@sqlToBool(@like(str, @stringToSql("The%"))))) {
+    return 1
+  }
+
+  if (!(@sqlToBool(@like(str, @stringToSql("%quick%fox"))))) {
+    return 2
+  }
+
+  if (@sqlToBool(@like(str, @stringToSql("%QUICK%")))) {
+    return 3
+  }
+
+  if (!(@sqlToBool(@ilike(str, @stringToSql("%QUICK%"))))) {
+    return 4
+  }
+
+  if (!(@sqlToBool(@like(str, @stringToSql("The _uick%"))))) {
+    return 5
+  }
+
+  return 0
+}
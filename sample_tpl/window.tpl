@@ -0,0 +1,202 @@
+// Evaluate window functions over 1000 rows, windowed by
+//
+// PARTITION BY part ORDER BY ord
+//
+// There are 10 partitions of 100 rows, and every value of ord appears twice in each partition, so every row has one
+// peer. Checks ROW_NUMBER(), RANK() and DENSE_RANK(), the running SUM(val) of the default frame, SUM(val) and MAX(val)
+// over ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING, and COUNT(val) and AVG(val) over the whole partition.
+//
+// Should return 1000 (number of rows whose window functions are correct).
+
+struct State {
+  sorter: Sorter
+  window: WindowOperator
+}
+
+struct Row {
+  part: uint64
+  ord: uint64
+  val: Integer
+}
+
+fun comparePartition(lhs: *Row, rhs: *Row) -> int32 {
+  if (lhs.part < rhs.part) {
+    return -1
+  }
+  if (lhs.part > rhs.part) {
+    return 1
+  }
+  return 0
+}
+
+fun comparePeer(lhs: *Row, rhs: *Row) -> int32 {
+  var cmp = comparePartition(lhs, rhs)
+  if (cmp != 0) {
+    return cmp
+  }
+  if (lhs.ord < rhs.ord) {
+    return -1
+  }
+  if (lhs.ord > rhs.ord) {
+    return 1
+  }
+  return 0
+}
+
+fun setUpState(execCtx: *ExecutionContext, state: *State) -> nil {
+  @sorterInit(&state.sorter, @execCtxGetMem(execCtx), comparePeer, @sizeOf(Row))
+}
+
+fun tearDownState(state: *State) -> nil {
+  @windowFree(&state.window)
+  @sorterFree(&state.sorter)
+}
+
+fun pipeline_1(state: *State) -> nil {
+  for (var i : uint64 = 0; i < 1000; i = i + 1) {
+    var row = @ptrCast(*Row, @sorterInsert(&state.sorter))
+    row.part = i % 10
+    row.ord = (i / 10) % 50
+    row.val = @intToSql(row.ord)
+  }
+}
+
+fun pipeline_2(state: *State) -> int32 {
+  var ret = 0
+  var num_partitions = 0
+
+  // RANGE BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW
+  var running: WindowFrame
+  @windowFrameInit(&running, 1, 0, 0, 2, 0)
+  // ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING
+  var sliding: WindowFrame
+  @windowFrameInit(&sliding, 0, 1, 1, 3, 1)
+  // ROWS BETWEEN UNBOUNDED PRECEDING AND UNBOUNDED FOLLOWING
+  var whole: WindowFrame
+  @windowFrameInit(&whole, 0, 0, 0, 4, 0)
+
+  var tree: IntegerSumWindowTree
+  @windowTreeInit(&tree)
+  var sum: IntegerSumAggregate
+  @aggInit(&sum)
+  var max_tree: IntegerMaxWindowTree
+  @windowTreeInit(&max_tree)
+  var max: IntegerMaxAggregate
+  @aggInit(&max)
+  var count_tree: CountWindowTree
+  @windowTreeInit(&count_tree)
+  var count: CountAggregate
+  @aggInit(&count)
+  var avg_tree: IntegerAvgWindowTree
+  @windowTreeInit(&avg_tree)
+  var avg: IntegerAvgAggregate
+  @aggInit(&avg)
+
+  var iter: WindowIterator
+  for (@windowIterInit(&iter, &state.window); @windowIterHasNext(&iter); @windowIterNext(&iter)) {
+    var row = @ptrCast(*Row, @windowIterGetRow(&iter))
+    if (@windowIterIsPartitionStart(&iter)) {
+      @windowTreeBuild(&tree, &iter, @offsetOf(Row, val))
+      @windowTreeBuild(&max_tree, &iter, @offsetOf(Row, val))
+      @windowTreeBuild(&count_tree, &iter, @offsetOf(Row, val))
+      @windowTreeBuild(&avg_tree, &iter, @offsetOf(Row, val))
+      num_partitions = num_partitions + 1
+    }
+    var correct = true
+
+    // Ranking functions
+    var pos = @windowIterGetRowNumber(&iter) - 1
+    if (pos / 2 != row.ord or @windowIterGetRank(&iter) != 2 * row.ord + 1) {
+      correct = false
+    }
+    if (@windowIterGetDenseRank(&iter) != row.ord + 1) {
+      correct = false
+    }
+
+    // The running sum covers the row's peer and all rows before them
+    var begin = @windowIterGetFrameBegin(&iter, &running)
+    var end = @windowIterGetFrameEnd(&iter, &running)
+    if (begin != 0 or end != 2 * row.ord + 2) {
+      correct = false
+    }
+    @windowTreeQuery(&tree, begin, end, &sum)
+    if (@aggResult(&sum) != @intToSql(row.ord * (row.ord + 1))) {
+      correct = false
+    }
+
+    // The sliding sum covers at most one row on either side
+    var expected_begin = pos
+    if (pos > 0) {
+      expected_begin = pos - 1
+    }
+    var expected_end = pos + 2
+    if (pos == 99) {
+      expected_end = pos + 1
+    }
+    begin = @windowIterGetFrameBegin(&iter, &sliding)
+    end = @windowIterGetFrameEnd(&iter, &sliding)
+    if (begin != expected_begin or end != expected_end) {
+      correct = false
+    }
+    var expected : uint64 = 0
+    for (var j = begin; j < end; j = j + 1) {
+      expected = expected + j / 2
+    }
+    @windowTreeQuery(&tree, begin, end, &sum)
+    if (@aggResult(&sum) != @intToSql(expected)) {
+      correct = false
+    }
+    @windowTreeQuery(&max_tree, begin, end, &max)
+    if (@aggResult(&max) != @intToSql((end - 1) / 2)) {
+      correct = false
+    }
+
+    // Every value of ord appears twice in the whole partition
+    begin = @windowIterGetFrameBegin(&iter, &whole)
+    end = @windowIterGetFrameEnd(&iter, &whole)
+    @windowTreeQuery(&count_tree, begin, end, &count)
+    if (@aggResult(&count) != @intToSql(100)) {
+      correct = false
+    }
+    @windowTreeQuery(&avg_tree, begin, end, &avg)
+    if (@aggResult(&avg) != @floatToSql(24.5)) {
+      correct = false
+    }
+
+    if (correct) {
+      ret = ret + 1
+    }
+  }
+  @windowIterClose(&iter)
+  @windowTreeFree(&tree)
+  @windowTreeFree(&max_tree)
+  @windowTreeFree(&count_tree)
+  @windowTreeFree(&avg_tree)
+
+  if (num_partitions != 10) {
+    return -1
+  }
+  return ret
+}
+
+fun main(execCtx: *ExecutionContext) -> int32 {
+  var state: State
+
+  // Initialize
+  setUpState(execCtx, &state)
+
+  // Pipeline 1
+  pipeline_1(&state)
+
+  // Pipeline 1 end
+  @sorterSort(&state.sorter)
+  @windowInit(&state.window, &state.sorter, comparePartition, comparePeer)
+
+  // Pipeline 2
+  var ret = pipeline_2(&state)
+
+  // Cleanup
+  tearDownState(&state)
+
+  return ret
+}
@@ -26,12 +26,14 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/plan_visitor.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "type/type_id.h"
 
 namespace terrier::brain {
@@ -181,6 +183,7 @@ void OperatingUnitRecorder::VisitAbstractScanPlanNode(const planner::AbstractSca
 
 void OperatingUnitRecorder::VisitAbstractJoinPlanNode(const planner::AbstractJoinPlanNode *plan) {
   if (plan_feature_ == ExecutionOperatingUnitType::HASHJOIN_PROBE ||
+      plan_feature_ == ExecutionOperatingUnitType::MERGEJOIN_PROBE ||
       plan_feature_ == ExecutionOperatingUnitType::NLJOIN_RIGHT ||
       plan_feature_ == ExecutionOperatingUnitType::IDXJOIN) {
     // Right side stiches together outputs
@@ -267,6 +270,26 @@ void OperatingUnitRecorder::Visit(const planner::HashJoinPlanNode *plan) {
   }
 }
 
+void OperatingUnitRecorder::Visit(const planner::MergeJoinPlanNode *plan) {
+  VisitAbstractJoinPlanNode(plan);
+
+  if (plan_feature_ == ExecutionOperatingUnitType::MERGEJOIN_BUILD) {
+    for (auto key : plan->GetLeftMergeKeys()) {
+      auto features = ExtractFeaturesFromExpression(key);
+      plan_features_.insert(plan_features_.end(), std::make_move_iterator(features.begin()),
+                            std::make_move_iterator(features.end()));
+    }
+  }
+
+  if (plan_feature_ == ExecutionOperatingUnitType::MERGEJOIN_PROBE) {
+    for (auto key : plan->GetRightMergeKeys()) {
+      auto features = ExtractFeaturesFromExpression(key);
+      plan_features_.insert(plan_features_.end(), std::make_move_iterator(features.begin()),
+                            std::make_move_iterator(features.end()));
+    }
+  }
+}
+
 void OperatingUnitRecorder::Visit(const planner::NestedLoopJoinPlanNode *plan) {
   // Execution Engine does not utilize LeftKeys()/RightKeys().
   // Instead the exec engine relies on the join predicate directly.
@@ -317,6 +340,31 @@ void OperatingUnitRecorder::Visit(const planner::AggregatePlanNode *plan) {
   }
 }
 
+void OperatingUnitRecorder::Visit(const planner::WindowPlanNode *plan) {
+  if (plan_feature_ == ExecutionOperatingUnitType::SORT_BUILD) {
+    // SORT_BUILD will operate on the partitioning terms and sort keys
+    for (auto term : plan->GetPartitionByTerms()) {
+      auto features = ExtractFeaturesFromExpression(term);
+      plan_features_.insert(plan_features_.end(), std::make_move_iterator(features.begin()),
+                            std::make_move_iterator(features.end()));
+    }
+
+    for (auto key : plan->GetSortKeys()) {
+      auto features = ExtractFeaturesFromExpression(key.first);
+      plan_features_.insert(plan_features_.end(), std::make_move_iterator(features.begin()),
+                            std::make_move_iterator(features.end()));
+    }
+  } else if (plan_feature_ == ExecutionOperatingUnitType::SORT_ITERATE) {
+    // SORT_ITERATE will compute the window aggregates and do any output computations
+    for (const auto &function : plan->GetWindowFunctions()) {
+      auto features = ExtractFeaturesFromExpression(function.aggregate_);
+      plan_features_.insert(plan_features_.end(), std::make_move_iterator(features.begin()),
+                            std::make_move_iterator(features.end()));
+    }
+    VisitAbstractPlanNode(plan);
+  }
+}
+
 ExecutionOperatingUnitFeatureVector OperatingUnitRecorder::RecordTranslators(
     const std::vector<std::unique_ptr<execution::compiler::OperatorTranslator>> &translators) {
   // Note that OperatorTranslators are roughly 1:1 with a plan node
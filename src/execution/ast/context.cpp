@@ -19,6 +19,7 @@
 #include "execution/ast/type.h"
 #include "execution/sql/aggregation_hash_table.h"
 #include "execution/sql/aggregators.h"
+#include "execution/sql/csv_reader.h"
 #include "execution/sql/filter_manager.h"
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
@@ -27,6 +28,7 @@
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/value.h"
+#include "execution/sql/window_operator.h"
 #include "execution/util/execution_common.h"
 
 namespace terrier::execution::ast {
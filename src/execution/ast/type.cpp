@@ -7,6 +7,7 @@
 #include "execution/exec/execution_context.h"
 #include "execution/sql/aggregation_hash_table.h"
 #include "execution/sql/aggregators.h"
+#include "execution/sql/csv_reader.h"
 #include "execution/sql/filter_manager.h"
 #include "execution/sql/hash_table_entry.h"
 #include "execution/sql/index_iterator.h"
@@ -17,6 +18,7 @@
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/value.h"
+#include "execution/sql/window_operator.h"
 
 namespace terrier::execution::ast {
 
@@ -0,0 +1,60 @@
+#include "execution/compiled_query_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "execution/executable_query.h"
+#include "execution/vm/module.h"
+
+namespace terrier::execution {
+
+std::shared_ptr<ExecutableQuery> CompiledQueryCache::Get(const common::hash_t fingerprint, const std::string &key) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const auto it = entries_.find(fingerprint);
+  // A different plan with the same fingerprint is a miss
+  if (it == entries_.end() || it->second->key_ != key) return nullptr;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->query_;
+}
+
+void CompiledQueryCache::Put(const common::hash_t fingerprint, std::string key, std::shared_ptr<ExecutableQuery> query,
+                             const uint64_t size) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (size > capacity_) return;
+  const auto it = entries_.find(fingerprint);
+  if (it != entries_.end()) {
+    // Another thread compiled the same plan first, or a plan with the same fingerprint is cached. Keep the newer one.
+    size_ -= it->second->size_;
+    lru_.erase(it->second);
+    entries_.erase(it);
+  }
+  lru_.push_front({fingerprint, std::move(key), std::move(query), size});
+  entries_.emplace(fingerprint, lru_.begin());
+  size_ += size;
+  Evict();
+}
+
+void CompiledQueryCache::SetCapacity(const uint64_t capacity) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  capacity_ = capacity;
+  Evict();
+}
+
+void CompiledQueryCache::Clear() {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  entries_.clear();
+  lru_.clear();
+  size_ = 0;
+}
+
+void CompiledQueryCache::Evict() {
+  while (size_ > capacity_) {
+    const Entry &victim = lru_.back();
+    size_ -= victim.size_;
+    entries_.erase(victim.fingerprint_);
+    lru_.pop_back();
+  }
+}
+
+}  // namespace terrier::execution
@@ -11,16 +11,18 @@
 
 namespace terrier::execution::compiler {
 
-CodeGen::CodeGen(exec::ExecutionContext *exec_ctx)
+CodeGen::CodeGen(exec::ExecutionContext *exec_ctx, const ConstantLifter *lifter)
     : region_(std::make_unique<util::Region>("QueryRegion")),
       error_reporter_(region_.get()),
       ast_ctx_(std::make_unique<ast::Context>(region_.get(), &error_reporter_)),
       factory_(region_.get()),
       exec_ctx_(exec_ctx),
+      lifter_(lifter),
       pipeline_operating_units_(std::make_unique<brain::PipelineOperatingUnits>()),
       state_struct_{Context()->GetIdentifier("State")},
       state_var_{Context()->GetIdentifier("state")},
       exec_ctx_var_(Context()->GetIdentifier("execCtx")),
+      thread_state_var_(Context()->GetIdentifier("threadState")),
       main_fn_(Context()->GetIdentifier("main")),
       setup_fn_(Context()->GetIdentifier("setupFn")),
       teardown_fn_(Context()->GetIdentifier("teardownFn")) {}
@@ -65,6 +67,10 @@ ast::Stmt *CodeGen::ExecCall(ast::Identifier fn_name) {
 
 ast::Expr *CodeGen::GetStateMemberPtr(ast::Identifier ident) { return PointerTo(MemberExpr(state_var_, ident)); }
 
+ast::Expr *CodeGen::GetThreadStateMemberPtr(ast::Identifier ident) {
+  return PointerTo(MemberExpr(thread_state_var_, ident));
+}
+
 ast::Identifier CodeGen::NewIdentifier(const std::string &prefix) {
   // TODO(Amadou/Wan): John notes that there could be an extra string allocation and deallocation for the id count.
   //  An explicit string formatting call could avoid this.
@@ -81,6 +87,14 @@ ast::Expr *CodeGen::ZeroArgCall(ast::Builtin builtin) {
   return Factory()->NewBuiltinCallExpr(fun, std::move(args));
 }
 
+ast::Expr *CodeGen::Call(ast::Identifier fn_name, std::vector<ast::Expr *> &&params) {
+  util::RegionVector<ast::Expr *> args{{}, Region()};
+  for (auto &expr : params) {
+    args.emplace_back(expr);
+  }
+  return Factory()->NewCallExpr(MakeExpr(fn_name), std::move(args));
+}
+
 ast::Expr *CodeGen::OneArgCall(ast::Builtin builtin, ast::Expr *arg) {
   ast::Expr *fun = BuiltinFunction(builtin);
   util::RegionVector<ast::Expr *> args{{arg}, Region()};
@@ -217,11 +231,19 @@ ast::Expr *CodeGen::ExecCtxGetMem() {
 
 ast::Expr *CodeGen::SizeOf(ast::Identifier type_name) { return OneArgCall(ast::Builtin::SizeOf, type_name, false); }
 
+ast::Expr *CodeGen::OffsetOf(ast::Identifier type_name, ast::Identifier member) {
+  ast::Expr *fun = BuiltinFunction(ast::Builtin::OffsetOf);
+  util::RegionVector<ast::Expr *> args{{MakeExpr(type_name), MakeExpr(member)}, Region()};
+  return Factory()->NewBuiltinCallExpr(fun, std::move(args));
+}
+
 ast::Expr *CodeGen::HTInitCall(ast::Builtin builtin, ast::Identifier object, ast::Identifier struct_type) {
+  return HTInitCall(builtin, GetStateMemberPtr(object), struct_type);
+}
+
+ast::Expr *CodeGen::HTInitCall(ast::Builtin builtin, ast::Expr *obj_ptr, ast::Identifier struct_type) {
   // Init Function
   ast::Expr *fun = BuiltinFunction(builtin);
-  // The object to initialize
-  ast::Expr *obj_ptr = GetStateMemberPtr(object);
   // Then get @execCtxGetMem(execCtx)
   ast::Expr *get_mem_call = ExecCtxGetMem();
   // Then get @sizeof(Struct)
@@ -460,6 +482,42 @@ ast::Expr *CodeGen::PeekValue(const type::TransientValue &transient_val) {
   }
 }
 
+ast::Expr *CodeGen::GetParam(const type::TypeId type, const uint32_t param_idx) {
+  ast::Builtin builtin;
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      builtin = ast::Builtin::GetParamBool;
+      break;
+    case type::TypeId::TINYINT:
+      builtin = ast::Builtin::GetParamTinyInt;
+      break;
+    case type::TypeId::SMALLINT:
+      builtin = ast::Builtin::GetParamSmallInt;
+      break;
+    case type::TypeId::INTEGER:
+      builtin = ast::Builtin::GetParamInt;
+      break;
+    case type::TypeId::BIGINT:
+      builtin = ast::Builtin::GetParamBigInt;
+      break;
+    case type::TypeId::DECIMAL:
+      builtin = ast::Builtin::GetParamDouble;
+      break;
+    case type::TypeId::DATE:
+      builtin = ast::Builtin::GetParamDate;
+      break;
+    case type::TypeId::TIMESTAMP:
+      builtin = ast::Builtin::GetParamTimestamp;
+      break;
+    case type::TypeId::VARCHAR:
+      builtin = ast::Builtin::GetParamString;
+      break;
+    default:
+      UNREACHABLE("Unsupported parameter type");
+  }
+  return BuiltinCall(builtin, {MakeExpr(exec_ctx_var_), IntLiteral(param_idx)});
+}
+
 ast::Expr *CodeGen::TplType(type::TypeId type) {
   switch (type) {
     case type::TypeId::BOOLEAN:
@@ -538,6 +596,23 @@ ast::Expr *CodeGen::AggregateType(parser::ExpressionType agg_type, type::TypeId
   }
 }
 
+ast::Expr *CodeGen::WindowTreeType(parser::ExpressionType agg_type, type::TypeId ret_type) {
+  switch (agg_type) {
+    case parser::ExpressionType::AGGREGATE_COUNT:
+      return BuiltinType(ast::BuiltinType::Kind::CountWindowTree);
+    case parser::ExpressionType::AGGREGATE_AVG:
+      AGGTYPE(AvgWindowTree, ret_type);
+    case parser::ExpressionType::AGGREGATE_MIN:
+      AGGTYPE(MinWindowTree, ret_type);
+    case parser::ExpressionType::AGGREGATE_MAX:
+      AGGTYPE(MaxWindowTree, ret_type);
+    case parser::ExpressionType::AGGREGATE_SUM:
+      AGGTYPE(SumWindowTree, ret_type);
+    default:
+      UNREACHABLE("WindowTreeType() should only be called with aggregates");
+  }
+}
+
 ast::Stmt *CodeGen::DeclareVariable(ast::Identifier name, ast::Expr *type, ast::Expr *init) {
   ast::Decl *decl = Factory()->NewVariableDecl(DUMMY_POS, name, type, init);
   return Factory()->NewDeclStmt(decl);
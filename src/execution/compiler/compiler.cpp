@@ -66,7 +66,7 @@ ast::File *Compiler::Compile() {
     codegen_->GetPipelineOperatingUnits()->RecordOperatingUnit(pipeline_idx, std::move(features));
 
     // Produce the actual pipeline
-    top_level.emplace_back(pipeline->Produce(query_identifier_, pipeline_idx));
+    pipeline->Produce(query_identifier_, pipeline_idx, &top_level);
   }
 
   // Step 3: Make the main function
@@ -83,7 +83,8 @@ ast::File *Compiler::Compile() {
 void Compiler::MakePipelines(const terrier::planner::AbstractPlanNode &op, Pipeline *curr_pipeline) {
   switch (op.GetPlanNodeType()) {
     case terrier::planner::PlanNodeType::AGGREGATE:
-    case terrier::planner::PlanNodeType::ORDERBY: {
+    case terrier::planner::PlanNodeType::ORDERBY:
+    case terrier::planner::PlanNodeType::WINDOW: {
       // These nodes split in two parts: A "build" side (called bottom) and an "iterate" side (called top).
       auto bottom_translator = TranslatorFactory::CreateBottomTranslator(&op, codegen_);
       auto top_translator = TranslatorFactory::CreateTopTranslator(&op, bottom_translator.get(), codegen_);
@@ -96,8 +97,9 @@ void Compiler::MakePipelines(const terrier::planner::AbstractPlanNode &op, Pipel
       curr_pipeline->Add(std::move(top_translator));
       return;
     }
-    case terrier::planner::PlanNodeType::HASHJOIN: {
-      // The hash join splits also splits in a "build" side (called left) and an "iterate" side (called right).
+    case terrier::planner::PlanNodeType::HASHJOIN:
+    case terrier::planner::PlanNodeType::MERGEJOIN: {
+      // Hash and merge joins also split in a "build" side (called left) and an "iterate" side (called right).
       auto left_translator = TranslatorFactory::CreateLeftTranslator(&op, codegen_);
       auto right_translator = TranslatorFactory::CreateRightTranslator(&op, left_translator.get(), codegen_);
 
@@ -111,6 +113,25 @@ void Compiler::MakePipelines(const terrier::planner::AbstractPlanNode &op, Pipel
       curr_pipeline->Add(std::move(right_translator));
       return;
     }
+    case terrier::planner::PlanNodeType::SETOP: {
+      // Every input of a set operation is a separate "build" pipeline (called bottom). They all fill the same hash
+      // table, which the "iterate" side (called top) then scans.
+      auto first_bottom = TranslatorFactory::CreateBottomTranslator(&op, codegen_);
+      auto top_translator = TranslatorFactory::CreateTopTranslator(&op, first_bottom.get(), codegen_);
+      OperatorTranslator *first = first_bottom.get();
+      for (uint32_t child_idx = 0; child_idx < op.GetChildrenSize(); child_idx++) {
+        auto bottom_translator = child_idx == 0
+                                     ? std::move(first_bottom)
+                                     : TranslatorFactory::CreateSetOpInputTranslator(&op, child_idx, first, codegen_);
+        auto next_pipeline = std::make_unique<Pipeline>(codegen_);
+        MakePipelines(*op.GetChild(child_idx), next_pipeline.get());
+        next_pipeline->Add(std::move(bottom_translator));
+        pipelines_.emplace_back(std::move(next_pipeline));
+      }
+      // The "iterate" side terminates the current pipeline.
+      curr_pipeline->Add(std::move(top_translator));
+      return;
+    }
     case terrier::planner::PlanNodeType::NESTLOOP: {
       // The two sides of the nested loop join belong to the same pipeline. They are just concatenated together.
       // These two translator glue the two sides together and ensure that expression evaluation is correctly done.
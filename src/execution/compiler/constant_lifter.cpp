@@ -0,0 +1,240 @@
+#include "execution/compiler/constant_lifter.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "execution/util/execution_common.h"
+#include "parser/expression/aggregate_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "planner/plannodes/aggregate_plan_node.h"
+#include "planner/plannodes/csv_scan_plan_node.h"
+#include "planner/plannodes/delete_plan_node.h"
+#include "planner/plannodes/hash_join_plan_node.h"
+#include "planner/plannodes/index_join_plan_node.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+#include "planner/plannodes/insert_plan_node.h"
+#include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/nested_loop_join_plan_node.h"
+#include "planner/plannodes/order_by_plan_node.h"
+#include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/projection_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "planner/plannodes/update_plan_node.h"
+#include "type/transient_value_factory.h"
+
+namespace terrier::execution::compiler {
+
+namespace {
+
+// Whether generated code can read a constant of this type through a @getParam builtin with the same SQL type that
+// CodeGen::PeekValue() would produce. Booleans are peeked as primitive bools, so they stay in the code.
+bool IsLiftable(const type::TransientValue &value) {
+  if (value.Null()) return false;
+  switch (value.Type()) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// A fixed value of the given type that stands in for lifted constants while the plan is hashed
+type::TransientValue Placeholder(const type::TypeId type) {
+  switch (type) {
+    case type::TypeId::TINYINT:
+      return type::TransientValueFactory::GetTinyInt(0);
+    case type::TypeId::SMALLINT:
+      return type::TransientValueFactory::GetSmallInt(0);
+    case type::TypeId::INTEGER:
+      return type::TransientValueFactory::GetInteger(0);
+    case type::TypeId::BIGINT:
+      return type::TransientValueFactory::GetBigInt(0);
+    case type::TypeId::DECIMAL:
+      return type::TransientValueFactory::GetDecimal(0);
+    case type::TypeId::DATE:
+      return type::TransientValueFactory::GetDate(type::date_t(0));
+    case type::TypeId::TIMESTAMP:
+      return type::TransientValueFactory::GetTimestamp(type::timestamp_t(0));
+    case type::TypeId::VARCHAR:
+      return type::TransientValueFactory::GetVarChar("");
+    default:
+      UNREACHABLE("Constant of this type is never lifted");
+  }
+}
+
+}  // namespace
+
+ConstantLifter::ConstantLifter(const common::ManagedPointer<planner::AbstractPlanNode> plan) {
+  VisitNode(plan);
+  if (cacheable_) ComputeFingerprint(plan);
+}
+
+void ConstantLifter::VisitNode(const common::ManagedPointer<planner::AbstractPlanNode> plan) {
+  visited_ = false;
+  plan->Accept(common::ManagedPointer<planner::PlanVisitor>(this));
+  if (!visited_) {
+    cacheable_ = false;
+    return;
+  }
+  if (plan->GetOutputSchema() != nullptr) {
+    for (const auto &col : plan->GetOutputSchema()->GetColumns()) VisitExpression(col.GetExpr());
+  }
+  for (const auto &child : plan->GetChildren()) VisitNode(child);
+}
+
+void ConstantLifter::VisitExpression(const common::ManagedPointer<parser::AbstractExpression> expr) {
+  if (expr == nullptr) return;
+  switch (expr->GetExpressionType()) {
+    case parser::ExpressionType::VALUE_PARAMETER:
+      // The parameter slots already belong to the client
+      cacheable_ = false;
+      return;
+    case parser::ExpressionType::VALUE_CONSTANT: {
+      const auto constant = expr.CastManagedPointerTo<parser::ConstantValueExpression>();
+      if (!IsLiftable(constant->value_)) {
+        occurrences_.emplace_back(NOT_LIFTED);
+        return;
+      }
+      // The same expression may be reachable from several places, e.g. an output column and a predicate
+      const auto [it, inserted] = slots_.emplace(expr.Get(), static_cast<uint32_t>(constants_.size()));
+      if (inserted) {
+        constants_.emplace_back(constant);
+        values_.emplace_back(constant->value_);
+      }
+      occurrences_.emplace_back(it->second);
+      return;
+    }
+    default:
+      for (const auto &child : expr->GetChildren()) VisitExpression(child);
+  }
+}
+
+void ConstantLifter::VisitRoot(const common::ManagedPointer<parser::AbstractExpression> expr) {
+  if (expr == nullptr) return;
+  roots_.emplace_back(expr);
+  VisitExpression(expr);
+}
+
+void ConstantLifter::VisitIndexColumns(
+    const std::unordered_map<catalog::indexkeycol_oid_t, common::ManagedPointer<parser::AbstractExpression>> &cols) {
+  // Walk the key columns in a fixed order so that slots do not depend on the layout of the map
+  std::vector<catalog::indexkeycol_oid_t> oids;
+  oids.reserve(cols.size());
+  for (const auto &col : cols) oids.emplace_back(col.first);
+  std::sort(oids.begin(), oids.end());
+  AddExtra(oids.size());
+  for (const auto oid : oids) {
+    AddExtra(oid);
+    VisitRoot(cols.at(oid));
+  }
+}
+
+void ConstantLifter::ComputeFingerprint(const common::ManagedPointer<planner::AbstractPlanNode> plan) {
+  // Hash and serialize the plan as if every lifted constant had the same value. The originals are kept in values_.
+  for (const auto &constant : constants_) constant->value_ = Placeholder(constant->value_.Type());
+  common::hash_t hash = plan->Hash();
+  nlohmann::json key;
+  key["plan"] = plan->ToJson();
+  std::vector<nlohmann::json> roots;
+  roots.reserve(roots_.size());
+  for (const auto &root : roots_) {
+    hash = common::HashUtil::CombineHashes(hash, root->Hash());
+    roots.emplace_back(root->ToJson());
+  }
+  for (uint32_t i = 0; i < constants_.size(); i++) constants_[i]->value_ = type::TransientValue(values_[i]);
+
+  hash = common::HashUtil::CombineHashes(hash, extras_);
+  fingerprint_ = common::HashUtil::CombineHashInRange(hash, occurrences_.begin(), occurrences_.end());
+  key["roots"] = roots;
+  key["extras"] = extra_values_;
+  key["occurrences"] = occurrences_;
+  key_ = key.dump();
+}
+
+void ConstantLifter::Visit(const planner::AggregatePlanNode *plan) {
+  visited_ = true;
+  for (const auto &term : plan->GetGroupByTerms()) VisitRoot(term);
+  VisitRoot(plan->GetHavingClausePredicate());
+  for (const auto &term : plan->GetAggregateTerms()) VisitRoot(term.CastManagedPointerTo<parser::AbstractExpression>());
+}
+
+void ConstantLifter::Visit(const planner::CSVScanPlanNode *plan) {
+  visited_ = true;
+  AddExtra(plan->GetFileName());
+  VisitRoot(plan->GetScanPredicate());
+}
+
+void ConstantLifter::Visit(const planner::DeletePlanNode *plan) {
+  visited_ = true;
+  modified_tables_.emplace_back(plan->GetTableOid());
+}
+
+void ConstantLifter::Visit(const planner::HashJoinPlanNode *plan) {
+  visited_ = true;
+  VisitRoot(plan->GetJoinPredicate());
+  for (const auto &key : plan->GetLeftHashKeys()) VisitRoot(key);
+  for (const auto &key : plan->GetRightHashKeys()) VisitRoot(key);
+}
+
+void ConstantLifter::Visit(const planner::IndexJoinPlanNode *plan) {
+  visited_ = true;
+  AddExtra(plan->GetIndexOid());
+  AddExtra(plan->GetTableOid());
+  VisitRoot(plan->GetJoinPredicate());
+  VisitIndexColumns(plan->GetIndexColumns());
+}
+
+void ConstantLifter::Visit(const planner::IndexScanPlanNode *plan) {
+  visited_ = true;
+  AddExtra(plan->GetScanType());
+  VisitRoot(plan->GetScanPredicate());
+  VisitIndexColumns(plan->GetIndexColumns());
+  VisitIndexColumns(plan->GetLoIndexColumns());
+  VisitIndexColumns(plan->GetHiIndexColumns());
+}
+
+void ConstantLifter::Visit(const planner::InsertPlanNode *plan) {
+  visited_ = true;
+  modified_tables_.emplace_back(plan->GetTableOid());
+  for (uint32_t i = 0; i < plan->GetBulkInsertCount(); i++) {
+    for (const auto &value : plan->GetValues(i)) VisitRoot(value);
+  }
+}
+
+void ConstantLifter::Visit(UNUSED_ATTRIBUTE const planner::LimitPlanNode *plan) { visited_ = true; }
+
+void ConstantLifter::Visit(const planner::NestedLoopJoinPlanNode *plan) {
+  visited_ = true;
+  VisitRoot(plan->GetJoinPredicate());
+  for (const auto &key : plan->GetLeftKeys()) VisitRoot(key);
+  for (const auto &key : plan->GetRightKeys()) VisitRoot(key);
+}
+
+void ConstantLifter::Visit(const planner::OrderByPlanNode *plan) {
+  visited_ = true;
+  for (const auto &sort_key : plan->GetSortKeys()) VisitRoot(sort_key.first);
+}
+
+void ConstantLifter::Visit(UNUSED_ATTRIBUTE const planner::ProjectionPlanNode *plan) { visited_ = true; }
+
+void ConstantLifter::Visit(const planner::SeqScanPlanNode *plan) {
+  visited_ = true;
+  VisitRoot(plan->GetScanPredicate());
+}
+
+void ConstantLifter::Visit(const planner::UpdatePlanNode *plan) {
+  visited_ = true;
+  modified_tables_.emplace_back(plan->GetTableOid());
+  AddExtra(plan->GetIndexedUpdate());
+  for (const auto &set_clause : plan->GetSetClauses()) VisitRoot(set_clause.second);
+}
+
+}  // namespace terrier::execution::compiler
@@ -12,6 +12,18 @@ ast::Expr *ComparisonTranslator::DeriveExpr(ExpressionEvaluator *evaluator) {
   auto *left_expr = left_->DeriveExpr(evaluator);
   auto *right_expr = right_->DeriveExpr(evaluator);
   parsing::Token::Type op_token;
+  switch (expression_->GetExpressionType()) {
+    case terrier::parser::ExpressionType::COMPARE_LIKE:
+      return codegen_->BuiltinCall(ast::Builtin::Like, {left_expr, right_expr});
+    case terrier::parser::ExpressionType::COMPARE_NOT_LIKE: {
+      // Compare with false rather than negate, so that NULL stays NULL
+      auto *like_call = codegen_->BuiltinCall(ast::Builtin::Like, {left_expr, right_expr});
+      auto *false_val = codegen_->OneArgCall(ast::Builtin::BoolToSql, codegen_->BoolLiteral(false));
+      return codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, like_call, false_val);
+    }
+    default:
+      break;
+  }
   switch (expression_->GetExpressionType()) {
     case terrier::parser::ExpressionType::COMPARE_EQUAL:
       op_token = parsing::Token::Type::EQUAL_EQUAL;
@@ -1,4 +1,5 @@
 #include "execution/compiler/expression/constant_translator.h"
+#include "execution/compiler/constant_lifter.h"
 #include "execution/compiler/translator_factory.h"
 #include "execution/sql/value.h"
 #include "parser/expression/constant_value_expression.h"
@@ -11,6 +12,11 @@ ConstantTranslator::ConstantTranslator(const terrier::parser::AbstractExpression
 ast::Expr *ConstantTranslator::DeriveExpr(ExpressionEvaluator *evaluator) {
   auto const_val = GetExpressionAs<terrier::parser::ConstantValueExpression>();
   auto trans_val = const_val->GetValue();
+  if (codegen_->Lifter() != nullptr) {
+    // Lifted constants are passed in as parameters so that the code can be reused for other values
+    const uint32_t slot = codegen_->Lifter()->SlotOf(expression_);
+    if (slot != ConstantLifter::NOT_LIFTED) return codegen_->GetParam(trans_val.Type(), slot);
+  }
   return codegen_->PeekValue(trans_val);
 }
 };  // namespace terrier::execution::compiler
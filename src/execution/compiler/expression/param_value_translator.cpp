@@ -11,40 +11,6 @@ ParamValueTranslator::ParamValueTranslator(const terrier::parser::AbstractExpres
 ast::Expr *ParamValueTranslator::DeriveExpr(ExpressionEvaluator *evaluator) {
   auto param_val = GetExpressionAs<terrier::parser::ParameterValueExpression>();
   auto param_idx = param_val->GetValueIdx();
-  ast::Builtin builtin;
-  switch (param_val->GetReturnValueType()) {
-    case type::TypeId::BOOLEAN:
-      builtin = ast::Builtin::GetParamBool;
-      break;
-    case type::TypeId::TINYINT:
-      builtin = ast::Builtin::GetParamTinyInt;
-      break;
-    case type::TypeId::SMALLINT:
-      builtin = ast::Builtin::GetParamSmallInt;
-      break;
-    case type::TypeId::INTEGER:
-      builtin = ast::Builtin::GetParamInt;
-      break;
-    case type::TypeId::BIGINT:
-      builtin = ast::Builtin::GetParamBigInt;
-      break;
-    case type::TypeId::DECIMAL:
-      builtin = ast::Builtin::GetParamDouble;
-      break;
-    case type::TypeId::DATE:
-      builtin = ast::Builtin::GetParamDate;
-      break;
-    case type::TypeId::TIMESTAMP:
-      builtin = ast::Builtin::GetParamTimestamp;
-      break;
-    case type::TypeId::VARCHAR:
-      builtin = ast::Builtin::GetParamString;
-      break;
-    default:
-      UNREACHABLE("Unsupported parameter type");
-  }
-
-  return codegen_->BuiltinCall(builtin,
-                               {codegen_->MakeExpr(codegen_->GetExecCtxVar()), codegen_->IntLiteral(param_idx)});
+  return codegen_->GetParam(param_val->GetReturnValueType(), param_idx);
 }
 };  // namespace terrier::execution::compiler
@@ -7,7 +7,15 @@
 
 namespace terrier::execution::compiler {
 AggregateBottomTranslator::AggregateBottomTranslator(const terrier::planner::AggregatePlanNode *op, CodeGen *codegen)
-    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_BUILD), op_(op), helper_(codegen, op) {}
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_BUILD),
+      op_(op),
+      helper_(codegen, op),
+      partial_key_check_(codegen->NewIdentifier("partialKeyCheck")),
+      merge_partitions_fn_(codegen->NewIdentifier("mergePartitions")),
+      partition_(codegen->NewIdentifier("agg_partition")),
+      part_iter_(codegen->NewIdentifier("part_iter")),
+      partial_(codegen->NewIdentifier("partial")),
+      partial_hash_(codegen->NewIdentifier("partial_hash")) {}
 
 void AggregateBottomTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
   // There the aggregation hash tables.
@@ -24,6 +32,10 @@ void AggregateBottomTranslator::InitializeStructs(util::RegionVector<ast::Decl *
 void AggregateBottomTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
   // Generate the key check functions.
   helper_.GenKeyChecks(decls);
+  // Generate the functions that merge the partitions of the global hash table. The table may be partitioned even
+  // when the pipeline is serial, once the query goes over its memory budget.
+  GenPartialKeyCheck(decls);
+  GenMergePartitions(decls);
 }
 
 void AggregateBottomTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
@@ -36,7 +48,51 @@ void AggregateBottomTranslator::InitializeTeardown(util::RegionVector<ast::Stmt
   helper_.FreeAHTs(teardown_stmts);
 }
 
-void AggregateBottomTranslator::Produce(FunctionBuilder *builder) { child_translator_->Produce(builder); }
+void AggregateBottomTranslator::InitializeThreadStateFields(
+    util::RegionVector<ast::FieldDecl *> *thread_state_fields) {
+  ast::Expr *ht_type = codegen_->BuiltinType(ast::BuiltinType::Kind::AggregationHashTable);
+  thread_state_fields->emplace_back(codegen_->MakeField(helper_.GetGlobalAHT()->HT(), ht_type));
+}
+
+// @aggHTInit(&threadState.aht, @execCtxGetMem(execCtx), @sizeOf(AHTStruct))
+void AggregateBottomTranslator::InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  auto global_aht = helper_.GetGlobalAHT();
+  ast::Expr *init_call = codegen_->HTInitCall(ast::Builtin::AggHashTableInit,
+                                              codegen_->GetThreadStateMemberPtr(global_aht->HT()),
+                                              global_aht->StructType());
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+// @aggHTFree(&threadState.aht)
+void AggregateBottomTranslator::InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  ast::Expr *free_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableFree,
+                                               {codegen_->GetThreadStateMemberPtr(helper_.GetGlobalAHT()->HT())});
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+// @aggHTMoveParts(&state.aht, &state.thread_states, @offsetOf(ThreadState, aht), mergePartitions)
+void AggregateBottomTranslator::FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {
+  ast::Identifier ht = helper_.GetGlobalAHT()->HT();
+  std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(ht), thread_states,
+                                codegen_->OffsetOf(thread_state_type_, ht), codegen_->MakeExpr(merge_partitions_fn_)};
+  ast::Expr *move_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableMovePartitions, std::move(args));
+  builder->Append(codegen_->MakeStmt(move_call));
+  // The top translator builds the partitions itself if it scans them in parallel
+  if (!partitions_scanned_in_parallel_) GenBuildPartitions(builder);
+}
+
+bool AggregateBottomTranslator::IsParallelizable() {
+  for (const auto &term : op_->GetAggregateTerms()) {
+    if (term->IsDistinct()) return false;
+  }
+  return true;
+}
+
+void AggregateBottomTranslator::Produce(FunctionBuilder *builder) {
+  child_translator_->Produce(builder);
+  // Merge whatever the table partitioned. Parallel pipelines do it in FinishParallelWork.
+  if (!parallelized_pipeline_) GenBuildPartitions(builder);
+}
 
 void AggregateBottomTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
 
@@ -46,7 +102,7 @@ void AggregateBottomTranslator::Consume(FunctionBuilder *builder) {
   // Generate hashes
   helper_.GenHashCalls(builder);
   // Construct new hash table entries
-  helper_.GenConstruct(builder);
+  helper_.GenConstruct(builder, parallelized_pipeline_);
   // Advance non distinct aggregates
   helper_.GenAdvanceNonDistinct(builder);
 }
@@ -67,6 +123,102 @@ ast::Expr *AggregateBottomTranslator::GetChildOutput(uint32_t child_idx, uint32_
   return child_translator_->GetOutput(attr_idx);
 }
 
+void AggregateBottomTranslator::GenPartialKeyCheck(util::RegionVector<ast::Decl *> *decls) {
+  auto global_aht = helper_.GetGlobalAHT();
+  // Both entries are of the hash table's struct type
+  ast::FieldDecl *param1 = codegen_->MakeField(global_aht->Entry(), codegen_->PointerType(global_aht->StructType()));
+  ast::FieldDecl *param2 = codegen_->MakeField(partial_, codegen_->PointerType(global_aht->StructType()));
+  util::RegionVector<ast::FieldDecl *> params({param1, param2}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Bool);
+  FunctionBuilder builder(codegen_, partial_key_check_, std::move(params), ret_type);
+  // Compare the group by terms
+  for (uint32_t term_idx = 0; term_idx < op_->GetGroupByTerms().size(); term_idx++) {
+    ast::Expr *lhs = codegen_->MemberExpr(global_aht->Entry(), helper_.GetGroupBy(term_idx));
+    ast::Expr *rhs = codegen_->MemberExpr(partial_, helper_.GetGroupBy(term_idx));
+    ast::Expr *cond = codegen_->Compare(parsing::Token::Type::BANG_EQUAL, lhs, rhs);
+    builder.StartIfStmt(cond);
+    builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(false)));
+    builder.FinishBlockStmt();
+  }
+  builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(true)));
+  decls->emplace_back(builder.Finish());
+}
+
+void AggregateBottomTranslator::GenMergePartitions(util::RegionVector<ast::Decl *> *decls) {
+  auto global_aht = helper_.GetGlobalAHT();
+  // Function parameters: the query state, the table to fill, and the partial aggregates of one partition.
+  ast::FieldDecl *state_param =
+      codegen_->MakeField(codegen_->GetStateVar(), codegen_->PointerType(codegen_->GetStateType()));
+  ast::Expr *ht_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::Kind::AggregationHashTable));
+  ast::FieldDecl *partition_param = codegen_->MakeField(partition_, ht_type);
+  ast::Expr *iter_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::Kind::AggOverflowPartIter));
+  ast::FieldDecl *iter_param = codegen_->MakeField(part_iter_, iter_type);
+  util::RegionVector<ast::FieldDecl *> params({state_param, partition_param, iter_param}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Nil);
+  FunctionBuilder builder(codegen_, merge_partitions_fn_, std::move(params), ret_type);
+
+  // for (; @aggPartIterHasNext(part_iter); @aggPartIterNext(part_iter))
+  ast::Expr *has_next_call = codegen_->OneArgCall(ast::Builtin::AggPartIterHasNext, part_iter_, false);
+  ast::Expr *next_call = codegen_->OneArgCall(ast::Builtin::AggPartIterNext, part_iter_, false);
+  builder.StartForStmt(nullptr, has_next_call, codegen_->MakeStmt(next_call));
+
+  // var partial_hash = @aggPartIterGetHash(part_iter)
+  ast::Expr *get_hash_call = codegen_->OneArgCall(ast::Builtin::AggPartIterGetHash, part_iter_, false);
+  builder.Append(codegen_->DeclareVariable(partial_hash_, nullptr, get_hash_call));
+  // var partial = @ptrCast(*AHTStruct, @aggPartIterGetRow(part_iter))
+  ast::Expr *get_row_call = codegen_->OneArgCall(ast::Builtin::AggPartIterGetRow, part_iter_, false);
+  ast::Expr *partial_cast = codegen_->PtrCast(global_aht->StructType(), get_row_call);
+  builder.Append(codegen_->DeclareVariable(partial_, nullptr, partial_cast));
+
+  // var aht_entry = @ptrCast(*AHTStruct, @aggHTLookup(agg_partition, partial_hash, partialKeyCheck, partial))
+  std::vector<ast::Expr *> lookup_args{codegen_->MakeExpr(partition_), codegen_->MakeExpr(partial_hash_),
+                                       codegen_->MakeExpr(partial_key_check_), codegen_->MakeExpr(partial_)};
+  ast::Expr *lookup_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableLookup, std::move(lookup_args));
+  ast::Expr *entry_cast = codegen_->PtrCast(global_aht->StructType(), lookup_call);
+  builder.Append(codegen_->DeclareVariable(global_aht->Entry(), nullptr, entry_cast));
+
+  // If the group is new, insert it and initialize its aggregates
+  ast::Expr *entry = codegen_->MakeExpr(global_aht->Entry());
+  builder.StartIfStmt(codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, codegen_->NilLiteral(), entry));
+  {
+    std::vector<ast::Expr *> insert_args{codegen_->MakeExpr(partition_), codegen_->MakeExpr(partial_hash_)};
+    ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsert, std::move(insert_args));
+    builder.Append(codegen_->Assign(codegen_->MakeExpr(global_aht->Entry()),
+                                    codegen_->PtrCast(global_aht->StructType(), insert_call)));
+    for (uint32_t term_idx = 0; term_idx < op_->GetGroupByTerms().size(); term_idx++) {
+      ast::Expr *lhs = codegen_->MemberExpr(global_aht->Entry(), helper_.GetGroupBy(term_idx));
+      ast::Expr *rhs = codegen_->MemberExpr(partial_, helper_.GetGroupBy(term_idx));
+      builder.Append(codegen_->Assign(lhs, rhs));
+    }
+    for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+      ast::Expr *agg = codegen_->MemberExpr(global_aht->Entry(), helper_.GetAggregate(term_idx));
+      builder.Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::AggInit, codegen_->PointerTo(agg))));
+    }
+  }
+  builder.FinishBlockStmt();
+
+  // @aggMerge(&aht_entry.agg_i, &partial.agg_i) for each aggregate
+  for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+    ast::Expr *agg = codegen_->MemberExpr(global_aht->Entry(), helper_.GetAggregate(term_idx));
+    ast::Expr *partial_agg = codegen_->MemberExpr(partial_, helper_.GetAggregate(term_idx));
+    ast::Expr *merge_call =
+        codegen_->BuiltinCall(ast::Builtin::AggMerge, {codegen_->PointerTo(agg), codegen_->PointerTo(partial_agg)});
+    builder.Append(codegen_->MakeStmt(merge_call));
+  }
+
+  // Close the loop
+  builder.FinishBlockStmt();
+  decls->emplace_back(builder.Finish());
+}
+
+void AggregateBottomTranslator::GenBuildPartitions(FunctionBuilder *builder) {
+  std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(helper_.GetGlobalAHT()->HT()),
+                                codegen_->MakeExpr(codegen_->GetStateVar()),
+                                codegen_->MakeExpr(merge_partitions_fn_)};
+  ast::Expr *build_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableBuildPartitions, std::move(args));
+  builder->Append(codegen_->MakeStmt(build_call));
+}
+
 ///////////////////////////////////////////////
 ///// Top Translator
 ///////////////////////////////////////////////
@@ -122,11 +274,29 @@ void AggregateTopTranslator::DeclareIterator(FunctionBuilder *builder) {
   builder->Append(codegen_->DeclareVariable(agg_iterator_, iter_type, nullptr));
 }
 
+ast::FieldDecl *AggregateTopTranslator::GetParallelWorkParam() {
+  ast::Expr *ht_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::Kind::AggregationHashTable));
+  return codegen_->MakeField(partition_, ht_type);
+}
+
+void AggregateTopTranslator::LaunchParallelWork(FunctionBuilder *builder, ast::Expr *thread_states,
+                                                ast::Identifier work_fn) {
+  // @aggHTParallelPartScan(&state.aht, state, &state.thread_states, work_fn)
+  std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(bottom_->helper_.GetGlobalAHT()->HT()),
+                                codegen_->MakeExpr(codegen_->GetStateVar()), thread_states,
+                                codegen_->MakeExpr(work_fn)};
+  ast::Expr *scan_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableParallelPartitionedScan, std::move(args));
+  builder->Append(codegen_->MakeStmt(scan_call));
+}
+
 // for (@aggHTIterInit(&agg_iter, &state.table); @aggHTIterHasNext(&agg_iter); @aggHTIterNext(&agg_iter)) {...}
 void AggregateTopTranslator::GenHTLoop(FunctionBuilder *builder) {
   auto global_aht = bottom_->helper_.GetGlobalAHT();
+  // Parallel workers iterate the table built over their partition
+  ast::Expr *table = ScansPartitionsInParallel() ? codegen_->MakeExpr(partition_)
+                                                 : codegen_->GetStateMemberPtr(global_aht->HT());
   // Loop Initialization
-  std::vector<ast::Expr *> init_args{codegen_->PointerTo(agg_iterator_), codegen_->GetStateMemberPtr(global_aht->HT())};
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(agg_iterator_), table};
   ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableIterInit, std::move(init_args));
   ast::Stmt *loop_init = codegen_->MakeStmt(init_call);
   // Loop condition
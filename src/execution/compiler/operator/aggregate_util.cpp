@@ -149,11 +149,16 @@ void AggregateHelper::GenHashCalls(FunctionBuilder *builder) {
   }
 }
 
-void AggregateHelper::GenConstruct(FunctionBuilder *builder) {
+void AggregateHelper::GenConstruct(FunctionBuilder *builder, bool thread_local_ht) {
   auto construct_entry = [&](const AHTInfo *info) {
+    // Only the global hash table can be thread-local. Thread-local tables are partitioned once they fill up.
+    const bool is_thread_local = thread_local_ht && !info->IsDistinct();
+    auto ht_ptr = [&]() {
+      return is_thread_local ? codegen_->GetThreadStateMemberPtr(info->HT()) : codegen_->GetStateMemberPtr(info->HT());
+    };
     // For lookup the entry in the table.
     {
-      std::vector<ast::Expr *> lookup_args{codegen_->GetStateMemberPtr(info->HT()), codegen_->MakeExpr(info->HashVal()),
+      std::vector<ast::Expr *> lookup_args{ht_ptr(), codegen_->MakeExpr(info->HashVal()),
                                            codegen_->MakeExpr(info->KeyCheck()), codegen_->PointerTo(agg_values_)};
       ast::Expr *lookup_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableLookup, std::move(lookup_args));
       ast::Expr *cast_call = codegen_->PtrCast(info->StructType(), lookup_call);
@@ -168,9 +173,10 @@ void AggregateHelper::GenConstruct(FunctionBuilder *builder) {
     }
     // If it is null, then insert a new entry into the table.
     {
-      std::vector<ast::Expr *> insert_args{codegen_->GetStateMemberPtr(info->HT()),
-                                           codegen_->MakeExpr(info->HashVal())};
-      ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsert, std::move(insert_args));
+      std::vector<ast::Expr *> insert_args{ht_ptr(), codegen_->MakeExpr(info->HashVal())};
+      const ast::Builtin insert_builtin =
+          is_thread_local ? ast::Builtin::AggHashTableInsertPartitioned : ast::Builtin::AggHashTableInsert;
+      ast::Expr *insert_call = codegen_->BuiltinCall(insert_builtin, std::move(insert_args));
       auto cast_call = codegen_->PtrCast(info->StructType(), insert_call);
       builder->Append(codegen_->Assign(codegen_->MakeExpr(info->Entry()), cast_call));
       // Initialize the group by values.
@@ -238,13 +244,15 @@ void AggregateHelper::GenKeyChecks(util::RegionVector<ast::Decl *> *decls) {
   }
 }
 
-void AggregateHelper::GenAdvanceNonDistinct(FunctionBuilder *builder) {
+void AggregateHelper::GenAdvanceNonDistinct(FunctionBuilder *builder, bool thread_local_aggs) {
   for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
     auto term = op_->GetAggregateTerms()[term_idx];
     if (!term->IsDistinct()) {
       ast::Expr *arg1;
       if (!op_->GetGroupByTerms().empty()) {
         arg1 = codegen_->PointerTo(codegen_->MemberExpr(global_info_.Entry(), aggregates_[term_idx]));
+      } else if (thread_local_aggs) {
+        arg1 = codegen_->GetThreadStateMemberPtr(aggregates_[term_idx]);
       } else {
         arg1 = codegen_->GetStateMemberPtr(aggregates_[term_idx]);
       }
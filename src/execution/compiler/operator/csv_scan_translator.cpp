@@ -0,0 +1,121 @@
+#include "execution/compiler/operator/csv_scan_translator.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "execution/ast/type.h"
+#include "execution/compiler/codegen.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/translator_factory.h"
+#include "planner/plannodes/csv_scan_plan_node.h"
+
+namespace terrier::execution::compiler {
+
+CSVScanTranslator::CSVScanTranslator(const terrier::planner::CSVScanPlanNode *op, CodeGen *codegen)
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::CSV_SCAN),
+      op_(op),
+      reader_(codegen->NewIdentifier("csv")) {}
+
+void CSVScanTranslator::Produce(FunctionBuilder *builder) {
+  // In parallel pipelines, the reader is a parameter of the worker function.
+  if (parallelized_pipeline_) {
+    DoFileScan(builder);
+    return;
+  }
+
+  // var csv: CSVReader
+  ast::Expr *reader_type = codegen_->BuiltinType(ast::BuiltinType::Kind::CSVReader);
+  builder->Append(codegen_->DeclareVariable(reader_, reader_type, nullptr));
+
+  // @csvReaderInit(&csv, file_name, delimiter, quote, escape)
+  std::vector<ast::Expr *> args{codegen_->PointerTo(reader_)};
+  for (auto *arg : FileArgs()) args.emplace_back(arg);
+  ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::CSVReaderInit, std::move(args));
+  builder->Append(codegen_->MakeStmt(init_call));
+
+  DoFileScan(builder);
+
+  // @csvReaderClose(&csv)
+  ast::Expr *close_call = codegen_->OneArgCall(ast::Builtin::CSVReaderClose, reader_, true);
+  builder->Append(codegen_->MakeStmt(close_call));
+}
+
+void CSVScanTranslator::Abort(FunctionBuilder *builder) {
+  // Close the reader. Parallel workers do not own theirs.
+  if (!parallelized_pipeline_) {
+    ast::Expr *close_call = codegen_->OneArgCall(ast::Builtin::CSVReaderClose, reader_, true);
+    builder->Append(codegen_->MakeStmt(close_call));
+  }
+}
+
+ast::FieldDecl *CSVScanTranslator::GetParallelWorkParam() {
+  ast::Expr *reader_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::Kind::CSVReader));
+  return codegen_->MakeField(reader_, reader_type);
+}
+
+void CSVScanTranslator::LaunchParallelWork(FunctionBuilder *builder, ast::Expr *thread_states,
+                                           ast::Identifier work_fn) {
+  // @iterateCSVParallel(file_name, delimiter, quote, escape, state, &state.thread_states, work_fn)
+  std::vector<ast::Expr *> args = FileArgs();
+  args.emplace_back(codegen_->MakeExpr(codegen_->GetStateVar()));
+  args.emplace_back(thread_states);
+  args.emplace_back(codegen_->MakeExpr(work_fn));
+  ast::Expr *scan_call = codegen_->BuiltinCall(ast::Builtin::CSVReaderParallel, std::move(args));
+  builder->Append(codegen_->MakeStmt(scan_call));
+}
+
+void CSVScanTranslator::DoFileScan(FunctionBuilder *builder) {
+  // for (@csvReaderAdvance(&csv)) {...}
+  ast::Expr *advance_call = codegen_->OneArgCall(ast::Builtin::CSVReaderAdvance, reader_, !parallelized_pipeline_);
+  builder->StartForStmt(nullptr, advance_call, nullptr);
+  // Let parent consume.
+  parent_translator_->Consume(builder);
+  // Close loop
+  builder->FinishBlockStmt();
+}
+
+std::vector<ast::Expr *> CSVScanTranslator::FileArgs() {
+  const std::string &file_name = op_->GetFileName();
+  ast::Identifier file_ident = codegen_->Context()->GetIdentifier(file_name);
+  return {codegen_->Factory()->NewStringLiteral(DUMMY_POS, file_ident), codegen_->IntLiteral(op_->GetDelimiterChar()),
+          codegen_->IntLiteral(op_->GetQuoteChar()), codegen_->IntLiteral(op_->GetEscapeChar())};
+}
+
+ast::Expr *CSVScanTranslator::GetOutput(uint32_t attr_idx) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  auto translator = TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+
+ast::Expr *CSVScanTranslator::GetTableColumn(const catalog::col_oid_t &col_oid) {
+  // Call @csvReaderGetType(&csv, field_idx)
+  const uint32_t field_idx = !col_oid;
+  TERRIER_ASSERT(field_idx < op_->GetValueTypes().size(), "CSV field out of range");
+  ast::Builtin builtin;
+  switch (op_->GetValueTypes()[field_idx]) {
+    case type::TypeId::BOOLEAN:
+      builtin = ast::Builtin::CSVReaderGetBool;
+      break;
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      builtin = ast::Builtin::CSVReaderGetInt;
+      break;
+    case type::TypeId::DECIMAL:
+      builtin = ast::Builtin::CSVReaderGetReal;
+      break;
+    case type::TypeId::DATE:
+      builtin = ast::Builtin::CSVReaderGetDate;
+      break;
+    case type::TypeId::VARCHAR:
+      builtin = ast::Builtin::CSVReaderGetString;
+      break;
+    default:
+      UNREACHABLE("Unsupported CSV column type");
+  }
+  ast::Expr *reader = parallelized_pipeline_ ? codegen_->MakeExpr(reader_) : codegen_->PointerTo(reader_);
+  return codegen_->BuiltinCall(builtin, {reader, codegen_->IntLiteral(field_idx)});
+}
+
+}  // namespace terrier::execution::compiler
@@ -3,14 +3,18 @@
 #include <utility>
 #include <vector>
 #include "execution/compiler/function_builder.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/translator_factory.h"
+#include "parser/expression/derived_value_expression.h"
 #include "planner/plannodes/hash_join_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
 
 namespace terrier::execution::compiler {
 HashJoinLeftTranslator::HashJoinLeftTranslator(const terrier::planner::HashJoinPlanNode *op,
                                                execution::compiler::CodeGen *codegen)
     : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::HASHJOIN_BUILD),
       op_(op),
+      probe_filter_col_(FindProbeFilterColumn()),
       hash_val_{codegen->NewIdentifier("hash_val")},
       build_struct_{codegen->NewIdentifier("BuildRow")},
       build_row_{codegen->NewIdentifier("build_row")},
@@ -20,8 +24,8 @@ HashJoinLeftTranslator::HashJoinLeftTranslator(const terrier::planner::HashJoinP
 void HashJoinLeftTranslator::Produce(FunctionBuilder *builder) {
   // Produce the rest of the pipeline
   child_translator_->Produce(builder);
-  // Call @joinHTBuild at the end of the pipeline
-  GenBuildCall(builder);
+  // Call @joinHTBuild at the end of the pipeline. Parallel pipelines build in FinishParallelWork.
+  if (!parallelized_pipeline_) GenBuildCall(builder);
 }
 
 void HashJoinLeftTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
@@ -31,6 +35,8 @@ void HashJoinLeftTranslator::Consume(FunctionBuilder *builder) {
   GenHashCall(builder);
   // Then call insert
   GenHTInsert(builder);
+  // Track the key for the probe side's runtime filter
+  if (probe_filter_col_ != nullptr) GenAddFilterKey(builder);
   // Fill up the build row
   FillBuildRow(builder);
 }
@@ -69,12 +75,88 @@ void HashJoinLeftTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *>
   teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
 }
 
+// Each thread inserts into its own hash table
+void HashJoinLeftTranslator::InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) {
+  ast::Expr *ht_type = codegen_->BuiltinType(ast::BuiltinType::Kind::JoinHashTable);
+  thread_state_fields->emplace_back(codegen_->MakeField(join_ht_, ht_type));
+}
+
+// @joinHTInit(&threadState.join_table, @execCtxGetMem(execCtx), @sizeOf(BuildRow))
+void HashJoinLeftTranslator::InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  ast::Expr *init_call =
+      codegen_->HTInitCall(ast::Builtin::JoinHashTableInit, codegen_->GetThreadStateMemberPtr(join_ht_), build_struct_);
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+// @joinHTFree(&threadState.join_table)
+void HashJoinLeftTranslator::InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  ast::Expr *free_call =
+      codegen_->BuiltinCall(ast::Builtin::JoinHashTableFree, {codegen_->GetThreadStateMemberPtr(join_ht_)});
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+// @joinHTBuildParallel(&state.join_table, &state.thread_states, @offsetOf(ThreadState, join_table))
+void HashJoinLeftTranslator::FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {
+  std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(join_ht_), thread_states,
+                                codegen_->OffsetOf(thread_state_type_, join_ht_)};
+  ast::Expr *build_call = codegen_->BuiltinCall(ast::Builtin::JoinHashTableBuildParallel, std::move(args));
+  builder->Append(codegen_->MakeStmt(build_call));
+}
+
 // Call @joinHTBuild(&state.join_hash_table)
 void HashJoinLeftTranslator::GenBuildCall(FunctionBuilder *builder) {
   ast::Expr *build_call = codegen_->OneArgStateCall(ast::Builtin::JoinHashTableBuild, join_ht_);
   builder->Append(codegen_->MakeStmt(build_call));
 }
 
+const parser::ColumnValueExpression *HashJoinLeftTranslator::FindProbeFilterColumn() const {
+  // Only joins that discard unmatched probe tuples can discard them early
+  const auto join_type = op_->GetLogicalJoinType();
+  if (join_type != planner::LogicalJoinType::INNER && join_type != planner::LogicalJoinType::LEFT_SEMI) {
+    return nullptr;
+  }
+
+  // The runtime filter tracks a single integer key
+  const auto is_integer = [](const type::TypeId type) {
+    return type == type::TypeId::TINYINT || type == type::TypeId::SMALLINT || type == type::TypeId::INTEGER ||
+           type == type::TypeId::BIGINT;
+  };
+  if (op_->GetLeftHashKeys().size() != 1 || op_->GetRightHashKeys().size() != 1 ||
+      !is_integer(op_->GetLeftHashKeys()[0]->GetReturnValueType())) {
+    return nullptr;
+  }
+
+  // The probe key must be an integer column read directly by a sequential scan
+  const auto right_key = op_->GetRightHashKeys()[0];
+  const auto *probe = op_->GetChild(1);
+  if (probe->GetPlanNodeType() != planner::PlanNodeType::SEQSCAN ||
+      right_key->GetExpressionType() != parser::ExpressionType::VALUE_TUPLE) {
+    return nullptr;
+  }
+  const auto derived = right_key.CastManagedPointerTo<parser::DerivedValueExpression>();
+  const auto scanned = probe->GetOutputSchema()->GetColumn(derived->GetValueIdx()).GetExpr();
+  if (derived->GetTupleIdx() != 1 || scanned->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+    return nullptr;
+  }
+  const auto *col = scanned.CastManagedPointerTo<parser::ColumnValueExpression>().Get();
+  const auto table_oid = static_cast<const planner::SeqScanPlanNode *>(probe)->GetTableOid();
+  if (!is_integer(codegen_->Accessor()->GetSchema(table_oid).GetColumn(col->GetColumnOid()).Type())) {
+    return nullptr;
+  }
+  return col;
+}
+
+// @joinHTAddFilterKey(&state.join_table, join_key)
+// In parallel pipelines, the thread-local table is used instead.
+void HashJoinLeftTranslator::GenAddFilterKey(FunctionBuilder *builder) {
+  ast::Expr *ht_ptr =
+      parallelized_pipeline_ ? codegen_->GetThreadStateMemberPtr(join_ht_) : codegen_->GetStateMemberPtr(join_ht_);
+  auto key_translator = TranslatorFactory::CreateExpressionTranslator(op_->GetLeftHashKeys()[0].Get(), codegen_);
+  std::vector<ast::Expr *> args{ht_ptr, key_translator->DeriveExpr(this)};
+  ast::Expr *add_call = codegen_->BuiltinCall(ast::Builtin::JoinHashTableAddFilterKey, std::move(args));
+  builder->Append(codegen_->MakeStmt(add_call));
+}
+
 // Declare var hash_val = @hash(join_keys)
 void HashJoinLeftTranslator::GenHashCall(FunctionBuilder *builder) {
   // First create @hash(join_key1, join_key2, ...)
@@ -91,9 +173,12 @@ void HashJoinLeftTranslator::GenHashCall(FunctionBuilder *builder) {
 }
 
 // var build_row = @ptrCast(*BuildRow, @joinHTInsert(&state.join_table, hash_val))
+// In parallel pipelines, the thread-local table is used instead.
 void HashJoinLeftTranslator::GenHTInsert(FunctionBuilder *builder) {
   // First create @joinHTInsert(&state.join_table, hash_val)
-  std::vector<ast::Expr *> insert_args{codegen_->GetStateMemberPtr(join_ht_), codegen_->MakeExpr(hash_val_)};
+  ast::Expr *ht_ptr =
+      parallelized_pipeline_ ? codegen_->GetThreadStateMemberPtr(join_ht_) : codegen_->GetStateMemberPtr(join_ht_);
+  std::vector<ast::Expr *> insert_args{ht_ptr, codegen_->MakeExpr(hash_val_)};
   ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::JoinHashTableInsert, std::move(insert_args));
 
   // Gen create @ptrcast(*BuildRow, ...)
@@ -149,6 +234,12 @@ HashJoinRightTranslator::HashJoinRightTranslator(const terrier::planner::HashJoi
       join_iter_{codegen->NewIdentifier("join_iter")} {}
 
 void HashJoinRightTranslator::Produce(FunctionBuilder *builder) {
+  // Have the probe-side scan apply the runtime filter of the built table
+  if (left_->probe_filter_col_ != nullptr) {
+    auto *scan = dynamic_cast<SeqScanTranslator *>(child_translator_);
+    TERRIER_ASSERT(scan != nullptr, "Runtime join filters are only applied by sequential scans");
+    scan->AddJoinFilter(left_->probe_filter_col_->GetColumnOid(), left_->join_ht_);
+  }
   // Declare the iterator
   DeclareIterator(builder);
   // Let right child produce its code
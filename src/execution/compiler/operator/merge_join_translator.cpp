@@ -0,0 +1,371 @@
+#include "execution/compiler/operator/merge_join_translator.h"
+#include <memory>
+#include <utility>
+#include <vector>
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/translator_factory.h"
+#include "planner/plannodes/merge_join_plan_node.h"
+
+namespace terrier::execution::compiler {
+MergeJoinLeftTranslator::MergeJoinLeftTranslator(const terrier::planner::MergeJoinPlanNode *op,
+                                                 execution::compiler::CodeGen *codegen)
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::MERGEJOIN_BUILD),
+      op_(op),
+      sorter_{codegen->NewIdentifier("merge_sorter")},
+      merge_struct_{codegen->NewIdentifier("MergeRow")},
+      merge_row_{codegen->NewIdentifier("merge_row")},
+      comp_fn_{codegen->NewIdentifier("mergeSortFn")},
+      comp_lhs_{codegen->NewIdentifier("lhs")},
+      comp_rhs_{codegen->NewIdentifier("rhs")} {}
+
+void MergeJoinLeftTranslator::Produce(FunctionBuilder *builder) {
+  // Produce the rest of the pipeline
+  child_translator_->Produce(builder);
+  // Call @sorterSort at the end of the pipeline. Parallel pipelines sort in FinishParallelWork.
+  if (!parallelized_pipeline_) {
+    builder->Append(codegen_->MakeStmt(codegen_->OneArgStateCall(ast::Builtin::SorterSort, sorter_)));
+  }
+}
+
+void MergeJoinLeftTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
+
+void MergeJoinLeftTranslator::Consume(FunctionBuilder *builder) {
+  // if (@isSqlNotNull(key1) and @isSqlNotNull(key2) ...) {...}
+  ast::Expr *not_null = nullptr;
+  for (const auto &key : op_->GetLeftMergeKeys()) {
+    auto key_translator = TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+    ast::Expr *key_not_null = codegen_->IsSqlNotNull(key_translator->DeriveExpr(this));
+    not_null = not_null == nullptr ? key_not_null
+                                   : codegen_->BinaryOp(parsing::Token::Type::AND, not_null, key_not_null);
+  }
+  builder->StartIfStmt(not_null);
+
+  // var merge_row = @ptrCast(*MergeRow, @sorterInsert(&state.merge_sorter))
+  // In parallel pipelines, the thread-local sorter is used instead.
+  ast::Expr *sorter_ptr =
+      parallelized_pipeline_ ? codegen_->GetThreadStateMemberPtr(sorter_) : codegen_->GetStateMemberPtr(sorter_);
+  ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::SorterInsert, {sorter_ptr});
+  builder->Append(codegen_->DeclareVariable(merge_row_, nullptr, codegen_->PtrCast(merge_struct_, insert_call)));
+
+  // Fill up the merge row
+  for (uint32_t attr_idx = 0; attr_idx < op_->GetChild(0)->GetOutputSchema()->GetColumns().size(); attr_idx++) {
+    builder->Append(codegen_->Assign(GetOutput(attr_idx), child_translator_->GetOutput(attr_idx)));
+  }
+  builder->FinishBlockStmt();
+}
+
+void MergeJoinLeftTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
+  // merge_sorter: Sorter
+  ast::Expr *sorter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Sorter);
+  state_fields->emplace_back(codegen_->MakeField(sorter_, sorter_type));
+}
+
+void MergeJoinLeftTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
+  util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
+  GetChildOutputFields(&fields, LEFT_ATTR_NAME);
+  decls->emplace_back(codegen_->MakeStruct(merge_struct_, std::move(fields)));
+}
+
+void MergeJoinLeftTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  // Make a function (lhs *MergeRow, rhs *MergeRow) -> int32
+  ast::FieldDecl *lhs = codegen_->MakeField(comp_lhs_, codegen_->PointerType(merge_struct_));
+  ast::FieldDecl *rhs = codegen_->MakeField(comp_rhs_, codegen_->PointerType(merge_struct_));
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Int32);
+  util::RegionVector<ast::FieldDecl *> params{{lhs, rhs}, codegen_->Region()};
+  FunctionBuilder builder{codegen_, comp_fn_, std::move(params), ret_type};
+  GenComparisons(&builder);
+  decls->push_back(builder.Finish());
+}
+
+void MergeJoinLeftTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
+  setup_stmts->emplace_back(codegen_->MakeStmt(SorterInitCall(codegen_->GetStateMemberPtr(sorter_))));
+}
+
+void MergeJoinLeftTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  // @sorterFree(&state.merge_sorter)
+  ast::Expr *free_call = codegen_->OneArgStateCall(ast::Builtin::SorterFree, sorter_);
+  teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+void MergeJoinLeftTranslator::InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) {
+  // merge_sorter: Sorter
+  ast::Expr *sorter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Sorter);
+  thread_state_fields->emplace_back(codegen_->MakeField(sorter_, sorter_type));
+}
+
+void MergeJoinLeftTranslator::InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(SorterInitCall(codegen_->GetThreadStateMemberPtr(sorter_))));
+}
+
+void MergeJoinLeftTranslator::InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  // @sorterFree(&threadState.merge_sorter)
+  ast::Expr *free_call = codegen_->BuiltinCall(ast::Builtin::SorterFree, {codegen_->GetThreadStateMemberPtr(sorter_)});
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+// @sorterSortParallel(&state.merge_sorter, &state.thread_states, @offsetOf(ThreadState, merge_sorter))
+void MergeJoinLeftTranslator::FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {
+  std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(sorter_), thread_states,
+                                codegen_->OffsetOf(thread_state_type_, sorter_)};
+  ast::Expr *sort_call = codegen_->BuiltinCall(ast::Builtin::SorterSortParallel, std::move(args));
+  builder->Append(codegen_->MakeStmt(sort_call));
+}
+
+ast::Expr *MergeJoinLeftTranslator::SorterInitCall(ast::Expr *sorter) {
+  // @sorterInit(sorter, @execCtxGetMem(execCtx), mergeSortFn, @sizeOf(MergeRow))
+  std::vector<ast::Expr *> init_args{sorter, codegen_->ExecCtxGetMem(), codegen_->MakeExpr(comp_fn_),
+                                     codegen_->SizeOf(merge_struct_)};
+  return codegen_->BuiltinCall(ast::Builtin::SorterInit, std::move(init_args));
+}
+
+void MergeJoinLeftTranslator::GenComparisons(FunctionBuilder *builder) {
+  // For each left key:
+  // if (lhs.key_i < rhs.key_i) {return -1}
+  // if (lhs.key_i > rhs.key_i) {return 1}
+  // ...
+  // return 0
+  for (const auto &key : op_->GetLeftMergeKeys()) {
+    auto key_translator = TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+    int32_t ret_value = -1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      current_row_ = CurrentRow::Lhs;
+      ast::Expr *lhs_key = key_translator->DeriveExpr(this);
+      current_row_ = CurrentRow::Rhs;
+      ast::Expr *rhs_key = key_translator->DeriveExpr(this);
+      builder->StartIfStmt(codegen_->Compare(tok, lhs_key, rhs_key));
+      builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(ret_value)));
+      builder->FinishBlockStmt();
+      ret_value = -ret_value;
+    }
+  }
+  current_row_ = CurrentRow::Child;
+  builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(0)));
+}
+
+ast::Expr *MergeJoinLeftTranslator::GetAttribute(ast::Identifier object, uint32_t attr_idx) {
+  ast::Identifier member = codegen_->Context()->GetIdentifier(LEFT_ATTR_NAME + std::to_string(attr_idx));
+  return codegen_->MemberExpr(object, member);
+}
+
+ast::Expr *MergeJoinLeftTranslator::GetOutput(uint32_t attr_idx) { return GetAttribute(merge_row_, attr_idx); }
+
+ast::Expr *MergeJoinLeftTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
+  // Pass through to the child, or read either side of the comparison function
+  if (current_row_ == CurrentRow::Child) {
+    return child_translator_->GetOutput(attr_idx);
+  }
+  return GetAttribute(current_row_ == CurrentRow::Lhs ? comp_lhs_ : comp_rhs_, attr_idx);
+}
+
+////////////////////////////////////////
+//// Right translator
+////////////////////////////////////////
+
+MergeJoinRightTranslator::MergeJoinRightTranslator(const terrier::planner::MergeJoinPlanNode *op,
+                                                   execution::compiler::CodeGen *codegen,
+                                                   execution::compiler::OperatorTranslator *left)
+    : OperatorTranslator{codegen, brain::ExecutionOperatingUnitType::MERGEJOIN_PROBE},
+      op_(op),
+      left_(dynamic_cast<MergeJoinLeftTranslator *>(left)),
+      keys_struct_{codegen->NewIdentifier("MergeKeys")},
+      keys_{codegen->NewIdentifier("merge_keys")},
+      comp_fn_{codegen->NewIdentifier("mergeKeyCmpFn")},
+      num_rows_{codegen->NewIdentifier("merge_num_rows")},
+      lo_{codegen->NewIdentifier("merge_lo")},
+      hi_{codegen->NewIdentifier("merge_hi")},
+      match_idx_{codegen->NewIdentifier("merge_idx")} {}
+
+void MergeJoinRightTranslator::Produce(FunctionBuilder *builder) {
+  // Declare the cursors
+  DeclareCursors(builder);
+  // Let right child produce its code
+  child_translator_->Produce(builder);
+}
+
+void MergeJoinRightTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
+
+void MergeJoinRightTranslator::Consume(FunctionBuilder *builder) {
+  // Materialize the right keys
+  FillKeys(builder);
+  // NULL keys never match
+  builder->StartIfStmt(KeysNotNull());
+  // Move the cursors to the matching range of left tuples
+  switch (op_->GetKeyComparison()) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      GenAdvanceCursor(builder, lo_, parsing::Token::Type::LESS);
+      GenAdvanceCursor(builder, hi_, parsing::Token::Type::LESS_EQUAL);
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      GenAdvanceCursor(builder, hi_, parsing::Token::Type::LESS);
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      GenAdvanceCursor(builder, hi_, parsing::Token::Type::LESS_EQUAL);
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      GenAdvanceCursor(builder, lo_, parsing::Token::Type::LESS_EQUAL);
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      GenAdvanceCursor(builder, lo_, parsing::Token::Type::LESS);
+      break;
+    default:
+      UNREACHABLE("Unsupported merge join key comparison");
+  }
+  // Loop over the matches
+  GenMatchLoop(builder);
+  DeclareMatch(builder);
+  // Check the join predicate
+  if (op_->GetJoinPredicate() != nullptr) {
+    auto pred_translator = TranslatorFactory::CreateExpressionTranslator(op_->GetJoinPredicate().Get(), codegen_);
+    builder->StartIfStmt(pred_translator->DeriveExpr(this));
+  }
+  // Let the parent consume
+  parent_translator_->Consume(builder);
+  // Close if stmt
+  if (op_->GetJoinPredicate() != nullptr) {
+    builder->FinishBlockStmt();
+  }
+  // Close the loop and the NULL check
+  builder->FinishBlockStmt();
+  builder->FinishBlockStmt();
+}
+
+ast::Expr *MergeJoinRightTranslator::GetOutput(uint32_t attr_idx) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  std::unique_ptr<ExpressionTranslator> translator =
+      TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+
+ast::Expr *MergeJoinRightTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx,
+                                                    terrier::type::TypeId type) {
+  TERRIER_ASSERT(child_idx <= 1, "A merge join can only have two children.");
+  // For the left child, get the output of the current left tuple
+  if (child_idx == 0) {
+    return left_->GetOutput(attr_idx);
+  }
+  return child_translator_->GetOutput(attr_idx);
+}
+
+ast::Expr *MergeJoinRightTranslator::GetKey(uint32_t key_idx) {
+  ast::Identifier member = codegen_->Context()->GetIdentifier(KEY_ATTR_NAME + std::to_string(key_idx));
+  return codegen_->MemberExpr(keys_, member);
+}
+
+// Declare the struct holding the right keys
+void MergeJoinRightTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
+  util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
+  uint32_t key_idx = 0;
+  for (const auto &key : op_->GetRightMergeKeys()) {
+    ast::Identifier field_name = codegen_->Context()->GetIdentifier(KEY_ATTR_NAME + std::to_string(key_idx++));
+    fields.emplace_back(codegen_->MakeField(field_name, codegen_->TplType(key->GetReturnValueType())));
+  }
+  decls->emplace_back(codegen_->MakeStruct(keys_struct_, std::move(fields)));
+}
+
+// Declare a function comparing the keys of a left tuple to the right keys
+void MergeJoinRightTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  // Generate the function type (*MergeRow, *MergeKeys) -> int32
+  ast::FieldDecl *param1 = codegen_->MakeField(left_->merge_row_, codegen_->PointerType(left_->merge_struct_));
+  ast::FieldDecl *param2 = codegen_->MakeField(keys_, codegen_->PointerType(keys_struct_));
+  util::RegionVector<ast::FieldDecl *> params({param1, param2}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Int32);
+
+  FunctionBuilder builder(codegen_, comp_fn_, std::move(params), ret_type);
+  // Fill up the function
+  GenKeyComparison(&builder);
+  // Add it to top level declarations
+  decls->emplace_back(builder.Finish());
+}
+
+void MergeJoinRightTranslator::GenKeyComparison(FunctionBuilder *builder) {
+  // For each key:
+  // if (merge_row.left_key_i < merge_keys.key_i) {return -1}
+  // if (merge_row.left_key_i > merge_keys.key_i) {return 1}
+  // ...
+  // return 0
+  uint32_t key_idx = 0;
+  for (const auto &key : op_->GetLeftMergeKeys()) {
+    auto key_translator = TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+    int32_t ret_value = -1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      builder->StartIfStmt(codegen_->Compare(tok, key_translator->DeriveExpr(this), GetKey(key_idx)));
+      builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(ret_value)));
+      builder->FinishBlockStmt();
+      ret_value = -ret_value;
+    }
+    key_idx++;
+  }
+  builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(0)));
+}
+
+// var merge_num_rows = @sorterGetTupleCount(&state.merge_sorter)
+// var merge_lo: uint64 = 0
+// var merge_hi: uint64 = 0, or merge_num_rows when every tuple after merge_lo matches
+void MergeJoinRightTranslator::DeclareCursors(FunctionBuilder *builder) {
+  ast::Expr *count_call = codegen_->OneArgStateCall(ast::Builtin::SorterGetTupleCount, left_->sorter_);
+  builder->Append(codegen_->DeclareVariable(num_rows_, nullptr, count_call));
+  builder->Append(
+      codegen_->DeclareVariable(lo_, codegen_->BuiltinType(ast::BuiltinType::Kind::Uint64), codegen_->IntLiteral(0)));
+  const auto key_comparison = op_->GetKeyComparison();
+  const bool unbounded_hi = key_comparison == parser::ExpressionType::COMPARE_GREATER_THAN ||
+                            key_comparison == parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO;
+  ast::Expr *hi_init = unbounded_hi ? codegen_->MakeExpr(num_rows_) : codegen_->IntLiteral(0);
+  builder->Append(codegen_->DeclareVariable(hi_, codegen_->BuiltinType(ast::BuiltinType::Kind::Uint64), hi_init));
+}
+
+// var merge_keys: MergeKeys
+// merge_keys.key_i = right_key_i
+void MergeJoinRightTranslator::FillKeys(FunctionBuilder *builder) {
+  builder->Append(codegen_->DeclareVariable(keys_, codegen_->MakeExpr(keys_struct_), nullptr));
+  uint32_t key_idx = 0;
+  for (const auto &key : op_->GetRightMergeKeys()) {
+    auto key_translator = TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+    builder->Append(codegen_->Assign(GetKey(key_idx++), key_translator->DeriveExpr(this)));
+  }
+}
+
+// @isSqlNotNull(merge_keys.key1) and @isSqlNotNull(merge_keys.key2) ...
+ast::Expr *MergeJoinRightTranslator::KeysNotNull() {
+  ast::Expr *not_null = codegen_->IsSqlNotNull(GetKey(0));
+  for (uint32_t key_idx = 1; key_idx < op_->GetRightMergeKeys().size(); key_idx++) {
+    not_null = codegen_->BinaryOp(parsing::Token::Type::AND, not_null, codegen_->IsSqlNotNull(GetKey(key_idx)));
+  }
+  return not_null;
+}
+
+// for (; cursor < merge_num_rows
+//        and mergeKeyCmpFn(@ptrCast(*MergeRow, @sorterGetTupleAt(&state.merge_sorter, cursor)), &merge_keys) CMP 0;
+//      cursor = cursor + 1) {}
+void MergeJoinRightTranslator::GenAdvanceCursor(FunctionBuilder *builder, ast::Identifier cursor,
+                                                parsing::Token::Type comparison) {
+  ast::Expr *in_bounds = codegen_->Compare(parsing::Token::Type::LESS, codegen_->MakeExpr(cursor),
+                                           codegen_->MakeExpr(num_rows_));
+  std::vector<ast::Expr *> get_args{codegen_->GetStateMemberPtr(left_->sorter_), codegen_->MakeExpr(cursor)};
+  ast::Expr *get_call = codegen_->BuiltinCall(ast::Builtin::SorterGetTupleAt, std::move(get_args));
+  ast::Expr *left_row = codegen_->PtrCast(left_->merge_struct_, get_call);
+  ast::Expr *cmp_call = codegen_->Call(comp_fn_, {left_row, codegen_->PointerTo(keys_)});
+  ast::Expr *before = codegen_->Compare(comparison, cmp_call, codegen_->IntLiteral(0));
+  ast::Expr *cond = codegen_->BinaryOp(parsing::Token::Type::AND, in_bounds, before);
+  ast::Expr *incr = codegen_->BinaryOp(parsing::Token::Type::PLUS, codegen_->MakeExpr(cursor), codegen_->IntLiteral(1));
+  builder->StartForStmt(nullptr, cond, codegen_->Assign(codegen_->MakeExpr(cursor), incr));
+  builder->FinishBlockStmt();
+}
+
+// for (var merge_idx = merge_lo; merge_idx < merge_hi; merge_idx = merge_idx + 1) {...}
+void MergeJoinRightTranslator::GenMatchLoop(FunctionBuilder *builder) {
+  ast::Stmt *init = codegen_->DeclareVariable(match_idx_, nullptr, codegen_->MakeExpr(lo_));
+  ast::Expr *cond = codegen_->Compare(parsing::Token::Type::LESS, codegen_->MakeExpr(match_idx_),
+                                      codegen_->MakeExpr(hi_));
+  ast::Expr *incr =
+      codegen_->BinaryOp(parsing::Token::Type::PLUS, codegen_->MakeExpr(match_idx_), codegen_->IntLiteral(1));
+  builder->StartForStmt(init, cond, codegen_->Assign(codegen_->MakeExpr(match_idx_), incr));
+}
+
+// var merge_row = @ptrCast(*MergeRow, @sorterGetTupleAt(&state.merge_sorter, merge_idx))
+void MergeJoinRightTranslator::DeclareMatch(FunctionBuilder *builder) {
+  std::vector<ast::Expr *> get_args{codegen_->GetStateMemberPtr(left_->sorter_), codegen_->MakeExpr(match_idx_)};
+  ast::Expr *get_call = codegen_->BuiltinCall(ast::Builtin::SorterGetTupleAt, std::move(get_args));
+  ast::Expr *cast_call = codegen_->PtrCast(left_->merge_struct_, get_call);
+  builder->Append(codegen_->DeclareVariable(left_->merge_row_, nullptr, cast_call));
+}
+}  // namespace terrier::execution::compiler
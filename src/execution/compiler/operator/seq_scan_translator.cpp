@@ -1,11 +1,15 @@
 #include "execution/compiler/operator/seq_scan_translator.h"
 
 #include <utility>
+#include <vector>
 #include "execution/ast/type.h"
 #include "execution/compiler/codegen.h"
+#include "execution/compiler/constant_lifter.h"
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/translator_factory.h"
+#include "execution/sql/table_vector_iterator.h"
+#include "parser/expression/column_value_expression.h"
 #include "parser/expression/constant_value_expression.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 
@@ -18,14 +22,21 @@ SeqScanTranslator::SeqScanTranslator(const terrier::planner::SeqScanPlanNode *op
       input_oids_(MakeInputOids(schema_, op_)),
       pm_(codegen->Accessor()->GetTable(op_->GetTableOid())->ProjectionMapForOids(input_oids_)),
       has_predicate_(op_->GetScanPredicate() != nullptr),
-      is_vectorizable_{IsVectorizable(op_->GetScanPredicate().Get())},
       tvi_(codegen->NewIdentifier("tvi")),
       col_oids_(codegen->NewIdentifier("col_oids")),
       pci_(codegen->NewIdentifier("pci")),
       slot_(codegen->NewIdentifier("slot")),
-      pci_type_{codegen->Context()->GetIdentifier("ProjectedColumnsIterator")} {}
+      pci_type_{codegen->Context()->GetIdentifier("ProjectedColumnsIterator")} {
+  is_vectorizable_ = has_predicate_ && CollectVectorizedFilters(op_->GetScanPredicate().Get());
+}
 
 void SeqScanTranslator::Produce(FunctionBuilder *builder) {
+  // In parallel pipelines, the iterator is a parameter of the worker function.
+  if (parallelized_pipeline_) {
+    DoTableScan(builder);
+    return;
+  }
+
   SetOids(builder);
   DeclareTVI(builder);
 
@@ -42,27 +53,47 @@ void SeqScanTranslator::Produce(FunctionBuilder *builder) {
   GenTVIClose(builder);
 }
 
+ast::FieldDecl *SeqScanTranslator::GetParallelWorkParam() {
+  ast::Expr *iter_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::Kind::TableVectorIterator));
+  return codegen_->MakeField(tvi_, iter_type);
+}
+
+void SeqScanTranslator::LaunchParallelWork(FunctionBuilder *builder, ast::Expr *thread_states,
+                                           ast::Identifier work_fn) {
+  SetOids(builder);
+  // @iterateTableParallel(table_oid, col_oids, state, execCtx, &state.thread_states, work_fn)
+  std::vector<ast::Expr *> args{codegen_->IntLiteral(!op_->GetTableOid()),
+                                codegen_->MakeExpr(col_oids_),
+                                codegen_->MakeExpr(codegen_->GetStateVar()),
+                                codegen_->MakeExpr(codegen_->GetExecCtxVar()),
+                                thread_states,
+                                codegen_->MakeExpr(work_fn)};
+  ast::Expr *scan_call = codegen_->BuiltinCall(ast::Builtin::TableIterParallel, std::move(args));
+  builder->Append(codegen_->MakeStmt(scan_call));
+}
+
 void SeqScanTranslator::Abort(FunctionBuilder *builder) {
-  // Close iterator
-  GenTVIClose(builder);
+  // Close iterator. Parallel workers do not own theirs.
+  if (!parallelized_pipeline_) GenTVIClose(builder);
   if (child_translator_ != nullptr) child_translator_->Abort(builder);
 }
 
 void SeqScanTranslator::DoTableScan(FunctionBuilder *builder) {
+  // Let the iterator skip the blocks that cannot satisfy the predicate
+  if (has_predicate_) GenRestrictRanges(builder, op_->GetScanPredicate().Get());
   // Start looping over the table
   GenTVILoop(builder);
   DeclarePCI(builder);
-  // The PCI loop depends on whether we vectorize or not.
+  // Runtime join filters are cheap and often selective, so they run first.
+  GenJoinFilters(builder);
+  // Comparisons of columns with constants run as vectorized filters, which work directly on the encoded columns of
+  // frozen blocks. The rest of the predicate is checked a tuple at a time.
+  GenVectorizedPredicate(builder);
+  GenPCILoop(builder);
   bool has_if_stmt = false;
-  if (is_vectorizable_) {
-    if (has_predicate_) GenVectorizedPredicate(builder, op_->GetScanPredicate().Get());
-    GenPCILoop(builder);
-  } else {
-    GenPCILoop(builder);
-    if (has_predicate_) {
-      GenScanCondition(builder);
-      has_if_stmt = true;
-    }
+  if (has_predicate_ && !is_vectorizable_) {
+    GenScanCondition(builder);
+    has_if_stmt = true;
   }
   // Declare Slot.
   DeclareSlot(builder);
@@ -125,13 +156,13 @@ void SeqScanTranslator::SetOids(FunctionBuilder *builder) {
 // Generate for(@tableIterAdvance(&tvi)) {...}
 void SeqScanTranslator::GenTVILoop(FunctionBuilder *builder) {
   // The advance call
-  ast::Expr *advance_call = codegen_->OneArgCall(ast::Builtin::TableIterAdvance, tvi_, true);
+  ast::Expr *advance_call = codegen_->OneArgCall(ast::Builtin::TableIterAdvance, tvi_, !parallelized_pipeline_);
   builder->StartForStmt(nullptr, advance_call, nullptr);
 }
 
 void SeqScanTranslator::DeclarePCI(FunctionBuilder *builder) {
   // Assign var pci = @tableIterGetPCI(&tvi)
-  ast::Expr *get_pci_call = codegen_->OneArgCall(ast::Builtin::TableIterGetPCI, tvi_, true);
+  ast::Expr *get_pci_call = codegen_->OneArgCall(ast::Builtin::TableIterGetPCI, tvi_, !parallelized_pipeline_);
   builder->Append(codegen_->DeclareVariable(pci_, nullptr, get_pci_call));
 }
 
@@ -144,18 +175,69 @@ void SeqScanTranslator::DeclareSlot(FunctionBuilder *builder) {
 void SeqScanTranslator::GenPCILoop(FunctionBuilder *builder) {
   // Generate for(; @pciHasNext(pci); @pciAdvance(pci)) {...} or the Filtered version
   // The HasNext call
-  ast::Builtin has_next_fn =
-      (is_vectorizable_ && has_predicate_) ? ast::Builtin::PCIHasNextFiltered : ast::Builtin::PCIHasNext;
+  ast::Builtin has_next_fn = IsPCIFiltered() ? ast::Builtin::PCIHasNextFiltered : ast::Builtin::PCIHasNext;
   ast::Expr *has_next_call = codegen_->OneArgCall(has_next_fn, pci_, false);
   // The Advance call
-  ast::Builtin advance_fn =
-      (is_vectorizable_ && has_predicate_) ? ast::Builtin::PCIAdvanceFiltered : ast::Builtin::PCIAdvance;
+  ast::Builtin advance_fn = IsPCIFiltered() ? ast::Builtin::PCIAdvanceFiltered : ast::Builtin::PCIAdvance;
   ast::Expr *advance_call = codegen_->OneArgCall(advance_fn, pci_, false);
   ast::Stmt *loop_advance = codegen_->MakeStmt(advance_call);
   // Make the for loop.
   builder->StartForStmt(nullptr, has_next_call, loop_advance);
 }
 
+void SeqScanTranslator::GenJoinFilters(FunctionBuilder *builder) {
+  for (const auto &[col_oid, join_ht] : join_filters_) {
+    // @filterJoin(pci, col_idx, col_type, &state.join_ht)
+    auto col_type = schema_.GetColumn(col_oid).Type();
+    std::vector<ast::Expr *> args{codegen_->MakeExpr(pci_), codegen_->IntLiteral(pm_[col_oid]),
+                                  codegen_->IntLiteral(static_cast<int8_t>(col_type)),
+                                  codegen_->GetStateMemberPtr(join_ht)};
+    ast::Expr *filter_call = codegen_->BuiltinCall(ast::Builtin::FilterJoin, std::move(args));
+    builder->Append(codegen_->MakeStmt(filter_call));
+  }
+}
+
+void SeqScanTranslator::GenRestrictRanges(FunctionBuilder *builder, const parser::AbstractExpression *predicate) {
+  if (predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+    GenRestrictRanges(builder, predicate->GetChild(0).Get());
+    GenRestrictRanges(builder, predicate->GetChild(1).Get());
+    return;
+  }
+  const parser::ColumnValueExpression *column;
+  const parser::ConstantValueExpression *constant;
+  parser::ExpressionType comparison;
+  if (!MatchColumnComparison(predicate, &column, &constant, &comparison)) return;
+  auto col_oid = column->GetColumnOid();
+  if (pm_.count(col_oid) == 0) return;
+  auto col_type = schema_.GetColumn(col_oid).Type();
+  ast::Expr *tvi = parallelized_pipeline_ ? codegen_->MakeExpr(tvi_) : codegen_->PointerTo(tvi_);
+
+  // A lifted constant is only known when the query runs, and may differ between runs of the same code
+  const uint32_t slot =
+      codegen_->Lifter() == nullptr ? ConstantLifter::NOT_LIFTED : codegen_->Lifter()->SlotOf(constant);
+  if (slot != ConstantLifter::NOT_LIFTED) {
+    // @tableIterRestrictRangeToParam(tvi, col_idx, col_type, comparison, param_idx)
+    std::vector<ast::Expr *> args{tvi, codegen_->IntLiteral(pm_[col_oid]),
+                                  codegen_->IntLiteral(static_cast<int8_t>(col_type)),
+                                  codegen_->IntLiteral(static_cast<int8_t>(comparison)), codegen_->IntLiteral(slot)};
+    ast::Expr *restrict_call = codegen_->BuiltinCall(ast::Builtin::TableIterRestrictRangeToParam, std::move(args));
+    builder->Append(codegen_->MakeStmt(restrict_call));
+    return;
+  }
+
+  // The range of values that can satisfy the comparison
+  int64_t value, min, max;
+  if (!sql::TableVectorIterator::ValueAsInteger(col_type, constant->GetValue(), &value)) return;
+  if (!sql::TableVectorIterator::ComparisonRange(comparison, value, &min, &max)) return;
+
+  // @tableIterRestrictRange(tvi, col_idx, col_type, min, max)
+  std::vector<ast::Expr *> args{tvi, codegen_->IntLiteral(pm_[col_oid]),
+                                codegen_->IntLiteral(static_cast<int8_t>(col_type)), codegen_->IntLiteral(min),
+                                codegen_->IntLiteral(max)};
+  ast::Expr *restrict_call = codegen_->BuiltinCall(ast::Builtin::TableIterRestrictRange, std::move(args));
+  builder->Append(codegen_->MakeStmt(restrict_call));
+}
+
 void SeqScanTranslator::GenScanCondition(FunctionBuilder *builder) {
   // Generate tuple at a time scan condition
   auto predicate = op_->GetScanPredicate();
@@ -176,61 +258,131 @@ void SeqScanTranslator::GenTVIReset(execution::compiler::FunctionBuilder *builde
   builder->Append(codegen_->MakeStmt(reset_call));
 }
 
-bool SeqScanTranslator::IsVectorizable(const terrier::parser::AbstractExpression *predicate) {
-  // TODO(Amadou): Does not currently work with negative numbers so it's commented out.
-  // Once that bug is fixed, comment back in.
-  /*
-  // Recursively walks down the query plan to ensure that predicate has the form ((colX comp int) AND (colY comp int)
-  ...) if (predicate == nullptr) return true;
-
-  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_AND) {
-    return IsVectorizable(predicate->GetChild(0).Get()) && IsVectorizable(predicate->GetChild(1).Get());
-  }
-  if (TranslatorFactory::IsComparisonOp(predicate->GetExpressionType())) {
-    // left is TVE and right is constant integer.
-    // TODO(Amadou): Add support for floats here and in the SIMD code.
-    // TODO(Amadou): Support right TVE and left constant integers. Be sure to flip inequalities while codegening.
-    return predicate->GetChild(0)->GetExpressionType() == terrier::parser::ExpressionType::COLUMN_VALUE &&
-        predicate->GetChild(1)->GetExpressionType() == terrier::parser::ExpressionType::VALUE_CONSTANT &&
-        (predicate->GetChild(1)->GetReturnValueType() >= terrier::type::TypeId::TINYINT &&
-            predicate->GetChild(1)->GetReturnValueType() <= terrier::type::TypeId::BIGINT);
-  }*/
-  return false;
-}
-
-void SeqScanTranslator::GenVectorizedPredicate(FunctionBuilder *builder,
-                                               const terrier::parser::AbstractExpression *predicate) {
-  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_AND) {
-    GenVectorizedPredicate(builder, predicate->GetChild(0).Get());
-    GenVectorizedPredicate(builder, predicate->GetChild(1).Get());
-  } else if (TranslatorFactory::IsComparisonOp(predicate->GetExpressionType())) {
-    auto left_cve = dynamic_cast<const terrier::parser::ColumnValueExpression *>(predicate->GetChild(0).Get());
-    auto col_idx = pm_[left_cve->GetColumnOid()];
-    auto col_type = schema_.GetColumn(left_cve->GetColumnOid()).Type();
-    auto const_val = dynamic_cast<const terrier::parser::ConstantValueExpression *>(predicate->GetChild(1).Get());
-    auto trans_val = const_val->GetValue();
-    auto type = trans_val.Type();
-    ast::Expr *filter_val;
-    switch (type) {
-      case terrier::type::TypeId::TINYINT:
-        filter_val = codegen_->IntLiteral(terrier::type::TransientValuePeeker::PeekTinyInt(trans_val));
+bool SeqScanTranslator::CollectVectorizedFilters(const parser::AbstractExpression *predicate) {
+  if (predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+    // Both sides are collected, even if the left one cannot be fully vectorized
+    const bool left = CollectVectorizedFilters(predicate->GetChild(0).Get());
+    const bool right = CollectVectorizedFilters(predicate->GetChild(1).Get());
+    return left && right;
+  }
+  const parser::ColumnValueExpression *column;
+  const parser::ConstantValueExpression *constant;
+  parser::ExpressionType comparison;
+  if (!MatchColumnComparison(predicate, &column, &constant, &comparison)) return false;
+  auto col_oid = column->GetColumnOid();
+  if (pm_.count(col_oid) == 0) return false;
+
+  auto col_type = schema_.GetColumn(col_oid).Type();
+  if (col_type != type::TypeId::VARCHAR && (col_type < type::TypeId::TINYINT || col_type > type::TypeId::BIGINT)) {
+    return false;
+  }
+
+  // A lifted constant is only known when the query runs, and may differ between runs of the same code. Its filter is
+  // skipped when the value cannot be compared in the column's type, so the predicate is still checked afterwards.
+  const uint32_t slot =
+      codegen_->Lifter() == nullptr ? ConstantLifter::NOT_LIFTED : codegen_->Lifter()->SlotOf(constant);
+  if (slot != ConstantLifter::NOT_LIFTED) {
+    vectorized_filters_.push_back({col_oid, comparison, constant, slot});
+    return false;
+  }
+
+  const auto &value = constant->GetValue();
+  if (value.Null()) return false;
+  if (col_type == type::TypeId::VARCHAR) {
+    if (value.Type() != type::TypeId::VARCHAR) return false;
+  } else {
+    // Integer filters compare in the column's type, so the constant must fit in it
+    int64_t val;
+    if (!sql::TableVectorIterator::ValueAsInteger(col_type, value, &val)) return false;
+    switch (col_type) {
+      case type::TypeId::TINYINT:
+        if (val != static_cast<int8_t>(val)) return false;
         break;
-      case terrier::type::TypeId::SMALLINT:
-        filter_val = codegen_->IntLiteral(terrier::type::TransientValuePeeker::PeekSmallInt(trans_val));
+      case type::TypeId::SMALLINT:
+        if (val != static_cast<int16_t>(val)) return false;
         break;
-      case terrier::type::TypeId::INTEGER:
-        filter_val = codegen_->IntLiteral(terrier::type::TransientValuePeeker::PeekInteger(trans_val));
+      case type::TypeId::INTEGER:
+        if (val != static_cast<int32_t>(val)) return false;
         break;
-      case terrier::type::TypeId::BIGINT:
-        filter_val =
-            codegen_->IntLiteral(static_cast<int32_t>(terrier::type::TransientValuePeeker::PeekBigInt(trans_val)));
+      default:
+        break;
+    }
+  }
+  vectorized_filters_.push_back({col_oid, comparison, constant, slot});
+  return true;
+}
+
+bool SeqScanTranslator::MatchColumnComparison(const parser::AbstractExpression *predicate,
+                                              const parser::ColumnValueExpression **column,
+                                              const parser::ConstantValueExpression **constant,
+                                              parser::ExpressionType *comparison) {
+  if (!TranslatorFactory::IsComparisonOp(predicate->GetExpressionType()) || predicate->GetChildrenSize() != 2) {
+    return false;
+  }
+
+  // Look for a column compared to a constant, on either side
+  *comparison = predicate->GetExpressionType();
+  const parser::AbstractExpression *left = predicate->GetChild(0).Get();
+  const parser::AbstractExpression *right = predicate->GetChild(1).Get();
+  if (left->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT) {
+    std::swap(left, right);
+    switch (*comparison) {
+      case parser::ExpressionType::COMPARE_LESS_THAN:
+        *comparison = parser::ExpressionType::COMPARE_GREATER_THAN;
+        break;
+      case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+        *comparison = parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO;
+        break;
+      case parser::ExpressionType::COMPARE_GREATER_THAN:
+        *comparison = parser::ExpressionType::COMPARE_LESS_THAN;
+        break;
+      case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+        *comparison = parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO;
         break;
       default:
-        UNREACHABLE("Impossible vectorized predicate!");
+        break;
+    }
+  }
+  if (left->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE ||
+      right->GetExpressionType() != parser::ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+  *column = static_cast<const parser::ColumnValueExpression *>(left);
+  *constant = static_cast<const parser::ConstantValueExpression *>(right);
+  return true;
+}
+
+void SeqScanTranslator::GenVectorizedPredicate(FunctionBuilder *builder) {
+  for (const auto &filter : vectorized_filters_) {
+    auto col_type = schema_.GetColumn(filter.col_oid_).Type();
+    if (filter.param_idx_ != ConstantLifter::NOT_LIFTED) {
+      // @filterParam(pci, col_idx, col_type, comparison, execCtx, param_idx)
+      std::vector<ast::Expr *> args{codegen_->MakeExpr(pci_),
+                                    codegen_->IntLiteral(pm_[filter.col_oid_]),
+                                    codegen_->IntLiteral(static_cast<int8_t>(col_type)),
+                                    codegen_->IntLiteral(static_cast<int8_t>(filter.comparison_)),
+                                    codegen_->MakeExpr(codegen_->GetExecCtxVar()),
+                                    codegen_->IntLiteral(filter.param_idx_)};
+      ast::Expr *filter_call = codegen_->BuiltinCall(ast::Builtin::FilterParam, std::move(args));
+      builder->Append(codegen_->MakeStmt(filter_call));
+      continue;
+    }
+    const auto &value = filter.constant_->GetValue();
+    ast::Expr *filter_val;
+    if (col_type == type::TypeId::VARCHAR) {
+      // String filters take the address of the string, so it needs a variable
+      ast::Identifier filter_str = codegen_->NewIdentifier("filter_str");
+      ast::Expr *str = codegen_->StringToSql(type::TransientValuePeeker::PeekVarChar(value));
+      builder->Append(codegen_->DeclareVariable(filter_str, nullptr, str));
+      filter_val = codegen_->MakeExpr(filter_str);
+    } else {
+      int64_t val;
+      sql::TableVectorIterator::ValueAsInteger(col_type, value, &val);
+      filter_val = codegen_->IntLiteral(val);
     }
-    ast::Expr *filter_call = codegen_->PCIFilter(pci_, predicate->GetExpressionType(), col_idx, col_type, filter_val);
+    // @filterComp(pci, col_idx, col_type, filter_val)
+    ast::Expr *filter_call = codegen_->PCIFilter(pci_, filter.comparison_, pm_[filter.col_oid_], col_type, filter_val);
     builder->Append(codegen_->MakeStmt(filter_call));
   }
-  UNREACHABLE("This function should not be called on non vectorized predicates!");
 }
 }  // namespace terrier::execution::compiler
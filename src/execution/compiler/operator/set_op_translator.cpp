@@ -0,0 +1,348 @@
+#include "execution/compiler/operator/set_op_translator.h"
+#include <string>
+#include <utility>
+#include <vector>
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/translator_factory.h"
+
+namespace terrier::execution::compiler {
+
+namespace {
+// Identifier of the field of a hash table entry
+ast::Identifier EntryField(CodeGen *codegen, const char *prefix, uint32_t idx) {
+  return codegen->Context()->GetIdentifier(prefix + std::to_string(idx));
+}
+}  // namespace
+
+SetOpBottomTranslator::SetOpBottomTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen,
+                                             uint32_t child_idx, OperatorTranslator *first)
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_BUILD),
+      op_(op),
+      child_idx_(child_idx),
+      owner_(first == nullptr ? this : dynamic_cast<SetOpBottomTranslator *>(first)),
+      ht_(codegen->NewIdentifier("set_op_ht")),
+      entry_struct_(codegen->NewIdentifier("SetOpEntry")),
+      key_check_(codegen->NewIdentifier("setOpKeyCheckFn")),
+      entry_(codegen->NewIdentifier("set_op_entry")),
+      values_(codegen->NewIdentifier("set_op_values")),
+      hash_val_(codegen->NewIdentifier("set_op_hash_val")),
+      partial_(codegen->NewIdentifier("set_op_partial")),
+      merge_iter_(codegen->NewIdentifier("set_op_merge_iter")),
+      merge_fn_(codegen->NewIdentifier("setOpMerge")) {
+  TERRIER_ASSERT((child_idx == 0) == (first == nullptr), "Only the first input owns the hash table");
+}
+
+bool SetOpBottomTranslator::InsertsMissing() const {
+  // INTERSECT and EXCEPT only output tuples of the left input, so the right input only counts the ones it finds.
+  const auto set_op = op_->GetSetOp();
+  return child_idx_ == 0 || set_op == planner::SetOpType::UNION || set_op == planner::SetOpType::UNION_ALL;
+}
+
+void SetOpBottomTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
+  if (owner_ != this) return;
+  ast::Expr *ht_type = codegen_->BuiltinType(ast::BuiltinType::Kind::AggregationHashTable);
+  state_fields->emplace_back(codegen_->MakeField(ht_, ht_type));
+}
+
+void SetOpBottomTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
+  if (owner_ != this) return;
+  // The tuple, followed by the number of times each input produced it.
+  util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
+  GetChildOutputFields(&fields, KEY_ATTR_NAME);
+  ast::Expr *count_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Int64);
+  for (uint32_t i = 0; i < op_->GetChildrenSize(); i++) {
+    fields.emplace_back(codegen_->MakeField(EntryField(codegen_, COUNT_ATTR_NAME, i), count_type));
+  }
+  decls->emplace_back(codegen_->MakeStruct(entry_struct_, std::move(fields)));
+}
+
+void SetOpBottomTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  if (owner_ != this) return;
+  // Create a function (entry: *SetOpEntry, values: *SetOpEntry) -> bool
+  ast::FieldDecl *param1 = codegen_->MakeField(entry_, codegen_->PointerType(entry_struct_));
+  ast::FieldDecl *param2 = codegen_->MakeField(values_, codegen_->PointerType(entry_struct_));
+  util::RegionVector<ast::FieldDecl *> params({param1, param2}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Bool);
+  FunctionBuilder builder(codegen_, key_check_, std::move(params), ret_type);
+  // Compare every column of the tuples
+  for (uint32_t i = 0; i < op_->GetOutputSchema()->GetColumns().size(); i++) {
+    ast::Identifier key = EntryField(codegen_, KEY_ATTR_NAME, i);
+    ast::Expr *lhs = codegen_->MemberExpr(entry_, key);
+    ast::Expr *rhs = codegen_->MemberExpr(values_, key);
+    builder.StartIfStmt(codegen_->Compare(parsing::Token::Type::BANG_EQUAL, lhs, rhs));
+    builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(false)));
+    builder.FinishBlockStmt();
+  }
+  builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(true)));
+  decls->emplace_back(builder.Finish());
+}
+
+void SetOpBottomTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
+  if (owner_ != this) return;
+  ast::Expr *init_call = codegen_->HTInitCall(ast::Builtin::AggHashTableInit, ht_, entry_struct_);
+  setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+void SetOpBottomTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  if (owner_ != this) return;
+  ast::Expr *free_call = codegen_->OneArgStateCall(ast::Builtin::AggHashTableFree, ht_);
+  teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+void SetOpBottomTranslator::InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) {
+  ast::Expr *ht_type = codegen_->BuiltinType(ast::BuiltinType::Kind::AggregationHashTable);
+  thread_state_fields->emplace_back(codegen_->MakeField(owner_->ht_, ht_type));
+}
+
+void SetOpBottomTranslator::InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  ast::Expr *ht = codegen_->GetThreadStateMemberPtr(owner_->ht_);
+  ast::Expr *init_call = codegen_->HTInitCall(ast::Builtin::AggHashTableInit, ht, owner_->entry_struct_);
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+void SetOpBottomTranslator::InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  ast::Expr *ht = codegen_->GetThreadStateMemberPtr(owner_->ht_);
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::AggHashTableFree, ht)));
+}
+
+void SetOpBottomTranslator::InitializeThreadStateHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  // fun setOpMerge(state: *State, threadState: *ThreadState) -> nil
+  ast::FieldDecl *state_param =
+      codegen_->MakeField(codegen_->GetStateVar(), codegen_->PointerType(codegen_->GetStateType()));
+  ast::FieldDecl *thread_state_param =
+      codegen_->MakeField(codegen_->GetThreadStateVar(), codegen_->PointerType(thread_state_type_));
+  util::RegionVector<ast::FieldDecl *> params({state_param, thread_state_param}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Nil);
+  FunctionBuilder builder{codegen_, merge_fn_, std::move(params), ret_type};
+
+  // for (@aggHTIterInit(&iter, &threadState.ht); @aggHTIterHasNext(&iter); @aggHTIterNext(&iter)) {...}
+  ast::Expr *iter_type = codegen_->BuiltinType(ast::BuiltinType::AggregationHashTableIterator);
+  builder.Append(codegen_->DeclareVariable(merge_iter_, iter_type, nullptr));
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(merge_iter_),
+                                     codegen_->GetThreadStateMemberPtr(owner_->ht_)};
+  ast::Stmt *loop_init =
+      codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::AggHashTableIterInit, std::move(init_args)));
+  ast::Expr *has_next_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterHasNext, merge_iter_, true);
+  ast::Stmt *loop_update =
+      codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::AggHashTableIterNext, merge_iter_, true));
+  builder.StartForStmt(loop_init, has_next_call, loop_update);
+
+  // var partial = @ptrCast(*SetOpEntry, @aggHTIterGetRow(&iter))
+  ast::Expr *get_row_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterGetRow, merge_iter_, true);
+  builder.Append(codegen_->DeclareVariable(partial_, nullptr, codegen_->PtrCast(owner_->entry_struct_, get_row_call)));
+
+  // Find the tuple in the global hash table, and add this thread's count to it.
+  const bool insert_missing = InsertsMissing();
+  GenLookupOrInsert(&builder, codegen_->GetStateMemberPtr(owner_->ht_), partial_, codegen_->MakeExpr(partial_),
+                    insert_missing);
+  if (!insert_missing) {
+    builder.StartIfStmt(codegen_->Compare(parsing::Token::Type::BANG_EQUAL, codegen_->MakeExpr(owner_->entry_),
+                                          codegen_->NilLiteral()));
+  }
+  ast::Expr *sum = codegen_->BinaryOp(parsing::Token::Type::PLUS, GetCounter(owner_->entry_, child_idx_),
+                                      GetCounter(partial_, child_idx_));
+  builder.Append(codegen_->Assign(GetCounter(owner_->entry_, child_idx_), sum));
+  if (!insert_missing) {
+    builder.FinishBlockStmt();
+  }
+  // Close the loop, then the iterator
+  builder.FinishBlockStmt();
+  builder.Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::AggHashTableIterClose, merge_iter_, true)));
+  decls->emplace_back(builder.Finish());
+}
+
+void SetOpBottomTranslator::FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {
+  // @tlsIterate(&state.thread_states, state, setOpMerge)
+  std::vector<ast::Expr *> args{thread_states, codegen_->MakeExpr(codegen_->GetStateVar()),
+                                codegen_->MakeExpr(merge_fn_)};
+  ast::Expr *iterate_call = codegen_->BuiltinCall(ast::Builtin::ThreadStateContainerIterate, std::move(args));
+  builder->Append(codegen_->MakeStmt(iterate_call));
+}
+
+void SetOpBottomTranslator::Consume(FunctionBuilder *builder) {
+  // var values: SetOpEntry, holding the tuple to look for
+  builder->Append(codegen_->DeclareVariable(values_, codegen_->MakeExpr(owner_->entry_struct_), nullptr));
+  for (uint32_t i = 0; i < op_->GetOutputSchema()->GetColumns().size(); i++) {
+    ast::Expr *lhs = codegen_->MemberExpr(values_, EntryField(codegen_, KEY_ATTR_NAME, i));
+    builder->Append(codegen_->Assign(lhs, child_translator_->GetOutput(i)));
+  }
+
+  // Thread-local tables keep every tuple, since the global table is only complete once all of them are merged.
+  const bool insert_missing = parallelized_pipeline_ || InsertsMissing();
+  ast::Expr *ht = parallelized_pipeline_ ? codegen_->GetThreadStateMemberPtr(owner_->ht_)
+                                         : codegen_->GetStateMemberPtr(owner_->ht_);
+  GenLookupOrInsert(builder, ht, values_, codegen_->PointerTo(values_), insert_missing);
+
+  // Count the tuple: entry.count = entry.count + 1
+  if (!insert_missing) {
+    builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::BANG_EQUAL, codegen_->MakeExpr(owner_->entry_),
+                                           codegen_->NilLiteral()));
+  }
+  ast::Expr *incr =
+      codegen_->BinaryOp(parsing::Token::Type::PLUS, GetCounter(owner_->entry_, child_idx_), codegen_->IntLiteral(1));
+  builder->Append(codegen_->Assign(GetCounter(owner_->entry_, child_idx_), incr));
+  if (!insert_missing) {
+    builder->FinishBlockStmt();
+  }
+}
+
+void SetOpBottomTranslator::GenLookupOrInsert(FunctionBuilder *builder, ast::Expr *ht, ast::Identifier values,
+                                              ast::Expr *values_ptr, bool insert_missing) {
+  const uint32_t num_cols = op_->GetOutputSchema()->GetColumns().size();
+  // var hash_val = @hash(values.key0, ...)
+  std::vector<ast::Expr *> hash_args{};
+  for (uint32_t i = 0; i < num_cols; i++) {
+    hash_args.emplace_back(codegen_->MemberExpr(values, EntryField(codegen_, KEY_ATTR_NAME, i)));
+  }
+  ast::Expr *hash_call = codegen_->BuiltinCall(ast::Builtin::Hash, std::move(hash_args));
+  builder->Append(codegen_->DeclareVariable(hash_val_, nullptr, hash_call));
+
+  // var entry = @ptrCast(*SetOpEntry, @aggHTLookup(ht, hash_val, keyCheck, values))
+  std::vector<ast::Expr *> lookup_args{ht, codegen_->MakeExpr(hash_val_), codegen_->MakeExpr(owner_->key_check_),
+                                       values_ptr};
+  ast::Expr *lookup_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableLookup, std::move(lookup_args));
+  ast::Expr *cast_call = codegen_->PtrCast(owner_->entry_struct_, lookup_call);
+  builder->Append(codegen_->DeclareVariable(owner_->entry_, nullptr, cast_call));
+  if (!insert_missing) return;
+
+  // if (entry == nil) { entry = @ptrCast(*SetOpEntry, @aggHTInsert(ht, hash_val)); ... }
+  builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, codegen_->NilLiteral(),
+                                         codegen_->MakeExpr(owner_->entry_)));
+  std::vector<ast::Expr *> insert_args{ht, codegen_->MakeExpr(hash_val_)};
+  ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsert, std::move(insert_args));
+  builder->Append(
+      codegen_->Assign(codegen_->MakeExpr(owner_->entry_), codegen_->PtrCast(owner_->entry_struct_, insert_call)));
+  // Copy the tuple, and start all counts at zero
+  for (uint32_t i = 0; i < num_cols; i++) {
+    ast::Identifier key = EntryField(codegen_, KEY_ATTR_NAME, i);
+    builder->Append(codegen_->Assign(codegen_->MemberExpr(owner_->entry_, key), codegen_->MemberExpr(values, key)));
+  }
+  for (uint32_t i = 0; i < op_->GetChildrenSize(); i++) {
+    builder->Append(codegen_->Assign(GetCounter(owner_->entry_, i), codegen_->IntLiteral(0)));
+  }
+  builder->FinishBlockStmt();
+}
+
+ast::Expr *SetOpBottomTranslator::GetCounter(ast::Identifier entry, uint32_t child_idx) {
+  return codegen_->MemberExpr(entry, EntryField(codegen_, COUNT_ATTR_NAME, child_idx));
+}
+
+///////////////////////////////////////////////
+///// Top Translator
+///////////////////////////////////////////////
+
+void SetOpTopTranslator::Produce(FunctionBuilder *builder) {
+  // var iter: AggregationHashTableIterator
+  ast::Expr *iter_type = codegen_->BuiltinType(ast::BuiltinType::AggregationHashTableIterator);
+  builder->Append(codegen_->DeclareVariable(iterator_, iter_type, nullptr));
+  // In case of nested loop joins, let the child produce
+  if (child_translator_ != nullptr) {
+    child_translator_->Produce(builder);
+  } else {
+    // Otherwise directly consume the bottom's output
+    Consume(builder);
+  }
+}
+
+void SetOpTopTranslator::Consume(FunctionBuilder *builder) {
+  GenHTLoop(builder);
+  DeclareEntry(builder);
+  GenNumCopies(builder);
+  parent_translator_->Consume(builder);
+  // Close the copy loop or condition, if any
+  if (op_->GetSetOp() != planner::SetOpType::UNION) {
+    builder->FinishBlockStmt();
+  }
+  // Close HT loop
+  builder->FinishBlockStmt();
+  CloseIterator(builder);
+}
+
+void SetOpTopTranslator::Abort(FunctionBuilder *builder) {
+  CloseIterator(builder);
+  if (child_translator_ != nullptr) child_translator_->Abort(builder);
+}
+
+ast::Expr *SetOpTopTranslator::GetOutput(uint32_t attr_idx) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  auto translator = TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+
+ast::Expr *SetOpTopTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
+  return codegen_->MemberExpr(bottom_->entry_, EntryField(codegen_, SetOpBottomTranslator::KEY_ATTR_NAME, attr_idx));
+}
+
+void SetOpTopTranslator::GenHTLoop(FunctionBuilder *builder) {
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(iterator_), codegen_->GetStateMemberPtr(bottom_->ht_)};
+  ast::Stmt *loop_init =
+      codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::AggHashTableIterInit, std::move(init_args)));
+  ast::Expr *has_next_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterHasNext, iterator_, true);
+  ast::Stmt *loop_update =
+      codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::AggHashTableIterNext, iterator_, true));
+  builder->StartForStmt(loop_init, has_next_call, loop_update);
+}
+
+void SetOpTopTranslator::DeclareEntry(FunctionBuilder *builder) {
+  ast::Expr *get_row_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterGetRow, iterator_, true);
+  ast::Expr *cast_call = codegen_->PtrCast(bottom_->entry_struct_, get_row_call);
+  builder->Append(codegen_->DeclareVariable(bottom_->entry_, nullptr, cast_call));
+}
+
+void SetOpTopTranslator::GenNumCopies(FunctionBuilder *builder) {
+  auto count = [&](uint32_t child_idx) { return bottom_->GetCounter(bottom_->entry_, child_idx); };
+  auto num_copies = [&]() { return codegen_->MakeExpr(num_copies_); };
+  ast::Expr *int_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Int64);
+
+  // Only tuples of the left input are in the table of an INTERSECT or EXCEPT, so its count is never zero.
+  switch (op_->GetSetOp()) {
+    case planner::SetOpType::UNION:
+      // Every tuple is output once
+      return;
+    case planner::SetOpType::INTERSECT:
+      builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::GREATER, count(1), codegen_->IntLiteral(0)));
+      return;
+    case planner::SetOpType::EXCEPT:
+      builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, count(1), codegen_->IntLiteral(0)));
+      return;
+    case planner::SetOpType::UNION_ALL: {
+      // var num_copies: int64 = count0 + count1 + ...
+      ast::Expr *sum = count(0);
+      for (uint32_t i = 1; i < op_->GetChildrenSize(); i++) {
+        sum = codegen_->BinaryOp(parsing::Token::Type::PLUS, sum, count(i));
+      }
+      builder->Append(codegen_->DeclareVariable(num_copies_, int_type, sum));
+      break;
+    }
+    case planner::SetOpType::INTERSECT_ALL: {
+      // var num_copies: int64 = min(count0, count1)
+      builder->Append(codegen_->DeclareVariable(num_copies_, int_type, count(0)));
+      builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::LESS, count(1), num_copies()));
+      builder->Append(codegen_->Assign(num_copies(), count(1)));
+      builder->FinishBlockStmt();
+      break;
+    }
+    case planner::SetOpType::EXCEPT_ALL: {
+      // var num_copies: int64 = count0 - count1, which the loop below treats as zero if negative
+      ast::Expr *diff = codegen_->BinaryOp(parsing::Token::Type::MINUS, count(0), count(1));
+      builder->Append(codegen_->DeclareVariable(num_copies_, int_type, diff));
+      break;
+    }
+    default:
+      UNREACHABLE("Unsupported set operation");
+  }
+
+  // for (var copy_idx: int64 = 0; copy_idx < num_copies; copy_idx = copy_idx + 1) {...}
+  ast::Stmt *loop_init = codegen_->DeclareVariable(copy_idx_, int_type, codegen_->IntLiteral(0));
+  ast::Expr *loop_cond = codegen_->Compare(parsing::Token::Type::LESS, codegen_->MakeExpr(copy_idx_), num_copies());
+  ast::Expr *incr =
+      codegen_->BinaryOp(parsing::Token::Type::PLUS, codegen_->MakeExpr(copy_idx_), codegen_->IntLiteral(1));
+  builder->StartForStmt(loop_init, loop_cond, codegen_->Assign(codegen_->MakeExpr(copy_idx_), incr));
+}
+
+void SetOpTopTranslator::CloseIterator(FunctionBuilder *builder) {
+  ast::Expr *close_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterClose, iterator_, true);
+  builder->Append(codegen_->MakeStmt(close_call));
+}
+
+}  // namespace terrier::execution::compiler
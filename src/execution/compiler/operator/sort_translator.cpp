@@ -19,8 +19,8 @@ SortBottomTranslator::SortBottomTranslator(const terrier::planner::OrderByPlanNo
 
 void SortBottomTranslator::Produce(FunctionBuilder *builder) {
   child_translator_->Produce(builder);
-  // At the end of the pipeline, call sorterSort.
-  GenSorterSort(builder);
+  // At the end of the pipeline, call sorterSort. Parallel pipelines sort in FinishParallelWork.
+  if (!parallelized_pipeline_) GenSorterSort(builder);
 }
 
 void SortBottomTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
@@ -40,11 +40,10 @@ void SortBottomTranslator::GenSorterInsert(FunctionBuilder *builder) {
   // var sorter_row = @ptrCast(*SorterStruct, @sorterInsert(&state.sorter))
   ast::Expr *insert_call;
   if (op_->HasLimit()) {
-    ast::Expr *sorter = codegen_->GetStateMemberPtr(sorter_);
     ast::Expr *k = codegen_->IntLiteral(op_->GetLimit() + op_->GetOffset());
-    insert_call = codegen_->BuiltinCall(ast::Builtin::SorterInsertTopK, {sorter, k});
+    insert_call = codegen_->BuiltinCall(ast::Builtin::SorterInsertTopK, {GetInsertSorterPtr(), k});
   } else {
-    insert_call = codegen_->OneArgStateCall(ast::Builtin::SorterInsert, sorter_);
+    insert_call = codegen_->BuiltinCall(ast::Builtin::SorterInsert, {GetInsertSorterPtr()});
   }
 
   // Gen create @ptrcast(*SorterStruct, ...)
@@ -55,9 +54,8 @@ void SortBottomTranslator::GenSorterInsert(FunctionBuilder *builder) {
 }
 
 void SortBottomTranslator::GenFinishTopK(FunctionBuilder *builder) {
-  ast::Expr *sorter = codegen_->GetStateMemberPtr(sorter_);
   ast::Expr *k = codegen_->IntLiteral(op_->GetLimit() + op_->GetOffset());
-  auto finish_call = codegen_->BuiltinCall(ast::Builtin::SorterInsertTopKFinish, {sorter, k});
+  auto finish_call = codegen_->BuiltinCall(ast::Builtin::SorterInsertTopKFinish, {GetInsertSorterPtr(), k});
   builder->Append(codegen_->MakeStmt(finish_call));
 }
 
@@ -75,6 +73,17 @@ void SortBottomTranslator::GenSorterSort(FunctionBuilder *builder) {
   builder->Append(codegen_->MakeStmt(sort_call));
 }
 
+ast::Expr *SortBottomTranslator::GetInsertSorterPtr() {
+  return parallelized_pipeline_ ? codegen_->GetThreadStateMemberPtr(sorter_) : codegen_->GetStateMemberPtr(sorter_);
+}
+
+ast::Expr *SortBottomTranslator::SorterInitCall(ast::Expr *sorter) {
+  // @sorterInit(sorter, @execCtxGetMem(execCtx), sorterCompare, @sizeOf(SorterStruct))
+  ast::Expr *sizeof_call = codegen_->SizeOf(sorter_struct_);
+  std::vector<ast::Expr *> init_args{sorter, codegen_->ExecCtxGetMem(), codegen_->MakeExpr(comp_fn_), sizeof_call};
+  return codegen_->BuiltinCall(ast::Builtin::SorterInit, std::move(init_args));
+}
+
 void SortBottomTranslator::InitializeStateFields(
     execution::util::RegionVector<execution::ast::FieldDecl *> *state_fields) {
   // sorter: Sorter
@@ -100,11 +109,7 @@ void SortBottomTranslator::InitializeHelperFunctions(execution::util::RegionVect
 }
 
 void SortBottomTranslator::InitializeSetup(execution::util::RegionVector<execution::ast::Stmt *> *setup_stmts) {
-  // @sorterInit(&state.sorter, @execCtxGetMem(execCtx), sorterCompare, @sizeOf(SorterStruct))
-  ast::Expr *sizeof_call = codegen_->SizeOf(sorter_struct_);
-  std::vector<ast::Expr *> init_args{codegen_->GetStateMemberPtr(sorter_), codegen_->ExecCtxGetMem(),
-                                     codegen_->MakeExpr(comp_fn_), sizeof_call};
-  ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::SorterInit, std::move(init_args));
+  ast::Expr *init_call = SorterInitCall(codegen_->GetStateMemberPtr(sorter_));
 
   // Add it the setup statements
   setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
@@ -116,6 +121,38 @@ void SortBottomTranslator::InitializeTeardown(execution::util::RegionVector<exec
   teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
 }
 
+void SortBottomTranslator::InitializeThreadStateFields(
+    util::RegionVector<ast::FieldDecl *> *thread_state_fields) {
+  // sorter: Sorter
+  ast::Expr *sorter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Sorter);
+  thread_state_fields->emplace_back(codegen_->MakeField(sorter_, sorter_type));
+}
+
+void SortBottomTranslator::InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  ast::Expr *init_call = SorterInitCall(codegen_->GetThreadStateMemberPtr(sorter_));
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+void SortBottomTranslator::InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  // @sorterFree(&threadState.sorter)
+  ast::Expr *free_call = codegen_->BuiltinCall(ast::Builtin::SorterFree, {codegen_->GetThreadStateMemberPtr(sorter_)});
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+void SortBottomTranslator::FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {
+  // @sorterSortParallel(&state.sorter, &state.thread_states, @offsetOf(ThreadState, sorter))
+  // or @sorterSortTopKParallel(..., k) when there is a limit.
+  std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(sorter_), thread_states,
+                                codegen_->OffsetOf(thread_state_type_, sorter_)};
+  ast::Builtin builtin = ast::Builtin::SorterSortParallel;
+  if (op_->HasLimit()) {
+    args.emplace_back(codegen_->IntLiteral(op_->GetLimit() + op_->GetOffset()));
+    builtin = ast::Builtin::SorterSortTopKParallel;
+  }
+  ast::Expr *sort_call = codegen_->BuiltinCall(builtin, std::move(args));
+  builder->Append(codegen_->MakeStmt(sort_call));
+}
+
 ast::Expr *SortBottomTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
   // Pass through to child node
   if (current_row_ == CurrentRow::Child) {
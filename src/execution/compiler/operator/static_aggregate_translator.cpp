@@ -8,7 +8,10 @@
 namespace terrier::execution::compiler {
 StaticAggregateBottomTranslator::StaticAggregateBottomTranslator(const terrier::planner::AggregatePlanNode *op,
                                                                  CodeGen *codegen)
-    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_STATIC), op_(op), helper_(codegen, op) {}
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_STATIC),
+      op_(op),
+      helper_(codegen, op),
+      merge_fn_(codegen->NewIdentifier("mergeAggregates")) {}
 
 void StaticAggregateBottomTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
   // Static aggregations add their aggregates directly in the state.
@@ -57,7 +60,59 @@ void StaticAggregateBottomTranslator::Consume(FunctionBuilder *builder) {
   // Construct new hash table entries
   helper_.GenConstruct(builder);
   // Advance non distinct aggregates
-  helper_.GenAdvanceNonDistinct(builder);
+  helper_.GenAdvanceNonDistinct(builder, parallelized_pipeline_);
+}
+
+bool StaticAggregateBottomTranslator::IsParallelizable() {
+  for (const auto &term : op_->GetAggregateTerms()) {
+    if (term->IsDistinct()) return false;
+  }
+  return true;
+}
+
+void StaticAggregateBottomTranslator::InitializeThreadStateFields(
+    util::RegionVector<ast::FieldDecl *> *thread_state_fields) {
+  for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+    auto term = op_->GetAggregateTerms()[term_idx];
+    ast::Expr *agg_type = codegen_->AggregateType(term->GetExpressionType(), term->GetChild(0)->GetReturnValueType());
+    thread_state_fields->emplace_back(codegen_->MakeField(helper_.GetAggregate(term_idx), agg_type));
+  }
+}
+
+void StaticAggregateBottomTranslator::InitializeThreadStateSetup(
+    util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+    ast::Expr *agg = codegen_->GetThreadStateMemberPtr(helper_.GetAggregate(term_idx));
+    ast::Expr *agg_init_call = codegen_->OneArgCall(ast::Builtin::AggInit, agg);
+    thread_state_stmts->emplace_back(codegen_->MakeStmt(agg_init_call));
+  }
+}
+
+void StaticAggregateBottomTranslator::InitializeThreadStateHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  // fun mergeAggregates(state: *State, threadState: *ThreadState) -> nil
+  ast::FieldDecl *state_param =
+      codegen_->MakeField(codegen_->GetStateVar(), codegen_->PointerType(codegen_->GetStateType()));
+  ast::FieldDecl *thread_state_param =
+      codegen_->MakeField(codegen_->GetThreadStateVar(), codegen_->PointerType(thread_state_type_));
+  util::RegionVector<ast::FieldDecl *> params({state_param, thread_state_param}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Nil);
+  FunctionBuilder builder{codegen_, merge_fn_, std::move(params), ret_type};
+  // @aggMerge(&state.agg_i, &threadState.agg_i) for each aggregate
+  for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+    ast::Identifier agg = helper_.GetAggregate(term_idx);
+    ast::Expr *merge_call = codegen_->BuiltinCall(
+        ast::Builtin::AggMerge, {codegen_->GetStateMemberPtr(agg), codegen_->GetThreadStateMemberPtr(agg)});
+    builder.Append(codegen_->MakeStmt(merge_call));
+  }
+  decls->emplace_back(builder.Finish());
+}
+
+void StaticAggregateBottomTranslator::FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {
+  // @tlsIterate(&state.thread_states, state, mergeAggregates)
+  std::vector<ast::Expr *> args{thread_states, codegen_->MakeExpr(codegen_->GetStateVar()),
+                                codegen_->MakeExpr(merge_fn_)};
+  ast::Expr *iterate_call = codegen_->BuiltinCall(ast::Builtin::ThreadStateContainerIterate, std::move(args));
+  builder->Append(codegen_->MakeStmt(iterate_call));
 }
 
 ///////////////////////
@@ -0,0 +1,389 @@
+#include "execution/compiler/operator/window_translator.h"
+#include <memory>
+#include <utility>
+#include <vector>
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/translator_factory.h"
+#include "planner/plannodes/window_plan_node.h"
+
+namespace terrier::execution::compiler {
+WindowBottomTranslator::WindowBottomTranslator(const terrier::planner::WindowPlanNode *op, CodeGen *codegen)
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::SORT_BUILD),
+      op_(op),
+      sorter_(codegen_->NewIdentifier("sorter")),
+      window_row_(codegen_->NewIdentifier("window_row")),
+      window_struct_(codegen_->NewIdentifier("WindowRow")),
+      partition_fn_(codegen_->NewIdentifier("windowPartitionFn")),
+      peer_fn_(codegen_->NewIdentifier("windowPeerFn")),
+      comp_lhs_(codegen_->NewIdentifier("lhs")),
+      comp_rhs_(codegen_->NewIdentifier("rhs")) {}
+
+void WindowBottomTranslator::Produce(FunctionBuilder *builder) {
+  child_translator_->Produce(builder);
+  // At the end of the pipeline, call sorterSort. Parallel pipelines sort in FinishParallelWork.
+  if (!parallelized_pipeline_) {
+    ast::Expr *sort_call = codegen_->OneArgStateCall(ast::Builtin::SorterSort, sorter_);
+    builder->Append(codegen_->MakeStmt(sort_call));
+  }
+}
+
+void WindowBottomTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
+
+void WindowBottomTranslator::Consume(FunctionBuilder *builder) {
+  // var window_row = @ptrCast(*WindowRow, @sorterInsert(&state.sorter))
+  ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::SorterInsert, {GetInsertSorterPtr()});
+  builder->Append(codegen_->DeclareVariable(window_row_, nullptr, codegen_->PtrCast(window_struct_, insert_call)));
+
+  // For each child output, set the window attribute
+  for (uint32_t attr_idx = 0; attr_idx < op_->GetChild(0)->GetOutputSchema()->GetColumns().size(); attr_idx++) {
+    ast::Expr *lhs = GetAttribute(window_row_, attr_idx);
+    ast::Expr *rhs = child_translator_->GetOutput(attr_idx);
+    builder->Append(codegen_->Assign(lhs, rhs));
+  }
+
+  // Then evaluate the input of every window aggregate
+  const auto &functions = op_->GetWindowFunctions();
+  for (uint32_t function_idx = 0; function_idx < functions.size(); function_idx++) {
+    if (!HasInput(function_idx)) continue;
+    auto input = functions[function_idx].aggregate_->GetChild(0);
+    std::unique_ptr<ExpressionTranslator> translator =
+        TranslatorFactory::CreateExpressionTranslator(input.Get(), codegen_);
+    ast::Expr *lhs = codegen_->MemberExpr(window_row_, GetInputField(function_idx));
+    builder->Append(codegen_->Assign(lhs, translator->DeriveExpr(this)));
+  }
+}
+
+ast::Expr *WindowBottomTranslator::GetInsertSorterPtr() {
+  return parallelized_pipeline_ ? codegen_->GetThreadStateMemberPtr(sorter_) : codegen_->GetStateMemberPtr(sorter_);
+}
+
+ast::Expr *WindowBottomTranslator::SorterInitCall(ast::Expr *sorter) {
+  // @sorterInit(sorter, @execCtxGetMem(execCtx), windowPeerFn, @sizeOf(WindowRow))
+  ast::Expr *sizeof_call = codegen_->SizeOf(window_struct_);
+  std::vector<ast::Expr *> init_args{sorter, codegen_->ExecCtxGetMem(), codegen_->MakeExpr(peer_fn_), sizeof_call};
+  return codegen_->BuiltinCall(ast::Builtin::SorterInit, std::move(init_args));
+}
+
+void WindowBottomTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
+  // sorter: Sorter
+  ast::Expr *sorter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Sorter);
+  state_fields->emplace_back(codegen_->MakeField(sorter_, sorter_type));
+}
+
+void WindowBottomTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
+  util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
+  GetChildOutputFields(&fields, WINDOW_ATTR_PREFIX);
+  // The window trees are built over these fields
+  const auto &functions = op_->GetWindowFunctions();
+  for (uint32_t function_idx = 0; function_idx < functions.size(); function_idx++) {
+    if (!HasInput(function_idx)) continue;
+    auto input = functions[function_idx].aggregate_->GetChild(0);
+    ast::Expr *type = codegen_->TplType(input->GetReturnValueType());
+    fields.emplace_back(codegen_->MakeField(GetInputField(function_idx), type));
+  }
+  decls->emplace_back(codegen_->MakeStruct(window_struct_, std::move(fields)));
+}
+
+void WindowBottomTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  // Rows are sorted by peer group, which also groups them by partition
+  decls->push_back(GenComparisonFunction(partition_fn_, false));
+  decls->push_back(GenComparisonFunction(peer_fn_, true));
+}
+
+void WindowBottomTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
+  ast::Expr *init_call = SorterInitCall(codegen_->GetStateMemberPtr(sorter_));
+  setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+void WindowBottomTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  // @sorterFree(&state.sorter)
+  ast::Expr *free_call = codegen_->OneArgStateCall(ast::Builtin::SorterFree, sorter_);
+  teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+void WindowBottomTranslator::InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) {
+  // sorter: Sorter
+  ast::Expr *sorter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Sorter);
+  thread_state_fields->emplace_back(codegen_->MakeField(sorter_, sorter_type));
+}
+
+void WindowBottomTranslator::InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  ast::Expr *init_call = SorterInitCall(codegen_->GetThreadStateMemberPtr(sorter_));
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+void WindowBottomTranslator::InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) {
+  // @sorterFree(&threadState.sorter)
+  ast::Expr *free_call = codegen_->BuiltinCall(ast::Builtin::SorterFree, {codegen_->GetThreadStateMemberPtr(sorter_)});
+  thread_state_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+void WindowBottomTranslator::FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {
+  // @sorterSortParallel(&state.sorter, &state.thread_states, @offsetOf(ThreadState, sorter))
+  std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(sorter_), thread_states,
+                                codegen_->OffsetOf(thread_state_type_, sorter_)};
+  ast::Expr *sort_call = codegen_->BuiltinCall(ast::Builtin::SorterSortParallel, std::move(args));
+  builder->Append(codegen_->MakeStmt(sort_call));
+}
+
+ast::Expr *WindowBottomTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
+  // Pass through to child node
+  if (current_row_ == CurrentRow::Child) {
+    return child_translator_->GetOutput(attr_idx);
+  }
+  // Use the lhs or rhs
+  return GetAttribute(current_row_ == CurrentRow::Lhs ? comp_lhs_ : comp_rhs_, attr_idx);
+}
+
+ast::Expr *WindowBottomTranslator::GetOutput(uint32_t attr_idx) { return GetAttribute(window_row_, attr_idx); }
+
+ast::Expr *WindowBottomTranslator::GetAttribute(ast::Identifier object, uint32_t attr_idx) {
+  ast::Identifier member = codegen_->Context()->GetIdentifier(WINDOW_ATTR_PREFIX + std::to_string(attr_idx));
+  return codegen_->MemberExpr(object, member);
+}
+
+ast::Identifier WindowBottomTranslator::GetInputField(uint32_t function_idx) {
+  return codegen_->Context()->GetIdentifier(WINDOW_INPUT_PREFIX + std::to_string(function_idx));
+}
+
+bool WindowBottomTranslator::HasInput(uint32_t function_idx) {
+  const auto &function = op_->GetWindowFunctions()[function_idx];
+  return function.type_ == planner::WindowFunctionType::AGGREGATE &&
+         function.aggregate_->GetChild(0)->GetExpressionType() != parser::ExpressionType::STAR;
+}
+
+ast::Decl *WindowBottomTranslator::GenComparisonFunction(ast::Identifier fn_name, bool include_sort_keys) {
+  // Make a function (lhs *WindowRow, rhs *WindowRow) -> int32
+  ast::FieldDecl *lhs = codegen_->MakeField(comp_lhs_, codegen_->PointerType(window_struct_));
+  ast::FieldDecl *rhs = codegen_->MakeField(comp_rhs_, codegen_->PointerType(window_struct_));
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Int32);
+  util::RegionVector<ast::FieldDecl *> params{{lhs, rhs}, codegen_->Region()};
+  FunctionBuilder builder{codegen_, fn_name, std::move(params), ret_type};
+  // Partitions can be in any order, so they are sorted ascending
+  for (const auto &term : op_->GetPartitionByTerms()) {
+    GenComparison(&builder, term, optimizer::OrderByOrderingType::ASC);
+  }
+  if (include_sort_keys) {
+    for (const auto &key : op_->GetSortKeys()) {
+      GenComparison(&builder, key.first, key.second);
+    }
+  }
+  // return 0 at the end
+  builder.Append(codegen_->ReturnStmt(codegen_->IntLiteral(0)));
+  return builder.Finish();
+}
+
+void WindowBottomTranslator::GenComparison(FunctionBuilder *builder,
+                                           common::ManagedPointer<parser::AbstractExpression> key,
+                                           optimizer::OrderByOrderingType ordering) {
+  // Generate this (or its inverse depending on the ordering type):
+  // if (lhs.col_i < rhs.col_i) {return -1}
+  // if (lhs.col_i > rhs.col_i) {return 1}
+  int32_t ret_value = ordering == optimizer::OrderByOrderingType::ASC ? -1 : 1;
+  std::unique_ptr<ExpressionTranslator> key_translator =
+      TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+  for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+    current_row_ = CurrentRow::Lhs;
+    ast::Expr *lhs_cond = key_translator->DeriveExpr(this);
+    current_row_ = CurrentRow::Rhs;
+    ast::Expr *rhs_cond = key_translator->DeriveExpr(this);
+    builder->StartIfStmt(codegen_->Compare(tok, lhs_cond, rhs_cond));
+    builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(ret_value)));
+    builder->FinishBlockStmt();
+    // Next if statement should return the opposite value
+    ret_value = -ret_value;
+  }
+  current_row_ = CurrentRow::Child;
+}
+
+WindowTopTranslator::WindowTopTranslator(const terrier::planner::WindowPlanNode *op, CodeGen *codegen,
+                                         OperatorTranslator *bottom)
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::SORT_ITERATE),
+      op_(op),
+      bottom_(dynamic_cast<WindowBottomTranslator *>(bottom)),
+      window_(codegen_->NewIdentifier("window")),
+      window_iter_(codegen_->NewIdentifier("window_iter")) {
+  for (uint32_t function_idx = 0; function_idx < op_->GetWindowFunctions().size(); function_idx++) {
+    frames_.emplace_back(codegen_->NewIdentifier("window_frame"));
+    trees_.emplace_back(codegen_->NewIdentifier("window_tree"));
+    aggregates_.emplace_back(codegen_->NewIdentifier("window_agg"));
+  }
+}
+
+void WindowTopTranslator::Produce(FunctionBuilder *builder) {
+  // Declare the window over the sorted rows
+  DeclareWindow(builder);
+  // In case of nested loop joins, let the child produce
+  if (child_translator_ != nullptr) {
+    child_translator_->Produce(builder);
+  } else {
+    // Otherwise directly consume the bottom's output
+    Consume(builder);
+  }
+}
+
+void WindowTopTranslator::Abort(FunctionBuilder *builder) {
+  FreeWindow(builder);
+  if (child_translator_ != nullptr) child_translator_->Abort(builder);
+}
+
+void WindowTopTranslator::Consume(FunctionBuilder *builder) {
+  // Generate the for loop
+  GenForLoop(builder);
+  // Compute the window aggregates of the current row
+  ComputeAggregates(builder);
+  // Let parent consume
+  parent_translator_->Consume(builder);
+  // Free everything after the loop ends.
+  builder->FinishBlockStmt();
+  FreeWindow(builder);
+}
+
+void WindowTopTranslator::DeclareWindow(FunctionBuilder *builder) {
+  // var window : WindowOperator
+  // @windowInit(&window, &state.sorter, windowPartitionFn, windowPeerFn)
+  builder->Append(
+      codegen_->DeclareVariable(window_, codegen_->BuiltinType(ast::BuiltinType::WindowOperator), nullptr));
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(window_), codegen_->GetStateMemberPtr(bottom_->sorter_),
+                                     codegen_->MakeExpr(bottom_->partition_fn_), codegen_->MakeExpr(bottom_->peer_fn_)};
+  builder->Append(codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::WindowInit, std::move(init_args))));
+
+  const auto &functions = op_->GetWindowFunctions();
+  for (uint32_t function_idx = 0; function_idx < functions.size(); function_idx++) {
+    const auto &function = functions[function_idx];
+    if (function.type_ != planner::WindowFunctionType::AGGREGATE) continue;
+
+    // var window_frame : WindowFrame
+    // @windowFrameInit(&window_frame, mode, start, start_offset, end, end_offset)
+    builder->Append(codegen_->DeclareVariable(frames_[function_idx],
+                                              codegen_->BuiltinType(ast::BuiltinType::WindowFrame), nullptr));
+    std::vector<ast::Expr *> frame_args{codegen_->PointerTo(frames_[function_idx]),
+                                        codegen_->IntLiteral(static_cast<int64_t>(function.frame_mode_)),
+                                        codegen_->IntLiteral(static_cast<int64_t>(function.frame_start_)),
+                                        codegen_->IntLiteral(static_cast<int64_t>(function.frame_start_offset_)),
+                                        codegen_->IntLiteral(static_cast<int64_t>(function.frame_end_)),
+                                        codegen_->IntLiteral(static_cast<int64_t>(function.frame_end_offset_))};
+    builder->Append(codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::WindowFrameInit, std::move(frame_args))));
+
+    // COUNT(*) is the size of the frame
+    if (!bottom_->HasInput(function_idx)) continue;
+
+    // var window_tree : [Type]WindowTree
+    // @windowTreeInit(&window_tree)
+    auto agg_type = function.aggregate_->GetExpressionType();
+    auto input_type = function.aggregate_->GetChild(0)->GetReturnValueType();
+    builder->Append(
+        codegen_->DeclareVariable(trees_[function_idx], codegen_->WindowTreeType(agg_type, input_type), nullptr));
+    builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::WindowTreeInit, trees_[function_idx])));
+
+    // var window_agg : [Type]Aggregate
+    // @aggInit(&window_agg)
+    builder->Append(
+        codegen_->DeclareVariable(aggregates_[function_idx], codegen_->AggregateType(agg_type, input_type), nullptr));
+    builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::AggInit, aggregates_[function_idx])));
+  }
+}
+
+void WindowTopTranslator::GenForLoop(FunctionBuilder *builder) {
+  // var window_iter : WindowIterator
+  ast::Expr *iter_type = codegen_->BuiltinType(ast::BuiltinType::WindowIterator);
+  builder->Append(codegen_->DeclareVariable(window_iter_, iter_type, nullptr));
+
+  // for (@windowIterInit(&window_iter, &window); @windowIterHasNext(&window_iter); @windowIterNext(&window_iter))
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(window_iter_), codegen_->PointerTo(window_)};
+  ast::Stmt *loop_init = codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::WindowIterInit, std::move(init_args)));
+  ast::Expr *has_next_call = codegen_->OneArgCall(ast::Builtin::WindowIterHasNext, window_iter_, true);
+  ast::Stmt *loop_update = codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::WindowIterNext, window_iter_, true));
+  builder->StartForStmt(loop_init, has_next_call, loop_update);
+
+  // var window_row = @ptrCast(*WindowRow, @windowIterGetRow(&window_iter))
+  ast::Expr *get_row_call = codegen_->OneArgCall(ast::Builtin::WindowIterGetRow, window_iter_, true);
+  ast::Expr *cast_call = codegen_->PtrCast(bottom_->window_struct_, get_row_call);
+  builder->Append(codegen_->DeclareVariable(bottom_->window_row_, nullptr, cast_call));
+}
+
+void WindowTopTranslator::ComputeAggregates(FunctionBuilder *builder) {
+  std::vector<uint32_t> tree_functions;
+  for (uint32_t function_idx = 0; function_idx < op_->GetWindowFunctions().size(); function_idx++) {
+    if (bottom_->HasInput(function_idx)) tree_functions.emplace_back(function_idx);
+  }
+  if (tree_functions.empty()) return;
+
+  // if (@windowIterIsPartitionStart(&window_iter)) {
+  //   @windowTreeBuild(&window_tree, &window_iter, @offsetOf(WindowRow, window_input))
+  // }
+  builder->StartIfStmt(codegen_->OneArgCall(ast::Builtin::WindowIterIsPartitionStart, window_iter_, true));
+  for (const auto function_idx : tree_functions) {
+    std::vector<ast::Expr *> build_args{codegen_->PointerTo(trees_[function_idx]), codegen_->PointerTo(window_iter_),
+                                        codegen_->OffsetOf(bottom_->window_struct_,
+                                                           bottom_->GetInputField(function_idx))};
+    builder->Append(codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::WindowTreeBuild, std::move(build_args))));
+  }
+  builder->FinishBlockStmt();
+
+  // @windowTreeQuery(&window_tree, frame begin, frame end, &window_agg)
+  for (const auto function_idx : tree_functions) {
+    std::vector<ast::Expr *> query_args{codegen_->PointerTo(trees_[function_idx]),
+                                        FrameBoundCall(ast::Builtin::WindowIterGetFrameBegin, function_idx),
+                                        FrameBoundCall(ast::Builtin::WindowIterGetFrameEnd, function_idx),
+                                        codegen_->PointerTo(aggregates_[function_idx])};
+    builder->Append(codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::WindowTreeQuery, std::move(query_args))));
+  }
+}
+
+void WindowTopTranslator::FreeWindow(FunctionBuilder *builder) {
+  // @windowIterClose(&window_iter)
+  builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::WindowIterClose, window_iter_, true)));
+  // @windowTreeFree(&window_tree)
+  for (uint32_t function_idx = 0; function_idx < op_->GetWindowFunctions().size(); function_idx++) {
+    if (!bottom_->HasInput(function_idx)) continue;
+    builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::WindowTreeFree, trees_[function_idx])));
+  }
+  // @windowFree(&window)
+  builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::WindowFree, window_)));
+}
+
+ast::Expr *WindowTopTranslator::FrameBoundCall(ast::Builtin builtin, uint32_t function_idx) {
+  std::vector<ast::Expr *> args{codegen_->PointerTo(window_iter_), codegen_->PointerTo(frames_[function_idx])};
+  return codegen_->BuiltinCall(builtin, std::move(args));
+}
+
+ast::Expr *WindowTopTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
+  // Tuple index 0 refers to the child's columns
+  if (child_idx == 0) {
+    return bottom_->GetOutput(attr_idx);
+  }
+
+  // Tuple index 1 refers to the window functions
+  const auto &function = op_->GetWindowFunctions()[attr_idx];
+  switch (function.type_) {
+    case planner::WindowFunctionType::ROW_NUMBER:
+      return codegen_->OneArgCall(ast::Builtin::IntToSql,
+                                  codegen_->OneArgCall(ast::Builtin::WindowIterGetRowNumber, window_iter_, true));
+    case planner::WindowFunctionType::RANK:
+      return codegen_->OneArgCall(ast::Builtin::IntToSql,
+                                  codegen_->OneArgCall(ast::Builtin::WindowIterGetRank, window_iter_, true));
+    case planner::WindowFunctionType::DENSE_RANK:
+      return codegen_->OneArgCall(ast::Builtin::IntToSql,
+                                  codegen_->OneArgCall(ast::Builtin::WindowIterGetDenseRank, window_iter_, true));
+    case planner::WindowFunctionType::AGGREGATE:
+      break;
+  }
+  if (!bottom_->HasInput(attr_idx)) {
+    // COUNT(*): @intToSql(frame end - frame begin)
+    ast::Expr *frame_size =
+        codegen_->BinaryOp(parsing::Token::Type::MINUS, FrameBoundCall(ast::Builtin::WindowIterGetFrameEnd, attr_idx),
+                           FrameBoundCall(ast::Builtin::WindowIterGetFrameBegin, attr_idx));
+    return codegen_->OneArgCall(ast::Builtin::IntToSql, frame_size);
+  }
+  // @aggResult(&window_agg)
+  return codegen_->OneArgCall(ast::Builtin::AggResult, aggregates_[attr_idx], true);
+}
+
+ast::Expr *WindowTopTranslator::GetOutput(uint32_t attr_idx) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  std::unique_ptr<ExpressionTranslator> translator =
+      TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+}  // namespace terrier::execution::compiler
@@ -1,6 +1,8 @@
 #include "execution/compiler/pipeline.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -8,6 +10,22 @@ namespace terrier::execution::compiler {
 void Pipeline::Initialize(util::RegionVector<ast::Decl *> *decls, util::RegionVector<ast::FieldDecl *> *state_fields,
                           util::RegionVector<ast::Stmt *> *setup_stmts,
                           util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  // A pipeline runs in parallel only if every one of its operators supports it. Ask again now: an operator that
+  // iterates the output of an earlier pipeline may only know once that pipeline is initialized.
+  is_parallelizable_ = std::all_of(pipeline_.begin(), pipeline_.end(),
+                                   [](const auto &translator) { return translator->IsParallelizable(); });
+  is_parallelizable_ = is_parallelizable_ && !pipeline_.empty() && codegen_->IsParallelExecutionEnabled();
+  if (is_parallelizable_) {
+    thread_state_type_ = codegen_->NewIdentifier("ThreadState");
+    thread_states_ = codegen_->NewIdentifier("thread_states");
+    thread_state_init_fn_ = codegen_->NewIdentifier("threadStateInit");
+    thread_state_teardown_fn_ = codegen_->NewIdentifier("threadStateTeardown");
+    thread_state_exec_ctx_ = codegen_->Context()->GetIdentifier("execCtx");
+  }
+
+  util::RegionVector<ast::FieldDecl *> thread_state_fields(codegen_->Region());
+  util::RegionVector<ast::Stmt *> thread_state_init_stmts(codegen_->Region());
+  util::RegionVector<ast::Stmt *> thread_state_teardown_stmts(codegen_->Region());
   for (uint32_t i = 0; i < pipeline_.size(); i++) {
     // Get previous, current, and parent translator
     OperatorTranslator *child_translator = nullptr;
@@ -17,20 +35,86 @@ void Pipeline::Initialize(util::RegionVector<ast::Decl *> *decls, util::RegionVe
     if (i < pipeline_.size() - 1) parent_translator = pipeline_[i + 1].get();
 
     // Initialize
-    curr_translator->Prepare(child_translator, parent_translator, is_vectorizable_, is_parallelizable_);
+    curr_translator->Prepare(child_translator, parent_translator, is_vectorizable_, is_parallelizable_,
+                             thread_state_type_);
     curr_translator->InitializeStateFields(state_fields);
     curr_translator->InitializeStructs(decls);
     curr_translator->InitializeHelperFunctions(decls);
     curr_translator->InitializeSetup(setup_stmts);
     curr_translator->InitializeTeardown(teardown_stmts);
+    if (is_parallelizable_) {
+      curr_translator->InitializeThreadStateFields(&thread_state_fields);
+      curr_translator->InitializeThreadStateSetup(&thread_state_init_stmts);
+      curr_translator->InitializeThreadStateTeardown(&thread_state_teardown_stmts);
+    }
+  }
+
+  if (is_parallelizable_) {
+    // thread_states: ThreadStateContainer
+    ast::Expr *tls_type = codegen_->BuiltinType(ast::BuiltinType::Kind::ThreadStateContainer);
+    state_fields->emplace_back(codegen_->MakeField(thread_states_, tls_type));
+    // @tlsInit(&state.thread_states, @execCtxGetMem(execCtx))
+    std::vector<ast::Expr *> init_args{codegen_->GetStateMemberPtr(thread_states_), codegen_->ExecCtxGetMem()};
+    ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::ThreadStateContainerInit, std::move(init_args));
+    setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+    // @tlsFree(&state.thread_states)
+    ast::Expr *free_call = codegen_->OneArgStateCall(ast::Builtin::ThreadStateContainerFree, thread_states_);
+    teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
+
+    GenThreadState(decls, std::move(thread_state_fields), std::move(thread_state_init_stmts),
+                   std::move(thread_state_teardown_stmts));
+    for (auto &translator : pipeline_) {
+      translator->InitializeThreadStateHelperFunctions(decls);
+    }
   }
 }
 
-ast::Decl *Pipeline::Produce(query_id_t query_id, pipeline_id_t pipeline_idx) {
+void Pipeline::GenThreadState(util::RegionVector<ast::Decl *> *decls, util::RegionVector<ast::FieldDecl *> &&fields,
+                              util::RegionVector<ast::Stmt *> &&init_stmts,
+                              util::RegionVector<ast::Stmt *> &&teardown_stmts) {
+  // Every thread state keeps a pointer to the execution context, so that workers can use it.
+  ast::Expr *exec_ctx_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::Kind::ExecutionContext));
+  fields.insert(fields.begin(), codegen_->MakeField(thread_state_exec_ctx_, exec_ctx_type));
+  decls->emplace_back(codegen_->MakeStruct(thread_state_type_, std::move(fields)));
+
+  // threadState.execCtx = execCtx
+  ast::Expr *lhs = codegen_->MemberExpr(codegen_->GetThreadStateVar(), thread_state_exec_ctx_);
+  ast::Expr *rhs = codegen_->MakeExpr(codegen_->GetExecCtxVar());
+  init_stmts.insert(init_stmts.begin(), codegen_->Assign(lhs, rhs));
+
+  decls->emplace_back(GenThreadStateFunction(thread_state_init_fn_, std::move(init_stmts)));
+  decls->emplace_back(GenThreadStateFunction(thread_state_teardown_fn_, std::move(teardown_stmts)));
+}
+
+ast::Decl *Pipeline::GenThreadStateFunction(ast::Identifier fn_name, util::RegionVector<ast::Stmt *> &&stmts) {
+  // Function parameters
+  ast::Expr *exec_ctx_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::Kind::ExecutionContext));
+  ast::FieldDecl *exec_ctx_param = codegen_->MakeField(codegen_->GetExecCtxVar(), exec_ctx_type);
+  ast::Expr *thread_state_ptr_type = codegen_->PointerType(thread_state_type_);
+  ast::FieldDecl *thread_state_param = codegen_->MakeField(codegen_->GetThreadStateVar(), thread_state_ptr_type);
+  util::RegionVector<ast::FieldDecl *> params({exec_ctx_param, thread_state_param}, codegen_->Region());
+
+  // Function return type (nil)
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Nil);
+
+  FunctionBuilder builder{codegen_, fn_name, std::move(params), ret_type};
+  for (const auto &stmt : stmts) {
+    builder.Append(stmt);
+  }
+  return builder.Finish();
+}
+
+void Pipeline::Produce(query_id_t query_id, pipeline_id_t pipeline_idx, util::RegionVector<ast::Decl *> *decls) {
   pipeline_idx_ = pipeline_idx;
   // Function name
   ast::Identifier fn_name = GetPipelineName();
 
+  // The parallel work function must be declared before the pipeline function that launches it.
+  if (is_parallelizable_) {
+    parallel_work_fn_ = codegen_->Context()->GetIdentifier(std::string(fn_name.Data()) + "_ParallelWork");
+    decls->emplace_back(ProduceParallelWork());
+  }
+
   // Function parameter
   util::RegionVector<ast::FieldDecl *> params = codegen_->ExecParams();
 
@@ -46,9 +130,11 @@ ast::Decl *Pipeline::Produce(query_id_t query_id, pipeline_id_t pipeline_idx) {
   auto start_call = codegen_->BuiltinCall(ast::Builtin::ExecutionContextStartResourceTracker, std::move(args));
   builder.Append(codegen_->MakeStmt(start_call));
 
-  // for (const auto & translator: pipeline_) {
-  pipeline_[pipeline_.size() - 1]->Produce(&builder);
-  //}
+  if (is_parallelizable_) {
+    ProduceParallel(&builder);
+  } else {
+    ProduceSerial(&builder);
+  }
 
   // Inject EndPipelineTracker();
   args = {codegen_->MakeExpr(codegen_->GetExecCtxVar())};
@@ -56,6 +142,52 @@ ast::Decl *Pipeline::Produce(query_id_t query_id, pipeline_id_t pipeline_idx) {
   args.push_back(codegen_->IntLiteral(!pipeline_idx));
   auto end_call = codegen_->BuiltinCall(ast::Builtin::ExecutionContextEndPipelineTracker, std::move(args));
   builder.Append(codegen_->MakeStmt(end_call));
+  decls->emplace_back(builder.Finish());
+}
+
+void Pipeline::ProduceSerial(FunctionBuilder *builder) {
+  // for (const auto & translator: pipeline_) {
+  pipeline_[pipeline_.size() - 1]->Produce(builder);
+  //}
+}
+
+void Pipeline::ProduceParallel(FunctionBuilder *builder) {
+  // @tlsReset(&state.thread_states, @sizeOf(ThreadState), threadStateInit, threadStateTeardown, execCtx)
+  std::vector<ast::Expr *> reset_args{
+      codegen_->GetStateMemberPtr(thread_states_), codegen_->SizeOf(thread_state_type_),
+      codegen_->MakeExpr(thread_state_init_fn_), codegen_->MakeExpr(thread_state_teardown_fn_),
+      codegen_->MakeExpr(codegen_->GetExecCtxVar())};
+  ast::Expr *reset_call = codegen_->BuiltinCall(ast::Builtin::ThreadStateContainerReset, std::move(reset_args));
+  builder->Append(codegen_->MakeStmt(reset_call));
+
+  // Let the source launch the workers.
+  pipeline_[0]->LaunchParallelWork(builder, codegen_->GetStateMemberPtr(thread_states_), parallel_work_fn_);
+
+  // Once every worker is done, let the operators merge their thread-local state.
+  for (const auto &translator : pipeline_) {
+    translator->FinishParallelWork(builder, codegen_->GetStateMemberPtr(thread_states_));
+  }
+}
+
+ast::Decl *Pipeline::ProduceParallelWork() {
+  // Function parameters: the query state, the thread state, and the source's share of the input.
+  util::RegionVector<ast::FieldDecl *> params(codegen_->Region());
+  ast::Expr *state_type = codegen_->PointerType(codegen_->GetStateType());
+  params.emplace_back(codegen_->MakeField(codegen_->GetStateVar(), state_type));
+  ast::Expr *thread_state_type = codegen_->PointerType(thread_state_type_);
+  params.emplace_back(codegen_->MakeField(codegen_->GetThreadStateVar(), thread_state_type));
+  params.emplace_back(pipeline_[0]->GetParallelWorkParam());
+
+  // Function return type (nil)
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Nil);
+
+  FunctionBuilder builder{codegen_, parallel_work_fn_, std::move(params), ret_type};
+
+  // var execCtx = threadState.execCtx
+  ast::Expr *exec_ctx = codegen_->MemberExpr(codegen_->GetThreadStateVar(), thread_state_exec_ctx_);
+  builder.Append(codegen_->DeclareVariable(codegen_->GetExecCtxVar(), nullptr, exec_ctx));
+
+  pipeline_[pipeline_.size() - 1]->Produce(&builder);
   return builder.Finish();
 }
 
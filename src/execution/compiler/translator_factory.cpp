@@ -14,18 +14,22 @@
 #include "execution/compiler/expression/star_translator.h"
 #include "execution/compiler/expression/unary_translator.h"
 #include "execution/compiler/operator/aggregate_translator.h"
+#include "execution/compiler/operator/csv_scan_translator.h"
 #include "execution/compiler/operator/delete_translator.h"
 #include "execution/compiler/operator/hash_join_translator.h"
 #include "execution/compiler/operator/index_join_translator.h"
 #include "execution/compiler/operator/index_scan_translator.h"
 #include "execution/compiler/operator/insert_translator.h"
 #include "execution/compiler/operator/limit_translator.h"
+#include "execution/compiler/operator/merge_join_translator.h"
 #include "execution/compiler/operator/nested_loop_translator.h"
 #include "execution/compiler/operator/projection_translator.h"
 #include "execution/compiler/operator/seq_scan_translator.h"
+#include "execution/compiler/operator/set_op_translator.h"
 #include "execution/compiler/operator/sort_translator.h"
 #include "execution/compiler/operator/static_aggregate_translator.h"
 #include "execution/compiler/operator/update_translator.h"
+#include "execution/compiler/operator/window_translator.h"
 #include "execution/compiler/pipeline.h"
 
 namespace terrier::execution::compiler {
@@ -38,6 +42,9 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateRegularTranslator(
     case terrier::planner::PlanNodeType::SEQSCAN: {
       return std::make_unique<SeqScanTranslator>(static_cast<const planner::SeqScanPlanNode *>(op), codegen);
     }
+    case terrier::planner::PlanNodeType::CSVSCAN: {
+      return std::make_unique<CSVScanTranslator>(static_cast<const planner::CSVScanPlanNode *>(op), codegen);
+    }
     case terrier::planner::PlanNodeType::INSERT: {
       return std::make_unique<InsertTranslator>(static_cast<const planner::InsertPlanNode *>(op), codegen);
     }
@@ -76,11 +83,24 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateBottomTranslator(
     }
     case terrier::planner::PlanNodeType::ORDERBY:
       return std::make_unique<SortBottomTranslator>(static_cast<const planner::OrderByPlanNode *>(op), codegen);
+    case terrier::planner::PlanNodeType::SETOP:
+      return std::make_unique<SetOpBottomTranslator>(static_cast<const planner::SetOpPlanNode *>(op), codegen, 0,
+                                                     nullptr);
+    case terrier::planner::PlanNodeType::WINDOW:
+      return std::make_unique<WindowBottomTranslator>(static_cast<const planner::WindowPlanNode *>(op), codegen);
     default:
       UNREACHABLE("Not a pipeline boundary!");
   }
 }
 
+std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateSetOpInputTranslator(
+    const terrier::planner::AbstractPlanNode *op, uint32_t child_idx, OperatorTranslator *first_bottom,
+    CodeGen *codegen) {
+  TERRIER_ASSERT(op->GetPlanNodeType() == terrier::planner::PlanNodeType::SETOP, "Not a set operation!");
+  return std::make_unique<SetOpBottomTranslator>(static_cast<const planner::SetOpPlanNode *>(op), codegen, child_idx,
+                                                 first_bottom);
+}
+
 std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTopTranslator(const terrier::planner::AbstractPlanNode *op,
                                                                            OperatorTranslator *bottom,
                                                                            CodeGen *codegen) {
@@ -94,6 +114,10 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTopTranslator(const
     }
     case terrier::planner::PlanNodeType::ORDERBY:
       return std::make_unique<SortTopTranslator>(static_cast<const planner::OrderByPlanNode *>(op), codegen, bottom);
+    case terrier::planner::PlanNodeType::SETOP:
+      return std::make_unique<SetOpTopTranslator>(static_cast<const planner::SetOpPlanNode *>(op), codegen, bottom);
+    case terrier::planner::PlanNodeType::WINDOW:
+      return std::make_unique<WindowTopTranslator>(static_cast<const planner::WindowPlanNode *>(op), codegen, bottom);
     default:
       UNREACHABLE("Not a pipeline boundary!");
   }
@@ -104,6 +128,8 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateLeftTranslator(
   switch (op->GetPlanNodeType()) {
     case terrier::planner::PlanNodeType::HASHJOIN:
       return std::make_unique<HashJoinLeftTranslator>(static_cast<const planner::HashJoinPlanNode *>(op), codegen);
+    case terrier::planner::PlanNodeType::MERGEJOIN:
+      return std::make_unique<MergeJoinLeftTranslator>(static_cast<const planner::MergeJoinPlanNode *>(op), codegen);
     case terrier::planner::PlanNodeType::NESTLOOP:
       return std::make_unique<NestedLoopLeftTranslator>(static_cast<const planner::NestedLoopJoinPlanNode *>(op),
                                                         codegen);
@@ -118,6 +144,9 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateRightTranslator(
     case terrier::planner::PlanNodeType::HASHJOIN:
       return std::make_unique<HashJoinRightTranslator>(static_cast<const planner::HashJoinPlanNode *>(op), codegen,
                                                        left);
+    case terrier::planner::PlanNodeType::MERGEJOIN:
+      return std::make_unique<MergeJoinRightTranslator>(static_cast<const planner::MergeJoinPlanNode *>(op), codegen,
+                                                        left);
     case terrier::planner::PlanNodeType::NESTLOOP:
       return std::make_unique<NestedLoopRightTranslator>(static_cast<const planner::NestedLoopJoinPlanNode *>(op),
                                                          codegen, left);
@@ -129,7 +158,7 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateRightTranslator(
 std::unique_ptr<ExpressionTranslator> TranslatorFactory::CreateExpressionTranslator(
     const terrier::parser::AbstractExpression *expression, CodeGen *codegen) {
   auto type = expression->GetExpressionType();
-  if (IsComparisonOp(type)) {
+  if (IsComparisonOp(type) || IsLikeOp(type)) {
     return std::make_unique<ComparisonTranslator>(expression, codegen);
   }
   if (IsArithmeticOp(type)) {
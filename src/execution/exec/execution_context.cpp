@@ -6,6 +6,7 @@ namespace terrier::execution::exec {
 
 char *ExecutionContext::StringAllocator::Allocate(std::size_t size) {
   if (tracker_ != nullptr) tracker_->Increment(size);
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   return reinterpret_cast<char *>(region_.Allocate(size));
 }
 
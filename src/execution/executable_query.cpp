@@ -10,18 +10,38 @@
 #include "execution/vm/bytecode_generator.h"
 #include "execution/vm/module.h"
 #include "loggers/execution_logger.h"
+#include "planner/plannodes/abstract_plan_node.h"
 
 namespace terrier::execution {
 
+namespace {
+// Whether the plan writes to any table, possibly to the blocks it is scanning
+bool ModifiesTables(const planner::AbstractPlanNode *plan) {
+  switch (plan->GetPlanNodeType()) {
+    case planner::PlanNodeType::INSERT:
+    case planner::PlanNodeType::UPDATE:
+    case planner::PlanNodeType::DELETE:
+      return true;
+    default:
+      break;
+  }
+  for (const auto &child : plan->GetChildren())
+    if (ModifiesTables(child.Get())) return true;
+  return false;
+}
+}  // namespace
+
 std::atomic<query_id_t> ExecutableQuery::query_identifier{query_id_t{0}};
 
 ExecutableQuery::ExecutableQuery(const common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
-                                 const common::ManagedPointer<exec::ExecutionContext> exec_ctx) {
+                                 const common::ManagedPointer<exec::ExecutionContext> exec_ctx,
+                                 const compiler::ConstantLifter *const lifter) {
   // Generate a query id using std::atomic<>.fetch_add()
   query_id_ = ExecutableQuery::query_identifier++;
+  read_only_ = !ModifiesTables(physical_plan.Get());
 
   // Compile and check for errors
-  compiler::CodeGen codegen(exec_ctx.Get());
+  compiler::CodeGen codegen(exec_ctx.Get(), lifter);
   compiler::Compiler compiler(query_id_, &codegen, physical_plan.Get());
   auto root = compiler.Compile();
   if (codegen.Reporter()->HasErrors()) {
@@ -86,9 +106,17 @@ ExecutableQuery::ExecutableQuery(const std::string &filename,
   query_name_ = GetFileName(filename);
 }
 
+std::size_t ExecutableQuery::GetCodeSizeInBytes() const {
+  TERRIER_ASSERT(tpl_module_ != nullptr, "Trying to measure a module that failed to compile.");
+  return tpl_module_->GetCodeSizeInBytes();
+}
+
 void ExecutableQuery::Run(const common::ManagedPointer<exec::ExecutionContext> exec_ctx, const vm::ExecutionMode mode) {
   TERRIER_ASSERT(tpl_module_ != nullptr, "Trying to run a module that failed to compile.");
   exec_ctx->SetExecutionMode(static_cast<uint8_t>(mode));
+  // The query may be run with a different execution context than the one it was generated with
+  exec_ctx->SetPipelineOperatingUnits(common::ManagedPointer(pipeline_operating_units_));
+  exec_ctx->SetInPlaceReads(read_only_);
 
   // Run the main function
   std::function<int64_t(exec::ExecutionContext *)> main;
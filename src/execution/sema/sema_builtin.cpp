@@ -28,6 +28,39 @@ bool IsPointerToAggregatorValue(ast::Type *type) {
   return false;
 }
 
+bool IsPointerToWindowTree(ast::Type *type) {
+  if (auto *pointee_type = type->GetPointeeType()) {
+    return pointee_type->IsSqlWindowTreeType();
+  }
+  return false;
+}
+
+// The aggregate that the frames of a window tree are computed into
+ast::BuiltinType::Kind WindowTreeAggregateKind(const ast::BuiltinType::Kind tree_kind) {
+  switch (tree_kind) {
+    case ast::BuiltinType::CountWindowTree:
+      return ast::BuiltinType::CountAggregate;
+    case ast::BuiltinType::IntegerAvgWindowTree:
+      return ast::BuiltinType::IntegerAvgAggregate;
+    case ast::BuiltinType::IntegerMaxWindowTree:
+      return ast::BuiltinType::IntegerMaxAggregate;
+    case ast::BuiltinType::IntegerMinWindowTree:
+      return ast::BuiltinType::IntegerMinAggregate;
+    case ast::BuiltinType::IntegerSumWindowTree:
+      return ast::BuiltinType::IntegerSumAggregate;
+    case ast::BuiltinType::RealAvgWindowTree:
+      return ast::BuiltinType::RealAvgAggregate;
+    case ast::BuiltinType::RealMaxWindowTree:
+      return ast::BuiltinType::RealMaxAggregate;
+    case ast::BuiltinType::RealMinWindowTree:
+      return ast::BuiltinType::RealMinAggregate;
+    case ast::BuiltinType::RealSumWindowTree:
+      return ast::BuiltinType::RealSumAggregate;
+    default:
+      UNREACHABLE("Impossible window tree type");
+  }
+}
+
 template <typename... ArgTypes>
 bool AreAllFunctions(const ArgTypes... type) {
   return (true && ... && type->IsFunctionType());
@@ -241,10 +274,138 @@ void Sema::CheckBuiltinFilterCall(ast::CallExpr *call) {
     return;
   }
 
+  // The fourth call argument is an integer literal, or a SQL string for varlen columns
+  if (!args[3]->IsIntegerLiteral() && !args[3]->GetType()->IsSpecificBuiltin(ast::BuiltinType::StringVal)) {
+    ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Int64));
+    return;
+  }
+
+  // Set return type
+  call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
+}
+
+void Sema::CheckBuiltinFilterLikeCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 3)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first call argument must be a pointer to a ProjectedColumnsIterator
+  const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), pci_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(pci_kind)->PointerTo());
+    return;
+  }
+
+  // The second call argument must be an integer for the column index
+  if (!args[1]->IsIntegerLiteral()) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Int32));
+    return;
+  }
+
+  // The third call argument is the pattern
+  const auto string_kind = ast::BuiltinType::StringVal;
+  if (!args[2]->GetType()->IsSpecificBuiltin(string_kind)) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(string_kind));
+    return;
+  }
+
+  // Set return type
+  call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
+}
+
+void Sema::CheckBuiltinFilterJoinCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 4)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first call argument must be a pointer to a ProjectedColumnsIterator
+  const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), pci_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(pci_kind)->PointerTo());
+    return;
+  }
+
+  // The second and third call arguments must be integers for the column index and type
+  for (uint32_t i = 1; i < 3; i++) {
+    if (!args[i]->IsIntegerLiteral()) {
+      ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Int32));
+      return;
+    }
+  }
+
+  // The fourth call argument is the join hash table whose runtime filter is applied
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(args[3]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 3, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  // Set return type
+  call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
+}
+
+void Sema::CheckBuiltinFilterParamCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 6)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first call argument must be a pointer to a ProjectedColumnsIterator
+  const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), pci_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(pci_kind)->PointerTo());
+    return;
+  }
+
+  // The second to fourth call arguments must be integers for the column index, type and comparison
+  for (uint32_t i = 1; i < 4; i++) {
+    if (!args[i]->IsIntegerLiteral()) {
+      ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Int32));
+      return;
+    }
+  }
+
+  // The fifth call argument is the execution context holding the parameters
+  const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+  if (!IsPointerToSpecificBuiltin(args[4]->GetType(), exec_ctx_kind)) {
+    ReportIncorrectCallArg(call, 4, GetBuiltinType(exec_ctx_kind)->PointerTo());
+    return;
+  }
+
+  // The sixth call argument must be an integer for the parameter index
+  if (!args[5]->IsIntegerLiteral()) {
+    ReportIncorrectCallArg(call, 5, GetBuiltinType(ast::BuiltinType::Int32));
+    return;
+  }
+
   // Set return type
   call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
 }
 
+void Sema::CheckBuiltinLikeCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 2)) {
+    return;
+  }
+
+  // Both the string and the pattern must be SQL strings
+  const auto &args = call->Arguments();
+  const auto string_kind = ast::BuiltinType::StringVal;
+  for (uint32_t i = 0; i < 2; i++) {
+    if (!args[i]->GetType()->IsSpecificBuiltin(string_kind)) {
+      ReportIncorrectCallArg(call, i, GetBuiltinType(string_kind));
+      return;
+    }
+  }
+
+  // Set return type
+  call->SetType(GetBuiltinType(ast::BuiltinType::Boolean));
+}
+
 void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCountAtLeast(call, 1)) {
     return;
@@ -279,7 +440,8 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
-    case ast::Builtin::AggHashTableInsert: {
+    case ast::Builtin::AggHashTableInsert:
+    case ast::Builtin::AggHashTableInsertPartitioned: {
       if (!CheckArgCount(call, 2)) {
         return;
       }
@@ -385,6 +547,24 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::AggHashTableBuildPartitions: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is an opaque context pointer
+      if (!args[1]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(agg_ht_kind));
+        return;
+      }
+      // Third argument is the merging function
+      if (!args[2]->GetType()->IsFunctionType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(agg_ht_kind));
+        return;
+      }
+
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::AggHashTableFree: {
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
@@ -652,6 +832,31 @@ void Sema::CheckBuiltinJoinHashTableInsert(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(byte_kind)->PointerTo());
 }
 
+void Sema::CheckBuiltinJoinHashTableAddFilterKey(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 2)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument is a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  // Second argument is the SQL integer join key
+  const auto int_kind = ast::BuiltinType::Integer;
+  if (!args[1]->GetType()->IsSpecificBuiltin(int_kind)) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(int_kind));
+    return;
+  }
+
+  // This call returns nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCountAtLeast(call, 1)) {
     return;
@@ -1056,6 +1261,34 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::TableIterRestrictRange: {
+      if (!CheckArgCount(call, 5)) {
+        return;
+      }
+      // The column index, column type, and the bounds of the range are all integer literals
+      for (uint32_t i = 1; i < 5; i++) {
+        if (!call_args[i]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Int64));
+          return;
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterRestrictRangeToParam: {
+      if (!CheckArgCount(call, 5)) {
+        return;
+      }
+      // The column index and type, the comparison, and the parameter index are all integer literals
+      for (uint32_t i = 1; i < 5; i++) {
+        if (!call_args[i]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Int64));
+          return;
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::TableIterGetPCI: {
       // A single-arg builtin return a pointer to the current PCI
       const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
@@ -1074,36 +1307,51 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
 }
 
 void Sema::CheckBuiltinTableIterParCall(ast::CallExpr *call) {
-  if (!CheckArgCount(call, 4)) {
+  if (!CheckArgCount(call, 6)) {
     return;
   }
 
   const auto &call_args = call->Arguments();
 
-  // First argument is table name as a string literal
-  if (!call_args[0]->IsStringLiteral()) {
+  // First argument is either a table oid integer literal or the table name as a string literal
+  if (!call_args[0]->IsIntegerLiteral() && !call_args[0]->IsStringLiteral()) {
     ReportIncorrectCallArg(call, 0, ast::StringType::Get(GetContext()));
     return;
   }
 
-  // Second argument is an opaque query state. For now, check it's a pointer.
+  // Second argument is a fixed length uint32 array of column oids
+  auto *arr_type = call_args[1]->GetType()->SafeAs<ast::ArrayType>();
+  if (arr_type == nullptr || !arr_type->ElementType()->IsSpecificBuiltin(ast::BuiltinType::Uint32) ||
+      !arr_type->HasKnownLength()) {
+    ReportIncorrectCallArg(call, 1, "Second argument should be a fixed length uint32 array");
+    return;
+  }
+
+  // Third argument is an opaque query state. For now, check it's a pointer.
   const auto void_kind = ast::BuiltinType::Nil;
-  if (!call_args[1]->GetType()->IsPointerType()) {
-    ReportIncorrectCallArg(call, 1, GetBuiltinType(void_kind)->PointerTo());
+  if (!call_args[2]->GetType()->IsPointerType()) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(void_kind)->PointerTo());
     return;
   }
 
-  // Third argument is the thread state container
+  // Fourth argument is the execution context
+  const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+  if (!IsPointerToSpecificBuiltin(call_args[3]->GetType(), exec_ctx_kind)) {
+    ReportIncorrectCallArg(call, 3, GetBuiltinType(exec_ctx_kind)->PointerTo());
+    return;
+  }
+
+  // Fifth argument is the thread state container
   const auto tls_kind = ast::BuiltinType::ThreadStateContainer;
-  if (!IsPointerToSpecificBuiltin(call_args[2]->GetType(), tls_kind)) {
-    ReportIncorrectCallArg(call, 2, GetBuiltinType(tls_kind)->PointerTo());
+  if (!IsPointerToSpecificBuiltin(call_args[4]->GetType(), tls_kind)) {
+    ReportIncorrectCallArg(call, 4, GetBuiltinType(tls_kind)->PointerTo());
     return;
   }
 
-  // Third argument is scanner function
-  auto *scan_fn_type = call_args[3]->GetType()->SafeAs<ast::FunctionType>();
+  // Sixth argument is scanner function
+  auto *scan_fn_type = call_args[5]->GetType()->SafeAs<ast::FunctionType>();
   if (scan_fn_type == nullptr) {
-    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[3]->GetType());
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[5]->GetType());
     return;
   }
   // Check type
@@ -1111,7 +1359,146 @@ void Sema::CheckBuiltinTableIterParCall(ast::CallExpr *call) {
   const auto &params = scan_fn_type->Params();
   if (params.size() != 3 || !params[0].type_->IsPointerType() || !params[1].type_->IsPointerType() ||
       !IsPointerToSpecificBuiltin(params[2].type_, tvi_kind)) {
-    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[3]->GetType());
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[5]->GetType());
+    return;
+  }
+
+  // Nil
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
+void Sema::CheckBuiltinCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument must be a *CSVReader
+  const auto csv_kind = ast::BuiltinType::CSVReader;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), csv_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(csv_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::CSVReaderInit: {
+      if (!CheckArgCount(call, 5)) {
+        return;
+      }
+      // The second argument is the file name as a literal string
+      if (!call_args[1]->IsStringLiteral()) {
+        ReportIncorrectCallArg(call, 1, ast::StringType::Get(GetContext()));
+        return;
+      }
+      // The delimiter, quote and escape characters are integer literals
+      for (uint32_t i = 2; i < 5; i++) {
+        if (!call_args[i]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Int8));
+          return;
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::CSVReaderAdvance: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::CSVReaderGetBool:
+    case ast::Builtin::CSVReaderGetInt:
+    case ast::Builtin::CSVReaderGetReal:
+    case ast::Builtin::CSVReaderGetDate:
+    case ast::Builtin::CSVReaderGetString: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is the field index
+      if (!call_args[1]->IsIntegerLiteral()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      ast::BuiltinType::Kind sql_kind;
+      switch (builtin) {
+        case ast::Builtin::CSVReaderGetBool:
+          sql_kind = ast::BuiltinType::Boolean;
+          break;
+        case ast::Builtin::CSVReaderGetInt:
+          sql_kind = ast::BuiltinType::Integer;
+          break;
+        case ast::Builtin::CSVReaderGetReal:
+          sql_kind = ast::BuiltinType::Real;
+          break;
+        case ast::Builtin::CSVReaderGetDate:
+          sql_kind = ast::BuiltinType::Date;
+          break;
+        default:
+          sql_kind = ast::BuiltinType::StringVal;
+          break;
+      }
+      call->SetType(GetBuiltinType(sql_kind));
+      break;
+    }
+    case ast::Builtin::CSVReaderClose: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible CSV reader call");
+    }
+  }
+}
+
+void Sema::CheckBuiltinCSVParallelCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 7)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // First argument is the file name as a string literal
+  if (!call_args[0]->IsStringLiteral()) {
+    ReportIncorrectCallArg(call, 0, ast::StringType::Get(GetContext()));
+    return;
+  }
+
+  // The delimiter, quote and escape characters are integer literals
+  for (uint32_t i = 1; i < 4; i++) {
+    if (!call_args[i]->IsIntegerLiteral()) {
+      ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Int8));
+      return;
+    }
+  }
+
+  // Fifth argument is an opaque query state. For now, check it's a pointer.
+  if (!call_args[4]->GetType()->IsPointerType()) {
+    ReportIncorrectCallArg(call, 4, GetBuiltinType(ast::BuiltinType::Nil)->PointerTo());
+    return;
+  }
+
+  // Sixth argument is the thread state container
+  const auto tls_kind = ast::BuiltinType::ThreadStateContainer;
+  if (!IsPointerToSpecificBuiltin(call_args[5]->GetType(), tls_kind)) {
+    ReportIncorrectCallArg(call, 5, GetBuiltinType(tls_kind)->PointerTo());
+    return;
+  }
+
+  // Seventh argument is the scanner function
+  auto *scan_fn_type = call_args[6]->GetType()->SafeAs<ast::FunctionType>();
+  if (scan_fn_type == nullptr) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[6]->GetType());
+    return;
+  }
+  const auto &params = scan_fn_type->Params();
+  if (params.size() != 3 || !params[0].type_->IsPointerType() || !params[1].type_->IsPointerType() ||
+      !IsPointerToSpecificBuiltin(params[2].type_, ast::BuiltinType::CSVReader)) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[6]->GetType());
     return;
   }
 
@@ -1335,6 +1722,32 @@ void Sema::CheckBuiltinSizeOfCall(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Uint32));
 }
 
+void Sema::CheckBuiltinOffsetOfCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 2)) {
+    return;
+  }
+
+  // The first argument is a struct type. The second argument is the name of one of its members, which is not an
+  // expression in scope, so only the first argument is resolved.
+  auto *struct_type = Resolve(call->Arguments()[0]);
+  if (struct_type == nullptr) {
+    return;
+  }
+  if (!struct_type->IsStructType()) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadArgToOffsetOf, struct_type, 0);
+    return;
+  }
+
+  auto *member = call->Arguments()[1]->SafeAs<ast::IdentifierExpr>();
+  if (member == nullptr || struct_type->As<ast::StructType>()->LookupFieldByName(member->Name()) == nullptr) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadArgToOffsetOf, struct_type, 1);
+    return;
+  }
+
+  // This call returns an unsigned 32-bit value for the offset of the member
+  call->SetType(GetBuiltinType(ast::BuiltinType::Uint32));
+}
+
 void Sema::CheckBuiltinPtrCastCall(ast::CallExpr *call) {
   if (!CheckArgCount(call, 2)) {
     return;
@@ -1505,9 +1918,9 @@ void Sema::CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin) {
           return;
         }
 
-        // Last argument must be the TopK value
+        // Last argument must be the TopK value (either a literal, as in @sorterInsertTopK, or a uint64)
         const auto uint64_kind = ast::BuiltinType::Uint64;
-        if (!call_args[3]->GetType()->IsSpecificBuiltin(uint64_kind)) {
+        if (!call_args[3]->IsIntegerLiteral() && !call_args[3]->GetType()->IsSpecificBuiltin(uint64_kind)) {
           ReportIncorrectCallArg(call, 3, GetBuiltinType(uint64_kind));
           return;
         }
@@ -1539,6 +1952,47 @@ void Sema::CheckBuiltinSorterFree(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinSorterAccess(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // First argument must be a pointer to a Sorter
+  const auto sorter_kind = ast::BuiltinType::Sorter;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), sorter_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(sorter_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::SorterGetTupleCount: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+      break;
+    }
+    case ast::Builtin::SorterGetTupleAt: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is the position of the tuple
+      const auto uint64_kind = ast::BuiltinType::Uint64;
+      if (!call_args[1]->IsIntegerLiteral() && !call_args[1]->GetType()->IsSpecificBuiltin(uint64_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(uint64_kind));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible sorter access call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCountAtLeast(call, 1)) {
     return;
@@ -1589,6 +2043,226 @@ void Sema::CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin)
   }
 }
 
+void Sema::CheckBuiltinWindowCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  switch (builtin) {
+    case ast::Builtin::WindowInit: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+
+      // First argument must be a pointer to a WindowOperator
+      const auto window_kind = ast::BuiltinType::WindowOperator;
+      if (!IsPointerToSpecificBuiltin(args[0]->GetType(), window_kind)) {
+        ReportIncorrectCallArg(call, 0, GetBuiltinType(window_kind)->PointerTo());
+        return;
+      }
+
+      // Second argument must be a pointer to the sorted input
+      const auto sorter_kind = ast::BuiltinType::Sorter;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), sorter_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(sorter_kind)->PointerTo());
+        return;
+      }
+
+      // Third and fourth arguments are the partition and peer comparison functions, like the sorter's
+      for (uint32_t i = 2; i < 4; i++) {
+        auto *const cmp_func_type = args[i]->GetType()->SafeAs<ast::FunctionType>();
+        if (cmp_func_type == nullptr || cmp_func_type->NumParams() != 2 ||
+            !cmp_func_type->ReturnType()->IsSpecificBuiltin(ast::BuiltinType::Int32) ||
+            !cmp_func_type->Params()[0].type_->IsPointerType() || !cmp_func_type->Params()[1].type_->IsPointerType()) {
+          GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadComparisonFunctionForWindow,
+                                     args[i]->GetType());
+          return;
+        }
+      }
+      break;
+    }
+    case ast::Builtin::WindowFree: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      const auto window_kind = ast::BuiltinType::WindowOperator;
+      if (!IsPointerToSpecificBuiltin(args[0]->GetType(), window_kind)) {
+        ReportIncorrectCallArg(call, 0, GetBuiltinType(window_kind)->PointerTo());
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::WindowFrameInit: {
+      if (!CheckArgCount(call, 6)) {
+        return;
+      }
+      const auto frame_kind = ast::BuiltinType::WindowFrame;
+      if (!IsPointerToSpecificBuiltin(args[0]->GetType(), frame_kind)) {
+        ReportIncorrectCallArg(call, 0, GetBuiltinType(frame_kind)->PointerTo());
+        return;
+      }
+      // The mode, the start bound and its offset, and the end bound and its offset are all integer literals
+      for (uint32_t i = 1; i < 6; i++) {
+        if (!args[i]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Int32));
+          return;
+        }
+      }
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible window call");
+    }
+  }
+
+  // These calls return nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
+void Sema::CheckBuiltinWindowIterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  const auto window_iter_kind = ast::BuiltinType::WindowIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), window_iter_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(window_iter_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::WindowIterInit: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+
+      // The second argument is the window to iterate over
+      const auto window_kind = ast::BuiltinType::WindowOperator;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), window_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(window_kind)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::WindowIterHasNext:
+    case ast::Builtin::WindowIterIsPartitionStart: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::WindowIterNext:
+    case ast::Builtin::WindowIterClose: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::WindowIterGetRow: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    case ast::Builtin::WindowIterGetRowNumber:
+    case ast::Builtin::WindowIterGetRank:
+    case ast::Builtin::WindowIterGetDenseRank: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+      break;
+    }
+    case ast::Builtin::WindowIterGetFrameBegin:
+    case ast::Builtin::WindowIterGetFrameEnd: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+
+      // The second argument is the frame, and the result is a position in the current partition
+      const auto frame_kind = ast::BuiltinType::WindowFrame;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), frame_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(frame_kind)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible window iteration call");
+    }
+  }
+}
+
+void Sema::CheckBuiltinWindowTreeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first argument is a pointer to any of the window trees
+  if (!IsPointerToWindowTree(args[0]->GetType())) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kNotAWindowTree, args[0]->GetType());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::WindowTreeInit:
+    case ast::Builtin::WindowTreeFree: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::WindowTreeBuild: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+
+      // The tree is built over the current partition of a window iterator
+      const auto window_iter_kind = ast::BuiltinType::WindowIterator;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), window_iter_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(window_iter_kind)->PointerTo());
+        return;
+      }
+
+      // The third argument is the offset of the aggregated value in the rows, as given by @offsetOf()
+      const auto uint32_kind = ast::BuiltinType::Uint32;
+      if (!args[2]->GetType()->IsSpecificBuiltin(uint32_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(uint32_kind));
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::WindowTreeQuery: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+
+      // The second and third arguments are the bounds of a frame
+      const auto uint64_kind = ast::BuiltinType::Uint64;
+      for (uint32_t i = 1; i < 3; i++) {
+        if (!args[i]->GetType()->IsSpecificBuiltin(uint64_kind)) {
+          ReportIncorrectCallArg(call, i, GetBuiltinType(uint64_kind));
+          return;
+        }
+      }
+
+      // The last argument is the aggregate receiving the frame's result, of the tree's aggregate type
+      const auto tree_kind = args[0]->GetType()->GetPointeeType()->As<ast::BuiltinType>()->GetKind();
+      const auto agg_kind = WindowTreeAggregateKind(tree_kind);
+      if (!IsPointerToSpecificBuiltin(args[3]->GetType(), agg_kind)) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(agg_kind)->PointerTo());
+        return;
+      }
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible window tree call");
+    }
+  }
+
+  // These calls return nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinOutputAlloc(execution::ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -2214,6 +2888,11 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     return;
   }
 
+  if (builtin == ast::Builtin::OffsetOf) {
+    CheckBuiltinOffsetOfCall(call);
+    return;
+  }
+
   // First, resolve all call arguments. If any fail, exit immediately.
   for (auto *arg : call->Arguments()) {
     auto *resolved_type = Resolve(arg);
@@ -2250,6 +2929,26 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinFilterCall(call);
       break;
     }
+    case ast::Builtin::FilterLike:
+    case ast::Builtin::FilterNotLike:
+    case ast::Builtin::FilterILike:
+    case ast::Builtin::FilterNotILike: {
+      CheckBuiltinFilterLikeCall(call);
+      break;
+    }
+    case ast::Builtin::FilterJoin: {
+      CheckBuiltinFilterJoinCall(call);
+      break;
+    }
+    case ast::Builtin::FilterParam: {
+      CheckBuiltinFilterParamCall(call);
+      break;
+    }
+    case ast::Builtin::Like:
+    case ast::Builtin::ILike: {
+      CheckBuiltinLikeCall(call);
+      break;
+    }
     case ast::Builtin::ExecutionContextGetMemoryPool:
     case ast::Builtin::ExecutionContextStartResourceTracker:
     case ast::Builtin::ExecutionContextEndResourceTracker:
@@ -2268,6 +2967,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::TableIterInitBind:
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterReset:
+    case ast::Builtin::TableIterRestrictRange:
+    case ast::Builtin::TableIterRestrictRangeToParam:
     case ast::Builtin::TableIterGetPCI:
     case ast::Builtin::TableIterClose: {
       CheckBuiltinTableIterCall(call, builtin);
@@ -2277,6 +2978,21 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinTableIterParCall(call);
       break;
     }
+    case ast::Builtin::CSVReaderInit:
+    case ast::Builtin::CSVReaderAdvance:
+    case ast::Builtin::CSVReaderGetBool:
+    case ast::Builtin::CSVReaderGetInt:
+    case ast::Builtin::CSVReaderGetReal:
+    case ast::Builtin::CSVReaderGetDate:
+    case ast::Builtin::CSVReaderGetString:
+    case ast::Builtin::CSVReaderClose: {
+      CheckBuiltinCSVReaderCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::CSVReaderParallel: {
+      CheckBuiltinCSVParallelCall(call);
+      break;
+    }
     case ast::Builtin::PCIIsFiltered:
     case ast::Builtin::PCIHasNext:
     case ast::Builtin::PCIHasNextFiltered:
@@ -2323,10 +3039,12 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     }
     case ast::Builtin::AggHashTableInit:
     case ast::Builtin::AggHashTableInsert:
+    case ast::Builtin::AggHashTableInsertPartitioned:
     case ast::Builtin::AggHashTableLookup:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
+    case ast::Builtin::AggHashTableBuildPartitions:
     case ast::Builtin::AggHashTableFree: {
       CheckBuiltinAggHashTableCall(call, builtin);
       break;
@@ -2362,6 +3080,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinJoinHashTableInsert(call);
       break;
     }
+    case ast::Builtin::JoinHashTableAddFilterKey: {
+      CheckBuiltinJoinHashTableAddFilterKey(call);
+      break;
+    }
     case ast::Builtin::JoinHashTableIterInit: {
       CheckBuiltinJoinHashTableIterInit(call);
       break;
@@ -2407,6 +3129,11 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterFree(call);
       break;
     }
+    case ast::Builtin::SorterGetTupleCount:
+    case ast::Builtin::SorterGetTupleAt: {
+      CheckBuiltinSorterAccess(call, builtin);
+      break;
+    }
     case ast::Builtin::SorterIterInit:
     case ast::Builtin::SorterIterHasNext:
     case ast::Builtin::SorterIterNext:
@@ -2415,6 +3142,33 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::WindowInit:
+    case ast::Builtin::WindowFree:
+    case ast::Builtin::WindowFrameInit: {
+      CheckBuiltinWindowCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::WindowIterInit:
+    case ast::Builtin::WindowIterHasNext:
+    case ast::Builtin::WindowIterNext:
+    case ast::Builtin::WindowIterGetRow:
+    case ast::Builtin::WindowIterIsPartitionStart:
+    case ast::Builtin::WindowIterGetRowNumber:
+    case ast::Builtin::WindowIterGetRank:
+    case ast::Builtin::WindowIterGetDenseRank:
+    case ast::Builtin::WindowIterGetFrameBegin:
+    case ast::Builtin::WindowIterGetFrameEnd:
+    case ast::Builtin::WindowIterClose: {
+      CheckBuiltinWindowIterCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::WindowTreeInit:
+    case ast::Builtin::WindowTreeBuild:
+    case ast::Builtin::WindowTreeQuery:
+    case ast::Builtin::WindowTreeFree: {
+      CheckBuiltinWindowTreeCall(call, builtin);
+      break;
+    }
     case ast::Builtin::SizeOf: {
       CheckBuiltinSizeOfCall(call);
       break;
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "common/math_util.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/projected_columns_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/bit_util.h"
@@ -92,6 +93,14 @@ void AggregationHashTable::Grow() {
 }
 
 byte *AggregationHashTable::Insert(const hash_t hash) {
+  // Over the memory budget, pre-aggregate into partitions that can be spilled
+  if (!partitioned_ && can_partition_ && IsOverMemoryLimit()) {
+    partitioned_ = true;
+  }
+  return partitioned_ ? InsertPartitioned(hash) : InsertEntry(hash);
+}
+
+byte *AggregationHashTable::InsertEntry(const hash_t hash) {
   // Grow if need be
   if (NeedsToGrow()) {
     Grow();
@@ -110,11 +119,54 @@ byte *AggregationHashTable::Insert(const hash_t hash) {
 }
 
 byte *AggregationHashTable::InsertPartitioned(const hash_t hash) {
-  byte *ret = Insert(hash);
-  if (hash_table_.NumElements() >= flush_threshold_) {
+  // Flush before inserting. A flush may spill, so the new entry would not be
+  // in memory anymore when the caller writes it. A bypassing table holds no
+  // entries, but flushes as often to check the memory budget.
+  const uint64_t window_size = bypass_ ? window_bypassed_ : hash_table_.NumElements();
+  if (window_size >= flush_threshold_) {
+    // Decide from the window that just ended whether pre-aggregation pays off
+    const bool bypass = ShouldBypass();
     FlushToOverflowPartitions();
+    StartWindow(bypass);
   }
-  return ret;
+  return bypass_ ? InsertBypassed(hash) : InsertEntry(hash);
+}
+
+bool AggregationHashTable::ShouldBypass() const {
+  if (bypass_) {
+    // Pre-aggregating the window would have made one group per distinct hash
+    const uint64_t num_groups = std::min(window_estimate_->Estimate(), window_bypassed_);
+    const auto num_hits = static_cast<float>(window_bypassed_ - num_groups);
+    return num_hits < K_MIN_PRE_AGGREGATION_HIT_RATIO * static_cast<float>(window_bypassed_);
+  }
+  const auto lookups = static_cast<float>(window_lookups_);
+  return window_lookups_ >= flush_threshold_ &&
+         static_cast<float>(window_hits_) < K_MIN_PRE_AGGREGATION_HIT_RATIO * lookups;
+}
+
+void AggregationHashTable::StartWindow(const bool bypass) {
+  bypass_ = bypass;
+  window_lookups_ = window_hits_ = window_bypassed_ = 0;
+  if (bypass_) {
+    window_estimate_.reset(libcount::HLL::Create(K_DEFAULT_HLL_PRECISION));
+  } else {
+    window_estimate_.reset();
+  }
+}
+
+byte *AggregationHashTable::InsertBypassed(const hash_t hash) {
+  TERRIER_ASSERT(hash_table_.NumElements() == 0, "A bypassing table must not hold entries in its hash table");
+
+  auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+  entry->hash_ = hash;
+  AddToOverflowPartition(entry);
+  window_estimate_->Update(hash);
+
+  // Update stats
+  window_bypassed_++;
+  stats_.num_bypassed_++;
+
+  return entry->payload_;
 }
 
 void AggregationHashTable::FlushToOverflowPartitions() {
@@ -123,18 +175,63 @@ void AggregationHashTable::FlushToOverflowPartitions() {
   }
 
   // Dump hash table into overflow partition
-  hash_table_.FlushEntries([this](HashTableEntry *entry) {
-    const uint64_t part_idx = (entry->hash_ >> partition_shift_bits_);
-    entry->next_ = partition_heads_[part_idx];
-    partition_heads_[part_idx] = entry;
-    if (UNLIKELY(partition_tails_[part_idx] == nullptr)) {
-      partition_tails_[part_idx] = entry;
-    }
-    partition_estimates_[part_idx]->Update(entry->hash_);
-  });
+  hash_table_.FlushEntries([this](HashTableEntry *entry) { AddToOverflowPartition(entry); });
 
   // Update stats
   stats_.num_flushes_++;
+
+  // Move the overflow partitions out of memory if the query is over budget
+  if (IsOverMemoryLimit()) {
+    SpillOverflowPartitions();
+  }
+}
+
+void AggregationHashTable::AddToOverflowPartition(HashTableEntry *const entry) {
+  const uint64_t part_idx = (entry->hash_ >> partition_shift_bits_);
+  entry->next_ = partition_heads_[part_idx];
+  partition_heads_[part_idx] = entry;
+  if (UNLIKELY(partition_tails_[part_idx] == nullptr)) {
+    partition_tails_[part_idx] = entry;
+  }
+  partition_estimates_[part_idx]->Update(entry->hash_);
+}
+
+bool AggregationHashTable::IsOverMemoryLimit() const {
+  const auto tracker = memory_->GetTracker();
+  return tracker != nullptr && tracker->IsOverLimit();
+}
+
+void AggregationHashTable::SpillOverflowPartitions() {
+  TERRIER_ASSERT(hash_table_.NumElements() == 0, "All entries must be flushed to the overflow partitions");
+  TERRIER_ASSERT(owned_entries_.empty(), "Overflow partitions must not hold entries owned by other tables");
+
+  if (spill_file_ == nullptr) {
+    spill_file_ = std::make_unique<SpillFile>();
+  }
+  if (spilled_partitions_.empty()) {
+    spilled_partitions_.resize(K_DEFAULT_NUM_PARTITIONS);
+  }
+
+  // Write each partition out as one contiguous run
+  for (uint32_t part_idx = 0; part_idx < K_DEFAULT_NUM_PARTITIONS; part_idx++) {
+    if (partition_heads_[part_idx] == nullptr) {
+      continue;
+    }
+    SpilledRun run{spill_file_.get(), spill_file_->Size(), 0};
+    for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+      spill_file_->Append(entry, entries_.ElementSize());
+      run.num_entries_++;
+    }
+    spilled_partitions_[part_idx].push_back(run);
+    partition_heads_[part_idx] = partition_tails_[part_idx] = nullptr;
+  }
+  spill_file_->Flush();
+
+  // Every entry was in an overflow partition, so all of them can be released
+  entries_.clear();
+
+  // Update stats
+  stats_.num_spills_++;
 }
 
 void AggregationHashTable::AllocateOverflowPartitions() {
@@ -310,8 +407,9 @@ void AggregationHashTable::CreateMissingGroups(ProjectedColumnsIterator *iters[]
       continue;
     }
 
-    // Initialize
-    init_agg_fn(Insert(hash), iters);
+    // Initialize. The batch holds pointers to existing groups, so the table
+    // must not flush here.
+    init_agg_fn(InsertEntry(hash), iters);
   }
 }
 
@@ -376,18 +474,33 @@ void AggregationHashTable::TransferMemoryAndPartitions(
         if (partition_tails_[part_idx] == nullptr) {
           partition_tails_[part_idx] = table->partition_tails_[part_idx];
         }
+      }
+      if (!table->IsPartitionEmpty(part_idx)) {
         // Update the partition's unique-count estimate
         partition_estimates_[part_idx]->Merge(table->partition_estimates_[part_idx]);
       }
     }
+
+    // And the partitions they spilled to disk
+    if (table->HasSpilled()) {
+      TERRIER_ASSERT(table->owned_spill_files_.empty(),
+                     "A thread-local aggregation table should not have any spill files of other tables.");
+      if (spilled_partitions_.empty()) {
+        spilled_partitions_.resize(K_DEFAULT_NUM_PARTITIONS);
+      }
+      for (uint32_t part_idx = 0; part_idx < K_DEFAULT_NUM_PARTITIONS; part_idx++) {
+        const auto &runs = table->spilled_partitions_[part_idx];
+        spilled_partitions_[part_idx].insert(spilled_partitions_[part_idx].end(), runs.begin(), runs.end());
+      }
+      owned_spill_files_.emplace_back(std::move(table->spill_file_));
+    }
   }
 }
 
 AggregationHashTable *AggregationHashTable::BuildTableOverPartition(void *const query_state,
                                                                     const uint32_t partition_idx) {
   TERRIER_ASSERT(partition_idx < K_DEFAULT_NUM_PARTITIONS, "Out-of-bounds partition access");
-  TERRIER_ASSERT(partition_heads_[partition_idx] != nullptr,
-                 "Should not build aggregation table over empty partition!");
+  TERRIER_ASSERT(!IsPartitionEmpty(partition_idx), "Should not build aggregation table over empty partition!");
 
   // If the table has already been built, return it
   if (partition_tables_[partition_idx] != nullptr) {
@@ -398,14 +511,39 @@ AggregationHashTable *AggregationHashTable::BuildTableOverPartition(void *const
   auto estimated_size = partition_estimates_[partition_idx]->Estimate();
   auto *agg_table = new (memory_->AllocateAligned(sizeof(AggregationHashTable), alignof(AggregationHashTable), false))
       AggregationHashTable(memory_, payload_size_, static_cast<uint32_t>(estimated_size));
+  agg_table->can_partition_ = false;
 
   util::Timer<std::milli> timer;
   timer.Start();
 
+  // Read the spilled entries of the partition back, and link them in front of
+  // the entries still in memory
+  HashTableEntry *head = partition_heads_[partition_idx];
+  std::vector<std::pair<byte *, std::size_t>> spilled_entries;
+  if (!spilled_partitions_.empty()) {
+    const std::size_t entry_size = sizeof(HashTableEntry) + payload_size_;
+    for (const auto &run : spilled_partitions_[partition_idx]) {
+      const std::size_t size = run.num_entries_ * entry_size;
+      auto *buffer = static_cast<byte *>(memory_->AllocateAligned(size, alignof(HashTableEntry), false));
+      run.file_->Read(run.offset_, buffer, size);
+      for (uint64_t i = 0; i < run.num_entries_; i++) {
+        auto *entry = reinterpret_cast<HashTableEntry *>(buffer + i * entry_size);
+        entry->next_ = head;
+        head = entry;
+      }
+      spilled_entries.emplace_back(buffer, size);
+    }
+  }
+
   // Build it
-  AggregationOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1);
+  AggregationOverflowPartitionIterator iter(&head, &head + 1);
   merge_partition_fn_(query_state, agg_table, &iter);
 
+  // The merged aggregates were copied into the new table
+  for (const auto &[buffer, size] : spilled_entries) {
+    memory_->Deallocate(buffer, size);
+  }
+
   timer.Stop();
   EXECUTION_LOG_DEBUG(
       "Overflow Partition {}: estimated size = {}, actual size = {}, "
@@ -438,9 +576,7 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
 
   // Determine the non-empty overflow partitions
   alignas(common::Constants::CACHELINE_SIZE) uint32_t nonempty_parts[K_DEFAULT_NUM_PARTITIONS];
-  uint32_t num_nonempty_parts =
-      util::VectorUtil::FilterNe(reinterpret_cast<const intptr_t *>(partition_heads_), K_DEFAULT_NUM_PARTITIONS,
-                                 intptr_t(0), nonempty_parts, nullptr);
+  const uint32_t num_nonempty_parts = CollectNonEmptyPartitions(nonempty_parts);
 
   tbb::parallel_for_each(nonempty_parts, nonempty_parts + num_nonempty_parts, [&](const uint32_t part_idx) {
     // Build a hash table over the given partition
@@ -454,4 +590,38 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   });
 }
 
+void AggregationHashTable::BuildAllPartitions(void *query_state, AggregationHashTable::MergePartitionFn merge_fn) {
+  // A table that never flushed still holds all of its aggregates
+  if (partition_heads_ == nullptr) {
+    return;
+  }
+
+  merge_partition_fn_ = merge_fn;
+
+  // Aggregates inserted since the last flush are not in any partition yet
+  if (NumElements() > 0) {
+    FlushToOverflowPartitions();
+  }
+
+  // Building a partition only touches the partition and its own table, so all
+  // partitions can be built at once
+  alignas(common::Constants::CACHELINE_SIZE) uint32_t nonempty_parts[K_DEFAULT_NUM_PARTITIONS];
+  const uint32_t num_nonempty_parts = CollectNonEmptyPartitions(nonempty_parts);
+  tbb::parallel_for_each(nonempty_parts, nonempty_parts + num_nonempty_parts,
+                         [&](const uint32_t part_idx) { BuildTableOverPartition(query_state, part_idx); });
+}
+
+uint32_t AggregationHashTable::CollectNonEmptyPartitions(uint32_t nonempty_parts[]) const {
+  if (spilled_partitions_.empty()) {
+    return util::VectorUtil::FilterNe(reinterpret_cast<const intptr_t *>(partition_heads_), K_DEFAULT_NUM_PARTITIONS,
+                                      intptr_t(0), nonempty_parts, nullptr);
+  }
+  uint32_t num_nonempty_parts = 0;
+  for (uint32_t part_idx = 0; part_idx < K_DEFAULT_NUM_PARTITIONS; part_idx++) {
+    nonempty_parts[num_nonempty_parts] = part_idx;
+    num_nonempty_parts += static_cast<uint32_t>(!IsPartitionEmpty(part_idx));
+  }
+  return num_nonempty_parts;
+}
+
 }  // namespace terrier::execution::sql
@@ -0,0 +1,252 @@
+#include "execution/sql/bulk_loader.h"
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
+#include "catalog/index_schema.h"
+#include "catalog/schema.h"
+#include "common/allocator.h"
+#include "common/exception.h"
+#include "execution/sql/csv_reader.h"
+#include "execution/util/timer.h"
+#include "loggers/execution_logger.h"
+#include "parser/expression/column_value_expression.h"
+#include "storage/index/index.h"
+#include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "transaction/transaction_context.h"
+#include "type/type_util.h"
+
+namespace terrier::execution::sql {
+
+namespace {
+
+std::vector<catalog::col_oid_t> ColOidsOf(const catalog::Schema &schema) {
+  std::vector<catalog::col_oid_t> col_oids;
+  col_oids.reserve(schema.GetColumns().size());
+  for (const auto &col : schema.GetColumns()) col_oids.emplace_back(col.Oid());
+  return col_oids;
+}
+
+}  // namespace
+
+BulkLoader::BulkLoader(const common::ManagedPointer<transaction::TransactionContext> txn,
+                       const common::ManagedPointer<catalog::CatalogAccessor> accessor, const catalog::db_oid_t db_oid,
+                       const catalog::table_oid_t table_oid)
+    : txn_(txn),
+      accessor_(accessor),
+      db_oid_(db_oid),
+      table_oid_(table_oid),
+      table_(accessor->GetTable(table_oid)),
+      schema_(accessor->GetSchema(table_oid)),
+      col_oids_(ColOidsOf(schema_)),
+      projection_map_(table_->ProjectionMapForOids(col_oids_)),
+      batch_initializer_(table_->InitializerForProjectedColumns(col_oids_, table_->GetNumSlotsPerBlock())),
+      redo_initializer_(table_->InitializerForProjectedRow(col_oids_)) {}
+
+uint64_t BulkLoader::LoadCSV(const std::string &file_name, const char delimiter, const char quote, const char escape) {
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  MappedFile file(file_name);
+  const std::vector<const char *> chunk_starts = CSVReader::SplitChunks(file, delimiter, quote, escape);
+
+  tbb::task_scheduler_init scheduler;
+  tbb::parallel_for(std::size_t(0), chunk_starts.size() - 1, [&](const std::size_t chunk_idx) {
+    LoadChunk(chunk_starts[chunk_idx], chunk_starts[chunk_idx + 1], delimiter, quote, escape);
+  });
+
+  BuildIndexes();
+
+  uint64_t num_tuples = 0;
+  for (const auto &run : runs_) num_tuples += run.num_tuples_;
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Bulk load of file {}: {} chunks, {} rows, {} blocks, load time = {:2f} ms", file_name,
+                      chunk_starts.size() - 1, num_tuples, runs_.size(), timer.Elapsed());
+  return num_tuples;
+}
+
+void BulkLoader::LoadChunk(const char *const begin, const char *const end, const char delimiter, const char quote,
+                           const char escape) {
+  CSVReader reader(begin, end, delimiter, quote, escape);
+  byte *const buffer = common::AllocationUtil::AllocateAligned(batch_initializer_.ProjectedColumnsSize());
+  storage::ProjectedColumns *const batch = batch_initializer_.Initialize(buffer);
+
+  uint32_t num_tuples = 0;
+  try {
+    while (reader.Advance()) {
+      if (reader.NumFields() != col_oids_.size()) {
+        throw EXECUTION_EXCEPTION(("COPY expected " + std::to_string(col_oids_.size()) + " fields per row but got " +
+                                   std::to_string(reader.NumFields()))
+                                      .c_str());
+      }
+      batch->SetNumTuples(num_tuples + 1);
+      storage::ProjectedColumns::RowView row = batch->InterpretAsRow(num_tuples);
+      // Start from an all-NULL row so that a failed conversion never leaves behind values of an earlier batch
+      for (uint16_t i = 0; i < row.NumColumns(); i++) row.SetNull(i);
+      num_tuples++;
+      ReadRow(&reader, &row);
+      if (num_tuples == batch->MaxTuples()) {
+        InsertBatch(batch);
+        num_tuples = 0;
+      }
+    }
+    if (num_tuples > 0) InsertBatch(batch);
+  } catch (...) {
+    // Varlens of rows that never made it into the table are still owned by the batch
+    FreeVarlens(batch, num_tuples);
+    delete[] buffer;
+    throw;
+  }
+  delete[] buffer;
+}
+
+void BulkLoader::ReadRow(CSVReader *const reader, storage::ProjectedColumns::RowView *const row) const {
+  const auto &columns = schema_.GetColumns();
+  for (uint32_t field = 0; field < columns.size(); field++) {
+    const catalog::Schema::Column &column = columns[field];
+    const uint16_t col_idx = projection_map_.at(column.Oid());
+    switch (column.Type()) {
+      case type::TypeId::BOOLEAN: {
+        const BoolVal val = reader->GetBool(field);
+        if (!val.is_null_) *reinterpret_cast<bool *>(row->AccessForceNotNull(col_idx)) = val.val_;
+        break;
+      }
+      case type::TypeId::TINYINT: {
+        const Integer val = reader->GetInteger(field);
+        if (!val.is_null_) {
+          *reinterpret_cast<int8_t *>(row->AccessForceNotNull(col_idx)) = static_cast<int8_t>(val.val_);
+        }
+        break;
+      }
+      case type::TypeId::SMALLINT: {
+        const Integer val = reader->GetInteger(field);
+        if (!val.is_null_) {
+          *reinterpret_cast<int16_t *>(row->AccessForceNotNull(col_idx)) = static_cast<int16_t>(val.val_);
+        }
+        break;
+      }
+      case type::TypeId::INTEGER: {
+        const Integer val = reader->GetInteger(field);
+        if (!val.is_null_) {
+          *reinterpret_cast<int32_t *>(row->AccessForceNotNull(col_idx)) = static_cast<int32_t>(val.val_);
+        }
+        break;
+      }
+      case type::TypeId::BIGINT: {
+        const Integer val = reader->GetInteger(field);
+        if (!val.is_null_) *reinterpret_cast<int64_t *>(row->AccessForceNotNull(col_idx)) = val.val_;
+        break;
+      }
+      case type::TypeId::DECIMAL: {
+        const Real val = reader->GetReal(field);
+        if (!val.is_null_) *reinterpret_cast<double *>(row->AccessForceNotNull(col_idx)) = val.val_;
+        break;
+      }
+      case type::TypeId::DATE: {
+        const DateVal val = reader->GetDate(field);
+        if (!val.is_null_) *reinterpret_cast<uint32_t *>(row->AccessForceNotNull(col_idx)) = val.val_.ToNative();
+        break;
+      }
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY: {
+        const StringVal val = reader->GetVarlen(field);
+        if (!val.is_null_) {
+          // The reader's buffers only live until the next batch, so the table gets its own copy
+          *reinterpret_cast<storage::VarlenEntry *>(row->AccessForceNotNull(col_idx)) =
+              StringVal::CreateVarlen(val, true);
+        }
+        break;
+      }
+      default:
+        throw EXECUTION_EXCEPTION(("COPY does not support the type of column " + column.Name()).c_str());
+    }
+    if (!column.Nullable() && row->IsNull(col_idx)) {
+      throw EXECUTION_EXCEPTION(("null value in column " + column.Name() + " violates not-null constraint").c_str());
+    }
+  }
+}
+
+void BulkLoader::FreeVarlens(storage::ProjectedColumns *const batch, const uint32_t num_tuples) const {
+  for (const auto &column : schema_.GetColumns()) {
+    if (column.Type() != type::TypeId::VARCHAR && column.Type() != type::TypeId::VARBINARY) continue;
+    const uint16_t col_idx = projection_map_.at(column.Oid());
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      const byte *const value = batch->InterpretAsRow(i).AccessWithNullCheck(col_idx);
+      if (value == nullptr) continue;
+      const auto *const varlen = reinterpret_cast<const storage::VarlenEntry *>(value);
+      if (varlen->NeedReclaim()) delete[] varlen->Content();
+    }
+  }
+}
+
+void BulkLoader::InsertBatch(storage::ProjectedColumns *const batch) {
+  const uint32_t num_tuples = batch->NumTuples();
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const storage::TupleSlot first = table_->InsertBlock(txn_, batch);
+  // Recovery replays one redo record per tuple, so the block is still logged row by row
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    storage::RedoRecord *const redo = txn_->StageWrite(db_oid_, table_oid_, redo_initializer_);
+    storage::ProjectedColumns::RowView row = batch->InterpretAsRow(i);
+    for (uint16_t col = 0; col < row.NumColumns(); col++) {
+      storage::StorageUtil::CopyWithNullCheck(row.AccessWithNullCheck(col), redo->Delta(),
+                                              static_cast<uint16_t>(batch->AttrSizeForColumn(col)), col);
+    }
+    redo->SetTupleSlot(storage::TupleSlot(first.GetBlock(), first.GetOffset() + i));
+  }
+  runs_.push_back({first, num_tuples});
+}
+
+void BulkLoader::BuildIndexes() {
+  for (const auto &[index, index_schema] : accessor_->GetIndexes(table_oid_)) {
+    // Only plain column keys can be read straight out of the table
+    std::vector<catalog::col_oid_t> key_oids;
+    for (const auto &key_col : index_schema.GetColumns()) {
+      const auto expr = key_col.StoredExpression();
+      if (expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+        throw EXECUTION_EXCEPTION("COPY does not support indexes on expressions");
+      }
+      const catalog::col_oid_t oid = expr.CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid();
+      if (std::find(key_oids.begin(), key_oids.end(), oid) == key_oids.end()) key_oids.emplace_back(oid);
+    }
+
+    const storage::ProjectedRowInitializer table_initializer = table_->InitializerForProjectedRow(key_oids);
+    const storage::ProjectionMap table_pm = table_->ProjectionMapForOids(key_oids);
+    byte *const table_buffer = common::AllocationUtil::AllocateAligned(table_initializer.ProjectedRowSize());
+    storage::ProjectedRow *const table_pr = table_initializer.InitializeRow(table_buffer);
+    byte *const key_buffer =
+        common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+    storage::ProjectedRow *const key_pr = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    const auto &key_pm = index->GetKeyOidToOffsetMap();
+
+    bool inserted = true;
+    for (const auto &run : runs_) {
+      for (uint32_t i = 0; i < run.num_tuples_ && inserted; i++) {
+        const storage::TupleSlot slot(run.first_.GetBlock(), run.first_.GetOffset() + i);
+        const bool UNUSED_ATTRIBUTE visible = table_->Select(txn_, slot, table_pr);
+        TERRIER_ASSERT(visible, "The loading transaction must see its own inserts");
+        for (const auto &key_col : index_schema.GetColumns()) {
+          const catalog::col_oid_t oid =
+              key_col.StoredExpression().CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid();
+          storage::StorageUtil::CopyWithNullCheck(table_pr->AccessWithNullCheck(table_pm.at(oid)), key_pr,
+                                                  storage::AttrSizeBytes(type::TypeUtil::GetTypeSize(key_col.Type())),
+                                                  key_pm.at(key_col.Oid()));
+        }
+        inserted =
+            index_schema.Unique() ? index->InsertUnique(txn_, *key_pr, slot) : index->Insert(txn_, *key_pr, slot);
+      }
+    }
+
+    delete[] table_buffer;
+    delete[] key_buffer;
+    if (!inserted) throw EXECUTION_EXCEPTION("duplicate key value violates unique constraint");
+  }
+}
+
+}  // namespace terrier::execution::sql
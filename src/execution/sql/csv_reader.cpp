@@ -0,0 +1,256 @@
+#include "execution/sql/csv_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/exception.h"
+#include "execution/sql/runtime_types.h"
+#include "execution/sql/thread_state_container.h"
+#include "execution/util/timer.h"
+#include "loggers/execution_logger.h"
+
+namespace terrier::execution::sql {
+
+MappedFile::MappedFile(const std::string &file_name) {
+  const int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw EXECUTION_EXCEPTION(("Could not open file " + file_name + ": " + std::strerror(errno)).c_str());
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) < 0) {
+    close(fd);
+    throw EXECUTION_EXCEPTION(("Could not stat file " + file_name + ": " + std::strerror(errno)).c_str());
+  }
+  size_ = static_cast<std::size_t>(file_stat.st_size);
+  // mmap() rejects empty mappings. An empty file is just an empty range.
+  if (size_ > 0) {
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      throw EXECUTION_EXCEPTION(("Could not map file " + file_name + ": " + std::strerror(errno)).c_str());
+    }
+    // The file is read front to back, so let the kernel read ahead aggressively.
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char *>(data);
+  }
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) munmap(const_cast<char *>(data_), size_);
+}
+
+CSVReader::CSVReader(const std::string &file_name, const char delimiter, const char quote, const char escape)
+    : file_(std::make_unique<MappedFile>(file_name)),
+      pos_(file_->Begin()),
+      end_(file_->End()),
+      delimiter_(delimiter),
+      quote_(quote),
+      escape_(escape) {}
+
+CSVReader::CSVReader(const char *begin, const char *end, const char delimiter, const char quote, const char escape)
+    : pos_(begin), end_(end), delimiter_(delimiter), quote_(quote), escape_(escape) {}
+
+bool CSVReader::SplitBatch() {
+  fields_.clear();
+  row_starts_.clear();
+  unescaped_.clear();
+  num_rows_ = 0;
+  curr_row_ = 0;
+
+  while (num_rows_ < K_BATCH_SIZE && pos_ < end_) {
+    row_starts_.push_back(static_cast<uint32_t>(fields_.size()));
+    while (!SplitField()) {
+    }
+    num_rows_++;
+  }
+  row_starts_.push_back(static_cast<uint32_t>(fields_.size()));
+  return num_rows_ > 0;
+}
+
+bool CSVReader::SplitField() {
+  Field field{pos_, 0, false, false};
+  if (pos_ < end_ && *pos_ == quote_) {
+    // Quoted field: read until the closing quote, skipping over escaped characters.
+    field.quoted_ = true;
+    field.ptr_ = ++pos_;
+    while (pos_ < end_) {
+      if (*pos_ == escape_ && pos_ + 1 < end_ && (pos_[1] == quote_ || pos_[1] == escape_)) {
+        // With the default escape (the quote itself), this is a doubled quote.
+        field.escaped_ = true;
+        pos_ += 2;
+      } else if (*pos_ == quote_) {
+        break;
+      } else {
+        pos_++;
+      }
+    }
+    field.len_ = static_cast<uint32_t>(pos_ - field.ptr_);
+    // Skip the closing quote and anything up to the next delimiter.
+    while (pos_ < end_ && *pos_ != delimiter_ && *pos_ != '\n') pos_++;
+  } else {
+    // Unquoted field: this is the hot loop.
+    const char delimiter = delimiter_;
+    const char *pos = pos_;
+    while (pos < end_ && *pos != delimiter && *pos != '\n') pos++;
+    pos_ = pos;
+    field.len_ = static_cast<uint32_t>(pos_ - field.ptr_);
+    // Tolerate CRLF line endings.
+    if (field.len_ > 0 && field.ptr_[field.len_ - 1] == '\r' && (pos_ == end_ || *pos_ == '\n')) field.len_--;
+  }
+  fields_.push_back(field);
+
+  // End of input or end of row
+  if (pos_ >= end_) return true;
+  return *pos_++ == '\n';
+}
+
+std::string_view CSVReader::Unescape(const Field &field) {
+  if (!field.escaped_) return std::string_view(field.ptr_, field.len_);
+  std::string &out = unescaped_.emplace_back();
+  out.reserve(field.len_);
+  for (uint32_t i = 0; i < field.len_; i++) {
+    if (field.ptr_[i] == escape_ && i + 1 < field.len_) i++;
+    out.push_back(field.ptr_[i]);
+  }
+  return out;
+}
+
+BoolVal CSVReader::GetBool(const uint32_t col_idx) {
+  const Field *field = GetField(col_idx);
+  if (field == nullptr) return BoolVal::Null();
+  std::string val(Unescape(*field));
+  std::transform(val.begin(), val.end(), val.begin(), ::tolower);
+  if (val == "t" || val == "true" || val == "1" || val == "y" || val == "yes" || val == "on") return BoolVal(true);
+  if (val == "f" || val == "false" || val == "0" || val == "n" || val == "no" || val == "off") return BoolVal(false);
+  throw CONVERSION_EXCEPTION(("Invalid boolean in CSV input: " + val).c_str());
+}
+
+Integer CSVReader::GetInteger(const uint32_t col_idx) {
+  const Field *field = GetField(col_idx);
+  if (field == nullptr) return Integer::Null();
+  const std::string_view val = Unescape(*field);
+  const char *ptr = val.data();
+  const char *end = ptr + val.size();
+  bool negative = false;
+  if (ptr < end && (*ptr == '-' || *ptr == '+')) negative = *ptr++ == '-';
+  if (ptr == end) throw CONVERSION_EXCEPTION(("Invalid integer in CSV input: " + std::string(val)).c_str());
+  int64_t result = 0;
+  for (; ptr < end; ptr++) {
+    const auto digit = static_cast<uint8_t>(*ptr - '0');
+    if (digit > 9) throw CONVERSION_EXCEPTION(("Invalid integer in CSV input: " + std::string(val)).c_str());
+    if (__builtin_mul_overflow(result, 10, &result) || __builtin_add_overflow(result, digit, &result)) {
+      throw CONVERSION_EXCEPTION(("Integer out of range in CSV input: " + std::string(val)).c_str());
+    }
+  }
+  return Integer(negative ? -result : result);
+}
+
+Real CSVReader::GetReal(const uint32_t col_idx) {
+  const Field *field = GetField(col_idx);
+  if (field == nullptr) return Real::Null();
+  // strtod() needs a null-terminated string
+  const std::string val(Unescape(*field));
+  char *end;
+  const double result = std::strtod(val.c_str(), &end);
+  if (end == val.c_str() || *end != '\0') {
+    throw CONVERSION_EXCEPTION(("Invalid real in CSV input: " + val).c_str());
+  }
+  return Real(result);
+}
+
+DateVal CSVReader::GetDate(const uint32_t col_idx) {
+  const Field *field = GetField(col_idx);
+  if (field == nullptr) return DateVal::Null();
+  return DateVal(Date::FromString(std::string(Unescape(*field))));
+}
+
+StringVal CSVReader::GetVarlen(const uint32_t col_idx) {
+  const Field *field = GetField(col_idx);
+  if (field == nullptr) return StringVal::Null();
+  const std::string_view val = Unescape(*field);
+  return StringVal(val.data(), static_cast<uint32_t>(val.size()));
+}
+
+void CSVReader::ParallelScan(const std::string &file_name, const char delimiter, const char quote, const char escape,
+                             void *const query_state, ThreadStateContainer *const thread_states,
+                             const ScanFn scan_fn) {
+  // Time
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  MappedFile file(file_name);
+  const std::vector<const char *> chunk_starts = SplitChunks(file, delimiter, quote, escape);
+
+  tbb::task_scheduler_init scheduler;
+  tbb::parallel_for(std::size_t(0), chunk_starts.size() - 1, [&](const std::size_t chunk_idx) {
+    CSVReader reader(chunk_starts[chunk_idx], chunk_starts[chunk_idx + 1], delimiter, quote, escape);
+    void *thread_state = thread_states->AccessThreadStateOfCurrentThread();
+    scan_fn(query_state, thread_state, &reader);
+  });
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Parallel scan of file {}: {} chunks, scan time = {:2f} ms", file_name,
+                      chunk_starts.size() - 1, timer.Elapsed());
+}
+
+std::vector<const char *> CSVReader::SplitChunks(const MappedFile &file, const char delimiter, const char quote,
+                                                 const char escape) {
+  std::vector<const char *> chunk_starts{file.Begin()};
+  if (std::memchr(file.Begin(), quote, file.Size()) == nullptr) {
+    // Without quotes, every newline ends a row. Every chunk but the first starts right after one.
+    for (std::size_t offset = K_CHUNK_SIZE; offset < file.Size(); offset += K_CHUNK_SIZE) {
+      const char *newline = std::find(file.Begin() + offset, file.End(), '\n');
+      if (newline == file.End()) break;
+      chunk_starts.push_back(newline + 1);
+      offset = static_cast<std::size_t>(newline + 1 - file.Begin());
+    }
+  } else {
+    // A quoted field may contain newlines, and whether a newline is quoted depends on everything before it. Walk the
+    // rows from the start of the file to find the boundaries.
+    const char *next_chunk = file.Begin() + K_CHUNK_SIZE;
+    for (const char *pos = file.Begin(); pos < file.End();) {
+      pos = SkipRow(pos, file.End(), delimiter, quote, escape);
+      if (pos >= next_chunk && pos < file.End()) {
+        chunk_starts.push_back(pos);
+        next_chunk = pos + K_CHUNK_SIZE;
+      }
+    }
+  }
+  chunk_starts.push_back(file.End());
+  return chunk_starts;
+}
+
+const char *CSVReader::SkipRow(const char *pos, const char *const end, const char delimiter, const char quote,
+                               const char escape) {
+  // This follows the field boundaries of SplitField().
+  while (pos < end) {
+    if (*pos == quote) {
+      for (pos++; pos < end; pos++) {
+        if (*pos == escape && pos + 1 < end && (pos[1] == quote || pos[1] == escape)) {
+          pos++;
+        } else if (*pos == quote) {
+          break;
+        }
+      }
+    }
+    while (pos < end && *pos != delimiter && *pos != '\n') pos++;
+    if (pos < end && *pos++ == '\n') break;
+  }
+  return pos;
+}
+
+}  // namespace terrier::execution::sql
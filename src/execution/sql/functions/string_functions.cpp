@@ -1,8 +1,10 @@
 #include "execution/sql/functions/string_functions.h"
 
 #include <algorithm>
+#include <string_view>
 
 #include "execution/exec/execution_context.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/util/bit_util.h"
 
 namespace terrier::execution::sql {
@@ -40,13 +42,8 @@ const char *SearchSubstring(const char *text, const std::size_t hay_len, const c
                             const std::size_t pattern_len) {
   TERRIER_ASSERT(pattern != nullptr, "No search string provided");
   TERRIER_ASSERT(pattern_len > 0, "No search string provided");
-  for (uint32_t i = 0; i < hay_len + pattern_len; i++) {
-    const auto pos = text + i;
-    if (strncmp(pos, pattern, pattern_len) == 0) {
-      return pos;
-    }
-  }
-  return nullptr;
+  const auto pos = LikePattern::Find<false>(std::string_view(text, hay_len), std::string_view(pattern, pattern_len));
+  return pos == std::string_view::npos ? nullptr : text + pos;
 }
 
 }  // namespace
@@ -201,6 +198,26 @@ void StringFunctions::Length(UNUSED_ATTRIBUTE exec::ExecutionContext *ctx, Integ
   result->val_ = str.len_;
 }
 
+void StringFunctions::Like(UNUSED_ATTRIBUTE exec::ExecutionContext *ctx, BoolVal *result, const StringVal &str,
+                           const StringVal &pattern) {
+  if (str.is_null_ || pattern.is_null_) {
+    *result = BoolVal::Null();
+    return;
+  }
+  const LikePattern like(pattern.StringView());
+  *result = BoolVal(like.Matches(str.StringView()));
+}
+
+void StringFunctions::ILike(UNUSED_ATTRIBUTE exec::ExecutionContext *ctx, BoolVal *result, const StringVal &str,
+                            const StringVal &pattern) {
+  if (str.is_null_ || pattern.is_null_) {
+    *result = BoolVal::Null();
+    return;
+  }
+  const LikePattern like(pattern.StringView(), true);
+  *result = BoolVal(like.Matches(str.StringView()));
+}
+
 void StringFunctions::Lower(exec::ExecutionContext *ctx, StringVal *result, const StringVal &str) {
   if (str.is_null_) {
     *result = StringVal::Null();
@@ -18,10 +18,14 @@
 namespace terrier::execution::sql {
 
 JoinHashTable::JoinHashTable(MemoryPool *memory, uint32_t tuple_size, bool use_concise_ht)
-    : entries_(sizeof(HashTableEntry) + tuple_size, MemoryPoolAllocator<byte>(memory)),
+    : memory_(memory),
+      entries_(sizeof(HashTableEntry) + tuple_size, MemoryPoolAllocator<byte>(memory)),
       owned_(memory),
       concise_hash_table_(0),
       hll_estimator_(libcount::HLL::Create(K_DEFAULT_HLL_PRECISION)),
+      bloom_filter_built_(false),
+      min_filter_key_(std::numeric_limits<int64_t>::max()),
+      max_filter_key_(std::numeric_limits<int64_t>::min()),
       built_(false),
       use_concise_ht_(use_concise_ht) {}
 
@@ -61,8 +65,10 @@ void JoinHashTable::BuildGenericHashTableInternal() noexcept {
 }
 
 void JoinHashTable::BuildGenericHashTable() noexcept {
-  // Setup based on number of buffered build-size tuples
-  generic_hash_table_.SetSize(NumElements());
+  // Setup based on the estimated number of unique keys, since all duplicates
+  // of a key share a bucket chain anyway
+  const uint64_t num_unique = std::min<uint64_t>(hll_estimator_->Estimate(), NumElements());
+  generic_hash_table_.SetSize(std::max<uint64_t>(num_unique, 1));
 
   // Dispatch to appropriate build code based on GHT size
   uint64_t l3_cache_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE);
@@ -586,6 +592,10 @@ void JoinHashTable::Build() {
     BuildGenericHashTable();
   }
 
+  if (HasFilterKeys()) {
+    BuildBloomFilter();
+  }
+
   timer.Stop();
   UNUSED_ATTRIBUTE double tps = (static_cast<double>(NumElements()) / timer.Elapsed()) / 1000.0;
   EXECUTION_LOG_DEBUG("JHT: built {} tuples in {} ms ({:.2f} tps)", NumElements(), timer.Elapsed(), tps);
@@ -593,6 +603,31 @@ void JoinHashTable::Build() {
   built_ = true;
 }
 
+void JoinHashTable::BuildBloomFilter() {
+  // Entries are either our own, or were taken over from thread-local tables
+  uint64_t num_entries = entries_.size();
+  for (const auto &owned_entries : owned_) {
+    num_entries += owned_entries.size();
+  }
+
+  // Duplicate keys share a hash, so size the filter for the unique keys only
+  const uint64_t num_unique =
+      std::min<uint64_t>({hll_estimator_->Estimate(), num_entries, std::numeric_limits<uint32_t>::max()});
+  bloom_filter_.Init(memory_, static_cast<uint32_t>(std::max<uint64_t>(num_unique, 1)));
+
+  const auto add_all = [this](const util::ChunkedVector<MemoryPoolAllocator<byte>> &entries) {
+    for (uint64_t idx = 0; idx < entries.size(); idx++) {
+      bloom_filter_.Add(reinterpret_cast<const HashTableEntry *>(entries[idx])->hash_);
+    }
+  };
+  add_all(entries_);
+  for (const auto &owned_entries : owned_) {
+    add_all(owned_entries);
+  }
+
+  bloom_filter_built_ = true;
+}
+
 template <bool Prefetch>
 void JoinHashTable::LookupBatchInGenericHashTableInternal(uint32_t num_tuples, const hash_t hashes[],
                                                           const HashTableEntry *results[]) const {
@@ -691,9 +726,12 @@ void JoinHashTable::MergeParallel(const ThreadStateContainer *thread_state_conta
   std::vector<JoinHashTable *> tl_join_tables;
   thread_state_container->CollectThreadLocalStateElementsAs(&tl_join_tables, jht_offset);
 
-  // Combine HLL counts to get a global estimate
+  // Combine HLL counts to get a global estimate, and the runtime filter key
+  // ranges to get the global range
   for (auto *jht : tl_join_tables) {
     hll_estimator_->Merge(jht->hll_estimator_.get());
+    min_filter_key_ = std::min(min_filter_key_, jht->min_filter_key_);
+    max_filter_key_ = std::max(max_filter_key_, jht->max_filter_key_);
   }
 
   uint64_t num_elem_estimate = hll_estimator_->Estimate();
@@ -720,6 +758,14 @@ void JoinHashTable::MergeParallel(const ThreadStateContainer *thread_state_conta
       MergeIncomplete<false, true>(source);
     }
   });
+
+  // Adding to the Bloom filter is not thread-safe, so it is built afterwards
+  if (HasFilterKeys()) {
+    BuildBloomFilter();
+  }
+
+  // The table can now be probed
+  built_ = true;
 }
 
 }  // namespace terrier::execution::sql
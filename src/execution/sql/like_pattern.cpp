@@ -0,0 +1,190 @@
+#include "execution/sql/like_pattern.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "common/macros.h"
+
+namespace terrier::execution::sql {
+
+namespace {
+
+constexpr char K_ANY_SEQUENCE = '%';
+constexpr char K_ANY_CHAR = '_';
+
+// Lower case an ASCII letter, leaving all other bytes alone
+template <bool CaseInsensitive>
+ALWAYS_INLINE inline char Fold(const char c) {
+  if constexpr (CaseInsensitive) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+  }
+  return c;
+}
+
+template <bool CaseInsensitive>
+ALWAYS_INLINE inline bool Equals(const char *a, const char *b, const std::size_t len) {
+  if constexpr (CaseInsensitive) {
+    for (std::size_t i = 0; i < len; i++) {
+      if (Fold<true>(a[i]) != Fold<true>(b[i])) return false;
+    }
+    return true;
+  }
+  return std::memcmp(a, b, len) == 0;
+}
+
+#if defined(__AVX2__)
+template <bool CaseInsensitive>
+ALWAYS_INLINE inline __m256i FoldVector(const __m256i vec) {
+  if constexpr (CaseInsensitive) {
+    // Bytes above 0x7F are negative, and never in the range
+    const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(vec, _mm256_set1_epi8('A' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), vec));
+    return _mm256_or_si256(vec, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+  }
+  return vec;
+}
+#endif
+
+}  // namespace
+
+LikePattern::LikePattern(const std::string_view pattern, const bool case_insensitive, const char escape)
+    : pattern_(pattern), kind_(Kind::General), case_insensitive_(case_insensitive), escape_(escape) {
+  if (pattern.find(escape) != std::string_view::npos || pattern.find(K_ANY_CHAR) != std::string_view::npos) {
+    return;
+  }
+
+  const std::size_t start = pattern.find_first_not_of(K_ANY_SEQUENCE);
+  if (start == std::string_view::npos) {
+    // Either empty, which only matches the empty string, or only '%', which matches everything
+    kind_ = pattern.empty() ? Kind::Exact : Kind::Contains;
+    return;
+  }
+  const std::size_t end = pattern.find_last_not_of(K_ANY_SEQUENCE) + 1;
+  literal_ = pattern.substr(start, end - start);
+  if (literal_.find(K_ANY_SEQUENCE) != std::string_view::npos) {
+    literal_ = std::string_view();
+    return;
+  }
+
+  const bool leading = start > 0, trailing = end < pattern.size();
+  if (leading && trailing) {
+    kind_ = Kind::Contains;
+  } else if (leading) {
+    kind_ = Kind::Suffix;
+  } else if (trailing) {
+    kind_ = Kind::Prefix;
+  } else {
+    kind_ = Kind::Exact;
+  }
+}
+
+bool LikePattern::Matches(const std::string_view str) const {
+  return case_insensitive_ ? MatchesImpl<true>(str) : MatchesImpl<false>(str);
+}
+
+template <bool CaseInsensitive>
+bool LikePattern::MatchesImpl(const std::string_view str) const {
+  const std::size_t len = literal_.size();
+  switch (kind_) {
+    case Kind::Exact:
+      return str.size() == len && Equals<CaseInsensitive>(str.data(), literal_.data(), len);
+    case Kind::Prefix:
+      return str.size() >= len && Equals<CaseInsensitive>(str.data(), literal_.data(), len);
+    case Kind::Suffix:
+      return str.size() >= len && Equals<CaseInsensitive>(str.data() + str.size() - len, literal_.data(), len);
+    case Kind::Contains:
+      return Find<CaseInsensitive>(str, literal_) != std::string_view::npos;
+    default:
+      return MatchesGeneral<CaseInsensitive>(str);
+  }
+}
+
+template <bool CaseInsensitive>
+bool LikePattern::MatchesGeneral(const std::string_view str) const {
+  // Match greedily, and on a mismatch, retry from the most recent '%' with it absorbing one more character. Only the
+  // most recent '%' needs to be retried, so this never backtracks further than that.
+  std::size_t p = 0, s = 0;
+  std::size_t retry_p = std::string_view::npos, retry_s = 0;
+  while (s < str.size()) {
+    if (p < pattern_.size()) {
+      const char c = pattern_[p];
+      if (c == K_ANY_SEQUENCE) {
+        retry_p = ++p;
+        retry_s = s;
+        continue;
+      }
+      if (c == K_ANY_CHAR) {
+        p++;
+        s++;
+        continue;
+      }
+      // An escape at the very end of the pattern matches itself
+      const bool escaped = c == escape_ && p + 1 < pattern_.size();
+      const char literal = escaped ? pattern_[p + 1] : c;
+      if (Fold<CaseInsensitive>(literal) == Fold<CaseInsensitive>(str[s])) {
+        p += escaped ? 2 : 1;
+        s++;
+        continue;
+      }
+    }
+    if (retry_p == std::string_view::npos) return false;
+    p = retry_p;
+    s = ++retry_s;
+  }
+
+  // The string is exhausted, so only trailing '%' may remain
+  while (p < pattern_.size() && pattern_[p] == K_ANY_SEQUENCE) p++;
+  return p == pattern_.size();
+}
+
+template <bool CaseInsensitive>
+std::size_t LikePattern::Find(const std::string_view haystack, const std::string_view needle) {
+  const std::size_t n = haystack.size(), m = needle.size();
+  if (m == 0) return 0;
+  if (m > n) return std::string_view::npos;
+  if constexpr (!CaseInsensitive) {
+    if (m == 1) {
+      const void *pos = std::memchr(haystack.data(), needle[0], n);
+      return pos == nullptr ? std::string_view::npos : static_cast<const char *>(pos) - haystack.data();
+    }
+  }
+
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  // Compare the first and last bytes of the needle against 32 candidate positions at a time, and only compare the
+  // rest of the needle at positions where both match
+  const __m256i first = _mm256_set1_epi8(Fold<CaseInsensitive>(needle[0]));
+  const __m256i last = _mm256_set1_epi8(Fold<CaseInsensitive>(needle[m - 1]));
+  for (; i + m - 1 + sizeof(__m256i) <= n; i += sizeof(__m256i)) {
+    const auto *block = haystack.data() + i;
+    const __m256i block_first =
+        FoldVector<CaseInsensitive>(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)));
+    const __m256i block_last =
+        FoldVector<CaseInsensitive>(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + m - 1)));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+    while (mask != 0) {
+      const auto offset = static_cast<uint32_t>(__builtin_ctz(mask));
+      if (m <= 2 || Equals<CaseInsensitive>(block + offset + 1, needle.data() + 1, m - 2)) return i + offset;
+      mask &= mask - 1;
+    }
+  }
+#endif
+
+  const char head = Fold<CaseInsensitive>(needle[0]);
+  for (; i + m <= n; i++) {
+    if (Fold<CaseInsensitive>(haystack[i]) == head &&
+        Equals<CaseInsensitive>(haystack.data() + i + 1, needle.data() + 1, m - 1)) {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+template std::size_t LikePattern::Find<true>(std::string_view haystack, std::string_view needle);
+template std::size_t LikePattern::Find<false>(std::string_view haystack, std::string_view needle);
+
+}  // namespace terrier::execution::sql
@@ -1,6 +1,10 @@
 #include "execution/sql/projected_columns_iterator.h"
+#include <algorithm>
+#include "execution/sql/join_hash_table.h"
 #include "execution/util/vector_util.h"
+#include "storage/arrow_block_metadata.h"
 #include "storage/projected_columns.h"
+#include "type/transient_value_peeker.h"
 #include "type/type_id.h"
 
 namespace terrier::execution::sql {
@@ -17,6 +21,7 @@ ProjectedColumnsIterator::ProjectedColumnsIterator(storage::ProjectedColumns *pr
 void ProjectedColumnsIterator::SetProjectedColumn(storage::ProjectedColumns *projected_column) {
   projected_column_ = projected_column;
   num_selected_ = projected_column_->NumTuples();
+  frozen_columns_ = nullptr;
   curr_idx_ = 0;
   selection_vector_[0] = K_INVALID_POS;
   selection_vector_read_idx_ = 0;
@@ -50,6 +55,15 @@ uint32_t ProjectedColumnsIterator::FilterColByColImpl(const uint32_t col_idx_1,
 // Filter an entire column's data by the provided constant value
 template <typename T, template <typename> typename Op>
 uint32_t ProjectedColumnsIterator::FilterColByValImpl(uint32_t col_idx, T val) {
+  // The values in NULL slots are arbitrary, and NULL never satisfies a comparison
+  SelectNotNull(col_idx);
+  if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    const auto encoding = frozen_columns_ == nullptr ? storage::ArrowColumnType::FIXED_LENGTH
+                                                     : frozen_columns_[col_idx]->Type();
+    if (encoding == storage::ArrowColumnType::RUN_LENGTH_ENCODED || encoding == storage::ArrowColumnType::BIT_PACKED)
+      return FilterEncodedColByValImpl<T, Op>(col_idx, val);
+  }
+
   // Get the input column's data
   const auto *input = reinterpret_cast<const T *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx)));
 
@@ -71,10 +85,232 @@ uint32_t ProjectedColumnsIterator::FilterColByValImpl(uint32_t col_idx, T val) {
   return NumSelected();
 }
 
+// Filter an entire varlen column's data by the provided constant value
+template <template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterColByVarlenImpl(uint32_t col_idx, const storage::VarlenEntry &val) {
+  // The entries in NULL slots are not valid, so they cannot be compared
+  SelectNotNull(col_idx);
+  if (frozen_columns_ != nullptr && frozen_columns_[col_idx]->Type() == storage::ArrowColumnType::DICTIONARY_COMPRESSED)
+    return FilterDictionaryColByVarlenImpl<Op>(col_idx, val);
+
+  // Get the input column's data
+  const auto *input =
+      reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx)));
+
+  // Use the existing selection vector if this PCI has been filtered
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // Filter!
+  selection_vector_write_idx_ =
+      util::VectorUtil::FilterVarlenByVal<Op>(input, num_selected_, val, selection_vector_, sel_vec);
+
+  // Make the filtered state visible, as in FilterColByValImpl()
+  ResetFiltered();
+
+  return NumSelected();
+}
+
+template <typename T, template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterEncodedColByValImpl(const uint32_t col_idx, const T val) {
+  // The offset of a tuple in the block locates its encoded value
+  const storage::EncodedIntegerColumn &encoded = frozen_columns_[col_idx]->EncodedColumn();
+  const storage::TupleSlot *slots = projected_column_->TupleSlots();
+
+  // Use the existing selection vector if this PCI has been filtered
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // Filter!
+  selection_vector_write_idx_ = 0;
+  if (frozen_columns_[col_idx]->Type() == storage::ArrowColumnType::RUN_LENGTH_ENCODED) {
+    // Tuples are in block order, so the runs are walked once, evaluating the predicate once per run
+    const uint32_t *run_ends = encoded.RunEnds();
+    uint32_t run = 0, run_end = 0;
+    bool matched = false;
+    for (uint32_t i = 0; i < num_selected_; i++) {
+      const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+      const uint32_t offset = slots[idx].GetOffset();
+      if (offset >= run_end) {
+        run = static_cast<uint32_t>(std::upper_bound(run_ends + run, run_ends + encoded.NumRuns(), offset) - run_ends);
+        run_end = run_ends[run];
+        matched = Op<T>{}(static_cast<T>(encoded.RunValues()[run]), val);
+      }
+      selection_vector_[selection_vector_write_idx_] = idx;
+      selection_vector_write_idx_ += matched ? 1 : 0;
+    }
+  } else {
+    for (uint32_t i = 0; i < num_selected_; i++) {
+      const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+      const bool matched = Op<T>{}(static_cast<T>(encoded.Unpack(slots[idx].GetOffset())), val);
+      selection_vector_[selection_vector_write_idx_] = idx;
+      selection_vector_write_idx_ += matched ? 1 : 0;
+    }
+  }
+
+  // Make the filtered state visible, as in FilterColByValImpl()
+  ResetFiltered();
+
+  return NumSelected();
+}
+
+template <template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterDictionaryColByVarlenImpl(const uint32_t col_idx,
+                                                                    const storage::VarlenEntry &val) {
+  const storage::ArrowColumnInfo &col_info = *frozen_columns_[col_idx];
+  const storage::ArrowVarlenColumn &dictionary = col_info.VarlenColumn();
+  const uint64_t *offsets = dictionary.Offsets();
+  const auto word = [&](uint64_t code) {
+    const auto size = static_cast<uint32_t>(offsets[code + 1] - offsets[code]);
+    const byte *content = dictionary.Values() + offsets[code];
+    return size <= storage::VarlenEntry::InlineThreshold() ? storage::VarlenEntry::CreateInline(content, size)
+                                                            : storage::VarlenEntry::Create(content, size, false);
+  };
+
+  // The dictionary is sorted and has distinct words, so comparing a code to the code of the value is the same as
+  // comparing the words. The value need not be in the dictionary: lo is the code of the first word no smaller than the
+  // value, and the range [lo, hi) holds the code of the value if it is in the dictionary.
+  const storage::VarlenContentCompare less;
+  const uint64_t num_words = dictionary.OffsetsLength() - 1;
+  uint64_t lo = 0, hi = num_words;
+  while (lo < hi) {
+    const uint64_t mid = lo + (hi - lo) / 2;
+    if (less(word(mid), val))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  hi = (lo < num_words && !less(val, word(lo))) ? lo + 1 : lo;
+
+  // NULLs were already removed from the selection. The offset of a tuple in the block locates its code.
+  const storage::TupleSlot *slots = projected_column_->TupleSlots();
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+  selection_vector_write_idx_ = 0;
+  for (uint32_t i = 0; i < num_selected_; i++) {
+    const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+    const uint64_t code = col_info.Indices()[slots[idx].GetOffset()];
+    const int32_t cmp = code < lo ? -1 : (code < hi ? 0 : 1);
+    selection_vector_[selection_vector_write_idx_] = idx;
+    selection_vector_write_idx_ += Op<int32_t>{}(cmp, 0) ? 1 : 0;
+  }
+
+  // Make the filtered state visible, as in FilterColByValImpl()
+  ResetFiltered();
+
+  return NumSelected();
+}
+
+void ProjectedColumnsIterator::SelectNotNull(const uint32_t col_idx) {
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(static_cast<uint16_t>(col_idx));
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // The null bitmap has a set bit for every value that is not NULL
+  uint32_t i = 0;
+  while (i < num_selected_ && null_bitmap->Test(sel_vec == nullptr ? i : sel_vec[i])) i++;
+  if (i == num_selected_) return;
+
+  // Only the tuples before the first NULL can be kept without checking them again
+  for (uint32_t j = 0; j < i; j++) selection_vector_[j] = (sel_vec == nullptr ? j : sel_vec[j]);
+  selection_vector_write_idx_ = i;
+  for (i++; i < num_selected_; i++) {
+    const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+    selection_vector_[selection_vector_write_idx_] = idx;
+    selection_vector_write_idx_ += null_bitmap->Test(idx) ? 1 : 0;
+  }
+  ResetFiltered();
+}
+
+uint32_t ProjectedColumnsIterator::FilterColByLike(const uint32_t col_idx, const LikePattern &pattern,
+                                                   const bool negate) {
+  // Get the input column's data
+  const auto *input =
+      reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx)));
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(static_cast<uint16_t>(col_idx));
+
+  // Use the existing selection vector if this PCI has been filtered
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // Filter! NULL neither matches nor fails to match a pattern, so it is never selected.
+  selection_vector_write_idx_ = 0;
+  for (uint32_t i = 0; i < num_selected_; i++) {
+    const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+    const bool matched = null_bitmap->Test(idx) && pattern.Matches(input[idx].StringView()) != negate;
+    selection_vector_[selection_vector_write_idx_] = idx;
+    selection_vector_write_idx_ += matched ? 1 : 0;
+  }
+
+  // Make the filtered state visible, as in FilterColByValImpl()
+  ResetFiltered();
+
+  return NumSelected();
+}
+
+uint32_t ProjectedColumnsIterator::FilterColByJoinKeys(const uint32_t col_idx, const type::TypeId type,
+                                                       const JoinHashTable &join_hash_table) {
+  switch (type) {
+    case type::TypeId::TINYINT: {
+      return FilterColByJoinKeysImpl<int8_t>(col_idx, join_hash_table);
+    }
+    case type::TypeId::SMALLINT: {
+      return FilterColByJoinKeysImpl<int16_t>(col_idx, join_hash_table);
+    }
+    case type::TypeId::INTEGER: {
+      return FilterColByJoinKeysImpl<int32_t>(col_idx, join_hash_table);
+    }
+    case type::TypeId::BIGINT: {
+      return FilterColByJoinKeysImpl<int64_t>(col_idx, join_hash_table);
+    }
+    default: {
+      throw std::runtime_error("Join filter not supported on type");
+    }
+  }
+}
+
+template <typename T>
+uint32_t ProjectedColumnsIterator::FilterColByJoinKeysImpl(const uint32_t col_idx,
+                                                           const JoinHashTable &join_hash_table) {
+  // Get the input column's data
+  const auto *input = reinterpret_cast<const T *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx)));
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(static_cast<uint16_t>(col_idx));
+  const uint32_t num_probed = num_selected_;
+
+  // Use the existing selection vector if this PCI has been filtered
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // First check the range of keys, which is cheap and often enough on its own
+  const int64_t min_key = join_hash_table.GetMinFilterKey(), max_key = join_hash_table.GetMaxFilterKey();
+  selection_vector_write_idx_ = 0;
+  for (uint32_t i = 0; i < num_selected_; i++) {
+    const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+    const auto key = static_cast<int64_t>(input[idx]);
+    selection_vector_[selection_vector_write_idx_] = idx;
+    selection_vector_write_idx_ += (null_bitmap->Test(idx) && key >= min_key && key <= max_key) ? 1 : 0;
+  }
+
+  // Then probe the Bloom filter with the remaining keys
+  if (const BloomFilter *bloom_filter = join_hash_table.GetBloomFilter(); bloom_filter != nullptr) {
+    const uint32_t num_in_range = selection_vector_write_idx_;
+    selection_vector_write_idx_ = 0;
+    for (uint32_t i = 0; i < num_in_range; i++) {
+      const uint32_t idx = selection_vector_[i];
+      const hash_t hash = JoinHashTable::HashFilterKey(static_cast<int64_t>(input[idx]));
+      selection_vector_[selection_vector_write_idx_] = idx;
+      selection_vector_write_idx_ += bloom_filter->Contains(hash) ? 1 : 0;
+    }
+  }
+
+  // Make the filtered state visible, as in FilterColByValImpl()
+  ResetFiltered();
+  num_join_filtered_ += num_probed - NumSelected();
+
+  return NumSelected();
+}
+
 // Filter an entire column's data by the provided constant value
 template <template <typename> typename Op>
 uint32_t ProjectedColumnsIterator::FilterColByVal(uint32_t col_idx, type::TypeId type, FilterVal val) {
   switch (type) {
+    case type::TypeId::TINYINT: {
+      return FilterColByValImpl<int8_t, Op>(col_idx, val.ti_);
+    }
     case type::TypeId::SMALLINT: {
       return FilterColByValImpl<int16_t, Op>(col_idx, val.si_);
     }
@@ -84,6 +320,19 @@ uint32_t ProjectedColumnsIterator::FilterColByVal(uint32_t col_idx, type::TypeId
     case type::TypeId::BIGINT: {
       return FilterColByValImpl<int64_t, Op>(col_idx, val.bi_);
     }
+    case type::TypeId::DATE: {
+      return FilterColByValImpl<uint32_t, Op>(col_idx, val.date_);
+    }
+    case type::TypeId::TIMESTAMP: {
+      return FilterColByValImpl<uint64_t, Op>(col_idx, val.ts_);
+    }
+    case type::TypeId::DECIMAL: {
+      return FilterColByValImpl<double, Op>(col_idx, val.dec_);
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      return FilterColByVarlenImpl<Op>(col_idx, *val.str_);
+    }
     default: {
       throw std::runtime_error("Filter not supported on type");
     }
@@ -105,12 +354,106 @@ uint32_t ProjectedColumnsIterator::FilterColByCol(const uint32_t col_idx_1, type
     case type::TypeId::BIGINT: {
       return FilterColByColImpl<int64_t, Op>(col_idx_1, col_idx_2);
     }
+    case type::TypeId::DATE: {
+      return FilterColByColImpl<uint32_t, Op>(col_idx_1, col_idx_2);
+    }
+    case type::TypeId::TIMESTAMP: {
+      return FilterColByColImpl<uint64_t, Op>(col_idx_1, col_idx_2);
+    }
+    case type::TypeId::DECIMAL: {
+      return FilterColByColImpl<double, Op>(col_idx_1, col_idx_2);
+    }
     default: {
       throw std::runtime_error("Filter not supported on type");
     }
   }
 }
 
+uint32_t ProjectedColumnsIterator::FilterColByParam(const uint32_t col_idx, const type::TypeId type,
+                                                    const parser::ExpressionType comparison,
+                                                    const type::TransientValue &param) {
+  // NULL never satisfies a comparison
+  if (param.Null()) {
+    selection_vector_write_idx_ = 0;
+    ResetFiltered();
+    return NumSelected();
+  }
+
+  // Skipping the filter selects every tuple, which callers still iterate through the selection vector
+  const auto skip = [this]() {
+    if (!IsFiltered()) {
+      for (uint32_t i = 0; i < num_selected_; i++) selection_vector_[i] = i;
+      selection_vector_write_idx_ = num_selected_;
+      ResetFiltered();
+    }
+    return NumSelected();
+  };
+
+  FilterVal val{};
+  storage::VarlenEntry str{};
+  if (type == type::TypeId::VARCHAR) {
+    if (param.Type() != type::TypeId::VARCHAR) return skip();
+    const std::string_view view = type::TransientValuePeeker::PeekVarChar(param);
+    const auto *content = reinterpret_cast<const byte *>(view.data());
+    const auto size = static_cast<uint32_t>(view.size());
+    str = size <= storage::VarlenEntry::InlineThreshold() ? storage::VarlenEntry::CreateInline(content, size)
+                                                          : storage::VarlenEntry::Create(content, size, false);
+    val.str_ = &str;
+  } else {
+    int64_t int_val;
+    switch (param.Type()) {
+      case type::TypeId::TINYINT:
+        int_val = type::TransientValuePeeker::PeekTinyInt(param);
+        break;
+      case type::TypeId::SMALLINT:
+        int_val = type::TransientValuePeeker::PeekSmallInt(param);
+        break;
+      case type::TypeId::INTEGER:
+        int_val = type::TransientValuePeeker::PeekInteger(param);
+        break;
+      case type::TypeId::BIGINT:
+        int_val = type::TransientValuePeeker::PeekBigInt(param);
+        break;
+      default:
+        return skip();
+    }
+    // The value is compared in the column's type, so it must fit in it
+    switch (type) {
+      case type::TypeId::TINYINT:
+        if (int_val != static_cast<int8_t>(int_val)) return skip();
+        break;
+      case type::TypeId::SMALLINT:
+        if (int_val != static_cast<int16_t>(int_val)) return skip();
+        break;
+      case type::TypeId::INTEGER:
+        if (int_val != static_cast<int32_t>(int_val)) return skip();
+        break;
+      case type::TypeId::BIGINT:
+        break;
+      default:
+        return skip();
+    }
+    val = MakeFilterVal(int_val, type);
+  }
+
+  switch (comparison) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      return FilterColByVal<std::equal_to>(col_idx, type, val);
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      return FilterColByVal<std::not_equal_to>(col_idx, type, val);
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      return FilterColByVal<std::less>(col_idx, type, val);
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      return FilterColByVal<std::less_equal>(col_idx, type, val);
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      return FilterColByVal<std::greater>(col_idx, type, val);
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      return FilterColByVal<std::greater_equal>(col_idx, type, val);
+    default:
+      return skip();
+  }
+}
+
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::equal_to>(uint32_t, type::TypeId, FilterVal);
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::greater>(uint32_t, type::TypeId, FilterVal);
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::greater_equal>(uint32_t, type::TypeId, FilterVal);
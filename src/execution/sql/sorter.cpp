@@ -7,6 +7,8 @@
 #include <utility>
 #include <vector>
 
+#include "common/exception.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
 #include "ips4o/ips4o.hpp"
@@ -16,21 +18,61 @@
 namespace terrier::execution::sql {
 
 Sorter::Sorter(MemoryPool *memory, ComparisonFunction cmp_fn, uint32_t tuple_size)
-    : tuple_storage_(tuple_size, MemoryPoolAllocator<byte>(memory)),
+    : memory_(memory),
+      tuple_size_(tuple_size),
+      tuple_storage_(tuple_size, MemoryPoolAllocator<byte>(memory)),
       owned_tuples_(memory),
       cmp_fn_(cmp_fn),
       tuples_(memory),
-      sorted_(false) {}
+      sorted_(false),
+      num_spilled_tuples_(0) {}
 
 Sorter::~Sorter() = default;
 
 byte *Sorter::AllocInputTuple() {
+  // Move the buffered tuples to disk if the query is over budget
+  if (UNLIKELY(tuples_.size() % K_SPILL_CHECK_INTERVAL == 0) && !tuples_.empty() && IsOverMemoryLimit()) {
+    SpillRun();
+  }
   byte *ret = tuple_storage_.Append();
   tuples_.push_back(ret);
   return ret;
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) {
+  // The heap has to stay in memory, so this never spills
+  byte *ret = tuple_storage_.Append();
+  tuples_.push_back(ret);
+  return ret;
+}
+
+bool Sorter::IsOverMemoryLimit() const {
+  const auto tracker = memory_->GetTracker();
+  return tracker != nullptr && tracker->IsOverLimit();
+}
+
+void Sorter::SpillRun() {
+  TERRIER_ASSERT(owned_tuples_.empty(), "Spilling tuples owned by other sorters");
+  if (spill_file_ == nullptr) {
+    spill_file_ = std::make_unique<SpillFile>();
+  }
+
+  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+
+  SpilledRun run{spill_file_.get(), spill_file_->Size(), tuples_.size()};
+  for (const byte *tuple : tuples_) {
+    spill_file_->Append(tuple, tuple_size_);
+  }
+  spill_file_->Flush();
+  spilled_runs_.push_back(run);
+  num_spilled_tuples_ += run.num_tuples_;
+
+  EXECUTION_LOG_DEBUG("Spilled a run of {} tuples", run.num_tuples_);
+
+  tuples_.clear();
+  tuple_storage_.clear();
+}
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done
@@ -97,12 +139,28 @@ void Sorter::HeapSiftDown() {
   tuples_[idx] = top;
 }
 
+uint64_t Sorter::NumTuplesForRandomAccess() const {
+  if (HasSpilled()) {
+    throw EXECUTION_EXCEPTION("Random access to a sorter that spilled to disk is not supported");
+  }
+  return tuples_.size();
+}
+
 void Sorter::Sort() {
   // Exit if the input tuples have already been sorted
   if (IsSorted()) {
     return;
   }
 
+  // Write the remaining tuples out as the last run. Iterating merges the runs.
+  if (HasSpilled()) {
+    if (!tuples_.empty()) {
+      SpillRun();
+    }
+    sorted_ = true;
+    return;
+  }
+
   // Exit if there are no input tuples
   if (tuples_.empty()) {
     return;
@@ -112,9 +170,11 @@ void Sorter::Sort() {
   util::Timer<std::milli> timer;
   timer.Start();
 
-  // Sort the sucker
+  // Sort the sucker, unless it arrived in order, e.g., from an ordered index scan
   const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
-  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  if (!std::is_sorted(tuples_.begin(), tuples_.end(), compare)) {
+    ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  }
 
   timer.Stop();
 
@@ -157,6 +217,39 @@ void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, co
     return;
   }
 
+  // If any thread-local sorter spilled, spill all of them, and take over
+  // their runs. Iterating merges the runs.
+  if (std::any_of(tl_sorters.begin(), tl_sorters.end(), [](const Sorter *sorter) { return sorter->HasSpilled(); })) {
+    tbb::task_scheduler_init sched;
+    tbb::parallel_for_each(tl_sorters.begin(), tl_sorters.end(), [](Sorter *const sorter) {
+      if (!sorter->tuples_.empty()) sorter->SpillRun();
+    });
+    if (!tuples_.empty()) {
+      SpillRun();
+    }
+    for (auto *tl_sorter : tl_sorters) {
+      spilled_runs_.insert(spilled_runs_.end(), tl_sorter->spilled_runs_.begin(), tl_sorter->spilled_runs_.end());
+      num_spilled_tuples_ += tl_sorter->num_spilled_tuples_;
+      owned_spill_files_.emplace_back(std::move(tl_sorter->spill_file_));
+      tl_sorter->spilled_runs_.clear();
+      tl_sorter->num_spilled_tuples_ = 0;
+    }
+    sorted_ = true;
+    return;
+  }
+
+  // A single sorter has no splitters to compute merge work from, and needs no
+  // merging anyway. Sort it and take over its tuples.
+  if (tl_sorters.size() == 1) {
+    Sorter *const tl_sorter = tl_sorters[0];
+    tl_sorter->Sort();
+    tuples_ = std::move(tl_sorter->tuples_);
+    owned_tuples_.emplace_back(std::move(tl_sorter->tuple_storage_));
+    tl_sorter->tuples_.clear();
+    sorted_ = true;
+    return;
+  }
+
   // -------------------------------------------------------
   // 1. Make room in this sorter for all result tuples
   // -------------------------------------------------------
@@ -273,6 +366,7 @@ void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, co
       // Bump new write position
       write_pos += part_size;
     }
+
   }
 
   timer.ExitStage();
@@ -333,9 +427,64 @@ void Sorter::SortTopKParallel(const ThreadStateContainer *thread_state_container
                               const uint64_t top_k) {
   // Parallel sort
   SortParallel(thread_state_container, sorter_offset);
+  TERRIER_ASSERT(!HasSpilled(), "Top-K sorts never spill");
+
+  // Trim to top-K. There may be fewer tuples than that.
+  if (tuples_.size() > top_k) tuples_.resize(top_k);
+}
 
-  // Trim to top-K
-  tuples_.resize(top_k);
+SpilledRunMerger::SpilledRunMerger(const Sorter &sorter)
+    : memory_(sorter.memory_),
+      cmp_fn_(sorter.cmp_fn_),
+      tuple_size_(sorter.tuple_size_),
+      block_size_(std::max<std::size_t>(K_READ_BLOCK_SIZE / sorter.tuple_size_, 1) * sorter.tuple_size_) {
+  TERRIER_ASSERT(sorter.IsSorted(), "Merging the runs of an unsorted sorter");
+  readers_.reserve(sorter.spilled_runs_.size());
+  for (const auto &run : sorter.spilled_runs_) {
+    readers_.push_back({run, 0, memory_->AllocateArray<byte>(block_size_, false), nullptr, nullptr});
+  }
+
+  // Read the first block of each run
+  const auto compare = [this](const RunReader *left, const RunReader *right) { return HeapCompare(left, right); };
+  for (auto &reader : readers_) {
+    if (ReadBlock(&reader)) {
+      heap_.push_back(&reader);
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(), compare);
+}
+
+SpilledRunMerger::~SpilledRunMerger() {
+  for (auto &reader : readers_) {
+    memory_->DeallocateArray(reader.block_, block_size_);
+  }
+}
+
+bool SpilledRunMerger::ReadBlock(RunReader *reader) {
+  const uint64_t num_left = reader->run_.num_tuples_ - reader->num_read_;
+  if (num_left == 0) {
+    return false;
+  }
+  const uint64_t num_tuples = std::min<uint64_t>(num_left, block_size_ / tuple_size_);
+  reader->run_.file_->Read(reader->run_.offset_ + reader->num_read_ * tuple_size_, reader->block_,
+                           num_tuples * tuple_size_);
+  reader->num_read_ += num_tuples;
+  reader->pos_ = reader->block_;
+  reader->end_ = reader->block_ + num_tuples * tuple_size_;
+  return true;
+}
+
+void SpilledRunMerger::Next() {
+  TERRIER_ASSERT(HasNext(), "Advancing past the end of the runs");
+  const auto compare = [this](const RunReader *left, const RunReader *right) { return HeapCompare(left, right); };
+  std::pop_heap(heap_.begin(), heap_.end(), compare);
+  RunReader *reader = heap_.back();
+  reader->pos_ += tuple_size_;
+  if (reader->pos_ == reader->end_ && !ReadBlock(reader)) {
+    heap_.pop_back();
+  } else {
+    std::push_heap(heap_.begin(), heap_.end(), compare);
+  }
 }
 
 }  // namespace terrier::execution::sql
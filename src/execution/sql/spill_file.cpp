@@ -0,0 +1,71 @@
+#include "execution/sql/spill_file.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "common/exception.h"
+
+namespace terrier::execution::sql {
+
+SpillFile::SpillFile() : buffer_(std::make_unique<byte[]>(K_WRITE_BUFFER_SIZE)) {
+  const char *dir = std::getenv("TMPDIR");
+  std::string path = std::string(dir != nullptr && dir[0] != '\0' ? dir : "/tmp") + "/terrier_spill_XXXXXX";
+  fd_ = mkstemp(path.data());
+  if (fd_ < 0) {
+    throw EXECUTION_EXCEPTION(("Could not create spill file " + path + ": " + std::strerror(errno)).c_str());
+  }
+  // Nothing else ever opens the file, so it can be removed right away
+  unlink(path.c_str());
+}
+
+SpillFile::~SpillFile() { close(fd_); }
+
+void SpillFile::Append(const void *data, std::size_t size) {
+  const auto *bytes = static_cast<const byte *>(data);
+  size_ += size;
+  while (buffer_size_ + size > K_WRITE_BUFFER_SIZE) {
+    const std::size_t chunk = K_WRITE_BUFFER_SIZE - buffer_size_;
+    std::memcpy(buffer_.get() + buffer_size_, bytes, chunk);
+    buffer_size_ = K_WRITE_BUFFER_SIZE;
+    Flush();
+    bytes += chunk;
+    size -= chunk;
+  }
+  std::memcpy(buffer_.get() + buffer_size_, bytes, size);
+  buffer_size_ += size;
+}
+
+void SpillFile::Flush() {
+  std::size_t written = 0;
+  while (written < buffer_size_) {
+    const ssize_t ret = write(fd_, buffer_.get() + written, buffer_size_ - written);
+    if (ret < 0) {
+      if (errno == EINTR) continue;
+      throw EXECUTION_EXCEPTION((std::string("Could not write spill file: ") + std::strerror(errno)).c_str());
+    }
+    written += static_cast<std::size_t>(ret);
+  }
+  buffer_size_ = 0;
+}
+
+void SpillFile::Read(const uint64_t offset, void *buffer, const std::size_t size) const {
+  TERRIER_ASSERT(offset + size + buffer_size_ <= size_, "Reading bytes that have not been flushed");
+  auto *bytes = static_cast<byte *>(buffer);
+  std::size_t read = 0;
+  while (read < size) {
+    const ssize_t ret = pread(fd_, bytes + read, size - read, static_cast<off_t>(offset + read));
+    if (ret <= 0) {
+      if (ret < 0 && errno == EINTR) continue;
+      throw EXECUTION_EXCEPTION(
+          (std::string("Could not read spill file: ") + (ret == 0 ? "unexpected end of file" : std::strerror(errno)))
+              .c_str());
+    }
+    read += static_cast<std::size_t>(ret);
+  }
+}
+
+}  // namespace terrier::execution::sql
@@ -4,11 +4,19 @@
 #include <tbb/parallel_for.h>
 #include <tbb/task_scheduler_init.h>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/exec/execution_context.h"
+#include "execution/sql/thread_state_container.h"
 #include "execution/util/timer.h"
+#include "loggers/execution_logger.h"
+#include "type/transient_value_peeker.h"
 
 namespace terrier::execution::sql {
 TableVectorIterator::TableVectorIterator(exec::ExecutionContext *exec_ctx, uint32_t table_oid, uint32_t *col_oids,
@@ -16,10 +24,14 @@ TableVectorIterator::TableVectorIterator(exec::ExecutionContext *exec_ctx, uint3
     : exec_ctx_(exec_ctx), table_oid_(table_oid), col_oids_(col_oids, col_oids + num_oids) {}
 
 TableVectorIterator::~TableVectorIterator() {
+  ReleaseFrozenBlock();
+  exec_ctx_->AddJoinFilteredTuples(pci_.NumJoinFiltered());
   exec_ctx_->GetMemoryPool()->Deallocate(buffer_, projected_columns_->Size());
 }
 
-bool TableVectorIterator::Init() {
+bool TableVectorIterator::Init() { return InitRange(0, std::numeric_limits<uint32_t>::max()); }
+
+bool TableVectorIterator::InitRange(uint32_t start_block_idx, uint32_t end_block_idx) {
   // Find the table
   table_ = exec_ctx_->GetAccessor()->GetTable(table_oid_);
   TERRIER_ASSERT(table_ != nullptr, "Table must exist!!");
@@ -32,32 +44,233 @@ bool TableVectorIterator::Init() {
   initialized_ = true;
 
   // Begin iterating
-  iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->begin());
+  start_block_idx_ = start_block_idx;
+  iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->GetBlockIterator(start_block_idx_));
+  if (end_block_idx != std::numeric_limits<uint32_t>::max()) {
+    end_iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->GetBlockIterator(end_block_idx));
+  }
   return true;
 }
 
+void TableVectorIterator::RestrictRange(const uint32_t col_idx, const type::TypeId type, const int64_t min,
+                                        const int64_t max) {
+  bool is_unsigned;
+  switch (type) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      is_unsigned = false;
+      break;
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+      is_unsigned = true;
+      break;
+    default:
+      return;
+  }
+  for (auto &range : column_ranges_) {
+    if (range.col_idx_ != col_idx) continue;
+    range.min_ = std::max(range.min_, min);
+    range.max_ = std::min(range.max_, max);
+    return;
+  }
+  column_ranges_.push_back({col_idx, is_unsigned, min, max});
+}
+
+void TableVectorIterator::RestrictRangeToParam(const uint32_t col_idx, const type::TypeId type,
+                                               const parser::ExpressionType comparison, const uint32_t param_idx) {
+  int64_t value, min, max;
+  if (!ValueAsInteger(type, exec_ctx_->GetParam(param_idx), &value)) return;
+  if (!ComparisonRange(comparison, value, &min, &max)) return;
+  RestrictRange(col_idx, type, min, max);
+}
+
+bool TableVectorIterator::ValueAsInteger(const type::TypeId col_type, const type::TransientValue &value,
+                                         int64_t *result) {
+  if (value.Null()) return false;
+  const auto is_integer = [](type::TypeId type) {
+    return type >= type::TypeId::TINYINT && type <= type::TypeId::BIGINT;
+  };
+  if (is_integer(col_type) && is_integer(value.Type())) {
+    switch (value.Type()) {
+      case type::TypeId::TINYINT:
+        *result = type::TransientValuePeeker::PeekTinyInt(value);
+        return true;
+      case type::TypeId::SMALLINT:
+        *result = type::TransientValuePeeker::PeekSmallInt(value);
+        return true;
+      case type::TypeId::INTEGER:
+        *result = type::TransientValuePeeker::PeekInteger(value);
+        return true;
+      default:
+        *result = type::TransientValuePeeker::PeekBigInt(value);
+        return true;
+    }
+  }
+  if (col_type == type::TypeId::DATE && value.Type() == type::TypeId::DATE) {
+    *result = !type::TransientValuePeeker::PeekDate(value);
+    return true;
+  }
+  if (col_type == type::TypeId::TIMESTAMP && value.Type() == type::TypeId::TIMESTAMP) {
+    const uint64_t timestamp = !type::TransientValuePeeker::PeekTimestamp(value);
+    if (timestamp > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) return false;
+    *result = static_cast<int64_t>(timestamp);
+    return true;
+  }
+  return false;
+}
+
+bool TableVectorIterator::ComparisonRange(const parser::ExpressionType comparison, const int64_t value, int64_t *min,
+                                          int64_t *max) {
+  *min = std::numeric_limits<int64_t>::min();
+  *max = std::numeric_limits<int64_t>::max();
+  switch (comparison) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      *min = *max = value;
+      return true;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      if (value == std::numeric_limits<int64_t>::min()) return false;
+      *max = value - 1;
+      return true;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      *max = value;
+      return true;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      if (value == std::numeric_limits<int64_t>::max()) return false;
+      *min = value + 1;
+      return true;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      *min = value;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool TableVectorIterator::AtEnd() const {
+  return *iter_ == table_->end() || (end_iter_ != nullptr && *iter_ == *end_iter_);
+}
+
+bool TableVectorIterator::CanSkipBlock(storage::RawBlock *const block) const {
+  for (const auto &range : column_ranges_) {
+    if (range.min_ > range.max_) return true;
+    const auto col_id = projected_columns_->ColumnIds()[range.col_idx_];
+    const storage::ColumnZoneMap &zone_map = table_->GetZoneMap(block, col_id);
+    // NULLs never fall in a range, so a column with only NULLs has no tuple to look for
+    if (zone_map.Empty()) return true;
+    if (range.is_unsigned_ && zone_map.Min() < 0) continue;
+    if (zone_map.Max() < range.min_ || zone_map.Min() > range.max_) return true;
+  }
+  return false;
+}
+
 bool TableVectorIterator::Advance() {
   if (!initialized_) return false;
+  ReleaseFrozenBlock();
+  // Skip whole blocks that the zone maps rule out, before reading anything from them.
+  while (!column_ranges_.empty() && !AtEnd() && (*iter_)->GetOffset() == 0 && CanSkipBlock((*iter_)->GetBlock())) {
+    table_->SkipBlock(iter_.get());
+    exec_ctx_->AddSkippedBlocks(1);
+  }
   // First check if the iterator ended.
-  if (*iter_ == table_->end()) {
-    return false;
+  if (AtEnd()) return false;
+  // Read frozen blocks in place, as long as no one starts updating them
+  storage::RawBlock *block = (*iter_)->GetBlock();
+  if (exec_ctx_->AreInPlaceReadsEnabled() && block->controller_.TryAcquireInPlaceRead()) {
+    frozen_block_ = block;
+    table_->ScanInPlace(iter_.get(), projected_columns_);
+    pci_.SetProjectedColumn(projected_columns_);
+    frozen_columns_.clear();
+    for (uint16_t i = 0; i < projected_columns_->NumColumns(); i++)
+      frozen_columns_.push_back(&table_->GetArrowColumnInfo(block, projected_columns_->ColumnIds()[i]));
+    pci_.SetFrozenColumns(frozen_columns_.data());
+    return true;
   }
   // Scan the table to set the projected column.
-  table_->Scan(exec_ctx_->GetTxn(), iter_.get(), projected_columns_);
+  if (end_iter_ != nullptr) {
+    table_->RangeScan(exec_ctx_->GetTxn(), iter_.get(), *end_iter_, projected_columns_);
+  } else {
+    table_->Scan(exec_ctx_->GetTxn(), iter_.get(), projected_columns_);
+  }
   pci_.SetProjectedColumn(projected_columns_);
   return true;
 }
 
 void TableVectorIterator::Reset() {
   if (!initialized_) return;
-  iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->begin());
+  ReleaseFrozenBlock();
+  iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->GetBlockIterator(start_block_idx_));
+}
+
+void TableVectorIterator::ReleaseFrozenBlock() {
+  if (frozen_block_ == nullptr) return;
+  frozen_block_->controller_.ReleaseInPlaceRead();
+  frozen_block_ = nullptr;
 }
 
-bool TableVectorIterator::ParallelScan(uint32_t db_oid, uint32_t table_oid, void *const query_state,
+bool TableVectorIterator::ParallelScan(exec::ExecutionContext *const exec_ctx, const uint32_t table_oid,
+                                       uint32_t *const col_oids, const uint32_t num_oids, void *const query_state,
                                        ThreadStateContainer *const thread_states, const ScanFn scan_fn,
                                        const uint32_t min_grain_size) {
-  // TODO(Amadou): Implement Me!!
-  return false;
+  // Find the table
+  const auto table = exec_ctx->GetAccessor()->GetTable(catalog::table_oid_t(table_oid));
+  if (table == nullptr) return false;
+
+  // Time
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  // Each task scans a contiguous range of blocks (a morsel) with its own iterator and thread-local state.
+  const auto scan_morsel = [&](uint32_t start_block_idx, uint32_t end_block_idx) {
+    TableVectorIterator iter(exec_ctx, table_oid, col_oids, num_oids);
+    iter.InitRange(start_block_idx, end_block_idx);
+    void *thread_state = thread_states->AccessThreadStateOfCurrentThread();
+    scan_fn(query_state, thread_state, &iter);
+  };
+
+  // Cut the blocks into morsels of blocks on the same NUMA node
+  const std::vector<uint16_t> numa_nodes = table->GetBlockNumaNodes();
+  const auto num_blocks = static_cast<uint32_t>(numa_nodes.size());
+  const uint32_t grain_size = std::max(min_grain_size, 1u);
+  std::map<uint16_t, std::vector<std::pair<uint32_t, uint32_t>>> node_morsels;
+  for (uint32_t start = 0, end; start < num_blocks; start = end) {
+    for (end = start + 1; end < num_blocks && end - start < grain_size && numa_nodes[end] == numa_nodes[start];) end++;
+    node_morsels[numa_nodes[start]].emplace_back(start, end);
+  }
+
+  tbb::task_scheduler_init scheduler;
+  if (node_morsels.size() <= 1 || node_morsels.count(storage::BlockAllocator::UNKNOWN_NUMA_NODE) != 0) {
+    tbb::parallel_for(tbb::blocked_range<uint32_t>(0, num_blocks, grain_size),
+                      [&](const tbb::blocked_range<uint32_t> &block_range) {
+                        scan_morsel(block_range.begin(), block_range.end());
+                      });
+  } else {
+    // Every task claims the morsels on its own node first, and then helps with the other nodes
+    std::vector<std::pair<uint16_t, const std::vector<std::pair<uint32_t, uint32_t>> *>> queues;
+    for (const auto &[node, morsels] : node_morsels) queues.emplace_back(node, &morsels);
+    std::vector<std::atomic<uint32_t>> next_morsels(queues.size());
+    for (auto &next_morsel : next_morsels) next_morsel = 0;
+    const auto num_tasks = static_cast<uint32_t>(tbb::task_scheduler_init::default_num_threads());
+    tbb::parallel_for(uint32_t{0}, num_tasks, [&](uint32_t) {
+      const uint16_t local_node = storage::BlockAllocator::CurrentNumaNode();
+      const auto local = std::find_if(queues.begin(), queues.end(),
+                                      [=](const auto &queue) { return queue.first == local_node; });
+      const auto first = static_cast<uint32_t>(local == queues.end() ? 0 : local - queues.begin());
+      for (uint32_t i = 0; i < queues.size(); i++) {
+        const uint32_t queue_idx = (first + i) % queues.size();
+        const auto &morsels = *queues[queue_idx].second;
+        for (uint32_t morsel; (morsel = next_morsels[queue_idx]++) < morsels.size();)
+          scan_morsel(morsels[morsel].first, morsels[morsel].second);
+      }
+    });
+  }
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Parallel scan of table {}: {} blocks, scan time = {:2f} ms", table_oid, num_blocks,
+                      timer.Elapsed());
+
+  return true;
 }
 
 }  // namespace terrier::execution::sql
@@ -0,0 +1,131 @@
+#include "execution/sql/window_operator.h"
+
+#include <tbb/tbb.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "common/exception.h"
+#include "execution/sql/thread_state_container.h"
+
+namespace terrier::execution::sql {
+
+WindowOperator::WindowOperator(const Sorter &sorter, const Sorter::ComparisonFunction partition_cmp_fn,
+                               const Sorter::ComparisonFunction peer_cmp_fn)
+    : rows_(sorter.tuples_.data()),
+      num_rows_(sorter.tuples_.size()),
+      peer_cmp_fn_(peer_cmp_fn),
+      partition_begins_(sorter.memory_) {
+  if (sorter.HasSpilled()) {
+    throw EXECUTION_EXCEPTION("Window functions over a sorter that spilled to disk are not supported");
+  }
+  TERRIER_ASSERT(sorter.IsSorted() || num_rows_ == 0, "The input of a window must be sorted");
+
+  // A partition starts wherever the partitioning keys of two neighbouring rows differ
+  if (num_rows_ > 0) {
+    partition_begins_.push_back(0);
+  }
+  if (partition_cmp_fn != nullptr) {
+    for (uint64_t i = 1; i < num_rows_; i++) {
+      if (partition_cmp_fn(rows_[i - 1], rows_[i]) != 0) {
+        partition_begins_.push_back(i);
+      }
+    }
+  }
+  partition_begins_.push_back(num_rows_);
+}
+
+void WindowOperator::ExecuteParallelScan(void *const query_state, ThreadStateContainer *const thread_states,
+                                         const WindowOperator::ScanPartitionFn scan_fn) const {
+  tbb::parallel_for(tbb::blocked_range<uint64_t>(0, NumPartitions()), [&](const tbb::blocked_range<uint64_t> &range) {
+    WindowIterator iter(*this, range.begin(), range.end());
+    scan_fn(query_state, thread_states->AccessThreadStateOfCurrentThread(), &iter);
+  });
+}
+
+WindowIterator::WindowIterator(const WindowOperator &window, const uint64_t begin_partition,
+                               const uint64_t end_partition)
+    : window_(window),
+      next_partition_(begin_partition),
+      pos_(window.partition_begins_[begin_partition]),
+      end_(window.partition_begins_[end_partition]),
+      partition_begin_(0),
+      partition_end_(0),
+      peer_begin_(0),
+      peer_end_(0),
+      dense_rank_(0) {
+  TERRIER_ASSERT(begin_partition <= end_partition && end_partition <= window.NumPartitions(),
+                 "Partition range out of bounds");
+  if (HasNext()) {
+    StartPartition();
+  }
+}
+
+void WindowIterator::Next() {
+  pos_++;
+  if (!HasNext()) {
+    return;
+  }
+  if (pos_ == partition_end_) {
+    StartPartition();
+  } else if (pos_ == peer_end_) {
+    StartPeerGroup();
+  }
+}
+
+void WindowIterator::StartPartition() {
+  TERRIER_ASSERT(pos_ == window_.partition_begins_[next_partition_], "Not at the start of a partition");
+  partition_begin_ = pos_;
+  partition_end_ = window_.partition_begins_[++next_partition_];
+  dense_rank_ = 0;
+  StartPeerGroup();
+}
+
+void WindowIterator::StartPeerGroup() {
+  peer_begin_ = pos_;
+  dense_rank_++;
+  if (window_.peer_cmp_fn_ == nullptr) {
+    peer_end_ = partition_end_;
+    return;
+  }
+  const byte *const *rows = window_.rows_;
+  for (peer_end_ = pos_ + 1; peer_end_ < partition_end_ && window_.peer_cmp_fn_(rows[pos_], rows[peer_end_]) == 0;) {
+    peer_end_++;
+  }
+}
+
+std::pair<uint64_t, uint64_t> WindowIterator::GetFrame(const WindowFrame &frame) const {
+  const uint64_t begin = FrameBound(frame, frame.start_, frame.start_offset_, false);
+  const uint64_t end = FrameBound(frame, frame.end_, frame.end_offset_, true);
+  // A frame that starts after it ends is empty
+  return {std::min(begin, end), end};
+}
+
+uint64_t WindowIterator::FrameBound(const WindowFrame &frame, const WindowFrame::Bound bound, const uint64_t offset,
+                                    const bool is_end) const {
+  const uint64_t current = GetPartitionOffset();
+  const uint64_t size = GetPartitionSize();
+  // An end bound is the position after the row it names
+  const uint64_t past = is_end ? 1 : 0;
+  switch (bound) {
+    case WindowFrame::Bound::UnboundedPreceding:
+      return 0;
+    case WindowFrame::Bound::UnboundedFollowing:
+      return size;
+    case WindowFrame::Bound::CurrentRow:
+      if (frame.mode_ == WindowFrame::Mode::Range) {
+        return (is_end ? peer_end_ : peer_begin_) - partition_begin_;
+      }
+      return current + past;
+    case WindowFrame::Bound::Preceding:
+      TERRIER_ASSERT(frame.mode_ == WindowFrame::Mode::Rows, "RANGE frames with offsets are not supported");
+      return offset > current ? 0 : current - offset + past;
+    case WindowFrame::Bound::Following:
+      TERRIER_ASSERT(frame.mode_ == WindowFrame::Mode::Rows, "RANGE frames with offsets are not supported");
+      return offset >= size - current ? size : current + offset + past;
+    default:
+      UNREACHABLE("Impossible frame bound");
+  }
+}
+
+}  // namespace terrier::execution::sql
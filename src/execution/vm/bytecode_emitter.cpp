@@ -260,13 +260,39 @@ void BytecodeEmitter::EmitTableIterInit(Bytecode bytecode, LocalVar iter, LocalV
   EmitAll(bytecode, iter, exec_ctx, table_oid, col_oids, num_oids);
 }
 
+void BytecodeEmitter::EmitTableIterRestrictRange(LocalVar iter, uint32_t col_idx, int8_t col_type, int64_t min,
+                                                 int64_t max) {
+  EmitAll(Bytecode::TableVectorIteratorRestrictRange, iter, col_idx, col_type, min, max);
+}
+
+void BytecodeEmitter::EmitTableIterRestrictRangeToParam(LocalVar iter, uint32_t col_idx, int8_t col_type,
+                                                        int8_t comparison, uint32_t param_idx) {
+  EmitAll(Bytecode::TableVectorIteratorRestrictRangeToParam, iter, col_idx, col_type, comparison, param_idx);
+}
+
 void BytecodeEmitter::EmitAddCol(Bytecode bytecode, LocalVar iter, uint32_t col_oid) {
   EmitAll(bytecode, iter, col_oid);
 }
 
-void BytecodeEmitter::EmitParallelTableScan(uint32_t db_oid, uint32_t table_oid, LocalVar ctx, LocalVar thread_states,
+void BytecodeEmitter::EmitParallelTableScan(uint32_t table_oid, LocalVar col_oids, uint32_t num_oids,
+                                            LocalVar query_state, LocalVar exec_ctx, LocalVar thread_states,
                                             FunctionId scan_fn) {
-  EmitAll(Bytecode::ParallelScanTable, db_oid, table_oid, ctx, thread_states, scan_fn);
+  EmitAll(Bytecode::ParallelScanTable, table_oid, col_oids, num_oids, query_state, exec_ctx, thread_states, scan_fn);
+}
+
+void BytecodeEmitter::EmitCSVReaderInit(LocalVar reader, uintptr_t file_name, uint64_t length, int8_t delimiter,
+                                        int8_t quote, int8_t escape) {
+  EmitAll(Bytecode::CSVReaderInit, reader, file_name, length, delimiter, quote, escape);
+}
+
+void BytecodeEmitter::EmitCSVReaderGet(Bytecode bytecode, LocalVar out, LocalVar reader, uint32_t col_idx) {
+  EmitAll(bytecode, out, reader, col_idx);
+}
+
+void BytecodeEmitter::EmitParallelCSVScan(uintptr_t file_name, uint64_t length, int8_t delimiter, int8_t quote,
+                                          int8_t escape, LocalVar query_state, LocalVar thread_states,
+                                          FunctionId scan_fn) {
+  EmitAll(Bytecode::ParallelScanCSV, file_name, length, delimiter, quote, escape, query_state, thread_states, scan_fn);
 }
 
 void BytecodeEmitter::EmitPCIGet(Bytecode bytecode, LocalVar out, LocalVar pci, uint16_t col_idx) {
@@ -278,6 +304,21 @@ void BytecodeEmitter::EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected,
   EmitAll(bytecode, selected, pci, col_idx, type, val);
 }
 
+void BytecodeEmitter::EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx,
+                                          LocalVar val) {
+  EmitAll(bytecode, selected, pci, col_idx, val);
+}
+
+void BytecodeEmitter::EmitPCIJoinFilter(LocalVar selected, LocalVar pci, uint32_t col_idx, int8_t type,
+                                        LocalVar join_hash_table) {
+  EmitAll(Bytecode::PCIFilterJoin, selected, pci, col_idx, type, join_hash_table);
+}
+
+void BytecodeEmitter::EmitPCIParamFilter(LocalVar selected, LocalVar pci, uint32_t col_idx, int8_t type,
+                                         int8_t comparison, LocalVar exec_ctx, uint32_t param_idx) {
+  EmitAll(Bytecode::PCIFilterParam, selected, pci, col_idx, type, comparison, exec_ctx, param_idx);
+}
+
 void BytecodeEmitter::EmitFilterManagerInsertFlavor(LocalVar fmb, FunctionId func) {
   EmitAll(Bytecode::FilterManagerInsertFlavor, fmb, func);
 }
@@ -303,6 +344,10 @@ void BytecodeEmitter::EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, L
   EmitAll(Bytecode::AggregationHashTableParallelPartitionedScan, agg_ht, context, tls, scan_part_fn);
 }
 
+void BytecodeEmitter::EmitAggHashTableBuildPartitions(LocalVar agg_ht, LocalVar context, FunctionId merge_part_fn) {
+  EmitAll(Bytecode::AggregationHashTableBuildPartitions, agg_ht, context, merge_part_fn);
+}
+
 void BytecodeEmitter::EmitJoinHashTableIterHasNext(LocalVar has_more, LocalVar iterator, FunctionId key_eq,
                                                    LocalVar opaque_ctx, LocalVar probe_tuple) {
   EmitAll(Bytecode::JoinHashTableIterHasNext, has_more, iterator, key_eq, opaque_ctx, probe_tuple);
@@ -313,6 +358,16 @@ void BytecodeEmitter::EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVa
   EmitAll(bytecode, sorter, region, cmp_fn, tuple_size);
 }
 
+void BytecodeEmitter::EmitWindowInit(LocalVar window, LocalVar sorter, FunctionId partition_cmp_fn,
+                                     FunctionId peer_cmp_fn) {
+  EmitAll(Bytecode::WindowInit, window, sorter, partition_cmp_fn, peer_cmp_fn);
+}
+
+void BytecodeEmitter::EmitWindowFrameInit(LocalVar frame, int8_t mode, int8_t start, uint32_t start_offset, int8_t end,
+                                          uint32_t end_offset) {
+  EmitAll(Bytecode::WindowFrameInit, frame, mode, start, start_offset, end, end_offset);
+}
+
 void BytecodeEmitter::EmitOutputAlloc(Bytecode bytecode, LocalVar exec_ctx, LocalVar dest) {
   EmitAll(bytecode, exec_ctx, dest);
 }
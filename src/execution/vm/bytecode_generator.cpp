@@ -9,9 +9,11 @@
 #include "execution/ast/context.h"
 #include "execution/ast/type.h"
 #include "execution/exec/execution_context.h"
+#include "execution/sql/join_hash_table.h"
 #include "execution/vm/bytecode_label.h"
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/control_flow_builders.h"
+#include "execution/vm/superinstructions.h"
 #include "loggers/execution_logger.h"
 
 namespace terrier::execution::vm {
@@ -604,6 +606,24 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
       Emitter()->Emit(Bytecode::TableVectorIteratorReset, iter);
       break;
     }
+    case ast::Builtin::TableIterRestrictRange: {
+      // The remaining arguments are the column index and type, and the bounds of the range
+      auto col_idx = static_cast<uint32_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+      auto col_type = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+      int64_t min = call->Arguments()[3]->As<ast::LitExpr>()->Int64Val();
+      int64_t max = call->Arguments()[4]->As<ast::LitExpr>()->Int64Val();
+      Emitter()->EmitTableIterRestrictRange(iter, col_idx, col_type, min, max);
+      break;
+    }
+    case ast::Builtin::TableIterRestrictRangeToParam: {
+      // The remaining arguments are the column index and type, the comparison, and the parameter index
+      auto col_idx = static_cast<uint32_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+      auto col_type = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+      auto comparison = static_cast<int8_t>(call->Arguments()[3]->As<ast::LitExpr>()->Int64Val());
+      auto param_idx = static_cast<uint32_t>(call->Arguments()[4]->As<ast::LitExpr>()->Int64Val());
+      Emitter()->EmitTableIterRestrictRangeToParam(iter, col_idx, col_type, comparison, param_idx);
+      break;
+    }
     case ast::Builtin::TableIterGetPCI: {
       ast::Type *pci_type = ast::BuiltinType::Get(ctx, ast::BuiltinType::ProjectedColumnsIterator);
       LocalVar pci = ExecutionResult()->GetOrCreateDestination(pci_type);
@@ -622,7 +642,110 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
 }
 
 void BytecodeGenerator::VisitBuiltinTableIterParallelCall(ast::CallExpr *call) {
-  UNREACHABLE("Parallel scan is not implemented yet!");
+  // The first argument is either the table oid or the table name
+  uint32_t table_oid;
+  if (call->Arguments()[0]->IsIntegerLiteral()) {
+    table_oid = static_cast<uint32_t>(call->Arguments()[0]->As<ast::LitExpr>()->Int64Val());
+  } else {
+    ast::Identifier table_name = call->Arguments()[0]->As<ast::LitExpr>()->RawStringVal();
+    auto ns_oid = exec_ctx_->GetAccessor()->GetDefaultNamespace();
+    auto oid = exec_ctx_->GetAccessor()->GetTableOid(ns_oid, table_name.Data());
+    TERRIER_ASSERT(oid != terrier::catalog::INVALID_TABLE_OID, "Table does not exists");
+    table_oid = !oid;
+  }
+  // The second argument is the array of oids
+  auto *arr_type = call->Arguments()[1]->GetType()->As<ast::ArrayType>();
+  LocalVar col_oids = VisitExpressionForLValue(call->Arguments()[1]);
+  // The third argument is the query state
+  LocalVar query_state = VisitExpressionForRValue(call->Arguments()[2]);
+  // The fourth argument is the execution context
+  LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[3]);
+  // The fifth argument is the thread state container
+  LocalVar thread_states = VisitExpressionForRValue(call->Arguments()[4]);
+  // The sixth argument is the scan function
+  FunctionId scan_fn = LookupFuncIdByName(call->Arguments()[5]->As<ast::IdentifierExpr>()->Name().Data());
+  // Emit the parallel scan
+  Emitter()->EmitParallelTableScan(table_oid, col_oids, static_cast<uint32_t>(arr_type->Length()), query_state,
+                                   exec_ctx, thread_states, scan_fn);
+}
+
+void BytecodeGenerator::VisitBuiltinCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin) {
+  ast::Context *ctx = call->GetType()->GetContext();
+
+  // The first argument to all calls is a pointer to the reader
+  LocalVar reader = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::CSVReaderInit: {
+      // The second argument is the file name. The rest are the delimiter, quote and escape characters.
+      ast::Identifier file_name = call->Arguments()[1]->As<ast::LitExpr>()->RawStringVal();
+      auto delimiter = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+      auto quote = static_cast<int8_t>(call->Arguments()[3]->As<ast::LitExpr>()->Int64Val());
+      auto escape = static_cast<int8_t>(call->Arguments()[4]->As<ast::LitExpr>()->Int64Val());
+      Emitter()->EmitCSVReaderInit(reader, reinterpret_cast<uintptr_t>(file_name.Data()), file_name.Length(),
+                                   delimiter, quote, escape);
+      break;
+    }
+    case ast::Builtin::CSVReaderAdvance: {
+      LocalVar cond = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      Emitter()->Emit(Bytecode::CSVReaderAdvance, cond, reader);
+      ExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
+    case ast::Builtin::CSVReaderGetBool:
+    case ast::Builtin::CSVReaderGetInt:
+    case ast::Builtin::CSVReaderGetReal:
+    case ast::Builtin::CSVReaderGetDate:
+    case ast::Builtin::CSVReaderGetString: {
+      Bytecode bytecode;
+      switch (builtin) {
+        case ast::Builtin::CSVReaderGetBool:
+          bytecode = Bytecode::CSVReaderGetBool;
+          break;
+        case ast::Builtin::CSVReaderGetInt:
+          bytecode = Bytecode::CSVReaderGetInteger;
+          break;
+        case ast::Builtin::CSVReaderGetReal:
+          bytecode = Bytecode::CSVReaderGetReal;
+          break;
+        case ast::Builtin::CSVReaderGetDate:
+          bytecode = Bytecode::CSVReaderGetDate;
+          break;
+        default:
+          bytecode = Bytecode::CSVReaderGetVarlen;
+          break;
+      }
+      auto col_idx = static_cast<uint32_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+      LocalVar val = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      Emitter()->EmitCSVReaderGet(bytecode, val, reader, col_idx);
+      ExecutionResult()->SetDestination(val.ValueOf());
+      break;
+    }
+    case ast::Builtin::CSVReaderClose: {
+      Emitter()->Emit(Bytecode::CSVReaderFree, reader);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible CSV reader call");
+    }
+  }
+}
+
+void BytecodeGenerator::VisitBuiltinCSVParallelCall(ast::CallExpr *call) {
+  // The first argument is the file name. The next three are the delimiter, quote and escape characters.
+  ast::Identifier file_name = call->Arguments()[0]->As<ast::LitExpr>()->RawStringVal();
+  auto delimiter = static_cast<int8_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+  auto quote = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+  auto escape = static_cast<int8_t>(call->Arguments()[3]->As<ast::LitExpr>()->Int64Val());
+  // The fifth argument is the query state
+  LocalVar query_state = VisitExpressionForRValue(call->Arguments()[4]);
+  // The sixth argument is the thread state container
+  LocalVar thread_states = VisitExpressionForRValue(call->Arguments()[5]);
+  // The seventh argument is the scan function
+  FunctionId scan_fn = LookupFuncIdByName(call->Arguments()[6]->As<ast::IdentifierExpr>()->Name().Data());
+  // Emit the parallel scan
+  Emitter()->EmitParallelCSVScan(reinterpret_cast<uintptr_t>(file_name.Data()), file_name.Length(), delimiter, quote,
+                                 escape, query_state, thread_states, scan_fn);
 }
 
 void BytecodeGenerator::VisitBuiltinPCICall(ast::CallExpr *call, ast::Builtin builtin) {
@@ -805,8 +928,8 @@ void BytecodeGenerator::VisitBuiltinHashCall(ast::CallExpr *call, UNUSED_ATTRIBU
   // hash_val is where we accumulate all the hash values passed to the @hash()
   LocalVar hash_val = ExecutionResult()->GetOrCreateDestination(call->GetType());
 
-  // Initialize it to 1
-  Emitter()->EmitAssignImm8(hash_val, 1);
+  // Initialize it. Join runtime filters rely on its value, see JoinHashTable::HashFilterKey().
+  Emitter()->EmitAssignImm8(hash_val, sql::JoinHashTable::K_INITIAL_TUPLE_HASH);
 
   // tmp is a temporary variable we use to store individual hash values. We
   // combine all values into hash_val above
@@ -890,6 +1013,44 @@ void BytecodeGenerator::VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin
   // Column index
   auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
   auto col_type = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+
+  // String filters take the address of the string to compare with
+  if (call->Arguments()[3]->GetType()->IsSpecificBuiltin(ast::BuiltinType::StringVal)) {
+    LocalVar str = VisitExpressionForLValue(call->Arguments()[3]);
+    Bytecode bytecode;
+    switch (builtin) {
+      case ast::Builtin::FilterEq: {
+        bytecode = Bytecode::PCIFilterEqualString;
+        break;
+      }
+      case ast::Builtin::FilterGt: {
+        bytecode = Bytecode::PCIFilterGreaterThanString;
+        break;
+      }
+      case ast::Builtin::FilterGe: {
+        bytecode = Bytecode::PCIFilterGreaterThanEqualString;
+        break;
+      }
+      case ast::Builtin::FilterLt: {
+        bytecode = Bytecode::PCIFilterLessThanString;
+        break;
+      }
+      case ast::Builtin::FilterLe: {
+        bytecode = Bytecode::PCIFilterLessThanEqualString;
+        break;
+      }
+      case ast::Builtin::FilterNe: {
+        bytecode = Bytecode::PCIFilterNotEqualString;
+        break;
+      }
+      default: {
+        UNREACHABLE("Impossible bytecode");
+      }
+    }
+    Emitter()->EmitPCIVectorFilter(bytecode, ret_val, pci, col_idx, str);
+    return;
+  }
+
   // Filter value
   int64_t val = call->Arguments()[3]->As<ast::LitExpr>()->Int64Val();
 
@@ -926,6 +1087,87 @@ void BytecodeGenerator::VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin
   Emitter()->EmitPCIVectorFilter(bytecode, ret_val, pci, col_idx, col_type, val);
 }
 
+void BytecodeGenerator::VisitBuiltinFilterLikeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  LocalVar ret_val;
+  if (ExecutionResult() != nullptr) {
+    ret_val = ExecutionResult()->GetOrCreateDestination(call->GetType());
+    ExecutionResult()->SetDestination(ret_val.ValueOf());
+  } else {
+    ret_val = CurrentFunction()->NewLocal(call->GetType());
+  }
+
+  LocalVar pci = VisitExpressionForRValue(call->Arguments()[0]);
+  auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+  LocalVar pattern = VisitExpressionForLValue(call->Arguments()[2]);
+
+  Bytecode bytecode;
+  switch (builtin) {
+    case ast::Builtin::FilterLike: {
+      bytecode = Bytecode::PCIFilterLike;
+      break;
+    }
+    case ast::Builtin::FilterNotLike: {
+      bytecode = Bytecode::PCIFilterNotLike;
+      break;
+    }
+    case ast::Builtin::FilterILike: {
+      bytecode = Bytecode::PCIFilterILike;
+      break;
+    }
+    case ast::Builtin::FilterNotILike: {
+      bytecode = Bytecode::PCIFilterNotILike;
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible bytecode");
+    }
+  }
+  Emitter()->EmitPCIVectorFilter(bytecode, ret_val, pci, col_idx, pattern);
+}
+
+void BytecodeGenerator::VisitBuiltinFilterJoinCall(ast::CallExpr *call) {
+  LocalVar ret_val;
+  if (ExecutionResult() != nullptr) {
+    ret_val = ExecutionResult()->GetOrCreateDestination(call->GetType());
+    ExecutionResult()->SetDestination(ret_val.ValueOf());
+  } else {
+    ret_val = CurrentFunction()->NewLocal(call->GetType());
+  }
+
+  LocalVar pci = VisitExpressionForRValue(call->Arguments()[0]);
+  auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+  auto col_type = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+  LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[3]);
+  Emitter()->EmitPCIJoinFilter(ret_val, pci, col_idx, col_type, join_hash_table);
+}
+
+void BytecodeGenerator::VisitBuiltinFilterParamCall(ast::CallExpr *call) {
+  LocalVar ret_val;
+  if (ExecutionResult() != nullptr) {
+    ret_val = ExecutionResult()->GetOrCreateDestination(call->GetType());
+    ExecutionResult()->SetDestination(ret_val.ValueOf());
+  } else {
+    ret_val = CurrentFunction()->NewLocal(call->GetType());
+  }
+
+  LocalVar pci = VisitExpressionForRValue(call->Arguments()[0]);
+  auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+  auto col_type = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+  auto comparison = static_cast<int8_t>(call->Arguments()[3]->As<ast::LitExpr>()->Int64Val());
+  LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[4]);
+  auto param_idx = static_cast<uint32_t>(call->Arguments()[5]->As<ast::LitExpr>()->Int64Val());
+  Emitter()->EmitPCIParamFilter(ret_val, pci, col_idx, col_type, comparison, exec_ctx, param_idx);
+}
+
+void BytecodeGenerator::VisitBuiltinLikeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  LocalVar dest = ExecutionResult()->GetOrCreateDestination(call->GetType());
+  LocalVar str = VisitExpressionForLValue(call->Arguments()[0]);
+  LocalVar pattern = VisitExpressionForLValue(call->Arguments()[1]);
+  const Bytecode bytecode = builtin == ast::Builtin::Like ? Bytecode::Like : Bytecode::ILike;
+  Emitter()->EmitBinaryOp(bytecode, dest, str, pattern);
+  ExecutionResult()->SetDestination(dest);
+}
+
 void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin) {
   switch (builtin) {
     case ast::Builtin::AggHashTableInit: {
@@ -942,6 +1184,13 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       Emitter()->Emit(Bytecode::AggregationHashTableInsert, dest, agg_ht, hash);
       break;
     }
+    case ast::Builtin::AggHashTableInsertPartitioned: {
+      LocalVar dest = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::AggregationHashTableInsertPartitioned, dest, agg_ht, hash);
+      break;
+    }
     case ast::Builtin::AggHashTableLookup: {
       LocalVar dest = ExecutionResult()->GetOrCreateDestination(call->GetType());
       LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
@@ -977,6 +1226,13 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       Emitter()->EmitAggHashTableParallelPartitionedScan(agg_ht, ctx, tls, scan_part_fn);
       break;
     }
+    case ast::Builtin::AggHashTableBuildPartitions: {
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar ctx = VisitExpressionForRValue(call->Arguments()[1]);
+      auto merge_part_fn = LookupFuncIdByName(call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().Data());
+      Emitter()->EmitAggHashTableBuildPartitions(agg_ht, ctx, merge_part_fn);
+      break;
+    }
     case ast::Builtin::AggHashTableFree: {
       LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
       Emitter()->Emit(Bytecode::AggregationHashTableFree, agg_ht);
@@ -1231,6 +1487,12 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
       Emitter()->Emit(Bytecode::JoinHashTableAllocTuple, dest, join_hash_table, hash);
       break;
     }
+    case ast::Builtin::JoinHashTableAddFilterKey: {
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar key = VisitExpressionForLValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::JoinHashTableAddFilterKey, join_hash_table, key);
+      break;
+    }
     case ast::Builtin::JoinHashTableBuild: {
       LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
       Emitter()->Emit(Bytecode::JoinHashTableBuild, join_hash_table);
@@ -1339,6 +1601,21 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
       Emitter()->Emit(Bytecode::SorterFree, sorter);
       break;
     }
+    case ast::Builtin::SorterGetTupleCount: {
+      LocalVar count = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::SorterGetTupleCount, count, sorter);
+      ExecutionResult()->SetDestination(count.ValueOf());
+      break;
+    }
+    case ast::Builtin::SorterGetTupleAt: {
+      LocalVar row_ptr = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar idx = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::SorterGetTupleAt, row_ptr, sorter, idx);
+      ExecutionResult()->SetDestination(row_ptr.ValueOf());
+      break;
+    }
     default: {
       UNREACHABLE("Impossible bytecode");
     }
@@ -1384,6 +1661,184 @@ void BytecodeGenerator::VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Bui
   }
 }
 
+void BytecodeGenerator::VisitBuiltinWindowCall(ast::CallExpr *call, ast::Builtin builtin) {
+  // The first argument to all calls is the window or the frame instance
+  const LocalVar window = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::WindowInit: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[1]);
+      const std::string partition_cmp_func_name = call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().Data();
+      const std::string peer_cmp_func_name = call->Arguments()[3]->As<ast::IdentifierExpr>()->Name().Data();
+      Emitter()->EmitWindowInit(window, sorter, LookupFuncIdByName(partition_cmp_func_name),
+                                LookupFuncIdByName(peer_cmp_func_name));
+      break;
+    }
+    case ast::Builtin::WindowFree: {
+      Emitter()->Emit(Bytecode::WindowFree, window);
+      break;
+    }
+    case ast::Builtin::WindowFrameInit: {
+      // The remaining arguments are the mode, the start bound and its offset, and the end bound and its offset
+      auto mode = static_cast<int8_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+      auto start = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+      auto start_offset = static_cast<uint32_t>(call->Arguments()[3]->As<ast::LitExpr>()->Int64Val());
+      auto end = static_cast<int8_t>(call->Arguments()[4]->As<ast::LitExpr>()->Int64Val());
+      auto end_offset = static_cast<uint32_t>(call->Arguments()[5]->As<ast::LitExpr>()->Int64Val());
+      Emitter()->EmitWindowFrameInit(window, mode, start, start_offset, end, end_offset);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible window call");
+    }
+  }
+}
+
+void BytecodeGenerator::VisitBuiltinWindowIterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  ast::Context *ctx = call->GetType()->GetContext();
+
+  // The first argument to all calls is the window iterator instance
+  const LocalVar window_iter = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::WindowIterInit: {
+      LocalVar window = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::WindowIteratorInit, window_iter, window);
+      break;
+    }
+    case ast::Builtin::WindowIterHasNext: {
+      LocalVar cond = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      Emitter()->Emit(Bytecode::WindowIteratorHasNext, cond, window_iter);
+      ExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
+    case ast::Builtin::WindowIterNext: {
+      Emitter()->Emit(Bytecode::WindowIteratorNext, window_iter);
+      break;
+    }
+    case ast::Builtin::WindowIterGetRow: {
+      LocalVar row_ptr =
+          ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Uint8)->PointerTo());
+      Emitter()->Emit(Bytecode::WindowIteratorGetRow, row_ptr, window_iter);
+      ExecutionResult()->SetDestination(row_ptr.ValueOf());
+      break;
+    }
+    case ast::Builtin::WindowIterIsPartitionStart: {
+      LocalVar cond = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      Emitter()->Emit(Bytecode::WindowIteratorIsPartitionStart, cond, window_iter);
+      ExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
+    case ast::Builtin::WindowIterGetRowNumber:
+    case ast::Builtin::WindowIterGetRank:
+    case ast::Builtin::WindowIterGetDenseRank: {
+      const Bytecode bytecode = builtin == ast::Builtin::WindowIterGetRowNumber
+                                    ? Bytecode::WindowIteratorGetRowNumber
+                                    : builtin == ast::Builtin::WindowIterGetRank ? Bytecode::WindowIteratorGetRank
+                                                                                 : Bytecode::WindowIteratorGetDenseRank;
+      LocalVar result = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      Emitter()->Emit(bytecode, result, window_iter);
+      ExecutionResult()->SetDestination(result.ValueOf());
+      break;
+    }
+    case ast::Builtin::WindowIterGetFrameBegin:
+    case ast::Builtin::WindowIterGetFrameEnd: {
+      const Bytecode bytecode = builtin == ast::Builtin::WindowIterGetFrameBegin ? Bytecode::WindowIteratorGetFrameBegin
+                                                                                 : Bytecode::WindowIteratorGetFrameEnd;
+      LocalVar result = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar frame = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(bytecode, result, window_iter, frame);
+      ExecutionResult()->SetDestination(result.ValueOf());
+      break;
+    }
+    case ast::Builtin::WindowIterClose: {
+      Emitter()->Emit(Bytecode::WindowIteratorFree, window_iter);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible window iteration call");
+    }
+  }
+}
+
+namespace {
+
+// The bytecodes of every window segment tree type
+#define WINDOW_TREE_CODES(F)                                                                                           \
+  F(CountWindowTree, CountWindowTreeInit, CountWindowTreeBuild, CountWindowTreeQuery,                                  \
+    CountWindowTreeFree)                                                                                               \
+  F(IntegerAvgWindowTree, AvgWindowTreeInit, IntegerAvgWindowTreeBuild, AvgWindowTreeQuery,                            \
+    AvgWindowTreeFree)                                                                                                 \
+  F(IntegerMaxWindowTree, IntegerMaxWindowTreeInit, IntegerMaxWindowTreeBuild, IntegerMaxWindowTreeQuery,              \
+    IntegerMaxWindowTreeFree)                                                                                          \
+  F(IntegerMinWindowTree, IntegerMinWindowTreeInit, IntegerMinWindowTreeBuild, IntegerMinWindowTreeQuery,              \
+    IntegerMinWindowTreeFree)                                                                                          \
+  F(IntegerSumWindowTree, IntegerSumWindowTreeInit, IntegerSumWindowTreeBuild, IntegerSumWindowTreeQuery,              \
+    IntegerSumWindowTreeFree)                                                                                          \
+  F(RealAvgWindowTree, AvgWindowTreeInit, RealAvgWindowTreeBuild, AvgWindowTreeQuery,                                  \
+    AvgWindowTreeFree)                                                                                                 \
+  F(RealMaxWindowTree, RealMaxWindowTreeInit, RealMaxWindowTreeBuild, RealMaxWindowTreeQuery,                          \
+    RealMaxWindowTreeFree)                                                                                             \
+  F(RealMinWindowTree, RealMinWindowTreeInit, RealMinWindowTreeBuild, RealMinWindowTreeQuery,                          \
+    RealMinWindowTreeFree)                                                                                             \
+  F(RealSumWindowTree, RealSumWindowTreeInit, RealSumWindowTreeBuild, RealSumWindowTreeQuery,                          \
+    RealSumWindowTreeFree)
+
+enum class WindowTreeOpKind : uint8_t { Init = 0, Build = 1, Query = 2, Free = 3 };
+
+// Given a window tree kind and the operation to perform on it, determine the appropriate bytecode
+Bytecode OpForWindowTree(const ast::BuiltinType::Kind tree_kind, const WindowTreeOpKind op_kind) {
+  switch (tree_kind) {
+    default: {
+      UNREACHABLE("Impossible window tree type");
+    }
+#define ENTRY(Type, Init, Build, Query, Free)                                                    \
+  case ast::BuiltinType::Type: {                                                                 \
+    const Bytecode codes[] = {Bytecode::Init, Bytecode::Build, Bytecode::Query, Bytecode::Free}; \
+    return codes[static_cast<uint8_t>(op_kind)];                                                 \
+  }
+      WINDOW_TREE_CODES(ENTRY)
+#undef ENTRY
+  }
+}
+
+#undef WINDOW_TREE_CODES
+
+}  // namespace
+
+void BytecodeGenerator::VisitBuiltinWindowTreeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  // The first argument to all calls is the tree instance, whose type selects the bytecode
+  const auto tree_kind = call->Arguments()[0]->GetType()->GetPointeeType()->As<ast::BuiltinType>()->GetKind();
+  const LocalVar tree = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::WindowTreeInit: {
+      Emitter()->Emit(OpForWindowTree(tree_kind, WindowTreeOpKind::Init), tree);
+      break;
+    }
+    case ast::Builtin::WindowTreeBuild: {
+      LocalVar window_iter = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar val_offset = VisitExpressionForRValue(call->Arguments()[2]);
+      Emitter()->Emit(OpForWindowTree(tree_kind, WindowTreeOpKind::Build), tree, window_iter, val_offset);
+      break;
+    }
+    case ast::Builtin::WindowTreeQuery: {
+      LocalVar begin = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar end = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar result = VisitExpressionForRValue(call->Arguments()[3]);
+      Emitter()->Emit(OpForWindowTree(tree_kind, WindowTreeOpKind::Query), result, tree, begin, end);
+      break;
+    }
+    case ast::Builtin::WindowTreeFree: {
+      Emitter()->Emit(OpForWindowTree(tree_kind, WindowTreeOpKind::Free), tree);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible window tree call");
+    }
+  }
+}
+
 void BytecodeGenerator::VisitExecutionContextCall(ast::CallExpr *call, UNUSED_ATTRIBUTE ast::Builtin builtin) {
   ast::Context *ctx = call->GetType()->GetContext();
 
@@ -1511,6 +1966,15 @@ void BytecodeGenerator::VisitBuiltinSizeOfCall(ast::CallExpr *call) {
   ExecutionResult()->SetDestination(size_var.ValueOf());
 }
 
+void BytecodeGenerator::VisitBuiltinOffsetOfCall(ast::CallExpr *call) {
+  auto *struct_type = call->Arguments()[0]->GetType()->As<ast::StructType>();
+  auto *member = call->Arguments()[1]->As<ast::IdentifierExpr>();
+  LocalVar offset_var = ExecutionResult()->GetOrCreateDestination(
+      ast::BuiltinType::Get(struct_type->GetContext(), ast::BuiltinType::Uint32));
+  Emitter()->EmitAssignImm4(offset_var, struct_type->GetOffsetOfFieldByName(member->Name()));
+  ExecutionResult()->SetDestination(offset_var.ValueOf());
+}
+
 void BytecodeGenerator::VisitBuiltinOutputCall(ast::CallExpr *call, ast::Builtin builtin) {
   LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
   switch (builtin) {
@@ -2058,6 +2522,26 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinFilterCall(call, builtin);
       break;
     }
+    case ast::Builtin::FilterLike:
+    case ast::Builtin::FilterNotLike:
+    case ast::Builtin::FilterILike:
+    case ast::Builtin::FilterNotILike: {
+      VisitBuiltinFilterLikeCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::FilterJoin: {
+      VisitBuiltinFilterJoinCall(call);
+      break;
+    }
+    case ast::Builtin::FilterParam: {
+      VisitBuiltinFilterParamCall(call);
+      break;
+    }
+    case ast::Builtin::Like:
+    case ast::Builtin::ILike: {
+      VisitBuiltinLikeCall(call, builtin);
+      break;
+    }
     case ast::Builtin::ExecutionContextStartResourceTracker:
     case ast::Builtin::ExecutionContextEndResourceTracker:
     case ast::Builtin::ExecutionContextEndPipelineTracker:
@@ -2076,6 +2560,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::TableIterInitBind:
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterReset:
+    case ast::Builtin::TableIterRestrictRange:
+    case ast::Builtin::TableIterRestrictRangeToParam:
     case ast::Builtin::TableIterGetPCI:
     case ast::Builtin::TableIterClose: {
       VisitBuiltinTableIterCall(call, builtin);
@@ -2085,6 +2571,21 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinTableIterParallelCall(call);
       break;
     }
+    case ast::Builtin::CSVReaderInit:
+    case ast::Builtin::CSVReaderAdvance:
+    case ast::Builtin::CSVReaderGetBool:
+    case ast::Builtin::CSVReaderGetInt:
+    case ast::Builtin::CSVReaderGetReal:
+    case ast::Builtin::CSVReaderGetDate:
+    case ast::Builtin::CSVReaderGetString:
+    case ast::Builtin::CSVReaderClose: {
+      VisitBuiltinCSVReaderCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::CSVReaderParallel: {
+      VisitBuiltinCSVParallelCall(call);
+      break;
+    }
     case ast::Builtin::PCIIsFiltered:
     case ast::Builtin::PCIHasNext:
     case ast::Builtin::PCIHasNextFiltered:
@@ -2131,10 +2632,12 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     }
     case ast::Builtin::AggHashTableInit:
     case ast::Builtin::AggHashTableInsert:
+    case ast::Builtin::AggHashTableInsertPartitioned:
     case ast::Builtin::AggHashTableLookup:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
+    case ast::Builtin::AggHashTableBuildPartitions:
     case ast::Builtin::AggHashTableFree: {
       VisitBuiltinAggHashTableCall(call, builtin);
       break;
@@ -2164,6 +2667,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     }
     case ast::Builtin::JoinHashTableInit:
     case ast::Builtin::JoinHashTableInsert:
+    case ast::Builtin::JoinHashTableAddFilterKey:
     case ast::Builtin::JoinHashTableIterInit:
     case ast::Builtin::JoinHashTableIterGetRow:
     case ast::Builtin::JoinHashTableIterHasNext:
@@ -2181,7 +2685,9 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::SorterSort:
     case ast::Builtin::SorterSortParallel:
     case ast::Builtin::SorterSortTopKParallel:
-    case ast::Builtin::SorterFree: {
+    case ast::Builtin::SorterFree:
+    case ast::Builtin::SorterGetTupleCount:
+    case ast::Builtin::SorterGetTupleAt: {
       VisitBuiltinSorterCall(call, builtin);
       break;
     }
@@ -2193,6 +2699,33 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::WindowInit:
+    case ast::Builtin::WindowFree:
+    case ast::Builtin::WindowFrameInit: {
+      VisitBuiltinWindowCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::WindowIterInit:
+    case ast::Builtin::WindowIterHasNext:
+    case ast::Builtin::WindowIterNext:
+    case ast::Builtin::WindowIterGetRow:
+    case ast::Builtin::WindowIterIsPartitionStart:
+    case ast::Builtin::WindowIterGetRowNumber:
+    case ast::Builtin::WindowIterGetRank:
+    case ast::Builtin::WindowIterGetDenseRank:
+    case ast::Builtin::WindowIterGetFrameBegin:
+    case ast::Builtin::WindowIterGetFrameEnd:
+    case ast::Builtin::WindowIterClose: {
+      VisitBuiltinWindowIterCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::WindowTreeInit:
+    case ast::Builtin::WindowTreeBuild:
+    case ast::Builtin::WindowTreeQuery:
+    case ast::Builtin::WindowTreeFree: {
+      VisitBuiltinWindowTreeCall(call, builtin);
+      break;
+    }
     case ast::Builtin::ACos:
     case ast::Builtin::ASin:
     case ast::Builtin::ATan:
@@ -2208,6 +2741,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinSizeOfCall(call);
       break;
     }
+    case ast::Builtin::OffsetOf: {
+      VisitBuiltinOffsetOfCall(call);
+      break;
+    }
     case ast::Builtin::PtrCast: {
       Visit(call->Arguments()[1]);
       break;
@@ -2935,6 +3472,9 @@ std::unique_ptr<BytecodeModule> BytecodeGenerator::Compile(ast::AstNode *root, e
   BytecodeGenerator generator{exec_ctx};
   generator.Visit(root);
 
+  // Fuse common bytecode sequences to cut down on dispatch in the VM
+  Superinstructions::Fuse(&generator.bytecode_, generator.functions_);
+
   // Create the bytecode module. Note that we move the bytecode and functions
   // array from the generator into the module.
   return std::make_unique<BytecodeModule>(name, std::move(generator.bytecode_), std::move(generator.functions_));
@@ -37,11 +37,44 @@ void OpTableVectorIteratorReset(terrier::execution::sql::TableVectorIterator *it
   iter->Reset();
 }
 
+void OpTableVectorIteratorRestrictRange(terrier::execution::sql::TableVectorIterator *iter, const uint32_t col_idx,
+                                        const int8_t col_type, const int64_t min, const int64_t max) {
+  TERRIER_ASSERT(iter != nullptr, "NULL iterator given to restrict");
+  iter->RestrictRange(col_idx, static_cast<terrier::type::TypeId>(col_type), min, max);
+}
+
+void OpTableVectorIteratorRestrictRangeToParam(terrier::execution::sql::TableVectorIterator *iter,
+                                               const uint32_t col_idx, const int8_t col_type, const int8_t comparison,
+                                               const uint32_t param_idx) {
+  TERRIER_ASSERT(iter != nullptr, "NULL iterator given to restrict");
+  iter->RestrictRangeToParam(col_idx, static_cast<terrier::type::TypeId>(col_type),
+                             static_cast<terrier::parser::ExpressionType>(comparison), param_idx);
+}
+
 void OpTableVectorIteratorFree(terrier::execution::sql::TableVectorIterator *iter) {
   TERRIER_ASSERT(iter != nullptr, "NULL iterator given to close");
   iter->~TableVectorIterator();
 }
 
+void OpCSVReaderInit(terrier::execution::sql::CSVReader *reader, uintptr_t file_name, uint64_t length,
+                     int8_t delimiter, int8_t quote, int8_t escape) {
+  TERRIER_ASSERT(reader != nullptr, "Null reader to initialize");
+  new (reader) terrier::execution::sql::CSVReader(std::string(reinterpret_cast<const char *>(file_name), length),
+                                                  delimiter, quote, escape);
+}
+
+void OpCSVReaderFree(terrier::execution::sql::CSVReader *reader) {
+  TERRIER_ASSERT(reader != nullptr, "NULL reader given to close");
+  reader->~CSVReader();
+}
+
+void OpParallelScanCSV(uintptr_t file_name, uint64_t length, int8_t delimiter, int8_t quote, int8_t escape,
+                       void *query_state, terrier::execution::sql::ThreadStateContainer *thread_states,
+                       terrier::execution::sql::CSVReader::ScanFn scanner) {
+  terrier::execution::sql::CSVReader::ParallelScan(std::string(reinterpret_cast<const char *>(file_name), length),
+                                                   delimiter, quote, escape, query_state, thread_states, scanner);
+}
+
 void OpPCIFilterEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
                       int8_t type, int64_t val) {
   auto sql_type = static_cast<terrier::type::TypeId>(type);
@@ -84,6 +117,49 @@ void OpPCIFilterNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColum
   *size = iter->FilterColByVal<std::not_equal_to>(col_idx, sql_type, v);
 }
 
+#define GEN_PCI_FILTER_STRING(Op, Comparison)                                                                     \
+  void OpPCIFilter##Op##String(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,           \
+                               uint32_t col_idx, const terrier::execution::sql::StringVal *val) {                 \
+    TERRIER_ASSERT(!val->is_null_, "Cannot filter by NULL");                                                      \
+    const auto entry = terrier::execution::sql::StringVal::CreateVarlen(*val, false);                             \
+    const terrier::execution::sql::ProjectedColumnsIterator::FilterVal filter_val{.str_ = &entry};                \
+    *size = iter->FilterColByVal<Comparison>(col_idx, terrier::type::TypeId::VARCHAR, filter_val);                \
+  }
+GEN_PCI_FILTER_STRING(Equal, std::equal_to)
+GEN_PCI_FILTER_STRING(GreaterThan, std::greater)
+GEN_PCI_FILTER_STRING(GreaterThanEqual, std::greater_equal)
+GEN_PCI_FILTER_STRING(LessThan, std::less)
+GEN_PCI_FILTER_STRING(LessThanEqual, std::less_equal)
+GEN_PCI_FILTER_STRING(NotEqual, std::not_equal_to)
+#undef GEN_PCI_FILTER_STRING
+
+#define GEN_PCI_FILTER_LIKE(Op, CaseInsensitive, Negate)                                                         \
+  void OpPCIFilter##Op(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx, \
+                       const terrier::execution::sql::StringVal *pattern) {                                       \
+    TERRIER_ASSERT(!pattern->is_null_, "Cannot filter by NULL");                                                  \
+    const terrier::execution::sql::LikePattern like(pattern->StringView(), CaseInsensitive);                      \
+    *size = iter->FilterColByLike(col_idx, like, Negate);                                                         \
+  }
+GEN_PCI_FILTER_LIKE(Like, false, false)
+GEN_PCI_FILTER_LIKE(NotLike, false, true)
+GEN_PCI_FILTER_LIKE(ILike, true, false)
+GEN_PCI_FILTER_LIKE(NotILike, true, true)
+#undef GEN_PCI_FILTER_LIKE
+
+void OpPCIFilterJoin(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                     int8_t type, const terrier::execution::sql::JoinHashTable *join_hash_table) {
+  TERRIER_ASSERT(join_hash_table->IsBuilt(), "Probing the runtime filter of an unbuilt join hash table");
+  *size = iter->FilterColByJoinKeys(col_idx, static_cast<terrier::type::TypeId>(type), *join_hash_table);
+}
+
+void OpPCIFilterParam(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                      int8_t type, int8_t comparison, const terrier::execution::exec::ExecutionContext *exec_ctx,
+                      uint32_t param_idx) {
+  const auto &param = exec_ctx->GetParam(param_idx);
+  *size = iter->FilterColByParam(col_idx, static_cast<terrier::type::TypeId>(type),
+                                 static_cast<terrier::parser::ExpressionType>(comparison), param);
+}
+
 // ---------------------------------------------------------
 // Filter Manager
 // ---------------------------------------------------------
@@ -177,12 +253,42 @@ void OpSorterSortTopKParallel(terrier::execution::sql::Sorter *sorter,
 
 void OpSorterFree(terrier::execution::sql::Sorter *sorter) { sorter->~Sorter(); }
 
+void OpSorterGetTupleCount(uint64_t *count, const terrier::execution::sql::Sorter *sorter) {
+  *count = sorter->NumTuplesForRandomAccess();
+}
+
 void OpSorterIteratorInit(terrier::execution::sql::SorterIterator *iter, terrier::execution::sql::Sorter *sorter) {
   new (iter) terrier::execution::sql::SorterIterator(sorter);
 }
 
 void OpSorterIteratorFree(terrier::execution::sql::SorterIterator *iter) { iter->~SorterIterator(); }
 
+// ---------------------------------------------------------
+// Window functions
+// ---------------------------------------------------------
+
+void OpWindowInit(terrier::execution::sql::WindowOperator *window, const terrier::execution::sql::Sorter *sorter,
+                  const terrier::execution::sql::Sorter::ComparisonFunction partition_cmp_fn,
+                  const terrier::execution::sql::Sorter::ComparisonFunction peer_cmp_fn) {
+  new (window) terrier::execution::sql::WindowOperator(*sorter, partition_cmp_fn, peer_cmp_fn);
+}
+
+void OpWindowFree(terrier::execution::sql::WindowOperator *window) { window->~WindowOperator(); }
+
+void OpWindowFrameInit(terrier::execution::sql::WindowFrame *frame, const int8_t mode, const int8_t start,
+                       const uint32_t start_offset, const int8_t end, const uint32_t end_offset) {
+  using WindowFrame = terrier::execution::sql::WindowFrame;
+  *frame = {static_cast<WindowFrame::Mode>(mode), static_cast<WindowFrame::Bound>(start), start_offset,
+            static_cast<WindowFrame::Bound>(end), end_offset};
+}
+
+void OpWindowIteratorInit(terrier::execution::sql::WindowIterator *iter,
+                          const terrier::execution::sql::WindowOperator *window) {
+  new (iter) terrier::execution::sql::WindowIterator(*window);
+}
+
+void OpWindowIteratorFree(terrier::execution::sql::WindowIterator *iter) { iter->~WindowIterator(); }
+
 // -------------------------------------------------------------
 // StorageInterface Calls
 // -------------------------------------------------------------
@@ -32,6 +32,7 @@
 #include "execution/ast/type.h"
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/bytecode_traits.h"
+#include "execution/vm/object_cache.h"
 #include "loggers/execution_logger.h"
 
 extern void *__dso_handle __attribute__((__visibility__("hidden")));  // NOLINT
@@ -40,6 +41,9 @@ namespace terrier::execution::vm {
 
 namespace {
 
+// Set by LLVMEngine::Initialize() if compiled modules should be cached on disk
+std::unique_ptr<ObjectCache> object_cache;
+
 bool FunctionHasIndirectReturn(const ast::FunctionType *func_type) {
   ast::Type *ret_type = func_type->ReturnType();
   return (!ret_type->IsNilType() && ret_type->Size() > sizeof(int64_t));
@@ -857,8 +861,16 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunctions() {
   //
 
   llvm::IRBuilder<> ir_builder(GetContext());
-  for (const auto &func_info : TplModule().Functions()) {
-    DefineFunction(func_info, &ir_builder);
+  if (Options().GetFunctions().empty()) {
+    for (const auto &func_info : TplModule().Functions()) {
+      DefineFunction(func_info, &ir_builder);
+    }
+    return;
+  }
+
+  // Only some functions are compiled. The others stay declarations.
+  for (const FunctionId func_id : Options().GetFunctions()) {
+    DefineFunction(*TplModule().GetFuncInfoById(func_id), &ir_builder);
   }
 }
 
@@ -893,7 +905,11 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   //
 
   llvm::PassManagerBuilder pm_builder;
-  pm_builder.Inliner = llvm::createFunctionInliningPass(3, 0, false);
+  if (Options().IsBaseline()) {
+    pm_builder.OptLevel = 1;
+  } else {
+    pm_builder.Inliner = llvm::createFunctionInliningPass(3, 0, false);
+  }
 
   //
   // The function optimization passes ...
@@ -922,10 +938,20 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   function_pm.doInitialization();
   for (const auto &func_info : TplModule().Functions()) {
     auto *func = Module()->getFunction(func_info.Name());
-    function_pm.run(*func);
+    if (func != nullptr && !func->isDeclaration()) {
+      function_pm.run(*func);
+    }
   }
   function_pm.doFinalization();
 
+  //
+  // Baseline compilation stops here
+  //
+
+  if (Options().IsBaseline()) {
+    return;
+  }
+
   //
   // Now, run the module-level optimizations
   //
@@ -1099,7 +1125,7 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
 // LLVM Engine
 // ---------------------------------------------------------
 
-void LLVMEngine::Initialize() {
+void LLVMEngine::Initialize(const std::string &object_cache_directory) {
   // Global LLVM initialization
   llvm::InitializeNativeTarget();
   llvm::InitializeNativeTargetAsmPrinter();
@@ -1107,12 +1133,29 @@ void LLVMEngine::Initialize() {
 
   // Make all exported TPL symbols available to JITed code
   llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+
+  if (!object_cache_directory.empty()) {
+    object_cache = std::make_unique<ObjectCache>(object_cache_directory, CompilerOptions().GetBytecodeHandlersBcPath());
+  }
 }
 
-void LLVMEngine::Shutdown() { llvm::llvm_shutdown(); }
+void LLVMEngine::Shutdown() {
+  object_cache.reset();
+  llvm::llvm_shutdown();
+}
 
 std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeModule &module,
                                                                 const CompilerOptions &options) {
+  // A module compiled by an earlier process can be loaded as is. Entries are only kept for fully optimized modules.
+  const bool use_object_cache = object_cache != nullptr && !options.IsBaseline() && options.GetFunctions().empty();
+  if (use_object_cache) {
+    if (auto object_code = object_cache->Lookup(module); object_code != nullptr) {
+      auto compiled_module = std::make_unique<CompiledModule>(std::move(object_code));
+      compiled_module->Load(module);
+      if (compiled_module->IsLoaded()) return compiled_module;
+    }
+  }
+
   CompiledModuleBuilder builder(options, module);
 
   builder.DeclareFunctions();
@@ -1129,6 +1172,10 @@ std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeMo
 
   compiled_module->Load(module);
 
+  if (use_object_cache && compiled_module->IsLoaded()) {
+    object_cache->Store(module, *compiled_module->GetObjectCode());
+  }
+
   return compiled_module;
 }
 
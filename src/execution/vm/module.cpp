@@ -3,10 +3,13 @@
 #include <tbb/task.h>
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/constants.h"
+#include "execution/vm/bytecode_iterator.h"
 
 #define XBYAK_NO_OP_NAMES
 #include "xbyak/xbyak.h"
@@ -14,25 +17,48 @@
 namespace terrier::execution::vm {
 
 // ---------------------------------------------------------
-// Async Compile Task
+// Tier-Up Task
 // ---------------------------------------------------------
 
-// This class encapsulates the ability to asynchronously JIT compile a module.
-class Module::AsyncCompileTask : public tbb::task {
+// This class encapsulates the ability to asynchronously JIT compile a hot
+// function.
+class Module::TierUpTask : public tbb::task {
  public:
-  // Construct an asynchronous compilation task to compile the the module
-  explicit AsyncCompileTask(Module *module) : module_(module) {}
+  // Construct an asynchronous compilation task to compile the given function
+  TierUpTask(const Module *module, std::shared_ptr<TieringState> tiering, const FunctionId func_id)
+      : module_(module), tiering_(std::move(tiering)), func_id_(func_id) {}
 
   // Execute
   tbb::task *execute() override {
-    // This simply invokes Module::CompileToMachineCode() asynchronously.
-    module_->CompileToMachineCode();
+    // The module may be gone by the time this task runs. If it is not, it
+    // stays alive until the compilation is done.
+    {
+      std::lock_guard<std::mutex> lock(tiering_->mutex_);
+      if (tiering_->cancelled_) return nullptr;
+      tiering_->running_++;
+    }
+
+    try {
+      module_->TierUp(func_id_);
+    } catch (const std::exception &e) {
+      // Nobody waits on this task, so failures leave the function interpreted
+      EXECUTION_LOG_ERROR("Compiling function {} failed: {}", func_id_, e.what());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(tiering_->mutex_);
+      tiering_->running_--;
+    }
+    tiering_->done_.notify_all();
+
     // Done. There's no next task, so return null.
     return nullptr;
   }
 
  private:
-  Module *module_;
+  const Module *module_;
+  std::shared_ptr<TieringState> tiering_;
+  FunctionId func_id_;
 };
 
 // ---------------------------------------------------------
@@ -45,7 +71,10 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
     : bytecode_module_(std::move(bytecode_module)),
       jit_module_(std::move(llvm_module)),
       functions_(std::make_unique<std::atomic<void *>[]>(bytecode_module_->NumFunctions())),
-      bytecode_trampolines_(std::make_unique<Trampoline[]>(bytecode_module_->NumFunctions())) {
+      bytecode_trampolines_(std::make_unique<Trampoline[]>(bytecode_module_->NumFunctions())),
+      hotness_(std::make_unique<std::atomic<uint32_t>[]>(bytecode_module_->NumFunctions())),
+      tiers_(std::make_unique<std::atomic<uint8_t>[]>(bytecode_module_->NumFunctions())),
+      tiering_(std::make_shared<TieringState>()) {
   // Create the trampolines for all bytecode functions
   for (const auto &func : bytecode_module_->Functions()) {
     CreateFunctionTrampoline(func.Id());
@@ -57,14 +86,29 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
     const auto num_functions = bytecode_module_->NumFunctions();
     for (uint32_t idx = 0; idx < num_functions; idx++) {
       functions_[idx] = bytecode_trampolines_[idx].Code();
+      tiers_[idx] = static_cast<uint8_t>(FunctionTier::Interpreted);
     }
   } else {
     const auto num_functions = bytecode_module_->NumFunctions();
     for (uint32_t idx = 0; idx < num_functions; idx++) {
       auto func_info = bytecode_module_->GetFuncInfoById(static_cast<uint16_t>(idx));
       functions_[idx] = jit_module_->GetFunctionPointer(func_info->Name());
+      tiers_[idx] = static_cast<uint8_t>(FunctionTier::Optimized);
     }
   }
+
+  const auto num_functions = bytecode_module_->NumFunctions();
+  for (uint32_t idx = 0; idx < num_functions; idx++) {
+    hotness_[idx] = 0;
+  }
+}
+
+Module::~Module() {
+  // Compilations that have not started will see the flag and not touch this
+  // module. Wait for the ones that have.
+  std::unique_lock<std::mutex> lock(tiering_->mutex_);
+  tiering_->cancelled_ = true;
+  tiering_->done_.wait(lock, [this] { return tiering_->running_ == 0; });
 }
 
 namespace {
@@ -279,18 +323,110 @@ void Module::CompileToMachineCode() {
     LLVMEngine::CompilerOptions options;
     jit_module_ = LLVMEngine::Compile(*bytecode_module_, options);
 
-    // Setup function pointers
+    // Setup function pointers. Functions that were tiered up in adaptive mode
+    // may be swapped concurrently, so this happens under the tiering latch.
+    std::lock_guard<std::mutex> lock(tiering_->mutex_);
     for (const auto &func_info : bytecode_module_->Functions()) {
       auto *jit_function = jit_module_->GetFunctionPointer(func_info.Name());
       TERRIER_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
-      functions_[func_info.Id()].store(jit_function, std::memory_order_relaxed);
+      functions_[func_info.Id()].store(jit_function, std::memory_order_release);
+      tiers_[func_info.Id()].store(static_cast<uint8_t>(FunctionTier::Optimized), std::memory_order_relaxed);
     }
   });
 }
 
-void Module::CompileToMachineCodeAsync() {
-  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this);
+void Module::RecordHotness(const FunctionId func_id, const uint32_t count) const {
+  if (!adaptive_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Only the invocation that crosses the threshold triggers compilation
+  const uint32_t hotness = hotness_[func_id].fetch_add(count, std::memory_order_relaxed);
+  if (hotness >= hotness_threshold_ || hotness + count < hotness_threshold_) {
+    return;
+  }
+
+  if (tiers_[func_id].load(std::memory_order_relaxed) == static_cast<uint8_t>(FunctionTier::Optimized)) {
+    return;
+  }
+
+  EXECUTION_LOG_DEBUG("Function {} is hot, compiling it", GetFuncInfoById(func_id)->Name());
+  auto *compile_task = new (tbb::task::allocate_root()) TierUpTask(this, tiering_, func_id);
   tbb::task::enqueue(*compile_task);
 }
 
+void Module::TierUp(const FunctionId func_id) const {
+  const std::vector<FunctionId> funcs = ReachableFunctions(func_id);
+
+  // The baseline tier gets the function out of the interpreter quickly. The
+  // optimized tier then replaces it if the module is still around.
+  if (baseline_tier_) {
+    LLVMEngine::CompilerOptions options;
+    options.SetBaseline(true).SetFunctions(funcs);
+    if (!CompileTier(funcs, FunctionTier::Baseline, options)) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(tiering_->mutex_);
+    if (tiering_->cancelled_) {
+      return;
+    }
+  }
+
+  LLVMEngine::CompilerOptions options;
+  options.SetFunctions(funcs);
+  CompileTier(funcs, FunctionTier::Optimized, options);
+}
+
+bool Module::CompileTier(const std::vector<FunctionId> &funcs, const FunctionTier tier,
+                         const LLVMEngine::CompilerOptions &options) const {
+  auto compiled_module = LLVMEngine::Compile(*bytecode_module_, options);
+  if (!compiled_module->IsLoaded()) {
+    EXECUTION_LOG_ERROR("Could not compile function {}", GetFuncInfoById(funcs[0])->Name());
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(tiering_->mutex_);
+  for (const FunctionId func_id : funcs) {
+    if (tiers_[func_id].load(std::memory_order_relaxed) >= static_cast<uint8_t>(tier)) {
+      continue;
+    }
+    auto *jit_function = compiled_module->GetFunctionPointer(GetFuncInfoById(func_id)->Name());
+    TERRIER_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
+    functions_[func_id].store(jit_function, std::memory_order_release);
+    tiers_[func_id].store(static_cast<uint8_t>(tier), std::memory_order_relaxed);
+  }
+  tiering_->compiled_modules_.emplace_back(std::move(compiled_module));
+  return true;
+}
+
+std::vector<FunctionId> Module::ReachableFunctions(const FunctionId func_id) const {
+  std::vector<bool> visited(bytecode_module_->NumFunctions(), false);
+  std::vector<FunctionId> funcs = {func_id};
+  visited[func_id] = true;
+
+  // Depth-first over calls and function pointer operands
+  std::vector<FunctionId> stack = {func_id};
+  while (!stack.empty()) {
+    const FunctionInfo &func_info = *GetFuncInfoById(stack.back());
+    stack.pop_back();
+    for (auto iter = bytecode_module_->BytecodeForFunction(func_info); !iter.Done(); iter.Advance()) {
+      const Bytecode bytecode = iter.CurrentBytecode();
+      for (uint32_t i = 0; i < Bytecodes::NumOperands(bytecode); i++) {
+        if (Bytecodes::GetNthOperandType(bytecode, i) != OperandType::FunctionId) {
+          continue;
+        }
+        const FunctionId callee_id = iter.GetFunctionIdOperand(i);
+        if (!visited[callee_id]) {
+          visited[callee_id] = true;
+          funcs.push_back(callee_id);
+          stack.push_back(callee_id);
+        }
+      }
+    }
+  }
+
+  return funcs;
+}
+
 }  // namespace terrier::execution::vm
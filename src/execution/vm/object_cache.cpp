@@ -0,0 +1,184 @@
+#include "execution/vm/object_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "execution/ast/type.h"
+#include "execution/util/cpu_info.h"
+#include "execution/util/hash.h"
+#include "execution/vm/bytecode_module.h"
+#include "loggers/execution_logger.h"
+
+namespace terrier::execution::vm {
+
+namespace {
+
+// Identifies the file format. Bump the version whenever the key or the layout changes.
+constexpr const char K_MAGIC[] = "TPLOBJ01";
+constexpr std::size_t K_MAGIC_SIZE = sizeof(K_MAGIC) - 1;
+
+template <typename T>
+void AppendValue(std::string *out, const T val) {
+  out->append(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+void AppendString(std::string *out, const std::string &str) {
+  AppendValue(out, static_cast<uint64_t>(str.size()));
+  out->append(str);
+}
+
+}  // namespace
+
+ObjectCache::ObjectCache(std::string directory, const std::string &bytecode_handlers_path)
+    : directory_(std::move(directory)), usable_(true) {
+  if (std::error_code error = llvm::sys::fs::create_directories(directory_)) {
+    EXECUTION_LOG_ERROR("Object cache: could not create directory '{}': {}", directory_, error.message());
+    usable_ = false;
+    return;
+  }
+
+  AppendString(&environment_, LLVM_VERSION_STRING);
+  AppendString(&environment_, llvm::sys::getProcessTriple());
+  AppendString(&environment_, llvm::sys::getHostCPUName().str());
+
+  // The target machine is built with every feature of the host, so all of them go into the key, in a fixed order
+  llvm::StringMap<bool> feature_map;
+  llvm::sys::getHostCPUFeatures(feature_map);
+  std::vector<std::string> features;
+  for (const auto &entry : feature_map) features.emplace_back((entry.getValue() ? "+" : "-") + entry.getKey().str());
+  std::sort(features.begin(), features.end());
+  for (const auto &feature : features) AppendString(&environment_, feature);
+  for (const auto feature : {CpuInfo::SSE_4_2, CpuInfo::AVX, CpuInfo::AVX2, CpuInfo::AVX512}) {
+    AppendValue(&environment_, CpuInfo::Instance()->HasFeature(feature));
+  }
+
+  // Object code calls into the bytecode handlers, so a rebuilt handlers file invalidates every entry
+  auto handlers = llvm::MemoryBuffer::getFile(bytecode_handlers_path);
+  if (std::error_code error = handlers.getError()) {
+    EXECUTION_LOG_ERROR("Object cache: could not read '{}': {}", bytecode_handlers_path, error.message());
+    usable_ = false;
+    return;
+  }
+  const llvm::StringRef handlers_code = (*handlers)->getBuffer();
+  AppendValue(&environment_, static_cast<uint64_t>(handlers_code.size()));
+  AppendValue(&environment_, util::Hasher::Hash<util::HashMethod::xxHash3>(
+                                 reinterpret_cast<const uint8_t *>(handlers_code.data()),
+                                 static_cast<uint32_t>(handlers_code.size())));
+}
+
+bool ObjectCache::IsCacheable(const BytecodeModule &module) {
+  for (const auto &func : module.Functions()) {
+    for (auto iter = module.BytecodeForFunction(func); !iter.Done(); iter.Advance()) {
+      switch (iter.CurrentBytecode()) {
+        case Bytecode::InitString:
+        case Bytecode::CSVReaderInit:
+        case Bytecode::ParallelScanCSV:
+          return false;
+        default:
+          break;
+      }
+    }
+  }
+  return true;
+}
+
+std::string ObjectCache::MakeKey(const BytecodeModule &module) const {
+  std::string key = environment_;
+  AppendValue(&key, static_cast<uint64_t>(module.NumFunctions()));
+  for (const auto &func : module.Functions()) {
+    AppendString(&key, func.Name());
+    AppendString(&key, ast::Type::ToString(func.FuncType()));
+    AppendValue(&key, func.NumParams());
+    AppendValue(&key, static_cast<uint64_t>(func.BytecodeRange().first));
+    AppendValue(&key, static_cast<uint64_t>(func.BytecodeRange().second));
+    AppendValue(&key, static_cast<uint64_t>(func.Locals().size()));
+    for (const auto &local : func.Locals()) {
+      AppendString(&key, local.Name());
+      AppendString(&key, ast::Type::ToString(local.GetType()));
+      AppendValue(&key, local.Offset());
+      AppendValue(&key, local.Size());
+    }
+  }
+  const std::vector<uint8_t> &code = module.Code();
+  AppendValue(&key, static_cast<uint64_t>(code.size()));
+  key.append(reinterpret_cast<const char *>(code.data()), code.size());
+  return key;
+}
+
+std::string ObjectCache::MakePath(const std::string &key) const {
+  const auto hash = util::Hasher::Hash<util::HashMethod::xxHash3>(reinterpret_cast<const uint8_t *>(key.data()),
+                                                                  static_cast<uint32_t>(key.size()));
+  llvm::SmallString<128> path(directory_);
+  llvm::sys::path::append(path, llvm::utohexstr(hash) + ".to");
+  return path.str().str();
+}
+
+std::unique_ptr<llvm::MemoryBuffer> ObjectCache::Lookup(const BytecodeModule &module) const {
+  if (!usable_ || !IsCacheable(module)) return nullptr;
+
+  const std::string key = MakeKey(module);
+  auto file = llvm::MemoryBuffer::getFile(MakePath(key));
+  if (file.getError()) return nullptr;
+
+  // Layout: magic, key size, key, object code
+  const llvm::StringRef contents = (*file)->getBuffer();
+  const std::size_t header_size = K_MAGIC_SIZE + sizeof(uint64_t);
+  if (contents.size() < header_size || std::memcmp(contents.data(), K_MAGIC, K_MAGIC_SIZE) != 0) return nullptr;
+  uint64_t key_size;
+  std::memcpy(&key_size, contents.data() + K_MAGIC_SIZE, sizeof(key_size));
+  if (key_size != key.size() || contents.size() - header_size < key_size ||
+      contents.substr(header_size, key_size) != key) {
+    return nullptr;
+  }
+
+  EXECUTION_LOG_DEBUG("Object cache: hit for module {}", module.Name());
+  return llvm::MemoryBuffer::getMemBufferCopy(contents.substr(header_size + key_size), module.Name());
+}
+
+void ObjectCache::Store(const BytecodeModule &module, const llvm::MemoryBuffer &object_code) const {
+  if (!usable_ || !IsCacheable(module)) return;
+
+  const std::string key = MakeKey(module);
+  const std::string path = MakePath(key);
+
+  // Readers must never see a partially written entry
+  int fd;
+  llvm::SmallString<128> tmp_path;
+  if (std::error_code error = llvm::sys::fs::createUniqueFile(path + ".tmp-%%%%%%", fd, tmp_path)) {
+    EXECUTION_LOG_ERROR("Object cache: could not create file in '{}': {}", directory_, error.message());
+    return;
+  }
+  {
+    llvm::raw_fd_ostream out(fd, true);
+    out.write(K_MAGIC, K_MAGIC_SIZE);
+    const auto key_size = static_cast<uint64_t>(key.size());
+    out.write(reinterpret_cast<const char *>(&key_size), sizeof(key_size));
+    out.write(key.data(), key.size());
+    out.write(object_code.getBufferStart(), object_code.getBufferSize());
+    out.close();
+    if (out.has_error()) {
+      EXECUTION_LOG_ERROR("Object cache: could not write '{}': {}", tmp_path.str().str(), out.error().message());
+      out.clear_error();
+      llvm::sys::fs::remove(tmp_path);
+      return;
+    }
+  }
+  if (std::error_code error = llvm::sys::fs::rename(tmp_path, path)) {
+    EXECUTION_LOG_ERROR("Object cache: could not rename '{}': {}", tmp_path.str().str(), error.message());
+    llvm::sys::fs::remove(tmp_path);
+  }
+}
+
+}  // namespace terrier::execution::vm
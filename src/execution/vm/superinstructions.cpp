@@ -0,0 +1,132 @@
+#include "execution/vm/superinstructions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "execution/vm/bytecode_iterator.h"
+#include "execution/vm/bytecode_module.h"
+
+namespace terrier::execution::vm {
+
+namespace {
+
+// The superinstruction a bytecode can be fused into, and the bytecode that must follow it
+struct Fusion {
+  Bytecode second_;
+  Bytecode fused_;
+};
+
+const std::unordered_map<Bytecode, Fusion> &Fusions() {
+  static const std::unordered_map<Bytecode, Fusion> fusions = {
+#define ENTRY(fused, first, second) {Bytecode::first, {Bytecode::second, Bytecode::fused}},
+      SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+  };
+  return fusions;
+}
+
+// Deeper nesting than this does not make a pair any more interesting, and would overflow the weights
+constexpr uint32_t K_MAX_LOOP_DEPTH = 12;
+
+// The absolute position of the target of the jump at the iterator's position
+std::size_t JumpTarget(const BytecodeIterator &iter, const std::size_t position) {
+  const Bytecode bytecode = iter.CurrentBytecode();
+  for (uint32_t i = 0; i < Bytecodes::NumOperands(bytecode); i++) {
+    if (Bytecodes::GetNthOperandType(bytecode, i) == OperandType::JumpOffset) {
+      return position + Bytecodes::GetNthOperandOffset(bytecode, i) + iter.GetJumpOffsetOperand(i);
+    }
+  }
+  UNREACHABLE("Jump without a jump offset");
+}
+
+}  // namespace
+
+uint32_t Superinstructions::Fuse(std::vector<uint8_t> *code, const std::vector<FunctionInfo> &functions) {
+  const auto &fusions = Fusions();
+  uint32_t num_fused = 0;
+
+  for (const auto &func : functions) {
+    const auto [start, end] = func.BytecodeRange();
+
+    // The previous bytecode, if it can be the first half of a superinstruction
+    const Fusion *fusion = nullptr;
+    std::size_t fusion_pos = 0;
+    LocalVar fusion_dest;
+
+    for (BytecodeIterator iter(*code, start, end); !iter.Done(); iter.Advance()) {
+      const Bytecode bytecode = iter.CurrentBytecode();
+
+      if (fusion != nullptr && fusion->second_ == bytecode) {
+        // A fused conditional jump tests the result of the first bytecode without loading it from the frame, so its
+        // condition must be exactly that result
+        bool eligible = true;
+        if (bytecode == Bytecode::JumpIfFalse) {
+          const LocalVar cond = iter.GetLocalOperand(0);
+          eligible = fusion_dest.GetAddressMode() == LocalVar::AddressMode::Address &&
+                     cond.GetAddressMode() == LocalVar::AddressMode::Value &&
+                     cond.GetOffset() == fusion_dest.GetOffset();
+        }
+        if (eligible) {
+          const auto fused = Bytecodes::ToByte(fusion->fused_);
+          std::memcpy(&(*code)[start + fusion_pos], &fused, sizeof(fused));
+          num_fused++;
+        }
+      }
+
+      fusion = nullptr;
+      if (const auto it = fusions.find(bytecode); it != fusions.end()) {
+        fusion = &it->second;
+        fusion_pos = iter.GetPosition();
+        if (Bytecodes::NumOperands(bytecode) > 0 && Bytecodes::GetNthOperandType(bytecode, 0) == OperandType::Local) {
+          fusion_dest = iter.GetLocalOperand(0);
+        }
+      }
+    }
+  }
+
+  return num_fused;
+}
+
+std::vector<Superinstructions::PairProfile> Superinstructions::ProfilePairs(const BytecodeModule &module) {
+  std::map<std::pair<Bytecode, Bytecode>, uint64_t> weights;
+
+  for (const auto &func : module.Functions()) {
+    // Every backward jump closes a loop spanning from its target to itself
+    std::vector<std::pair<std::size_t, std::size_t>> loops;
+    for (auto iter = module.BytecodeForFunction(func); !iter.Done(); iter.Advance()) {
+      if (!Bytecodes::IsJump(iter.CurrentBytecode())) continue;
+      const std::size_t target = JumpTarget(iter, iter.GetPosition());
+      if (target <= iter.GetPosition()) loops.emplace_back(target, iter.GetPosition());
+    }
+
+    bool has_prev = false;
+    Bytecode prev = Bytecode::Jump;
+    uint64_t prev_weight = 0;
+    for (auto iter = module.BytecodeForFunction(func); !iter.Done(); iter.Advance()) {
+      const std::size_t position = iter.GetPosition();
+      const auto depth = static_cast<uint32_t>(std::count_if(loops.begin(), loops.end(), [=](const auto &loop) {
+        return loop.first <= position && position <= loop.second;
+      }));
+      uint64_t weight = 1;
+      for (uint32_t i = 0; i < std::min(depth, K_MAX_LOOP_DEPTH); i++) weight *= K_LOOP_WEIGHT;
+
+      if (has_prev) weights[{prev, iter.CurrentBytecode()}] += prev_weight;
+      has_prev = true;
+      prev = iter.CurrentBytecode();
+      prev_weight = weight;
+    }
+  }
+
+  std::vector<PairProfile> profile;
+  profile.reserve(weights.size());
+  for (const auto &[pair, weight] : weights) profile.push_back({pair.first, pair.second, weight});
+  std::stable_sort(profile.begin(), profile.end(),
+                   [](const PairProfile &a, const PairProfile &b) { return a.weight_ > b.weight_; });
+  return profile;
+}
+
+}  // namespace terrier::execution::vm
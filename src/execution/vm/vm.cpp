@@ -87,6 +87,10 @@ static constexpr const uint32_t K_MAX_STACK_ALLOC_SIZE = 1ull << 14ull;
 // than 4K (the soft max), try the stack and fallback to heap. If the function
 // requires less, use the stack.
 static constexpr const uint32_t K_SOFT_MAX_STACK_ALLOC_SIZE = 1ull << 12ull;
+// The number of loop back-edges the interpreter takes before it reports them
+// to the module. Batching keeps parallel workers running the same function
+// from contending on its hotness counter.
+static constexpr const uint32_t K_BACK_EDGE_BATCH_SIZE = 256;
 
 VM::VM(const Module *module) : module_(module) {}
 
@@ -114,6 +118,7 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
   std::memcpy(raw_frame + func_info->ParamsStartPos(), args, func_info->ParamsSize());
 
   EXECUTION_LOG_DEBUG("Executing function '{}'", func_info->Name());
+  module->RecordHotness(func_id, 1);
 
   // Let's go. First, create the virtual machine instance.
   VM vm(module);
@@ -122,7 +127,7 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
   const uint8_t *bytecode = module->GetBytecodeModule()->GetBytecodeForFunction(*func_info);
   TERRIER_ASSERT(bytecode != nullptr, "Bytecode cannot be null");
   Frame frame(raw_frame, frame_size);
-  vm.Interpret(bytecode, &frame);
+  vm.Interpret(func_id, bytecode, &frame);
 
   // Cleanup
   if (used_heap) {
@@ -153,7 +158,7 @@ inline ALWAYS_INLINE T Peek(const uint8_t **ip) {
 }  // namespace
 
 // NOLINTNEXTLINE (google-readability-function-size,readability-function-size)
-void VM::Interpret(const uint8_t *ip, Frame *frame) {
+void VM::Interpret(const FunctionId func_id, const uint8_t *ip, Frame *frame) {
   static void *kDispatchTable[] = {
 #define ENTRY(name, ...) &&op_##name,
       BYTECODE_LIST(ENTRY)
@@ -189,6 +194,13 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
 #define READ_FUNC_ID() READ_UIMM2()
 
 #define OP(name) op_##name
+#define COUNT_BACK_EDGE()                                      \
+  do {                                                         \
+    if (++back_edges == K_BACK_EDGE_BATCH_SIZE) {              \
+      module_->RecordHotness(func_id, K_BACK_EDGE_BATCH_SIZE); \
+      back_edges = 0;                                          \
+    }                                                          \
+  } while (false)
 #define DISPATCH_NEXT()           \
   do {                            \
     auto op = READ_OP();          \
@@ -222,6 +234,9 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
    *
    ****************************************************************************/
 
+  // Loop back-edges taken since they were last reported to the module
+  uint32_t back_edges = 0;
+
   // Jump to the first instruction
   DISPATCH_NEXT();
 
@@ -335,6 +350,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   OP(Jump) : {
     auto skip = PEEK_JMP_OFFSET();
     if (LIKELY(OpJump())) {
+      if (skip < 0) COUNT_BACK_EDGE();
       ip += skip;
     }
     DISPATCH_NEXT();
@@ -344,6 +360,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     auto cond = frame->LocalAt<bool>(READ_LOCAL_ID());
     auto skip = PEEK_JMP_OFFSET();
     if (OpJumpIfTrue(cond)) {
+      if (skip < 0) COUNT_BACK_EDGE();
       ip += skip;
     } else {
       READ_JMP_OFFSET();
@@ -355,6 +372,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     auto cond = frame->LocalAt<bool>(READ_LOCAL_ID());
     auto skip = PEEK_JMP_OFFSET();
     if (OpJumpIfFalse(cond)) {
+      if (skip < 0) COUNT_BACK_EDGE();
       ip += skip;
     } else {
       READ_JMP_OFFSET();
@@ -563,6 +581,26 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(TableVectorIteratorRestrictRange) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto col_type = READ_IMM1();
+    auto min = READ_IMM8();
+    auto max = READ_IMM8();
+    OpTableVectorIteratorRestrictRange(iter, col_idx, col_type, min, max);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorRestrictRangeToParam) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto col_type = READ_IMM1();
+    auto comparison = READ_IMM1();
+    auto param_idx = READ_UIMM4();
+    OpTableVectorIteratorRestrictRangeToParam(iter, col_idx, col_type, comparison, param_idx);
+    DISPATCH_NEXT();
+  }
+
   OP(TableVectorIteratorFree) : {
     auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
     OpTableVectorIteratorFree(iter);
@@ -577,14 +615,75 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   }
 
   OP(ParallelScanTable) : {
-    auto db_oid = READ_UIMM4();
     auto table_oid = READ_UIMM4();
+    auto col_oids = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto num_oids = READ_UIMM4();
     auto query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
     auto thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
     auto scan_fn_id = READ_FUNC_ID();
 
     auto scan_fn = reinterpret_cast<sql::TableVectorIterator::ScanFn>(module_->GetRawFunctionImpl(scan_fn_id));
-    OpParallelScanTable(db_oid, table_oid, query_state, thread_state_container, scan_fn);
+    OpParallelScanTable(table_oid, col_oids, num_oids, query_state, exec_ctx, thread_state_container, scan_fn);
+    DISPATCH_NEXT();
+  }
+
+  // -------------------------------------------------------
+  // CSV reader operations
+  // -------------------------------------------------------
+
+  OP(CSVReaderInit) : {
+    auto *reader = frame->LocalAt<sql::CSVReader *>(READ_LOCAL_ID());
+    auto file_name = static_cast<uintptr_t>(READ_IMM8());
+    auto length = static_cast<uint64_t>(READ_IMM8());
+    auto delimiter = READ_IMM1();
+    auto quote = READ_IMM1();
+    auto escape = READ_IMM1();
+    OpCSVReaderInit(reader, file_name, length, delimiter, quote, escape);
+    DISPATCH_NEXT();
+  }
+
+  OP(CSVReaderAdvance) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *reader = frame->LocalAt<sql::CSVReader *>(READ_LOCAL_ID());
+    OpCSVReaderAdvance(has_more, reader);
+    DISPATCH_NEXT();
+  }
+
+#define GEN_CSV_GET(type_str, type)                                    \
+  OP(CSVReaderGet##type_str) : {                                       \
+    auto *result = frame->LocalAt<type *>(READ_LOCAL_ID());            \
+    auto *reader = frame->LocalAt<sql::CSVReader *>(READ_LOCAL_ID());  \
+    auto col_idx = READ_UIMM4();                                       \
+    OpCSVReaderGet##type_str(result, reader, col_idx);                 \
+    DISPATCH_NEXT();                                                   \
+  }
+
+  GEN_CSV_GET(Bool, sql::BoolVal);
+  GEN_CSV_GET(Integer, sql::Integer);
+  GEN_CSV_GET(Real, sql::Real);
+  GEN_CSV_GET(Date, sql::DateVal);
+  GEN_CSV_GET(Varlen, sql::StringVal);
+#undef GEN_CSV_GET
+
+  OP(CSVReaderFree) : {
+    auto *reader = frame->LocalAt<sql::CSVReader *>(READ_LOCAL_ID());
+    OpCSVReaderFree(reader);
+    DISPATCH_NEXT();
+  }
+
+  OP(ParallelScanCSV) : {
+    auto file_name = static_cast<uintptr_t>(READ_IMM8());
+    auto length = static_cast<uint64_t>(READ_IMM8());
+    auto delimiter = READ_IMM1();
+    auto quote = READ_IMM1();
+    auto escape = READ_IMM1();
+    auto query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
+    auto scan_fn_id = READ_FUNC_ID();
+
+    auto scan_fn = reinterpret_cast<sql::CSVReader::ScanFn>(module_->GetRawFunctionImpl(scan_fn_id));
+    OpParallelScanCSV(file_name, length, delimiter, quote, escape, query_state, thread_state_container, scan_fn);
     DISPATCH_NEXT();
   }
 
@@ -701,6 +800,60 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   GEN_PCI_FILTER(NotEqual)
 #undef GEN_PCI_FILTER
 
+#define GEN_PCI_FILTER_STRING(Op)                                                  \
+  OP(PCIFilter##Op##String) : {                                                    \
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());                      \
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID()); \
+    auto col_idx = READ_UIMM4();                                                   \
+    auto *val = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());                 \
+    OpPCIFilter##Op##String(size, iter, col_idx, val);                             \
+    DISPATCH_NEXT();                                                               \
+  }
+  GEN_PCI_FILTER_STRING(Equal)
+  GEN_PCI_FILTER_STRING(GreaterThan)
+  GEN_PCI_FILTER_STRING(GreaterThanEqual)
+  GEN_PCI_FILTER_STRING(LessThan)
+  GEN_PCI_FILTER_STRING(LessThanEqual)
+  GEN_PCI_FILTER_STRING(NotEqual)
+#undef GEN_PCI_FILTER_STRING
+
+#define GEN_PCI_FILTER_LIKE(Op)                                                    \
+  OP(PCIFilter##Op) : {                                                            \
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());                      \
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID()); \
+    auto col_idx = READ_UIMM4();                                                   \
+    auto *pattern = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());             \
+    OpPCIFilter##Op(size, iter, col_idx, pattern);                                 \
+    DISPATCH_NEXT();                                                               \
+  }
+  GEN_PCI_FILTER_LIKE(Like)
+  GEN_PCI_FILTER_LIKE(NotLike)
+  GEN_PCI_FILTER_LIKE(ILike)
+  GEN_PCI_FILTER_LIKE(NotILike)
+#undef GEN_PCI_FILTER_LIKE
+
+  OP(PCIFilterJoin) : {
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto type = READ_IMM1();
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpPCIFilterJoin(size, iter, col_idx, type, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIFilterParam) : {
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto type = READ_IMM1();
+    auto comparison = READ_IMM1();
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto param_idx = READ_UIMM4();
+    OpPCIFilterParam(size, iter, col_idx, type, comparison, exec_ctx, param_idx);
+    DISPATCH_NEXT();
+  }
+
   // ------------------------------------------------------
   // Hashing
   // ------------------------------------------------------
@@ -916,6 +1069,22 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   GEN_CMP(NotEqual);
 #undef GEN_CMP
 
+  OP(Like) : {
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
+    auto *pattern = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
+    OpLike(result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
+  OP(ILike) : {
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
+    auto *pattern = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
+    OpILike(result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
 #define GEN_UNARY_MATH_OPS(op)                                      \
   OP(op##Integer) : {                                               \
     auto *result = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID()); \
@@ -992,6 +1161,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(AggregationHashTableInsertPartitioned) : {
+    auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto hash = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpAggregationHashTableInsertPartitioned(result, agg_hash_table, hash);
+    DISPATCH_NEXT();
+  }
+
   OP(AggregationHashTableLookup) : {
     auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
     auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
@@ -1047,6 +1224,17 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(AggregationHashTableBuildPartitions) : {
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto merge_partition_fn_id = READ_FUNC_ID();
+
+    auto merge_partition_fn = reinterpret_cast<sql::AggregationHashTable::MergePartitionFn>(
+        module_->GetRawFunctionImpl(merge_partition_fn_id));
+    OpAggregationHashTableBuildPartitions(agg_hash_table, query_state, merge_partition_fn);
+    DISPATCH_NEXT();
+  }
+
   OP(AggregationHashTableFree) : {
     auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
     OpAggregationHashTableFree(agg_hash_table);
@@ -1301,6 +1489,13 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableAddFilterKey) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto *key = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    OpJoinHashTableAddFilterKey(join_hash_table, key);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableIterInit) : {
     auto *iterator = frame->LocalAt<sql::JoinHashTableIterator *>(READ_LOCAL_ID());
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
@@ -1419,6 +1614,21 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(SorterGetTupleCount) : {
+    auto *count = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    OpSorterGetTupleCount(count, sorter);
+    DISPATCH_NEXT();
+  }
+
+  OP(SorterGetTupleAt) : {
+    const auto **row = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto idx = frame->LocalAt<uint64_t>(READ_LOCAL_ID());
+    OpSorterGetTupleAt(row, sorter, idx);
+    DISPATCH_NEXT();
+  }
+
   OP(SorterIteratorInit) : {
     auto *iter = frame->LocalAt<sql::SorterIterator *>(READ_LOCAL_ID());
     auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
@@ -1452,6 +1662,169 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  // -------------------------------------------------------
+  // Window functions
+  // -------------------------------------------------------
+
+  OP(WindowInit) : {
+    auto *window = frame->LocalAt<sql::WindowOperator *>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto partition_cmp_func_id = READ_FUNC_ID();
+    auto peer_cmp_func_id = READ_FUNC_ID();
+
+    auto partition_cmp_fn =
+        reinterpret_cast<sql::Sorter::ComparisonFunction>(module_->GetRawFunctionImpl(partition_cmp_func_id));
+    auto peer_cmp_fn = reinterpret_cast<sql::Sorter::ComparisonFunction>(module_->GetRawFunctionImpl(peer_cmp_func_id));
+    OpWindowInit(window, sorter, partition_cmp_fn, peer_cmp_fn);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowFree) : {
+    auto *window = frame->LocalAt<sql::WindowOperator *>(READ_LOCAL_ID());
+    OpWindowFree(window);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowFrameInit) : {
+    auto *window_frame = frame->LocalAt<sql::WindowFrame *>(READ_LOCAL_ID());
+    auto mode = READ_IMM1();
+    auto start = READ_IMM1();
+    auto start_offset = READ_UIMM4();
+    auto end = READ_IMM1();
+    auto end_offset = READ_UIMM4();
+    OpWindowFrameInit(window_frame, mode, start, start_offset, end, end_offset);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorInit) : {
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    auto *window = frame->LocalAt<sql::WindowOperator *>(READ_LOCAL_ID());
+    OpWindowIteratorInit(iter, window);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorHasNext) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorHasNext(has_more, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorNext) : {
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorNext(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorGetRow) : {
+    const auto **row = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorGetRow(row, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorIsPartitionStart) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorIsPartitionStart(result, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorGetRowNumber) : {
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorGetRowNumber(result, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorGetRank) : {
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorGetRank(result, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorGetDenseRank) : {
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorGetDenseRank(result, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorGetFrameBegin) : {
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    auto *window_frame = frame->LocalAt<sql::WindowFrame *>(READ_LOCAL_ID());
+    OpWindowIteratorGetFrameBegin(result, iter, window_frame);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorGetFrameEnd) : {
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    auto *window_frame = frame->LocalAt<sql::WindowFrame *>(READ_LOCAL_ID());
+    OpWindowIteratorGetFrameEnd(result, iter, window_frame);
+    DISPATCH_NEXT();
+  }
+
+  OP(WindowIteratorFree) : {
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID());
+    OpWindowIteratorFree(iter);
+    DISPATCH_NEXT();
+  }
+
+#define GEN_WINDOW_TREE(Name, Tree, Agg)                        \
+  OP(Name##WindowTreeInit) : {                                  \
+    auto *tree = frame->LocalAt<sql::Tree *>(READ_LOCAL_ID());  \
+    Op##Name##WindowTreeInit(tree);                             \
+    DISPATCH_NEXT();                                            \
+  }                                                             \
+  OP(Name##WindowTreeQuery) : {                                 \
+    auto *result = frame->LocalAt<sql::Agg *>(READ_LOCAL_ID()); \
+    auto *tree = frame->LocalAt<sql::Tree *>(READ_LOCAL_ID());  \
+    auto begin = frame->LocalAt<uint64_t>(READ_LOCAL_ID());     \
+    auto end = frame->LocalAt<uint64_t>(READ_LOCAL_ID());       \
+    Op##Name##WindowTreeQuery(result, tree, begin, end);        \
+    DISPATCH_NEXT();                                            \
+  }                                                             \
+  OP(Name##WindowTreeFree) : {                                  \
+    auto *tree = frame->LocalAt<sql::Tree *>(READ_LOCAL_ID());  \
+    Op##Name##WindowTreeFree(tree);                             \
+    DISPATCH_NEXT();                                            \
+  }
+
+  GEN_WINDOW_TREE(Count, CountWindowTree, CountAggregate);
+  GEN_WINDOW_TREE(Avg, AvgWindowTree, AvgAggregate);
+  GEN_WINDOW_TREE(IntegerMax, IntegerMaxWindowTree, IntegerMaxAggregate);
+  GEN_WINDOW_TREE(IntegerMin, IntegerMinWindowTree, IntegerMinAggregate);
+  GEN_WINDOW_TREE(IntegerSum, IntegerSumWindowTree, IntegerSumAggregate);
+  GEN_WINDOW_TREE(RealMax, RealMaxWindowTree, RealMaxAggregate);
+  GEN_WINDOW_TREE(RealMin, RealMinWindowTree, RealMinAggregate);
+  GEN_WINDOW_TREE(RealSum, RealSumWindowTree, RealSumAggregate);
+
+#undef GEN_WINDOW_TREE
+
+#define GEN_WINDOW_TREE_BUILD(Name, Tree)                                \
+  OP(Name##WindowTreeBuild) : {                                          \
+    auto *tree = frame->LocalAt<sql::Tree *>(READ_LOCAL_ID());           \
+    auto *iter = frame->LocalAt<sql::WindowIterator *>(READ_LOCAL_ID()); \
+    auto val_offset = frame->LocalAt<uint32_t>(READ_LOCAL_ID());         \
+    Op##Name##WindowTreeBuild(tree, iter, val_offset);                   \
+    DISPATCH_NEXT();                                                     \
+  }
+
+  GEN_WINDOW_TREE_BUILD(Count, CountWindowTree);
+  GEN_WINDOW_TREE_BUILD(IntegerAvg, AvgWindowTree);
+  GEN_WINDOW_TREE_BUILD(RealAvg, AvgWindowTree);
+  GEN_WINDOW_TREE_BUILD(IntegerMax, IntegerMaxWindowTree);
+  GEN_WINDOW_TREE_BUILD(IntegerMin, IntegerMinWindowTree);
+  GEN_WINDOW_TREE_BUILD(IntegerSum, IntegerSumWindowTree);
+  GEN_WINDOW_TREE_BUILD(RealMax, RealMaxWindowTree);
+  GEN_WINDOW_TREE_BUILD(RealMin, RealMinWindowTree);
+  GEN_WINDOW_TREE_BUILD(RealSum, RealSumWindowTree);
+
+#undef GEN_WINDOW_TREE_BUILD
+
   // -------------------------------------------------------
   // Output Calls
   // -------------------------------------------------------
@@ -1954,6 +2327,97 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  // -------------------------------------------------------
+  // Superinstructions
+  // -------------------------------------------------------
+
+  // The second bytecode of a superinstruction follows its operands. Fused
+  // conditional jumps always test the result of the first bytecode, so only
+  // the jump offset is read, and the condition comes straight from the
+  // register it was computed in.
+#define FUSED_JUMP_IF_FALSE(cond)      \
+  do {                                 \
+    READ_OP();                         \
+    READ_LOCAL_ID();                   \
+    auto skip = PEEK_JMP_OFFSET();     \
+    if (OpJumpIfFalse(cond)) {         \
+      if (skip < 0) COUNT_BACK_EDGE(); \
+      ip += skip;                      \
+    } else {                           \
+      READ_JMP_OFFSET();               \
+    }                                  \
+  } while (false)
+
+#define FUSED_JUMP()                   \
+  do {                                 \
+    READ_OP();                         \
+    auto skip = PEEK_JMP_OFFSET();     \
+    if (LIKELY(OpJump())) {            \
+      if (skip < 0) COUNT_BACK_EDGE(); \
+      ip += skip;                      \
+    }                                  \
+  } while (false)
+
+#define DO_GEN_FUSED_COMPARISON(op, type)                 \
+  OP(op##JumpIfFalse##_##type) : {                        \
+    auto *dest = frame->LocalAt<bool *>(READ_LOCAL_ID()); \
+    auto lhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    auto rhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    Op##op##_##type(dest, lhs, rhs);                      \
+    FUSED_JUMP_IF_FALSE(*dest);                           \
+    DISPATCH_NEXT();                                      \
+  }
+#define GEN_FUSED_COMPARISON_TYPES(type, ...)     \
+  DO_GEN_FUSED_COMPARISON(GreaterThan, type)      \
+  DO_GEN_FUSED_COMPARISON(GreaterThanEqual, type) \
+  DO_GEN_FUSED_COMPARISON(Equal, type)            \
+  DO_GEN_FUSED_COMPARISON(LessThan, type)         \
+  DO_GEN_FUSED_COMPARISON(LessThanEqual, type)    \
+  DO_GEN_FUSED_COMPARISON(NotEqual, type)
+  INT_TYPES(GEN_FUSED_COMPARISON_TYPES)
+#undef GEN_FUSED_COMPARISON_TYPES
+#undef DO_GEN_FUSED_COMPARISON
+
+  OP(ForceBoolTruthJumpIfFalse) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *sql_bool = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    OpForceBoolTruth(result, sql_bool);
+    FUSED_JUMP_IF_FALSE(*result);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIHasNextJumpIfFalse) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    OpPCIHasNext(has_more, iter);
+    FUSED_JUMP_IF_FALSE(*has_more);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIHasNextFilteredJumpIfFalse) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    OpPCIHasNextFiltered(has_more, iter);
+    FUSED_JUMP_IF_FALSE(*has_more);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIAdvanceJump) : {
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    OpPCIAdvance(iter);
+    FUSED_JUMP();
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIAdvanceFilteredJump) : {
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    OpPCIAdvanceFiltered(iter);
+    FUSED_JUMP();
+    DISPATCH_NEXT();
+  }
+#undef FUSED_JUMP
+#undef FUSED_JUMP_IF_FALSE
+
   // Impossible
   UNREACHABLE("Impossible to reach end of interpreter loop. Bad code!");
 }  // NOLINT (function is too long)
@@ -1989,12 +2453,13 @@ const uint8_t *VM::ExecuteCall(const uint8_t *ip, VM::Frame *caller) {
   }
 
   EXECUTION_LOG_DEBUG("Executing function '{}'", func_info->Name());
+  module_->RecordHotness(func_id, 1);
 
   // Let's go
   const uint8_t *bytecode = module_->GetBytecodeModule()->GetBytecodeForFunction(*func_info);
   TERRIER_ASSERT(bytecode != nullptr, "Bytecode cannot be null");
   VM::Frame callee(raw_frame, func_info->FrameSize());
-  Interpret(bytecode, &callee);
+  Interpret(func_id, bytecode, &callee);
 
   if (used_heap) {
     std::free(raw_frame);
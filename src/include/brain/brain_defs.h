@@ -12,6 +12,9 @@ enum class ExecutionOperatingUnitType : uint32_t {
   HASHJOIN_BUILD,
   HASHJOIN_PROBE,
 
+  MERGEJOIN_BUILD,
+  MERGEJOIN_PROBE,
+
   NLJOIN_LEFT,
   NLJOIN_RIGHT,
   IDXJOIN,
@@ -21,6 +24,7 @@ enum class ExecutionOperatingUnitType : uint32_t {
 
   SEQ_SCAN,
   IDX_SCAN,
+  CSV_SCAN,
 
   INSERT,
   UPDATE,
@@ -26,6 +26,10 @@ class BrainUtil {
         return "HASHJOIN_BUILD";
       case ExecutionOperatingUnitType::HASHJOIN_PROBE:
         return "HASHJOIN_PROBE";
+      case ExecutionOperatingUnitType::MERGEJOIN_BUILD:
+        return "MERGEJOIN_BUILD";
+      case ExecutionOperatingUnitType::MERGEJOIN_PROBE:
+        return "MERGEJOIN_PROBE";
       case ExecutionOperatingUnitType::NLJOIN_LEFT:
         return "NLJOIN_LEFT";
       case ExecutionOperatingUnitType::NLJOIN_RIGHT:
@@ -40,6 +44,8 @@ class BrainUtil {
         return "SEQ_SCAN";
       case ExecutionOperatingUnitType::IDX_SCAN:
         return "IDX_SCAN";
+      case ExecutionOperatingUnitType::CSV_SCAN:
+        return "CSV_SCAN";
       case ExecutionOperatingUnitType::INSERT:
         return "INSERT";
       case ExecutionOperatingUnitType::UPDATE:
@@ -18,6 +18,8 @@ class CompilerTest_SimpleIndexScanLimitDesendingTest_Test;
 class CompilerTest_SimpleAggregateTest_Test;
 class CompilerTest_CountStarTest_Test;
 class CompilerTest_SimpleSortTest_Test;
+class CompilerTest_SimpleSetOpTest_Test;
+class CompilerTest_SimpleWindowTest_Test;
 class CompilerTest_SimpleAggregateHavingTest_Test;
 class CompilerTest_SimpleHashJoinTest_Test;
 class CompilerTest_MultiWayHashJoinTest_Test;
@@ -119,6 +121,8 @@ class PipelineOperatingUnits {
   friend class terrier::execution::compiler::test::CompilerTest_SimpleAggregateTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_CountStarTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleSortTest_Test;
+  friend class terrier::execution::compiler::test::CompilerTest_SimpleSetOpTest_Test;
+  friend class terrier::execution::compiler::test::CompilerTest_SimpleWindowTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleAggregateHavingTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleHashJoinTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_MultiWayHashJoinTest_Test;
@@ -78,11 +78,13 @@ class OperatingUnitRecorder : planner::PlanVisitor {
   void Visit(const planner::IndexScanPlanNode *plan) override;
   void Visit(const planner::IndexJoinPlanNode *plan) override;
   void Visit(const planner::HashJoinPlanNode *plan) override;
+  void Visit(const planner::MergeJoinPlanNode *plan) override;
   void Visit(const planner::NestedLoopJoinPlanNode *plan) override;
   void Visit(const planner::LimitPlanNode *plan) override;
   void Visit(const planner::OrderByPlanNode *plan) override;
   void Visit(const planner::ProjectionPlanNode *plan) override;
   void Visit(const planner::AggregatePlanNode *plan) override;
+  void Visit(const planner::WindowPlanNode *plan) override;
 
   /**
    * Feature of plan currently being visited
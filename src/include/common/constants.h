@@ -11,6 +11,10 @@ struct Constants {
    * Block/RawBlock size, in bytes. Must be a power of 2.
    */
   static const uint32_t BLOCK_SIZE = 1 << 20;
+  /**
+   * Huge page size, in bytes. Must be a multiple of BLOCK_SIZE.
+   */
+  static const uint32_t HUGE_PAGE_SIZE = 1 << 21;
   /**
    * Buffer segment size, in bytes.
    */
@@ -21,6 +21,7 @@ namespace terrier {
 #define OPTIMIZER_EXCEPTION(msg) OptimizerException(msg, __FILE__, __LINE__)
 #define SYNTAX_EXCEPTION(msg) SyntaxException(msg, __FILE__, __LINE__)
 #define BINDER_EXCEPTION(msg) BinderException(msg, __FILE__, __LINE__)
+#define EXECUTION_EXCEPTION(msg) ExecutionException(msg, __FILE__, __LINE__)
 
 /**
  * Exception types
@@ -35,7 +36,8 @@ enum class ExceptionType : uint8_t {
   PARSER,
   SETTINGS,
   OPTIMIZER,
-  SYNTAX
+  SYNTAX,
+  EXECUTION
 };
 
 /**
@@ -84,6 +86,8 @@ class Exception : public std::runtime_error {
         return "Binder";
       case ExceptionType::OPTIMIZER:
         return "Optimizer";
+      case ExceptionType::EXECUTION:
+        return "Execution";
       default:
         return "Unknown exception type";
     }
@@ -135,5 +139,6 @@ DEFINE_EXCEPTION(OptimizerException, ExceptionType::OPTIMIZER);
 DEFINE_EXCEPTION(ConversionException, ExceptionType::CONVERSION);
 DEFINE_EXCEPTION(SyntaxException, ExceptionType::SYNTAX);
 DEFINE_EXCEPTION(BinderException, ExceptionType::BINDER);
+DEFINE_EXCEPTION(ExecutionException, ExceptionType::EXECUTION);
 
 }  // namespace terrier
@@ -29,6 +29,16 @@ namespace terrier::execution::ast {
   F(FilterLe, filterLe)                                                 \
   F(FilterLt, filterLt)                                                 \
   F(FilterNe, filterNe)                                                 \
+  F(FilterLike, filterLike)                                             \
+  F(FilterNotLike, filterNotLike)                                       \
+  F(FilterILike, filterILike)                                           \
+  F(FilterNotILike, filterNotILike)                                     \
+  F(FilterJoin, filterJoin)                                             \
+  F(FilterParam, filterParam)                                           \
+                                                                        \
+  /* Pattern Matching */                                                \
+  F(Like, like)                                                         \
+  F(ILike, ilike)                                                       \
                                                                         \
   /* Thread State Container */                                          \
   F(ExecutionContextGetMemoryPool, execCtxGetMem)                       \
@@ -47,8 +57,21 @@ namespace terrier::execution::ast {
   F(TableIterGetPCI, tableIterGetPCI)                                   \
   F(TableIterClose, tableIterClose)                                     \
   F(TableIterReset, tableIterReset)                                     \
+  F(TableIterRestrictRange, tableIterRestrictRange)                     \
+  F(TableIterRestrictRangeToParam, tableIterRestrictRangeToParam)       \
   F(TableIterParallel, iterateTableParallel)                            \
                                                                         \
+  /* CSV scans */                                                       \
+  F(CSVReaderInit, csvReaderInit)                                       \
+  F(CSVReaderAdvance, csvReaderAdvance)                                 \
+  F(CSVReaderGetBool, csvReaderGetBool)                                 \
+  F(CSVReaderGetInt, csvReaderGetInt)                                   \
+  F(CSVReaderGetReal, csvReaderGetReal)                                 \
+  F(CSVReaderGetDate, csvReaderGetDate)                                 \
+  F(CSVReaderGetString, csvReaderGetString)                             \
+  F(CSVReaderClose, csvReaderClose)                                     \
+  F(CSVReaderParallel, iterateCSVParallel)                              \
+                                                                        \
   /* PCI */                                                             \
   F(PCIIsFiltered, pciIsFiltered)                                       \
   F(PCIHasNext, pciHasNext)                                             \
@@ -93,10 +116,12 @@ namespace terrier::execution::ast {
   /* Aggregations */                                                    \
   F(AggHashTableInit, aggHTInit)                                        \
   F(AggHashTableInsert, aggHTInsert)                                    \
+  F(AggHashTableInsertPartitioned, aggHTInsertPartitioned)              \
   F(AggHashTableLookup, aggHTLookup)                                    \
   F(AggHashTableProcessBatch, aggHTProcessBatch)                        \
   F(AggHashTableMovePartitions, aggHTMoveParts)                         \
   F(AggHashTableParallelPartitionedScan, aggHTParallelPartScan)         \
+  F(AggHashTableBuildPartitions, aggHTBuildParts)                       \
   F(AggHashTableFree, aggHTFree)                                        \
   F(AggHashTableIterInit, aggHTIterInit)                                \
   F(AggHashTableIterHasNext, aggHTIterHasNext)                          \
@@ -116,6 +141,7 @@ namespace terrier::execution::ast {
   /* Joins */                                                           \
   F(JoinHashTableInit, joinHTInit)                                      \
   F(JoinHashTableInsert, joinHTInsert)                                  \
+  F(JoinHashTableAddFilterKey, joinHTAddFilterKey)                      \
   F(JoinHashTableIterInit, joinHTIterInit)                              \
   F(JoinHashTableIterHasNext, joinHTIterHasNext)                        \
   F(JoinHashTableIterGetRow, joinHTIterGetRow)                          \
@@ -133,12 +159,34 @@ namespace terrier::execution::ast {
   F(SorterSortParallel, sorterSortParallel)                             \
   F(SorterSortTopKParallel, sorterSortTopKParallel)                     \
   F(SorterFree, sorterFree)                                             \
+  F(SorterGetTupleCount, sorterGetTupleCount)                           \
+  F(SorterGetTupleAt, sorterGetTupleAt)                                 \
   F(SorterIterInit, sorterIterInit)                                     \
   F(SorterIterHasNext, sorterIterHasNext)                               \
   F(SorterIterNext, sorterIterNext)                                     \
   F(SorterIterGetRow, sorterIterGetRow)                                 \
   F(SorterIterClose, sorterIterClose)                                   \
                                                                         \
+  /* Window functions */                                                \
+  F(WindowInit, windowInit)                                             \
+  F(WindowFree, windowFree)                                             \
+  F(WindowFrameInit, windowFrameInit)                                   \
+  F(WindowIterInit, windowIterInit)                                     \
+  F(WindowIterHasNext, windowIterHasNext)                               \
+  F(WindowIterNext, windowIterNext)                                     \
+  F(WindowIterGetRow, windowIterGetRow)                                 \
+  F(WindowIterIsPartitionStart, windowIterIsPartitionStart)             \
+  F(WindowIterGetRowNumber, windowIterGetRowNumber)                     \
+  F(WindowIterGetRank, windowIterGetRank)                               \
+  F(WindowIterGetDenseRank, windowIterGetDenseRank)                     \
+  F(WindowIterGetFrameBegin, windowIterGetFrameBegin)                   \
+  F(WindowIterGetFrameEnd, windowIterGetFrameEnd)                       \
+  F(WindowIterClose, windowIterClose)                                   \
+  F(WindowTreeInit, windowTreeInit)                                     \
+  F(WindowTreeBuild, windowTreeBuild)                                   \
+  F(WindowTreeQuery, windowTreeQuery)                                   \
+  F(WindowTreeFree, windowTreeFree)                                     \
+                                                                        \
   /* Trig */                                                            \
   F(ACos, acos)                                                         \
   F(ASin, asin)                                                         \
@@ -151,6 +199,7 @@ namespace terrier::execution::ast {
                                                                         \
   /* Generic */                                                         \
   F(SizeOf, sizeOf)                                                     \
+  F(OffsetOf, offsetOf)                                                 \
   F(PtrCast, ptrCast)                                                   \
                                                                         \
   /* Output Buffer */                                                   \
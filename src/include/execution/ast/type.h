@@ -58,6 +58,7 @@ class Context;
   NON_PRIM(AggregationHashTableIterator, terrier::execution::sql::AggregationHashTableIterator) \
   NON_PRIM(AggOverflowPartIter, terrier::execution::sql::AggregationOverflowPartitionIterator)  \
   NON_PRIM(BloomFilter, terrier::execution::sql::BloomFilter)                                   \
+  NON_PRIM(CSVReader, terrier::execution::sql::CSVReader)                                       \
   NON_PRIM(ExecutionContext, terrier::execution::exec::ExecutionContext)                        \
   NON_PRIM(FilterManager, terrier::execution::sql::FilterManager)                               \
   NON_PRIM(HashTableEntry, terrier::execution::sql::HashTableEntry)                             \
@@ -71,6 +72,20 @@ class Context;
   NON_PRIM(ThreadStateContainer, terrier::execution::sql::ThreadStateContainer)                 \
   NON_PRIM(ProjectedColumnsIterator, terrier::execution::sql::ProjectedColumnsIterator)         \
   NON_PRIM(IndexIterator, terrier::execution::sql::IndexIterator)                               \
+  NON_PRIM(WindowFrame, terrier::execution::sql::WindowFrame)                                   \
+  NON_PRIM(WindowIterator, terrier::execution::sql::WindowIterator)                             \
+  NON_PRIM(WindowOperator, terrier::execution::sql::WindowOperator)                             \
+                                                                                                \
+  /* Window segment tree types (if you add, remember to update BuiltinType) */                  \
+  NON_PRIM(CountWindowTree, terrier::execution::sql::CountWindowTree)                           \
+  NON_PRIM(IntegerAvgWindowTree, terrier::execution::sql::AvgWindowTree)                        \
+  NON_PRIM(IntegerMaxWindowTree, terrier::execution::sql::IntegerMaxWindowTree)                 \
+  NON_PRIM(IntegerMinWindowTree, terrier::execution::sql::IntegerMinWindowTree)                 \
+  NON_PRIM(IntegerSumWindowTree, terrier::execution::sql::IntegerSumWindowTree)                 \
+  NON_PRIM(RealAvgWindowTree, terrier::execution::sql::AvgWindowTree)                           \
+  NON_PRIM(RealMaxWindowTree, terrier::execution::sql::RealMaxWindowTree)                       \
+  NON_PRIM(RealMinWindowTree, terrier::execution::sql::RealMinWindowTree)                       \
+  NON_PRIM(RealSumWindowTree, terrier::execution::sql::RealSumWindowTree)                       \
                                                                                                 \
   /* SQL Aggregate types (if you add, remember to update BuiltinType) */                        \
   NON_PRIM(CountAggregate, terrier::execution::sql::CountAggregate)                             \
@@ -282,6 +297,12 @@ class Type : public util::RegionObject {
    */
   bool IsSqlAggregatorType() const;
 
+  /**
+   * Checks whether this is a window segment tree type
+   * @return true iff this is a window segment tree type.
+   */
+  bool IsSqlWindowTreeType() const;
+
   /**
    * @return a type that is a pointer to the current type
    */
@@ -390,6 +411,13 @@ class BuiltinType : public Type {
    */
   bool IsSqlAggregatorType() const { return Kind::CountAggregate <= GetKind() && GetKind() <= Kind::RealSumAggregate; }
 
+  /**
+   * Is this type a window segment tree type? IntegerSumWindowTree, CountWindowTree ...
+   */
+  bool IsSqlWindowTreeType() const {
+    return Kind::CountWindowTree <= GetKind() && GetKind() <= Kind::RealSumWindowTree;
+  }
+
   /**
    * @return the kind of this builtin
    */
@@ -771,4 +799,11 @@ inline bool Type::IsSqlAggregatorType() const {
   return false;
 }
 
+inline bool Type::IsSqlWindowTreeType() const {
+  if (auto *builtin_type = SafeAs<BuiltinType>()) {
+    return builtin_type->IsSqlWindowTreeType();
+  }
+  return false;
+}
+
 }  // namespace terrier::execution::ast
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "common/hash_util.h"
+#include "common/macros.h"
+#include "common/spin_latch.h"
+
+namespace terrier::execution {
+
+class ExecutableQuery;
+
+/**
+ * CompiledQueryCache keeps generated queries alive for the lifetime of the process so that a plan with the same
+ * fingerprint as an earlier one can skip code generation and compilation. Fingerprints and keys come from
+ * compiler::ConstantLifter, and the cached code reads the lifted constants from the query parameters. Entries are
+ * looked up by fingerprint, and only hit if their full key matches too, so colliding plans never share code.
+ *
+ * The cache is bounded by the total code size of its queries and evicts the least recently used ones first. Cached
+ * code refers to catalog objects by oid, so the cache must be cleared whenever the schema changes.
+ *
+ * The cache is thread-safe. Queries handed out stay valid after they are evicted.
+ */
+class CompiledQueryCache {
+ public:
+  /**
+   * Create a cache
+   * @param capacity maximum total code size in bytes of the cached queries. 0 disables caching.
+   */
+  explicit CompiledQueryCache(uint64_t capacity) : capacity_(capacity) {}
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(CompiledQueryCache);
+
+  /**
+   * Look up a query and mark it as most recently used
+   * @param fingerprint fingerprint of the plan
+   * @param key key of the plan
+   * @return the cached query, or nullptr if there is none for this key
+   */
+  std::shared_ptr<ExecutableQuery> Get(common::hash_t fingerprint, const std::string &key);
+
+  /**
+   * Add a query, evicting least recently used queries until the cache is within its capacity again. A query that is
+   * larger than the whole cache is not added. The query replaces any entry with the same fingerprint.
+   * @param fingerprint fingerprint of the plan
+   * @param key key of the plan
+   * @param query the compiled query
+   * @param size code size of the query in bytes
+   */
+  void Put(common::hash_t fingerprint, std::string key, std::shared_ptr<ExecutableQuery> query, uint64_t size);
+
+  /**
+   * Change the capacity of the cache, evicting queries if it shrinks
+   * @param capacity maximum total code size in bytes of the cached queries. 0 disables caching.
+   */
+  void SetCapacity(uint64_t capacity);
+
+  /**
+   * Drop every cached query
+   */
+  void Clear();
+
+  /**
+   * @return number of cached queries
+   */
+  uint64_t NumEntries() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return entries_.size();
+  }
+
+  /**
+   * @return total code size in bytes of the cached queries
+   */
+  uint64_t Size() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return size_;
+  }
+
+ private:
+  struct Entry {
+    common::hash_t fingerprint_;
+    std::string key_;
+    std::shared_ptr<ExecutableQuery> query_;
+    uint64_t size_;
+  };
+
+  // Evict least recently used entries until the cache fits in its capacity. The latch must be held.
+  void Evict();
+
+  mutable common::SpinLatch latch_;
+  uint64_t capacity_;
+  uint64_t size_ = 0;
+  // Entries from most to least recently used
+  std::list<Entry> lru_;
+  std::unordered_map<common::hash_t, std::list<Entry>::iterator> entries_;
+};
+
+}  // namespace terrier::execution
@@ -22,6 +22,7 @@
 
 namespace terrier::execution::compiler {
 
+class ConstantLifter;
 class FunctionBuilder;
 
 /**
@@ -37,8 +38,9 @@ class CodeGen {
    * Constructor
    * TODO(Amadou): This implicitly ties this object to a transaction. May not be what we want.
    * @param exec_ctx The execution context
+   * @param lifter if given, the constants it lifted are read from the query parameters instead of embedded in the code
    */
-  explicit CodeGen(exec::ExecutionContext *exec_ctx);
+  explicit CodeGen(exec::ExecutionContext *exec_ctx, const ConstantLifter *lifter = nullptr);
 
   /**
    * Prevent copy and move
@@ -80,6 +82,11 @@ class CodeGen {
    */
   exec::ExecutionContext *ExecCtx() { return exec_ctx_; }
 
+  /**
+   * @return the constant lifter of the plan, or nullptr if constants are embedded in the code
+   */
+  const ConstantLifter *Lifter() const { return lifter_; }
+
   /**
    * @return the error reporter
    */
@@ -100,6 +107,16 @@ class CodeGen {
    */
   ast::Identifier GetExecCtxVar() { return exec_ctx_var_; }
 
+  /**
+   * @return the thread state variable
+   */
+  ast::Identifier GetThreadStateVar() { return thread_state_var_; }
+
+  /**
+   * @return whether the query may use parallel pipelines
+   */
+  bool IsParallelExecutionEnabled() { return exec_ctx_ != nullptr && exec_ctx_->IsParallelExecutionEnabled(); }
+
   /**
    * @return PipelineOperatingUnits instance
    */
@@ -161,6 +178,13 @@ class CodeGen {
    */
   ast::Expr *GetStateMemberPtr(ast::Identifier ident);
 
+  /**
+   * Return a pointer to a thread state member
+   * @param ident identifier of the member
+   * @return the expression &threadState.ident
+   */
+  ast::Expr *GetThreadStateMemberPtr(ast::Identifier ident);
+
   /**
    * Creates a field declaration
    * @param field_name name of field
@@ -185,6 +209,13 @@ class CodeGen {
    */
   ast::Expr *PeekValue(const terrier::type::TransientValue &transient_val);
 
+  /**
+   * @param type type of the parameter
+   * @param param_idx index of the parameter in the execution context
+   * @return the value of the query parameter, read at runtime
+   */
+  ast::Expr *GetParam(terrier::type::TypeId type, uint32_t param_idx);
+
   /**
    * Convert from terrier type to TPL expr type
    * @param type The terrier type
@@ -209,6 +240,11 @@ class CodeGen {
    */
   ast::Expr *AggregateType(terrier::parser::ExpressionType agg_type, terrier::type::TypeId ret_type);
 
+  /**
+   * @return the tpl type of the segment tree that computes an aggregate over window frames.
+   */
+  ast::Expr *WindowTreeType(terrier::parser::ExpressionType agg_type, terrier::type::TypeId ret_type);
+
   /**
    * @return a pointer type with the given base type (i.e *base_type)
    */
@@ -472,6 +508,14 @@ class CodeGen {
    */
   ast::Expr *SizeOf(ast::Identifier type_name);
 
+  /**
+   * Call offsetOf(type, member)
+   * @param type_name The struct type.
+   * @param member The member whose offset is computed.
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *OffsetOf(ast::Identifier type_name, ast::Identifier member);
+
   /**
    * Call indexIteratorInit(&iter, execCtx, table_oid, index_oid, col_oids)
    * @param iter The identifier of the index iterator.
@@ -534,6 +578,14 @@ class CodeGen {
    */
   ast::Expr *BuiltinCall(ast::Builtin builtin, std::vector<ast::Expr *> &&params);
 
+  /**
+   * Make a call to a generated function with the given arguments.
+   * @param fn_name name of the function to call
+   * @param params parameters of the function
+   * @return The expression corresponding to the function call.
+   */
+  ast::Expr *Call(ast::Identifier fn_name, std::vector<ast::Expr *> &&params);
+
   /**
    * This is for functions that take one identifier or a pointer to an identifier as their argument.
    * @param builtin builtin function to call
@@ -553,6 +605,15 @@ class CodeGen {
    */
   ast::Expr *HTInitCall(ast::Builtin builtin, ast::Identifier object, ast::Identifier struct_type);
 
+  /**
+   * Same as above, but takes a pointer to the object to initialize (e.g. a thread-local hash table).
+   * @param builtin builtin function to call
+   * @param object_ptr pointer to the hash table to initialize.
+   * @param struct_type identifier of the build struct.
+   * @return The expression corresponding to the builtin call initializing the given hash table.
+   */
+  ast::Expr *HTInitCall(ast::Builtin builtin, ast::Expr *object_ptr, ast::Identifier struct_type);
+
   /**
    * This is for function this take one state argument.
    * @param builtin builtin function to call
@@ -586,6 +647,7 @@ class CodeGen {
   std::unique_ptr<ast::Context> ast_ctx_;
   ast::AstNodeFactory factory_;
   exec::ExecutionContext *exec_ctx_;
+  const ConstantLifter *lifter_;
   std::unique_ptr<brain::PipelineOperatingUnits> pipeline_operating_units_;
 
   // Identifiers that are always needed
@@ -595,6 +657,8 @@ class CodeGen {
   ast::Identifier state_var_;
   // Identifier of the execution context variable
   ast::Identifier exec_ctx_var_;
+  // Identifier of the thread state variable in parallel pipelines
+  ast::Identifier thread_state_var_;
   /**
    * Identifier of the main function.
    * Signature: (execCtx: *ExecutionContext) -> int32
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/hash_util.h"
+#include "common/json.h"
+#include "common/managed_pointer.h"
+#include "planner/plannodes/plan_visitor.h"
+#include "type/transient_value.h"
+
+namespace terrier::parser {
+class AbstractExpression;
+class ConstantValueExpression;
+}  // namespace terrier::parser
+
+namespace terrier::planner {
+class AbstractPlanNode;
+}  // namespace terrier::planner
+
+namespace terrier::execution::compiler {
+
+/**
+ * ConstantLifter turns the constants of a physical plan into query parameters, so that plans which only differ in
+ * their constants can share generated code.
+ *
+ * The plan is walked in a fixed order and every constant that can be read through a @getParam builtin is assigned a
+ * parameter slot. Code generated for a plan with lifted constants reads the slots from the ExecutionContext instead of
+ * embedding the values, and runs correctly for any plan with the same fingerprint given that plan's Parameters().
+ */
+class ConstantLifter : planner::PlanVisitor {
+ public:
+  /**
+   * Walk the given plan and lift its constants
+   * @param plan the physical plan
+   */
+  explicit ConstantLifter(common::ManagedPointer<planner::AbstractPlanNode> plan);
+
+  /**
+   * @return false if the plan contains nodes or expressions that cannot be parameterized. The other methods are only
+   * meaningful when this returns true.
+   */
+  bool IsCacheable() const { return cacheable_; }
+
+  /**
+   * @return hash of the plan in which every lifted constant only contributes its type and slot
+   */
+  common::hash_t Fingerprint() const { return fingerprint_; }
+
+  /**
+   * @return serialization of the plan in which every lifted constant only contributes its type and slot. Plans with
+   * equal keys can share code. Unlike the fingerprint, the key does not collide for different plans.
+   */
+  const std::string &Key() const { return key_; }
+
+  /**
+   * @return the values of the lifted constants, in slot order
+   */
+  const std::vector<type::TransientValue> &Parameters() const { return values_; }
+
+  /**
+   * @return tables modified by the plan. The generated code maintains the indexes these tables had when it was
+   * generated, so their current indexes must be part of the cache key.
+   */
+  const std::vector<catalog::table_oid_t> &ModifiedTables() const { return modified_tables_; }
+
+  /**
+   * @param expr an expression of the plan
+   * @return the parameter slot of the expression, or NOT_LIFTED if it is not a lifted constant
+   */
+  uint32_t SlotOf(const parser::AbstractExpression *expr) const {
+    const auto it = slots_.find(expr);
+    return it == slots_.end() ? NOT_LIFTED : it->second;
+  }
+
+  /**
+   * Slot of expressions that were not lifted
+   */
+  static constexpr uint32_t NOT_LIFTED = UINT32_MAX;
+
+ private:
+  void VisitNode(common::ManagedPointer<planner::AbstractPlanNode> plan);
+  void VisitExpression(common::ManagedPointer<parser::AbstractExpression> expr);
+  void VisitRoot(common::ManagedPointer<parser::AbstractExpression> expr);
+  void VisitIndexColumns(
+      const std::unordered_map<catalog::indexkeycol_oid_t, common::ManagedPointer<parser::AbstractExpression>> &cols);
+  template <typename T>
+  void AddExtra(const T &value) {
+    extras_ = common::HashUtil::CombineHashes(extras_, common::HashUtil::Hash(value));
+    extra_values_.emplace_back(value);
+  }
+  void ComputeFingerprint(common::ManagedPointer<planner::AbstractPlanNode> plan);
+
+  void Visit(const planner::AggregatePlanNode *plan) override;
+  void Visit(const planner::CSVScanPlanNode *plan) override;
+  void Visit(const planner::DeletePlanNode *plan) override;
+  void Visit(const planner::HashJoinPlanNode *plan) override;
+  void Visit(const planner::IndexJoinPlanNode *plan) override;
+  void Visit(const planner::IndexScanPlanNode *plan) override;
+  void Visit(const planner::InsertPlanNode *plan) override;
+  void Visit(const planner::LimitPlanNode *plan) override;
+  void Visit(const planner::NestedLoopJoinPlanNode *plan) override;
+  void Visit(const planner::OrderByPlanNode *plan) override;
+  void Visit(const planner::ProjectionPlanNode *plan) override;
+  void Visit(const planner::SeqScanPlanNode *plan) override;
+  void Visit(const planner::UpdatePlanNode *plan) override;
+
+  // Lifted constants and their values in slot order
+  std::vector<common::ManagedPointer<parser::ConstantValueExpression>> constants_;
+  std::vector<type::TransientValue> values_;
+  std::unordered_map<const parser::AbstractExpression *, uint32_t> slots_;
+  // The slot of every constant occurrence in walk order, or NOT_LIFTED. Two plans with the same plan hash but
+  // different lifted positions must not share code.
+  std::vector<uint32_t> occurrences_;
+  // Expressions and node properties that the plan nodes leave out of their own Hash()
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> roots_;
+  common::hash_t extras_{0};
+  std::vector<nlohmann::json> extra_values_;
+  std::vector<catalog::table_oid_t> modified_tables_;
+  // Set by the Visit() overloads of supported plan nodes
+  bool visited_{false};
+  bool cacheable_{true};
+  common::hash_t fingerprint_{0};
+  std::string key_;
+};
+
+}  // namespace terrier::execution::compiler
@@ -29,7 +29,7 @@ class AggregateBottomTranslator : public OperatorTranslator {
   // Declare the values and payload structs
   void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
 
-  // Create the key check functions.
+  // Create the key check functions, and the function that merges the partitions of the global hash table.
   void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
 
   // Initialize all hash tables.
@@ -38,6 +38,21 @@ class AggregateBottomTranslator : public OperatorTranslator {
   // Free all hash tables.
   void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
 
+  // Add the thread-local hash table
+  void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) override;
+
+  // Initialize the thread-local hash table
+  void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Free the thread-local hash table
+  void InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Move the partitions of the thread-local hash tables into the global one
+  void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) override;
+
+  // Distinct aggregates use hash tables that cannot be merged yet.
+  bool IsParallelizable() override;
+
   void Produce(FunctionBuilder *builder) override;
   void Abort(FunctionBuilder *builder) override;
   void Consume(FunctionBuilder *builder) override;
@@ -79,12 +94,33 @@ class AggregateBottomTranslator : public OperatorTranslator {
    */
   ast::Expr *GetAggregateOutput(uint32_t idx);
 
+  // fun partialKeyCheck(aht_entry: *AHTStruct, partial: *AHTStruct) -> bool {...}
+  void GenPartialKeyCheck(util::RegionVector<ast::Decl *> *decls);
+
+  // fun mergePartitions(state: *State, agg_partition: *AggregationHashTable, part_iter: *AggOverflowPartIter) {...}
+  void GenMergePartitions(util::RegionVector<ast::Decl *> *decls);
+
+  // Call @aggHTBuildParts(&state.aht, state, mergePartitions)
+  void GenBuildPartitions(FunctionBuilder *builder);
+
   // Make the top translator a friend class.
   friend class AggregateTopTranslator;
 
  private:
   const planner::AggregatePlanNode *op_;
   AggregateHelper helper_;
+
+  // Structs, Functions, and local variables needed to merge partitions.
+  ast::Identifier partial_key_check_;
+  ast::Identifier merge_partitions_fn_;
+  ast::Identifier partition_;
+  ast::Identifier part_iter_;
+  ast::Identifier partial_;
+  ast::Identifier partial_hash_;
+
+  // Whether the top translator builds and scans the partitions of the global hash table in parallel. Otherwise, they
+  // are all built at the end of this pipeline. Set by the top translator.
+  bool partitions_scanned_in_parallel_{false};
 };
 
 /**
@@ -103,10 +139,13 @@ class AggregateTopTranslator : public OperatorTranslator {
       : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_ITERATE),
         op_(op),
         bottom_(dynamic_cast<AggregateBottomTranslator *>(bottom)),
-        agg_iterator_("agg_iter") {}
+        agg_iterator_("agg_iter"),
+        partition_(codegen->NewIdentifier("agg_partition")) {}
 
-  // Does nothing
-  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+  // Let the bottom know whether this translator scans the partitions in parallel
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {
+    bottom_->partitions_scanned_in_parallel_ = ScansPartitionsInParallel();
+  }
 
   // Does nothing
   void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
@@ -124,6 +163,15 @@ class AggregateTopTranslator : public OperatorTranslator {
   void Abort(FunctionBuilder *builder) override;
   void Consume(FunctionBuilder *builder) override;
 
+  // A parallel build leaves the aggregates in partitions, which can be scanned in parallel.
+  bool IsParallelizable() override { return bottom_->parallelized_pipeline_; }
+
+  // Each worker scans the table built over one partition
+  ast::FieldDecl *GetParallelWorkParam() override;
+
+  // @aggHTParallelPartScan(&state.aht, state, &state.thread_states, work_fn)
+  void LaunchParallelWork(FunctionBuilder *builder, ast::Expr *thread_states, ast::Identifier work_fn) override;
+
   // Let the bottom translator handle these call
   ast::Expr *GetOutput(uint32_t attr_idx) override;
   ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
@@ -158,11 +206,15 @@ class AggregateTopTranslator : public OperatorTranslator {
   // Return true iff there is a having clause
   bool GenHaving(FunctionBuilder *builder);
 
+  // Whether this translator drives a parallel pipeline over the partitions of the hash table
+  bool ScansPartitionsInParallel() const { return parallelized_pipeline_ && child_translator_ == nullptr; }
+
   const planner::AggregatePlanNode *op_;
   // Used to access member of the resulting aggregate
   AggregateBottomTranslator *bottom_;
 
   // Structs, Functions, and local variables needed.
   ast::Identifier agg_iterator_;
+  ast::Identifier partition_;
 };
 }  // namespace terrier::execution::compiler
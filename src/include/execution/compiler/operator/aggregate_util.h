@@ -147,8 +147,9 @@ class AggregateHelper {
   /**
    * Generate code to construct new hash table entries
    * @param builder Current function builder
+   * @param thread_local_ht Whether the global hash table lives in the thread state instead of the query state.
    */
-  void GenConstruct(FunctionBuilder *builder);
+  void GenConstruct(FunctionBuilder *builder, bool thread_local_ht = false);
 
   /**
    * Fill the values that will be used to aggregate and group
@@ -160,8 +161,9 @@ class AggregateHelper {
   /**
    * Unconditionally advance non distinct aggregates.
    * @param builder Current function builder.
+   * @param thread_local_aggs Whether static aggregates live in the thread state instead of the query state.
    */
-  void GenAdvanceNonDistinct(FunctionBuilder *builder);
+  void GenAdvanceNonDistinct(FunctionBuilder *builder, bool thread_local_aggs = false);
 
   /**
    * @param term_idx Index of the aggregate.
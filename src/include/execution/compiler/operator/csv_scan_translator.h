@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include "execution/compiler/operator/operator_translator.h"
+#include "planner/plannodes/csv_scan_plan_node.h"
+
+namespace terrier::execution::compiler {
+
+/**
+ * CSV Scan Translator
+ * Column value expressions over a CSV scan refer to fields by position: column oid i is the i-th field of each
+ * row, and its type is the i-th entry of the plan's value types.
+ */
+class CSVScanTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op The plan node
+   * @param codegen The code generator
+   */
+  CSVScanTranslator(const terrier::planner::CSVScanPlanNode *op, CodeGen *codegen);
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+
+  // Should not be called here
+  void Consume(FunctionBuilder *builder) override { UNREACHABLE("CSV scans are always pipeline sources"); }
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Does nothing
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  // Should not be called here
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override {
+    UNREACHABLE("CSV scan nodes should use column value expressions");
+  }
+
+  // Each thread can parse its own chunks of the file.
+  bool IsParallelizable() override { return true; }
+
+  // The parallel worker receives csv: *CSVReader
+  ast::FieldDecl *GetParallelWorkParam() override;
+
+  // Calls @iterateCSVParallel
+  void LaunchParallelWork(FunctionBuilder *builder, ast::Expr *thread_states, ast::Identifier work_fn) override;
+
+  // Used by column value expression to get a field.
+  ast::Expr *GetTableColumn(const catalog::col_oid_t &col_oid) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // for (@csvReaderAdvance(&csv)) {...}
+  void DoFileScan(FunctionBuilder *builder);
+
+  // The file name, followed by the delimiter, quote and escape characters
+  std::vector<ast::Expr *> FileArgs();
+
+ private:
+  const planner::CSVScanPlanNode *op_;
+  ast::Identifier reader_;
+};
+
+}  // namespace terrier::execution::compiler
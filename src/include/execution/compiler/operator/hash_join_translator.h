@@ -2,6 +2,7 @@
 
 #include "execution/compiler/expression/expression_translator.h"
 #include "execution/compiler/operator/operator_translator.h"
+#include "parser/expression/column_value_expression.h"
 #include "planner/plannodes/hash_join_plan_node.h"
 
 namespace terrier::execution::compiler {
@@ -41,12 +42,26 @@ class HashJoinLeftTranslator : public OperatorTranslator {
   // Call @joinHTFree on the hash table
   void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
 
+  // Add a thread-local hash table
+  void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) override;
+
+  // Call @joinHTInit on the thread-local hash table
+  void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Call @joinHTFree on the thread-local hash table
+  void InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Merge the thread-local hash tables into the global one
+  void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) override;
+
   ast::Expr *GetOutput(uint32_t attr_idx) override;
 
   ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
 
   const planner::AbstractPlanNode *Op() override { return op_; }
 
+  bool IsParallelizable() override { return true; }
+
  private:
   friend class HashJoinRightTranslator;
 
@@ -68,9 +83,19 @@ class HashJoinLeftTranslator : public OperatorTranslator {
   // Build the hash table
   void GenBuildCall(FunctionBuilder *builder);
 
+  // Find the scanned column the probe side can apply the runtime filter to, if any
+  const parser::ColumnValueExpression *FindProbeFilterColumn() const;
+
+  // Add the join key to the runtime filter
+  void GenAddFilterKey(FunctionBuilder *builder);
+
   // The hash join plan node
   const planner::HashJoinPlanNode *op_;
 
+  // The probe-side column that is filtered by the runtime filter built from
+  // the join keys, or nullptr if this join does not use a runtime filter
+  const parser::ColumnValueExpression *probe_filter_col_;
+
   // Structs, functions, and locals
   static constexpr const char *LEFT_ATTR_NAME = "left_attr";
   ast::Identifier hash_val_;
@@ -122,6 +147,9 @@ class HashJoinRightTranslator : public OperatorTranslator {
 
   const planner::AbstractPlanNode *Op() override { return op_; }
 
+  // Left semi joins write the mark flag of the build row, so they cannot probe in parallel.
+  bool IsParallelizable() override { return op_->GetLogicalJoinType() != planner::LogicalJoinType::LEFT_SEMI; }
+
  private:
   // Returns a probe value
   ast::Expr *GetProbeValue(uint32_t idx);
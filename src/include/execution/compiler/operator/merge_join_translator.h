@@ -0,0 +1,179 @@
+#pragma once
+#include "execution/compiler/expression/expression_translator.h"
+#include "execution/compiler/operator/operator_translator.h"
+#include "planner/plannodes/merge_join_plan_node.h"
+
+namespace terrier::execution::compiler {
+
+// Forward declare for friendship
+class MergeJoinRightTranslator;
+
+/**
+ * Left translator for merge joins.
+ * Materializes the left input into a sorter ordered on the left join keys. Tuples with a NULL key never match, so
+ * they are not materialized. When the left pipeline is serial and its input is already ordered, e.g. because it comes
+ * from an index scan, sorting only checks the order.
+ */
+class MergeJoinLeftTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op The plan node
+   * @param codegen The code generator
+   */
+  MergeJoinLeftTranslator(const terrier::planner::MergeJoinPlanNode *op, CodeGen *codegen);
+
+  // Insert tuples into the sorter
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  // Add the sorter
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override;
+
+  // Declare MergeRow struct
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Create the comparison function of the sorter
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Call @sorterInit on the sorter
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override;
+
+  // Call @sorterFree on the sorter
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
+
+  // Add a thread-local sorter
+  void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) override;
+
+  // Call @sorterInit on the thread-local sorter
+  void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Call @sorterFree on the thread-local sorter
+  void InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Sort the thread-local sorters into the global one
+  void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) override;
+
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+  bool IsParallelizable() override { return true; }
+
+ private:
+  friend class MergeJoinRightTranslator;
+
+  // Return the member of the object at the given index
+  ast::Expr *GetAttribute(ast::Identifier object, uint32_t attr_idx);
+
+  // Make the @sorterInit call
+  ast::Expr *SorterInitCall(ast::Expr *sorter);
+
+  // Generate the comparisons of the left keys in the comparison function
+  void GenComparisons(FunctionBuilder *builder);
+
+  // The merge join plan node
+  const planner::MergeJoinPlanNode *op_;
+
+  // Which row GetChildOutput reads from: the child's output, or either side of the comparison function
+  enum class CurrentRow { Child, Lhs, Rhs };
+  CurrentRow current_row_{CurrentRow::Child};
+
+  // Structs, functions, and locals
+  static constexpr const char *LEFT_ATTR_NAME = "left_attr";
+  ast::Identifier sorter_;
+  ast::Identifier merge_struct_;
+  ast::Identifier merge_row_;
+  ast::Identifier comp_fn_;
+  ast::Identifier comp_lhs_;
+  ast::Identifier comp_rhs_;
+};
+
+/**
+ * Right translator for merge joins.
+ * The right input arrives in ascending order of the right join keys. Two cursors into the sorted left tuples delimit
+ * the tuples whose keys compare to the current right keys as the join requires. Since both inputs are ordered, the
+ * cursors only move forward, and the whole join walks each input once plus the size of the output. The right
+ * pipeline has to run serially so that the right tuples are seen in order.
+ */
+class MergeJoinRightTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op The plan node
+   * @param codegen The code generator
+   * @param left The corresponding left translator
+   */
+  MergeJoinRightTranslator(const terrier::planner::MergeJoinPlanNode *op, CodeGen *codegen, OperatorTranslator *left);
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Declare the MergeKeys struct
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Declare the function comparing a left tuple to the right keys
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Does nothing (left operator already initialized the sorter)
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing (left operator already freed the sorter)
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  // Get the output at idx
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  // Dispatch the call to the correct child
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // Return the member of the keys struct at the given index
+  ast::Expr *GetKey(uint32_t key_idx);
+
+  // Declare the number of left tuples and the two cursors
+  void DeclareCursors(FunctionBuilder *builder);
+
+  // Fill the keys struct with the right keys
+  void FillKeys(FunctionBuilder *builder);
+
+  // Check that none of the right keys is NULL
+  ast::Expr *KeysNotNull();
+
+  // Move a cursor past the left tuples that compare to the right keys with the given operator
+  void GenAdvanceCursor(FunctionBuilder *builder, ast::Identifier cursor, parsing::Token::Type comparison);
+
+  // Loop over the left tuples between the two cursors
+  void GenMatchLoop(FunctionBuilder *builder);
+
+  // Declare the current left tuple
+  void DeclareMatch(FunctionBuilder *builder);
+
+  // Complete the comparison function
+  void GenKeyComparison(FunctionBuilder *builder);
+
+  // The merge join plan node
+  const planner::MergeJoinPlanNode *op_;
+  // The left translator
+  MergeJoinLeftTranslator *left_;
+
+  // Structs, functions, and locals
+  static constexpr const char *KEY_ATTR_NAME = "key";
+  ast::Identifier keys_struct_;
+  ast::Identifier keys_;
+  ast::Identifier comp_fn_;
+  ast::Identifier num_rows_;
+  ast::Identifier lo_;
+  ast::Identifier hi_;
+  ast::Identifier match_idx_;
+};
+}  // namespace terrier::execution::compiler
@@ -83,15 +83,66 @@ class OperatorTranslator : public ExpressionEvaluator {
    * @param parent_translator the parent translator
    * @param vectorize whether the pipeline is vectorized
    * @param parallelize whether the pipeline is paralellized
+   * @param thread_state_type identifier of the pipeline's thread state struct (only valid if parallelized)
    */
   void Prepare(OperatorTranslator *child_translator, OperatorTranslator *parent_translator, bool vectorize,
-               bool parallelize) {
+               bool parallelize, ast::Identifier thread_state_type) {
     child_translator_ = child_translator;
     parent_translator_ = parent_translator;
     vectorized_pipeline_ = vectorize;
     parallelized_pipeline_ = parallelize;
+    thread_state_type_ = thread_state_type;
   }
 
+  /**
+   * Add fields to the thread state struct of a parallel pipeline.
+   * Only called when the pipeline is parallelized. Most operators do not need thread-local state.
+   * @param thread_state_fields list of fields of the thread state struct
+   */
+  virtual void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) {}
+
+  /**
+   * Add statements to the function that initializes a thread state of a parallel pipeline.
+   * @param thread_state_stmts list of statements in the thread state init function
+   */
+  virtual void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) {}
+
+  /**
+   * Add statements to the function that destroys a thread state of a parallel pipeline.
+   * @param thread_state_stmts list of statements in the thread state teardown function
+   */
+  virtual void InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) {}
+
+  /**
+   * Declare helper functions that take the thread state of a parallel pipeline (e.g. merge functions).
+   * Called after the thread state struct is declared.
+   * @param decls list of top level declarations
+   */
+  virtual void InitializeThreadStateHelperFunctions(util::RegionVector<ast::Decl *> *decls) {}
+
+  /**
+   * Only called on the source of a parallel pipeline.
+   * @return the parameter through which each parallel worker receives its share of the input
+   */
+  virtual ast::FieldDecl *GetParallelWorkParam() { UNREACHABLE("This operator cannot drive a parallel pipeline"); }
+
+  /**
+   * Only called on the source of a parallel pipeline. Generate the call that runs the worker function in parallel.
+   * @param builder builder of the pipeline function
+   * @param thread_states pointer to the pipeline's thread state container
+   * @param work_fn name of the worker function
+   */
+  virtual void LaunchParallelWork(FunctionBuilder *builder, ast::Expr *thread_states, ast::Identifier work_fn) {
+    UNREACHABLE("This operator cannot drive a parallel pipeline");
+  }
+
+  /**
+   * Generate code that runs once all parallel workers are done (e.g. merging thread-local hash tables).
+   * @param builder builder of the pipeline function
+   * @param thread_states pointer to the pipeline's thread state container
+   */
+  virtual void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) {}
+
   /**
    * @return Whether this operator is vectorizable
    */
@@ -201,5 +252,10 @@ class OperatorTranslator : public ExpressionEvaluator {
    * Whether the whole pipeline is produced in parallel mode
    */
   bool parallelized_pipeline_{false};
+
+  /**
+   * Identifier of the pipeline's thread state struct
+   */
+  ast::Identifier thread_state_type_{nullptr};
 };
 }  // namespace terrier::execution::compiler
@@ -59,6 +59,9 @@ class ProjectionTranslator : public OperatorTranslator {
   // Is always vectorizable.
   bool IsVectorizable() override { return true; }
 
+  // Is always parallelizable.
+  bool IsParallelizable() override { return true; }
+
   // Should not be called here
   ast::Expr *GetTableColumn(const catalog::col_oid_t &col_oid) override {
     UNREACHABLE("Projection nodes should not use column value expressions");
@@ -3,6 +3,8 @@
 #include <utility>
 #include <vector>
 #include "execution/compiler/operator/operator_translator.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 
 namespace terrier::execution::compiler {
@@ -51,14 +53,17 @@ class SeqScanTranslator : public OperatorTranslator {
     return true;
   }
 
-  // This is vectorizable only if the predicate is vectorizable
+  // Each thread can scan its own range of blocks.
+  bool IsParallelizable() override { return true; }
+
+  // The parallel worker receives tvi: *TableVectorIterator
+  ast::FieldDecl *GetParallelWorkParam() override;
+
+  // Calls @iterateTableParallel
+  void LaunchParallelWork(FunctionBuilder *builder, ast::Expr *thread_states, ast::Identifier work_fn) override;
+
+  // This is vectorizable only if the whole predicate runs as vectorized filters
   bool IsVectorizable() override { return is_vectorizable_; }
-  /**
-   * Recursively walk down the predicate tree to check if it is vectorizable.
-   * @param predicate The predicate to check
-   * @return Whether the predicate is vectorizable or not.
-   */
-  static bool IsVectorizable(const terrier::parser::AbstractExpression *predicate);
 
   // Return the pci and its type
   std::pair<const ast::Identifier *, const ast::Identifier *> GetMaterializedTuple() override {
@@ -71,6 +76,15 @@ class SeqScanTranslator : public OperatorTranslator {
   // Return the current slot.
   ast::Expr *GetSlot() override { return codegen_->PointerTo(slot_); }
 
+  /**
+   * Filter the scanned tuples by the runtime filter of a hash join that this scan probes.
+   * @param col_oid The integer column holding the probe key
+   * @param join_ht The state member holding the built join hash table
+   */
+  void AddJoinFilter(catalog::col_oid_t col_oid, ast::Identifier join_ht) {
+    join_filters_.emplace_back(col_oid, join_ht);
+  }
+
   const planner::AbstractPlanNode *Op() override { return op_; }
 
  private:
@@ -100,8 +114,32 @@ class SeqScanTranslator : public OperatorTranslator {
   // @tableIterReset(&tvi)
   void GenTVIReset(FunctionBuilder *builder);
 
-  // Generated vectorized filters
-  void GenVectorizedPredicate(FunctionBuilder *builder, const terrier::parser::AbstractExpression *predicate);
+  // @filterComp(pci, col_idx, col_type, val) for each vectorized filter, or
+  // @filterParam(pci, col_idx, col_type, comparison, execCtx, param_idx) for lifted constants
+  void GenVectorizedPredicate(FunctionBuilder *builder);
+
+  // Recursively walk down the conjunction, and collect the comparisons of a column with a constant that vectorized
+  // filters can evaluate: integer columns with integer constants that fit in them, and varchar columns with strings.
+  // Returns whether every conjunct was collected exactly, in which case the tuple at a time check is not needed.
+  bool CollectVectorizedFilters(const parser::AbstractExpression *predicate);
+
+  // Match a comparison of a column with a constant, on either side. The comparison is flipped to have the column on
+  // the left.
+  static bool MatchColumnComparison(const parser::AbstractExpression *predicate,
+                                    const parser::ColumnValueExpression **column,
+                                    const parser::ConstantValueExpression **constant,
+                                    parser::ExpressionType *comparison);
+
+  // @filterJoin(pci, col_idx, col_type, &state.join_ht) for each join filter
+  void GenJoinFilters(FunctionBuilder *builder);
+
+  // @tableIterRestrictRange(&tvi, col_idx, col_type, min, max) for each comparison of a column to a constant in the
+  // conjunction, so that the iterator can skip blocks whose zone maps rule out the predicate. Lifted constants use
+  // @tableIterRestrictRangeToParam instead, since the code is reused for other values of them.
+  void GenRestrictRanges(FunctionBuilder *builder, const parser::AbstractExpression *predicate);
+
+  // Whether the PCI loop only visits the tuples selected by vectorized filters
+  bool IsPCIFiltered() const { return !vectorized_filters_.empty() || !join_filters_.empty(); }
 
   // Create the input oids used for the scans.
   // When the plan's oid list is empty (like in "SELECT COUNT(*)"), then we just read the first column of the table.
@@ -124,6 +162,17 @@ class SeqScanTranslator : public OperatorTranslator {
   storage::ProjectionMap pm_;
   bool has_predicate_;
   bool is_vectorizable_;
+  // Comparisons of a column with a constant, run as vectorized filters on the PCI
+  struct VectorizedFilter {
+    catalog::col_oid_t col_oid_;
+    parser::ExpressionType comparison_;
+    const parser::ConstantValueExpression *constant_;
+    // The parameter slot of a lifted constant, or ConstantLifter::NOT_LIFTED
+    uint32_t param_idx_;
+  };
+  std::vector<VectorizedFilter> vectorized_filters_;
+  // Runtime filters of the hash joins this scan probes
+  std::vector<std::pair<catalog::col_oid_t, ast::Identifier>> join_filters_;
 
   // Structs, functions and locals
   ast::Identifier tvi_;
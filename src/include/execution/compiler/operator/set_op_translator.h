@@ -0,0 +1,205 @@
+#pragma once
+
+#include <utility>
+#include "execution/compiler/operator/operator_translator.h"
+#include "planner/plannodes/set_op_plan_node.h"
+
+namespace terrier::execution::compiler {
+
+// Forward declare
+class SetOpTopTranslator;
+
+/**
+ * SetOp Bottom Translator
+ * Every input of a set operation is a separate build pipeline with its own bottom translator. All of them insert the
+ * input's tuples into a single aggregation hash table whose entries hold the distinct tuples, and how many times each
+ * input produced them. The bottom translator of the first input owns the hash table and its helpers.
+ */
+class SetOpBottomTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op plan node to translate
+   * @param codegen code generator
+   * @param child_idx index of the input this translator builds
+   * @param first the bottom translator of the first input, or nullptr if this is the first input
+   */
+  SetOpBottomTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen, uint32_t child_idx,
+                        OperatorTranslator *first);
+
+  // Declare the hash table
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override;
+
+  // Declare the entry struct
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Create the key check function
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Initialize the hash table
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override;
+
+  // Free the hash table
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
+
+  // Add a thread-local hash table
+  void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) override;
+
+  // Initialize the thread-local hash table
+  void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Free the thread-local hash table
+  void InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Declare the function that merges a thread's hash table into the global one
+  void InitializeThreadStateHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Merge the thread-local hash tables
+  void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) override;
+
+  void Produce(FunctionBuilder *builder) override { child_translator_->Produce(builder); }
+  void Abort(FunctionBuilder *builder) override { child_translator_->Abort(builder); }
+  void Consume(FunctionBuilder *builder) override;
+
+  // Pass through to the child
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override {
+    return child_translator_->GetOutput(attr_idx);
+  }
+
+  // Should not be called.
+  ast::Expr *GetOutput(uint32_t attr_idx) override { UNREACHABLE("Set operations only output through the top"); }
+
+  // This is a materializer
+  bool IsMaterializer(bool *is_ptr) override {
+    *is_ptr = true;
+    return true;
+  }
+
+  // Return the hash table entry and its type
+  std::pair<const ast::Identifier *, const ast::Identifier *> GetMaterializedTuple() override {
+    return {&owner_->entry_, &owner_->entry_struct_};
+  }
+
+  bool IsParallelizable() override { return true; }
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // Make the top translator a friend class.
+  friend class SetOpTopTranslator;
+
+  // Whether tuples of this input that no earlier input produced are inserted into the hash table
+  bool InsertsMissing() const;
+
+  // Declare var entry = @ptrCast(*Entry, @aggHTLookup(ht, hash, keyCheck, values)), inserting the values if missing
+  void GenLookupOrInsert(FunctionBuilder *builder, ast::Expr *ht, ast::Identifier values, ast::Expr *values_ptr,
+                         bool insert_missing);
+
+  // Return the given input's counter in the given hash table entry
+  ast::Expr *GetCounter(ast::Identifier entry, uint32_t child_idx);
+
+  const planner::SetOpPlanNode *op_;
+  // Index of the input
+  uint32_t child_idx_;
+  // The translator holding the shared hash table
+  SetOpBottomTranslator *owner_;
+
+  // Structs, functions, and locals. Only the owner's are used for the shared ones.
+  ast::Identifier ht_;
+  ast::Identifier entry_struct_;
+  ast::Identifier key_check_;
+  ast::Identifier entry_;
+  ast::Identifier values_;
+  ast::Identifier hash_val_;
+  ast::Identifier partial_;
+  ast::Identifier merge_iter_;
+  ast::Identifier merge_fn_;
+  static constexpr const char *KEY_ATTR_NAME = "key";
+  static constexpr const char *COUNT_ATTR_NAME = "count";
+};
+
+/**
+ * SetOp Top Translator
+ * This translator iterates through the hash table, and outputs every tuple as many times as the set operation
+ * keeps it given its counts.
+ */
+class SetOpTopTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op plan node
+   * @param codegen The code generator
+   * @param bottom The bottom translator of the first input
+   */
+  SetOpTopTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen, OperatorTranslator *bottom)
+      : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_ITERATE),
+        op_(op),
+        bottom_(dynamic_cast<SetOpBottomTranslator *>(bottom)),
+        iterator_(codegen->NewIdentifier("set_op_iter")),
+        num_copies_(codegen->NewIdentifier("num_copies")),
+        copy_idx_(codegen->NewIdentifier("copy_idx")) {
+    TERRIER_ASSERT(op->GetChildrenSize() == 2 || op->GetSetOp() == planner::SetOpType::UNION ||
+                       op->GetSetOp() == planner::SetOpType::UNION_ALL,
+                   "Only UNION can have more than two inputs");
+  }
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Does nothing
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  // Every input maps to the same columns of the hash table entry
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+
+  // This is a materializer
+  bool IsMaterializer(bool *is_ptr) override {
+    *is_ptr = false;
+    return true;
+  }
+
+  // Pass the call to the bottom translator.
+  std::pair<const ast::Identifier *, const ast::Identifier *> GetMaterializedTuple() override {
+    return bottom_->GetMaterializedTuple();
+  }
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // for (@aggHTIterInit(&iter, &state.ht); @aggHTIterHasNext(&iter); @aggHTIterNext(&iter)) {...}
+  void GenHTLoop(FunctionBuilder *builder);
+
+  // Declare var entry = @ptrCast(*Entry, @aggHTIterGetRow(&iter))
+  void DeclareEntry(FunctionBuilder *builder);
+
+  // Declare var num_copies: int64, the number of times the current entry is output
+  void GenNumCopies(FunctionBuilder *builder);
+
+  // Call @aggHTIterClose(&iter)
+  void CloseIterator(FunctionBuilder *builder);
+
+  const planner::SetOpPlanNode *op_;
+  // The bottom translator owning the hash table
+  SetOpBottomTranslator *bottom_;
+
+  // Structs, Functions, and local variables needed.
+  ast::Identifier iterator_;
+  ast::Identifier num_copies_;
+  ast::Identifier copy_idx_;
+};
+}  // namespace terrier::execution::compiler
@@ -35,6 +35,20 @@ class SortBottomTranslator : public OperatorTranslator {
   // Call @asorterFree on the Sorter
   void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
 
+  // Add a thread-local sorter
+  void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) override;
+
+  // Call @sorterInit on the thread-local sorter
+  void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Call @sorterFree on the thread-local sorter
+  void InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Sort the thread-local sorters into the global one
+  void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) override;
+
+  bool IsParallelizable() override { return true; }
+
   void Produce(FunctionBuilder *builder) override;
   void Abort(FunctionBuilder *builder) override;
   void Consume(FunctionBuilder *builder) override;
@@ -68,6 +82,10 @@ class SortBottomTranslator : public OperatorTranslator {
   void FillSorterRow(FunctionBuilder *builder);
   // Call Sort()
   void GenSorterSort(FunctionBuilder *builder);
+  // Pointer to the sorter that tuples are inserted into (thread-local in parallel pipelines)
+  ast::Expr *GetInsertSorterPtr();
+  // Make the @sorterInit call
+  ast::Expr *SorterInitCall(ast::Expr *sorter);
   // Generate the comparisons in the comparison function
   void GenComparisons(FunctionBuilder *builder);
 
@@ -39,6 +39,21 @@ class StaticAggregateBottomTranslator : public OperatorTranslator {
   // Free Distinct
   void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
 
+  // Add thread-local aggregates
+  void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) override;
+
+  // Initialize the thread-local aggregates
+  void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Declare the function that merges a thread's aggregates into the global ones
+  void InitializeThreadStateHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Merge the thread-local aggregates
+  void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) override;
+
+  // Distinct aggregates use hash tables that cannot be merged yet.
+  bool IsParallelizable() override;
+
   // Pass Through
   void Produce(FunctionBuilder *builder) override { child_translator_->Produce(builder); };
   // Pass Through
@@ -62,6 +77,7 @@ class StaticAggregateBottomTranslator : public OperatorTranslator {
   friend class StaticAggregateTopTranslator;
   const planner::AggregatePlanNode *op_;
   AggregateHelper helper_;
+  ast::Identifier merge_fn_;
 };
 
 /**
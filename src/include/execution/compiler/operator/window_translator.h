@@ -0,0 +1,165 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "execution/compiler/operator/operator_translator.h"
+#include "planner/plannodes/window_plan_node.h"
+
+namespace terrier::execution::compiler {
+
+class WindowTopTranslator;
+
+/**
+ * The window bottom translator. It materializes the child's rows into a sorter, ordered by the partitioning terms and
+ * then by the sort keys, along with the inputs of the window aggregates.
+ */
+class WindowBottomTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op The plan node
+   * @param codegen The code generator
+   */
+  WindowBottomTranslator(const terrier::planner::WindowPlanNode *op, CodeGen *codegen);
+
+  // Declare the Sorter
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override;
+
+  // Declare WindowRow struct
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Create the partition and peer comparison functions
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Call @sorterInit on the Sorter
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override;
+
+  // Call @sorterFree on the Sorter
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
+
+  // Add a thread-local sorter
+  void InitializeThreadStateFields(util::RegionVector<ast::FieldDecl *> *thread_state_fields) override;
+
+  // Call @sorterInit on the thread-local sorter
+  void InitializeThreadStateSetup(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Call @sorterFree on the thread-local sorter
+  void InitializeThreadStateTeardown(util::RegionVector<ast::Stmt *> *thread_state_stmts) override;
+
+  // Sort the thread-local sorters into the global one
+  void FinishParallelWork(FunctionBuilder *builder, ast::Expr *thread_states) override;
+
+  bool IsParallelizable() override { return true; }
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  friend class WindowTopTranslator;
+
+  // Return the member of the object at the given index
+  ast::Expr *GetAttribute(ast::Identifier object, uint32_t attr_idx);
+  // Return the name of the input of the window function at the given index
+  ast::Identifier GetInputField(uint32_t function_idx);
+  // Whether the window function at the given index reads an input from the rows (every aggregate but COUNT(*))
+  bool HasInput(uint32_t function_idx);
+  // Pointer to the sorter that tuples are inserted into (thread-local in parallel pipelines)
+  ast::Expr *GetInsertSorterPtr();
+  // Make the @sorterInit call
+  ast::Expr *SorterInitCall(ast::Expr *sorter);
+  // Make a comparison function over the partitioning terms, followed by the sort keys if include_sort_keys is set
+  ast::Decl *GenComparisonFunction(ast::Identifier fn_name, bool include_sort_keys);
+  // Generate the comparisons of one key in a comparison function
+  void GenComparison(FunctionBuilder *builder, common::ManagedPointer<parser::AbstractExpression> key,
+                     optimizer::OrderByOrderingType ordering);
+
+  // The window plan node
+  const planner::WindowPlanNode *op_;
+
+  // Like the sort translator, GetChildOutput uses the lhs or rhs row in the comparison functions, and the child
+  // node in the main pipeline.
+  enum class CurrentRow { Child, Lhs, Rhs };
+  CurrentRow current_row_{CurrentRow::Child};
+
+  // Structs, Functions, and local variables needed.
+  static constexpr const char *WINDOW_ATTR_PREFIX = "window_attr";
+  static constexpr const char *WINDOW_INPUT_PREFIX = "window_input";
+  ast::Identifier sorter_;
+  ast::Identifier window_row_;
+  ast::Identifier window_struct_;
+  ast::Identifier partition_fn_;
+  ast::Identifier peer_fn_;
+  ast::Identifier comp_lhs_;
+  ast::Identifier comp_rhs_;
+};
+
+/**
+ * The window top translator. It scans the sorted rows partition by partition, and computes the window functions of
+ * every row before passing it on.
+ */
+class WindowTopTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op The plan node
+   * @param codegen The code generator
+   * @param bottom The corresponding bottom translator
+   */
+  WindowTopTranslator(const terrier::planner::WindowPlanNode *op, CodeGen *codegen, OperatorTranslator *bottom);
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Does nothing
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // Declare the window operator, and the frames, trees and aggregates of the window functions
+  void DeclareWindow(FunctionBuilder *builder);
+  // Generate the iteration loop
+  void GenForLoop(FunctionBuilder *builder);
+  // Build the trees at the start of every partition, and query them for the current row
+  void ComputeAggregates(FunctionBuilder *builder);
+  // Free the iterator, the trees and the window operator
+  void FreeWindow(FunctionBuilder *builder);
+  // Make the @windowIterGetFrameBegin or @windowIterGetFrameEnd call of a window function
+  ast::Expr *FrameBoundCall(ast::Builtin builtin, uint32_t function_idx);
+
+  // The window plan node
+  const planner::WindowPlanNode *op_;
+
+  // The bottom translator
+  WindowBottomTranslator *bottom_;
+
+  // Local variables
+  ast::Identifier window_;
+  ast::Identifier window_iter_;
+  std::vector<ast::Identifier> frames_;
+  std::vector<ast::Identifier> trees_;
+  std::vector<ast::Identifier> aggregates_;
+};
+
+}  // namespace terrier::execution::compiler
@@ -54,9 +54,9 @@ class Pipeline {
    * Produce the code of this pipeline
    * @param query_id query identifier
    * @param pipeline_idx index of of this pipeline
-   * @return the function generated by this pipeline
+   * @param decls where to append the functions generated by this pipeline
    */
-  ast::Decl *Produce(query_id_t query_id, pipeline_id_t pipeline_idx);
+  void Produce(query_id_t query_id, pipeline_id_t pipeline_idx, util::RegionVector<ast::Decl *> *decls);
 
   /**
    * Gets the vector of operators that make up the pipeline
@@ -64,12 +64,42 @@ class Pipeline {
    */
   const std::vector<std::unique_ptr<OperatorTranslator>> &GetTranslators() const { return pipeline_; }
 
+  /**
+   * @return whether this pipeline is executed in parallel
+   */
+  bool IsParallel() const { return is_parallelizable_; }
+
  private:
+  // Declare the thread state struct and the functions that initialize and destroy it.
+  void GenThreadState(util::RegionVector<ast::Decl *> *decls, util::RegionVector<ast::FieldDecl *> &&fields,
+                      util::RegionVector<ast::Stmt *> &&init_stmts, util::RegionVector<ast::Stmt *> &&teardown_stmts);
+
+  // Generate fun (execCtx: *ExecutionContext, threadState: *ThreadState) -> nil {...}
+  ast::Decl *GenThreadStateFunction(ast::Identifier fn_name, util::RegionVector<ast::Stmt *> &&stmts);
+
+  // Generate fun pipelineN_ParallelWork(state: *State, threadState: *ThreadState, ...) -> nil {...}
+  // Each thread runs this function over its share of the input.
+  ast::Decl *ProduceParallelWork();
+
+  // Produce the body of a serial pipeline.
+  void ProduceSerial(FunctionBuilder *builder);
+
+  // Produce the body of a parallel pipeline: launch the workers, then let each operator merge thread-local state.
+  void ProduceParallel(FunctionBuilder *builder);
+
   CodeGen *codegen_;
   std::vector<std::unique_ptr<OperatorTranslator>> pipeline_{};
   pipeline_id_t pipeline_idx_{0};
   bool is_vectorizable_{true};
   bool is_parallelizable_{true};
+
+  // Identifiers only used by parallel pipelines
+  ast::Identifier thread_state_type_{nullptr};
+  ast::Identifier thread_states_{nullptr};
+  ast::Identifier thread_state_init_fn_{nullptr};
+  ast::Identifier thread_state_teardown_fn_{nullptr};
+  ast::Identifier parallel_work_fn_{nullptr};
+  ast::Identifier thread_state_exec_ctx_{nullptr};
 };
 
 }  // namespace terrier::execution::compiler
@@ -35,6 +35,14 @@ class TranslatorFactory {
   static std::unique_ptr<OperatorTranslator> CreateTopTranslator(const planner::AbstractPlanNode *op,
                                                                  OperatorTranslator *bottom, CodeGen *codegen);
 
+  /**
+   * Create the bottom translator of an input of a set operation other than the first one
+   */
+  static std::unique_ptr<OperatorTranslator> CreateSetOpInputTranslator(const planner::AbstractPlanNode *op,
+                                                                        uint32_t child_idx,
+                                                                        OperatorTranslator *first_bottom,
+                                                                        CodeGen *codegen);
+
   /**
    * Create a left expression translator
    */
@@ -63,6 +71,13 @@ class TranslatorFactory {
            type == parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO;
   }
 
+  /**
+   * Whether this is a pattern matching operation
+   */
+  static bool IsLikeOp(parser::ExpressionType type) {
+    return type == parser::ExpressionType::COMPARE_LIKE || type == parser::ExpressionType::COMPARE_NOT_LIKE;
+  }
+
   /**
    * Whether this is an arithmetic operation
    */
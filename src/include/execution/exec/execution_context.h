@@ -1,10 +1,12 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
 #include "common/managed_pointer.h"
+#include "common/spin_latch.h"
 #include "execution/exec/output.h"
 #include "execution/exec_defs.h"
 #include "execution/sql/memory_pool.h"
@@ -60,6 +62,8 @@ class EXPORT ExecutionContext {
     void Deallocate(char *str) {}
 
    private:
+    // Protects the region, since the threads of a parallel pipeline share this allocator
+    common::SpinLatch latch_;
     util::Region region_;
     // Metadata tracker for memory allocations
     common::ManagedPointer<sql::MemoryTracker> tracker_;
@@ -173,6 +177,30 @@ class EXPORT ExecutionContext {
    */
   uint64_t &RowsAffected() { return rows_affected_; }
 
+  /**
+   * Count blocks that table scans skipped because their zone maps ruled out the scan predicate
+   * @param num_blocks number of skipped blocks
+   */
+  void AddSkippedBlocks(uint64_t num_blocks) { skipped_blocks_.fetch_add(num_blocks, std::memory_order_relaxed); }
+
+  /**
+   * @return number of blocks that the table scans of the query skipped so far
+   */
+  uint64_t SkippedBlocks() const { return skipped_blocks_.load(std::memory_order_relaxed); }
+
+  /**
+   * Count probe-side tuples that table scans dropped because the runtime filter of a hash join ruled them out
+   * @param num_tuples number of dropped tuples
+   */
+  void AddJoinFilteredTuples(uint64_t num_tuples) {
+    join_filtered_tuples_.fetch_add(num_tuples, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return number of tuples that the runtime join filters of the query dropped so far
+   */
+  uint64_t JoinFilteredTuples() const { return join_filtered_tuples_.load(std::memory_order_relaxed); }
+
   /**
    * Set the PipelineOperatingUnits
    * @param op PipelineOperatingUnits for executing the given query
@@ -181,6 +209,35 @@ class EXPORT ExecutionContext {
     pipeline_operating_units_ = op;
   }
 
+  /**
+   * Set whether the compiler may generate parallel pipelines for this query
+   * @param parallel_execution whether parallel execution is enabled
+   */
+  void SetParallelExecution(bool parallel_execution) { parallel_execution_ = parallel_execution; }
+
+  /**
+   * @return whether the compiler may generate parallel pipelines for this query
+   */
+  bool IsParallelExecutionEnabled() const { return parallel_execution_; }
+
+  /**
+   * Set whether table scans may read frozen blocks in place. This keeps a block frozen while its tuples are processed,
+   * so it is only safe for queries that do not write to the tables they scan.
+   * @param in_place_reads whether in-place reads are enabled
+   */
+  void SetInPlaceReads(bool in_place_reads) { in_place_reads_ = in_place_reads; }
+
+  /**
+   * @return whether table scans may read frozen blocks in place
+   */
+  bool AreInPlaceReadsEnabled() const { return in_place_reads_; }
+
+  /**
+   * Set the memory budget of this query. Aggregations and sorts spill to disk to stay within it.
+   * @param limit maximum number of bytes the query should allocate, 0 for no limit
+   */
+  void SetMemoryLimit(size_t limit) { mem_tracker_->SetMemoryLimit(limit); }
+
  private:
   catalog::db_oid_t db_oid_;
   common::ManagedPointer<transaction::TransactionContext> txn_;
@@ -193,5 +250,11 @@ class EXPORT ExecutionContext {
   uint8_t execution_mode_;
   std::vector<type::TransientValue> params_;
   uint64_t rows_affected_ = 0;
+  // Blocks skipped by table scans, which may run in parallel
+  std::atomic<uint64_t> skipped_blocks_{0};
+  // Probe tuples dropped by runtime join filters, which may also run in parallel
+  std::atomic<uint64_t> join_filtered_tuples_{0};
+  bool parallel_execution_ = false;
+  bool in_place_reads_ = false;
 };
 }  // namespace terrier::execution::exec
@@ -15,6 +15,10 @@ class AbstractPlanNode;
 
 namespace terrier::execution {
 
+namespace compiler {
+class ConstantLifter;
+}
+
 namespace exec {
 class ExecutionContext;
 }
@@ -41,9 +45,12 @@ class ExecutableQuery {
    * @param physical_plan output from the optimizer
    * @param exec_ctx execution context to use for code generation. Note that this execution context need not be the one
    * used for Run.
+   * @param lifter if given, the lifted constants of the plan are read from the parameters of the execution context, so
+   * the query can be run for any plan with the same fingerprint
    */
   ExecutableQuery(common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
-                  common::ManagedPointer<exec::ExecutionContext> exec_ctx);
+                  common::ManagedPointer<exec::ExecutionContext> exec_ctx,
+                  const compiler::ConstantLifter *lifter = nullptr);
 
   /**
    * Construct and compile an executable TPL program in the given filename
@@ -72,6 +79,16 @@ class ExecutableQuery {
    */
   query_id_t GetQueryId() const { return query_id_; }
 
+  /**
+   * @returns whether code generation succeeded and the query can be run
+   */
+  bool IsCompiled() const { return tpl_module_ != nullptr; }
+
+  /**
+   * @returns size of the query's code in bytes
+   */
+  std::size_t GetCodeSizeInBytes() const;
+
   /**
    * @returns Pipeline Units
    */
@@ -96,6 +113,9 @@ class ExecutableQuery {
   std::unique_ptr<ast::Context> ast_ctx_;
   std::unique_ptr<brain::PipelineOperatingUnits> pipeline_operating_units_;
 
+  // Whether the query only reads tables, so that its scans can read frozen blocks in place
+  bool read_only_ = false;
+
   std::string query_name_;
   query_id_t query_id_;
   static std::atomic<query_id_t> query_identifier;
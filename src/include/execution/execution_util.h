@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "execution/util/cpu_info.h"
@@ -16,10 +17,11 @@ class ExecutionUtil {
 
   /**
    * Initialize all TPL subsystems
+   * @param object_cache_directory where compiled object code is cached, empty to disable the cache
    */
-  static void InitTPL() {
+  static void InitTPL(const std::string &object_cache_directory = "") {
     execution::CpuInfo::Instance();
-    execution::vm::LLVMEngine::Initialize();
+    execution::vm::LLVMEngine::Initialize(object_cache_directory);
   }
 
   /**
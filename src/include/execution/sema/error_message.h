@@ -74,13 +74,22 @@ namespace sema {
     "sorterInit requires a comparison function of type (*,*)->int32. "                                                \
     "Received type '%0'",                                                                                             \
     (ast::Type *))                                                                                                    \
+  F(BadComparisonFunctionForWindow,                                                                                   \
+    "windowInit requires comparison functions of type (*,*)->int32. "                                                 \
+    "Received type '%0'",                                                                                             \
+    (ast::Type *))                                                                                                    \
   F(BadArgToPtrCast,                                                                                                  \
     "ptrCast() expects (compile-time *DestType, *T) arguments.  Received "                                            \
     "type '%0' in position %1",                                                                                       \
     (ast::Type *, uint32_t))                                                                                          \
+  F(BadArgToOffsetOf,                                                                                                 \
+    "offsetOf() expects (compile-time StructType, member) arguments.  Received "                                      \
+    "type '%0' in position %1",                                                                                       \
+    (ast::Type *, uint32_t))                                                                                          \
   F(BadHashArg, "cannot hash type '%0'", (ast::Type *))                                                               \
   F(MissingArrayLength, "missing array length (either compile-time number or '*')", ())                               \
   F(NotASQLAggregate, "'%0' is not a SQL aggregator type", (ast::Type *))                                             \
+  F(NotAWindowTree, "'%0' is not a window tree type", (ast::Type *))                                                  \
   F(BadParallelScanFunction,                                                                                          \
     "parallel scan function must have type (*ExecutionContext, "                                                      \
     "*TableVectorIterator)->nil, received '%0'",                                                                      \
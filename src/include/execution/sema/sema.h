@@ -120,12 +120,17 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinSqlNullCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSqlConversionCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinFilterCall(ast::CallExpr *call);
+  void CheckBuiltinFilterLikeCall(ast::CallExpr *call);
+  void CheckBuiltinFilterJoinCall(ast::CallExpr *call);
+  void CheckBuiltinFilterParamCall(ast::CallExpr *call);
+  void CheckBuiltinLikeCall(ast::CallExpr *call);
   void CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggPartIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableInit(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableInsert(ast::CallExpr *call);
+  void CheckBuiltinJoinHashTableAddFilterKey(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableIterInit(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableIterHasNext(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableIterGetRow(ast::CallExpr *call);
@@ -136,14 +141,21 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinSorterInsert(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterFree(ast::CallExpr *call);
+  void CheckBuiltinSorterAccess(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinWindowCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinWindowIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinWindowTreeCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckMathTrigCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSizeOfCall(ast::CallExpr *call);
+  void CheckBuiltinOffsetOfCall(ast::CallExpr *call);
   void CheckBuiltinPtrCastCall(ast::CallExpr *call);
   void CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinTableIterParCall(ast::CallExpr *call);
+  void CheckBuiltinCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinCSVParallelCall(ast::CallExpr *call);
   void CheckBuiltinPCICall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinFilterManagerCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinHashCall(ast::CallExpr *call, ast::Builtin builtin);
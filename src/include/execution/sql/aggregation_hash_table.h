@@ -1,10 +1,14 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include "execution/sql/generic_hash_table.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/sql/projected_columns_iterator.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace libcount {
@@ -20,6 +24,18 @@ class AggregationOverflowPartitionIterator;
 
 /**
  * The hash table used when performing aggregations
+ *
+ * In partitioned mode, the table is periodically flushed into overflow partitions. If the query is over its memory
+ * budget after a flush, all overflow partitions are written to a spill file and their memory is released. Each
+ * partition is read back when its table is built in ExecuteParallelPartitionedScan(), so only the partitions being
+ * built are in memory at once. Spilling copies aggregates byte for byte, so any memory an aggregate points to, like the
+ * contents of strings, stays in memory.
+ *
+ * A thread-local table in partitioned mode is a cache-sized pre-aggregation table in front of the overflow partitions.
+ * If its lookups rarely find an existing group by the time it first fills up, the grouping keys are close to unique
+ * and pre-aggregating only costs a probe per tuple. The table then switches to pass-through: Lookup() stops probing,
+ * and InsertPartitioned() appends every tuple directly into its overflow partition, where it is merged with the other
+ * partial aggregates of its group when the partition's table is built.
  */
 class EXPORT AggregationHashTable {
  public:
@@ -43,6 +59,12 @@ class EXPORT AggregationHashTable {
    */
   static constexpr uint32_t K_DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * A partitioned table whose lookups find an existing group less often than this switches to pass-through. The
+   * ratio is measured again over every window of tuples between two flushes, so the table can also switch back.
+   */
+  static constexpr float K_MIN_PRE_AGGREGATION_HIT_RATIO = 0.2f;
+
   // -------------------------------------------------------
   // Callback functions to customize aggregations
   // -------------------------------------------------------
@@ -105,6 +127,26 @@ class EXPORT AggregationHashTable {
      * Number of flushes
      */
     uint64_t num_flushes_ = 0;
+
+    /**
+     * Number of times the overflow partitions were spilled to disk
+     */
+    uint64_t num_spills_ = 0;
+
+    /**
+     * Number of lookups
+     */
+    uint64_t num_lookups_ = 0;
+
+    /**
+     * Number of lookups that found an existing group
+     */
+    uint64_t num_hits_ = 0;
+
+    /**
+     * Number of tuples passed through to the overflow partitions without pre-aggregation
+     */
+    uint64_t num_bypassed_ = 0;
   };
 
   // -------------------------------------------------------
@@ -141,6 +183,11 @@ class EXPORT AggregationHashTable {
 
   /**
    * Insert a new element with hash value @em hash into the aggregation table.
+   * Once the query goes over its memory budget, the table switches to
+   * partitioned mode for good: from then on, this behaves as
+   * InsertPartitioned(), so the table flushes and spills its overflow
+   * partitions. Its aggregates must then be read back with
+   * BuildAllPartitions().
    * @param hash The hash value of the element to insert
    * @return A pointer to a memory area where the element can be written to
    */
@@ -148,7 +195,11 @@ class EXPORT AggregationHashTable {
 
   /**
    * Insert a new element with hash value @em hash into this partitioned
-   * aggregation hash table.
+   * aggregation hash table. If the table passes tuples through, the element
+   * is appended directly to its overflow partition. Every window of tuples as
+   * large as the pre-aggregation table ends with a flush, which decides from
+   * the hit ratio of the window whether the next one pre-aggregates or passes
+   * tuples through.
    * @param hash The hash value of the element to insert
    * @return A pointer to a memory area where the input element can be written
    */
@@ -161,7 +212,8 @@ class EXPORT AggregationHashTable {
    * @param hash The hash value to use for early filtering
    * @param key_eq_fn The key-equality function to resolve hash collisions
    * @param probe_tuple The probe tuple
-   * @return A pointer to the matching entry payload; null if no entry is found.
+   * @return A pointer to the matching entry payload; null if no entry is found,
+   *         or if the table passes tuples through.
    */
   byte *Lookup(hash_t hash, KeyEqFn key_eq_fn, const void *probe_tuple);
 
@@ -217,6 +269,16 @@ class EXPORT AggregationHashTable {
    */
   void ExecuteParallelPartitionedScan(void *query_state, ThreadStateContainer *thread_states, ScanPartitionFn scan_fn);
 
+  /**
+   * Build an aggregation hash table over every non-empty overflow partition, merging the contents of each partition
+   * with @em merge_partition_fn. The tables are built in parallel, but are then scanned serially by an
+   * AggregationHashTableIterator over this table. Nothing is done if this table was never partitioned, since all of
+   * its aggregates are still in its hash table.
+   * @param query_state The (opaque) query state.
+   * @param merge_partition_fn The partition merge function
+   */
+  void BuildAllPartitions(void *query_state, MergePartitionFn merge_partition_fn);
+
   /**
    * How many aggregates are in this table?
    */
@@ -227,15 +289,40 @@ class EXPORT AggregationHashTable {
    */
   const Stats *GetStats() const { return &stats_; }
 
+  /**
+   * @return True if some overflow partitions were spilled to disk
+   */
+  bool HasSpilled() const { return spill_file_ != nullptr || !owned_spill_files_.empty(); }
+
+  /**
+   * @return True if this table stopped pre-aggregating, and passes tuples through to the overflow partitions
+   */
+  bool IsBypassing() const { return bypass_; }
+
+  /**
+   * @return True if this table went over the memory budget in Insert(), and partitions its entries since
+   */
+  bool IsPartitioned() const { return partitioned_; }
+
  private:
   friend class AggregationHashTableIterator;
 
+  // A range of a spill file holding entries of one overflow partition
+  struct SpilledRun {
+    const SpillFile *file_;
+    uint64_t offset_;
+    uint64_t num_entries_;
+  };
+
   // Does the hash table need to grow?
   bool NeedsToGrow() const { return hash_table_.NumElements() >= max_fill_; }
 
   // Grow the hash table
   void Grow();
 
+  // Insert a new entry into the hash table, growing it if need be
+  byte *InsertEntry(hash_t hash);
+
   // Lookup a hash table entry internally
   HashTableEntry *LookupEntryInternal(hash_t hash, KeyEqFn key_eq_fn, const void *probe_tuple) const;
 
@@ -246,6 +333,36 @@ class EXPORT AggregationHashTable {
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
+  // Link an entry into its overflow partition
+  void AddToOverflowPartition(HashTableEntry *entry);
+
+  // Has pre-aggregation reduced the current window too little to be worth its
+  // lookups? A bypassed window has no lookups, so its hit ratio is estimated
+  // from the number of distinct hashes in it.
+  bool ShouldBypass() const;
+
+  // Start a new window of tuples, in which the table passes tuples through if
+  // bypass is true, and pre-aggregates them otherwise
+  void StartWindow(bool bypass);
+
+  // Append a new entry directly into its overflow partition, bypassing the hash table
+  byte *InsertBypassed(hash_t hash);
+
+  // Is the query over its memory budget?
+  bool IsOverMemoryLimit() const;
+
+  // Write all overflow partitions to the spill file, and release their memory
+  void SpillOverflowPartitions();
+
+  // Collect the indexes of all overflow partitions that have entries, and return how many there are
+  uint32_t CollectNonEmptyPartitions(uint32_t nonempty_parts[]) const;
+
+  // Does the given overflow partition have any entries, in memory or spilled?
+  bool IsPartitionEmpty(uint32_t partition_idx) const {
+    return partition_heads_[partition_idx] == nullptr &&
+           (spilled_partitions_.empty() || spilled_partitions_[partition_idx].empty());
+  }
+
   // Compute the hash value and perform the table lookup for all elements in the
   // input vector projections.
   template <bool PCIIsFiltered>
@@ -337,6 +454,29 @@ class EXPORT AggregationHashTable {
   // The number of bits to shift the hash value to determine its overflow
   // partition.
   uint64_t partition_shift_bits_;
+  // The file this table spills its overflow partitions to, created on the
+  // first spill.
+  std::unique_ptr<SpillFile> spill_file_;
+  // Spill files taken from other tables.
+  std::vector<std::unique_ptr<SpillFile>> owned_spill_files_;
+  // The spilled runs of each overflow partition. Empty until a spill.
+  std::vector<std::vector<SpilledRun>> spilled_partitions_;
+  // Whether this table passes tuples through to the overflow partitions
+  // instead of pre-aggregating them.
+  bool bypass_{false};
+  // The lookups, and those that found a group, since the last flush.
+  uint64_t window_lookups_{0};
+  uint64_t window_hits_{0};
+  // The tuples passed through since the last flush, and an estimate of how
+  // many distinct hashes they have. The estimate is only kept while bypassing.
+  uint64_t window_bypassed_{0};
+  std::unique_ptr<libcount::HLL> window_estimate_;
+  // Whether Insert() switched this table to partitioned mode, because the
+  // query went over its memory budget.
+  bool partitioned_{false};
+  // Whether Insert() may switch this table to partitioned mode. Tables built
+  // over a partition hold the final aggregates, so they must stay in memory.
+  bool can_partition_{true};
 
   // Runtime stats.
   Stats stats_;
@@ -363,8 +503,18 @@ inline HashTableEntry *AggregationHashTable::LookupEntryInternal(hash_t hash, Ag
 
 inline byte *AggregationHashTable::Lookup(hash_t hash, AggregationHashTable::KeyEqFn key_eq_fn,
                                           const void *probe_tuple) {
+  if (bypass_) {
+    return nullptr;
+  }
+  stats_.num_lookups_++;
+  window_lookups_++;
   auto *entry = LookupEntryInternal(hash, key_eq_fn, probe_tuple);
-  return (entry == nullptr ? nullptr : entry->payload_);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  stats_.num_hits_++;
+  window_hits_++;
+  return entry->payload_;
 }
 
 // ---------------------------------------------------------
@@ -372,7 +522,9 @@ inline byte *AggregationHashTable::Lookup(hash_t hash, AggregationHashTable::Key
 // ---------------------------------------------------------
 
 /**
- * An iterator over the contents of an aggregation hash table
+ * An iterator over the contents of an aggregation hash table. If tables were
+ * built over the overflow partitions of the table, their contents are iterated
+ * after the table's own.
  */
 class AggregationHashTableIterator {
  public:
@@ -380,32 +532,52 @@ class AggregationHashTableIterator {
    * Constructor
    * @param agg_table hash table to iterator over
    */
-  explicit AggregationHashTableIterator(const AggregationHashTable &agg_table) : iter_(agg_table.hash_table_) {}
+  explicit AggregationHashTableIterator(const AggregationHashTable &agg_table)
+      : partition_tables_(agg_table.partition_tables_), iter_(std::in_place, agg_table.hash_table_) {
+    SkipExhaustedTables();
+  }
 
   /**
    * Does this iterate have more data
    * @return True if the iterator has more data; false otherwise
    */
-  bool HasNext() const { return iter_.HasNext(); }
+  bool HasNext() const { return iter_->HasNext(); }
 
   /**
    * Advance the iterator
    */
-  void Next() { iter_.Next(); }
+  void Next() {
+    iter_->Next();
+    SkipExhaustedTables();
+  }
 
   /**
    * Return a pointer to the current row. It assumed the called has checked the
    * iterator is valid.
    */
   const byte *GetCurrentAggregateRow() const {
-    auto *ht_entry = iter_.GetCurrentEntry();
+    auto *ht_entry = iter_->GetCurrentEntry();
     return ht_entry->payload_;
   }
 
  private:
+  // Move on to the next partition table while the current table has no more entries
+  void SkipExhaustedTables() {
+    while (!iter_->HasNext() && partition_tables_ != nullptr &&
+           next_partition_ < AggregationHashTable::K_DEFAULT_NUM_PARTITIONS) {
+      if (const AggregationHashTable *table = partition_tables_[next_partition_++]; table != nullptr) {
+        iter_.emplace(table->hash_table_);
+      }
+    }
+  }
+
+  // The tables built over the overflow partitions, or null if there are none
+  const AggregationHashTable *const *partition_tables_;
+  // The next partition table to iterate over
+  uint32_t next_partition_{0};
   // The iterator over the aggregation hash table
   // TODO(pmenon): Switch to vectorized iterator when perf is better
-  GenericHashTableIterator<false> iter_;
+  std::optional<GenericHashTableIterator<false>> iter_;
 };
 
 /**
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+#include "storage/projected_columns.h"
+#include "storage/projected_row.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::catalog {
+class CatalogAccessor;
+class Schema;
+}  // namespace terrier::catalog
+
+namespace terrier::storage {
+class SqlTable;
+}  // namespace terrier::storage
+
+namespace terrier::transaction {
+class TransactionContext;
+}  // namespace terrier::transaction
+
+namespace terrier::execution::sql {
+class CSVReader;
+
+/**
+ * Loads a file into a table for COPY FROM.
+ *
+ * The file is split into chunks and each chunk is parsed by its own task. Parsed rows are gathered into batches of
+ * one block's worth of tuples, and each batch is copied into a fresh block column by column under a single bulk
+ * insert undo record. Indexes are not maintained row by row; they are built once all of the data is in the table.
+ *
+ * The transaction must not be used by anyone else while the load is running. If the load throws, the transaction
+ * must abort.
+ */
+class BulkLoader {
+ public:
+  /**
+   * Create a loader for the given table
+   * @param txn the loading transaction
+   * @param accessor catalog accessor of the transaction
+   * @param db_oid database of the table
+   * @param table_oid table to load into
+   */
+  BulkLoader(common::ManagedPointer<transaction::TransactionContext> txn,
+             common::ManagedPointer<catalog::CatalogAccessor> accessor, catalog::db_oid_t db_oid,
+             catalog::table_oid_t table_oid);
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(BulkLoader);
+
+  /**
+   * Load a CSV file. The i-th field of each row is stored in the i-th column of the table. Throws if a row is
+   * malformed, violates a NOT NULL or unique constraint, or has a column type that cannot be loaded.
+   * @param file_name name of the file
+   * @param delimiter field delimiter
+   * @param quote quote character
+   * @param escape escape character within quoted fields
+   * @return number of rows loaded
+   */
+  uint64_t LoadCSV(const std::string &file_name, char delimiter, char quote, char escape);
+
+ private:
+  // A run of tuples at consecutive offsets of one block
+  struct Run {
+    storage::TupleSlot first_;
+    uint32_t num_tuples_;
+  };
+
+  // Parse a chunk of the file and insert its rows one batch at a time
+  void LoadChunk(const char *begin, const char *end, char delimiter, char quote, char escape);
+
+  // Convert the current row of the reader into the given row of the batch
+  void ReadRow(CSVReader *reader, storage::ProjectedColumns::RowView *row) const;
+
+  // Free the out-of-line varlens of the first num_tuples rows of a batch that was never inserted
+  void FreeVarlens(storage::ProjectedColumns *batch, uint32_t num_tuples) const;
+
+  // Copy a full batch into a new block and log its tuples
+  void InsertBatch(storage::ProjectedColumns *batch);
+
+  // Insert the keys of every loaded tuple into the indexes of the table
+  void BuildIndexes();
+
+  const common::ManagedPointer<transaction::TransactionContext> txn_;
+  const common::ManagedPointer<catalog::CatalogAccessor> accessor_;
+  const catalog::db_oid_t db_oid_;
+  const catalog::table_oid_t table_oid_;
+  const common::ManagedPointer<storage::SqlTable> table_;
+  const catalog::Schema &schema_;
+
+  // Column oids in the order of the fields in the file
+  std::vector<catalog::col_oid_t> col_oids_;
+  storage::ProjectionMap projection_map_;
+  storage::ProjectedColumnsInitializer batch_initializer_;
+  storage::ProjectedRowInitializer redo_initializer_;
+
+  // Protects the transaction's buffers and the runs below
+  common::SpinLatch latch_;
+  std::vector<Run> runs_;
+};
+
+}  // namespace terrier::execution::sql
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "execution/sql/value.h"
+
+namespace terrier::execution::sql {
+class ThreadStateContainer;
+
+/**
+ * A read-only memory mapping of a whole file.
+ */
+class MappedFile {
+ public:
+  /**
+   * Map the file with the given name. Throws if the file cannot be opened or mapped.
+   * @param file_name name of the file
+   */
+  explicit MappedFile(const std::string &file_name);
+
+  /**
+   * Unmap the file
+   */
+  ~MappedFile();
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(MappedFile);
+
+  /**
+   * @return pointer to the first byte of the file
+   */
+  const char *Begin() const { return data_; }
+
+  /**
+   * @return pointer one past the last byte of the file
+   */
+  const char *End() const { return data_ + size_; }
+
+  /**
+   * @return size of the file in bytes
+   */
+  std::size_t Size() const { return size_; }
+
+ private:
+  const char *data_{nullptr};
+  std::size_t size_{0};
+};
+
+/**
+ * A reader over CSV data in a memory mapped file.
+ *
+ * Rows are split into fields one batch at a time: Advance() locates the field boundaries of up to
+ * K_BATCH_SIZE rows in one tight pass over the input, and typed values are only converted when they
+ * are accessed. An empty unquoted field is NULL. Strings returned by GetVarlen() point either into the
+ * mapped file or, for quoted fields containing escapes, into a buffer that lives until the next batch.
+ */
+class EXPORT CSVReader {
+ public:
+  /**
+   * Number of rows split at once
+   */
+  static constexpr uint32_t K_BATCH_SIZE = common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+  /**
+   * Target size of the chunks handed to each task by ParallelScan
+   */
+  static constexpr std::size_t K_CHUNK_SIZE = 4 * common::Constants::MB;
+
+  /**
+   * Create a reader over a whole file
+   * @param file_name name of the file
+   * @param delimiter field delimiter
+   * @param quote quote character
+   * @param escape escape character within quoted fields
+   */
+  CSVReader(const std::string &file_name, char delimiter, char quote, char escape);
+
+  /**
+   * Create a reader over a range of bytes. The range must start at the beginning of a row.
+   * @param begin first byte to read
+   * @param end one past the last byte to read
+   * @param delimiter field delimiter
+   * @param quote quote character
+   * @param escape escape character within quoted fields
+   */
+  CSVReader(const char *begin, const char *end, char delimiter, char quote, char escape);
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(CSVReader);
+
+  /**
+   * Move to the next row
+   * @return true if there is a row to read; false at the end of the input
+   */
+  bool Advance() {
+    if (++curr_row_ < num_rows_) return true;
+    return SplitBatch();
+  }
+
+  /**
+   * @return number of fields in the current row
+   */
+  uint32_t NumFields() const { return row_starts_[curr_row_ + 1] - row_starts_[curr_row_]; }
+
+  /**
+   * @param col_idx index of the field
+   * @return the field as a boolean
+   */
+  BoolVal GetBool(uint32_t col_idx);
+
+  /**
+   * @param col_idx index of the field
+   * @return the field as an integer
+   */
+  Integer GetInteger(uint32_t col_idx);
+
+  /**
+   * @param col_idx index of the field
+   * @return the field as a real
+   */
+  Real GetReal(uint32_t col_idx);
+
+  /**
+   * @param col_idx index of the field
+   * @return the field as a date
+   */
+  DateVal GetDate(uint32_t col_idx);
+
+  /**
+   * @param col_idx index of the field
+   * @return the field as a string
+   */
+  StringVal GetVarlen(uint32_t col_idx);
+
+  /**
+   * Scan function callback used to scan a chunk of the file.
+   * Convention: First argument is the opaque query state, second argument is
+   *             the thread state, and last argument is the reader over the chunk.
+   */
+  using ScanFn = void (*)(void *, void *, CSVReader *reader);
+
+  /**
+   * Scan the given file in parallel. The file is split into chunks of about K_CHUNK_SIZE bytes that
+   * start at row boundaries, and each chunk is handed to @em scan_fn with the current thread's state.
+   * @param file_name name of the file
+   * @param delimiter field delimiter
+   * @param quote quote character
+   * @param escape escape character within quoted fields
+   * @param query_state the query state
+   * @param thread_states the thread state container
+   * @param scan_fn the callback function invoked on each chunk
+   */
+  static void ParallelScan(const std::string &file_name, char delimiter, char quote, char escape, void *query_state,
+                           ThreadStateContainer *thread_states, ScanFn scan_fn);
+
+  /**
+   * Split a file into chunks of about K_CHUNK_SIZE bytes that start at row boundaries. Newlines within quoted fields
+   * are not row boundaries. If the file contains the quote character, its rows are walked serially to find them.
+   * @param file the file to split
+   * @param delimiter field delimiter
+   * @param quote quote character
+   * @param escape escape character within quoted fields
+   * @return the first byte of each chunk, followed by the end of the file
+   */
+  static std::vector<const char *> SplitChunks(const MappedFile &file, char delimiter, char quote, char escape);
+
+ private:
+  // A field of the current batch
+  struct Field {
+    const char *ptr_;
+    uint32_t len_;
+    // Whether the field was quoted. Quoted fields are never NULL.
+    bool quoted_;
+    // Whether the field contains escape sequences that must be removed before use
+    bool escaped_;
+  };
+
+  // Split the next batch of rows. Returns false if the input is exhausted.
+  bool SplitBatch();
+
+  // Return one past the end of the row starting at pos, skipping over newlines in quoted fields
+  static const char *SkipRow(const char *pos, const char *end, char delimiter, char quote, char escape);
+
+  // Split a single field starting at pos_, and consume the following delimiter or newline.
+  // Returns true if the field ends its row.
+  bool SplitField();
+
+  // Return the field at the given index in the current row, or nullptr if it is NULL or missing.
+  const Field *GetField(uint32_t col_idx) const {
+    const uint32_t idx = row_starts_[curr_row_] + col_idx;
+    if (idx >= row_starts_[curr_row_ + 1]) return nullptr;
+    const Field &field = fields_[idx];
+    return field.len_ == 0 && !field.quoted_ ? nullptr : &field;
+  }
+
+  // The field without its escape sequences
+  std::string_view Unescape(const Field &field);
+
+  // Set when the reader owns the whole file
+  std::unique_ptr<MappedFile> file_{nullptr};
+  const char *pos_;
+  const char *end_;
+  const char delimiter_;
+  const char quote_;
+  const char escape_;
+
+  // Fields of the current batch, in row-major order.
+  std::vector<Field> fields_;
+  // Index of the first field of each row in the batch, plus one past the last field.
+  std::vector<uint32_t> row_starts_;
+  // Unescaped copies of fields. A deque does not invalidate references to its elements on insertion.
+  std::deque<std::string> unescaped_;
+  uint32_t num_rows_{0};
+  uint32_t curr_row_{0};
+};
+
+}  // namespace terrier::execution::sql
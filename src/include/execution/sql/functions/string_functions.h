@@ -37,6 +37,16 @@ class EXPORT StringFunctions {
    */
   static void Length(exec::ExecutionContext *ctx, Integer *result, const StringVal &str);
 
+  /**
+   * Check if the string matches the LIKE pattern
+   */
+  static void Like(exec::ExecutionContext *ctx, BoolVal *result, const StringVal &str, const StringVal &pattern);
+
+  /**
+   * Check if the string matches the LIKE pattern, ignoring the case of letters
+   */
+  static void ILike(exec::ExecutionContext *ctx, BoolVal *result, const StringVal &str, const StringVal &pattern);
+
   /**
    * Set the string to lower case
    */
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -10,6 +12,7 @@
 #include "execution/sql/generic_hash_table.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/util/chunked_vector.h"
+#include "execution/util/hash.h"
 
 namespace libcount {
 class HLL;
@@ -28,6 +31,12 @@ class JoinHashTableIterator;
  * The main join hash table. Join hash tables are bulk-loaded through calls to
  * @em AllocInputTuple() and frozen after calling @em Build(). Thus, they're
  * write-once read-many (WORM) structures.
+ *
+ * Joins on a single integer key can also produce a runtime filter for the probe
+ * side. Each build tuple's key is given to @em AddFilterKey(), and the table
+ * then tracks the range of keys and, once built, a Bloom filter over the tuple
+ * hashes. Probe-side scans apply both to whole vectors of keys before hashing
+ * them, to drop most of the probes that cannot find a match.
  */
 class EXPORT JoinHashTable {
  public:
@@ -36,6 +45,11 @@ class EXPORT JoinHashTable {
    */
   static constexpr uint32_t K_DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * The value @hash() combines the hashes of its arguments into
+   */
+  static constexpr hash_t K_INITIAL_TUPLE_HASH = 1;
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the
    * injected @em memory, and thus, are ephemeral.
@@ -65,6 +79,28 @@ class EXPORT JoinHashTable {
    */
   byte *AllocInputTuple(hash_t hash);
 
+  /**
+   * Add the join key of a build-side tuple to the runtime filter. Once any key
+   * is added, the key of every build tuple must be added for the filter to be
+   * correct. NULL keys never match, and must not be added.
+   * @param key The integer join key of the tuple
+   */
+  void AddFilterKey(const int64_t key) noexcept {
+    min_filter_key_ = std::min(min_filter_key_, key);
+    max_filter_key_ = std::max(max_filter_key_, key);
+  }
+
+  /**
+   * Hash a single integer join key exactly like @hash() does when computing the
+   * hash of a build or probe tuple. The Bloom filter of the runtime filter holds
+   * tuple hashes, so probe keys must be hashed with this to be checked in it.
+   * @param key The integer join key
+   * @return The hash of the tuple with the given key
+   */
+  static hash_t HashFilterKey(const int64_t key) noexcept {
+    return util::Hasher::CombineHashes(K_INITIAL_TUPLE_HASH, util::Hasher::Hash<util::HashMethod::Crc>(key));
+  }
+
   /**
    * Fully construct the join hash table. Nothing is done if the join hash table
    * has already been built. After building, the table becomes read-only.
@@ -135,6 +171,28 @@ class EXPORT JoinHashTable {
    */
   bool UseConciseHashTable() const noexcept { return use_concise_ht_; }
 
+  /**
+   * Have build-side keys been added to the runtime filter?
+   */
+  bool HasFilterKeys() const noexcept { return min_filter_key_ <= max_filter_key_; }
+
+  /**
+   * Return the smallest key added to the runtime filter. If no keys were added,
+   * this is larger than @em GetMaxFilterKey(), and the range is empty.
+   */
+  int64_t GetMinFilterKey() const noexcept { return min_filter_key_; }
+
+  /**
+   * Return the largest key added to the runtime filter
+   */
+  int64_t GetMaxFilterKey() const noexcept { return max_filter_key_; }
+
+  /**
+   * Return the Bloom filter over the hashes of all build tuples, or nullptr if
+   * the table has not been built or no keys were added to the runtime filter
+   */
+  const BloomFilter *GetBloomFilter() const noexcept { return bloom_filter_built_ ? &bloom_filter_ : nullptr; }
+
  private:
   friend class execution::sql::test::JoinHashTableTest;
 
@@ -149,6 +207,9 @@ class EXPORT JoinHashTable {
   void BuildGenericHashTable() noexcept;
   void BuildConciseHashTable();
 
+  // Add the hashes of all entries to the Bloom filter of the runtime filter
+  void BuildBloomFilter();
+
   // Dispatched from BuildGenericHashTable()
   template <bool Prefetch>
   void BuildGenericHashTableInternal() noexcept;
@@ -186,6 +247,9 @@ class EXPORT JoinHashTable {
   void MergeIncomplete(JoinHashTable *source);
 
  private:
+  // The memory pool all build-side input is allocated from
+  MemoryPool *memory_;
+
   // The vector where we store the build-side input
   util::ChunkedVector<MemoryPoolAllocator<byte>> entries_;
 
@@ -200,8 +264,13 @@ class EXPORT JoinHashTable {
   // The concise hash table
   ConciseHashTable concise_hash_table_;
 
-  // The bloom filter
+  // The bloom filter over the hashes of all entries, part of the runtime filter
   BloomFilter bloom_filter_;
+  bool bloom_filter_built_;
+
+  // The range of build-side keys, the other part of the runtime filter
+  int64_t min_filter_key_;
+  int64_t max_filter_key_;
 
   // Estimator of unique elements
   std::unique_ptr<libcount::HLL> hll_estimator_;
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "execution/util/execution_common.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * A SQL LIKE pattern, classified once so that it can be matched against many strings. In a pattern, '%' matches any
+ * sequence of characters, '_' matches any single character, and the escape character makes the character after it
+ * match only itself. Patterns that only anchor a literal at the start, end, or anywhere in a string are matched with
+ * comparisons and a SIMD substring search instead of the general wildcard matcher.
+ *
+ * Matching is done on bytes: '_' matches a single byte, and case insensitive matching only folds ASCII letters.
+ * A pattern does not copy the text it was created from, which must outlive it.
+ */
+class EXPORT LikePattern {
+ public:
+  /**
+   * The default escape character, as in SQL
+   */
+  static constexpr char K_DEFAULT_ESCAPE = '\\';
+
+  /**
+   * The shape of a pattern, which determines how it is matched
+   */
+  enum class Kind : uint8_t {
+    /** No wildcards: 'abc' */
+    Exact,
+    /** A literal followed by '%': 'abc%' */
+    Prefix,
+    /** '%' followed by a literal: '%abc' */
+    Suffix,
+    /** A literal surrounded by '%': '%abc%' */
+    Contains,
+    /** Anything else, including any pattern with '_' or escapes */
+    General,
+  };
+
+  /**
+   * Classify the given pattern
+   * @param pattern The text of the pattern
+   * @param case_insensitive Whether the pattern is for ILIKE, and ignores the case of letters
+   * @param escape The escape character
+   */
+  explicit LikePattern(std::string_view pattern, bool case_insensitive = false, char escape = K_DEFAULT_ESCAPE);
+
+  /**
+   * @return How this pattern is matched
+   */
+  Kind GetKind() const { return kind_; }
+
+  /**
+   * @return The literal the pattern compares against, for all but general patterns
+   */
+  std::string_view GetLiteral() const { return literal_; }
+
+  /**
+   * @return True if the pattern ignores the case of letters
+   */
+  bool IsCaseInsensitive() const { return case_insensitive_; }
+
+  /**
+   * @param str The string to match
+   * @return True if the whole string matches the pattern
+   */
+  bool Matches(std::string_view str) const;
+
+  /**
+   * Find the first occurrence of a string in another one
+   * @tparam CaseInsensitive Whether to ignore the case of ASCII letters
+   * @param haystack The string to search
+   * @param needle The string to search for
+   * @return The position of the first occurrence, or std::string_view::npos if there is none
+   */
+  template <bool CaseInsensitive>
+  static std::size_t Find(std::string_view haystack, std::string_view needle);
+
+ private:
+  template <bool CaseInsensitive>
+  bool MatchesImpl(std::string_view str) const;
+
+  template <bool CaseInsensitive>
+  bool MatchesGeneral(std::string_view str) const;
+
+ private:
+  std::string_view pattern_;
+  std::string_view literal_;
+  Kind kind_;
+  bool case_insensitive_;
+  char escape_;
+};
+
+}  // namespace terrier::execution::sql
@@ -2,42 +2,66 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <atomic>
+
 namespace terrier::execution::sql {
 
 /**
- * TODO: track memory usage
+ * Tracks the memory allocated by a query, and the budget it should stay within. Allocations never fail because of the
+ * budget. Instead, operators that can spill to disk, like partitioned aggregations and sorts, check IsOverLimit() and
+ * move their data out of memory once the query exceeds it.
  */
 class MemoryTracker {
  public:
   // TODO(pmenon): Fill me in
 
   /**
-   * Reset tracker
+   * Reset tracker. The counter is atomic because the tracker is shared by all threads of a parallel pipeline.
    */
   void Reset() { allocated_bytes_ = 0; }
 
   /**
    * @returns number of allocated bytes
    */
-  size_t GetAllocatedSize() { return allocated_bytes_; }
+  size_t GetAllocatedSize() { return allocated_bytes_.load(std::memory_order_relaxed); }
 
   /**
    * Increments number of allocated bytes
    * @param size number to increment by
    */
-  void Increment(size_t size) { allocated_bytes_ += size; }
+  void Increment(size_t size) { allocated_bytes_.fetch_add(size, std::memory_order_relaxed); }
 
   /**
    * Decrements number of allocated bytes
    * @param size number to decrement by
    */
-  void Decrement(size_t size) { allocated_bytes_ -= size; }
+  void Decrement(size_t size) { allocated_bytes_.fetch_sub(size, std::memory_order_relaxed); }
+
+  /**
+   * Set the memory budget of the query
+   * @param limit maximum number of bytes the query should allocate, 0 for no limit
+   */
+  void SetMemoryLimit(size_t limit) { memory_limit_ = limit; }
+
+  /**
+   * @returns the memory budget of the query in bytes, 0 if there is no limit
+   */
+  size_t GetMemoryLimit() const { return memory_limit_; }
+
+  /**
+   * @returns true if the query has allocated more memory than its budget
+   */
+  bool IsOverLimit() const {
+    return memory_limit_ != 0 && allocated_bytes_.load(std::memory_order_relaxed) > memory_limit_;
+  }
 
  private:
   struct Stats {};
   tbb::enumerable_thread_specific<Stats> stats_;
   // number of bytes allocated
-  size_t allocated_bytes_;
+  std::atomic<size_t> allocated_bytes_{0};
+  // maximum number of bytes the query should allocate, 0 for no limit
+  size_t memory_limit_{0};
 };
 
 }  // namespace terrier::execution::sql
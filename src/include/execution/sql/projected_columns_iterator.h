@@ -6,10 +6,20 @@
 
 #include "common/macros.h"
 #include "execution/util/bit_util.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/util/execution_common.h"
+#include "parser/expression_defs.h"
+#include "type/transient_value.h"
 #include "type/type_id.h"
 
+namespace terrier::storage {
+class ArrowColumnInfo;
+}  // namespace terrier::storage
+
 namespace terrier::execution::sql {
+
+class JoinHashTable;
+
 /**
  * An iterator over projections. A ProjectedColumnsIterator allows both
  * tuple-at-a-time iteration over a vector projection and vector-at-a-time
@@ -50,6 +60,14 @@ class EXPORT ProjectedColumnsIterator {
    */
   void SetProjectedColumn(storage::ProjectedColumns *projected_column);
 
+  /**
+   * Let filters use the compressed storage of the columns of the current projection, which was read in place from a
+   * frozen block. Filters then evaluate predicates on dictionary codes, on whole runs of run-length encoded integers,
+   * or on bit-packed integers, instead of the decoded values. This lasts until the next call to SetProjectedColumn().
+   * @param frozen_columns the Arrow storage of every column in the projection, which must outlive the projection
+   */
+  void SetFrozenColumns(const storage::ArrowColumnInfo *const *frozen_columns) { frozen_columns_ = frozen_columns; }
+
   // -------------------------------------------------------
   // Tuple-at-a-time API
   // -------------------------------------------------------
@@ -166,6 +184,22 @@ class EXPORT ProjectedColumnsIterator {
      * an int64_t filter value
      */
     int64_t bi_;
+    /**
+     * a date filter value
+     */
+    uint32_t date_;
+    /**
+     * a timestamp filter value
+     */
+    uint64_t ts_;
+    /**
+     * a decimal filter value
+     */
+    double dec_;
+    /**
+     * a varlen filter value
+     */
+    const storage::VarlenEntry *str_;
   };
 
   /**
@@ -184,13 +218,20 @@ class EXPORT ProjectedColumnsIterator {
         return FilterVal{.i_ = static_cast<int32_t>(val)};
       case type::TypeId::BIGINT:
         return FilterVal{.bi_ = static_cast<int64_t>(val)};
+      case type::TypeId::DATE:
+        return FilterVal{.date_ = static_cast<uint32_t>(val)};
+      case type::TypeId::TIMESTAMP:
+        return FilterVal{.ts_ = static_cast<uint64_t>(val)};
+      case type::TypeId::DECIMAL:
+        return FilterVal{.dec_ = static_cast<double>(val)};
       default:
         throw std::runtime_error("Filter not supported on type");
     }
   }
 
   /**
-   * Filter the column at index @em col_idx by the given constant value @em val.
+   * Filter the column at index @em col_idx by the given constant value @em val. Varlen columns are compared
+   * lexicographically with the entry that @em val points to. NULL values are never selected.
    * @tparam Op The filtering operator.
    * @param col_idx The index of the column in the projection to filter.
    * @param type The type of the column.
@@ -213,11 +254,50 @@ class EXPORT ProjectedColumnsIterator {
   template <template <typename> typename Op>
   uint32_t FilterColByCol(uint32_t col_idx_1, type::TypeId type_1, uint32_t col_idx_2, type::TypeId type_2);
 
+  /**
+   * Filter the varlen column at index @em col_idx by whether its values match the given LIKE pattern. NULL values are
+   * always filtered out.
+   * @param col_idx The index of the column in the projection to filter.
+   * @param pattern The pattern to match.
+   * @param negate Whether to select the values that do not match the pattern instead, as in NOT LIKE.
+   * @return The number of selected elements.
+   */
+  uint32_t FilterColByLike(uint32_t col_idx, const LikePattern &pattern, bool negate);
+
+  /**
+   * Filter the integer column at index @em col_idx by the runtime filter of a built join hash table, keeping only the
+   * keys that may find a match on the build side. NULL values never match, and are always filtered out.
+   * @param col_idx The index of the column in the projection to filter.
+   * @param type The type of the column.
+   * @param join_hash_table The join hash table, whose build side added its keys to the runtime filter.
+   * @return The number of selected elements.
+   */
+  uint32_t FilterColByJoinKeys(uint32_t col_idx, type::TypeId type, const JoinHashTable &join_hash_table);
+
+  /**
+   * Filter the column at index @em col_idx by the comparison `column <comparison> param`, for a query parameter
+   * @em param that is only known when the query runs. NULL values are never selected, and nothing is selected if the
+   * parameter is NULL. The filter is skipped if the parameter cannot be compared in the column's type, such as an
+   * integer that does not fit in it, so it must be checked again a tuple at a time.
+   * @param col_idx The index of the column in the projection to filter.
+   * @param type The type of the column, an integer type or VARCHAR.
+   * @param comparison The comparison of the column to the parameter.
+   * @param param The parameter.
+   * @return The number of selected elements.
+   */
+  uint32_t FilterColByParam(uint32_t col_idx, type::TypeId type, parser::ExpressionType comparison,
+                            const type::TransientValue &param);
+
   /**
    * Return the number of selected tuples after any filters have been applied
    */
   uint32_t NumSelected() const { return num_selected_; }
 
+  /**
+   * Return the number of tuples that runtime join filters removed, over all projections iterated so far
+   */
+  uint64_t NumJoinFiltered() const { return num_join_filtered_; }
+
  private:
   // Filter a column by a constant value
   template <typename T, template <typename> typename Op>
@@ -227,6 +307,25 @@ class EXPORT ProjectedColumnsIterator {
   template <typename T, template <typename> typename Op>
   uint32_t FilterColByColImpl(uint32_t col_idx_1, uint32_t col_idx_2);
 
+  // Filter a varlen column by a constant value
+  template <template <typename> typename Op>
+  uint32_t FilterColByVarlenImpl(uint32_t col_idx, const storage::VarlenEntry &val);
+
+  // Filter a run-length encoded or bit-packed integer column of a frozen block by a constant value
+  template <typename T, template <typename> typename Op>
+  uint32_t FilterEncodedColByValImpl(uint32_t col_idx, T val);
+
+  // Filter a dictionary-compressed varlen column of a frozen block by a constant value
+  template <template <typename> typename Op>
+  uint32_t FilterDictionaryColByVarlenImpl(uint32_t col_idx, const storage::VarlenEntry &val);
+
+  // Filter an integer column by the runtime filter of a hash join
+  template <typename T>
+  uint32_t FilterColByJoinKeysImpl(uint32_t col_idx, const JoinHashTable &join_hash_table);
+
+  // Remove the tuples whose value in a column is NULL from the selection
+  void SelectNotNull(uint32_t col_idx);
+
  private:
   // The selection vector used to filter the ProjectedColumns
   alignas(common::Constants::CACHELINE_SIZE) uint32_t selection_vector_[common::Constants::K_DEFAULT_VECTOR_SIZE];
@@ -234,6 +333,9 @@ class EXPORT ProjectedColumnsIterator {
   // The projected column we are iterating over.
   storage::ProjectedColumns *projected_column_{nullptr};
 
+  // The Arrow storage of every column, if the projection was read in place from a frozen block
+  const storage::ArrowColumnInfo *const *frozen_columns_{nullptr};
+
   // The current raw position in the ProjectedColumns we're pointing to
   uint32_t curr_idx_{0};
 
@@ -245,6 +347,9 @@ class EXPORT ProjectedColumnsIterator {
 
   // The next slot in the selection vector to write into
   uint32_t selection_vector_write_idx_{0};
+
+  // The number of tuples removed by runtime join filters, over all projections
+  uint64_t num_join_filtered_{0};
 };
 
 // ---------------------------------------------------------
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace terrier::execution::sql {
@@ -12,9 +14,19 @@ class ThreadStateContainer;
 
 /**
  * Sorters
+ *
+ * If the query goes over its memory budget while tuples are inserted, the buffered tuples are sorted and written to a
+ * spill file as a sorted run, and their memory is released. Sorting a sorter that spilled writes its remaining tuples
+ * out as a final run, and iterating over it merges all runs from disk. Spilling copies tuples byte for byte, so any
+ * memory a tuple points to, like the contents of strings, stays in memory. Top-K sorts never spill.
  */
 class EXPORT Sorter {
  public:
+  /**
+   * Number of tuples inserted between checks of the memory budget
+   */
+  static constexpr uint32_t K_SPILL_CHECK_INTERVAL = 1024;
+
   /**
    * The interface of the comparison function used to sort tuples
    */
@@ -92,16 +104,51 @@ class EXPORT Sorter {
   void SortTopKParallel(const ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k);
 
   /**
-   * Return the number of tuples currently in this sorter
+   * Return the number of tuples currently in this sorter, including spilled tuples
    */
-  uint64_t NumTuples() const { return tuples_.size(); }
+  uint64_t NumTuples() const { return tuples_.size() + num_spilled_tuples_; }
+
+  /**
+   * Return the number of tuples that can be accessed by position through GetTupleAt(). Throws if the sorter spilled to
+   * disk, since spilled tuples can only be read back in order through a SorterIterator.
+   */
+  uint64_t NumTuplesForRandomAccess() const;
+
+  /**
+   * Return the tuple at the given position of this sorter. Only valid if the sorter has not spilled to disk.
+   * @param idx The position of the tuple
+   * @return A pointer to the tuple
+   */
+  const byte *GetTupleAt(uint64_t idx) const {
+    TERRIER_ASSERT(!HasSpilled() && idx < tuples_.size(), "Tuple position out of bounds");
+    return tuples_[idx];
+  }
 
   /**
    * Has this sorter's contents been sorted?
    */
   bool IsSorted() const { return sorted_; }
 
+  /**
+   * Have any tuples been spilled to disk?
+   */
+  bool HasSpilled() const { return !spilled_runs_.empty(); }
+
  private:
+  // A sorted run of tuples in a spill file
+  struct SpilledRun {
+    const SpillFile *file_;
+    uint64_t offset_;
+    uint64_t num_tuples_;
+  };
+
+  // Is the query over its memory budget?
+  bool IsOverMemoryLimit() const;
+
+  // Sort the buffered tuples, write them to the spill file as a run, and
+  // release their memory
+  void SpillRun();
+
   // Build a max heap from the tuples currently stored in the sorter instance
   void BuildHeap();
 
@@ -111,6 +158,14 @@ class EXPORT Sorter {
 
  private:
   friend class SorterIterator;
+  friend class SpilledRunMerger;
+  friend class WindowOperator;
+
+  // The memory pool
+  MemoryPool *memory_;
+
+  // The size of each tuple in bytes
+  uint32_t tuple_size_;
 
   // Vector of entries
   util::ChunkedVector<MemoryPoolAllocator<byte>> tuple_storage_;
@@ -126,10 +181,91 @@ class EXPORT Sorter {
 
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
+
+  // The file this sorter spills to, created on the first spill
+  std::unique_ptr<SpillFile> spill_file_;
+
+  // Spill files taken from thread-local sorters
+  std::vector<std::unique_ptr<SpillFile>> owned_spill_files_;
+
+  // All sorted runs on disk, and the number of tuples in them
+  std::vector<SpilledRun> spilled_runs_;
+  uint64_t num_spilled_tuples_;
+};
+
+/**
+ * Merges the sorted runs a sorter spilled to disk into one sorted sequence. Each run is read a block at a time, so
+ * only one block per run is in memory. A row stays valid until the merger advances past it.
+ */
+class EXPORT SpilledRunMerger {
+ public:
+  /**
+   * Size of the block read from each run at a time, in bytes
+   */
+  static constexpr std::size_t K_READ_BLOCK_SIZE = 256 * 1024;
+
+  /**
+   * Start merging the runs of a sorted sorter
+   * @param sorter The sorter whose runs to merge
+   */
+  explicit SpilledRunMerger(const Sorter &sorter);
+
+  /**
+   * Release all read blocks
+   */
+  ~SpilledRunMerger();
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(SpilledRunMerger);
+
+  /**
+   * @return True if there are more rows
+   */
+  bool HasNext() const { return !heap_.empty(); }
+
+  /**
+   * @return A pointer to the current row
+   */
+  const byte *GetRow() const { return heap_.front()->pos_; }
+
+  /**
+   * Advance to the next row
+   */
+  void Next();
+
+ private:
+  // Reads one run a block at a time
+  struct RunReader {
+    Sorter::SpilledRun run_;
+    uint64_t num_read_;
+    byte *block_;
+    byte *pos_;
+    byte *end_;
+  };
+
+  // Read the next block of a run, returning false if it has been read
+  bool ReadBlock(RunReader *reader);
+
+  // Order readers so the one at the smallest row is at the front of the heap
+  bool HeapCompare(const RunReader *left, const RunReader *right) const {
+    return cmp_fn_(left->pos_, right->pos_) > 0;
+  }
+
+ private:
+  MemoryPool *memory_;
+  Sorter::ComparisonFunction cmp_fn_;
+  uint32_t tuple_size_;
+  std::size_t block_size_;
+  std::vector<RunReader> readers_;
+  // Min-heap of the readers that have rows left
+  std::vector<RunReader *> heap_;
 };
 
 /**
- * An iterator over the elements in a sorter instance
+ * An iterator over the elements in a sorter instance. If the sorter spilled to disk, its runs are merged while
+ * iterating, and a row stays valid until the iterator advances past it.
  */
 class EXPORT SorterIterator {
   /**
@@ -142,20 +278,27 @@ class EXPORT SorterIterator {
    * Constructor
    * @param sorter sorter to iterate over
    */
-  explicit SorterIterator(Sorter *sorter) noexcept : iter_(sorter->tuples_.begin()), end_(sorter->tuples_.end()) {}
+  explicit SorterIterator(Sorter *sorter)
+      : iter_(sorter->tuples_.begin()),
+        end_(sorter->tuples_.end()),
+        merger_(sorter->HasSpilled() ? std::make_unique<SpilledRunMerger>(*sorter) : nullptr) {}
 
   /**
    * Dereference operator
    * @return A pointer to the current iteration row
    */
-  const byte *operator*() const noexcept { return *iter_; }
+  const byte *operator*() const noexcept { return merger_ == nullptr ? *iter_ : merger_->GetRow(); }
 
   /**
    * Pre-increment the iterator
    * @return A reference to this iterator after it's been advanced one row
    */
-  SorterIterator &operator++() noexcept {
-    ++iter_;
+  SorterIterator &operator++() {
+    if (merger_ == nullptr) {
+      ++iter_;
+    } else {
+      merger_->Next();
+    }
     return *this;
   }
 
@@ -163,7 +306,7 @@ class EXPORT SorterIterator {
    * Does this iterate have more data
    * @return True if the iterator has more data; false otherwise
    */
-  bool HasNext() const { return iter_ != end_; }
+  bool HasNext() const { return merger_ == nullptr ? iter_ != end_ : merger_->HasNext(); }
 
   /**
    * Advance the iterator
@@ -175,7 +318,7 @@ class EXPORT SorterIterator {
    * iterator is valid.
    */
   const byte *GetRow() const {
-    TERRIER_ASSERT(iter_ != end_, "Invalid iterator");
+    TERRIER_ASSERT(HasNext(), "Invalid iterator");
     return this->operator*();
   }
 
@@ -193,6 +336,8 @@ class EXPORT SorterIterator {
   IteratorType iter_;
   // The ending iterator position
   const IteratorType end_;
+  // Merges the runs of a sorter that spilled to disk, null otherwise
+  std::unique_ptr<SpilledRunMerger> merger_;
 };
 
 }  // namespace terrier::execution::sql
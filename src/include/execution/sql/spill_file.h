@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+#include "execution/util/execution_common.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * A temporary file that operators write their data to when a query exceeds its memory budget.
+ *
+ * The file is created in the directory named by TMPDIR, or /tmp, and is unlinked right away, so it goes away when it
+ * is closed, even if the process dies. Writes are appended through a buffer. Once flushed, any range of the file can be
+ * read back, from any number of threads at once.
+ */
+class EXPORT SpillFile {
+ public:
+  /**
+   * Size of the write buffer in bytes
+   */
+  static constexpr std::size_t K_WRITE_BUFFER_SIZE = 256 * 1024;
+
+  /**
+   * Create a new, empty temporary file. Throws if the file cannot be created.
+   */
+  SpillFile();
+
+  /**
+   * Close and remove the file
+   */
+  ~SpillFile();
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Append bytes to the end of the file. Throws if the file cannot be written.
+   * @param data the bytes to append
+   * @param size the number of bytes to append
+   */
+  void Append(const void *data, std::size_t size);
+
+  /**
+   * Write out all buffered bytes, so that they can be read. Throws if the file cannot be written.
+   */
+  void Flush();
+
+  /**
+   * Read a range of flushed bytes. Throws if the file cannot be read.
+   * @param offset the position of the first byte to read
+   * @param[out] buffer where the bytes are read to
+   * @param size the number of bytes to read
+   */
+  void Read(uint64_t offset, void *buffer, std::size_t size) const;
+
+  /**
+   * @return the size of the file in bytes, including buffered bytes
+   */
+  uint64_t Size() const { return size_; }
+
+ private:
+  // The file descriptor
+  int fd_;
+  // Appended bytes that have not been written yet
+  std::unique_ptr<byte[]> buffer_;
+  std::size_t buffer_size_{0};
+  // The size of the file, including buffered bytes
+  uint64_t size_{0};
+};
+
+}  // namespace terrier::execution::sql
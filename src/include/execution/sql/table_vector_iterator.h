@@ -5,13 +5,17 @@
 #include "catalog/catalog.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/projected_columns_iterator.h"
+#include "parser/expression_defs.h"
 #include "storage/sql_table.h"
+#include "type/transient_value.h"
+#include "type/type_id.h"
 
 namespace terrier::execution::sql {
 class ThreadStateContainer;
 
 /**
- * An iterator over a table's data in vector-wise fashion.
+ * An iterator over a table's data in vector-wise fashion. If the query does not write to tables, frozen blocks are
+ * read in place instead of through the transactional path, and filters can run on their compressed columns.
  * TODO(Amadou): Add a Reset() method to avoid reconstructing the object in NL joins.
  */
 class EXPORT TableVectorIterator {
@@ -47,6 +51,56 @@ class EXPORT TableVectorIterator {
    */
   bool Init();
 
+  /**
+   * Initialize the iterator over the range of blocks [start_block_idx, end_block_idx).
+   * @param start_block_idx index of the first block to scan
+   * @param end_block_idx index one past the last block to scan
+   * @return True if the initialization succeeded; false otherwise
+   */
+  bool InitRange(uint32_t start_block_idx, uint32_t end_block_idx);
+
+  /**
+   * Skip the blocks where the column at index @em col_idx of the projection has no value in the range [min, max],
+   * according to their zone maps. Calls for the same column narrow the range further, and repeating a call has no
+   * effect. Only integer, date, and timestamp columns can restrict blocks.
+   * @param col_idx index of the column in the projection
+   * @param type SQL type of the column
+   * @param min smallest value to look for
+   * @param max largest value to look for
+   */
+  void RestrictRange(uint32_t col_idx, type::TypeId type, int64_t min, int64_t max);
+
+  /**
+   * Skip the blocks where no value of the column at index @em col_idx of the projection satisfies the comparison
+   * `column <comparison> param`, where the parameter is read from the execution context. This lets code generated once
+   * for a predicate restrict its scan by the constant each run was given.
+   * @param col_idx index of the column in the projection
+   * @param type SQL type of the column
+   * @param comparison comparison of the column to the parameter
+   * @param param_idx index of the parameter in the execution context
+   */
+  void RestrictRangeToParam(uint32_t col_idx, type::TypeId type, parser::ExpressionType comparison,
+                            uint32_t param_idx);
+
+  /**
+   * Get a value as an integer comparable to the values of a column of the given type in zone maps
+   * @param col_type SQL type of the column
+   * @param value the value
+   * @param[out] result the value as an integer
+   * @return false if the value is NULL or cannot be compared in zone maps
+   */
+  static bool ValueAsInteger(type::TypeId col_type, const type::TransientValue &value, int64_t *result);
+
+  /**
+   * Get the range of values that satisfy `column <comparison> value`
+   * @param comparison the comparison
+   * @param value the value the column is compared to
+   * @param[out] min smallest value in the range
+   * @param[out] max largest value in the range
+   * @return false if the comparison does not restrict the column to a range
+   */
+  static bool ComparisonRange(parser::ExpressionType comparison, int64_t value, int64_t *min, int64_t *max);
+
   /**
    * Advance the iterator by a vector of input
    * @return True if there is more data in the iterator; false otherwise
@@ -78,17 +132,38 @@ class EXPORT TableVectorIterator {
    * callback function @em scanner on each input vector projection from the
    * source table. This call is blocking, meaning that it only returns after
    * the whole table has been scanned. Iteration order is non-deterministic.
-   * @param db_oid The ID of the database containing the table
+   * @param exec_ctx execution context of the query
    * @param table_oid The ID of the table
+   * @param col_oids array column oids to scan
+   * @param num_oids length of the array
    * @param query_state the query state
    * @param thread_states the thread state container
    * @param scan_fn The callback function invoked for vectors of table input
    * @param min_grain_size The minimum number of blocks to give a scan task
+   * @return True if the scan succeeded; false otherwise
    */
-  static bool ParallelScan(uint32_t db_oid, uint32_t table_oid, void *query_state, ThreadStateContainer *thread_states,
-                           ScanFn scan_fn, uint32_t min_grain_size = K_MIN_BLOCK_RANGE_SIZE);
+  static bool ParallelScan(exec::ExecutionContext *exec_ctx, uint32_t table_oid, uint32_t *col_oids,
+                           uint32_t num_oids, void *query_state, ThreadStateContainer *thread_states, ScanFn scan_fn,
+                           uint32_t min_grain_size = K_MIN_BLOCK_RANGE_SIZE);
 
  private:
+  // A range of values of a column in the projection that the scan looks for
+  struct ColumnRange {
+    uint32_t col_idx_;
+    // Unsigned values are compared as signed ones in zone maps, which only orders them right if none is too large
+    bool is_unsigned_;
+    int64_t min_, max_;
+  };
+
+  // Whether the iterator is past the last tuple to scan
+  bool AtEnd() const;
+
+  // Whether the zone maps of the block show that it has no tuple in the ranges looked for
+  bool CanSkipBlock(storage::RawBlock *block) const;
+
+  // Drop the in-place read lock on the frozen block of the last vector, if any
+  void ReleaseFrozenBlock();
+
   exec::ExecutionContext *exec_ctx_;
   const catalog::table_oid_t table_oid_;
   std::vector<catalog::col_oid_t> col_oids_{};
@@ -101,6 +176,16 @@ class EXPORT TableVectorIterator {
   storage::ProjectedColumns *projected_columns_ = nullptr;
   // Iterator of the slots in the PC
   std::unique_ptr<storage::DataTable::SlotIterator> iter_ = nullptr;
+  // Range of blocks to scan. The end iterator is only set when scanning a sub-range of the table.
+  uint32_t start_block_idx_ = 0;
+  std::unique_ptr<storage::DataTable::SlotIterator> end_iter_ = nullptr;
+  // Ranges of values the scan looks for, which let it skip blocks
+  std::vector<ColumnRange> column_ranges_{};
+  // The frozen block the current vector was read from in place. An in-place read lock keeps the block frozen, and its
+  // Arrow storage alive, until the next vector is read.
+  storage::RawBlock *frozen_block_ = nullptr;
+  // The Arrow storage of the projected columns in the frozen block
+  std::vector<const storage::ArrowColumnInfo *> frozen_columns_{};
 
   bool initialized_ = false;
 };
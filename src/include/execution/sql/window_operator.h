@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "common/macros.h"
+#include "execution/sql/aggregators.h"
+#include "execution/sql/memory_pool.h"
+#include "execution/sql/sorter.h"
+
+namespace terrier::execution::sql {
+
+class ThreadStateContainer;
+class WindowIterator;
+
+/**
+ * The frame of a window function, i.e., the rows of its partition that a window aggregate is computed over for each
+ * row. ROWS frames are bounded by a number of rows before or after the current row. RANGE frames are bounded by the
+ * peers of the current row, which are the rows that are equal to it in the window's ordering; only unbounded and
+ * CURRENT ROW bounds are supported for them.
+ */
+struct WindowFrame {
+  /**
+   * How the bounds of the frame are measured
+   */
+  enum class Mode : uint8_t { Rows, Range };
+
+  /**
+   * The kind of one bound of the frame
+   */
+  enum class Bound : uint8_t { UnboundedPreceding, Preceding, CurrentRow, Following, UnboundedFollowing };
+
+  /**
+   * How the bounds of the frame are measured
+   */
+  Mode mode_;
+  /**
+   * The kind of the start bound
+   */
+  Bound start_;
+  /**
+   * The number of rows of a Preceding or Following start bound
+   */
+  uint64_t start_offset_;
+  /**
+   * The kind of the end bound
+   */
+  Bound end_;
+  /**
+   * The number of rows of a Preceding or Following end bound
+   */
+  uint64_t end_offset_;
+
+  /**
+   * @return The frame used when a window has an ordering but no frame clause: RANGE BETWEEN UNBOUNDED PRECEDING AND
+   *         CURRENT ROW. Aggregates over it are running aggregates.
+   */
+  static constexpr WindowFrame Default() { return {Mode::Range, Bound::UnboundedPreceding, 0, Bound::CurrentRow, 0}; }
+
+  /**
+   * @return The frame covering the whole partition of each row
+   */
+  static constexpr WindowFrame WholePartition() {
+    return {Mode::Rows, Bound::UnboundedPreceding, 0, Bound::UnboundedFollowing, 0};
+  }
+
+  /**
+   * @param preceding The number of rows before the current row in the frame
+   * @param following The number of rows after the current row in the frame
+   * @return The sliding frame ROWS BETWEEN @em preceding PRECEDING AND @em following FOLLOWING
+   */
+  static constexpr WindowFrame Sliding(uint64_t preceding, uint64_t following) {
+    return {Mode::Rows, Bound::Preceding, preceding, Bound::Following, following};
+  }
+};
+
+/**
+ * Evaluates window functions over the rows of a sorter. The sorter must be sorted on the window's partitioning keys
+ * followed by its ordering keys, which can be done with any of its sorts, including the parallel one.
+ *
+ * The operator is given two comparison functions. The partition function only compares partitioning keys, and the peer
+ * function compares the partitioning keys and the ordering keys. Either can be null: with no partition function all
+ * rows are one partition, and with no peer function all rows of a partition are peers.
+ *
+ * Rows are visited through a WindowIterator, which provides the ranking functions of the current row and the bounds of
+ * its frames. Frame aggregates are computed with a WindowSegmentTree over the rows of the current partition. Since
+ * partitions are independent, ExecuteParallelScan() processes them in parallel.
+ */
+class EXPORT WindowOperator {
+ public:
+  /**
+   * Function to scan a range of partitions of the window.
+   * Convention: First argument is query state, second argument is thread-local
+   *             state, last argument is an iterator over the range.
+   */
+  using ScanPartitionFn = void (*)(void *, void *, WindowIterator *);
+
+  /**
+   * Construct a window over the rows of the given sorter. Throws if the sorter spilled to disk, since frames need
+   * random access to the rows of a partition.
+   * @param sorter The sorted input
+   * @param partition_cmp_fn The function comparing the partitioning keys of two rows, or null
+   * @param peer_cmp_fn The function comparing the partitioning and ordering keys of two rows, or null
+   */
+  WindowOperator(const Sorter &sorter, Sorter::ComparisonFunction partition_cmp_fn,
+                 Sorter::ComparisonFunction peer_cmp_fn);
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(WindowOperator);
+
+  /**
+   * @return The number of rows in the window
+   */
+  uint64_t NumRows() const { return num_rows_; }
+
+  /**
+   * @return The number of partitions in the window
+   */
+  uint64_t NumPartitions() const { return partition_begins_.size() - 1; }
+
+  /**
+   * Scan all partitions in parallel. Each invocation of the scan function receives an iterator over a range of whole
+   * partitions, and the thread state of the thread running it. The scan function must be thread-safe.
+   * @param query_state The (opaque) query state.
+   * @param thread_states The container holding all thread states.
+   * @param scan_fn The callback scan function.
+   */
+  void ExecuteParallelScan(void *query_state, ThreadStateContainer *thread_states, ScanPartitionFn scan_fn) const;
+
+ private:
+  friend class WindowIterator;
+
+  // The sorted rows
+  const byte *const *rows_;
+  // The number of rows
+  uint64_t num_rows_;
+  // The function comparing the partitioning and ordering keys
+  Sorter::ComparisonFunction peer_cmp_fn_;
+  // The position of the first row of each partition, followed by the number of rows
+  MemPoolVector<uint64_t> partition_begins_;
+};
+
+/**
+ * An iterator over the rows of a range of partitions of a window
+ */
+class EXPORT WindowIterator {
+ public:
+  /**
+   * Construct an iterator over all partitions of the window
+   * @param window The window to iterate over
+   */
+  explicit WindowIterator(const WindowOperator &window) : WindowIterator(window, 0, window.NumPartitions()) {}
+
+  /**
+   * Construct an iterator over the partitions [@em begin_partition, @em end_partition) of the window
+   * @param window The window to iterate over
+   * @param begin_partition The first partition to visit
+   * @param end_partition The partition after the last one to visit
+   */
+  WindowIterator(const WindowOperator &window, uint64_t begin_partition, uint64_t end_partition);
+
+  /**
+   * @return True if the iterator has more rows; false otherwise
+   */
+  bool HasNext() const { return pos_ < end_; }
+
+  /**
+   * Advance the iterator to the next row
+   */
+  void Next();
+
+  /**
+   * @return A pointer to the current row
+   */
+  const byte *GetRow() const {
+    TERRIER_ASSERT(HasNext(), "Invalid iterator");
+    return window_.rows_[pos_];
+  }
+
+  /**
+   * @return A pointer to the current row, interpreted as the template type @em T
+   */
+  template <typename T>
+  const T *GetRowAs() const {
+    return reinterpret_cast<const T *>(GetRow());
+  }
+
+  /**
+   * @return True if the current row is the first of its partition
+   */
+  bool IsPartitionStart() const { return pos_ == partition_begin_; }
+
+  /**
+   * @return The rows of the current partition
+   */
+  const byte *const *GetPartitionRows() const { return window_.rows_ + partition_begin_; }
+
+  /**
+   * @return The number of rows in the current partition
+   */
+  uint64_t GetPartitionSize() const { return partition_end_ - partition_begin_; }
+
+  /**
+   * @return The position of the current row in its partition
+   */
+  uint64_t GetPartitionOffset() const { return pos_ - partition_begin_; }
+
+  /**
+   * @return ROW_NUMBER() of the current row: its position in its partition, starting at one
+   */
+  uint64_t GetRowNumber() const { return GetPartitionOffset() + 1; }
+
+  /**
+   * @return RANK() of the current row: the row number of its first peer
+   */
+  uint64_t GetRank() const { return peer_begin_ - partition_begin_ + 1; }
+
+  /**
+   * @return DENSE_RANK() of the current row: the number of distinct peer groups up to and including its own
+   */
+  uint64_t GetDenseRank() const { return dense_rank_; }
+
+  /**
+   * Compute the bounds of the current row's frame, as positions in its partition
+   * @param frame The frame of the window function
+   * @return The frame's first position, and the position after its last one. The frame is empty if they are equal.
+   */
+  std::pair<uint64_t, uint64_t> GetFrame(const WindowFrame &frame) const;
+
+ private:
+  // Enter the partition that starts at the current position
+  void StartPartition();
+
+  // Find the end of the peer group that starts at the current position
+  void StartPeerGroup();
+
+  // The position of a frame bound, relative to the start of the partition
+  uint64_t FrameBound(const WindowFrame &frame, WindowFrame::Bound bound, uint64_t offset, bool is_end) const;
+
+ private:
+  const WindowOperator &window_;
+  // The next partition to enter
+  uint64_t next_partition_;
+  // The current row, and the row after the last one to visit
+  uint64_t pos_;
+  uint64_t end_;
+  // The bounds of the current partition
+  uint64_t partition_begin_;
+  uint64_t partition_end_;
+  // The bounds of the current row's peer group
+  uint64_t peer_begin_;
+  uint64_t peer_end_;
+  // The dense rank of the current peer group
+  uint64_t dense_rank_;
+};
+
+/**
+ * A segment tree over the rows of a window partition, to compute aggregates over arbitrary frames in logarithmic time.
+ * Every node holds the partial aggregate of a range of rows, and a frame's aggregate is the merge of the O(log n)
+ * nodes that cover it. This evaluates sliding frames in O(n log n) per partition instead of O(n * frame size).
+ *
+ * The aggregate type is any of the aggregates in aggregators.h, or any other default constructible type with Reset()
+ * and Merge() functions. Since nodes are merged out of order, the merge must be commutative.
+ *
+ * @tparam AggType The type of the aggregate
+ */
+template <typename AggType>
+class WindowSegmentTree {
+ public:
+  /**
+   * Create an empty tree
+   */
+  WindowSegmentTree() = default;
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(WindowSegmentTree);
+
+  /**
+   * Build the tree over the rows of a partition. Memory is reused across calls.
+   * @tparam F The type of the function advancing an aggregate by a row
+   * @param rows The rows of the partition
+   * @param num_rows The number of rows in the partition
+   * @param advance The function advancing an aggregate by a row, as advance(AggType *agg, const byte *row)
+   */
+  template <typename F>
+  void Build(const byte *const *rows, uint64_t num_rows, F &&advance) {
+    static_assert(std::is_invocable_v<F, AggType *, const byte *>);
+    num_leaves_ = num_rows;
+    if (num_leaves_ == 0) {
+      return;
+    }
+    if (2 * num_leaves_ > capacity_) {
+      capacity_ = std::max<uint64_t>(2 * num_leaves_, 64);
+      nodes_ = std::make_unique<AggType[]>(capacity_);
+    }
+    // Leaves are at [n, 2n), and every other node i merges the nodes 2i and 2i+1
+    for (uint64_t i = 0; i < num_leaves_; i++) {
+      AggType &leaf = nodes_[num_leaves_ + i];
+      leaf.Reset();
+      advance(&leaf, rows[i]);
+    }
+    for (uint64_t i = num_leaves_ - 1; i > 0; i--) {
+      nodes_[i].Reset();
+      nodes_[i].Merge(nodes_[2 * i]);
+      nodes_[i].Merge(nodes_[2 * i + 1]);
+    }
+  }
+
+  /**
+   * Compute the aggregate over a range of rows
+   * @param begin The first row of the range
+   * @param end The row after the last row of the range
+   * @param[out] result The aggregate to write the result to. It is reset, so an empty range has the aggregate's
+   *                    initial value.
+   */
+  void Query(uint64_t begin, uint64_t end, AggType *result) const {
+    TERRIER_ASSERT(begin <= end && end <= num_leaves_, "Range out of bounds");
+    result->Reset();
+    for (begin += num_leaves_, end += num_leaves_; begin < end; begin >>= 1, end >>= 1) {
+      if ((begin & 1) != 0) result->Merge(nodes_[begin++]);
+      if ((end & 1) != 0) result->Merge(nodes_[--end]);
+    }
+  }
+
+ private:
+  // The nodes of the tree
+  std::unique_ptr<AggType[]> nodes_;
+  // The number of nodes allocated
+  uint64_t capacity_{0};
+  // The number of rows the tree is built over
+  uint64_t num_leaves_{0};
+};
+
+// The segment trees exposed to TPL, one for each aggregate in aggregators.h that can be computed over a frame.
+// COUNT(*) over a frame is just its size, so it has no tree.
+
+/**
+ * COUNT() over frames
+ */
+using CountWindowTree = WindowSegmentTree<CountAggregate>;
+/**
+ * AVG() over frames of an integer or a real column
+ */
+using AvgWindowTree = WindowSegmentTree<AvgAggregate>;
+/**
+ * MAX() over frames of an integer column
+ */
+using IntegerMaxWindowTree = WindowSegmentTree<IntegerMaxAggregate>;
+/**
+ * MIN() over frames of an integer column
+ */
+using IntegerMinWindowTree = WindowSegmentTree<IntegerMinAggregate>;
+/**
+ * SUM() over frames of an integer column
+ */
+using IntegerSumWindowTree = WindowSegmentTree<IntegerSumAggregate>;
+/**
+ * MAX() over frames of a real column
+ */
+using RealMaxWindowTree = WindowSegmentTree<RealMaxAggregate>;
+/**
+ * MIN() over frames of a real column
+ */
+using RealMinWindowTree = WindowSegmentTree<RealMinAggregate>;
+/**
+ * SUM() over frames of a real column
+ */
+using RealSumWindowTree = WindowSegmentTree<RealSumAggregate>;
+
+}  // namespace terrier::execution::sql
@@ -508,6 +508,14 @@ class ChunkedVector {
     std::memcpy(dest, elem, ElementSize());
   }
 
+  /**
+   * Remove all elements from the vector, releasing all memory back to the allocator.
+   */
+  void clear() noexcept {  // NOLINT
+    DeallocateAll();
+    num_elements_ = 0;
+  }
+
   /**
    * Remove the last element from the vector.
    */
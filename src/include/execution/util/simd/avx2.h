@@ -960,4 +960,113 @@ static inline uint32_t FilterVectorByVector(const T *RESTRICT in_1, const T *RES
   return out_pos;
 }
 
+// ---------------------------------------------------------
+// Floating-point Filter
+// ---------------------------------------------------------
+
+template <template <typename> typename Compare>
+static inline uint32_t FilterDoubleVectorByVal(const double *RESTRICT in, uint32_t in_count, double val,
+                                               uint32_t *RESTRICT out, const uint32_t *RESTRICT sel,
+                                               uint32_t *RESTRICT in_pos) {
+  constexpr int predicate = FloatComparePredicate<Compare>::VALUE;
+
+  const __m256d xval = _mm256_set1_pd(val);
+
+  uint32_t out_pos = 0;
+
+  if (sel == nullptr) {
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      const __m256d in_vec = _mm256_loadu_pd(in + *in_pos);
+      const Vec4Mask mask(_mm256_castpd_si256(_mm256_cmp_pd(in_vec, xval, predicate)));
+      out_pos += mask.ToPositions(out + out_pos, *in_pos);
+    }
+  } else {
+    Vec4 sel_vec;
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      sel_vec.Load(sel + *in_pos);
+      const __m256d in_vec = _mm256_i64gather_pd(in, sel_vec, sizeof(double));
+      const Vec4Mask mask(_mm256_castpd_si256(_mm256_cmp_pd(in_vec, xval, predicate)));
+      out_pos += mask.ToPositions(out + out_pos, sel_vec);
+    }
+  }
+
+  return out_pos;
+}
+
+template <template <typename> typename Compare>
+static inline uint32_t FilterDoubleVectorByVector(const double *RESTRICT in_1, const double *RESTRICT in_2,
+                                                  const uint32_t in_count, uint32_t *RESTRICT out,
+                                                  const uint32_t *RESTRICT sel, uint32_t *RESTRICT in_pos) {
+  constexpr int predicate = FloatComparePredicate<Compare>::VALUE;
+
+  uint32_t out_pos = 0;
+
+  if (sel == nullptr) {
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      const __m256d in_1_vec = _mm256_loadu_pd(in_1 + *in_pos);
+      const __m256d in_2_vec = _mm256_loadu_pd(in_2 + *in_pos);
+      const Vec4Mask mask(_mm256_castpd_si256(_mm256_cmp_pd(in_1_vec, in_2_vec, predicate)));
+      out_pos += mask.ToPositions(out + out_pos, *in_pos);
+    }
+  } else {
+    Vec4 sel_vec;
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      sel_vec.Load(sel + *in_pos);
+      const __m256d in_1_vec = _mm256_i64gather_pd(in_1, sel_vec, sizeof(double));
+      const __m256d in_2_vec = _mm256_i64gather_pd(in_2, sel_vec, sizeof(double));
+      const Vec4Mask mask(_mm256_castpd_si256(_mm256_cmp_pd(in_1_vec, in_2_vec, predicate)));
+      out_pos += mask.ToPositions(out + out_pos, sel_vec);
+    }
+  }
+
+  return out_pos;
+}
+
+// ---------------------------------------------------------
+// Varlen Header Filter
+// ---------------------------------------------------------
+
+/**
+ * Find the 16-byte varlen entries whose first 64-bit word is equal to @em header after masking it with @em mask.
+ * @param in The varlen entries, as pairs of 64-bit words.
+ * @param in_count The number of entries in the input (or selection) vector.
+ * @param header The masked word to look for.
+ * @param mask The mask to apply to the first word of every entry.
+ * @param[out] out The vector storing indexes of matching entries.
+ * @param sel The selection vector used to read input entries.
+ * @param[out] in_pos The number of input (or selection) vector elements processed.
+ * @return The number of matching entries.
+ */
+static inline uint32_t FilterVarlenHeaders(const uint64_t *RESTRICT in, uint32_t in_count, uint64_t header,
+                                           uint64_t mask, uint32_t *RESTRICT out, const uint32_t *RESTRICT sel,
+                                           uint32_t *RESTRICT in_pos) {
+  const Vec4 xheader(static_cast<int64_t>(header));
+  const Vec4 xmask(static_cast<int64_t>(mask));
+
+  uint32_t out_pos = 0;
+
+  if (sel == nullptr) {
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      const auto *words = reinterpret_cast<const __m256i *>(in + 2 * *in_pos);
+      const __m256i lo = _mm256_loadu_si256(words);
+      const __m256i hi = _mm256_loadu_si256(words + 1);
+      // Interleaving yields the headers in the order [0, 2, 1, 3]
+      const Vec4 headers(_mm256_permute4x64_epi64(_mm256_unpacklo_epi64(lo, hi), 0xD8));
+      const Vec4Mask matches = (headers & xmask) == xheader;
+      out_pos += matches.ToPositions(out + out_pos, *in_pos);
+    }
+  } else {
+    Vec4 sel_vec;
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      sel_vec.Load(sel + *in_pos);
+      const Vec4 headers(
+          _mm256_i64gather_epi64(reinterpret_cast<const long long *>(in), sel_vec << 1, sizeof(uint64_t)));  // NOLINT
+      const Vec4Mask matches = (headers & xmask) == xheader;
+      out_pos += matches.ToPositions(out + out_pos, sel_vec);
+    }
+  }
+
+  return out_pos;
+}
+
 }  // namespace terrier::execution::util::simd
@@ -1042,4 +1042,112 @@ static inline uint32_t FilterVectorByVector(const T *RESTRICT in_1, const T *RES
   return out_pos;
 }
 
+// ---------------------------------------------------------
+// Floating-point Filter
+// ---------------------------------------------------------
+
+template <template <typename> typename Compare>
+static inline uint32_t FilterDoubleVectorByVal(const double *RESTRICT in, uint32_t in_count, double val,
+                                               uint32_t *RESTRICT out, const uint32_t *RESTRICT sel,
+                                               uint32_t *RESTRICT in_pos) {
+  constexpr int predicate = FloatComparePredicate<Compare>::VALUE;
+
+  const __m512d xval = _mm512_set1_pd(val);
+
+  uint32_t out_pos = 0;
+
+  if (sel == nullptr) {
+    for (*in_pos = 0; *in_pos + Vec8::Size() < in_count; *in_pos += Vec8::Size()) {
+      const __m512d in_vec = _mm512_loadu_pd(in + *in_pos);
+      const Vec8Mask mask(_mm512_cmp_pd_mask(in_vec, xval, predicate));
+      out_pos += mask.ToPositions(out + out_pos, *in_pos);
+    }
+  } else {
+    Vec8 sel_vec;
+    for (*in_pos = 0; *in_pos + Vec8::Size() < in_count; *in_pos += Vec8::Size()) {
+      sel_vec.Load(sel + *in_pos);
+      const __m512d in_vec = _mm512_i64gather_pd(sel_vec, in, sizeof(double));
+      const Vec8Mask mask(_mm512_cmp_pd_mask(in_vec, xval, predicate));
+      out_pos += mask.ToPositions(out + out_pos, sel_vec);
+    }
+  }
+
+  return out_pos;
+}
+
+template <template <typename> typename Compare>
+static inline uint32_t FilterDoubleVectorByVector(const double *RESTRICT in_1, const double *RESTRICT in_2,
+                                                  const uint32_t in_count, uint32_t *RESTRICT out,
+                                                  const uint32_t *RESTRICT sel, uint32_t *RESTRICT in_pos) {
+  constexpr int predicate = FloatComparePredicate<Compare>::VALUE;
+
+  uint32_t out_pos = 0;
+
+  if (sel == nullptr) {
+    for (*in_pos = 0; *in_pos + Vec8::Size() < in_count; *in_pos += Vec8::Size()) {
+      const __m512d in_1_vec = _mm512_loadu_pd(in_1 + *in_pos);
+      const __m512d in_2_vec = _mm512_loadu_pd(in_2 + *in_pos);
+      const Vec8Mask mask(_mm512_cmp_pd_mask(in_1_vec, in_2_vec, predicate));
+      out_pos += mask.ToPositions(out + out_pos, *in_pos);
+    }
+  } else {
+    Vec8 sel_vec;
+    for (*in_pos = 0; *in_pos + Vec8::Size() < in_count; *in_pos += Vec8::Size()) {
+      sel_vec.Load(sel + *in_pos);
+      const __m512d in_1_vec = _mm512_i64gather_pd(sel_vec, in_1, sizeof(double));
+      const __m512d in_2_vec = _mm512_i64gather_pd(sel_vec, in_2, sizeof(double));
+      const Vec8Mask mask(_mm512_cmp_pd_mask(in_1_vec, in_2_vec, predicate));
+      out_pos += mask.ToPositions(out + out_pos, sel_vec);
+    }
+  }
+
+  return out_pos;
+}
+
+// ---------------------------------------------------------
+// Varlen Header Filter
+// ---------------------------------------------------------
+
+/**
+ * Find the 16-byte varlen entries whose first 64-bit word is equal to @em header after masking it with @em mask.
+ * @param in The varlen entries, as pairs of 64-bit words.
+ * @param in_count The number of entries in the input (or selection) vector.
+ * @param header The masked word to look for.
+ * @param mask The mask to apply to the first word of every entry.
+ * @param[out] out The vector storing indexes of matching entries.
+ * @param sel The selection vector used to read input entries.
+ * @param[out] in_pos The number of input (or selection) vector elements processed.
+ * @return The number of matching entries.
+ */
+static inline uint32_t FilterVarlenHeaders(const uint64_t *RESTRICT in, uint32_t in_count, uint64_t header,
+                                           uint64_t mask, uint32_t *RESTRICT out, const uint32_t *RESTRICT sel,
+                                           uint32_t *RESTRICT in_pos) {
+  const __m512i xheader = _mm512_set1_epi64(static_cast<int64_t>(header));
+  const __m512i xmask = _mm512_set1_epi64(static_cast<int64_t>(mask));
+
+  uint32_t out_pos = 0;
+
+  if (sel == nullptr) {
+    // The even words of two consecutive registers
+    const __m512i even = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+    for (*in_pos = 0; *in_pos + Vec8::Size() < in_count; *in_pos += Vec8::Size()) {
+      const uint64_t *words = in + 2 * *in_pos;
+      const __m512i headers =
+          _mm512_permutex2var_epi64(_mm512_loadu_si512(words), even, _mm512_loadu_si512(words + Vec8::Size()));
+      const Vec8Mask matches(_mm512_cmpeq_epi64_mask(_mm512_and_si512(headers, xmask), xheader));
+      out_pos += matches.ToPositions(out + out_pos, *in_pos);
+    }
+  } else {
+    Vec8 sel_vec;
+    for (*in_pos = 0; *in_pos + Vec8::Size() < in_count; *in_pos += Vec8::Size()) {
+      sel_vec.Load(sel + *in_pos);
+      const __m512i headers = _mm512_i64gather_epi64(_mm512_slli_epi64(sel_vec, 1), in, sizeof(uint64_t));
+      const Vec8Mask matches(_mm512_cmpeq_epi64_mask(_mm512_and_si512(headers, xmask), xheader));
+      out_pos += matches.ToPositions(out + out_pos, sel_vec);
+    }
+  }
+
+  return out_pos;
+}
+
 }  // namespace terrier::execution::util::simd
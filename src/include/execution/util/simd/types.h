@@ -1,5 +1,9 @@
 #pragma once
 
+#include <immintrin.h>
+
+#include <functional>
+
 #include "execution/util/execution_common.h"
 
 namespace terrier::execution::util::simd {
@@ -64,4 +68,65 @@ alignas(64) static constexpr const uint64_t K4_BIT_MATCH_LUT[16] = {
     0x0000000100020003ull, 0x0001000200030000ull, 0x0000000200030001ull, 0x0002000300010000ull,
     0x0000000100030002ull, 0x0001000300020000ull, 0x0000000300020001ull, 0x0003000200010000ull};
 
+/**
+ * The predicate of the floating-point SIMD comparison equivalent to the comparison functor Compare. Comparisons with
+ * NaN behave as they do in scalar code, i.e., only != holds.
+ */
+template <template <typename> typename Compare>
+struct FloatComparePredicate;
+
+/**
+ * == predicate
+ */
+template <>
+struct FloatComparePredicate<std::equal_to> {
+  /** The predicate */
+  static constexpr int VALUE = _CMP_EQ_OQ;
+};
+
+/**
+ * > predicate
+ */
+template <>
+struct FloatComparePredicate<std::greater> {
+  /** The predicate */
+  static constexpr int VALUE = _CMP_GT_OQ;
+};
+
+/**
+ * >= predicate
+ */
+template <>
+struct FloatComparePredicate<std::greater_equal> {
+  /** The predicate */
+  static constexpr int VALUE = _CMP_GE_OQ;
+};
+
+/**
+ * < predicate
+ */
+template <>
+struct FloatComparePredicate<std::less> {
+  /** The predicate */
+  static constexpr int VALUE = _CMP_LT_OQ;
+};
+
+/**
+ * <= predicate
+ */
+template <>
+struct FloatComparePredicate<std::less_equal> {
+  /** The predicate */
+  static constexpr int VALUE = _CMP_LE_OQ;
+};
+
+/**
+ * != predicate
+ */
+template <>
+struct FloatComparePredicate<std::not_equal_to> {
+  /** The predicate */
+  static constexpr int VALUE = _CMP_NEQ_UQ;
+};
+
 }  // namespace terrier::execution::util::simd
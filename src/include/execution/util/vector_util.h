@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 
 #include "execution/util/execution_common.h"
 #include "execution/util/simd.h"
+#include "storage/storage_defs.h"
 
 namespace terrier::execution::util {
 
@@ -37,10 +40,13 @@ class VectorUtil {
     static_assert(std::is_same_v<bool, std::invoke_result_t<Op<T>, T, T>>);
 
     uint32_t in_pos = 0;
-#if defined(__AVX2__) || defined(__AVX512F__)
-    uint32_t out_pos = simd::FilterVectorByVal<T, Op>(in, in_count, val, out, sel, &in_pos);
-#else
     uint32_t out_pos = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    if constexpr (std::is_same_v<T, double>) {
+      out_pos = simd::FilterDoubleVectorByVal<Op>(in, in_count, val, out, sel, &in_pos);
+    } else if constexpr (std::is_integral_v<T>) {
+      out_pos = simd::FilterVectorByVal<T, Op>(in, in_count, val, out, sel, &in_pos);
+    }
 #endif
 
     if (sel == nullptr) {
@@ -81,10 +87,13 @@ class VectorUtil {
     static_assert(std::is_same_v<bool, std::invoke_result_t<Op<T>, T, T>>);
 
     uint32_t in_pos = 0;
-#if defined(__AVX2__) || defined(__AVX512F__)
-    uint32_t out_pos = simd::FilterVectorByVector<T, Op>(in_1, in_2, in_count, out, sel, &in_pos);
-#else
     uint32_t out_pos = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    if constexpr (std::is_same_v<T, double>) {
+      out_pos = simd::FilterDoubleVectorByVector<Op>(in_1, in_2, in_count, out, sel, &in_pos);
+    } else if constexpr (std::is_integral_v<T>) {
+      out_pos = simd::FilterVectorByVector<T, Op>(in_1, in_2, in_count, out, sel, &in_pos);
+    }
 #endif
 
     if (sel == nullptr) {
@@ -104,6 +113,45 @@ class VectorUtil {
     return out_pos;
   }
 
+  /**
+   * Filter an input vector of varlen entries by a constant value, comparing their contents lexicographically, and
+   * store the indexes of valid elements in the output vector. If a selection vector is provided, only vector elements
+   * from the selection vector will be read. Most comparisons are decided by the inline prefix of the entries, without
+   * reading their contents.
+   * @tparam Op The filter comparison operation.
+   * @param in The input vector.
+   * @param in_count The number of elements in the input (or selection) vector.
+   * @param val The constant value to compare with.
+   * @param[out] out The vector storing indexes of valid input elements.
+   * @param sel The selection vector used to read input values.
+   * @return The number of elements that pass the filter.
+   */
+  template <template <typename> typename Op>
+  static uint32_t FilterVarlenByVal(const storage::VarlenEntry *RESTRICT in, const uint32_t in_count,
+                                    const storage::VarlenEntry &val, uint32_t *RESTRICT out,
+                                    const uint32_t *RESTRICT sel) {
+    if constexpr (std::is_same_v<Op<int32_t>, std::equal_to<int32_t>>) {
+      return FilterVarlenEq(in, in_count, val, out, sel);
+    } else if constexpr (std::is_same_v<Op<int32_t>, std::not_equal_to<int32_t>>) {
+      return FilterVarlenNe(in, in_count, val, out, sel);
+    } else {
+      const Op<int32_t> cmp{};
+      uint32_t out_pos = 0;
+      if (sel == nullptr) {
+        for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+          out[out_pos] = in_pos;
+          out_pos += static_cast<uint32_t>(cmp(CompareVarlen(in[in_pos], val), 0));
+        }
+      } else {
+        for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+          out[out_pos] = sel[in_pos];
+          out_pos += static_cast<uint32_t>(cmp(CompareVarlen(in[sel[in_pos]], val), 0));
+        }
+      }
+      return out_pos;
+    }
+  }
+
   /**
    * Gather potentially non-contiguous indexes from an input vector and store
    * them into an output vector. Only elements whose indexes are stored in the
@@ -181,6 +229,110 @@ class VectorUtil {
                             uint32_t *RESTRICT sel) -> std::enable_if_t<std::is_pointer_v<T>, uint32_t> {
     return FilterNe(reinterpret_cast<const intptr_t *>(in), in_count, intptr_t(0), out, sel);
   }
+
+ private:
+  // The first eight bytes of a varlen entry hold its size, whose sign bit only marks whether the entry owns its
+  // content, followed by the first bytes of its content. Only the content bytes within the size are meaningful, so
+  // these masks select the meaningful bits of the first eight bytes of entries with the given size.
+  static uint32_t PrefixMask(const uint32_t size) {
+    const uint32_t prefix_len = std::min(size, storage::VarlenEntry::PrefixSize());
+    return prefix_len == sizeof(uint32_t) ? ~0u : (1u << (prefix_len * 8)) - 1;
+  }
+
+  static uint64_t HeaderMask(const uint32_t size) {
+    return static_cast<uint64_t>(PrefixMask(size)) << 32u | static_cast<uint32_t>(INT32_MAX);
+  }
+
+  static uint64_t Header(const storage::VarlenEntry &entry) {
+    uint64_t header;
+    std::memcpy(&header, &entry, sizeof(header));
+    return header;
+  }
+
+  // Equal entries have equal headers, and entries whose content fits in the prefix are equal if their headers are
+  static bool VarlenContentEq(const storage::VarlenEntry &a, const storage::VarlenEntry &b) {
+    const uint32_t prefix_size = storage::VarlenEntry::PrefixSize();
+    return a.Size() <= prefix_size ||
+           std::memcmp(a.Content() + prefix_size, b.Content() + prefix_size, a.Size() - prefix_size) == 0;
+  }
+
+  // Three-way lexicographic comparison that only reads contents when the prefixes are equal
+  static int32_t CompareVarlen(const storage::VarlenEntry &a, const storage::VarlenEntry &b) {
+    const uint32_t min_size = std::min(a.Size(), b.Size());
+    const uint32_t mask = PrefixMask(min_size);
+    uint32_t prefix_a, prefix_b;
+    std::memcpy(&prefix_a, a.Prefix(), sizeof(prefix_a));
+    std::memcpy(&prefix_b, b.Prefix(), sizeof(prefix_b));
+    // Big-endian order makes integer comparison lexicographic
+    prefix_a = __builtin_bswap32(prefix_a & mask);
+    prefix_b = __builtin_bswap32(prefix_b & mask);
+    if (prefix_a != prefix_b) return prefix_a < prefix_b ? -1 : 1;
+    const uint32_t prefix_size = storage::VarlenEntry::PrefixSize();
+    if (min_size > prefix_size) {
+      const int32_t result = std::memcmp(a.Content() + prefix_size, b.Content() + prefix_size, min_size - prefix_size);
+      if (result != 0) return result;
+    }
+    return static_cast<int32_t>(a.Size() > b.Size()) - static_cast<int32_t>(a.Size() < b.Size());
+  }
+
+  static uint32_t FilterVarlenEq(const storage::VarlenEntry *RESTRICT in, const uint32_t in_count,
+                                 const storage::VarlenEntry &val, uint32_t *RESTRICT out,
+                                 const uint32_t *RESTRICT sel) {
+    const uint64_t mask = HeaderMask(val.Size());
+    const uint64_t header = Header(val) & mask;
+
+    // Find the candidates whose headers match
+    uint32_t in_pos = 0;
+    uint32_t num_candidates = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    num_candidates = simd::FilterVarlenHeaders(reinterpret_cast<const uint64_t *>(in), in_count, header, mask, out,
+                                               sel, &in_pos);
+#endif
+    if (sel == nullptr) {
+      for (; in_pos < in_count; in_pos++) {
+        out[num_candidates] = in_pos;
+        num_candidates += static_cast<uint32_t>((Header(in[in_pos]) & mask) == header);
+      }
+    } else {
+      for (; in_pos < in_count; in_pos++) {
+        out[num_candidates] = sel[in_pos];
+        num_candidates += static_cast<uint32_t>((Header(in[sel[in_pos]]) & mask) == header);
+      }
+    }
+
+    // Only candidates too long for their prefix need their contents compared
+    if (val.Size() <= storage::VarlenEntry::PrefixSize()) return num_candidates;
+    uint32_t out_pos = 0;
+    for (uint32_t i = 0; i < num_candidates; i++) {
+      const uint32_t idx = out[i];
+      out[out_pos] = idx;
+      out_pos += static_cast<uint32_t>(VarlenContentEq(in[idx], val));
+    }
+    return out_pos;
+  }
+
+  static uint32_t FilterVarlenNe(const storage::VarlenEntry *RESTRICT in, const uint32_t in_count,
+                                 const storage::VarlenEntry &val, uint32_t *RESTRICT out,
+                                 const uint32_t *RESTRICT sel) {
+    const uint64_t mask = HeaderMask(val.Size());
+    const uint64_t header = Header(val) & mask;
+
+    uint32_t out_pos = 0;
+    if (sel == nullptr) {
+      for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+        const auto &entry = in[in_pos];
+        out[out_pos] = in_pos;
+        out_pos += static_cast<uint32_t>((Header(entry) & mask) != header || !VarlenContentEq(entry, val));
+      }
+    } else {
+      for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+        const auto &entry = in[sel[in_pos]];
+        out[out_pos] = sel[in_pos];
+        out_pos += static_cast<uint32_t>((Header(entry) & mask) != header || !VarlenContentEq(entry, val));
+      }
+    }
+    return out_pos;
+  }
 };
 
 }  // namespace terrier::execution::util
@@ -311,6 +311,28 @@ class BytecodeEmitter {
   void EmitTableIterInit(Bytecode bytecode, LocalVar iter, LocalVar exec_ctx, uint32_t table_oid, LocalVar col_oids,
                          uint32_t num_oids);
 
+  /**
+   * Emit code to restrict the blocks a TVI reads to the ones that may have values in a range
+   * @param iter TVI to restrict
+   * @param col_idx index of the column in the projection
+   * @param col_type type of the column
+   * @param min smallest value of the range
+   * @param max largest value of the range
+   */
+  void EmitTableIterRestrictRange(LocalVar iter, uint32_t col_idx, int8_t col_type, int64_t min, int64_t max);
+
+  /**
+   * Emit code to restrict the blocks a TVI reads to the ones that may have values satisfying a comparison of a column
+   * to a query parameter
+   * @param iter TVI to restrict
+   * @param col_idx index of the column in the projection
+   * @param col_type type of the column
+   * @param comparison the parser::ExpressionType of the comparison
+   * @param param_idx index of the parameter
+   */
+  void EmitTableIterRestrictRangeToParam(LocalVar iter, uint32_t col_idx, int8_t col_type, int8_t comparison,
+                                         uint32_t param_idx);
+
   /**
    * Emit bytecode to add a column for scanning
    * @param bytecode bytecode to emit
@@ -321,9 +343,51 @@ class BytecodeEmitter {
 
   /**
    * Emit a parallel table scan
+   * @param table_oid oid of the table
+   * @param col_oids array of column oids to scan
+   * @param num_oids length of the array
+   * @param query_state opaque query state
+   * @param exec_ctx the execution context
+   * @param thread_states the thread state container
+   * @param scan_fn function invoked on each block range
+   */
+  void EmitParallelTableScan(uint32_t table_oid, LocalVar col_oids, uint32_t num_oids, LocalVar query_state,
+                             LocalVar exec_ctx, LocalVar thread_states, FunctionId scan_fn);
+
+  /**
+   * Emit bytecode to initialize a CSV reader
+   * @param reader reader to initialize
+   * @param file_name pointer to the file name
+   * @param length length of the file name
+   * @param delimiter field delimiter
+   * @param quote quote character
+   * @param escape escape character
+   */
+  void EmitCSVReaderInit(LocalVar reader, uintptr_t file_name, uint64_t length, int8_t delimiter, int8_t quote,
+                         int8_t escape);
+
+  /**
+   * Emit bytecode to read a field from a CSV reader
+   * @param bytecode CSVReaderGet bytecode
+   * @param out destination variable
+   * @param reader reader to read from
+   * @param col_idx index of the field to read
    */
-  void EmitParallelTableScan(uint32_t db_oid, uint32_t table_oid, LocalVar ctx, LocalVar thread_states,
-                             FunctionId scan_fn);
+  void EmitCSVReaderGet(Bytecode bytecode, LocalVar out, LocalVar reader, uint32_t col_idx);
+
+  /**
+   * Emit a parallel CSV scan
+   * @param file_name pointer to the file name
+   * @param length length of the file name
+   * @param delimiter field delimiter
+   * @param quote quote character
+   * @param escape escape character
+   * @param query_state opaque query state
+   * @param thread_states the thread state container
+   * @param scan_fn function invoked on each chunk of the file
+   */
+  void EmitParallelCSVScan(uintptr_t file_name, uint64_t length, int8_t delimiter, int8_t quote, int8_t escape,
+                           LocalVar query_state, LocalVar thread_states, FunctionId scan_fn);
 
   // Reading integer values from an iterator
   /**
@@ -347,6 +411,39 @@ class BytecodeEmitter {
   void EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx, int8_t type,
                            int64_t val);
 
+  /**
+   * Filter a varlen column in the iterator by a constant string
+   * @param bytecode filter bytecode to emit
+   * @param selected output variable for the number of selected values
+   * @param pci PCI to filter
+   * @param col_idx index of the iterator to filter
+   * @param val pointer to the string to filter by
+   */
+  void EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx, LocalVar val);
+
+  /**
+   * Filter an integer column in the iterator by the runtime filter of a join hash table
+   * @param selected output variable for the number of selected values
+   * @param pci PCI to filter
+   * @param col_idx index of the iterator to filter
+   * @param type type of the column
+   * @param join_hash_table pointer to the built join hash table
+   */
+  void EmitPCIJoinFilter(LocalVar selected, LocalVar pci, uint32_t col_idx, int8_t type, LocalVar join_hash_table);
+
+  /**
+   * Filter a column in the iterator by its comparison to a query parameter
+   * @param selected output variable for the number of selected values
+   * @param pci PCI to filter
+   * @param col_idx index of the iterator to filter
+   * @param type type of the column
+   * @param comparison comparison of the column to the parameter
+   * @param exec_ctx the execution context holding the parameters
+   * @param param_idx index of the parameter
+   */
+  void EmitPCIParamFilter(LocalVar selected, LocalVar pci, uint32_t col_idx, int8_t type, int8_t comparison,
+                          LocalVar exec_ctx, uint32_t param_idx);
+
   /**
    * Insert a filter flavor into the filter manager builder
    */
@@ -374,6 +471,11 @@ class BytecodeEmitter {
   void EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, LocalVar context, LocalVar tls,
                                                FunctionId scan_part_fn);
 
+  /**
+   * Emit code to build the tables over all partitions
+   */
+  void EmitAggHashTableBuildPartitions(LocalVar agg_ht, LocalVar context, FunctionId merge_part_fn);
+
   /**
    * Emit join table iteration code
    */
@@ -385,6 +487,21 @@ class BytecodeEmitter {
    */
   void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar region, FunctionId cmp_fn, LocalVar tuple_size);
 
+  // --------------------------------------------
+  // Window calls
+  // --------------------------------------------
+
+  /**
+   * Initialize a window over a sorter
+   */
+  void EmitWindowInit(LocalVar window, LocalVar sorter, FunctionId partition_cmp_fn, FunctionId peer_cmp_fn);
+
+  /**
+   * Initialize a window frame
+   */
+  void EmitWindowFrameInit(LocalVar frame, int8_t mode, int8_t start, uint32_t start_offset, int8_t end,
+                           uint32_t end_offset);
+
   // --------------------------------------------
   // Output calls
   // --------------------------------------------
@@ -68,10 +68,16 @@ class BytecodeGenerator : public ast::AstVisitor<BytecodeGenerator> {
   void VisitSqlConversionCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinTableIterParallelCall(ast::CallExpr *call);
+  void VisitBuiltinCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinCSVParallelCall(ast::CallExpr *call);
   void VisitBuiltinPCICall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinHashCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinFilterManagerCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinFilterLikeCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinFilterJoinCall(ast::CallExpr *call);
+  void VisitBuiltinFilterParamCall(ast::CallExpr *call);
+  void VisitBuiltinLikeCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggPartIterCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -79,9 +85,13 @@ class BytecodeGenerator : public ast::AstVisitor<BytecodeGenerator> {
   void VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinWindowCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinWindowIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinWindowTreeCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSizeOfCall(ast::CallExpr *call);
+  void VisitBuiltinOffsetOfCall(ast::CallExpr *call);
   void VisitBuiltinTrigCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinOutputCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::Builtin builtin);
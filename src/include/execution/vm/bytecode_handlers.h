@@ -8,6 +8,7 @@
 #include "execution/exec/execution_context.h"
 #include "execution/sql/aggregation_hash_table.h"
 #include "execution/sql/aggregators.h"
+#include "execution/sql/csv_reader.h"
 #include "execution/sql/filter_manager.h"
 #include "execution/sql/functions/arithmetic_functions.h"
 #include "execution/sql/functions/comparison_functions.h"
@@ -21,6 +22,7 @@
 #include "execution/sql/storage_interface.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/sql/window_operator.h"
 #include "execution/util/execution_common.h"
 #include "execution/util/hash.h"
 #include "metrics/metrics_defs.h"
@@ -250,17 +252,68 @@ VM_OP void OpTableVectorIteratorFree(terrier::execution::sql::TableVectorIterato
 
 VM_OP void OpTableVectorIteratorReset(terrier::execution::sql::TableVectorIterator *iter);
 
+VM_OP void OpTableVectorIteratorRestrictRange(terrier::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                              int8_t col_type, int64_t min, int64_t max);
+
+VM_OP void OpTableVectorIteratorRestrictRangeToParam(terrier::execution::sql::TableVectorIterator *iter,
+                                                     uint32_t col_idx, int8_t col_type, int8_t comparison,
+                                                     uint32_t param_idx);
+
 VM_OP_HOT void OpTableVectorIteratorGetPCI(terrier::execution::sql::ProjectedColumnsIterator **pci,
                                            terrier::execution::sql::TableVectorIterator *iter) {
   *pci = iter->GetProjectedColumnsIterator();
 }
 
-VM_OP_HOT void OpParallelScanTable(const uint32_t db_oid, const uint32_t table_oid, void *const query_state,
+VM_OP_HOT void OpParallelScanTable(const uint32_t table_oid, uint32_t *const col_oids, const uint32_t num_oids,
+                                   void *const query_state, terrier::execution::exec::ExecutionContext *const exec_ctx,
                                    terrier::execution::sql::ThreadStateContainer *const thread_states,
                                    const terrier::execution::sql::TableVectorIterator::ScanFn scanner) {
-  terrier::execution::sql::TableVectorIterator::ParallelScan(db_oid, table_oid, query_state, thread_states, scanner);
+  terrier::execution::sql::TableVectorIterator::ParallelScan(exec_ctx, table_oid, col_oids, num_oids, query_state,
+                                                             thread_states, scanner);
+}
+
+// ---------------------------------------------------------
+// CSV Reader
+// ---------------------------------------------------------
+
+VM_OP void OpCSVReaderInit(terrier::execution::sql::CSVReader *reader, uintptr_t file_name, uint64_t length,
+                           int8_t delimiter, int8_t quote, int8_t escape);
+
+VM_OP_HOT void OpCSVReaderAdvance(bool *has_more, terrier::execution::sql::CSVReader *reader) {
+  *has_more = reader->Advance();
+}
+
+VM_OP_HOT void OpCSVReaderGetBool(terrier::execution::sql::BoolVal *out, terrier::execution::sql::CSVReader *reader,
+                                  uint32_t col_idx) {
+  *out = reader->GetBool(col_idx);
+}
+
+VM_OP_HOT void OpCSVReaderGetInteger(terrier::execution::sql::Integer *out,
+                                     terrier::execution::sql::CSVReader *reader, uint32_t col_idx) {
+  *out = reader->GetInteger(col_idx);
 }
 
+VM_OP_HOT void OpCSVReaderGetReal(terrier::execution::sql::Real *out, terrier::execution::sql::CSVReader *reader,
+                                  uint32_t col_idx) {
+  *out = reader->GetReal(col_idx);
+}
+
+VM_OP_HOT void OpCSVReaderGetDate(terrier::execution::sql::DateVal *out, terrier::execution::sql::CSVReader *reader,
+                                  uint32_t col_idx) {
+  *out = reader->GetDate(col_idx);
+}
+
+VM_OP_HOT void OpCSVReaderGetVarlen(terrier::execution::sql::StringVal *out,
+                                    terrier::execution::sql::CSVReader *reader, uint32_t col_idx) {
+  *out = reader->GetVarlen(col_idx);
+}
+
+VM_OP void OpCSVReaderFree(terrier::execution::sql::CSVReader *reader);
+
+VM_OP void OpParallelScanCSV(uintptr_t file_name, uint64_t length, int8_t delimiter, int8_t quote, int8_t escape,
+                             void *query_state, terrier::execution::sql::ThreadStateContainer *thread_states,
+                             terrier::execution::sql::CSVReader::ScanFn scanner);
+
 // ---------------------------------------------------------
 // Projected Columns Iterator
 // ---------------------------------------------------------
@@ -557,6 +610,43 @@ VM_OP void OpPCIFilterLessThanEqual(uint64_t *size, terrier::execution::sql::Pro
 VM_OP void OpPCIFilterNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
                                uint32_t col_idx, int8_t type, int64_t val);
 
+VM_OP void OpPCIFilterEqualString(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                  uint32_t col_idx, const terrier::execution::sql::StringVal *val);
+
+VM_OP void OpPCIFilterGreaterThanString(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                        uint32_t col_idx, const terrier::execution::sql::StringVal *val);
+
+VM_OP void OpPCIFilterGreaterThanEqualString(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                             uint32_t col_idx, const terrier::execution::sql::StringVal *val);
+
+VM_OP void OpPCIFilterLessThanString(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                     uint32_t col_idx, const terrier::execution::sql::StringVal *val);
+
+VM_OP void OpPCIFilterLessThanEqualString(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                          uint32_t col_idx, const terrier::execution::sql::StringVal *val);
+
+VM_OP void OpPCIFilterNotEqualString(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                     uint32_t col_idx, const terrier::execution::sql::StringVal *val);
+
+VM_OP void OpPCIFilterLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                           const terrier::execution::sql::StringVal *pattern);
+
+VM_OP void OpPCIFilterNotLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                              uint32_t col_idx, const terrier::execution::sql::StringVal *pattern);
+
+VM_OP void OpPCIFilterILike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                            const terrier::execution::sql::StringVal *pattern);
+
+VM_OP void OpPCIFilterNotILike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                               uint32_t col_idx, const terrier::execution::sql::StringVal *pattern);
+
+VM_OP void OpPCIFilterJoin(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                           int8_t type, const terrier::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP void OpPCIFilterParam(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                            int8_t type, int8_t comparison, const terrier::execution::exec::ExecutionContext *exec_ctx,
+                            uint32_t param_idx);
+
 // ---------------------------------------------------------
 // Hashing
 // ---------------------------------------------------------
@@ -694,6 +784,18 @@ GEN_SQL_COMPARISONS(DateVal)
 GEN_SQL_COMPARISONS(TimestampVal)
 #undef GEN_SQL_COMPARISONS
 
+VM_OP_HOT void OpLike(terrier::execution::sql::BoolVal *const result,
+                      const terrier::execution::sql::StringVal *const str,
+                      const terrier::execution::sql::StringVal *const pattern) {
+  terrier::execution::sql::StringFunctions::Like(nullptr, result, *str, *pattern);
+}
+
+VM_OP_HOT void OpILike(terrier::execution::sql::BoolVal *const result,
+                       const terrier::execution::sql::StringVal *const str,
+                       const terrier::execution::sql::StringVal *const pattern) {
+  terrier::execution::sql::StringFunctions::ILike(nullptr, result, *str, *pattern);
+}
+
 // ----------------------------------
 // SQL arithmetic
 // ---------------------------------
@@ -782,6 +884,12 @@ VM_OP_HOT void OpAggregationHashTableInsert(terrier::byte **result,
   *result = agg_hash_table->Insert(hash_val);
 }
 
+VM_OP_HOT void OpAggregationHashTableInsertPartitioned(terrier::byte **result,
+                                                       terrier::execution::sql::AggregationHashTable *agg_hash_table,
+                                                       terrier::hash_t hash_val) {
+  *result = agg_hash_table->InsertPartitioned(hash_val);
+}
+
 VM_OP_HOT void OpAggregationHashTableLookup(terrier::byte **result,
                                             terrier::execution::sql::AggregationHashTable *const agg_hash_table,
                                             const terrier::hash_t hash_val,
@@ -814,6 +922,12 @@ VM_OP_HOT void OpAggregationHashTableParallelPartitionedScan(
   agg_hash_table->ExecuteParallelPartitionedScan(query_state, thread_state_container, scan_partition_fn);
 }
 
+VM_OP_HOT void OpAggregationHashTableBuildPartitions(
+    terrier::execution::sql::AggregationHashTable *const agg_hash_table, void *const query_state,
+    const terrier::execution::sql::AggregationHashTable::MergePartitionFn merge_partition_fn) {
+  agg_hash_table->BuildAllPartitions(query_state, merge_partition_fn);
+}
+
 VM_OP void OpAggregationHashTableFree(terrier::execution::sql::AggregationHashTable *agg_hash_table);
 
 VM_OP void OpAggregationHashTableIteratorInit(terrier::execution::sql::AggregationHashTableIterator *iter,
@@ -1125,6 +1239,11 @@ VM_OP_HOT void OpJoinHashTableAllocTuple(terrier::byte **result,
   *result = join_hash_table->AllocInputTuple(hash);
 }
 
+VM_OP_HOT void OpJoinHashTableAddFilterKey(terrier::execution::sql::JoinHashTable *join_hash_table,
+                                           const terrier::execution::sql::Integer *key) {
+  if (!key->is_null_) join_hash_table->AddFilterKey(key->val_);
+}
+
 VM_OP void OpJoinHashTableBuild(terrier::execution::sql::JoinHashTable *join_hash_table);
 
 VM_OP void OpJoinHashTableBuildParallel(terrier::execution::sql::JoinHashTable *join_hash_table,
@@ -1184,6 +1303,13 @@ VM_OP void OpSorterSortTopKParallel(terrier::execution::sql::Sorter *sorter,
 
 VM_OP void OpSorterFree(terrier::execution::sql::Sorter *sorter);
 
+VM_OP void OpSorterGetTupleCount(uint64_t *count, const terrier::execution::sql::Sorter *sorter);
+
+VM_OP_HOT void OpSorterGetTupleAt(const terrier::byte **row, const terrier::execution::sql::Sorter *sorter,
+                                  uint64_t idx) {
+  *row = sorter->GetTupleAt(idx);
+}
+
 VM_OP void OpSorterIteratorInit(terrier::execution::sql::SorterIterator *iter, terrier::execution::sql::Sorter *sorter);
 
 VM_OP_HOT void OpSorterIteratorHasNext(bool *has_more, terrier::execution::sql::SorterIterator *iter) {
@@ -1198,6 +1324,107 @@ VM_OP_HOT void OpSorterIteratorGetRow(const terrier::byte **row, terrier::execut
 
 VM_OP void OpSorterIteratorFree(terrier::execution::sql::SorterIterator *iter);
 
+// ---------------------------------------------------------
+// Window functions
+// ---------------------------------------------------------
+
+VM_OP void OpWindowInit(terrier::execution::sql::WindowOperator *window, const terrier::execution::sql::Sorter *sorter,
+                        terrier::execution::sql::Sorter::ComparisonFunction partition_cmp_fn,
+                        terrier::execution::sql::Sorter::ComparisonFunction peer_cmp_fn);
+
+VM_OP void OpWindowFree(terrier::execution::sql::WindowOperator *window);
+
+VM_OP void OpWindowFrameInit(terrier::execution::sql::WindowFrame *frame, int8_t mode, int8_t start,
+                             uint32_t start_offset, int8_t end, uint32_t end_offset);
+
+VM_OP void OpWindowIteratorInit(terrier::execution::sql::WindowIterator *iter,
+                                const terrier::execution::sql::WindowOperator *window);
+
+VM_OP_HOT void OpWindowIteratorHasNext(bool *has_more, const terrier::execution::sql::WindowIterator *iter) {
+  *has_more = iter->HasNext();
+}
+
+VM_OP_HOT void OpWindowIteratorNext(terrier::execution::sql::WindowIterator *iter) { iter->Next(); }
+
+VM_OP_HOT void OpWindowIteratorGetRow(const terrier::byte **row, const terrier::execution::sql::WindowIterator *iter) {
+  *row = iter->GetRow();
+}
+
+VM_OP_HOT void OpWindowIteratorIsPartitionStart(bool *result, const terrier::execution::sql::WindowIterator *iter) {
+  *result = iter->IsPartitionStart();
+}
+
+VM_OP_HOT void OpWindowIteratorGetRowNumber(uint64_t *result, const terrier::execution::sql::WindowIterator *iter) {
+  *result = iter->GetRowNumber();
+}
+
+VM_OP_HOT void OpWindowIteratorGetRank(uint64_t *result, const terrier::execution::sql::WindowIterator *iter) {
+  *result = iter->GetRank();
+}
+
+VM_OP_HOT void OpWindowIteratorGetDenseRank(uint64_t *result, const terrier::execution::sql::WindowIterator *iter) {
+  *result = iter->GetDenseRank();
+}
+
+VM_OP_HOT void OpWindowIteratorGetFrameBegin(uint64_t *result, const terrier::execution::sql::WindowIterator *iter,
+                                             const terrier::execution::sql::WindowFrame *frame) {
+  *result = iter->GetFrame(*frame).first;
+}
+
+VM_OP_HOT void OpWindowIteratorGetFrameEnd(uint64_t *result, const terrier::execution::sql::WindowIterator *iter,
+                                           const terrier::execution::sql::WindowFrame *frame) {
+  *result = iter->GetFrame(*frame).second;
+}
+
+VM_OP void OpWindowIteratorFree(terrier::execution::sql::WindowIterator *iter);
+
+// Init, Query and Free of the segment tree Tree over aggregates of type Agg
+#define GEN_WINDOW_TREE_CALLS(Name, Tree, Agg)                                                                       \
+  VM_OP_WARM void Op##Name##WindowTreeInit(terrier::execution::sql::Tree *tree) {                                    \
+    new (tree) terrier::execution::sql::Tree();                                                                      \
+  }                                                                                                                  \
+                                                                                                                     \
+  VM_OP_HOT void Op##Name##WindowTreeQuery(terrier::execution::sql::Agg *result,                                     \
+                                          const terrier::execution::sql::Tree *tree, uint64_t begin, uint64_t end) { \
+    tree->Query(begin, end, result);                                                                                 \
+  }                                                                                                                  \
+                                                                                                                     \
+  VM_OP_WARM void Op##Name##WindowTreeFree(terrier::execution::sql::Tree *tree) { tree->~WindowSegmentTree(); }
+
+// Build of the segment tree Tree over aggregates of type Agg, advanced by the SqlType value at an offset in each row
+#define GEN_WINDOW_TREE_BUILD(Name, Tree, Agg, SqlType)                                                        \
+  VM_OP_WARM void Op##Name##WindowTreeBuild(terrier::execution::sql::Tree *tree,                               \
+                                            const terrier::execution::sql::WindowIterator *iter,               \
+                                            uint32_t val_offset) {                                             \
+    tree->Build(iter->GetPartitionRows(), iter->GetPartitionSize(),                                            \
+                [val_offset](terrier::execution::sql::Agg *agg, const terrier::byte *row) {                    \
+                  agg->Advance(*reinterpret_cast<const terrier::execution::sql::SqlType *>(row + val_offset)); \
+                });                                                                                            \
+  }
+
+GEN_WINDOW_TREE_CALLS(Count, CountWindowTree, CountAggregate);
+GEN_WINDOW_TREE_CALLS(Avg, AvgWindowTree, AvgAggregate);
+GEN_WINDOW_TREE_CALLS(IntegerMax, IntegerMaxWindowTree, IntegerMaxAggregate);
+GEN_WINDOW_TREE_CALLS(IntegerMin, IntegerMinWindowTree, IntegerMinAggregate);
+GEN_WINDOW_TREE_CALLS(IntegerSum, IntegerSumWindowTree, IntegerSumAggregate);
+GEN_WINDOW_TREE_CALLS(RealMax, RealMaxWindowTree, RealMaxAggregate);
+GEN_WINDOW_TREE_CALLS(RealMin, RealMinWindowTree, RealMinAggregate);
+GEN_WINDOW_TREE_CALLS(RealSum, RealSumWindowTree, RealSumAggregate);
+
+// COUNT() only looks at the NULL flag, which every SQL value has
+GEN_WINDOW_TREE_BUILD(Count, CountWindowTree, CountAggregate, Val);
+GEN_WINDOW_TREE_BUILD(IntegerAvg, AvgWindowTree, AvgAggregate, Integer);
+GEN_WINDOW_TREE_BUILD(RealAvg, AvgWindowTree, AvgAggregate, Real);
+GEN_WINDOW_TREE_BUILD(IntegerMax, IntegerMaxWindowTree, IntegerMaxAggregate, Integer);
+GEN_WINDOW_TREE_BUILD(IntegerMin, IntegerMinWindowTree, IntegerMinAggregate, Integer);
+GEN_WINDOW_TREE_BUILD(IntegerSum, IntegerSumWindowTree, IntegerSumAggregate, Integer);
+GEN_WINDOW_TREE_BUILD(RealMax, RealMaxWindowTree, RealMaxAggregate, Real);
+GEN_WINDOW_TREE_BUILD(RealMin, RealMinWindowTree, RealMinAggregate, Real);
+GEN_WINDOW_TREE_BUILD(RealSum, RealSumWindowTree, RealSumAggregate, Real);
+
+#undef GEN_WINDOW_TREE_BUILD
+#undef GEN_WINDOW_TREE_CALLS
+
 // ---------------------------------------------------------
 // Trig functions
 // ---------------------------------------------------------
@@ -1720,4 +1947,53 @@ VM_OP_HOT void OpGetParamString(terrier::execution::sql::StringVal *ret,
   }
 }
 
+// ---------------------------------------------------------
+// Superinstructions
+// ---------------------------------------------------------
+
+// The second bytecode of a superinstruction is still in the bytecode stream, and compiled code executes it on its own.
+// These handlers only perform the first bytecode.
+
+#define FUSED_COMPARISONS(type, ...)                                                        \
+  VM_OP_HOT void OpGreaterThanJumpIfFalse##_##type(bool *result, type lhs, type rhs) {      \
+    OpGreaterThan##_##type(result, lhs, rhs);                                               \
+  }                                                                                         \
+  VM_OP_HOT void OpGreaterThanEqualJumpIfFalse##_##type(bool *result, type lhs, type rhs) { \
+    OpGreaterThanEqual##_##type(result, lhs, rhs);                                          \
+  }                                                                                         \
+  VM_OP_HOT void OpEqualJumpIfFalse##_##type(bool *result, type lhs, type rhs) {            \
+    OpEqual##_##type(result, lhs, rhs);                                                     \
+  }                                                                                         \
+  VM_OP_HOT void OpLessThanJumpIfFalse##_##type(bool *result, type lhs, type rhs) {         \
+    OpLessThan##_##type(result, lhs, rhs);                                                  \
+  }                                                                                         \
+  VM_OP_HOT void OpLessThanEqualJumpIfFalse##_##type(bool *result, type lhs, type rhs) {    \
+    OpLessThanEqual##_##type(result, lhs, rhs);                                             \
+  }                                                                                         \
+  VM_OP_HOT void OpNotEqualJumpIfFalse##_##type(bool *result, type lhs, type rhs) {         \
+    OpNotEqual##_##type(result, lhs, rhs);                                                  \
+  }
+
+INT_TYPES(FUSED_COMPARISONS);
+
+#undef FUSED_COMPARISONS
+
+VM_OP_HOT void OpForceBoolTruthJumpIfFalse(bool *result, terrier::execution::sql::BoolVal *input) {
+  OpForceBoolTruth(result, input);
+}
+
+VM_OP_HOT void OpPCIHasNextJumpIfFalse(bool *has_more, terrier::execution::sql::ProjectedColumnsIterator *pci) {
+  OpPCIHasNext(has_more, pci);
+}
+
+VM_OP_HOT void OpPCIHasNextFilteredJumpIfFalse(bool *has_more, terrier::execution::sql::ProjectedColumnsIterator *pci) {
+  OpPCIHasNextFiltered(has_more, pci);
+}
+
+VM_OP_HOT void OpPCIAdvanceJump(terrier::execution::sql::ProjectedColumnsIterator *pci) { OpPCIAdvance(pci); }
+
+VM_OP_HOT void OpPCIAdvanceFilteredJump(terrier::execution::sql::ProjectedColumnsIterator *pci) {
+  OpPCIAdvanceFiltered(pci);
+}
+
 }  // extern "C"
@@ -78,6 +78,11 @@ class BytecodeModule {
    */
   const std::vector<FunctionInfo> &Functions() const { return functions_; }
 
+  /**
+   * Return the raw bytecode of all functions in this module
+   */
+  const std::vector<uint8_t> &Code() const { return code_; }
+
   /**
    * Return the number of bytecode instructions in this module
    */
@@ -39,6 +39,17 @@ namespace terrier::execution::vm {
   CREATE_FOR_FLOAT_TYPES(F, op, __VA_ARGS__) \
   CREATE_FOR_BOOL_TYPES(F, op, __VA_ARGS__)
 
+// Creates instances of a given superinstruction for all integer primitive types
+#define CREATE_FUSED_FOR_INT_TYPES(F, first, second)    \
+  F(first##second##_int8_t, first##_int8_t, second)     \
+  F(first##second##_int16_t, first##_int16_t, second)   \
+  F(first##second##_int32_t, first##_int32_t, second)   \
+  F(first##second##_int64_t, first##_int64_t, second)   \
+  F(first##second##_uint8_t, first##_uint8_t, second)   \
+  F(first##second##_uint16_t, first##_uint16_t, second) \
+  F(first##second##_uint32_t, first##_uint32_t, second) \
+  F(first##second##_uint64_t, first##_uint64_t, second)
+
 #define GET_BASE_FOR_INT_TYPES(op) (op##_int8_t)
 #define GET_BASE_FOR_FLOAT_TYPES(op) (op##_float)
 #define GET_BASE_FOR_BOOL_TYPES(op) (op##_bool)
@@ -116,10 +127,27 @@ namespace terrier::execution::vm {
   F(TableVectorIteratorPerformInit, OperandType::Local)                                                               \
   F(TableVectorIteratorNext, OperandType::Local, OperandType::Local)                                                  \
   F(TableVectorIteratorReset, OperandType::Local)                                                                     \
+  F(TableVectorIteratorRestrictRange, OperandType::Local, OperandType::UImm4, OperandType::Imm1, OperandType::Imm8,   \
+    OperandType::Imm8)                                                                                                \
+  F(TableVectorIteratorRestrictRangeToParam, OperandType::Local, OperandType::UImm4, OperandType::Imm1,               \
+    OperandType::Imm1, OperandType::UImm4)                                                                            \
   F(TableVectorIteratorFree, OperandType::Local)                                                                      \
   F(TableVectorIteratorGetPCI, OperandType::Local, OperandType::Local)                                                \
-  F(ParallelScanTable, OperandType::UImm4, OperandType::UImm4, OperandType::Local, OperandType::Local,                \
-    OperandType::FunctionId)                                                                                          \
+  F(ParallelScanTable, OperandType::UImm4, OperandType::Local, OperandType::UImm4, OperandType::Local,                \
+    OperandType::Local, OperandType::Local, OperandType::FunctionId)                                                  \
+                                                                                                                      \
+  /* CSV Reader */                                                                                                    \
+  F(CSVReaderInit, OperandType::Local, OperandType::Imm8, OperandType::Imm8, OperandType::Imm1, OperandType::Imm1,    \
+    OperandType::Imm1)                                                                                                \
+  F(CSVReaderAdvance, OperandType::Local, OperandType::Local)                                                         \
+  F(CSVReaderGetBool, OperandType::Local, OperandType::Local, OperandType::UImm4)                                     \
+  F(CSVReaderGetInteger, OperandType::Local, OperandType::Local, OperandType::UImm4)                                  \
+  F(CSVReaderGetReal, OperandType::Local, OperandType::Local, OperandType::UImm4)                                     \
+  F(CSVReaderGetDate, OperandType::Local, OperandType::Local, OperandType::UImm4)                                     \
+  F(CSVReaderGetVarlen, OperandType::Local, OperandType::Local, OperandType::UImm4)                                   \
+  F(CSVReaderFree, OperandType::Local)                                                                                \
+  F(ParallelScanCSV, OperandType::Imm8, OperandType::Imm8, OperandType::Imm1, OperandType::Imm1, OperandType::Imm1,   \
+    OperandType::Local, OperandType::Local, OperandType::FunctionId)                                                  \
                                                                                                                       \
   /* ProjectedColumns Iterator (PCI) */                                                                               \
   F(PCIIsFiltered, OperandType::Local, OperandType::Local)                                                            \
@@ -164,6 +192,19 @@ namespace terrier::execution::vm {
     OperandType::Imm8)                                                                                                \
   F(PCIFilterNotEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1,                 \
     OperandType::Imm8)                                                                                                \
+  F(PCIFilterEqualString, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)             \
+  F(PCIFilterGreaterThanString, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)       \
+  F(PCIFilterGreaterThanEqualString, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)  \
+  F(PCIFilterLessThanString, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)          \
+  F(PCIFilterLessThanEqualString, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)     \
+  F(PCIFilterNotEqualString, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)          \
+  F(PCIFilterLike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)                    \
+  F(PCIFilterNotLike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)                 \
+  F(PCIFilterILike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)                   \
+  F(PCIFilterNotILike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local)                \
+  F(PCIFilterJoin, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1, OperandType::Local) \
+  F(PCIFilterParam, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1, OperandType::Imm1, \
+    OperandType::Local, OperandType::UImm4)                                                                           \
                                                                                                                       \
   /* Filter Manager */                                                                                                \
   F(FilterManagerInit, OperandType::Local)                                                                            \
@@ -210,6 +251,8 @@ namespace terrier::execution::vm {
   F(GreaterThanEqualStringVal, OperandType::Local, OperandType::Local, OperandType::Local)                            \
   F(EqualStringVal, OperandType::Local, OperandType::Local, OperandType::Local)                                       \
   F(NotEqualStringVal, OperandType::Local, OperandType::Local, OperandType::Local)                                    \
+  F(Like, OperandType::Local, OperandType::Local, OperandType::Local)                                                 \
+  F(ILike, OperandType::Local, OperandType::Local, OperandType::Local)                                                \
   F(LessThanDateVal, OperandType::Local, OperandType::Local, OperandType::Local)                                      \
   F(LessThanEqualDateVal, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
   F(GreaterThanDateVal, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
@@ -249,6 +292,7 @@ namespace terrier::execution::vm {
   /* Aggregation Hash Table */                                                                                        \
   F(AggregationHashTableInit, OperandType::Local, OperandType::Local, OperandType::Local)                             \
   F(AggregationHashTableInsert, OperandType::Local, OperandType::Local, OperandType::Local)                           \
+  F(AggregationHashTableInsertPartitioned, OperandType::Local, OperandType::Local, OperandType::Local)                \
   F(AggregationHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId,  \
     OperandType::Local)                                                                                               \
   F(AggregationHashTableProcessBatch, OperandType::Local, OperandType::Local, OperandType::FunctionId,                \
@@ -257,6 +301,7 @@ namespace terrier::execution::vm {
     OperandType::FunctionId)                                                                                          \
   F(AggregationHashTableParallelPartitionedScan, OperandType::Local, OperandType::Local, OperandType::Local,          \
     OperandType::FunctionId)                                                                                          \
+  F(AggregationHashTableBuildPartitions, OperandType::Local, OperandType::Local, OperandType::FunctionId)             \
   F(AggregationHashTableFree, OperandType::Local)                                                                     \
   F(AggregationHashTableIteratorInit, OperandType::Local, OperandType::Local)                                         \
   F(AggregationHashTableIteratorHasNext, OperandType::Local, OperandType::Local)                                      \
@@ -327,6 +372,7 @@ namespace terrier::execution::vm {
   /* Hash Joins */                                                                                                    \
   F(JoinHashTableInit, OperandType::Local, OperandType::Local, OperandType::Local)                                    \
   F(JoinHashTableAllocTuple, OperandType::Local, OperandType::Local, OperandType::Local)                              \
+  F(JoinHashTableAddFilterKey, OperandType::Local, OperandType::Local)                                                \
   F(JoinHashTableIterInit, OperandType::Local, OperandType::Local, OperandType::Local)                                \
   F(JoinHashTableIterHasNext, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local,    \
     OperandType::Local)                                                                                               \
@@ -345,12 +391,64 @@ namespace terrier::execution::vm {
   F(SorterSortParallel, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
   F(SorterSortTopKParallel, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)           \
   F(SorterFree, OperandType::Local)                                                                                   \
+  F(SorterGetTupleCount, OperandType::Local, OperandType::Local)                                                      \
+  F(SorterGetTupleAt, OperandType::Local, OperandType::Local, OperandType::Local)                                     \
   F(SorterIteratorInit, OperandType::Local, OperandType::Local)                                                       \
   F(SorterIteratorGetRow, OperandType::Local, OperandType::Local)                                                     \
   F(SorterIteratorHasNext, OperandType::Local, OperandType::Local)                                                    \
   F(SorterIteratorNext, OperandType::Local)                                                                           \
   F(SorterIteratorFree, OperandType::Local)                                                                           \
                                                                                                                       \
+  /* Window functions */                                                                                              \
+  F(WindowInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::FunctionId)             \
+  F(WindowFree, OperandType::Local)                                                                                   \
+  F(WindowFrameInit, OperandType::Local, OperandType::Imm1, OperandType::Imm1, OperandType::UImm4, OperandType::Imm1, \
+    OperandType::UImm4)                                                                                               \
+  F(WindowIteratorInit, OperandType::Local, OperandType::Local)                                                       \
+  F(WindowIteratorHasNext, OperandType::Local, OperandType::Local)                                                    \
+  F(WindowIteratorNext, OperandType::Local)                                                                           \
+  F(WindowIteratorGetRow, OperandType::Local, OperandType::Local)                                                     \
+  F(WindowIteratorIsPartitionStart, OperandType::Local, OperandType::Local)                                           \
+  F(WindowIteratorGetRowNumber, OperandType::Local, OperandType::Local)                                               \
+  F(WindowIteratorGetRank, OperandType::Local, OperandType::Local)                                                    \
+  F(WindowIteratorGetDenseRank, OperandType::Local, OperandType::Local)                                               \
+  F(WindowIteratorGetFrameBegin, OperandType::Local, OperandType::Local, OperandType::Local)                          \
+  F(WindowIteratorGetFrameEnd, OperandType::Local, OperandType::Local, OperandType::Local)                            \
+  F(WindowIteratorFree, OperandType::Local)                                                                           \
+  F(CountWindowTreeInit, OperandType::Local)                                                                          \
+  F(CountWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
+  F(CountWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)             \
+  F(CountWindowTreeFree, OperandType::Local)                                                                          \
+  F(AvgWindowTreeInit, OperandType::Local)                                                                            \
+  F(IntegerAvgWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                            \
+  F(RealAvgWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                               \
+  F(AvgWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)               \
+  F(AvgWindowTreeFree, OperandType::Local)                                                                            \
+  F(IntegerMaxWindowTreeInit, OperandType::Local)                                                                     \
+  F(IntegerMaxWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                            \
+  F(IntegerMaxWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)        \
+  F(IntegerMaxWindowTreeFree, OperandType::Local)                                                                     \
+  F(IntegerMinWindowTreeInit, OperandType::Local)                                                                     \
+  F(IntegerMinWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                            \
+  F(IntegerMinWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)        \
+  F(IntegerMinWindowTreeFree, OperandType::Local)                                                                     \
+  F(IntegerSumWindowTreeInit, OperandType::Local)                                                                     \
+  F(IntegerSumWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                            \
+  F(IntegerSumWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)        \
+  F(IntegerSumWindowTreeFree, OperandType::Local)                                                                     \
+  F(RealMaxWindowTreeInit, OperandType::Local)                                                                        \
+  F(RealMaxWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                               \
+  F(RealMaxWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)           \
+  F(RealMaxWindowTreeFree, OperandType::Local)                                                                        \
+  F(RealMinWindowTreeInit, OperandType::Local)                                                                        \
+  F(RealMinWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                               \
+  F(RealMinWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)           \
+  F(RealMinWindowTreeFree, OperandType::Local)                                                                        \
+  F(RealSumWindowTreeInit, OperandType::Local)                                                                        \
+  F(RealSumWindowTreeBuild, OperandType::Local, OperandType::Local, OperandType::Local)                               \
+  F(RealSumWindowTreeQuery, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)           \
+  F(RealSumWindowTreeFree, OperandType::Local)                                                                        \
+                                                                                                                      \
   /* Output */                                                                                                        \
   F(OutputAlloc, OperandType::Local, OperandType::Local)                                                              \
   F(OutputFinalize, OperandType::Local)                                                                               \
@@ -483,7 +581,44 @@ namespace terrier::execution::vm {
   F(GetParamDouble, OperandType::Local, OperandType::Local, OperandType::Local)                                       \
   F(GetParamDateVal, OperandType::Local, OperandType::Local, OperandType::Local)                                      \
   F(GetParamTimestampVal, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
-  F(GetParamString, OperandType::Local, OperandType::Local, OperandType::Local)
+  F(GetParamString, OperandType::Local, OperandType::Local, OperandType::Local)                                       \
+                                                                                                                      \
+  /* Superinstructions. See SUPERINSTRUCTION_LIST below. */                                                           \
+  CREATE_FOR_INT_TYPES(F, GreaterThanJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local)         \
+  CREATE_FOR_INT_TYPES(F, GreaterThanEqualJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local)    \
+  CREATE_FOR_INT_TYPES(F, EqualJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local)               \
+  CREATE_FOR_INT_TYPES(F, LessThanJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local)            \
+  CREATE_FOR_INT_TYPES(F, LessThanEqualJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local)       \
+  CREATE_FOR_INT_TYPES(F, NotEqualJumpIfFalse, OperandType::Local, OperandType::Local, OperandType::Local)            \
+  F(ForceBoolTruthJumpIfFalse, OperandType::Local, OperandType::Local)                                                \
+  F(PCIHasNextJumpIfFalse, OperandType::Local, OperandType::Local)                                                    \
+  F(PCIHasNextFilteredJumpIfFalse, OperandType::Local, OperandType::Local)                                            \
+  F(PCIAdvanceJump, OperandType::Local)                                                                               \
+  F(PCIAdvanceFilteredJump, OperandType::Local)
+
+/**
+ * Superinstructions fuse a bytecode with the bytecode that follows it, so that the VM executes both with a single
+ * dispatch. A superinstruction has the same operands as its first bytecode and only replaces its opcode; the second
+ * bytecode stays where it is. Hence, jumps can still target the second bytecode, and code that iterates over bytecode,
+ * like the LLVM engine, sees both bytecodes. Bytecode handlers of superinstructions only perform the first bytecode.
+ *
+ * The conditional jumps test the result of their first bytecode, so the VM tests it without reloading it from the
+ * frame. Superinstructions are created by the Superinstructions pass.
+ *
+ * F(superinstruction, first bytecode, second bytecode)
+ */
+#define SUPERINSTRUCTION_LIST(F)                                    \
+  CREATE_FUSED_FOR_INT_TYPES(F, GreaterThan, JumpIfFalse)           \
+  CREATE_FUSED_FOR_INT_TYPES(F, GreaterThanEqual, JumpIfFalse)      \
+  CREATE_FUSED_FOR_INT_TYPES(F, Equal, JumpIfFalse)                 \
+  CREATE_FUSED_FOR_INT_TYPES(F, LessThan, JumpIfFalse)              \
+  CREATE_FUSED_FOR_INT_TYPES(F, LessThanEqual, JumpIfFalse)         \
+  CREATE_FUSED_FOR_INT_TYPES(F, NotEqual, JumpIfFalse)              \
+  F(ForceBoolTruthJumpIfFalse, ForceBoolTruth, JumpIfFalse)         \
+  F(PCIHasNextJumpIfFalse, PCIHasNext, JumpIfFalse)                 \
+  F(PCIHasNextFilteredJumpIfFalse, PCIHasNextFiltered, JumpIfFalse) \
+  F(PCIAdvanceJump, PCIAdvance, Jump)                               \
+  F(PCIAdvanceFilteredJump, PCIAdvanceFiltered, Jump)
 
 /**
  * The single enumeration of all possible bytecode instructions
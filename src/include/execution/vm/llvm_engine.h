@@ -3,11 +3,14 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "llvm/Support/MemoryBuffer.h"
 
 #include "common/macros.h"
 #include "execution/util/execution_common.h"
+#include "execution/vm/bytecode_function_info.h"
 #include "execution/vm/bytecodes.h"
 
 namespace terrier::execution::ast {
@@ -17,8 +20,6 @@ class Type;
 namespace terrier::execution::vm {
 
 class BytecodeModule;
-class FunctionInfo;
-class LocalVar;
 
 /**
  * The interface to LLVM to JIT compile TPL bytecode
@@ -42,8 +43,10 @@ class LLVMEngine {
 
   /**
    * Initialize the whole LLVM subsystem
+   * @param object_cache_directory if not empty, compiled modules are cached in this directory and reused across
+   * processes
    */
-  static void Initialize();
+  static void Initialize(const std::string &object_cache_directory = "");
 
   /**
    * Shutdown the whole LLVM subsystem
@@ -118,6 +121,38 @@ class LLVMEngine {
      */
     const std::string &GetOutputObjectFileName() const { return output_file_name_; }
 
+    /**
+     * Set the baseline option. Baseline compilation skips inlining and the module-level optimization passes, trading
+     * code quality for compilation time.
+     * @param baseline whether to only run cheap optimizations
+     * @return the updated object
+     */
+    CompilerOptions &SetBaseline(bool baseline) {
+      baseline_ = baseline;
+      return *this;
+    }
+
+    /**
+     * @return whether only cheap optimizations are run
+     */
+    bool IsBaseline() const { return baseline_; }
+
+    /**
+     * Restrict compilation to the given functions. Functions they call, directly or through function pointers, must be
+     * in the list as well.
+     * @param functions the IDs of the functions to compile, or empty to compile the whole module
+     * @return the updated object
+     */
+    CompilerOptions &SetFunctions(std::vector<FunctionId> functions) {
+      functions_ = std::move(functions);
+      return *this;
+    }
+
+    /**
+     * @return the IDs of the functions to compile, empty if the whole module is compiled
+     */
+    const std::vector<FunctionId> &GetFunctions() const { return functions_; }
+
     /**
      * @return the path to the bytecode handlers bitcode file.
      */
@@ -127,6 +162,8 @@ class LLVMEngine {
     bool debug_{false};
     bool write_obj_file_{false};
     std::string output_file_name_;
+    bool baseline_{false};
+    std::vector<FunctionId> functions_;
   };
 
   // -------------------------------------------------------
@@ -165,7 +202,7 @@ class LLVMEngine {
     /**
      * Get a pointer to the JIT-ed function in this module with name @em name.
      * @return A function pointer if a function with the provided name exists.
-     *         If no such function exists, returns null.
+     *         If no such function exists, or it was not compiled, returns null.
      */
     void *GetFunctionPointer(const std::string &name) const;
 
@@ -174,6 +211,11 @@ class LLVMEngine {
      */
     std::size_t GetModuleObjectCodeSizeInBytes() const { return object_code_->getBufferSize(); }
 
+    /**
+     * Return the module's object code, or null if it has not been loaded yet.
+     */
+    const llvm::MemoryBuffer *GetObjectCode() const { return object_code_.get(); }
+
     /**
      * Load the given module @em module into memory. If this module has already
      * been loaded, it will not be reloaded.
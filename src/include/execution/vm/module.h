@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "llvm/Support/Memory.h"
 
@@ -12,6 +15,7 @@
 #include "execution/vm/llvm_engine.h"
 
 namespace terrier::execution::vm::test {
+class AdaptiveExecutionTest;
 class BytecodeTrampolineTest;
 }  // namespace terrier::execution::vm::test
 
@@ -25,12 +29,25 @@ enum class ExecutionMode : uint8_t {
   Interpret = 0,
   // Compile and generate all machine code before executing the function
   Compiled = 1,
-  // Execute in interpreted mode, but trigger a compilation asynchronously. As
-  // compiled code becomes available, seamlessly swap it in and execute mixed
-  // interpreter and compiled code.
+  // Execute in interpreted mode, but count the invocations and loop iterations
+  // of every function. Functions that become hot are compiled asynchronously.
+  // As compiled code becomes available, seamlessly swap it in and execute
+  // mixed interpreter and compiled code.
   Adaptive = 2,
 };
 
+/**
+ * The implementation a function currently executes with in adaptive mode. Tiers only ever move up.
+ */
+enum class FunctionTier : uint8_t {
+  // Bytecode run by the VM
+  Interpreted = 0,
+  // Machine code compiled with cheap optimizations
+  Baseline = 1,
+  // Fully optimized machine code
+  Optimized = 2,
+};
+
 /**
  * A Module instance is used to store all information associated with a single
  * TPL program. Module's are a top-level container for metadata about all TPL
@@ -61,6 +78,31 @@ class Module {
    */
   DISALLOW_COPY_AND_MOVE(Module);
 
+  /**
+   * Destroy the module. Background compilations that have not started yet are abandoned, and running ones are waited
+   * for.
+   */
+  ~Module();
+
+  /**
+   * Configure when functions are compiled in adaptive mode. This must be called before any function is executed.
+   * @param hotness_threshold The number of invocations plus loop iterations after which a function is compiled
+   * @param baseline_tier Whether hot functions are first compiled with cheap optimizations, and then recompiled with
+   *                      full optimizations
+   */
+  void SetTieringPolicy(uint32_t hotness_threshold, bool baseline_tier) {
+    hotness_threshold_ = hotness_threshold;
+    baseline_tier_ = baseline_tier;
+  }
+
+  /**
+   * @return The tier the function with ID @em func_id currently executes in
+   */
+  FunctionTier GetFunctionTier(const FunctionId func_id) const {
+    TERRIER_ASSERT(func_id < bytecode_module_->NumFunctions(), "Out-of-bounds function access");
+    return static_cast<FunctionTier>(tiers_[func_id].load(std::memory_order_relaxed));
+  }
+
   /**
    * Look up a TPL function in this module by its ID
    * @return A pointer to the function's info if it exists; null otherwise
@@ -102,7 +144,7 @@ class Module {
    */
   void *GetRawFunctionImpl(const FunctionId func_id) const {
     TERRIER_ASSERT(func_id < bytecode_module_->NumFunctions(), "Out-of-bounds function access");
-    return functions_[func_id].load(std::memory_order_relaxed);
+    return functions_[func_id].load(std::memory_order_acquire);
   }
 
   /**
@@ -110,13 +152,45 @@ class Module {
    */
   const BytecodeModule *GetBytecodeModule() const { return bytecode_module_.get(); }
 
+  /**
+   * Return the size of the module's code in bytes. This is the size of the
+   * machine code once the module has been compiled, and the size of the
+   * bytecode before that.
+   */
+  std::size_t GetCodeSizeInBytes() const {
+    if (jit_module_ != nullptr) return jit_module_->GetModuleObjectCodeSizeInBytes();
+    return bytecode_module_->InstructionCount();
+  }
+
  private:
   friend class VM;
-  friend class AsyncCompileTask;
+  friend class TierUpTask;
+  friend class test::AdaptiveExecutionTest;
   friend class test::BytecodeTrampolineTest;
 
-  // This class encapsulates the ability to asynchronously JIT compile a module.
-  class AsyncCompileTask;
+  // This class encapsulates the ability to asynchronously JIT compile hot
+  // functions.
+  class TierUpTask;
+
+  // State shared between the module and its background compilations, which
+  // may outlive it if they never got to run.
+  struct TieringState {
+    // Protects all members, and the installation of compiled functions
+    std::mutex mutex_;
+    // Signaled whenever a compilation finishes
+    std::condition_variable done_;
+    // Set when the module is destroyed
+    bool cancelled_{false};
+    // The number of compilations in progress
+    uint32_t running_{0};
+    // Compiled code that functions may point into
+    std::vector<std::unique_ptr<LLVMEngine::CompiledModule>> compiled_modules_;
+  };
+
+  // The default hotness a function must reach before it is compiled. Loops
+  // with a few thousand iterations, or a morsel-driven pipeline a few morsels
+  // into a large table, are worth compiling.
+  static constexpr uint32_t K_DEFAULT_HOTNESS_THRESHOLD = 10000;
 
   // A trampoline is a stub function that serves as a landing point for all
   // functions executed in interpreted mode. The purpose of the trampoline is
@@ -165,9 +239,29 @@ class Module {
   // Compile this module into machine code. This is a blocking call.
   void CompileToMachineCode();
 
-  // Compile this module into machine code. This is a non-blocking call that
-  // triggers a compilation in the background.
-  void CompileToMachineCodeAsync();
+  // Add to the hotness of the function with id @em func_id. In adaptive mode,
+  // crossing the threshold triggers its compilation in the background. This
+  // is const because the VM only holds a const module; only the tiering state
+  // and function pointers change.
+  void RecordHotness(FunctionId func_id, uint32_t count) const;
+
+  // Compile the function with id @em func_id and the functions it calls,
+  // installing each tier as it completes. This is a blocking call.
+  void TierUp(FunctionId func_id) const;
+
+  // Compile @em funcs with the given options and install them as tier @em tier
+  // if they do not have a higher tier already. Returns false if the
+  // compilation failed.
+  bool CompileTier(const std::vector<FunctionId> &funcs, FunctionTier tier,
+                   const LLVMEngine::CompilerOptions &options) const;
+
+  // Collect the function with id @em func_id and all functions reachable from
+  // it through calls or function pointers
+  std::vector<FunctionId> ReachableFunctions(FunctionId func_id) const;
+
+  // Run the function with ID @em func_id in the VM
+  template <typename Ret, typename... ArgTypes>
+  Ret InvokeInterpreted(FunctionId func_id, ArgTypes... args) const;
 
  private:
   // The module containing all TBC (i.e., bytecode) for the TPL program.
@@ -183,6 +277,17 @@ class Module {
   // Compilation flag used to ensure compilation occurs only once, even under
   // concurrent invocations.
   std::once_flag compiled_flag_;
+  // Per-function invocation and loop back-edge counts, maintained by the VM.
+  std::unique_ptr<std::atomic<uint32_t>[]> hotness_;
+  // Per-function FunctionTier.
+  std::unique_ptr<std::atomic<uint8_t>[]> tiers_;
+  // Whether hotness is tracked, i.e., whether the module runs adaptively.
+  std::atomic<bool> adaptive_{false};
+  // Tiering policy.
+  uint32_t hotness_threshold_{K_DEFAULT_HOTNESS_THRESHOLD};
+  bool baseline_tier_{true};
+  // Background compilations.
+  std::shared_ptr<TieringState> tiering_;
 };
 
 // ---------------------------------------------------------
@@ -204,6 +309,31 @@ inline void CopyAll(uint8_t *buffer, const HeadT &head, const RestT &... rest) {
 
 }  // namespace detail
 
+template <typename Ret, typename... ArgTypes>
+inline Ret Module::InvokeInterpreted(const FunctionId func_id, ArgTypes... args) const {
+  // NOLINTNEXTLINE: bugprone-suspicious-semicolon: seems like a false positive because of constexpr
+  if constexpr (std::is_void_v<Ret>) {
+    // Create a temporary on-stack buffer and copy all arguments
+    uint8_t arg_buffer[(0ul + ... + sizeof(args))];
+    detail::CopyAll(arg_buffer, args...);
+
+    // Invoke and finish
+    VM::InvokeFunction(this, func_id, arg_buffer);
+    return;
+  } else {  // NOLINT
+    // The return value
+    Ret rv{};
+
+    // Create a temporary on-stack buffer and copy all arguments
+    uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
+    detail::CopyAll(arg_buffer, &rv, args...);
+
+    // Invoke and finish
+    VM::InvokeFunction(this, func_id, arg_buffer);
+    return rv;
+  }
+}
+
 template <typename Ret, typename... ArgTypes>
 inline bool Module::GetFunction(const std::string &name, const ExecutionMode exec_mode,
                                 std::function<Ret(ArgTypes...)> *func) {
@@ -223,39 +353,28 @@ inline bool Module::GetFunction(const std::string &name, const ExecutionMode exe
 
   switch (exec_mode) {
     case ExecutionMode::Adaptive: {
-      CompileToMachineCodeAsync();
-      TERRIER_FALLTHROUGH;
+      adaptive_.store(true, std::memory_order_relaxed);
+      *func = [this, func_info](ArgTypes... args) -> Ret {
+        // Use the compiled implementation once the function has been tiered up
+        void *raw_func = functions_[func_info->Id()].load(std::memory_order_acquire);
+        if (raw_func != GetBytecodeImpl(func_info->Id())) {
+          auto *jit_f = reinterpret_cast<Ret (*)(ArgTypes...)>(raw_func);
+          return jit_f(args...);
+        }
+        return InvokeInterpreted<Ret>(func_info->Id(), args...);
+      };
+      break;
     }
     case ExecutionMode::Interpret: {
       *func = [this, func_info](ArgTypes... args) -> Ret {
-        // NOLINTNEXTLINE: bugprone-suspicious-semicolon: seems like a false positive because of constexpr
-        if constexpr (std::is_void_v<Ret>) {
-          // Create a temporary on-stack buffer and copy all arguments
-          uint8_t arg_buffer[(0ul + ... + sizeof(args))];
-          detail::CopyAll(arg_buffer, args...);
-
-          // Invoke and finish
-          VM::InvokeFunction(this, func_info->Id(), arg_buffer);
-          return;
-        } else {  // NOLINT
-          // The return value
-          Ret rv{};
-
-          // Create a temporary on-stack buffer and copy all arguments
-          uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
-          detail::CopyAll(arg_buffer, &rv, args...);
-
-          // Invoke and finish
-          VM::InvokeFunction(this, func_info->Id(), arg_buffer);
-          return rv;
-        }
+        return InvokeInterpreted<Ret>(func_info->Id(), args...);
       };
       break;
     }
     case ExecutionMode::Compiled: {
       CompileToMachineCode();
       *func = [this, func_info](ArgTypes... args) -> Ret {
-        void *raw_func = functions_[func_info->Id()].load(std::memory_order_relaxed);
+        void *raw_func = functions_[func_info->Id()].load(std::memory_order_acquire);
         auto *jit_f = reinterpret_cast<Ret (*)(ArgTypes...)>(raw_func);
         return jit_f(args...);
       };
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "common/macros.h"
+
+namespace terrier::execution::vm {
+
+class BytecodeModule;
+
+/**
+ * A directory of object files produced by the LLVM engine, so that a module compiled by an earlier process does not
+ * need to be compiled again.
+ *
+ * Each file is named after a hash of its key, and stores the full key ahead of the object code. The key is built from
+ * the module's bytecode and function metadata plus the environment the object was compiled for: the LLVM version,
+ * the host CPU and its features, and the bytecode handlers bitcode. An entry is only used if its stored key matches
+ * exactly, so hash collisions and files from other builds or machines are misses rather than errors.
+ *
+ * Several processes may share a directory. Entries are written to a temporary file and renamed into place.
+ */
+class ObjectCache {
+ public:
+  /**
+   * Open (and create, if needed) a cache directory
+   * @param directory path of the directory
+   * @param bytecode_handlers_path path of the bytecode handlers bitcode that compiled modules are linked against
+   */
+  ObjectCache(std::string directory, const std::string &bytecode_handlers_path);
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(ObjectCache);
+
+  /**
+   * Look up the object code of a module
+   * @param module the bytecode module
+   * @return the object code, or nullptr if it is not in the cache
+   */
+  std::unique_ptr<llvm::MemoryBuffer> Lookup(const BytecodeModule &module) const;
+
+  /**
+   * Add the object code of a module. Failures are logged and otherwise ignored.
+   * @param module the bytecode module
+   * @param object_code the module's object code
+   */
+  void Store(const BytecodeModule &module, const llvm::MemoryBuffer &object_code) const;
+
+  /**
+   * Object code is only reusable if it does not refer to memory of the process that compiled it. Modules whose
+   * bytecode embeds addresses, such as those of string literals, cannot be cached.
+   * @param module the bytecode module
+   * @return whether the module's object code can be cached
+   */
+  static bool IsCacheable(const BytecodeModule &module);
+
+ private:
+  // The full key of a module in this environment
+  std::string MakeKey(const BytecodeModule &module) const;
+
+  // The path of the file that stores the given key
+  std::string MakePath(const std::string &key) const;
+
+  const std::string directory_;
+  // Describes everything besides the module that the object code depends on
+  std::string environment_;
+  // False if the directory could not be created
+  bool usable_;
+};
+
+}  // namespace terrier::execution::vm
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "execution/vm/bytecode_function_info.h"
+#include "execution/vm/bytecodes.h"
+
+namespace terrier::execution::vm {
+
+class BytecodeModule;
+
+/**
+ * A peephole pass over generated bytecode that fuses pairs of bytecodes into the superinstructions listed in
+ * SUPERINSTRUCTION_LIST. Fusion rewrites opcodes in place and never moves bytecode, so jump offsets and function
+ * ranges stay valid.
+ */
+class Superinstructions {
+ public:
+  /**
+   * A pair of adjacent bytecodes and how often it executes
+   */
+  struct PairProfile {
+    /** The first bytecode */
+    Bytecode first_;
+    /** The bytecode that follows it */
+    Bytecode second_;
+    /** The estimated execution frequency */
+    uint64_t weight_;
+  };
+
+  /**
+   * This class cannot be instantiated
+   */
+  Superinstructions() = delete;
+
+  /**
+   * Fuse all eligible bytecode pairs in the given functions
+   * @param code The bytecode of the functions
+   * @param functions The functions to fuse bytecode in
+   * @return The number of superinstructions created
+   */
+  static uint32_t Fuse(std::vector<uint8_t> *code, const std::vector<FunctionInfo> &functions);
+
+  /**
+   * Estimate how often each pair of adjacent bytecodes in the module executes, to find candidates for new
+   * superinstructions. Without runtime information, a pair is weighted by the loops it is nested in: each level of
+   * nesting multiplies its weight by K_LOOP_WEIGHT.
+   * @param module The module to profile
+   * @return All adjacent pairs, from the most to the least frequent
+   */
+  static std::vector<PairProfile> ProfilePairs(const BytecodeModule &module);
+
+  /**
+   * How many more times a bytecode inside a loop is assumed to execute than one right outside of it
+   */
+  static constexpr uint64_t K_LOOP_WEIGHT = 10;
+};
+
+}  // namespace terrier::execution::vm
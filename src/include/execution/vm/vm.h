@@ -31,8 +31,9 @@ class VM {
   // Forward declare the frame
   class Frame;
 
-  // Interpret the given instruction stream using the given execution frame
-  void Interpret(const uint8_t *ip, Frame *frame);
+  // Interpret the instruction stream of the function with ID @em func_id
+  // using the given execution frame
+  void Interpret(FunctionId func_id, const uint8_t *ip, Frame *frame);
 
   // Execute a call instruction
   const uint8_t *ExecuteCall(const uint8_t *ip, Frame *caller);
@@ -118,19 +118,22 @@ class DBMain {
      * @param txn_layer arguments to the GarbageCollector
      * @param block_store_size_limit argument to the BlockStore
      * @param block_store_reuse_limit argument to the BlockStore
+     * @param block_allocator argument to the BlockStore
      * @param use_gc enable GarbageCollector
+     * @param gc_num_threads argument to the GarbageCollector
      * @param log_manager needed for safe destruction of StorageLayer
      */
     StorageLayer(const common::ManagedPointer<TransactionLayer> txn_layer, const uint64_t block_store_size_limit,
-                 const uint64_t block_store_reuse_limit, const bool use_gc,
-                 const common::ManagedPointer<storage::LogManager> log_manager)
+                 const uint64_t block_store_reuse_limit, storage::BlockAllocator block_allocator, const bool use_gc,
+                 const uint32_t gc_num_threads, const common::ManagedPointer<storage::LogManager> log_manager)
         : deferred_action_manager_(txn_layer->GetDeferredActionManager()), log_manager_(log_manager) {
       if (use_gc)
-        garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
-                                                                         txn_layer->GetDeferredActionManager(),
-                                                                         txn_layer->GetTransactionManager(), DISABLED);
+        garbage_collector_ = std::make_unique<storage::GarbageCollector>(
+            txn_layer->GetTimestampManager(), txn_layer->GetDeferredActionManager(), txn_layer->GetTransactionManager(),
+            DISABLED, gc_num_threads);
 
-      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
+      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit,
+                                                           std::move(block_allocator));
     }
 
     ~StorageLayer() {
@@ -259,7 +262,12 @@ class DBMain {
    */
   class ExecutionLayer {
    public:
-    ExecutionLayer() { execution::ExecutionUtil::InitTPL(); }
+    /**
+     * @param object_cache_directory where compiled object code is cached, empty to disable the cache
+     */
+    explicit ExecutionLayer(const std::string &object_cache_directory = "") {
+      execution::ExecutionUtil::InitTPL(object_cache_directory);
+    }
     ~ExecutionLayer() { execution::ExecutionUtil::ShutdownTPL(); }
   };
 
@@ -303,16 +311,20 @@ class DBMain {
         log_manager = std::make_unique<storage::LogManager>(
             log_file_path_, num_log_manager_buffers_, std::chrono::microseconds{log_serialization_interval_},
             std::chrono::milliseconds{log_persist_interval_}, log_persist_threshold_,
-            common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(thread_registry));
+            common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(thread_registry), synchronous_commit_,
+            num_log_streams_);
         log_manager->Start();
       }
 
       auto txn_layer = std::make_unique<TransactionLayer>(common::ManagedPointer(buffer_segment_pool), use_gc_,
                                                           common::ManagedPointer(log_manager));
 
-      auto storage_layer =
-          std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_, block_store_reuse_,
-                                         use_gc_, common::ManagedPointer(log_manager));
+      storage::BlockAllocator block_allocator;
+      if (block_huge_pages_ || block_numa_policy_ != storage::NumaPolicy::NONE)
+        block_allocator = storage::BlockAllocator(block_huge_pages_, block_numa_policy_);
+      auto storage_layer = std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_,
+                                                          block_store_reuse_, std::move(block_allocator), use_gc_,
+                                                          gc_num_threads_, common::ManagedPointer(log_manager));
 
       std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
       if (use_catalog_) {
@@ -338,7 +350,7 @@ class DBMain {
 
       std::unique_ptr<ExecutionLayer> execution_layer = DISABLED;
       if (use_execution_) {
-        execution_layer = std::make_unique<ExecutionLayer>();
+        execution_layer = std::make_unique<ExecutionLayer>(object_cache_directory_);
       }
 
       std::unique_ptr<trafficcop::TrafficCop> traffic_cop = DISABLED;
@@ -349,7 +361,8 @@ class DBMain {
         TERRIER_ASSERT(use_execution_ && execution_layer != DISABLED, "TrafficCopLayer needs ExecutionLayer.");
         traffic_cop = std::make_unique<trafficcop::TrafficCop>(
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(), DISABLED,
-            common::ManagedPointer(stats_storage), optimizer_timeout_);
+            common::ManagedPointer(stats_storage), optimizer_timeout_, parallel_execution_, compiled_query_cache_size_,
+            query_memory_limit_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -476,6 +489,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetSynchronousCommit(const bool value) {
+      synchronous_commit_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetNumLogStreams(const uint32_t value) {
+      num_log_streams_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -512,6 +543,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value GarbageCollector argument
+     * @return self reference for chaining
+     */
+    Builder &SetGCNumThreads(const uint32_t value) {
+      gc_num_threads_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -575,6 +615,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value BlockStore argument
+     * @return self reference for chaining
+     */
+    Builder &SetBlockHugePages(const bool value) {
+      block_huge_pages_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value BlockStore argument
+     * @return self reference for chaining
+     */
+    Builder &SetBlockNumaPolicy(const storage::NumaPolicy value) {
+      block_numa_policy_ = value;
+      return *this;
+    }
+
     /**
      * @param value TrafficCop argument
      * @return self reference for chaining
@@ -584,6 +642,42 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetParallelExecution(const bool value) {
+      parallel_execution_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetCompiledQueryCacheSize(const uint64_t value) {
+      compiled_query_cache_size_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetQueryMemoryLimit(const uint64_t value) {
+      query_memory_limit_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value ExecutionLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetObjectCacheDirectory(const std::string &value) {
+      object_cache_directory_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -611,18 +705,27 @@ class DBMain {
     int32_t log_serialization_interval_ = 10;
     int32_t log_persist_interval_ = 10;
     uint64_t log_persist_threshold_ = static_cast<uint64_t>(1 << 20);
+    bool synchronous_commit_ = true;
+    uint32_t num_log_streams_ = 1;
     bool use_logging_ = false;
     bool use_gc_ = false;
     bool use_catalog_ = false;
     bool create_default_database_ = true;
     uint64_t block_store_size_ = 1e5;
     uint64_t block_store_reuse_ = 1e3;
+    bool block_huge_pages_ = false;
+    storage::NumaPolicy block_numa_policy_ = storage::NumaPolicy::NONE;
     int32_t gc_interval_ = 10;
+    uint32_t gc_num_threads_ = 1;
     bool use_gc_thread_ = false;
     bool use_stats_storage_ = false;
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
     uint64_t optimizer_timeout_ = 5000;
+    bool parallel_execution_ = false;
+    uint64_t compiled_query_cache_size_ = 0;
+    uint64_t query_memory_limit_ = 0;
+    std::string object_cache_directory_;
     uint16_t network_port_ = 15721;
     bool use_network_ = false;
 
@@ -641,6 +744,14 @@ class DBMain {
           static_cast<uint64_t>(settings_manager->GetInt(settings::Param::record_buffer_segment_reuse));
       block_store_size_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_size));
       block_store_reuse_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_reuse));
+      block_huge_pages_ = settings_manager->GetBool(settings::Param::block_huge_pages);
+      const std::string numa_policy = settings_manager->GetString(settings::Param::block_numa_policy);
+      if (numa_policy == "interleave")
+        block_numa_policy_ = storage::NumaPolicy::INTERLEAVE;
+      else if (numa_policy == "local")
+        block_numa_policy_ = storage::NumaPolicy::LOCAL;
+      else
+        block_numa_policy_ = storage::NumaPolicy::NONE;
 
       log_file_path_ = settings_manager->GetString(settings::Param::log_file_path);
       num_log_manager_buffers_ =
@@ -649,11 +760,19 @@ class DBMain {
       log_persist_interval_ = settings_manager->GetInt(settings::Param::log_persist_interval);
       log_persist_threshold_ =
           static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::log_persist_threshold));
+      synchronous_commit_ = settings_manager->GetBool(settings::Param::synchronous_commit);
+      num_log_streams_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::num_log_streams));
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+      gc_num_threads_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::gc_num_threads));
 
       network_port_ = static_cast<uint16_t>(settings_manager->GetInt(settings::Param::port));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
+      parallel_execution_ = settings_manager->GetBool(settings::Param::parallel_execution);
+      compiled_query_cache_size_ =
+          static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::compiled_query_cache_size));
+      query_memory_limit_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::query_memory_limit));
+      object_cache_directory_ = settings_manager->GetString(settings::Param::object_cache_directory);
 
       return settings_manager;
     }
@@ -233,6 +233,9 @@ class PostgresPacketWriter : public PacketWriter {
       case QueryType::QUERY_SET:
         WriteCommandComplete("SET");
         break;
+      case QueryType::QUERY_COPY:
+        WriteCommandComplete("COPY " + std::to_string(num_rows));
+        break;
       default:
         WriteCommandComplete("This QueryType needs a completion message!");
         break;
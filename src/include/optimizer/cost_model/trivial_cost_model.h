@@ -116,6 +116,12 @@ class TrivialCostModel : public AbstractCostModel {
    */
   void Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) override {}
 
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const InnerMergeJoin *op) override { output_cost_ = 1.f; }
+
   /**
    * Visit a Insert operator
    * @param op operator
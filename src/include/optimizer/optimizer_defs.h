@@ -98,6 +98,7 @@ enum class OpType {
   LEFTHASHJOIN,
   RIGHTHASHJOIN,
   OUTERHASHJOIN,
+  INNERMERGEJOIN,
   INSERT,
   INSERTSELECT,
   DELETE,
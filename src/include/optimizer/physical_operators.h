@@ -789,6 +789,75 @@ class OuterHashJoin : public OperatorNodeContents<OuterHashJoin> {
   common::ManagedPointer<parser::AbstractExpression> join_predicate_;
 };
 
+/**
+ * Physical operator for inner merge join
+ */
+class InnerMergeJoin : public OperatorNodeContents<InnerMergeJoin> {
+ public:
+  /**
+   * @param join_predicates predicates for join
+   * @param left_keys left keys to join
+   * @param right_keys right keys to join
+   * @param key_comparison how the left keys compare to the right keys for tuples that join
+   * @return an InnerMergeJoin operator
+   */
+  static Operator Make(std::vector<AnnotatedExpression> &&join_predicates,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys,
+                       parser::ExpressionType key_comparison);
+
+  /**
+   * Copy
+   * @returns copy of this
+   */
+  BaseOperatorNodeContents *Copy() const override;
+
+  bool operator==(const BaseOperatorNodeContents &r) override;
+
+  common::hash_t Hash() const override;
+
+  /**
+   * @return Left join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftKeys() const { return left_keys_; }
+
+  /**
+   * @return Right join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightKeys() const { return right_keys_; }
+
+  /**
+   * @return How the left keys compare to the right keys
+   */
+  parser::ExpressionType GetKeyComparison() const { return key_comparison_; }
+
+  /**
+   * @return Predicates for the Join
+   */
+  const std::vector<AnnotatedExpression> &GetJoinPredicates() const { return join_predicates_; }
+
+ private:
+  /**
+   * Left join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys_;
+
+  /**
+   * Right join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys_;
+
+  /**
+   * Comparison between the left and right keys
+   */
+  parser::ExpressionType key_comparison_;
+
+  /**
+   * Predicate for join
+   */
+  std::vector<AnnotatedExpression> join_predicates_;
+};
+
 /**
  * Physical operator for INSERT
  */
@@ -154,6 +154,12 @@ class PlanGenerator : public OperatorVisitor {
    */
   void Visit(const OuterHashJoin *op) override;
 
+  /**
+   * Visitor function for a InnerMergeJoin operator
+   * @param op InnerMergeJoin operator being visited
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
   /**
    * Visitor function for a Insert operator
    * @param op Insert operator being visited
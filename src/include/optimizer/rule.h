@@ -35,6 +35,7 @@ enum class RuleType : uint32_t {
   AGGREGATE_TO_PLAIN_AGGREGATE,
   INNER_JOIN_TO_NL_JOIN,
   INNER_JOIN_TO_HASH_JOIN,
+  INNER_JOIN_TO_MERGE_JOIN,
   IMPLEMENT_DISTINCT,
   IMPLEMENT_LIMIT,
   EXPORT_EXTERNAL_FILE_TO_PHYSICAL,
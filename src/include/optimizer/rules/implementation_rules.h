@@ -372,6 +372,34 @@ class LogicalInnerJoinToPhysicalInnerHashJoin : public Rule {
                  OptimizationContext *context) const override;
 };
 
+/**
+ * Rule transforms Logical Inner Join to InnerMergeJoin
+ */
+class LogicalInnerJoinToPhysicalInnerMergeJoin : public Rule {
+ public:
+  /**
+   * Constructor
+   */
+  LogicalInnerJoinToPhysicalInnerMergeJoin();
+
+  /**
+   * Checks whether the given rule can be applied
+   * @param plan OperatorNode to check
+   * @param context Current OptimizationContext executing under
+   * @returns Whether the input OperatorNode passes the check
+   */
+  bool Check(common::ManagedPointer<OperatorNode> plan, OptimizationContext *context) const override;
+
+  /**
+   * Transforms the input expression using the given rule
+   * @param input Input OperatorNode to transform
+   * @param transformed Vector of transformed OperatorNodes
+   * @param context Current OptimizationContext executing under
+   */
+  void Transform(common::ManagedPointer<OperatorNode> input, std::vector<std::unique_ptr<OperatorNode>> *transformed,
+                 OptimizationContext *context) const override;
+};
+
 /**
  * Rule transforms LogicalLimit -> Limit
  */
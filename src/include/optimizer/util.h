@@ -51,6 +51,23 @@ class OptimizerUtil {
                                   const std::unordered_set<std::string> &left_alias,
                                   const std::unordered_set<std::string> &right_alias);
 
+  /**
+   * Walks through a vector of join predicates. Finds an inequality (<, <=, >, >=) between a column of the left
+   * tables and a column of the right tables, and generates a single pair of join keys from it.
+   *
+   * @param join_predicates vector of join predicates
+   * @param left_keys output vector of left keys
+   * @param right_keys output vector of right keys
+   * @param left_alias Alias set for left table
+   * @param right_alias Alias set for right table
+   * @returns how the left key compares to the right key, or INVALID if there is no such inequality
+   */
+  static parser::ExpressionType ExtractInequalityJoinKey(
+      const std::vector<AnnotatedExpression> &join_predicates,
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *left_keys,
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *right_keys,
+      const std::unordered_set<std::string> &left_alias, const std::unordered_set<std::string> &right_alias);
+
   /**
    * Generate all tuple value expressions of a base table
    *
@@ -8,6 +8,10 @@
 #include "parser/expression/abstract_expression.h"
 #include "type/transient_value.h"
 
+namespace terrier::execution::compiler {
+class ConstantLifter;
+}  // namespace terrier::execution::compiler
+
 namespace terrier::parser {
 /**
  * ConstantValueExpression represents a constant, e.g. numbers, string literals.
@@ -97,6 +101,7 @@ class ConstantValueExpression : public AbstractExpression {
 
  private:
   friend class binder::BindNodeVisitor; /* value_ may be modified, e.g., when parsing dates. */
+  friend class execution::compiler::ConstantLifter; /* value_ is masked while the plan is fingerprinted. */
   /** The constant held inside this ConstantValueExpression. */
   type::TransientValue value_;
 };
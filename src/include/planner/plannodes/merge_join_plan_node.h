@@ -0,0 +1,166 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "parser/expression_defs.h"
+#include "planner/plannodes/abstract_join_plan_node.h"
+#include "planner/plannodes/plan_visitor.h"
+
+namespace terrier::planner {
+
+/**
+ * Plan node for sort-merge join. Both children must produce their tuples in ascending order of their join keys. The
+ * left child is materialized in sorted order, and every right tuple is matched against the range of left tuples whose
+ * keys compare to its keys as the key comparison requires. An equality comparison can have any number of keys; the
+ * inequality comparisons (<, <=, >, >=, as in "left key < right key") have exactly one. The join predicate is checked
+ * on every matching pair.
+ */
+class MergeJoinPlanNode : public AbstractJoinPlanNode {
+ public:
+  /**
+   * Builder for merge join plan node
+   */
+  class Builder : public AbstractJoinPlanNode::Builder<Builder> {
+   public:
+    Builder() = default;
+
+    /**
+     * Don't allow builder to be copied or moved
+     */
+    DISALLOW_COPY_AND_MOVE(Builder);
+
+    /**
+     * @param key key to add to left merge keys
+     * @return builder object
+     */
+    Builder &AddLeftMergeKey(common::ManagedPointer<parser::AbstractExpression> key) {
+      left_merge_keys_.emplace_back(key);
+      return *this;
+    }
+
+    /**
+     * @param key key to add to right merge keys
+     * @return builder object
+     */
+    Builder &AddRightMergeKey(common::ManagedPointer<parser::AbstractExpression> key) {
+      right_merge_keys_.emplace_back(key);
+      return *this;
+    }
+
+    /**
+     * @param key_comparison how the left keys compare to the right keys of matching tuples
+     * @return builder object
+     */
+    Builder &SetKeyComparison(parser::ExpressionType key_comparison) {
+      key_comparison_ = key_comparison;
+      return *this;
+    }
+
+    /**
+     * Build the merge join plan node
+     * @return plan node
+     */
+    std::unique_ptr<MergeJoinPlanNode> Build() {
+      return std::unique_ptr<MergeJoinPlanNode>(
+          new MergeJoinPlanNode(std::move(children_), std::move(output_schema_), join_type_, join_predicate_,
+                                std::move(left_merge_keys_), std::move(right_merge_keys_), key_comparison_));
+    }
+
+   protected:
+    /**
+     * left side merge keys
+     */
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> left_merge_keys_;
+    /**
+     * right side merge keys
+     */
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> right_merge_keys_;
+    /**
+     * how the left keys compare to the right keys of matching tuples
+     */
+    parser::ExpressionType key_comparison_ = parser::ExpressionType::COMPARE_EQUAL;
+  };
+
+ private:
+  /**
+   * @param children child plan nodes
+   * @param output_schema Schema representing the structure of the output of this plan node
+   * @param join_type logical join type
+   * @param predicate join predicate
+   * @param left_merge_keys left side keys the left child is ordered on
+   * @param right_merge_keys right side keys the right child is ordered on
+   * @param key_comparison how the left keys compare to the right keys of matching tuples
+   */
+  MergeJoinPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
+                    std::unique_ptr<OutputSchema> output_schema, LogicalJoinType join_type,
+                    common::ManagedPointer<parser::AbstractExpression> predicate,
+                    std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_merge_keys,
+                    std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_merge_keys,
+                    parser::ExpressionType key_comparison)
+      : AbstractJoinPlanNode(std::move(children), std::move(output_schema), join_type, predicate),
+        left_merge_keys_(std::move(left_merge_keys)),
+        right_merge_keys_(std::move(right_merge_keys)),
+        key_comparison_(key_comparison) {
+    TERRIER_ASSERT(left_merge_keys_.size() == right_merge_keys_.size() && !left_merge_keys_.empty(),
+                   "Merge joins need the same non-zero number of keys on each side");
+    TERRIER_ASSERT(key_comparison_ == parser::ExpressionType::COMPARE_EQUAL || left_merge_keys_.size() == 1,
+                   "Inequality merge joins have a single key");
+  }
+
+ public:
+  /**
+   * Default constructor used for deserialization
+   */
+  MergeJoinPlanNode() = default;
+
+  DISALLOW_COPY_AND_MOVE(MergeJoinPlanNode)
+
+  /**
+   * @return the type of this plan node
+   */
+  PlanNodeType GetPlanNodeType() const override { return PlanNodeType::MERGEJOIN; }
+
+  /**
+   * @return left side merge keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftMergeKeys() const {
+    return left_merge_keys_;
+  }
+
+  /**
+   * @return right side merge keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightMergeKeys() const {
+    return right_merge_keys_;
+  }
+
+  /**
+   * @return how the left keys compare to the right keys of matching tuples
+   */
+  parser::ExpressionType GetKeyComparison() const { return key_comparison_; }
+
+  /**
+   * @return the hashed value of this plan node
+   */
+  common::hash_t Hash() const override;
+
+  bool operator==(const AbstractPlanNode &rhs) const override;
+
+  void Accept(common::ManagedPointer<PlanVisitor> v) const override { v->Visit(this); }
+
+  nlohmann::json ToJson() const override;
+  std::vector<std::unique_ptr<parser::AbstractExpression>> FromJson(const nlohmann::json &j) override;
+
+ private:
+  // The left and right expressions that constitute the join keys
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_merge_keys_;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_merge_keys_;
+  // How the left keys compare to the right keys of matching tuples
+  parser::ExpressionType key_comparison_;
+};
+
+DEFINE_JSON_DECLARATIONS(MergeJoinPlanNode);
+
+}  // namespace terrier::planner
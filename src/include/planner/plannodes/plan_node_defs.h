@@ -29,6 +29,7 @@ enum class PlanNodeType {
   NESTLOOP,
   HASHJOIN,
   INDEXNLJOIN,
+  MERGEJOIN,
 
   // Mutator Nodes
   UPDATE,
@@ -59,6 +60,7 @@ enum class PlanNodeType {
   DISTINCT,
   HASH,
   SETOP,
+  WINDOW,
 
   // Utility
   EXPORT_EXTERNAL_FILE,
@@ -95,7 +97,38 @@ enum class LogicalJoinType {
 // Set Operation Types
 //===--------------------------------------------------------------------===//
 
-enum class SetOpType { INVALID = INVALID_TYPE_ID, INTERSECT = 1, INTERSECT_ALL = 2, EXCEPT = 3, EXCEPT_ALL = 4 };
+enum class SetOpType {
+  INVALID = INVALID_TYPE_ID,
+  INTERSECT = 1,
+  INTERSECT_ALL = 2,
+  EXCEPT = 3,
+  EXCEPT_ALL = 4,
+  UNION = 5,
+  UNION_ALL = 6
+};
+
+//===--------------------------------------------------------------------===//
+// Window Function Types
+//===--------------------------------------------------------------------===//
+
+enum class WindowFunctionType : uint8_t {
+  ROW_NUMBER = 0,
+  RANK = 1,
+  DENSE_RANK = 2,
+  AGGREGATE = 3  // an aggregate over the frame of each row
+};
+
+/** How the bounds of a window frame are measured */
+enum class WindowFrameMode : uint8_t { ROWS = 0, RANGE = 1 };
+
+/** The kind of a bound of a window frame */
+enum class WindowFrameBoundType : uint8_t {
+  UNBOUNDED_PRECEDING = 0,
+  PRECEDING = 1,
+  CURRENT_ROW = 2,
+  FOLLOWING = 3,
+  UNBOUNDED_FOLLOWING = 4
+};
 
 //===--------------------------------------------------------------------===//
 // External File defaults
@@ -12,10 +12,10 @@ namespace terrier::planner {
 
 /**
  * Plan node for set operation:
- * INTERSECT/INTERSECT ALL/EXPECT/EXCEPT ALL
+ * UNION/UNION ALL/INTERSECT/INTERSECT ALL/EXCEPT/EXCEPT ALL
  *
- * @warning UNION (ALL) is handled differently.
- * IMPORTANT: Both children must have the same physical schema.
+ * UNION (ALL) may have any number of children. The other operations have exactly two, and the left one comes first.
+ * IMPORTANT: All children must have the same physical schema.
  */
 class SetOpPlanNode : public AbstractPlanNode {
  public:
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "optimizer/optimizer_defs.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/order_by_plan_node.h"
+#include "planner/plannodes/plan_node_defs.h"
+#include "planner/plannodes/plan_visitor.h"
+
+namespace terrier::planner {
+
+/**
+ * A window function computed by a window plan node
+ */
+struct WindowFunction {
+  /**
+   * The kind of function
+   */
+  WindowFunctionType type_;
+  /**
+   * The AggregateExpression computed over the frame of each row. Null for ranking functions.
+   */
+  common::ManagedPointer<parser::AbstractExpression> aggregate_;
+  /**
+   * How the bounds of the frame are measured. RANGE frames only support unbounded and CURRENT ROW bounds.
+   */
+  WindowFrameMode frame_mode_;
+  /**
+   * The kind of the start bound of the frame
+   */
+  WindowFrameBoundType frame_start_;
+  /**
+   * The number of rows of a PRECEDING or FOLLOWING start bound
+   */
+  uint64_t frame_start_offset_;
+  /**
+   * The kind of the end bound of the frame
+   */
+  WindowFrameBoundType frame_end_;
+  /**
+   * The number of rows of a PRECEDING or FOLLOWING end bound
+   */
+  uint64_t frame_end_offset_;
+
+  /**
+   * @param type ROW_NUMBER, RANK or DENSE_RANK
+   * @return The ranking function
+   */
+  static WindowFunction Ranking(WindowFunctionType type) {
+    return {type, nullptr, WindowFrameMode::RANGE, WindowFrameBoundType::UNBOUNDED_PRECEDING, 0,
+            WindowFrameBoundType::CURRENT_ROW, 0};
+  }
+
+  /**
+   * @param aggregate The AggregateExpression to compute
+   * @param mode How the bounds of the frame are measured
+   * @param start The start bound of the frame
+   * @param start_offset The number of rows of a PRECEDING or FOLLOWING start bound
+   * @param end The end bound of the frame
+   * @param end_offset The number of rows of a PRECEDING or FOLLOWING end bound
+   * @return The aggregate over the given frame
+   */
+  static WindowFunction Aggregate(common::ManagedPointer<parser::AbstractExpression> aggregate, WindowFrameMode mode,
+                                  WindowFrameBoundType start, uint64_t start_offset, WindowFrameBoundType end,
+                                  uint64_t end_offset) {
+    return {WindowFunctionType::AGGREGATE, aggregate, mode, start, start_offset, end, end_offset};
+  }
+
+  /**
+   * @param aggregate The AggregateExpression to compute
+   * @return The aggregate over the default frame, RANGE BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW. With no ordering,
+   *         this is the whole partition.
+   */
+  static WindowFunction Aggregate(common::ManagedPointer<parser::AbstractExpression> aggregate) {
+    return Aggregate(aggregate, WindowFrameMode::RANGE, WindowFrameBoundType::UNBOUNDED_PRECEDING, 0,
+                     WindowFrameBoundType::CURRENT_ROW, 0);
+  }
+
+  /**
+   * @return the hashed value of this window function
+   */
+  common::hash_t Hash() const;
+
+  /**
+   * @param rhs The other window function
+   * @return true if the two window functions are the same
+   */
+  bool operator==(const WindowFunction &rhs) const;
+
+  /**
+   * @param rhs The other window function
+   * @return true if the two window functions are not the same
+   */
+  bool operator!=(const WindowFunction &rhs) const { return !(*this == rhs); }
+};
+
+/**
+ * Plan node for window functions. Its child's rows are grouped into partitions by the partitioning terms, and ordered
+ * within each partition by the sort keys. Every row is output once, with its window functions computed over its
+ * partition.
+ *
+ * In the output schema, a DerivedValueExpression with tuple index 0 refers to a column of the child, and one with
+ * tuple index 1 refers to a window function.
+ */
+class WindowPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Builder for a window plan node
+   */
+  class Builder : public AbstractPlanNode::Builder<Builder> {
+   public:
+    Builder() = default;
+
+    /**
+     * Don't allow builder to be copied or moved
+     */
+    DISALLOW_COPY_AND_MOVE(Builder);
+
+    /**
+     * @param term expression to partition by
+     * @return builder object
+     */
+    Builder &AddPartitionByTerm(common::ManagedPointer<parser::AbstractExpression> term) {
+      partition_by_terms_.emplace_back(term);
+      return *this;
+    }
+
+    /**
+     * @param key expression to order the rows of a partition by
+     * @param ordering ordering (ASC or DESC) for key
+     * @return builder object
+     */
+    Builder &AddSortKey(common::ManagedPointer<parser::AbstractExpression> key,
+                        optimizer::OrderByOrderingType ordering) {
+      sort_keys_.emplace_back(key, ordering);
+      return *this;
+    }
+
+    /**
+     * @param function window function to compute
+     * @return builder object
+     */
+    Builder &AddWindowFunction(const WindowFunction &function) {
+      window_functions_.emplace_back(function);
+      return *this;
+    }
+
+    /**
+     * Build the window plan node
+     * @return plan node
+     */
+    std::unique_ptr<WindowPlanNode> Build() {
+      return std::unique_ptr<WindowPlanNode>(new WindowPlanNode(std::move(children_), std::move(output_schema_),
+                                                                std::move(partition_by_terms_), std::move(sort_keys_),
+                                                                std::move(window_functions_)));
+    }
+
+   protected:
+    /**
+     * Expressions to partition by
+     */
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> partition_by_terms_;
+    /**
+     * Expressions and ordering types used (in order) to order the rows of a partition
+     */
+    std::vector<SortKey> sort_keys_;
+    /**
+     * Window functions to compute
+     */
+    std::vector<WindowFunction> window_functions_;
+  };
+
+ private:
+  /**
+   * @param children child plan nodes
+   * @param output_schema Schema representing the structure of the output of this plan node
+   * @param partition_by_terms expressions to partition by
+   * @param sort_keys keys to order the rows of a partition by
+   * @param window_functions window functions to compute
+   */
+  WindowPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children, std::unique_ptr<OutputSchema> output_schema,
+                 std::vector<common::ManagedPointer<parser::AbstractExpression>> partition_by_terms,
+                 std::vector<SortKey> sort_keys, std::vector<WindowFunction> window_functions)
+      : AbstractPlanNode(std::move(children), std::move(output_schema)),
+        partition_by_terms_(std::move(partition_by_terms)),
+        sort_keys_(std::move(sort_keys)),
+        window_functions_(std::move(window_functions)) {}
+
+ public:
+  /**
+   * Default constructor used for deserialization
+   */
+  WindowPlanNode() = default;
+
+  DISALLOW_COPY_AND_MOVE(WindowPlanNode)
+
+  /**
+   * @return expressions to partition by
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetPartitionByTerms() const {
+    return partition_by_terms_;
+  }
+
+  /**
+   * @return keys to order the rows of a partition by
+   */
+  const std::vector<SortKey> &GetSortKeys() const { return sort_keys_; }
+
+  /**
+   * @return window functions to compute
+   */
+  const std::vector<WindowFunction> &GetWindowFunctions() const { return window_functions_; }
+
+  /**
+   * @return the type of this plan node
+   */
+  PlanNodeType GetPlanNodeType() const override { return PlanNodeType::WINDOW; }
+
+  /**
+   * @return the hashed value of this plan node
+   */
+  common::hash_t Hash() const override;
+
+  bool operator==(const AbstractPlanNode &rhs) const override;
+
+  void Accept(common::ManagedPointer<PlanVisitor> v) const override { v->Visit(this); }
+
+  nlohmann::json ToJson() const override;
+  std::vector<std::unique_ptr<parser::AbstractExpression>> FromJson(const nlohmann::json &j) override;
+
+ private:
+  /* Expressions to partition by */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> partition_by_terms_;
+
+  /* Expressions and ordering types used (in order) to order the rows of a partition */
+  std::vector<SortKey> sort_keys_;
+
+  /* Window functions to compute */
+  std::vector<WindowFunction> window_functions_;
+};
+
+DEFINE_JSON_DECLARATIONS(WindowPlanNode);
+
+}  // namespace terrier::planner
@@ -107,5 +107,35 @@ class Callbacks {
    */
   static void MetricsPipeline(void *old_value, void *new_value, DBMain *db_main,
                               common::ManagedPointer<common::ActionContext> action_context);
+
+  /**
+   * Enable or disable parallel pipelines in generated code
+   * @param old_value old settings value
+   * @param new_value new settings value
+   * @param db_main pointer to db_main
+   * @param action_context pointer to the action context for this settings change
+   */
+  static void ParallelExecution(void *old_value, void *new_value, DBMain *db_main,
+                                common::ManagedPointer<common::ActionContext> action_context);
+
+  /**
+   * Resize the compiled query cache
+   * @param old_value old settings value
+   * @param new_value new settings value
+   * @param db_main pointer to db_main
+   * @param action_context pointer to the action context for this settings change
+   */
+  static void CompiledQueryCacheSize(void *old_value, void *new_value, DBMain *db_main,
+                                     common::ManagedPointer<common::ActionContext> action_context);
+
+  /**
+   * Change the memory budget of queries
+   * @param old_value old settings value
+   * @param new_value new settings value
+   * @param db_main pointer to db_main
+   * @param action_context pointer to the action context for this settings change
+   */
+  static void QueryMemoryLimit(void *old_value, void *new_value, DBMain *db_main,
+                               common::ManagedPointer<common::ActionContext> action_context);
 };
 }  // namespace terrier::settings
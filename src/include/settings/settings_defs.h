@@ -55,6 +55,24 @@ SETTING_int(
     terrier::settings::Callbacks::BlockStoreReuseLimit
 )
 
+// BlockStore huge pages
+SETTING_bool(
+    block_huge_pages,
+    "Whether storage blocks are backed by huge pages, explicit if reserved or else transparent (default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// BlockStore NUMA placement
+SETTING_string(
+    block_numa_policy,
+    "How storage blocks are placed on NUMA nodes: none, interleave, or local (default: none)",
+    "none",
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Garbage collector thread interval
 SETTING_int(
     gc_interval,
@@ -66,6 +84,17 @@ SETTING_int(
     terrier::settings::Callbacks::NoOp
 )
 
+// Garbage collector threads
+SETTING_int(
+    gc_num_threads,
+    "Number of threads that share the work of every garbage collection (default: 1)",
+    1,
+    1,
+    256,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Path to log file for WAL
 SETTING_string(
     log_file_path,
@@ -108,6 +137,26 @@ SETTING_int(
     terrier::settings::Callbacks::NoOp
 )
 
+// Whether commits wait for the WAL to be persisted
+SETTING_bool(
+    synchronous_commit,
+    "Whether transactions wait for their logs to be persisted before reporting their commit (default: true)",
+    true,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Number of log streams
+SETTING_int(
+    num_log_streams,
+    "The number of log streams, each serialized and written to its own log file by its own threads (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Optimizer timeout
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task execution step of optimizer, "
@@ -120,6 +169,37 @@ SETTING_bool(
     "Whether parallel execution for scans is enabled",
     true,
     true,
+    terrier::settings::Callbacks::ParallelExecution
+)
+
+// Compiled query cache size
+SETTING_int64(
+    compiled_query_cache_size,
+    "Maximum code size (bytes) of the compiled queries kept for reuse, 0 disables the cache (default: 64MB)",
+    (1 << 26) /* 64MB */,
+    0,
+    (1LL << 34) /* 16GB */,
+    true,
+    terrier::settings::Callbacks::CompiledQueryCacheSize
+)
+
+// Query memory budget
+SETTING_int64(
+    query_memory_limit,
+    "Memory (bytes) a query may use before its aggregations and sorts spill to disk, 0 disables the limit (default: 0)",
+    0,
+    0,
+    (1LL << 40) /* 1TB */,
+    true,
+    terrier::settings::Callbacks::QueryMemoryLimit
+)
+
+// Directory for compiled object code that is reused across restarts
+SETTING_string(
+    object_cache_directory,
+    "The directory where JIT-compiled object code is cached, empty disables the cache (default: empty)",
+    "",
+    false,
     terrier::settings::Callbacks::NoOp
 )
 
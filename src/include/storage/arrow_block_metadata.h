@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <map>
 #include <unordered_set>
 #include <utility>
@@ -11,9 +12,15 @@ namespace terrier::storage {
 // TODO(Tianyu): In this future, there can be situations where varlen fields should not be gathered
 // compressed (e.g, blob). Can add a flag here to handle that.
 /**
- * Type of Arrow column
+ * Type of Arrow column. Run-length encoding and bit-packing only apply to fixed-length integer columns.
  */
-enum class ArrowColumnType : uint8_t { FIXED_LENGTH = 0, GATHERED_VARLEN, DICTIONARY_COMPRESSED };
+enum class ArrowColumnType : uint8_t {
+  FIXED_LENGTH = 0,
+  GATHERED_VARLEN,
+  DICTIONARY_COMPRESSED,
+  RUN_LENGTH_ENCODED,
+  BIT_PACKED
+};
 
 /**
  * Stores information about an Arrow varlen column. This class implements an Arrow list, with
@@ -115,13 +122,179 @@ class ArrowVarlenColumn {
   uint64_t *offsets_ = nullptr;
 };
 
+/**
+ * Stores a compressed copy of a fixed-length integer column of a frozen block. The column itself stays in the block
+ * where transactions and Arrow readers expect it, but scans can read the much smaller copy instead.
+ *
+ * A run-length encoded column stores the value of every run of equal values, and the offset one past the end of the
+ * run. A bit-packed column stores every value as its difference to the smallest value of the column (the base), in as
+ * many bits as the largest difference needs. All values are sign-extended to 64 bits. The values of NULL slots are
+ * unspecified, as the null bitmap of the column still tells them apart.
+ */
+class EncodedIntegerColumn {
+ public:
+  /**
+   * Constructs an empty EncodedIntegerColumn
+   */
+  EncodedIntegerColumn() = default;
+
+  DISALLOW_COPY(EncodedIntegerColumn)
+
+  /**
+   * Move constructor
+   * @param other object to move from
+   */
+  EncodedIntegerColumn(EncodedIntegerColumn &&other) noexcept
+      : base_(other.base_),
+        num_runs_(other.num_runs_),
+        bit_width_(other.bit_width_),
+        run_values_(other.run_values_),
+        run_ends_(other.run_ends_),
+        packed_values_(other.packed_values_) {
+    other.run_values_ = nullptr;
+    other.run_ends_ = nullptr;
+    other.packed_values_ = nullptr;
+  }
+
+  /**
+   * Move-assigmenet operator
+   * @param other object to move from
+   * @return self-reference
+   */
+  EncodedIntegerColumn &operator=(EncodedIntegerColumn &&other) noexcept {
+    if (this != &other) {
+      Deallocate();
+      base_ = other.base_;
+      num_runs_ = other.num_runs_;
+      bit_width_ = other.bit_width_;
+      run_values_ = other.run_values_;
+      other.run_values_ = nullptr;
+      run_ends_ = other.run_ends_;
+      other.run_ends_ = nullptr;
+      packed_values_ = other.packed_values_;
+      other.packed_values_ = nullptr;
+    }
+    return *this;
+  }
+
+  /**
+   * Destructs an EncodedIntegerColumn
+   */
+  ~EncodedIntegerColumn() { Deallocate(); }
+
+  /**
+   * Allocates a run-length encoded column
+   * @param num_runs number of runs of equal values
+   * @return the column, whose runs are still to be filled in
+   */
+  static EncodedIntegerColumn RunLengthEncoded(uint32_t num_runs) {
+    EncodedIntegerColumn result;
+    result.num_runs_ = num_runs;
+    result.run_values_ = common::AllocationUtil::AllocateAligned<int64_t>(num_runs);
+    result.run_ends_ = common::AllocationUtil::AllocateAligned<uint32_t>(num_runs);
+    return result;
+  }
+
+  /**
+   * Allocates a bit-packed column, with all the differences to the base zeroed out
+   * @param num_values number of values in the column
+   * @param base the smallest value in the column
+   * @param bit_width number of bits of every packed difference, between 0 and 64
+   * @return the column, whose values are still to be packed
+   */
+  static EncodedIntegerColumn BitPacked(uint32_t num_values, int64_t base, uint8_t bit_width) {
+    TERRIER_ASSERT(bit_width <= 64, "values are at most 64 bits wide");
+    EncodedIntegerColumn result;
+    result.base_ = base;
+    result.bit_width_ = bit_width;
+    // One word more than needed, so unpacking can always read the word after the one a value starts in
+    const uint32_t num_words = static_cast<uint32_t>((static_cast<uint64_t>(num_values) * bit_width + 63) / 64) + 1;
+    result.packed_values_ = common::AllocationUtil::AllocateAligned<uint64_t>(num_words);
+    std::memset(result.packed_values_, 0, num_words * sizeof(uint64_t));
+    return result;
+  }
+
+  /**
+   * @return number of runs of a run-length encoded column
+   */
+  uint32_t NumRuns() const { return num_runs_; }
+
+  /**
+   * @return the value of every run of a run-length encoded column
+   */
+  int64_t *RunValues() const { return run_values_; }
+
+  /**
+   * @return the offset one past the end of every run of a run-length encoded column
+   */
+  uint32_t *RunEnds() const { return run_ends_; }
+
+  /**
+   * @return the smallest value of a bit-packed column
+   */
+  int64_t Base() const { return base_; }
+
+  /**
+   * @return the number of bits of every packed difference of a bit-packed column
+   */
+  uint8_t BitWidth() const { return bit_width_; }
+
+  /**
+   * Packs the value of the given slot of a bit-packed column
+   * @param offset offset of the slot in the block
+   * @param value the value, no smaller than the base
+   */
+  void Pack(uint32_t offset, int64_t value) {
+    if (bit_width_ == 0) return;
+    const uint64_t delta = static_cast<uint64_t>(value) - static_cast<uint64_t>(base_);
+    const uint64_t bit = static_cast<uint64_t>(offset) * bit_width_;
+    const uint64_t word = bit / 64, shift = bit % 64;
+    packed_values_[word] |= delta << shift;
+    if (shift + bit_width_ > 64) packed_values_[word + 1] |= delta >> (64 - shift);
+  }
+
+  /**
+   * @param offset offset of the slot in the block
+   * @return the value of the given slot of a bit-packed column
+   */
+  int64_t Unpack(uint32_t offset) const {
+    if (bit_width_ == 0) return base_;
+    const uint64_t bit = static_cast<uint64_t>(offset) * bit_width_;
+    const uint64_t word = bit / 64, shift = bit % 64;
+    uint64_t delta = packed_values_[word] >> shift;
+    if (shift + bit_width_ > 64) delta |= packed_values_[word + 1] << (64 - shift);
+    if (bit_width_ < 64) delta &= (uint64_t{1} << bit_width_) - 1;
+    return static_cast<int64_t>(static_cast<uint64_t>(base_) + delta);
+  }
+
+  /**
+   * Deallocates all associated buffers in the EncodedIntegerColumn
+   */
+  void Deallocate() {
+    delete[] reinterpret_cast<byte *>(run_values_);
+    run_values_ = nullptr;
+    delete[] reinterpret_cast<byte *>(run_ends_);
+    run_ends_ = nullptr;
+    delete[] packed_values_;
+    packed_values_ = nullptr;
+  }
+
+ private:
+  int64_t base_ = 0;
+  uint32_t num_runs_ = 0;
+  uint8_t bit_width_ = 0;
+  int64_t *run_values_ = nullptr;      // for run-length encoding
+  uint32_t *run_ends_ = nullptr;       // for run-length encoding
+  uint64_t *packed_values_ = nullptr;  // for bit-packing
+};
+
 /**
  * An ArrowColumnInfo object contains everything needed to reason about Arrow storage of a column in the block.
  *
  * All columns has a type associated with it. Gathered varlen columns has an ArrowVarlenColumn. If the column
  * is dictionary-compressed, it has an ArrowVarlenColumn that is the dictionary, and an indices array that encodes
  * the values. Notice here that the meaning of the ArrowVarlenColumn is different for dictionary-encoded columns
- * and simple gathered columns.
+ * and simple gathered columns. Run-length encoded and bit-packed integer columns have an EncodedIntegerColumn.
  */
 class ArrowColumnInfo {
  public:
@@ -135,7 +308,10 @@ class ArrowColumnInfo {
    * @param other the object to move from
    */
   ArrowColumnInfo(ArrowColumnInfo &&other) noexcept
-      : type_(other.type_), varlen_column_(std::move(other.varlen_column_)), indices_(other.indices_) {
+      : type_(other.type_),
+        varlen_column_(std::move(other.varlen_column_)),
+        indices_(other.indices_),
+        encoded_column_(std::move(other.encoded_column_)) {
     other.indices_ = nullptr;
   }
 
@@ -156,6 +332,7 @@ class ArrowColumnInfo {
       delete[] indices_;
       indices_ = other.indices_;
       other.indices_ = nullptr;
+      encoded_column_ = std::move(other.encoded_column_);
     }
     return *this;
   }
@@ -164,10 +341,18 @@ class ArrowColumnInfo {
    * @return type of the Arrow Column
    */
   ArrowColumnType &Type() { return type_; }
+  /**
+   * @return type of the Arrow Column
+   */
+  ArrowColumnType Type() const { return type_; }
   /**
    * @return ArrowVarlenColumn object for the column
    */
   ArrowVarlenColumn &VarlenColumn() { return varlen_column_; }
+  /**
+   * @return ArrowVarlenColumn object for the column
+   */
+  const ArrowVarlenColumn &VarlenColumn() const { return varlen_column_; }
 
   /**
    * Returns the indices array. This array is only meaningful if the column is dictionary compressed. The
@@ -181,11 +366,43 @@ class ArrowColumnInfo {
   }
 
   /**
-   * Deallocates all associated buffers in the ArrowVarlenColumn
+   * @return the indices array, which is only meaningful if the column is dictionary compressed
+   */
+  const uint64_t *Indices() const {
+    TERRIER_ASSERT(type_ == ArrowColumnType::DICTIONARY_COMPRESSED,
+                   "this array is only meaningful if the column is dicationary compressed");
+    return indices_;
+  }
+
+  /**
+   * Returns the compressed copy of the column. This is only meaningful if the column is run-length encoded or
+   * bit-packed.
+   * @return the compressed column
+   */
+  EncodedIntegerColumn &EncodedColumn() {
+    TERRIER_ASSERT(type_ == ArrowColumnType::RUN_LENGTH_ENCODED || type_ == ArrowColumnType::BIT_PACKED,
+                   "this column is only meaningful if the column is run-length encoded or bit-packed");
+    return encoded_column_;
+  }
+
+  /**
+   * @return the compressed copy of the column, which is only meaningful if the column is run-length encoded or
+   * bit-packed
+   */
+  const EncodedIntegerColumn &EncodedColumn() const {
+    TERRIER_ASSERT(type_ == ArrowColumnType::RUN_LENGTH_ENCODED || type_ == ArrowColumnType::BIT_PACKED,
+                   "this column is only meaningful if the column is run-length encoded or bit-packed");
+    return encoded_column_;
+  }
+
+  /**
+   * Deallocates all associated buffers in the ArrowColumnInfo
    */
   void Deallocate() {
     delete[] indices_;
+    indices_ = nullptr;
     varlen_column_.Deallocate();
+    encoded_column_.Deallocate();
   }
 
  private:
@@ -195,7 +412,71 @@ class ArrowColumnInfo {
   ArrowColumnType type_;
   ArrowVarlenColumn varlen_column_;  // For varlen and dictionary
   // TODO(Tianyu): Add null bitmap
-  uint64_t *indices_ = nullptr;  // for dictionary
+  uint64_t *indices_ = nullptr;          // for dictionary
+  EncodedIntegerColumn encoded_column_;  // for run-length encoding and bit-packing
+};
+
+/**
+ * A ColumnZoneMap summarizes the values of a fixed-length column in a block by their range, so that scans can skip
+ * blocks that cannot hold any value they are looking for. Values are compared as signed integers of the attribute
+ * size, whatever their SQL type is, and NULLs are left out. The range is exact once the block is frozen. While the
+ * block is hot, every value is added to the range before it is written to the block, and the range never shrinks, so
+ * it always covers every version of every tuple that any transaction can read from the block.
+ *
+ * A zeroed-out zone map is empty, which lets it live in the block header.
+ */
+class ColumnZoneMap {
+ public:
+  MEM_REINTERPRETATION_ONLY(ColumnZoneMap)
+
+  /**
+   * @return whether no non-NULL value was ever written to the column
+   */
+  bool Empty() const { return Min() > Max(); }
+
+  /**
+   * @return the smallest value of the column, or INT64_MAX if the zone map is empty
+   */
+  int64_t Min() const { return Decode(~min_.load()); }
+
+  /**
+   * @return the largest value of the column, or INT64_MIN if the zone map is empty
+   */
+  int64_t Max() const { return Decode(max_.load()); }
+
+  /**
+   * Widens the range to cover the given value. Safe to call concurrently.
+   * @param value the value about to be written to the column
+   */
+  void Widen(int64_t value) {
+    FetchMax(&min_, ~Encode(value));
+    FetchMax(&max_, Encode(value));
+  }
+
+  /**
+   * Replaces the range with an exact one. Each bound is only narrowed on its own, so concurrent readers never see a
+   * range that misses values, as long as the given range covers the column and there are no concurrent writers.
+   * @param min the smallest value of the column
+   * @param max the largest value of the column, smaller than min if the column only has NULLs
+   */
+  void Reset(int64_t min, int64_t max) {
+    min_.store(~Encode(min));
+    max_.store(Encode(max));
+  }
+
+ private:
+  // Flipping the sign bit maps signed integers to unsigned ones of the same order, with INT64_MIN mapped to 0
+  static uint64_t Encode(int64_t value) { return static_cast<uint64_t>(value) ^ (uint64_t{1} << 63); }
+  static int64_t Decode(uint64_t value) { return static_cast<int64_t>(value ^ (uint64_t{1} << 63)); }
+
+  static void FetchMax(std::atomic<uint64_t> *bound, uint64_t value) {
+    uint64_t current = bound->load();
+    while (current < value && !bound->compare_exchange_weak(current, value)) {
+    }
+  }
+
+  std::atomic<uint64_t> min_;  // bitwise negation of the encoded minimum, so that 0 stands for INT64_MAX
+  std::atomic<uint64_t> max_;  // encoded maximum, so that 0 stands for INT64_MIN
 };
 
 /**
@@ -217,7 +498,7 @@ class ArrowBlockMetadata {
    */
   static uint32_t Size(uint16_t num_cols) {
     return StorageUtil::PadUpToSize(sizeof(uint64_t), static_cast<uint32_t>(sizeof(uint32_t)) * (num_cols + 1)) +
-           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo));
+           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo) + sizeof(ColumnZoneMap));
   }
 
   /**
@@ -274,9 +555,30 @@ class ArrowBlockMetadata {
     return reinterpret_cast<ArrowColumnInfo *>(null_count_end)[!col_id];
   }
 
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest
+   * @return zone map of the given column, which is only maintained for fixed-length columns
+   */
+  ColumnZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) {
+    auto *column_info_end = &GetColumnInfo(layout, col_id_t(0)) + layout.NumColumns();
+    return reinterpret_cast<ColumnZoneMap *>(column_info_end)[!col_id];
+  }
+
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest
+   * @return zone map of the given column, which is only maintained for fixed-length columns
+   */
+  const ColumnZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) const {
+    const auto *column_info_end = &GetColumnInfo(layout, col_id_t(0)) + layout.NumColumns();
+    return reinterpret_cast<const ColumnZoneMap *>(column_info_end)[!col_id];
+  }
+
  private:
   uint32_t num_records_;  // number of actual records
   // null_count[num_cols] (32-bit) | padding up to 8 byte-aligned | arrow_varlen_buffers[num_cols] |
+  // zone_maps[num_cols] |
   byte varlen_content_[];
 };
 }  // namespace terrier::storage
@@ -116,6 +116,11 @@ class BlockAccessController {
    */
   std::atomic<BlockState> *GetBlockState() { return reinterpret_cast<std::atomic<BlockState> *>(bytes_); }
 
+  /**
+   * @return number of in-place readers currently holding a read lock on the block
+   */
+  uint32_t NumInPlaceReaders() { return GetReaderCount()->load(); }
+
  private:
   friend class BlockCompactor;
   // we are breaking this down to two fields, (| BlockState (32-bits) | Reader Count (32-bits) |)
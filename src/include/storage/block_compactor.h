@@ -81,6 +81,12 @@ class BlockCompactor {
   void BuildDictionary(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata, col_id_t col_id,
                        common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col, VarlenEntry *values);
 
+  void RunLengthEncode(ArrowBlockMetadata *metadata, common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col,
+                       const byte *values, uint16_t attr_size);
+
+  void BitPack(ArrowBlockMetadata *metadata, common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col,
+               const byte *values, uint16_t attr_size);
+
   void ComputeFilled(const BlockLayout &layout, std::vector<uint32_t> *filled, const std::vector<uint32_t> &empty) {
     // Reconstruct the list of filled slots
     // Since the list of empty slots is sorted, we can use a counter j to keep track of the next empty slot that
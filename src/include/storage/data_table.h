@@ -157,6 +157,72 @@ class DataTable {
   void Scan(common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *start_pos,
             ProjectedColumns *out_buffer) const;
 
+  /**
+   * Same as Scan, but additionally stops once the given iterator reaches end_pos (exclusive). This allows several
+   * threads to scan disjoint ranges of blocks of the same table concurrently.
+   *
+   * @param txn the calling transaction
+   * @param start_pos iterator to the starting location for the sequential scan
+   * @param end_pos iterator one past the last location to scan
+   * @param out_buffer output buffer. The object should already contain projection list information. This buffer is
+   *                   always cleared of old values.
+   */
+  void RangeScan(common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *start_pos,
+                 const SlotIterator &end_pos, ProjectedColumns *out_buffer) const;
+
+  /**
+   * Copies the tuples of a frozen block into the given buffer without looking at any versions, decoding compressed
+   * columns on the way. Dictionary-compressed varlen columns point into the dictionary, and the offset of every tuple
+   * slot written to the buffer is the index of the tuple in the block. The caller must hold an in-place read lock on
+   * the block for as long as it reads the buffer. The given iterator is mutated to point to one slot past the last
+   * tuple scanned, or to the next block if the frozen block was read to the end.
+   *
+   * @param start_pos iterator into a frozen block to start the scan at
+   * @param out_buffer output buffer. The object should already contain projection list information. This buffer is
+   *                   always cleared of old values.
+   */
+  void ScanInPlace(SlotIterator *start_pos, ProjectedColumns *out_buffer) const;
+
+  /**
+   * Moves the given iterator to the first slot of the next block, or to end() if there is none.
+   * @param start_pos iterator into a block of this data table
+   */
+  void SkipBlock(SlotIterator *start_pos) const;
+
+  /**
+   * @param block a block of this data table
+   * @return the Arrow metadata of the block, which describes its content once the block is frozen and holds the zone
+   *         maps of its columns
+   */
+  const ArrowBlockMetadata &GetArrowBlockMetadata(RawBlock *block) const {
+    return accessor_.GetArrowBlockMetadata(block);
+  }
+
+  /**
+   * @return the number of blocks currently allocated to the data table
+   */
+  uint32_t GetNumBlocks() const {
+    common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+    return static_cast<uint32_t>(blocks_.size());
+  }
+
+  /**
+   * @return the NUMA node of every block currently allocated to the data table, in order
+   */
+  std::vector<uint16_t> GetBlockNumaNodes() const {
+    common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+    std::vector<uint16_t> numa_nodes;
+    numa_nodes.reserve(blocks_.size());
+    for (const RawBlock *block : blocks_) numa_nodes.push_back(block->numa_node_);
+    return numa_nodes;
+  }
+
+  /**
+   * @param block_idx index of the block in the table's list of blocks
+   * @return an iterator to the first tuple slot of the given block, or end() if the index is out of bounds
+   */
+  SlotIterator GetBlockIterator(uint32_t block_idx) const;
+
   /**
    * @return the first tuple slot contained in the data table
    */
@@ -200,6 +266,17 @@ class DataTable {
    */
   TupleSlot Insert(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo);
 
+  /**
+   * Inserts a batch of tuples into a fresh block, filling it one column at a time. All of the new tuples share a
+   * single bulk insert UndoRecord instead of one record each. Several threads may call this concurrently on behalf of
+   * the same transaction, as long as that transaction makes no other writes in the meantime.
+   *
+   * @param txn the calling transaction
+   * @param tuples the tuples to insert, at most as many as fit in a block. Should not reference col_id 0
+   * @return the TupleSlot of the first tuple. The i-th tuple is stored at offset i of the same block.
+   */
+  TupleSlot InsertBlock(common::ManagedPointer<transaction::TransactionContext> txn, ProjectedColumns *tuples);
+
   /**
    * Deletes the given TupleSlot, this will call StageDelete on the provided txn to generate the RedoRecord for delete.
    * The rest of the behavior follows Update's behavior.
@@ -290,11 +367,23 @@ class DataTable {
 
   // Compares and swaps the version pointer to be the undo record, only if its value is equal to the expected one.
   bool CompareAndSwapVersionPtr(TupleSlot slot, const TupleAccessStrategy &accessor, UndoRecord *expected,
-                                UndoRecord *desired);
+                                UndoRecord *desired) const;
+
+  // The most records a writer looks at below its new version for one that is older than every running txn. Beyond
+  // that, the chain is left to the GC, so that writes do not slow down with the length of the chain.
+  static constexpr uint32_t MAX_WRITE_PRUNE_HOPS = 4;
+
+  // Unlinks the records after start that are older than the oldest running txn, and thus invisible to everyone, if it
+  // finds the first such record within max_hops records after start. The records are still freed by the GC, which
+  // waits for txns that could be traversing them.
+  static void PruneVersionChain(UndoRecord *start, transaction::timestamp_t oldest_active_time, uint32_t max_hops);
 
   // Allocates a new block to be used as insertion head.
   RawBlock *NewBlock();
 
+  // Widens the zone map of the column to cover the value (nullptr for NULL). Must happen before the value is written.
+  void WidenZoneMap(RawBlock *block, col_id_t col_id, const byte *value) const;
+
   /**
    * Determine if a Tuple is visible (present and not deleted) to the given transaction. It's effectively Select's logic
    * (follow a version chain if present) without the materialization. If the logic of Select changes, this should change
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <queue>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
+#include "common/worker_pool.h"
 #include "storage/access_observer.h"
 #include "storage/index/index.h"
 #include "transaction/transaction_context.h"
@@ -18,6 +23,9 @@ namespace terrier::storage {
  * Based on the contents of this queue, it unlinks the UndoRecords from their version chains when no running
  * transactions can view those versions anymore. It then stores those transactions to attempt to deallocate on the next
  * iteration if no running transactions can still hold references to them.
+ *
+ * The work of every invocation can be spread over a pool of threads. Version chains are partitioned by block, so that
+ * every chain is only ever truncated by one thread, and the other steps are partitioned by transaction.
  */
 class GarbageCollector {
  public:
@@ -31,19 +39,26 @@ class GarbageCollector {
    *                 it is not null. The observer can then gain insight invoke other components to perform actions.
    *                 The observer's function implementation needs to be lightweight because it is called on the GC
    *                 thread.
+   * @param num_threads number of threads that share the work of every invocation
    */
   // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
   //  eliminate this perceived redundancy of taking in a transaction manager.
   GarbageCollector(const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
                    const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-                   const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer)
+                   const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+                   const uint32_t num_threads = 1)
       : timestamp_manager_(timestamp_manager),
         deferred_action_manager_(deferred_action_manager),
         txn_manager_(txn_manager),
         observer_(observer),
-        last_unlinked_{0} {
+        last_unlinked_{0},
+        num_threads_(std::max(num_threads, 1u)) {
     TERRIER_ASSERT(txn_manager_->GCEnabled(),
                    "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+    if (num_threads_ > 1) {
+      workers_ = std::make_unique<common::WorkerPool>(num_threads_, common::TaskQueue());
+      workers_->Startup();
+    }
   }
 
   ~GarbageCollector() {
@@ -100,6 +115,12 @@ class GarbageCollector {
 
   void ProcessIndexes();
 
+  // Run the task once for every thread of the GC, with the index of the thread, and wait for all of them
+  void RunOnAllThreads(const std::function<void(uint32_t)> &task);
+
+  // Index of the thread that truncates the version chains of the block
+  uint32_t ThreadOf(const RawBlock *block) const;
+
   const common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
   const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager_;
   const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
@@ -113,6 +134,10 @@ class GarbageCollector {
 
   std::unordered_set<common::ManagedPointer<index::Index>> indexes_;
   common::SharedLatch indexes_latch_;
+
+  // Threads that share the work of every invocation. There is no pool with a single thread, which does the work itself.
+  const uint32_t num_threads_;
+  std::unique_ptr<common::WorkerPool> workers_;
 };
 
 }  // namespace terrier::storage
@@ -325,12 +325,12 @@ class LogManager;  // forward declaration
 class RedoBuffer {
  public:
   /**
-   * Initializes a new RedoBuffer, working with the given LogManager
+   * Initializes a new RedoBuffer, working with the given LogManager. All of its records go to the log stream of the
+   * calling thread.
    * @param log_manager the log manager this redo buffer talks to, or nullptr if logging is disabled
    * @param buffer_pool The buffer pool to draw buffer segments from. Must be the same buffer pool the log manager uses.
    */
-  RedoBuffer(LogManager *log_manager, RecordBufferSegmentPool *buffer_pool)
-      : has_flushed_(false), log_manager_(log_manager), buffer_pool_(buffer_pool) {}
+  RedoBuffer(LogManager *log_manager, RecordBufferSegmentPool *buffer_pool);
 
   /**
    * Reserve a redo record with the given size, in bytes. The returned pointer is guaranteed to be valid until NewEntry
@@ -371,6 +371,8 @@ class RedoBuffer {
   // changes from aborted txns
   bool has_flushed_;
   LogManager *const log_manager_;
+  // Log stream the records go to, so that they are serialized in order
+  const uint32_t log_stream_;
   RecordBufferSegmentPool *const buffer_pool_;
   RecordBufferSegment *buffer_seg_ = nullptr;
   // reserved for aborts where we will potentially need to garbage collect the last operation (which caused the abort)
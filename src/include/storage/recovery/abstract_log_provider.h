@@ -16,13 +16,15 @@ namespace terrier::storage {
  */
 class AbstractLogProvider {
  public:
+  virtual ~AbstractLogProvider() = default;
+
   /**
    * Provide next available log record
    * @warning Can be a blocking call if provider is waiting to receive more logs
    * @return next log record along with vector of varlen entry pointers. nullptr log record if no more logs will be
    * provided.
    */
-  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
+  virtual std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
     return HasMoreRecords() ? ReadNextRecord() : std::make_pair(nullptr, std::vector<byte *>());
   }
 
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "storage/recovery/abstract_log_provider.h"
+
+namespace terrier::storage {
+
+/**
+ * @brief Log provider that merges the log streams of a LogManager
+ * Every stream holds the logs of the transactions logged to it in order, but the streams interleave arbitrarily. This
+ * provider reads every stream up to its next commit record, and provides the stream whose pending commit is the oldest
+ * first, so that the recovery manager sees the commits in timestamp order across streams.
+ */
+class MergedLogProvider : public AbstractLogProvider {
+ public:
+  /**
+   * @param sources providers of the log streams, one per stream
+   */
+  explicit MergedLogProvider(std::vector<std::unique_ptr<AbstractLogProvider>> sources);
+
+  /**
+   * Provide next available log record of the stream with the oldest pending commit
+   * @return next log record along with vector of varlen entry pointers. nullptr log record if no more logs will be
+   * provided.
+   */
+  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() override;
+
+ private:
+  // A log stream, along with its records read up to and including its next commit record
+  struct Source {
+    std::unique_ptr<AbstractLogProvider> provider_;
+    std::deque<std::pair<LogRecord *, std::vector<byte *>>> records_;
+    // Whether the last record in records_ is a commit record
+    bool has_commit_ = false;
+    bool exhausted_ = false;
+  };
+
+  std::vector<Source> sources_;
+
+  /**
+   * Reads records from the source until its next commit record, or until it runs out of records
+   * @param source source to fill
+   */
+  static void Fill(Source *source);
+
+  /**
+   * @return true if any stream has more records to provide. false otherwise
+   */
+  bool HasMoreRecords() override;
+
+  /**
+   * Records are read from the streams by their own providers, so this is never called
+   * @return false
+   */
+  bool Read(void *dest, uint32_t size) override { return false; }
+};
+
+}  // namespace terrier::storage
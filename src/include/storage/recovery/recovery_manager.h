@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -15,6 +18,7 @@
 #include "catalog/postgres/pg_index.h"
 #include "catalog/postgres/pg_namespace.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/worker_pool.h"
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/sql_table.h"
 #include "transaction/transaction_manager.h"
@@ -28,6 +32,10 @@ namespace terrier::storage {
 /**
  * Recovery Manager
  * TODO(Gus): Add more documentation when API is finalized
+ *
+ * Changes to user tables can be replayed by a pool of threads. Every table is replayed by one thread, so that the
+ * changes to a table are still replayed in commit order. Transactions that change the catalog are replayed by the
+ * recovery task alone, once every transaction before them has been replayed.
  */
 class RecoveryManager : public common::DedicatedThreadOwner {
   /**
@@ -63,20 +71,26 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param deferred_action_manager manager to use for deferred deletes
    * @param thread_registry thread registry to register tasks
    * @param store block store used for SQLTable creation during recovery
+   * @param num_threads number of threads that replay changes to user tables
    */
   explicit RecoveryManager(const common::ManagedPointer<AbstractLogProvider> log_provider,
                            const common::ManagedPointer<catalog::Catalog> catalog,
                            const common::ManagedPointer<transaction::TransactionManager> txn_manager,
                            const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                            const common::ManagedPointer<terrier::common::DedicatedThreadRegistry> thread_registry,
-                           const common::ManagedPointer<BlockStore> store)
+                           const common::ManagedPointer<BlockStore> store, const uint32_t num_threads = 1)
       : DedicatedThreadOwner(thread_registry),
         log_provider_(log_provider),
         catalog_(catalog),
         txn_manager_(txn_manager),
         deferred_action_manager_(deferred_action_manager),
         block_store_(store),
-        recovered_txns_(0) {
+        recovered_txns_(0),
+        num_threads_(std::max(num_threads, 1u)) {
+    if (num_threads_ > 1) {
+      workers_ = std::make_unique<common::WorkerPool>(num_threads_, common::TaskQueue());
+      workers_->Startup();
+    }
     // Initialize catalog_table_schemas_ map
     catalog_table_schemas_[catalog::postgres::CLASS_TABLE_OID] = catalog::postgres::Builder::GetClassTableSchema();
     catalog_table_schemas_[catalog::postgres::NAMESPACE_TABLE_OID] =
@@ -129,7 +143,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // tables during recovery
   const common::ManagedPointer<BlockStore> block_store_;
 
-  // Used during recovery from log. Maps old tuple slot to new tuple slot
+  // Used during recovery from log. Maps old tuple slot to new tuple slot. Holds the slots of catalog tables until
+  // recovery finishes, when the slots of user tables are merged in.
   // TODO(Gus): This map may get huge, benchmark whether this becomes a problem and if we need a more sophisticated data
   // structure
   std::unordered_map<TupleSlot, TupleSlot> tuple_slot_map_;
@@ -155,6 +170,23 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // Number of recovered committed txns. Used for benchmarking
   uint32_t recovered_txns_;
 
+  // Number of committed txns that only change user tables to replay at once
+  static constexpr uint32_t REPLAY_BATCH_SIZE = 1000;
+
+  // Threads that replay changes to user tables. There is no pool with a single thread, and the recovery task replays
+  // the changes itself.
+  const uint32_t num_threads_;
+  std::unique_ptr<common::WorkerPool> workers_;
+
+  // Used during recovery from log. Maps old tuple slot to new tuple slot for every user table, keyed by TableKey()
+  std::unordered_map<uint64_t, std::unordered_map<TupleSlot, TupleSlot>> table_tuple_slot_maps_;
+
+  // Committed txns that only change user tables, waiting to be replayed. The records of every txn, in commit order.
+  std::vector<std::vector<LogRecord *>> replay_batch_;
+  // The records of the txns waiting to be replayed, deleted once they are
+  std::vector<std::pair<LogRecord *, std::vector<byte *>>> replay_batch_records_;
+  uint32_t replay_batch_size_ = 0;
+
   /**
    * Recovers the databases using the provided log provider
    * @return number of committed transactions replayed
@@ -169,10 +201,73 @@ class RecoveryManager : public common::DedicatedThreadOwner {
 
   /**
    * @brief Replay a committed transaction corresponding to txn_id.
+   * If the transaction only changes user tables, it is added to the replay batch instead.
    * @param txn_id start timestamp for committed transaction
    */
   void ProcessCommittedTransaction(transaction::timestamp_t txn_id);
 
+  /**
+   * Replays the batched transactions. Transactions that change a common table, directly or through other transactions,
+   * are replayed by the same thread in commit order, and every transaction is replayed and committed as a whole.
+   */
+  void ReplayBatch();
+
+  /**
+   * Runs the task once for every replay thread, with the index of the thread, and waits for all of them
+   * @param task task to run
+   */
+  void RunOnAllThreads(const std::function<void(uint32_t)> &task);
+
+  /**
+   * @param db_oid database oid of a table
+   * @param table_oid oid of a table
+   * @return key identifying the table across databases
+   */
+  static uint64_t TableKey(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid) {
+    return (static_cast<uint64_t>(!db_oid) << 32) | !table_oid;
+  }
+
+  /**
+   * @param table_oid oid of a table
+   * @return true if the table is a catalog table
+   */
+  static bool IsCatalogTable(const catalog::table_oid_t table_oid) {
+    return !table_oid < catalog::START_OID;  // All catalog tables/indexes have OIDS less than START_OID
+  }
+
+  /**
+   * @param record redo or delete record
+   * @return oid of the table the record changes
+   */
+  static catalog::table_oid_t TableOidOf(const LogRecord *record) {
+    return record->RecordType() == LogRecordType::REDO
+               ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+               : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+  }
+
+  /**
+   * @param record redo or delete record
+   * @return oid of the database of the table the record changes
+   */
+  static catalog::db_oid_t DatabaseOidOf(const LogRecord *record) {
+    return record->RecordType() == LogRecordType::REDO
+               ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetDatabaseOid()
+               : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetDatabaseOid();
+  }
+
+  /**
+   * @param db_oid database oid of a table
+   * @param table_oid oid of a table
+   * @return map of old tuple slot to new tuple slot holding the slots of the table
+   */
+  std::unordered_map<TupleSlot, TupleSlot> &TupleSlotMap(const catalog::db_oid_t db_oid,
+                                                          const catalog::table_oid_t table_oid) {
+    if (IsCatalogTable(table_oid)) return tuple_slot_map_;
+    // Replay threads only ever find the map: ReplayBatch() creates the maps of all tables in the batch beforehand
+    const auto it = table_tuple_slot_maps_.find(TableKey(db_oid, table_oid));
+    return it != table_tuple_slot_maps_.end() ? it->second : table_tuple_slot_maps_[TableKey(db_oid, table_oid)];
+  }
+
   /**
    * Defers log records deletes with the transaction manager
    * @param txn_id txn_id for txn who's records to delete
@@ -189,7 +284,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   uint32_t ProcessDeferredTransactions(transaction::timestamp_t upper_bound);
 
   /**
-   * Handles mapping of old tuple slot (before recovery) to new tuple slot (after recovery)
+   * Handles mapping of old tuple slot (before recovery) to new tuple slot (after recovery) for catalog tables
    * @param slot old tuple slot
    * @return new tuple slot
    */
@@ -202,12 +297,14 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * Wrapper over GetDatabaseCatalog method that asserts the database exists
    * @param txn txn for catalog lookup
    * @param database oid for database we want
+   * @param lock whether to take the DDL lock of the database. Txns that replay user tables concurrently do not.
    * @return pointer to database catalog
    */
   common::ManagedPointer<catalog::DatabaseCatalog> GetDatabaseCatalog(transaction::TransactionContext *txn,
-                                                                      catalog::db_oid_t db_oid) {
+                                                                      catalog::db_oid_t db_oid, bool lock = true) {
     auto db_catalog_ptr = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
     TERRIER_ASSERT(db_catalog_ptr != nullptr, "No catalog for given database oid");
+    if (!lock) return db_catalog_ptr;
     auto result UNUSED_ATTRIBUTE = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
     TERRIER_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
     return db_catalog_ptr;
@@ -279,8 +376,9 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param record record we want to determine redo type of
    * @return true if record is an insert redo, false if it is an update redo
    */
-  bool IsInsertRecord(const RedoRecord *record) const {
-    return tuple_slot_map_.find(record->GetTupleSlot()) == tuple_slot_map_.end();
+  bool IsInsertRecord(const RedoRecord *record) {
+    const auto &tuple_slot_map = TupleSlotMap(record->GetDatabaseOid(), record->GetTableOid());
+    return tuple_slot_map.find(record->GetTupleSlot()) == tuple_slot_map.end();
   }
 
   /**
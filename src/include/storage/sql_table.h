@@ -110,6 +110,19 @@ class SqlTable {
     return slot;
   }
 
+  /**
+   * Inserts a batch of tuples into a fresh block under a single bulk insert UndoRecord. Unlike Insert, nothing is
+   * staged in the redo buffer; the caller must log the new tuples itself.
+   *
+   * @param txn the calling transaction
+   * @param tuples the tuples to insert, at most as many as fit in a block
+   * @return TupleSlot of the first tuple. The i-th tuple is stored at offset i of the same block.
+   */
+  TupleSlot InsertBlock(const common::ManagedPointer<transaction::TransactionContext> txn,
+                        ProjectedColumns *const tuples) const {
+    return table_.data_table_->InsertBlock(txn, tuples);
+  }
+
   /**
    * Deletes the given TupleSlot. StageDelete must have been called as well in order for the operation to be logged.
    * @param txn the calling transaction
@@ -151,6 +164,77 @@ class SqlTable {
     return table_.data_table_->Scan(txn, start_pos, out_buffer);
   }
 
+  /**
+   * Sequentially scans the table between the two given iterators. See DataTable::RangeScan.
+   * @param txn the calling transaction
+   * @param start_pos iterator to the starting location for the sequential scan
+   * @param end_pos iterator one past the last location to scan
+   * @param out_buffer output buffer. The object should already contain projection list information. This buffer is
+   *                   always cleared of old values.
+   */
+  void RangeScan(const common::ManagedPointer<transaction::TransactionContext> txn,
+                 DataTable::SlotIterator *const start_pos, const DataTable::SlotIterator &end_pos,
+                 ProjectedColumns *const out_buffer) const {
+    return table_.data_table_->RangeScan(txn, start_pos, end_pos, out_buffer);
+  }
+
+  /**
+   * Copies the tuples of a frozen block into the given buffer. See DataTable::ScanInPlace.
+   * @param start_pos iterator into a frozen block to start the scan at
+   * @param out_buffer output buffer. The object should already contain projection list information. This buffer is
+   *                   always cleared of old values.
+   */
+  void ScanInPlace(DataTable::SlotIterator *const start_pos, ProjectedColumns *const out_buffer) const {
+    table_.data_table_->ScanInPlace(start_pos, out_buffer);
+  }
+
+  /**
+   * @param block a block of the underlying DataTable
+   * @param col_id id of a column, as found in the projection list of a ProjectedColumns
+   * @return the Arrow storage of the column in the block, which describes its content once the block is frozen
+   */
+  const ArrowColumnInfo &GetArrowColumnInfo(RawBlock *const block, const col_id_t col_id) const {
+    return table_.data_table_->GetArrowBlockMetadata(block).GetColumnInfo(table_.layout_, col_id);
+  }
+
+  /**
+   * Moves the given iterator to the first slot of the next block. See DataTable::SkipBlock.
+   * @param start_pos iterator into a block of the underlying DataTable
+   */
+  void SkipBlock(DataTable::SlotIterator *const start_pos) const { table_.data_table_->SkipBlock(start_pos); }
+
+  /**
+   * @param block a block of the underlying DataTable
+   * @param col_id id of a column, as found in the projection list of a ProjectedColumns
+   * @return the zone map of the column in the block
+   */
+  const ColumnZoneMap &GetZoneMap(RawBlock *const block, const col_id_t col_id) const {
+    return table_.data_table_->GetArrowBlockMetadata(block).GetZoneMap(table_.layout_, col_id);
+  }
+
+  /**
+   * @return the number of blocks in the underlying DataTable
+   */
+  uint32_t GetNumBlocks() const { return table_.data_table_->GetNumBlocks(); }
+
+  /**
+   * @return the NUMA node of every block in the underlying DataTable, in order
+   */
+  std::vector<uint16_t> GetBlockNumaNodes() const { return table_.data_table_->GetBlockNumaNodes(); }
+
+  /**
+   * @return the number of tuples that fit in one block of the underlying DataTable
+   */
+  uint32_t GetNumSlotsPerBlock() const { return table_.layout_.NumSlots(); }
+
+  /**
+   * @param block_idx index of the block in the underlying DataTable
+   * @return an iterator to the first tuple slot of the given block, or end() if the index is out of bounds
+   */
+  DataTable::SlotIterator GetBlockIterator(uint32_t block_idx) const {
+    return table_.data_table_->GetBlockIterator(block_idx);
+  }
+
   /**
    * @return the first tuple slot contained in the underlying DataTable
    */
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
 #include <functional>
 #include <ostream>
 #include <string>
@@ -56,10 +58,11 @@ class alignas(common::Constants::BLOCK_SIZE) RawBlock {
   DataTable *data_table_;
 
   /**
-   * Padding for flags or whatever we may want in the future. Determined by size of layout_version below. See
-   * tuple_access_strategy.h for more details on Block header layout.
+   * NUMA node the block's memory is placed on, or BlockAllocator::UNKNOWN_NUMA_NODE. Set by the allocator and kept
+   * across reuse. Its size is determined by size of layout_version below. See tuple_access_strategy.h for more details
+   * on Block header layout.
    */
-  uint16_t padding_;
+  uint16_t numa_node_;
 
   /**
    * Layout version.
@@ -164,16 +167,46 @@ class TupleSlot {
   uintptr_t bytes_;
 };
 
+/**
+ * How the block allocator places blocks on NUMA nodes
+ */
+enum class NumaPolicy : uint8_t {
+  NONE,        // the kernel places pages where they are first touched
+  INTERLEAVE,  // huge pages of blocks are bound to the allowed nodes in turn
+  LOCAL        // huge pages of blocks are bound to the node of the allocating thread
+};
+
 /**
  * Allocator that allocates a block
+ *
+ * By default, blocks come from the plain allocator. Otherwise, blocks are carved out of huge-page-sized chunks mapped
+ * straight from the kernel, which are backed by explicit huge pages if any are reserved, or else by transparent ones,
+ * and placed on NUMA nodes according to the policy. Not thread-safe, the block store latches around it.
  */
 class BlockAllocator {
  public:
+  /**
+   * Node of blocks whose placement is not known
+   */
+  static constexpr uint16_t UNKNOWN_NUMA_NODE = UINT16_MAX;
+
+  /**
+   * Creates an allocator that allocates blocks from the plain allocator
+   */
+  BlockAllocator() = default;
+
+  /**
+   * Creates an allocator that maps blocks from the kernel
+   * @param huge_pages whether blocks are backed by huge pages
+   * @param numa_policy how blocks are placed on NUMA nodes
+   */
+  BlockAllocator(bool huge_pages, NumaPolicy numa_policy);
+
   /**
    * Allocates a new object by calling its constructor.
-   * @return a pointer to the allocated object.
+   * @return a pointer to the allocated object, or nullptr if out of memory.
    */
-  RawBlock *New() { return new RawBlock(); }
+  RawBlock *New();
 
   /**
    * Reuse a reused chunk of memory to be handed out again
@@ -186,7 +219,30 @@ class BlockAllocator {
    * Deletes the object by calling its destructor.
    * @param ptr a pointer to the object to be deleted.
    */
-  void Delete(RawBlock *const ptr) { delete ptr; }
+  void Delete(RawBlock *ptr);
+
+  /**
+   * @return the NUMA node the calling thread runs on, or UNKNOWN_NUMA_NODE
+   */
+  static uint16_t CurrentNumaNode();
+
+ private:
+  // Maps a new chunk placed on the given node, or returns nullptr if out of memory
+  byte *MapChunk(uint16_t numa_node);
+
+  // Node to place the next chunk on
+  uint16_t NextNumaNode();
+
+  bool mapped_ = false;
+  bool huge_pages_ = false;
+  NumaPolicy numa_policy_ = NumaPolicy::NONE;
+  // Nodes the process may allocate memory on
+  std::vector<uint16_t> numa_nodes_;
+  uint32_t next_numa_node_ = 0;
+  // Unused blocks of mapped chunks
+  std::vector<RawBlock *> spare_blocks_;
+  // Number of blocks handed out of every mapped chunk
+  std::unordered_map<uintptr_t, uint32_t> live_blocks_;
 };
 
 /**
@@ -207,7 +263,7 @@ using ProjectionMap = std::unordered_map<catalog::col_oid_t, uint16_t>;
 /**
  * Denote whether a record modifies the logical delete column, used when DataTable inspects deltas
  */
-enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE };
+enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE, BULK_INSERT };
 
 /**
  * Types of LogRecords
@@ -225,6 +281,34 @@ using CommitCallback = std::pair<transaction::callback_fn, void *>;
  */
 using SerializedLogs = std::pair<BufferedLogWriter *, std::vector<CommitCallback>>;
 
+/**
+ * Progress of a log stream, counted in the RecordBufferSegments handed to the stream. The tasks of every stream can see
+ * the progress of every other stream, since a commit is only reported once all buffers handed to any stream before it
+ * are persisted.
+ */
+struct LogStreamProgress {
+  /**
+   * Number of buffers handed to the serializer task of the stream
+   */
+  std::atomic<uint64_t> added_{0};
+  /**
+   * Number of buffers the serializer task has serialized and handed over to the disk log consumer task
+   */
+  std::atomic<uint64_t> serialized_{0};
+  /**
+   * Number of buffers the disk log consumer task has persisted
+   */
+  std::atomic<uint64_t> persisted_{0};
+  /**
+   * Number of buffers that commits logged to other streams wait on the disk log consumer task of the stream to persist
+   */
+  std::atomic<uint64_t> requested_{0};
+  /**
+   * Condition variable to wake up the disk log consumer task of the stream
+   */
+  std::condition_variable disk_log_writer_thread_cv_;
+};
+
 /**
  * A varlen entry is always a 32-bit size field and the varlen content,
  * with exactly size many bytes (no extra nul in the end).
@@ -162,6 +162,52 @@ class StorageUtil {
    */
   static std::vector<storage::col_id_t> ProjectionListAllColumns(const storage::BlockLayout &layout);
 
+  /**
+   * Reads a fixed-length integer attribute
+   * @param pos location of the attribute
+   * @param attr_size size of the attribute, in bytes
+   * @return the value of the attribute, sign-extended to 64 bits
+   */
+  static int64_t ReadInteger(const byte *pos, uint16_t attr_size) {
+    switch (attr_size) {
+      case sizeof(int8_t):
+        return *reinterpret_cast<const int8_t *>(pos);
+      case sizeof(int16_t):
+        return *reinterpret_cast<const int16_t *>(pos);
+      case sizeof(int32_t):
+        return *reinterpret_cast<const int32_t *>(pos);
+      case sizeof(int64_t):
+        return *reinterpret_cast<const int64_t *>(pos);
+      default:
+        throw std::runtime_error("unexpected attribute size");
+    }
+  }
+
+  /**
+   * Writes a fixed-length integer attribute, truncating the value to the size of the attribute
+   * @param value the value to write
+   * @param pos location of the attribute
+   * @param attr_size size of the attribute, in bytes
+   */
+  static void WriteInteger(int64_t value, byte *pos, uint16_t attr_size) {
+    switch (attr_size) {
+      case sizeof(int8_t):
+        *reinterpret_cast<int8_t *>(pos) = static_cast<int8_t>(value);
+        break;
+      case sizeof(int16_t):
+        *reinterpret_cast<int16_t *>(pos) = static_cast<int16_t>(value);
+        break;
+      case sizeof(int32_t):
+        *reinterpret_cast<int32_t *>(pos) = static_cast<int32_t>(value);
+        break;
+      case sizeof(int64_t):
+        *reinterpret_cast<int64_t *>(pos) = value;
+        break;
+      default:
+        throw std::runtime_error("unexpected attribute size");
+    }
+  }
+
   /**
    * Deallocates the value buffers along varlen columns within a block
    * @param block the block to clean up
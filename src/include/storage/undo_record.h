@@ -73,7 +73,31 @@ class UndoRecord {
    * @return size of this UndoRecord in memory, in bytes.
    */
   uint32_t Size() const {
-    return static_cast<uint32_t>(sizeof(UndoRecord) + (type_ == DeltaRecordType::UPDATE ? Delta()->Size() : 0));
+    switch (type_) {
+      case DeltaRecordType::UPDATE:
+        return static_cast<uint32_t>(sizeof(UndoRecord) + Delta()->Size());
+      case DeltaRecordType::BULK_INSERT:
+        return static_cast<uint32_t>(sizeof(UndoRecord) + sizeof(uint64_t));
+      default:
+        return static_cast<uint32_t>(sizeof(UndoRecord));
+    }
+  }
+
+  /**
+   * @return number of consecutive tuple slots, starting at Slot(), that this UndoRecord covers. This is only ever more
+   * than one for bulk inserts.
+   */
+  uint32_t NumSlots() const {
+    return type_ == DeltaRecordType::BULK_INSERT ? static_cast<uint32_t>(varlen_contents_[0]) : 1;
+  }
+
+  /**
+   * @param i index of the slot within this UndoRecord, less than NumSlots()
+   * @return the i-th tuple slot this UndoRecord covers
+   */
+  TupleSlot Slot(const uint32_t i) const {
+    TERRIER_ASSERT(i < NumSlots(), "Slot index out of bounds");
+    return TupleSlot(slot_.GetBlock(), slot_.GetOffset() + i);
   }
 
   /**
@@ -112,6 +136,34 @@ class UndoRecord {
     return result;
   }
 
+  /**
+   * Populates the UndoRecord to hold an insert of a run of consecutive tuple slots in the same block. The version
+   * pointer of every one of those slots points to this single record.
+   *
+   * @param head pointer to the byte buffer to initialize as a UndoRecord, of size BulkInsertSize()
+   * @param timestamp timestamp of the transaction that generated this UndoRecord
+   * @param slot the first TupleSlot this UndoRecord points to
+   * @param table the DataTable this UndoRecord points to
+   * @param num_slots number of consecutive slots inserted, starting at slot
+   * @return pointer to the initialized UndoRecord
+   */
+  static UndoRecord *InitializeBulkInsert(byte *const head, const transaction::timestamp_t timestamp,
+                                          const TupleSlot slot, DataTable *const table, const uint32_t num_slots) {
+    auto *result = reinterpret_cast<UndoRecord *>(head);
+    result->type_ = DeltaRecordType::BULK_INSERT;
+    result->next_ = nullptr;
+    result->timestamp_.store(timestamp);
+    result->table_ = table;
+    result->slot_ = slot;
+    result->varlen_contents_[0] = num_slots;
+    return result;
+  }
+
+  /**
+   * @return size of an UndoRecord holding a bulk insert, in bytes
+   */
+  static constexpr uint32_t BulkInsertSize() { return static_cast<uint32_t>(sizeof(UndoRecord) + sizeof(uint64_t)); }
+
   /**
    * Populates the UndoRecord to hold a delete.
    *
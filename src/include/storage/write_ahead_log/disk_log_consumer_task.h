@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <utility>
 #include <vector>
 #include "common/container/concurrent_blocking_queue.h"
@@ -11,8 +12,8 @@
 namespace terrier::storage {
 
 /**
- * A DiskLogConsumerTask is responsible for writing serialized log records out to disk by processing buffers in the log
- * manager's filled buffer queue
+ * A DiskLogConsumerTask is responsible for writing serialized log records out to disk by processing buffers in the
+ * filled buffer queue of a log stream
  */
 class DiskLogConsumerTask : public common::DedicatedThreadTask {
  public:
@@ -23,18 +24,24 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    * @param buffers pointer to list of all buffers used by log manager, used to persist log file
    * @param empty_buffer_queue pointer to queue to push empty buffers to
    * @param filled_buffer_queue pointer to queue to pop filled buffers from
+   * @param stream the log stream this task writes out
+   * @param streams_progress pointer to the progress of every log stream
    */
   explicit DiskLogConsumerTask(const std::chrono::milliseconds persist_interval, uint64_t persist_threshold,
                                std::vector<BufferedLogWriter> *buffers,
                                common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue)
+                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
+                               const uint32_t stream, std::vector<LogStreamProgress> *streams_progress)
       : run_task_(false),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
         current_data_written_(0),
         buffers_(buffers),
         empty_buffer_queue_(empty_buffer_queue),
-        filled_buffer_queue_(filled_buffer_queue) {}
+        filled_buffer_queue_(filled_buffer_queue),
+        stream_(stream),
+        streams_progress_(streams_progress),
+        progress_(&(*streams_progress)[stream]) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -52,6 +59,11 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   bool run_task_;
   // Stores callbacks for commit records written to disk but not yet persisted
   std::vector<storage::CommitCallback> commit_callbacks_;
+  // Stores callbacks for persisted commit records, along with how many buffers every other stream must have persisted
+  // before we can invoke them
+  std::deque<std::pair<std::vector<uint64_t>, std::vector<storage::CommitCallback>>> pending_callbacks_;
+  // Filled buffers dequeued to be written to disk together
+  std::vector<BufferedLogWriter *> buffers_to_write_;
 
   // Interval time for when to persist log file
   const std::chrono::milliseconds persist_interval_;
@@ -67,15 +79,17 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   // The queue containing filled buffers. Task should dequeue filled buffers from this queue to flush
   common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
 
+  // The log stream this task writes out, and the progress of every log stream
+  const uint32_t stream_;
+  std::vector<LogStreamProgress> *const streams_progress_;
+  LogStreamProgress *const progress_;
+
   // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
   volatile bool do_persist_;
 
   // Synchronisation primitives to synchronise persisting buffers to disk
   std::mutex persist_lock_;
   std::condition_variable persist_cv_;
-  // Condition variable to signal disk log consumer task thread to wake up and flush buffers to disk or if shutdown has
-  // initiated, then quit
-  std::condition_variable disk_log_writer_thread_cv_;
 
   /**
    * Main disk log consumer task loop. Flushes buffers to disk when new buffers are handed to it via
@@ -84,15 +98,34 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   void DiskLogConsumerTaskLoop();
 
   /**
-   * Flush all buffers in the filled buffers queue to the log file
+   * Flush all buffers in the filled buffers queue to the log file. Buffers that are in the queue together are written
+   * out with a single system call.
    */
   void WriteBuffersToLogFile();
 
   /*
-   * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
-   * were persisted
+   * Persists the log file on disk by calling fdatasync, and queues the callbacks for all committed transactions that
+   * were persisted to be invoked
+   * @param serialized number of buffers the serializer task had handed over before we flushed the filled buffers
    * @return number of buffers persisted, used for metrics
    */
-  uint64_t PersistLogFile();
+  uint64_t PersistLogFile(uint64_t serialized);
+
+  /**
+   * @param serialized number of buffers the serializer task has handed over
+   * @return whether commits on other streams wait on some of those buffers that we have not persisted yet
+   */
+  bool PersistRequested(uint64_t serialized) const;
+
+  /**
+   * @return whether the oldest persisted commit callbacks can be invoked, i.e. every other stream has persisted all
+   * buffers handed to it before the commits
+   */
+  bool CanInvokeCallbacks() const;
+
+  /**
+   * Invokes the persisted commit callbacks in order, until one of them cannot be invoked yet
+   */
+  void InvokeCallbacks();
 };
 }  // namespace terrier::storage
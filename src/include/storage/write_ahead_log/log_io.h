@@ -7,6 +7,7 @@
 #include <cerrno>
 #include <cstring>
 #include <string>
+#include <vector>
 #include "common/constants.h"
 #include "common/macros.h"
 #include "loggers/storage_logger.h"
@@ -68,6 +69,16 @@ struct PosixIoWrappers {
    * @throws runtime_error if the underlying posix call failed
    */
   static void WriteFully(int fd, const void *buf, size_t nbyte);
+
+  /**
+   * Wrapper around the posix writev call, where a single function call will always write all the buffers out.
+   * (unlike posix writev, which can write arbitrarily many bytes less than the given amount)
+   * @param fd posix fildes arg
+   * @param iov posix iov arg. The entries are modified to track progress over partial writes.
+   * @param iovcnt posix iovcnt arg
+   * @throws runtime_error if the underlying posix call failed
+   */
+  static void WritevFully(int fd, struct iovec *iov, int iovcnt);
 };
 // TODO(Tianyu):  we need control over when and what to flush as the log manager. Thus, we need to write our
 // own wrapper around lower level I/O functions. I could be wrong, and in that case we should
@@ -114,10 +125,11 @@ class BufferedLogWriter {
   }
 
   /**
-   * Call fsync to make sure that all writes are consistent.
+   * Call fdatasync to make sure that all writes are consistent. The log is only ever appended to, so the file size is
+   * the only metadata we need persisted, which fdatasync takes care of.
    */
   void Persist() {
-    if (fsync(out_) == -1) throw std::runtime_error("fsync failed with errno " + std::to_string(errno));
+    if (fdatasync(out_) == -1) throw std::runtime_error("fdatasync failed with errno " + std::to_string(errno));
   }
 
   /**
@@ -131,6 +143,14 @@ class BufferedLogWriter {
     return size;
   }
 
+  /**
+   * Flush the buffered writes of the given writers, in order, with as few write calls as possible. All writers must
+   * write to the same log file.
+   * @param writers the writers to flush
+   * @return amount of data flushed
+   */
+  static uint64_t FlushBuffers(const std::vector<BufferedLogWriter *> &writers);
+
   /**
    * @return if the buffer is full
    */
@@ -36,8 +36,14 @@ namespace terrier::storage {
  *          a) Someone calls ForceFlush on the LogManager, or
  *          b) Periodically
  *          c) A sufficient amount of data has been written since the last persist
+ *          d) There are CommitRecords waiting to be persisted (group commit)
  *      5. When the persist is done, the `DiskLogConsumerTask` will call the commit callbacks for any CommitRecords that
- * were just persisted.
+ * were just persisted. Transactions without synchronous commit have their callbacks called when they commit instead.
+ *
+ * The LogManager can split the logs into multiple streams, each with its own serializer task, consumer task and log
+ * file, so that serialization and writes scale past a single thread. Every transaction logs to the stream of the thread
+ * that began it. A commit callback is only called once every other stream has persisted all the logs handed to it
+ * before the commit, since the transaction may depend on them. Recovery merges the streams in commit order.
  */
 class LogManager : public common::DedicatedThreadOwner {
  public:
@@ -53,11 +59,16 @@ class LogManager : public common::DedicatedThreadOwner {
    * @param buffer_pool the object pool to draw log buffers from. This must be the same pool transactions draw their
    *                    buffers from
    * @param thread_registry DedicatedThreadRegistry dependency injection
+   * @param synchronous_commit whether transactions wait for their logs to be persisted before they report their commit
+   *                           by default
+   * @param num_streams number of log streams. The first one writes to log_file_path, and the others to files named
+   *                    after it (see StreamLogFilePath).
    */
   LogManager(std::string log_file_path, uint64_t num_buffers, std::chrono::microseconds serialization_interval,
              std::chrono::milliseconds persist_interval, uint64_t persist_threshold,
              common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
-             common::ManagedPointer<terrier::common::DedicatedThreadRegistry> thread_registry)
+             common::ManagedPointer<terrier::common::DedicatedThreadRegistry> thread_registry,
+             const bool synchronous_commit = true, const uint32_t num_streams = 1)
       : DedicatedThreadOwner(thread_registry),
         run_log_manager_(false),
         log_file_path_(std::move(log_file_path)),
@@ -65,9 +76,13 @@ class LogManager : public common::DedicatedThreadOwner {
         buffer_pool_(buffer_pool.Get()),
         serialization_interval_(serialization_interval),
         persist_interval_(persist_interval),
-        persist_threshold_(persist_threshold) {}
+        persist_threshold_(persist_threshold),
+        synchronous_commit_(synchronous_commit),
+        num_streams_(num_streams) {
+    TERRIER_ASSERT(num_streams_ > 0, "Need at least one log stream");
+  }
   /**
-   * Starts log manager. Does the following in order:
+   * Starts log manager. Does the following in order for every log stream:
    *    1. Initialize buffers to pass serialized logs to log consumers
    *    2. Starts up DiskLogConsumerTask
    *    3. Starts up LogSerializerTask
@@ -84,8 +99,8 @@ class LogManager : public common::DedicatedThreadOwner {
 
   /**
    * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order:
-   *    1. Stops LogSerializerTask
-   *    2. Stops DiskLogConsumerTask
+   *    1. Stops the LogSerializerTask of every stream
+   *    2. Stops the DiskLogConsumerTask of every stream
    *    3. Closes all open buffers
    * @note Start() can be called to run the log manager again, a new log manager does not need to be initialized.
    */
@@ -97,8 +112,33 @@ class LogManager : public common::DedicatedThreadOwner {
    * write to the buffer. This method can be called safely from concurrent execution threads.
    *
    * @param buffer_segment the (perhaps partially) filled log buffer ready to be consumed
+   * @param stream the log stream of the transaction the buffer belongs to
+   */
+  void AddBufferToFlushQueue(RecordBufferSegment *buffer_segment, uint32_t stream);
+
+  /**
+   * @return the log stream of transactions that the calling thread begins
+   */
+  uint32_t ThreadLogStream() const;
+
+  /**
+   * @return number of log streams
+   */
+  uint32_t NumStreams() const { return num_streams_; }
+
+  /**
+   * @param log_file_path path of the log file given to the LogManager
+   * @param stream a log stream
+   * @return path of the log file of the stream
+   */
+  static std::string StreamLogFilePath(const std::string &log_file_path, uint32_t stream) {
+    return stream == 0 ? log_file_path : log_file_path + "." + std::to_string(stream);
+  }
+
+  /**
+   * @return whether transactions wait for their logs to be persisted before they report their commit by default
    */
-  void AddBufferToFlushQueue(RecordBufferSegment *buffer_segment);
+  bool SynchronousCommit() const { return synchronous_commit_; }
 
   /**
    * For testing only
@@ -115,10 +155,14 @@ class LogManager : public common::DedicatedThreadOwner {
    */
   bool SetNumBuffers(uint64_t new_num_buffers) {
     if (new_num_buffers >= num_buffers_) {
-      // Add in new buffers
-      for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
-        buffers_.emplace_back(BufferedLogWriter(log_file_path_.c_str()));
-        empty_buffer_queue_.Enqueue(&buffers_[num_buffers_ + i]);
+      // Add in new buffers to every stream
+      for (uint32_t stream = 0; stream < streams_.size(); stream++) {
+        LogStream &log_stream = *streams_[stream];
+        const std::string stream_log_file_path = StreamLogFilePath(log_file_path_, stream);
+        for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
+          log_stream.buffers_.emplace_back(BufferedLogWriter(stream_log_file_path.c_str()));
+          log_stream.empty_buffer_queue_.Enqueue(&log_stream.buffers_[num_buffers_ + i]);
+        }
       }
       num_buffers_ = new_num_buffers;
       return true;
@@ -127,39 +171,49 @@ class LogManager : public common::DedicatedThreadOwner {
   }
 
  private:
+  // The buffers, queues and tasks of a log stream
+  struct LogStream {
+    // This stores a reference to all the buffers the serializer or the log consumer threads use
+    std::vector<BufferedLogWriter> buffers_;
+    // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
+    // serializer thread should block when requesting a new buffer until it receives an empty buffer
+    common::ConcurrentBlockingQueue<BufferedLogWriter *> empty_buffer_queue_;
+    // The queue containing filled buffers pending flush to the disk
+    common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+    // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
+    common::ManagedPointer<LogSerializerTask> log_serializer_task_ =
+        common::ManagedPointer<LogSerializerTask>(nullptr);
+    // The log consumer task which flushes filled buffers to the disk
+    common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
+        common::ManagedPointer<DiskLogConsumerTask>(nullptr);
+  };
+
   // Flag to tell us when the log manager is running or during termination
   bool run_log_manager_;
 
   // System path for log file
   std::string log_file_path_;
 
-  // Number of buffers to use for buffering and serializing logs
+  // Number of buffers every log stream uses for buffering and serializing logs
   uint64_t num_buffers_;
 
   // TODO(Tianyu): This can be changed later to be include things that are not necessarily backed by a disk
   //  (e.g. logs can be streamed out to the network for remote replication)
   RecordBufferSegmentPool *buffer_pool_;
 
-  // This stores a reference to all the buffers the serializer or the log consumer threads use
-  std::vector<BufferedLogWriter> buffers_;
-  // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
-  // serializer thread should block when requesting a new buffer until it receives an empty buffer
-  common::ConcurrentBlockingQueue<BufferedLogWriter *> empty_buffer_queue_;
-  // The queue containing filled buffers pending flush to the disk
-  common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
-
-  // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
-  common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
   // Interval used by log serialization task
   const std::chrono::microseconds serialization_interval_;
-
-  // The log consumer task which flushes filled buffers to the disk
-  common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
-      common::ManagedPointer<DiskLogConsumerTask>(nullptr);
   // Interval used by disk consumer task
   const std::chrono::milliseconds persist_interval_;
   // Threshold used by disk consumer task
   uint64_t persist_threshold_;
+  // Default for whether txns wait for persistence before they report their commit
+  const bool synchronous_commit_;
+
+  // The log streams, and their progress shared by the tasks of all streams
+  const uint32_t num_streams_;
+  std::vector<std::unique_ptr<LogStream>> streams_;
+  std::vector<LogStreamProgress> streams_progress_;
 
   /**
    * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
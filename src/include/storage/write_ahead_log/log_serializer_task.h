@@ -23,20 +23,21 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    * @param buffer_pool buffer pool to use to release serialized buffers
    * @param empty_buffer_queue pointer to queue to pop empty buffers from
    * @param filled_buffer_queue pointer to queue to push filled buffers to
-   * @param disk_log_writer_thread_cv pointer to condition variable to notify consumer when a new buffer has handed over
+   * @param progress pointer to the progress of the log stream, whose condition variable is notified when a new buffer
+   *                 is handed over to the consumer
    */
   explicit LogSerializerTask(const std::chrono::microseconds serialization_interval,
                              RecordBufferSegmentPool *buffer_pool,
                              common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
                              common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
-                             std::condition_variable *disk_log_writer_thread_cv)
+                             LogStreamProgress *progress)
       : run_task_(false),
         serialization_interval_(serialization_interval),
         buffer_pool_(buffer_pool),
         filled_buffer_(nullptr),
         empty_buffer_queue_(empty_buffer_queue),
         filled_buffer_queue_(filled_buffer_queue),
-        disk_log_writer_thread_cv_(disk_log_writer_thread_cv) {}
+        progress_(progress) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -63,6 +64,7 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   void AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment) {
     common::SpinLatch::ScopedSpinLatch guard(&flush_queue_latch_);
     flush_queue_.push(buffer_segment);
+    progress_->added_++;
   }
 
  private:
@@ -104,8 +106,9 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   // The queue containing filled buffers. Task should push filled serialized buffers into this queue
   common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
 
-  // Condition variable to signal disk log consumer task thread that a new full buffer has been pushed to the queue
-  std::condition_variable *disk_log_writer_thread_cv_;
+  // Progress of the log stream. Its condition variable signals the disk log consumer task thread that a new full buffer
+  // has been pushed to the queue
+  LogStreamProgress *progress_;
 
   /**
    * Main serialization loop. Calls Process every interval. Processes all the accumulated log records and
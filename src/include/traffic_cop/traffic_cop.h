@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "execution/compiled_query_cache.h"
 #include "network/network_defs.h"
 #include "parser/create_statement.h"
 #include "parser/drop_statement.h"
@@ -42,16 +43,23 @@ class TrafficCop {
    * @param replication_log_provider if given, the tcop will forward replication logs to this provider
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
+   * @param parallel_execution whether generated code may use parallel pipelines
+   * @param compiled_query_cache_size maximum code size in bytes of cached compiled queries, 0 disables the cache
+   * @param query_memory_limit memory budget in bytes of each query, 0 disables the limit
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
              common::ManagedPointer<catalog::Catalog> catalog,
              common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider,
-             common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout)
+             common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
+             bool parallel_execution = false, uint64_t compiled_query_cache_size = 0, uint64_t query_memory_limit = 0)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_log_provider_(replication_log_provider),
         stats_storage_(stats_storage),
-        optimizer_timeout_(optimizer_timeout) {}
+        optimizer_timeout_(optimizer_timeout),
+        parallel_execution_(parallel_execution),
+        query_memory_limit_(query_memory_limit),
+        compiled_query_cache_(std::make_unique<execution::CompiledQueryCache>(compiled_query_cache_size)) {}
 
   virtual ~TrafficCop() = default;
 
@@ -106,6 +114,31 @@ class TrafficCop {
    */
   void SetOptimizerTimeout(const uint64_t optimizer_timeout) { optimizer_timeout_ = optimizer_timeout; }
 
+  /**
+   * Enable or disable parallel pipelines in generated code (for use by SettingsManager)
+   * @param parallel_execution whether parallel execution is enabled
+   */
+  void SetParallelExecution(const bool parallel_execution) { parallel_execution_ = parallel_execution; }
+
+  /**
+   * Resize the compiled query cache (for use by SettingsManager)
+   * @param size maximum code size in bytes of cached compiled queries, 0 disables the cache
+   */
+  void SetCompiledQueryCacheSize(const uint64_t size) { compiled_query_cache_->SetCapacity(size); }
+
+  /**
+   * Adjust the memory budget of queries (for use by SettingsManager)
+   * @param limit memory budget in bytes of each query, 0 disables the limit
+   */
+  void SetQueryMemoryLimit(const uint64_t limit) { query_memory_limit_ = limit; }
+
+  /**
+   * @return the cache of compiled queries
+   */
+  common::ManagedPointer<execution::CompiledQueryCache> GetCompiledQueryCache() const {
+    return common::ManagedPointer(compiled_query_cache_);
+  }
+
  private:
   // Internal method to handle the logic of beginning a txn. Is not responsible for outputting results, only meant to be
   // called by ExecuteTransactionStatement
@@ -139,6 +172,11 @@ class TrafficCop {
                             common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
                             terrier::network::QueryType query_type, bool single_statement_txn) const;
 
+  // Contains the logic to reason about COPY execution. Responsible for outputting results.
+  void ExecuteCopyStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                            common::ManagedPointer<network::PostgresPacketWriter> out,
+                            common::ManagedPointer<parser::ParseResult> parse_result) const;
+
   // Contains the logic to reason about DML execution. Responsible for outputting results.
   void CodegenAndRunPhysicalPlan(common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                  common::ManagedPointer<network::PostgresPacketWriter> out,
@@ -151,6 +189,11 @@ class TrafficCop {
   common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider_;
   common::ManagedPointer<optimizer::StatsStorage> stats_storage_;
   uint64_t optimizer_timeout_;
+  bool parallel_execution_;
+  // Memory budget of each query, 0 for no limit
+  uint64_t query_memory_limit_;
+  // Compiled queries shared by all connections, keyed by plan fingerprint
+  std::unique_ptr<execution::CompiledQueryCache> compiled_query_cache_;
 };
 
 }  // namespace terrier::trafficcop
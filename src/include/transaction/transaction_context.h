@@ -4,6 +4,7 @@
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/object_pool.h"
+#include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/data_table.h"
 #include "storage/record_buffer.h"
@@ -82,6 +83,26 @@ class TransactionContext {
    */
   timestamp_t FinishTime() const { return finish_time_.load(); }
 
+  /**
+   * @return a timestamp no newer than the start time of any transaction running at the same time as this one. Versions
+   * older than it are invisible to everyone, so they can be unlinked from their version chains. TransactionContexts
+   * generated outside of the TransactionManager (i.e. in tests) return INITIAL_TXN_TIMESTAMP, which unlinks nothing.
+   */
+  timestamp_t OldestActiveTime() const { return oldest_active_time_; }
+
+  /**
+   * @return whether the commit callback of this transaction waits for its logs to be persisted
+   */
+  bool SynchronousCommit() const { return synchronous_commit_; }
+
+  /**
+   * Sets whether the commit callback of this transaction waits for its logs to be persisted. Without it, the callback
+   * is invoked as soon as the transaction commits, and a crash may lose a transaction that was reported as committed.
+   * The transaction is still serialized in order, so recovery never sees a partial transaction.
+   * @param synchronous_commit whether to wait for persistence before invoking the commit callback
+   */
+  void SetSynchronousCommit(const bool synchronous_commit) { synchronous_commit_ = synchronous_commit; }
+
   /**
    * Reserve space on this transaction's undo buffer for a record to log the update given
    * @param table pointer to the updated DataTable object
@@ -106,6 +127,22 @@ class TransactionContext {
     return storage::UndoRecord::InitializeInsert(result, finish_time_.load(), slot, table);
   }
 
+  /**
+   * Reserve space on this transaction's undo buffer for a record to log the bulk insert given. Unlike the other
+   * methods, this one may be called concurrently by several threads working on behalf of this transaction, as long as
+   * no other writes are made at the same time.
+   * @param table pointer to the updated DataTable object
+   * @param slot the first TupleSlot inserted
+   * @param num_slots number of consecutive slots inserted in the same block, starting at slot
+   * @return a persistent pointer to the head of a memory chunk large enough to hold the undo record
+   */
+  storage::UndoRecord *UndoRecordForBulkInsert(storage::DataTable *const table, const storage::TupleSlot slot,
+                                               const uint32_t num_slots) {
+    common::SpinLatch::ScopedSpinLatch guard(&bulk_insert_latch_);
+    byte *const result = undo_buffer_.NewEntry(storage::UndoRecord::BulkInsertSize());
+    return storage::UndoRecord::InitializeBulkInsert(result, finish_time_.load(), slot, table, num_slots);
+  }
+
   /**
    * Reserve space on this transaction's undo buffer for a record to log the delete given
    * @param table pointer to the updated DataTable object
@@ -214,8 +251,13 @@ class TransactionContext {
   friend class storage::RecoveryTests;           // Needs access to redo buffer
   const timestamp_t start_time_;
   std::atomic<timestamp_t> finish_time_;
+  // Oldest running txn known to the timestamp manager when this txn began
+  timestamp_t oldest_active_time_ = INITIAL_TXN_TIMESTAMP;
+  bool synchronous_commit_ = true;
   storage::UndoBuffer undo_buffer_;
   storage::RedoBuffer redo_buffer_;
+  // Serializes concurrent bulk inserts into undo_buffer_
+  common::SpinLatch bulk_insert_latch_;
   // TODO(Tianyu): Maybe not so much of a good idea to do this. Make explicit queue in GC?
   //
   std::vector<const byte *> loose_ptrs_;
@@ -85,6 +85,7 @@ class TransactionManager {
 
   bool gc_enabled_ = false;
   TransactionQueue completed_txns_;
+  common::SpinLatch completed_txns_latch_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
   timestamp_t UpdatingCommitCriticalSection(TransactionContext *txn);
@@ -96,11 +97,13 @@ class TransactionManager {
 
   void Rollback(TransactionContext *txn, const storage::UndoRecord &record) const;
 
+  void RollbackSlot(TransactionContext *txn, storage::DataTable *table, storage::TupleSlot slot) const;
+
   void DeallocateColumnUpdateIfVarlen(TransactionContext *txn, storage::UndoRecord *undo,
                                       uint16_t projection_list_index,
                                       const storage::TupleAccessStrategy &accessor) const;
 
-  void DeallocateInsertedTupleIfVarlen(TransactionContext *txn, storage::UndoRecord *undo,
+  void DeallocateInsertedTupleIfVarlen(TransactionContext *txn, storage::TupleSlot slot,
                                        const storage::TupleAccessStrategy &accessor) const;
   void GCLastUpdateOnAbort(TransactionContext *txn);
 };
@@ -111,6 +111,19 @@ void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) {}
 
+void ChildPropertyDeriver::Visit(const InnerMergeJoin *op) {
+  // Both children must be sorted ascending on their join keys. The right child drives the output, so the output is
+  // sorted on the right keys as well.
+  std::vector<OrderByOrderingType> left_ascending(op->GetLeftKeys().size(), OrderByOrderingType::ASC);
+  std::vector<OrderByOrderingType> right_ascending(op->GetRightKeys().size(), OrderByOrderingType::ASC);
+
+  auto left_prop =
+      new PropertySet(std::vector<Property *>{new PropertySort(op->GetLeftKeys(), std::move(left_ascending))});
+  auto right_prop =
+      new PropertySet(std::vector<Property *>{new PropertySort(op->GetRightKeys(), std::move(right_ascending))});
+  output_.emplace_back(right_prop->Copy(), std::vector<PropertySet *>{left_prop, right_prop});
+}
+
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const Insert *op) {
   std::vector<PropertySet *> child_input_properties;
   output_.emplace_back(requirements_->Copy(), std::move(child_input_properties));
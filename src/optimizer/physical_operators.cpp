@@ -497,6 +497,54 @@ bool OuterHashJoin::operator==(const BaseOperatorNodeContents &r) {
   return (*join_predicate_ == *(node.join_predicate_));
 }
 
+//===--------------------------------------------------------------------===//
+// InnerMergeJoin
+//===--------------------------------------------------------------------===//
+BaseOperatorNodeContents *InnerMergeJoin::Copy() const { return new InnerMergeJoin(*this); }
+
+Operator InnerMergeJoin::Make(std::vector<AnnotatedExpression> &&join_predicates,
+                              std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                              std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys,
+                              parser::ExpressionType key_comparison) {
+  auto join = std::make_unique<InnerMergeJoin>();
+  join->join_predicates_ = std::move(join_predicates);
+  join->left_keys_ = std::move(left_keys);
+  join->right_keys_ = std::move(right_keys);
+  join->key_comparison_ = key_comparison;
+  return Operator(std::move(join));
+}
+
+common::hash_t InnerMergeJoin::Hash() const {
+  common::hash_t hash = BaseOperatorNodeContents::Hash();
+  for (auto &expr : left_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(key_comparison_));
+  for (auto &pred : join_predicates_) {
+    auto expr = pred.GetExpr();
+    if (expr)
+      hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    else
+      hash = common::HashUtil::SumHashes(hash, BaseOperatorNodeContents::Hash());
+  }
+  return hash;
+}
+
+bool InnerMergeJoin::operator==(const BaseOperatorNodeContents &r) {
+  if (r.GetType() != OpType::INNERMERGEJOIN) return false;
+  const InnerMergeJoin &node = *dynamic_cast<const InnerMergeJoin *>(&r);
+  if (left_keys_.size() != node.left_keys_.size() || right_keys_.size() != node.right_keys_.size() ||
+      join_predicates_.size() != node.join_predicates_.size() || key_comparison_ != node.key_comparison_)
+    return false;
+  if (join_predicates_ != node.join_predicates_) return false;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (*(left_keys_[i]) != *(node.left_keys_[i])) return false;
+  }
+  for (size_t i = 0; i < right_keys_.size(); i++) {
+    if (*(right_keys_[i]) != *(node.right_keys_[i])) return false;
+  }
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Insert
 //===--------------------------------------------------------------------===//
@@ -1258,6 +1306,8 @@ const char *OperatorNodeContents<RightHashJoin>::name = "RightHashJoin";
 template <>
 const char *OperatorNodeContents<OuterHashJoin>::name = "OuterHashJoin";
 template <>
+const char *OperatorNodeContents<InnerMergeJoin>::name = "InnerMergeJoin";
+template <>
 const char *OperatorNodeContents<Insert>::name = "Insert";
 template <>
 const char *OperatorNodeContents<InsertSelect>::name = "InsertSelect";
@@ -1332,6 +1382,8 @@ OpType OperatorNodeContents<RightHashJoin>::type = OpType::RIGHTHASHJOIN;
 template <>
 OpType OperatorNodeContents<OuterHashJoin>::type = OpType::OUTERHASHJOIN;
 template <>
+OpType OperatorNodeContents<InnerMergeJoin>::type = OpType::INNERMERGEJOIN;
+template <>
 OpType OperatorNodeContents<Insert>::type = OpType::INSERT;
 template <>
 OpType OperatorNodeContents<InsertSelect>::type = OpType::INSERTSELECT;
@@ -37,6 +37,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/projection_plan_node.h"
@@ -562,6 +563,45 @@ void PlanGenerator::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) {
   TERRIER_ASSERT(0, "OuterHashJoin not implemented");
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// A mergejoin B (both sides sorted on the join keys)
+///////////////////////////////////////////////////////////////////////////////
+
+void PlanGenerator::Visit(const InnerMergeJoin *op) {
+  auto proj_schema = GenerateProjectionForJoin();
+
+  auto comb_pred = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetJoinPredicates());
+  auto eval_pred =
+      parser::ExpressionUtil::EvaluateExpression(children_expr_map_, common::ManagedPointer(comb_pred.get()));
+  auto join_predicate =
+      parser::ExpressionUtil::ConvertExprCVNodes(common::ManagedPointer(eval_pred.get()), children_expr_map_).release();
+  RegisterPointerCleanup<parser::AbstractExpression>(join_predicate, true, true);
+
+  // The predicate rechecks the merge keys, but also covers the predicates that are not merge keys
+  auto builder = planner::MergeJoinPlanNode::Builder();
+  builder.SetOutputSchema(std::move(proj_schema));
+  builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
+  builder.SetKeyComparison(op->GetKeyComparison());
+
+  std::vector<ExprMap> l_child_map{std::move(children_expr_map_[0])};
+  std::vector<ExprMap> r_child_map{std::move(children_expr_map_[1])};
+  for (auto &expr : op->GetLeftKeys()) {
+    auto left_key = parser::ExpressionUtil::EvaluateExpression(l_child_map, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(left_key, true, true);
+    builder.AddLeftMergeKey(common::ManagedPointer(left_key));
+  }
+
+  for (auto &expr : op->GetRightKeys()) {
+    auto right_key = parser::ExpressionUtil::EvaluateExpression(r_child_map, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
+    builder.AddRightMergeKey(common::ManagedPointer(right_key));
+  }
+
+  builder.AddChild(std::move(children_plans_[0]));
+  builder.AddChild(std::move(children_plans_[1]));
+  output_plan_ = builder.Build();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Aggregations (when the groups are greater than individuals)
 ///////////////////////////////////////////////////////////////////////////////
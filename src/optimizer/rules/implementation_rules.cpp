@@ -533,6 +533,68 @@ void LogicalInnerJoinToPhysicalInnerHashJoin::Transform(common::ManagedPointer<O
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalInnerJoinToPhysicalInnerMergeJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalInnerJoinToPhysicalInnerMergeJoin::LogicalInnerJoinToPhysicalInnerMergeJoin() {
+  type_ = RuleType::INNER_JOIN_TO_MERGE_JOIN;
+
+  // Make three node types for pattern matching
+  auto left_child(new Pattern(OpType::LEAF));
+  auto right_child(new Pattern(OpType::LEAF));
+
+  // Initialize a pattern for optimizer to match
+  match_pattern_ = new Pattern(OpType::LOGICALINNERJOIN);
+
+  // Add node - we match join relation R and S as well as the predicate exp
+  match_pattern_->AddChild(left_child);
+  match_pattern_->AddChild(right_child);
+}
+
+bool LogicalInnerJoinToPhysicalInnerMergeJoin::Check(common::ManagedPointer<OperatorNode> plan,
+                                                     OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void LogicalInnerJoinToPhysicalInnerMergeJoin::Transform(common::ManagedPointer<OperatorNode> input,
+                                                         std::vector<std::unique_ptr<OperatorNode>> *transformed,
+                                                         UNUSED_ATTRIBUTE OptimizationContext *context) const {
+  // first build an expression representing merge join
+  const auto inner_join = input->GetOp().As<LogicalInnerJoin>();
+
+  auto children = input->GetChildren();
+  TERRIER_ASSERT(children.size() == 2, "Inner Join should have two child");
+  auto left_group_id = children[0]->GetOp().As<LeafOperator>()->GetOriginGroup();
+  auto right_group_id = children[1]->GetOp().As<LeafOperator>()->GetOriginGroup();
+  auto &left_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
+
+  // Merge on the equality keys if there are any. Otherwise, a single inequality can be merged on, which hash joins
+  // cannot do.
+  std::vector<AnnotatedExpression> join_preds = inner_join->GetJoinPredicates();
+  auto key_comparison = parser::ExpressionType::COMPARE_EQUAL;
+  OptimizerUtil::ExtractEquiJoinKeys(join_preds, &left_keys, &right_keys, left_group_alias, right_group_alias);
+  if (left_keys.empty()) {
+    key_comparison = OptimizerUtil::ExtractInequalityJoinKey(join_preds, &left_keys, &right_keys, left_group_alias,
+                                                             right_group_alias);
+  }
+
+  TERRIER_ASSERT(right_keys.size() == left_keys.size(), "# left/right keys should equal");
+  std::vector<std::unique_ptr<OperatorNode>> child;
+  child.emplace_back(children[0]->Copy());
+  child.emplace_back(children[1]->Copy());
+  if (!left_keys.empty()) {
+    auto result = std::make_unique<OperatorNode>(
+        InnerMergeJoin::Make(std::move(join_preds), std::move(left_keys), std::move(right_keys), key_comparison),
+        std::move(child));
+    transformed->emplace_back(std::move(result));
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalLimitToPhysicalLimit
 ///////////////////////////////////////////////////////////////////////////////
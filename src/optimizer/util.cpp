@@ -44,6 +44,59 @@ void OptimizerUtil::ExtractEquiJoinKeys(const std::vector<AnnotatedExpression> &
   }
 }
 
+parser::ExpressionType OptimizerUtil::ExtractInequalityJoinKey(
+    const std::vector<AnnotatedExpression> &join_predicates,
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *left_keys,
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *right_keys,
+    const std::unordered_set<std::string> &left_alias, const std::unordered_set<std::string> &right_alias) {
+  for (auto &expr_unit : join_predicates) {
+    auto expr = expr_unit.GetExpr();
+    auto comparison = expr->GetExpressionType();
+    // The comparison seen from the other side, i.e. a < b is b > a
+    parser::ExpressionType flipped;
+    switch (comparison) {
+      case parser::ExpressionType::COMPARE_LESS_THAN:
+        flipped = parser::ExpressionType::COMPARE_GREATER_THAN;
+        break;
+      case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+        flipped = parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO;
+        break;
+      case parser::ExpressionType::COMPARE_GREATER_THAN:
+        flipped = parser::ExpressionType::COMPARE_LESS_THAN;
+        break;
+      case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+        flipped = parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO;
+        break;
+      default:
+        continue;
+    }
+
+    auto l_expr = expr->GetChild(0);
+    auto r_expr = expr->GetChild(1);
+    if (l_expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE ||
+        r_expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+      continue;
+    }
+    auto l_tv_expr = l_expr.CastManagedPointerTo<parser::ColumnValueExpression>();
+    auto r_tv_expr = r_expr.CastManagedPointerTo<parser::ColumnValueExpression>();
+
+    // Assign keys based on left and right join tables
+    if (left_alias.find(l_tv_expr->GetTableName()) != left_alias.end() &&
+        right_alias.find(r_tv_expr->GetTableName()) != right_alias.end()) {
+      left_keys->emplace_back(l_expr);
+      right_keys->emplace_back(r_expr);
+      return comparison;
+    }
+    if (left_alias.find(r_tv_expr->GetTableName()) != left_alias.end() &&
+        right_alias.find(l_tv_expr->GetTableName()) != right_alias.end()) {
+      left_keys->emplace_back(r_expr);
+      right_keys->emplace_back(l_expr);
+      return flipped;
+    }
+  }
+  return parser::ExpressionType::INVALID;
+}
+
 std::vector<parser::AbstractExpression *> OptimizerUtil::GenerateTableColumnValueExprs(
     catalog::CatalogAccessor *accessor, const std::string &alias, catalog::db_oid_t db_oid,
     catalog::table_oid_t tbl_oid) {
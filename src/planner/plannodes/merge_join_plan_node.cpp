@@ -0,0 +1,92 @@
+#include "planner/plannodes/merge_join_plan_node.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace terrier::planner {
+
+common::hash_t MergeJoinPlanNode::Hash() const {
+  common::hash_t hash = AbstractJoinPlanNode::Hash();
+
+  // Hash left keys
+  for (const auto &left_merge_key : left_merge_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, left_merge_key->Hash());
+  }
+
+  // Hash right keys
+  for (const auto &right_merge_key : right_merge_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, right_merge_key->Hash());
+  }
+
+  // Hash key comparison
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(key_comparison_));
+
+  return hash;
+}
+
+bool MergeJoinPlanNode::operator==(const AbstractPlanNode &rhs) const {
+  if (!AbstractJoinPlanNode::operator==(rhs)) return false;
+
+  const auto &other = static_cast<const MergeJoinPlanNode &>(rhs);
+
+  // Key comparison
+  if (key_comparison_ != other.key_comparison_) return false;
+
+  // Left merge keys
+  if (left_merge_keys_.size() != other.left_merge_keys_.size()) return false;
+  for (size_t i = 0; i < left_merge_keys_.size(); i++) {
+    if (*left_merge_keys_[i] != *other.left_merge_keys_[i]) return false;
+  }
+
+  // Right merge keys
+  if (right_merge_keys_.size() != other.right_merge_keys_.size()) return false;
+  for (size_t i = 0; i < right_merge_keys_.size(); i++) {
+    if (*right_merge_keys_[i] != *other.right_merge_keys_[i]) return false;
+  }
+
+  return true;
+}
+
+nlohmann::json MergeJoinPlanNode::ToJson() const {
+  nlohmann::json j = AbstractJoinPlanNode::ToJson();
+  j["left_merge_keys"] = left_merge_keys_;
+  j["right_merge_keys"] = right_merge_keys_;
+  j["key_comparison"] = key_comparison_;
+  return j;
+}
+
+std::vector<std::unique_ptr<parser::AbstractExpression>> MergeJoinPlanNode::FromJson(const nlohmann::json &j) {
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs;
+  auto e1 = AbstractJoinPlanNode::FromJson(j);
+  exprs.insert(exprs.end(), std::make_move_iterator(e1.begin()), std::make_move_iterator(e1.end()));
+
+  // Deserialize left keys
+  auto left_keys = j.at("left_merge_keys").get<std::vector<nlohmann::json>>();
+  for (const auto &key_json : left_keys) {
+    if (!key_json.is_null()) {
+      auto deserialized = parser::DeserializeExpression(key_json);
+      left_merge_keys_.emplace_back(common::ManagedPointer(deserialized.result_));
+      exprs.emplace_back(std::move(deserialized.result_));
+      exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                   std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+    }
+  }
+
+  // Deserialize right keys
+  auto right_keys = j.at("right_merge_keys").get<std::vector<nlohmann::json>>();
+  for (const auto &key_json : right_keys) {
+    if (!key_json.is_null()) {
+      auto deserialized = parser::DeserializeExpression(key_json);
+      right_merge_keys_.emplace_back(common::ManagedPointer(deserialized.result_));
+      exprs.emplace_back(std::move(deserialized.result_));
+      exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                   std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+    }
+  }
+
+  key_comparison_ = j.at("key_comparison").get<parser::ExpressionType>();
+  return exprs;
+}
+
+}  // namespace terrier::planner
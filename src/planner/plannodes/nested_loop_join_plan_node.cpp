@@ -8,8 +8,12 @@ namespace terrier::planner {
 
 common::hash_t NestedLoopJoinPlanNode::Hash() const {
   common::hash_t hash = AbstractJoinPlanNode::Hash();
-  hash = common::HashUtil::CombineHashInRange(hash, left_keys_.begin(), left_keys_.end());
-  hash = common::HashUtil::CombineHashInRange(hash, right_keys_.begin(), right_keys_.end());
+  for (const auto &left_key : left_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, left_key->Hash());
+  }
+  for (const auto &right_key : right_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, right_key->Hash());
+  }
   return hash;
 }
 
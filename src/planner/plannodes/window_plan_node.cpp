@@ -0,0 +1,147 @@
+#include "planner/plannodes/window_plan_node.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace terrier::planner {
+
+common::hash_t WindowFunction::Hash() const {
+  common::hash_t hash = common::HashUtil::Hash(type_);
+  if (aggregate_ != nullptr) {
+    hash = common::HashUtil::CombineHashes(hash, aggregate_->Hash());
+  }
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_mode_));
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_start_));
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_start_offset_));
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_end_));
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(frame_end_offset_));
+  return hash;
+}
+
+bool WindowFunction::operator==(const WindowFunction &rhs) const {
+  if (type_ != rhs.type_) return false;
+  if ((aggregate_ == nullptr) != (rhs.aggregate_ == nullptr)) return false;
+  if (aggregate_ != nullptr && *aggregate_ != *rhs.aggregate_) return false;
+  return frame_mode_ == rhs.frame_mode_ && frame_start_ == rhs.frame_start_ &&
+         frame_start_offset_ == rhs.frame_start_offset_ && frame_end_ == rhs.frame_end_ &&
+         frame_end_offset_ == rhs.frame_end_offset_;
+}
+
+common::hash_t WindowPlanNode::Hash() const {
+  common::hash_t hash = AbstractPlanNode::Hash();
+
+  // Partition By Terms
+  for (const auto &partition_by_term : partition_by_terms_) {
+    hash = common::HashUtil::CombineHashes(hash, partition_by_term->Hash());
+  }
+
+  // Sort Keys
+  for (const auto &sort_key : sort_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, sort_key.first->Hash());
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(sort_key.second));
+  }
+
+  // Window Functions
+  for (const auto &window_function : window_functions_) {
+    hash = common::HashUtil::CombineHashes(hash, window_function.Hash());
+  }
+
+  return hash;
+}
+
+bool WindowPlanNode::operator==(const AbstractPlanNode &rhs) const {
+  if (!AbstractPlanNode::operator==(rhs)) return false;
+
+  auto &other = static_cast<const WindowPlanNode &>(rhs);
+
+  // Partition By Terms
+  if (partition_by_terms_.size() != other.partition_by_terms_.size()) return false;
+  for (size_t i = 0; i < partition_by_terms_.size(); i++) {
+    if (*partition_by_terms_[i] != *other.partition_by_terms_[i]) return false;
+  }
+
+  // Sort Keys
+  if (sort_keys_.size() != other.sort_keys_.size()) return false;
+  for (size_t i = 0; i < sort_keys_.size(); i++) {
+    if (sort_keys_[i].second != other.sort_keys_[i].second) return false;
+    if (*sort_keys_[i].first != *other.sort_keys_[i].first) return false;
+  }
+
+  // Window Functions
+  return window_functions_ == other.window_functions_;
+}
+
+nlohmann::json WindowPlanNode::ToJson() const {
+  nlohmann::json j = AbstractPlanNode::ToJson();
+
+  j["partition_by_terms"] = partition_by_terms_;
+
+  std::vector<std::pair<nlohmann::json, optimizer::OrderByOrderingType>> sort_keys;
+  sort_keys.reserve(sort_keys_.size());
+  for (const auto &key : sort_keys_) {
+    sort_keys.emplace_back(key.first->ToJson(), key.second);
+  }
+  j["sort_keys"] = sort_keys;
+
+  std::vector<nlohmann::json> window_functions;
+  window_functions.reserve(window_functions_.size());
+  for (const auto &function : window_functions_) {
+    nlohmann::json function_json;
+    function_json["type"] = function.type_;
+    function_json["aggregate"] = function.aggregate_;
+    function_json["frame_mode"] = function.frame_mode_;
+    function_json["frame_start"] = function.frame_start_;
+    function_json["frame_start_offset"] = function.frame_start_offset_;
+    function_json["frame_end"] = function.frame_end_;
+    function_json["frame_end_offset"] = function.frame_end_offset_;
+    window_functions.emplace_back(std::move(function_json));
+  }
+  j["window_functions"] = window_functions;
+  return j;
+}
+
+std::vector<std::unique_ptr<parser::AbstractExpression>> WindowPlanNode::FromJson(const nlohmann::json &j) {
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs;
+  auto e1 = AbstractPlanNode::FromJson(j);
+  exprs.insert(exprs.end(), std::make_move_iterator(e1.begin()), std::make_move_iterator(e1.end()));
+
+  // Takes ownership of a deserialized expression, and returns a pointer to it
+  auto deserialize = [&exprs](const nlohmann::json &json) {
+    auto deserialized = parser::DeserializeExpression(json);
+    auto expr = common::ManagedPointer(deserialized.result_);
+    exprs.emplace_back(std::move(deserialized.result_));
+    exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                 std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+    return expr;
+  };
+
+  // Deserialize partition by terms
+  for (const auto &json : j.at("partition_by_terms").get<std::vector<nlohmann::json>>()) {
+    partition_by_terms_.emplace_back(deserialize(json));
+  }
+
+  // Deserialize sort keys
+  auto sort_keys = j.at("sort_keys").get<std::vector<std::pair<nlohmann::json, optimizer::OrderByOrderingType>>>();
+  for (const auto &key_json : sort_keys) {
+    sort_keys_.emplace_back(deserialize(key_json.first), key_json.second);
+  }
+
+  // Deserialize window functions
+  for (const auto &json : j.at("window_functions").get<std::vector<nlohmann::json>>()) {
+    WindowFunction function{};
+    function.type_ = json.at("type").get<WindowFunctionType>();
+    if (!json.at("aggregate").is_null()) {
+      function.aggregate_ = deserialize(json.at("aggregate"));
+    }
+    function.frame_mode_ = json.at("frame_mode").get<WindowFrameMode>();
+    function.frame_start_ = json.at("frame_start").get<WindowFrameBoundType>();
+    function.frame_start_offset_ = json.at("frame_start_offset").get<uint64_t>();
+    function.frame_end_ = json.at("frame_end").get<WindowFrameBoundType>();
+    function.frame_end_offset_ = json.at("frame_end_offset").get<uint64_t>();
+    window_functions_.emplace_back(function);
+  }
+  return exprs;
+}
+
+}  // namespace terrier::planner
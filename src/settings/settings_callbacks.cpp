@@ -93,4 +93,32 @@ void Callbacks::MetricsPipeline(void *const old_value, void *const new_value, DB
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::ParallelExecution(void *const old_value, void *const new_value, DBMain *const db_main,
+                                  common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  bool new_status = *static_cast<bool *>(new_value);
+  if (db_main->GetTrafficCop() != DISABLED) db_main->GetTrafficCop()->SetParallelExecution(new_status);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
+void Callbacks::CompiledQueryCacheSize(void *const old_value, void *const new_value, DBMain *const db_main,
+                                       common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  int64_t new_size = *static_cast<int64_t *>(new_value);
+  if (db_main->GetTrafficCop() != DISABLED) {
+    db_main->GetTrafficCop()->SetCompiledQueryCacheSize(static_cast<uint64_t>(new_size));
+  }
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
+void Callbacks::QueryMemoryLimit(void *const old_value, void *const new_value, DBMain *const db_main,
+                                 common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  int64_t new_limit = *static_cast<int64_t *>(new_value);
+  if (db_main->GetTrafficCop() != DISABLED) {
+    db_main->GetTrafficCop()->SetQueryMemoryLimit(static_cast<uint64_t>(new_limit));
+  }
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 }  // namespace terrier::settings
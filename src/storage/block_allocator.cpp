@@ -0,0 +1,128 @@
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <new>
+
+#include "storage/storage_defs.h"
+
+namespace terrier::storage {
+
+namespace {
+// Chunks hold a whole number of blocks and are aligned to their size, so every block in them is aligned as well
+constexpr uint32_t CHUNK_SIZE = common::Constants::HUGE_PAGE_SIZE;
+constexpr uint32_t BLOCKS_PER_CHUNK = CHUNK_SIZE / common::Constants::BLOCK_SIZE;
+static_assert(CHUNK_SIZE % common::Constants::BLOCK_SIZE == 0, "Chunks must hold a whole number of blocks");
+
+// Largest number of NUMA nodes we look for
+constexpr uint32_t MAX_NUMA_NODES = 1024;
+constexpr uint32_t BITS_PER_MASK_WORD = 8 * sizeof(unsigned long);  // NOLINT
+
+uintptr_t ChunkOf(const RawBlock *block) { return reinterpret_cast<uintptr_t>(block) & ~(uintptr_t{CHUNK_SIZE} - 1); }
+}  // namespace
+
+BlockAllocator::BlockAllocator(const bool huge_pages, const NumaPolicy numa_policy)
+    : mapped_(true), huge_pages_(huge_pages), numa_policy_(numa_policy) {
+  if (numa_policy_ == NumaPolicy::NONE) return;
+  // The nodes we may bind memory to. The call fails without NUMA support in the kernel, in which case we never bind.
+  unsigned long mask[MAX_NUMA_NODES / BITS_PER_MASK_WORD] = {};  // NOLINT
+  if (syscall(SYS_get_mempolicy, nullptr, mask, MAX_NUMA_NODES, nullptr, MPOL_F_MEMS_ALLOWED) != 0) return;
+  for (uint32_t node = 0; node < MAX_NUMA_NODES; node++) {
+    if ((mask[node / BITS_PER_MASK_WORD] >> (node % BITS_PER_MASK_WORD)) & 1UL)
+      numa_nodes_.push_back(static_cast<uint16_t>(node));
+  }
+}
+
+RawBlock *BlockAllocator::New() {
+  if (!mapped_) {
+    auto *block = new RawBlock();
+    block->numa_node_ = UNKNOWN_NUMA_NODE;
+    return block;
+  }
+
+  if (spare_blocks_.empty()) {
+    const uint16_t numa_node = NextNumaNode();
+    byte *chunk = MapChunk(numa_node);
+    if (chunk == nullptr) return nullptr;
+    // Construct the blocks now so that the node sticks to them across reuse
+    for (uint32_t i = BLOCKS_PER_CHUNK; i > 0; i--) {
+      auto *block = new (chunk + (i - 1) * common::Constants::BLOCK_SIZE) RawBlock;
+      block->numa_node_ = numa_node;
+      spare_blocks_.push_back(block);
+    }
+    live_blocks_[reinterpret_cast<uintptr_t>(chunk)] = 0;
+  }
+
+  RawBlock *block = spare_blocks_.back();
+  spare_blocks_.pop_back();
+  live_blocks_[ChunkOf(block)]++;
+  return block;
+}
+
+void BlockAllocator::Delete(RawBlock *const ptr) {
+  if (!mapped_) {
+    delete ptr;
+    return;
+  }
+
+  const uintptr_t chunk = ChunkOf(ptr);
+  auto live = live_blocks_.find(chunk);
+  TERRIER_ASSERT(live != live_blocks_.end() && live->second > 0, "Deleting a block this allocator did not hand out");
+  spare_blocks_.push_back(ptr);
+  if (--live->second > 0) return;
+
+  // Every block of the chunk is unused, so give it back to the kernel
+  spare_blocks_.erase(std::remove_if(spare_blocks_.begin(), spare_blocks_.end(),
+                                     [=](const RawBlock *block) { return ChunkOf(block) == chunk; }),
+                      spare_blocks_.end());
+  live_blocks_.erase(live);
+  munmap(reinterpret_cast<void *>(chunk), CHUNK_SIZE);
+}
+
+uint16_t BlockAllocator::CurrentNumaNode() {
+  unsigned cpu, node;  // NOLINT
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return UNKNOWN_NUMA_NODE;
+  return static_cast<uint16_t>(node);
+}
+
+uint16_t BlockAllocator::NextNumaNode() {
+  if (numa_nodes_.empty()) return UNKNOWN_NUMA_NODE;
+  switch (numa_policy_) {
+    case NumaPolicy::INTERLEAVE:
+      return numa_nodes_[next_numa_node_++ % numa_nodes_.size()];
+    case NumaPolicy::LOCAL:
+      return CurrentNumaNode();
+    default:
+      return UNKNOWN_NUMA_NODE;
+  }
+}
+
+byte *BlockAllocator::MapChunk(const uint16_t numa_node) {
+  void *chunk = MAP_FAILED;
+  // Explicit huge pages are only there if the administrator reserved some, so fall back to transparent ones
+  if (huge_pages_)
+    chunk = mmap(nullptr, CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (chunk == MAP_FAILED) {
+    // Over-allocate to align the chunk, then trim the ends
+    void *region = mmap(nullptr, 2 * CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) return nullptr;
+    const auto start = reinterpret_cast<uintptr_t>(region);
+    const uintptr_t aligned = (start + CHUNK_SIZE - 1) & ~(uintptr_t{CHUNK_SIZE} - 1);
+    if (aligned > start) munmap(region, aligned - start);
+    munmap(reinterpret_cast<void *>(aligned + CHUNK_SIZE), start + CHUNK_SIZE - aligned);
+    chunk = reinterpret_cast<void *>(aligned);
+    if (huge_pages_) madvise(chunk, CHUNK_SIZE, MADV_HUGEPAGE);
+  }
+
+  // Bind the chunk before anything touches it. We only prefer the node, so that a full node does not fail allocations.
+  if (numa_node != UNKNOWN_NUMA_NODE && numa_node < MAX_NUMA_NODES) {
+    unsigned long mask[MAX_NUMA_NODES / BITS_PER_MASK_WORD] = {};  // NOLINT
+    mask[numa_node / BITS_PER_MASK_WORD] |= 1UL << (numa_node % BITS_PER_MASK_WORD);
+    syscall(SYS_mbind, chunk, CHUNK_SIZE, MPOL_PREFERRED, mask, MAX_NUMA_NODES, 0);
+  }
+  return reinterpret_cast<byte *>(chunk);
+}
+
+}  // namespace terrier::storage
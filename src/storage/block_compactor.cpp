@@ -246,9 +246,34 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
     common::RawConcurrentBitmap *column_bitmap = accessor.ColumnNullBitmap(block, col_id);
     if (!layout.IsVarlen(col_id)) {
       metadata.NullCount(col_id) = 0;
-      // Only need to count null for non-varlens
-      for (uint32_t i = 0; i < metadata.NumRecords(); i++)
-        if (!column_bitmap->Test(i)) metadata.NullCount(col_id)++;
+      // Only need to count null and find the exact range of values for non-varlens
+      const byte *values = accessor.ColumnStart(block, col_id);
+      int64_t min = INT64_MAX, max = INT64_MIN;
+      for (uint32_t i = 0; i < metadata.NumRecords(); i++) {
+        if (!column_bitmap->Test(i)) {
+          metadata.NullCount(col_id)++;
+          continue;
+        }
+        const int64_t value = StorageUtil::ReadInteger(values + i * layout.AttrSize(col_id), layout.AttrSize(col_id));
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+      metadata.GetZoneMap(layout, col_id).Reset(min, max);
+
+      // Integer columns can additionally keep a compressed copy for scans
+      ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
+      switch (col_info.Type()) {
+        case ArrowColumnType::FIXED_LENGTH:
+          break;
+        case ArrowColumnType::RUN_LENGTH_ENCODED:
+          RunLengthEncode(&metadata, column_bitmap, &col_info, values, layout.AttrSize(col_id));
+          break;
+        case ArrowColumnType::BIT_PACKED:
+          BitPack(&metadata, column_bitmap, &col_info, values, layout.AttrSize(col_id));
+          break;
+        default:
+          throw std::runtime_error("unexpected control flow");
+      }
       continue;
     }
 
@@ -367,4 +392,53 @@ void BlockCompactor::BuildDictionary(std::vector<const byte *> *loose_ptrs, Arro
   *col = std::move(new_col_info);
 }
 
+void BlockCompactor::RunLengthEncode(ArrowBlockMetadata *metadata, common::RawConcurrentBitmap *column_bitmap,
+                                     ArrowColumnInfo *col, const byte *values, uint16_t attr_size) {
+  // Find the runs. A NULL slot continues the current run, whatever its value is, so it never breaks a run up.
+  std::vector<int64_t> run_values;
+  std::vector<uint32_t> run_ends;
+  for (uint32_t i = 0; i < metadata->NumRecords(); i++) {
+    const bool is_null = !column_bitmap->Test(i);
+    if (is_null && !run_values.empty()) {
+      run_ends.back()++;
+      continue;
+    }
+    const int64_t value = is_null ? 0 : StorageUtil::ReadInteger(values + i * attr_size, attr_size);
+    if (run_values.empty() || run_values.back() != value) {
+      run_values.push_back(value);
+      run_ends.push_back(i);
+    }
+    run_ends.back()++;
+  }
+
+  auto encoded = EncodedIntegerColumn::RunLengthEncoded(static_cast<uint32_t>(run_values.size()));
+  std::copy(run_values.begin(), run_values.end(), encoded.RunValues());
+  std::copy(run_ends.begin(), run_ends.end(), encoded.RunEnds());
+  col->EncodedColumn() = std::move(encoded);
+}
+
+void BlockCompactor::BitPack(ArrowBlockMetadata *metadata, common::RawConcurrentBitmap *column_bitmap,
+                             ArrowColumnInfo *col, const byte *values, uint16_t attr_size) {
+  // Find the range of values, which determines how many bits the differences to the smallest one need
+  bool seen_value = false;
+  int64_t min = 0, max = 0;
+  for (uint32_t i = 0; i < metadata->NumRecords(); i++) {
+    if (!column_bitmap->Test(i)) continue;
+    const int64_t value = StorageUtil::ReadInteger(values + i * attr_size, attr_size);
+    min = seen_value ? std::min(min, value) : value;
+    max = seen_value ? std::max(max, value) : value;
+    seen_value = true;
+  }
+  const uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+  const auto bit_width = static_cast<uint8_t>(range == 0 ? 0 : 64 - __builtin_clzll(range));
+
+  // NULL slots are packed as the smallest value
+  auto encoded = EncodedIntegerColumn::BitPacked(metadata->NumRecords(), min, bit_width);
+  for (uint32_t i = 0; i < metadata->NumRecords(); i++) {
+    if (!column_bitmap->Test(i)) continue;
+    encoded.Pack(i, StorageUtil::ReadInteger(values + i * attr_size, attr_size));
+  }
+  col->EncodedColumn() = std::move(encoded);
+}
+
 }  // namespace terrier::storage
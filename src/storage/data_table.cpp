@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <list>
 
 #include "common/allocator.h"
@@ -28,7 +30,7 @@ DataTable::~DataTable() {
   common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
   for (RawBlock *block : blocks_) {
     StorageUtil::DeallocateVarlens(block, accessor_);
-    for (col_id_t i : accessor_.GetBlockLayout().Varlens())
+    for (col_id_t i : accessor_.GetBlockLayout().AllColumns())
       accessor_.GetArrowBlockMetadata(block).GetColumnInfo(accessor_.GetBlockLayout(), i).Deallocate();
     block_store_->Release(block);
   }
@@ -59,6 +61,113 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
   out_buffer->SetNumTuples(filled);
 }
 
+void DataTable::RangeScan(const common::ManagedPointer<transaction::TransactionContext> txn,
+                          SlotIterator *const start_pos, const SlotIterator &end_pos,
+                          ProjectedColumns *const out_buffer) const {
+  uint32_t filled = 0;
+  while (filled < out_buffer->MaxTuples() && *start_pos != end_pos && *start_pos != end()) {
+    ProjectedColumns::RowView row = out_buffer->InterpretAsRow(filled);
+    const TupleSlot slot = **start_pos;
+    // Only fill the buffer with valid, visible tuples
+    if (SelectIntoBuffer(txn, slot, &row)) {
+      out_buffer->TupleSlots()[filled] = slot;
+      filled++;
+    }
+    ++(*start_pos);
+  }
+  out_buffer->SetNumTuples(filled);
+}
+
+void DataTable::ScanInPlace(SlotIterator *const start_pos, ProjectedColumns *const out_buffer) const {
+  RawBlock *const block = start_pos->current_slot_.GetBlock();
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  const ArrowBlockMetadata &metadata = accessor_.GetArrowBlockMetadata(block);
+  TERRIER_ASSERT(block->controller_.GetBlockState()->load() == BlockState::FROZEN, "block must be frozen");
+
+  // Tuples of a frozen block are contiguous, versionless, and visible to everyone
+  const uint32_t start = start_pos->current_slot_.GetOffset();
+  const uint32_t filled = std::min(metadata.NumRecords() - std::min(start, metadata.NumRecords()),
+                                   out_buffer->MaxTuples());
+  for (uint16_t i = 0; i < out_buffer->NumColumns(); i++) {
+    const col_id_t col_id = out_buffer->ColumnIds()[i];
+    const uint16_t attr_size = layout.AttrSize(col_id);
+    const ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
+    const common::RawConcurrentBitmap *column_bitmap = accessor_.ColumnNullBitmap(block, col_id);
+    const byte *values = accessor_.ColumnStart(block, col_id) + start * attr_size;
+    byte *out_values = out_buffer->ColumnStart(i);
+    common::RawBitmap *out_bitmap = out_buffer->ColumnNullBitmap(i);
+    for (uint32_t j = 0; j < filled; j++) out_bitmap->Set(j, column_bitmap->Test(start + j));
+
+    switch (col_info.Type()) {
+      case ArrowColumnType::RUN_LENGTH_ENCODED: {
+        const EncodedIntegerColumn &encoded = col_info.EncodedColumn();
+        uint32_t run = static_cast<uint32_t>(
+            std::upper_bound(encoded.RunEnds(), encoded.RunEnds() + encoded.NumRuns(), start) - encoded.RunEnds());
+        for (uint32_t j = 0; j < filled; j++) {
+          if (start + j == encoded.RunEnds()[run]) run++;
+          StorageUtil::WriteInteger(encoded.RunValues()[run], out_values + j * attr_size, attr_size);
+        }
+        break;
+      }
+      case ArrowColumnType::BIT_PACKED:
+        for (uint32_t j = 0; j < filled; j++)
+          StorageUtil::WriteInteger(col_info.EncodedColumn().Unpack(start + j), out_values + j * attr_size, attr_size);
+        break;
+      case ArrowColumnType::DICTIONARY_COMPRESSED: {
+        // Point into the dictionary instead of the block, as the dictionary is what the codes refer to
+        const ArrowVarlenColumn &dictionary = col_info.VarlenColumn();
+        for (uint32_t j = 0; j < filled; j++) {
+          if (!out_bitmap->Test(j)) continue;
+          const uint64_t code = col_info.Indices()[start + j];
+          const byte *word = dictionary.Values() + dictionary.Offsets()[code];
+          const auto size = static_cast<uint32_t>(dictionary.Offsets()[code + 1] - dictionary.Offsets()[code]);
+          const VarlenEntry entry = size <= VarlenEntry::InlineThreshold() ? VarlenEntry::CreateInline(word, size)
+                                                                           : VarlenEntry::Create(word, size, false);
+          std::memcpy(out_values + j * attr_size, &entry, sizeof(VarlenEntry));
+        }
+        break;
+      }
+      default:
+        // Plain and gathered columns are read as they are in the block
+        std::memcpy(out_values, values, filled * attr_size);
+    }
+  }
+  for (uint32_t j = 0; j < filled; j++) out_buffer->TupleSlots()[j] = {block, start + j};
+  out_buffer->SetNumTuples(filled);
+
+  // Skip the rest of the block if it has no tuples left
+  if (start + filled < metadata.NumRecords())
+    start_pos->current_slot_ = {block, start + filled};
+  else
+    SkipBlock(start_pos);
+}
+
+void DataTable::SkipBlock(SlotIterator *const start_pos) const {
+  common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+  RawBlock *const block = start_pos->current_slot_.GetBlock();
+  auto next = std::next(start_pos->block_);
+  if (next != blocks_.end()) {
+    *start_pos = {this, next, 0};
+  } else if (block->GetInsertHead() == accessor_.GetBlockLayout().NumSlots()) {
+    *start_pos = {this, blocks_.end(), 0};
+  } else {
+    // Same as end() while this is the last block
+    start_pos->current_slot_ = {block, block->GetInsertHead()};
+  }
+}
+
+DataTable::SlotIterator DataTable::GetBlockIterator(const uint32_t block_idx) const {
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+    if (block_idx < blocks_.size()) {
+      auto block = blocks_.begin();
+      std::advance(block, block_idx);
+      return {this, block, 0};
+    }
+  }
+  return end();
+}
+
 DataTable::SlotIterator &DataTable::SlotIterator::operator++() {
   common::SpinLatch::ScopedSpinLatch guard(&table_->blocks_latch_);
   // Jump to the next block if already the last slot in the block.
@@ -116,6 +225,10 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
 
+  // Hot tuples grow long version chains between GC runs, so cut off the versions that nobody can see anymore. Every
+  // write prunes, so the first invisible record of a hot tuple is usually right below its new one.
+  PruneVersionChain(undo, txn->OldestActiveTime(), MAX_WRITE_PRUNE_HOPS);
+
   // Update in place with the new value.
   for (uint16_t i = 0; i < redo.NumColumns(); i++) {
     TERRIER_ASSERT(redo.ColumnIds()[i] != VERSION_POINTER_COLUMN_ID,
@@ -123,6 +236,7 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     // TODO(Matt): It would be nice to check that a ProjectedRow that modifies the logical delete column only originated
     // from the DataTable calling Update() within Delete(), rather than an outside soure modifying this column, but
     // that's difficult with this implementation
+    WidenZoneMap(slot.GetBlock(), redo.ColumnIds()[i], redo.AccessWithNullCheck(i));
     StorageUtil::CopyAttrFromProjection(accessor_, slot, redo, i);
   }
   data_table_counter_.IncrementNumUpdate(1);
@@ -206,6 +320,57 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
   return result;
 }
 
+TupleSlot DataTable::InsertBlock(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                 ProjectedColumns *const tuples) {
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  const uint32_t num_tuples = tuples->NumTuples();
+  TERRIER_ASSERT(num_tuples > 0 && num_tuples <= layout.NumSlots(), "Bulk insert must fill between 1 and NumSlots()");
+  TERRIER_ASSERT(tuples->NumColumns() == layout.NumColumns() - NUM_RESERVED_COLUMNS,
+                 "The input buffer never changes the version pointer column, so it should have exactly 1 fewer "
+                 "attribute than the DataTable's layout.");
+
+  // The new block is invisible to everyone else until it is added to blocks_, so it can be filled without any
+  // synchronization. Slots are handed out in order, so the run starts at offset 0.
+  RawBlock *const block = NewBlock();
+  TupleSlot slot;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    const bool UNUSED_ATTRIBUTE allocated = accessor_.Allocate(block, &slot);
+    TERRIER_ASSERT(allocated, "A new block must have room for a full block of tuples");
+  }
+  const TupleSlot first(block, 0);
+
+  // Every version chain in the run starts at the same undo record
+  UndoRecord *const undo = txn->UndoRecordForBulkInsert(this, first, num_tuples);
+  auto *const version_ptrs = reinterpret_cast<UndoRecord **>(accessor_.ColumnStart(block, VERSION_POINTER_COLUMN_ID));
+  std::fill(version_ptrs, version_ptrs + num_tuples, undo);
+  common::RawConcurrentBitmap *const present = accessor_.ColumnNullBitmap(block, VERSION_POINTER_COLUMN_ID);
+  for (uint32_t i = 0; i < num_tuples; i++) present->Flip(i, false);
+
+  // Copy one column at a time. Values are laid out the same way in the block and in the ProjectedColumns.
+  for (uint16_t col = 0; col < tuples->NumColumns(); col++) {
+    const col_id_t col_id = tuples->ColumnIds()[col];
+    TERRIER_ASSERT(col_id != VERSION_POINTER_COLUMN_ID, "Insert buffer should not change the version pointer column.");
+    std::memcpy(accessor_.ColumnStart(block, col_id), tuples->ColumnStart(col), layout.AttrSize(col_id) * num_tuples);
+    common::RawConcurrentBitmap *const bitmap = accessor_.ColumnNullBitmap(block, col_id);
+    bitmap->UnsafeClear(layout.NumSlots());
+    const common::RawBitmap *const nulls = tuples->ColumnNullBitmap(col);
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      if (!nulls->Test(i)) continue;
+      bitmap->Flip(i, false);
+      WidenZoneMap(block, col_id, tuples->ColumnStart(col) + i * layout.AttrSize(col_id));
+    }
+  }
+
+  // Publish the block. Later inserts may use any slots left over.
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+    blocks_.push_back(block);
+  }
+
+  data_table_counter_.IncrementNumInsert(num_tuples);
+  return first;
+}
+
 void DataTable::InsertInto(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo,
                            TupleSlot dest) {
   TERRIER_ASSERT(accessor_.Allocated(dest), "destination slot must already be allocated");
@@ -223,10 +388,18 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
   for (uint16_t i = 0; i < redo.NumColumns(); i++) {
     TERRIER_ASSERT(redo.ColumnIds()[i] != VERSION_POINTER_COLUMN_ID,
                    "Insert buffer should not change the version pointer column.");
+    WidenZoneMap(dest.GetBlock(), redo.ColumnIds()[i], redo.AccessWithNullCheck(i));
     StorageUtil::CopyAttrFromProjection(accessor_, dest, redo, i);
   }
 }
 
+void DataTable::WidenZoneMap(RawBlock *const block, const col_id_t col_id, const byte *const value) const {
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  if (value == nullptr || layout.IsVarlen(col_id)) return;
+  const int64_t integer = StorageUtil::ReadInteger(value, layout.AttrSize(col_id));
+  accessor_.GetArrowBlockMetadata(block).GetZoneMap(layout, col_id).Widen(integer);
+}
+
 bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot) {
   data_table_counter_.IncrementNumDelete(1);
   UndoRecord *const undo = txn->UndoRecordForDelete(this, slot);
@@ -247,6 +420,10 @@ bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
 
+  // Hot tuples grow long version chains between GC runs, so cut off the versions that nobody can see anymore. Every
+  // write prunes, so the first invisible record of a hot tuple is usually right below its new one.
+  PruneVersionChain(undo, txn->OldestActiveTime(), MAX_WRITE_PRUNE_HOPS);
+
   // We have the write lock. Go ahead and flip the logically deleted bit to true
   accessor_.SetNull(slot, VERSION_POINTER_COLUMN_ID);
   return true;
@@ -312,6 +489,7 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
   }
 
   // Apply deltas until we reconstruct a version safe for us to read
+  UndoRecord *last_applied = nullptr;
   while (version_ptr != nullptr &&
          transaction::TransactionUtil::NewerThan(version_ptr->Timestamp().load(), txn->StartTime())) {
     switch (version_ptr->Type()) {
@@ -320,6 +498,7 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
         StorageUtil::ApplyDelta(accessor_.GetBlockLayout(), *(version_ptr->Delta()), out_buffer);
         break;
       case DeltaRecordType::INSERT:
+      case DeltaRecordType::BULK_INSERT:
         visible = false;
         break;
       case DeltaRecordType::DELETE:
@@ -328,9 +507,22 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
       default:
         throw std::runtime_error("unexpected delta record type");
     }
+    last_applied = version_ptr;
     version_ptr = version_ptr->Next();
   }
 
+  // The versions from where we stopped on are no newer than our start time, so they are likely invisible to every
+  // running txn too. Cut those off, so that readers of hot tuples do not have to wait for the GC to do it. Only the
+  // record we stopped at is checked, since we already read it: a reader never walks further than it had to.
+  const transaction::timestamp_t oldest_active_time = txn->OldestActiveTime();
+  if (last_applied != nullptr) {
+    PruneVersionChain(last_applied, oldest_active_time, 1);
+  } else if (version_ptr != nullptr &&
+             transaction::TransactionUtil::NewerThan(oldest_active_time, version_ptr->Timestamp().load())) {
+    // The whole chain is invisible. Writers may be installing a new head, so this has to be a CAS.
+    CompareAndSwapVersionPtr(slot, accessor_, version_ptr, nullptr);
+  }
+
   return visible;
 }
 
@@ -372,8 +564,21 @@ bool DataTable::HasConflict(const transaction::TransactionContext &txn, UndoReco
   return owned_by_other_txn || newer_committed_version;
 }
 
+void DataTable::PruneVersionChain(UndoRecord *const start, const transaction::timestamp_t oldest_active_time,
+                                  const uint32_t max_hops) {
+  // Cut the chain before the first record older than every running txn. The GC and other txns only ever cut chains as
+  // well, so if the pointer changed under us, someone else has already cut at least as much.
+  UndoRecord *curr = start, *next;
+  for (uint32_t hop = 0; hop < max_hops && (next = curr->Next().load()) != nullptr; hop++, curr = next) {
+    if (transaction::TransactionUtil::NewerThan(oldest_active_time, next->Timestamp().load())) {
+      curr->Next().compare_exchange_strong(next, nullptr);
+      return;
+    }
+  }
+}
+
 bool DataTable::CompareAndSwapVersionPtr(const TupleSlot slot, const TupleAccessStrategy &accessor,
-                                         UndoRecord *expected, UndoRecord *const desired) {
+                                         UndoRecord *expected, UndoRecord *const desired) const {
   // Okay to ignore presence bit, because we use that for logical delete, not for validity of the version pointer value
   byte *ptr_location = accessor.AccessWithoutNullCheck(slot, VERSION_POINTER_COLUMN_ID);
   return reinterpret_cast<std::atomic<UndoRecord *> *>(ptr_location)->compare_exchange_strong(expected, desired);
@@ -415,6 +620,7 @@ bool DataTable::IsVisible(const transaction::TransactionContext &txn, const Tupl
         // Normal delta to be applied. Does not modify the logical delete column.
         break;
       case DeltaRecordType::INSERT:
+      case DeltaRecordType::BULK_INSERT:
         visible = false;
         break;
       case DeltaRecordType::DELETE:
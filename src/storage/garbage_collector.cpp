@@ -1,6 +1,8 @@
 #include "storage/garbage_collector.h"
+#include <algorithm>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 #include "common/macros.h"
 #include "loggers/storage_logger.h"
 #include "storage/data_table.h"
@@ -46,12 +48,15 @@ uint32_t GarbageCollector::ProcessDeallocateQueue(transaction::timestamp_t oldes
   if (transaction::TransactionUtil::NewerThan(oldest_txn, last_unlinked_)) {
     // All of the transactions in my deallocation queue were unlinked before the oldest running txn in the system, and
     // have been serialized by the log manager. We are now safe to deallocate these txns because no running
-    // transaction should hold a reference to them anymore
-    for (auto &txn : txns_to_deallocate_) {
-      delete txn;
-      txns_processed++;
-    }
+    // transaction should hold a reference to them anymore. The threads each free a contiguous batch.
+    std::vector<transaction::TransactionContext *> txns(txns_to_deallocate_.begin(), txns_to_deallocate_.end());
     txns_to_deallocate_.clear();
+    const auto num_txns = static_cast<uint32_t>(txns.size());
+    RunOnAllThreads([&](const uint32_t thread) {
+      const uint32_t batch_size = (num_txns + num_threads_ - 1) / num_threads_;
+      for (uint32_t i = thread * batch_size; i < std::min(num_txns, (thread + 1) * batch_size); i++) delete txns[i];
+    });
+    txns_processed = num_txns;
   }
 
   if (gc_metrics_enabled) {
@@ -88,12 +93,10 @@ uint32_t GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_tx
   uint32_t txns_processed = 0;
   // Certain transactions might not be yet safe to gc. Need to requeue them
   transaction::TransactionQueue requeue;
-  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
-  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
-  // wasteful traversals of the version chain.
-  std::unordered_set<TupleSlot> visited_slots;
+  // Transactions that are safe to garbage collect
+  std::vector<transaction::TransactionContext *> unlinkable;
 
-  // Process every transaction in the unlink queue
+  // Sort out every transaction in the unlink queue
   while (!txns_to_unlink_.empty()) {
     txn = txns_to_unlink_.front();
     txns_to_unlink_.pop_front();
@@ -105,24 +108,7 @@ uint32_t GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_tx
       readonly_processed++;
     } else if (transaction::TransactionUtil::NewerThan(oldest_txn, txn->FinishTime())) {
       // Safe to garbage collect.
-      for (auto &undo_record : txn->undo_buffer_) {
-        // It is possible for the table field to be null, for aborted transaction's last conflicting record
-        DataTable *&table = undo_record.Table();
-        // Each version chain needs to be traversed and truncated at most once every GC period. Check
-        // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
-          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-        // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
-        // unless the transaction is aborted, and the record holds a version that is still visible.
-        if (!txn->Aborted()) {
-          ReclaimSlotIfDeleted(&undo_record);
-          ReclaimBufferIfVarlen(txn, &undo_record);
-        }
-        if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
-        buffer_processed++;
-      }
-      txns_to_deallocate_.push_front(txn);
-      txns_processed++;
+      unlinkable.push_back(txn);
     } else {
       // This is a committed txn that is still visible, requeue for next GC run
       requeue.push_front(txn);
@@ -132,6 +118,53 @@ uint32_t GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_tx
   // Requeue any txns that we were still visible to running transactions
   txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
 
+  // Truncate the version chains first. A single pass over the undo records buckets their slots by the thread that owns
+  // their block, and every thread then truncates the chains in its own bucket.
+  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
+  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
+  // wasteful traversals of the version chain.
+  std::unordered_set<TupleSlot> visited_slots;
+  std::vector<std::vector<std::pair<DataTable *, TupleSlot>>> slots_to_truncate(num_threads_);
+  for (transaction::TransactionContext *const unlinked : unlinkable) {
+    for (auto &undo_record : unlinked->undo_buffer_) {
+      // It is possible for the table field to be null, for aborted transaction's last conflicting record
+      DataTable *const table = undo_record.Table();
+      if (table == nullptr) continue;
+      // Each version chain needs to be traversed and truncated at most once every GC period. Check
+      // if we have already visited this tuple slot; if not, proceed to prune the version chain.
+      // A bulk insert record heads the version chains of a whole run of slots.
+      for (uint32_t i = 0; i < undo_record.NumSlots(); i++) {
+        const TupleSlot slot = undo_record.Slot(i);
+        if (visited_slots.insert(slot).second) slots_to_truncate[ThreadOf(slot.GetBlock())].emplace_back(table, slot);
+      }
+    }
+  }
+  RunOnAllThreads([&](const uint32_t thread) {
+    for (const auto &[table, slot] : slots_to_truncate[thread]) TruncateVersionChain(table, slot, oldest_txn);
+  });
+
+  // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
+  // unless the transaction is aborted, and the record holds a version that is still visible. Every thread takes its
+  // own transactions, since they collect the varlens to free.
+  RunOnAllThreads([&](const uint32_t thread) {
+    for (auto i = static_cast<uint32_t>(thread); i < unlinkable.size(); i += num_threads_) {
+      if (unlinkable[i]->Aborted()) continue;
+      for (auto &undo_record : unlinkable[i]->undo_buffer_) {
+        ReclaimSlotIfDeleted(&undo_record);
+        ReclaimBufferIfVarlen(unlinkable[i], &undo_record);
+      }
+    }
+  });
+
+  for (transaction::TransactionContext *const unlinked : unlinkable) {
+    for (auto &undo_record : unlinked->undo_buffer_) {
+      if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
+      buffer_processed++;
+    }
+    txns_to_deallocate_.push_front(unlinked);
+    txns_processed++;
+  }
+
   if (gc_metrics_enabled) {
     // Stop the resource tracker for this operating unit
     common::thread_context.resource_tracker_.Stop();
@@ -171,8 +204,8 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
     return;
   }
 
-  // a version chain is guaranteed to not change when not at the head (assuming single-threaded GC), so we are safe
-  // to traverse and update pointers without CAS
+  // a version chain only ever gets cut when not at the head (readers and writers prune it too, but only ever past
+  // records invisible to everyone), so we are safe to traverse and update pointers without CAS
   UndoRecord *curr = version_ptr;
   UndoRecord *next;
   // Traverse until we find the earliest UndoRecord that can be unlinked.
@@ -204,6 +237,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
   const BlockLayout &layout = accessor.GetBlockLayout();
   switch (undo_record->Type()) {
     case DeltaRecordType::INSERT:
+    case DeltaRecordType::BULK_INSERT:
       return;  // no possibility of outdated varlen to gc
     case DeltaRecordType::DELETE:
       // TODO(Tianyu): Potentially need to be more efficient than linear in column size?
@@ -250,4 +284,18 @@ void GarbageCollector::ProcessIndexes() {
   for (const auto &index : indexes_) index->PerformGarbageCollection();
 }
 
+void GarbageCollector::RunOnAllThreads(const std::function<void(uint32_t)> &task) {
+  if (workers_ == nullptr) {
+    task(0);
+    return;
+  }
+  for (uint32_t thread = 0; thread < num_threads_; thread++) workers_->SubmitTask([=, &task] { task(thread); });
+  workers_->WaitUntilAllFinished();
+}
+
+uint32_t GarbageCollector::ThreadOf(const RawBlock *const block) const {
+  // Blocks are aligned to their size, so the low bits of their addresses carry no information
+  return static_cast<uint32_t>((reinterpret_cast<uintptr_t>(block) / common::Constants::BLOCK_SIZE) % num_threads_);
+}
+
 }  // namespace terrier::storage
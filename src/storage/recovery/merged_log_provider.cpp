@@ -0,0 +1,57 @@
+#include "storage/recovery/merged_log_provider.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace terrier::storage {
+
+MergedLogProvider::MergedLogProvider(std::vector<std::unique_ptr<AbstractLogProvider>> sources) {
+  sources_.resize(sources.size());
+  for (size_t i = 0; i < sources.size(); i++) sources_[i].provider_ = std::move(sources[i]);
+}
+
+void MergedLogProvider::Fill(Source *const source) {
+  while (!source->has_commit_ && !source->exhausted_) {
+    auto record = source->provider_->GetNextRecord();
+    if (record.first == nullptr) {
+      source->exhausted_ = true;
+      break;
+    }
+    source->has_commit_ = record.first->RecordType() == LogRecordType::COMMIT;
+    source->records_.emplace_back(std::move(record));
+  }
+}
+
+bool MergedLogProvider::HasMoreRecords() {
+  for (auto &source : sources_) {
+    Fill(&source);
+    if (!source.records_.empty()) return true;
+  }
+  return false;
+}
+
+std::pair<LogRecord *, std::vector<byte *>> MergedLogProvider::GetNextRecord() {
+  // Pick the stream whose pending commit is the oldest. Once no stream has a commit left, what remains belongs to
+  // transactions that never committed, and can be provided in any order.
+  Source *next = nullptr;
+  for (auto &source : sources_) {
+    Fill(&source);
+    if (source.records_.empty()) continue;
+    if (next == nullptr || (source.has_commit_ && !next->has_commit_)) {
+      next = &source;
+      continue;
+    }
+    if (source.has_commit_ && next->has_commit_ &&
+        source.records_.back().first->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime() <
+            next->records_.back().first->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime())
+      next = &source;
+  }
+  if (next == nullptr) return {nullptr, std::vector<byte *>()};
+
+  auto result = std::move(next->records_.front());
+  next->records_.pop_front();
+  if (next->records_.empty()) next->has_commit_ = false;
+  return result;
+}
+
+}  // namespace terrier::storage
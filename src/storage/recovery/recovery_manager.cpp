@@ -64,6 +64,9 @@ void RecoveryManager::RecoverFromLogs() {
   // Process all deferred txns
   ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
   TERRIER_ASSERT(deferred_txns_.empty(), "We should have no unprocessed deferred transactions at the end of recovery");
+  ReplayBatch();
+  for (auto &table_tuple_slot_map : table_tuple_slot_maps_) tuple_slot_map_.merge(table_tuple_slot_map.second);
+  table_tuple_slot_maps_.clear();
 
   // If we have unprocessed buffered changes, then these transactions were in-process at the time of system shutdown.
   // They are unrecoverable, so we need to clean up the memory of their records.
@@ -76,6 +79,26 @@ void RecoveryManager::RecoverFromLogs() {
 }
 
 void RecoveryManager::ProcessCommittedTransaction(terrier::transaction::timestamp_t txn_id) {
+  auto &buffered_changes = buffered_changes_map_[txn_id];
+  const bool changes_catalog =
+      std::any_of(buffered_changes.cbegin(), buffered_changes.cend(),
+                  [](const std::pair<LogRecord *, std::vector<byte *>> &change) {
+                    return IsCatalogTable(TableOidOf(change.first));
+                  });
+  if (!changes_catalog) {
+    // The txn is replayed with the rest of the batch
+    auto &records = replay_batch_.emplace_back();
+    records.reserve(buffered_changes.size());
+    for (const auto &change : buffered_changes) records.push_back(change.first);
+    replay_batch_records_.insert(replay_batch_records_.end(), buffered_changes.begin(), buffered_changes.end());
+    buffered_changes_map_.erase(txn_id);
+    if (++replay_batch_size_ == REPLAY_BATCH_SIZE) ReplayBatch();
+    return;
+  }
+
+  // Catalog changes may create or drop the tables the batched txns change, so they are replayed in between
+  ReplayBatch();
+
   // Begin a txn to replay changes with.
   auto *txn = txn_manager_->BeginTransaction();
 
@@ -103,6 +126,83 @@ void RecoveryManager::ProcessCommittedTransaction(terrier::transaction::timestam
   txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+void RecoveryManager::ReplayBatch() {
+  if (replay_batch_size_ == 0) return;
+
+  // Group the tables into components such that every txn only changes the tables of one component. Replaying the txns
+  // of a component on one thread in commit order keeps every table's changes in order and every txn in one piece.
+  std::unordered_map<uint64_t, uint64_t> component_of;
+  const auto find = [&](uint64_t table) {
+    while (component_of[table] != table) table = component_of[table] = component_of[component_of[table]];
+    return table;
+  };
+  const auto table_of = [](const LogRecord *record) { return TableKey(DatabaseOidOf(record), TableOidOf(record)); };
+  for (const auto &records : replay_batch_) {
+    for (auto *record : records) {
+      component_of.emplace(table_of(record), table_of(record));
+      // Create the slot map of the table here, so that the replaying threads only ever look it up
+      table_tuple_slot_maps_[table_of(record)];
+    }
+    for (uint32_t idx = 1; idx < records.size(); idx++) {
+      component_of[find(table_of(records[idx]))] = find(table_of(records[0]));
+    }
+  }
+
+  // Hand the components to the threads, largest first, each to the thread with the fewest records to replay so far
+  std::unordered_map<uint64_t, uint64_t> component_size;
+  for (const auto &records : replay_batch_) {
+    if (!records.empty()) component_size[find(table_of(records[0]))] += records.size();
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> components(component_size.begin(), component_size.end());
+  std::sort(components.begin(), components.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.second > rhs.second; });
+  std::unordered_map<uint64_t, uint32_t> thread_of;
+  std::vector<uint64_t> thread_load(num_threads_, 0);
+  for (const auto &component : components) {
+    const auto thread =
+        static_cast<uint32_t>(std::min_element(thread_load.begin(), thread_load.end()) - thread_load.begin());
+    thread_of[component.first] = thread;
+    thread_load[thread] += component.second;
+  }
+  std::vector<std::vector<const std::vector<LogRecord *> *>> thread_txns(num_threads_);
+  for (const auto &records : replay_batch_) {
+    if (records.empty()) continue;
+    thread_txns[thread_of[find(table_of(records[0]))]].push_back(&records);
+  }
+
+  RunOnAllThreads([&](const uint32_t thread) {
+    for (const auto *records : thread_txns[thread]) {
+      // Begin a txn to replay all changes of the logged txn with
+      auto *txn = txn_manager_->BeginTransaction();
+      for (auto *record : *records) {
+        if (record->RecordType() == LogRecordType::REDO) {
+          ReplayRedoRecord(txn, record);
+        } else {
+          ReplayDeleteRecord(txn, record);
+        }
+      }
+      txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+  });
+  replay_batch_.clear();
+
+  // Defer deletes of the log records
+  deferred_action_manager_->RegisterDeferredAction([buffered_changes{std::move(replay_batch_records_)}]() {
+    for (auto &buffered_pair : buffered_changes) delete[] reinterpret_cast<byte *>(buffered_pair.first);
+  });
+  replay_batch_records_.clear();
+  replay_batch_size_ = 0;
+}
+
+void RecoveryManager::RunOnAllThreads(const std::function<void(uint32_t)> &task) {
+  if (workers_ == nullptr) {
+    task(0);
+    return;
+  }
+  for (uint32_t thread = 0; thread < num_threads_; thread++) workers_->SubmitTask([=, &task] { task(thread); });
+  workers_->WaitUntilAllFinished();
+}
+
 void RecoveryManager::DeferRecordDeletes(terrier::transaction::timestamp_t txn_id, bool delete_varlens) {
   // Capture the changes by value except for changes which we can move
   deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes_map_[txn_id])}]() {
@@ -139,6 +239,7 @@ uint32_t RecoveryManager::ProcessDeferredTransactions(terrier::transaction::time
 void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record) {
   auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
   auto sql_table_ptr = GetSqlTable(txn, redo_record->GetDatabaseOid(), redo_record->GetTableOid());
+  auto &tuple_slot_map = TupleSlotMap(redo_record->GetDatabaseOid(), redo_record->GetTableOid());
   if (IsInsertRecord(redo_record)) {
     // Save the old tuple slot, and reset the tuple slot in the record
     auto old_tuple_slot = redo_record->GetTupleSlot();
@@ -156,9 +257,9 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
     TERRIER_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot,
                    "Insert should update redo record with new tuple slot");
     // Create a mapping of the old to new tuple. The new tuple slot should be used for future updates and deletes.
-    tuple_slot_map_[old_tuple_slot] = new_tuple_slot;
+    tuple_slot_map[old_tuple_slot] = new_tuple_slot;
   } else {
-    auto new_tuple_slot = tuple_slot_map_[redo_record->GetTupleSlot()];
+    auto new_tuple_slot = tuple_slot_map[redo_record->GetTupleSlot()];
     redo_record->SetTupleSlot(new_tuple_slot);
     // Stage the write. This way the recovery operation is logged if logging is enabled
     auto staged_record = txn->StageRecoveryWrite(record);
@@ -171,8 +272,12 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
 void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, LogRecord *record) {
   auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
   // Get tuple slot
-  auto new_tuple_slot = GetTupleSlotMapping(delete_record->GetTupleSlot());
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, delete_record->GetDatabaseOid());
+  auto &tuple_slot_map = TupleSlotMap(delete_record->GetDatabaseOid(), delete_record->GetTableOid());
+  TERRIER_ASSERT(tuple_slot_map.find(delete_record->GetTupleSlot()) != tuple_slot_map.end(),
+                 "No tuple slot mapping exists");
+  auto new_tuple_slot = tuple_slot_map[delete_record->GetTupleSlot()];
+  auto db_catalog_ptr =
+      GetDatabaseCatalog(txn, delete_record->GetDatabaseOid(), IsCatalogTable(delete_record->GetTableOid()));
   auto sql_table_ptr = db_catalog_ptr->GetTable(common::ManagedPointer(txn), delete_record->GetTableOid());
   const auto &schema = GetTableSchema(txn, db_catalog_ptr, delete_record->GetTableOid());
 
@@ -197,7 +302,7 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   UpdateIndexesOnTable(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid(), sql_table_ptr,
                        new_tuple_slot, pr, false /* delete */);
   // We can delete the TupleSlot from the map
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  tuple_slot_map.erase(delete_record->GetTupleSlot());
   delete[] buffer;
 }
 
@@ -205,7 +310,7 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
                                            catalog::table_oid_t table_oid,
                                            common::ManagedPointer<storage::SqlTable> table_ptr,
                                            const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
   // Stores index objects and schemas
   std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> index_objects;
@@ -801,7 +906,7 @@ common::ManagedPointer<storage::SqlTable> RecoveryManager::GetSqlTable(transacti
     return common::ManagedPointer(catalog_->databases_);
   }
 
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
   common::ManagedPointer<storage::SqlTable> table_ptr = nullptr;
 
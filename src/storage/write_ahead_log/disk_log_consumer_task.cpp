@@ -17,42 +17,84 @@ void DiskLogConsumerTask::Terminate() {
   TERRIER_ASSERT(run_task_, "Cant terminate a task that isnt running");
   // Signal to terminate and force a flush so task persists before LogManager closes buffers
   run_task_ = false;
-  disk_log_writer_thread_cv_.notify_one();
+  progress_->disk_log_writer_thread_cv_.notify_one();
 }
 
 void DiskLogConsumerTask::WriteBuffersToLogFile() {
   // Persist all the filled buffers to the disk
   SerializedLogs logs;
   while (!filled_buffer_queue_->Empty()) {
-    // Dequeue filled buffers and flush them to disk, as well as storing commit callbacks
-    filled_buffer_queue_->Dequeue(&logs);
-    if (logs.first != nullptr) {
+    // Dequeue all the filled buffers there are, as well as storing commit callbacks
+    while (filled_buffer_queue_->Dequeue(&logs)) {
       // Need the nullptr check because read-only txns don't serialize any buffers, but generate callbacks to be invoked
-      current_data_written_ += logs.first->FlushBuffer();
-    }
-    commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
-    // Enqueue the flushed buffer to the empty buffer queue
-    if (logs.first != nullptr) {
-      // nullptr check for the same reason as above
-      empty_buffer_queue_->Enqueue(logs.first);
+      if (logs.first != nullptr) buffers_to_write_.push_back(logs.first);
+      commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
     }
+    // Flush them to disk with a single write, and enqueue the flushed buffers to the empty buffer queue
+    current_data_written_ += BufferedLogWriter::FlushBuffers(buffers_to_write_);
+    for (BufferedLogWriter *buffer : buffers_to_write_) empty_buffer_queue_->Enqueue(buffer);
+    buffers_to_write_.clear();
   }
 }
 
-uint64_t DiskLogConsumerTask::PersistLogFile() {
-  // buffers_ may be empty but we have callbacks to invoke due to read-only txns
-  if (!buffers_->empty()) {
+uint64_t DiskLogConsumerTask::PersistLogFile(const uint64_t serialized) {
+  // buffers_ may be empty but we have callbacks to invoke due to read-only txns. We skip the sync if nothing was
+  // written since the last one, since the callbacks then only wait for logs that are already persistent.
+  if (!buffers_->empty() && current_data_written_ > 0) {
     // Force the buffers to be written to disk. Because all buffers log to the same file, it suffices to call persist on
     // any buffer.
     buffers_->front().Persist();
   }
+  progress_->persisted_.store(serialized);
+  // The other streams may be waiting on us to invoke their callbacks. We do not take their latches, so a wake up can
+  // get lost, in which case they find out on their next timeout.
+  for (uint32_t stream = 0; stream < streams_progress_->size(); stream++)
+    if (stream != stream_) (*streams_progress_)[stream].disk_log_writer_thread_cv_.notify_one();
+
   const auto num_buffers = commit_callbacks_.size();
-  // Execute the callbacks for the transactions that have been persisted
-  for (auto &callback : commit_callbacks_) callback.first(callback.second);
+  if (num_buffers == 0) return num_buffers;
+  // The transactions that have been persisted may depend on transactions logged to other streams. Every such
+  // transaction handed its logs over before we got them, so we wait for the other streams to persist as many buffers as
+  // they have now.
+  std::vector<uint64_t> added;
+  added.reserve(streams_progress_->size());
+  for (const auto &stream_progress : *streams_progress_) added.push_back(stream_progress.added_.load());
+  // Ask those streams to persist these buffers as soon as they are serialized, rather than on their own interval or
+  // threshold, so that our commits are not held up by them
+  for (uint32_t stream = 0; stream < streams_progress_->size(); stream++) {
+    if (stream == stream_) continue;
+    LogStreamProgress &stream_progress = (*streams_progress_)[stream];
+    uint64_t requested = stream_progress.requested_.load();
+    while (requested < added[stream] && !stream_progress.requested_.compare_exchange_weak(requested, added[stream])) {
+    }
+    if (stream_progress.persisted_.load() < added[stream]) stream_progress.disk_log_writer_thread_cv_.notify_one();
+  }
+  pending_callbacks_.emplace_back(std::move(added), std::move(commit_callbacks_));
   commit_callbacks_.clear();
   return num_buffers;
 }
 
+bool DiskLogConsumerTask::PersistRequested(const uint64_t serialized) const {
+  const uint64_t persisted = progress_->persisted_.load();
+  return progress_->requested_.load() > persisted && serialized > persisted;
+}
+
+bool DiskLogConsumerTask::CanInvokeCallbacks() const {
+  if (pending_callbacks_.empty()) return false;
+  const std::vector<uint64_t> &added = pending_callbacks_.front().first;
+  for (uint32_t stream = 0; stream < streams_progress_->size(); stream++) {
+    if (stream != stream_ && (*streams_progress_)[stream].persisted_.load() < added[stream]) return false;
+  }
+  return true;
+}
+
+void DiskLogConsumerTask::InvokeCallbacks() {
+  // Execute the callbacks for the transactions that have been persisted, along with everything they may depend on
+  for (; CanInvokeCallbacks(); pending_callbacks_.pop_front()) {
+    for (auto &callback : pending_callbacks_.front().second) callback.first(callback.second);
+  }
+}
+
 void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // input for this operating unit
   uint64_t num_bytes = 0, num_buffers = 0;
@@ -80,24 +122,34 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
       // 1) The serializer thread has signalled to persist all non-empty buffers to disk
       // 2) There is a filled buffer to write to the disk
       // 3) LogManager has shut down the task
-      // 4) Our persist interval timed out
-      disk_log_writer_thread_cv_.wait_for(lock, persist_interval_,
-                                          [&] { return do_persist_ || !filled_buffer_queue_->Empty() || !run_task_; });
+      // 4) Other streams have persisted enough for us to invoke commit callbacks
+      // 5) Other streams wait on buffers that have been serialized but not persisted
+      // 6) Our persist interval timed out
+      progress_->disk_log_writer_thread_cv_.wait_for(lock, persist_interval_, [&] {
+        return do_persist_ || !filled_buffer_queue_->Empty() || !run_task_ || CanInvokeCallbacks() ||
+               PersistRequested(progress_->serialized_.load());
+      });
     }
 
+    // Every buffer the serializer has handed over so far is in the filled buffer queue by the time we flush it
+    const uint64_t serialized = progress_->serialized_.load();
     // Flush all the buffers to the log file
     WriteBuffersToLogFile();
 
     // We persist the log file if the following conditions are met
-    // 1) The persist interval amount of time has passed since the last persist
-    // 2) We have written more data since the last persist than the threshold
-    // 3) We are signaled to persist
-    // 4) We are shutting down this task
+    // 1) There are commits waiting on the persist. This is group commit: every commit serialized while the previous
+    //    persist was running waits on this one together, instead of waiting for the persist interval.
+    // 2) Commits on other streams wait on buffers we have written, which extends group commit across streams
+    // 3) The persist interval amount of time has passed since the last persist
+    // 4) We have written more data since the last persist than the threshold
+    // 5) We are signaled to persist
+    // 6) We are shutting down this task
     bool timeout = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -
                                                                          last_persist) > persist_interval_;
-    if (timeout || current_data_written_ > persist_threshold_ || do_persist_ || !run_task_) {
+    if (!commit_callbacks_.empty() || PersistRequested(serialized) || timeout ||
+        current_data_written_ > persist_threshold_ || do_persist_ || !run_task_) {
       std::unique_lock<std::mutex> lock(persist_lock_);
-      num_buffers = PersistLogFile();
+      num_buffers = PersistLogFile(serialized);
       num_bytes = current_data_written_;
       // Reset meta data
       last_persist = std::chrono::high_resolution_clock::now();
@@ -107,6 +159,7 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
       // Signal anyone who forced a persist that the persist has finished
       persist_cv_.notify_all();
     }
+    InvokeCallbacks();
 
     if (logging_metrics_enabled) {
       // Stop the resource tracker for this operating unit
@@ -121,7 +174,14 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     }
   } while (run_task_);
   // Be extra sure we processed everything
+  const uint64_t serialized = progress_->serialized_.load();
   WriteBuffersToLogFile();
-  PersistLogFile();
+  PersistLogFile(serialized);
+  // The other streams persist everything they have left when they stop as well, so we only wait for them to do so
+  std::unique_lock<std::mutex> lock(persist_lock_);
+  while (!pending_callbacks_.empty()) {
+    progress_->disk_log_writer_thread_cv_.wait_for(lock, persist_interval_, [&] { return CanInvokeCallbacks(); });
+    InvokeCallbacks();
+  }
 }
 }  // namespace terrier::storage
@@ -1,5 +1,6 @@
 #include "storage/write_ahead_log/log_io.h"
 #include <algorithm>
+#include <climits>
 namespace terrier::storage {
 void PosixIoWrappers::Close(int fd) {
   while (true) {
@@ -38,6 +39,38 @@ void PosixIoWrappers::WriteFully(int fd, const void *buf, size_t nbyte) {
   }
 }
 
+void PosixIoWrappers::WritevFully(int fd, struct iovec *iov, int iovcnt) {
+  while (iovcnt > 0) {
+    ssize_t ret = writev(fd, iov, std::min(iovcnt, IOV_MAX));
+    if (ret == -1) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Write to log file failed with errno " + std::to_string(errno));
+    }
+    // Skip over the buffers that were written out entirely, and advance into the one written out partially
+    for (; iovcnt > 0 && static_cast<size_t>(ret) >= iov->iov_len; iov++, iovcnt--) ret -= iov->iov_len;
+    if (iovcnt > 0) {
+      iov->iov_base = reinterpret_cast<char *>(iov->iov_base) + ret;
+      iov->iov_len -= ret;
+    }
+  }
+}
+
+uint64_t BufferedLogWriter::FlushBuffers(const std::vector<BufferedLogWriter *> &writers) {
+  if (writers.empty()) return 0;
+  std::vector<struct iovec> iovs;
+  iovs.reserve(writers.size());
+  uint64_t size = 0;
+  for (BufferedLogWriter *writer : writers) {
+    if (writer->buffer_size_ == 0) continue;
+    iovs.push_back({writer->buffer_, writer->buffer_size_});
+    size += writer->buffer_size_;
+    writer->buffer_size_ = 0;
+  }
+  // Every writer appends to the same file, so any of their file descriptors will do
+  PosixIoWrappers::WritevFully(writers.front()->out_, iovs.data(), static_cast<int>(iovs.size()));
+  return size;
+}
+
 bool BufferedLogReader::Read(void *dest, uint32_t size) {
   if (read_head_ + size <= filled_size_) {
     // bytes to read are already buffered.
@@ -1,42 +1,65 @@
 #include "storage/write_ahead_log/log_manager.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
 #include "storage/write_ahead_log/log_serializer_task.h"
 #include "transaction/transaction_context.h"
 
 namespace terrier::storage {
 
+namespace {
+// Spreads the threads over log streams, so that threads running transactions concurrently usually log to different ones
+std::atomic<uint32_t> next_log_stream{0};
+thread_local const uint32_t own_log_stream = next_log_stream++;
+}  // namespace
+
 void LogManager::Start() {
   TERRIER_ASSERT(!run_log_manager_, "Can't call Start on already started LogManager");
-  // Initialize buffers for logging
-  for (size_t i = 0; i < num_buffers_; i++) {
-    buffers_.emplace_back(BufferedLogWriter(log_file_path_.c_str()));
-  }
-  for (size_t i = 0; i < num_buffers_; i++) {
-    empty_buffer_queue_.Enqueue(&buffers_[i]);
+  streams_progress_ = std::vector<LogStreamProgress>(num_streams_);
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    streams_.emplace_back(std::make_unique<LogStream>());
+    LogStream &log_stream = *streams_.back();
+    // Initialize buffers for logging
+    const std::string stream_log_file_path = StreamLogFilePath(log_file_path_, stream);
+    for (size_t i = 0; i < num_buffers_; i++) {
+      log_stream.buffers_.emplace_back(BufferedLogWriter(stream_log_file_path.c_str()));
+    }
+    for (size_t i = 0; i < num_buffers_; i++) {
+      log_stream.empty_buffer_queue_.Enqueue(&log_stream.buffers_[i]);
+    }
   }
 
   run_log_manager_ = true;
 
-  // Register DiskLogConsumerTask
-  disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
-      this /* requester */, persist_interval_, persist_threshold_, &buffers_, &empty_buffer_queue_,
-      &filled_buffer_queue_);
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    LogStream &log_stream = *streams_[stream];
+    // Register DiskLogConsumerTask
+    log_stream.disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
+        this /* requester */, persist_interval_, persist_threshold_, &log_stream.buffers_,
+        &log_stream.empty_buffer_queue_, &log_stream.filled_buffer_queue_, stream, &streams_progress_);
 
-  // Register LogSerializerTask
-  log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
-      this /* requester */, serialization_interval_, buffer_pool_, &empty_buffer_queue_, &filled_buffer_queue_,
-      &disk_log_writer_task_->disk_log_writer_thread_cv_);
+    // Register LogSerializerTask
+    log_stream.log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
+        this /* requester */, serialization_interval_, buffer_pool_, &log_stream.empty_buffer_queue_,
+        &log_stream.filled_buffer_queue_, &streams_progress_[stream]);
+  }
 }
 
 void LogManager::ForceFlush() {
-  // Force the serializer task to serialize buffers
-  log_serializer_task_->Process();
-  // Signal the disk log consumer task thread to persist the buffers to disk
-  std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
-  disk_log_writer_task_->do_persist_ = true;
-  disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
-
-  // Wait for the disk log consumer task thread to persist the logs
-  disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->do_persist_; });
+  // Force the serializer tasks to serialize buffers
+  for (auto &log_stream : streams_) log_stream->log_serializer_task_->Process();
+
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    const auto &disk_log_writer_task = streams_[stream]->disk_log_writer_task_;
+    // Signal the disk log consumer task thread to persist the buffers to disk
+    std::unique_lock<std::mutex> lock(disk_log_writer_task->persist_lock_);
+    disk_log_writer_task->do_persist_ = true;
+    streams_progress_[stream].disk_log_writer_thread_cv_.notify_one();
+
+    // Wait for the disk log consumer task thread to persist the logs
+    disk_log_writer_task->persist_cv_.wait(lock, [&] { return !disk_log_writer_task->do_persist_; });
+  }
 }
 
 void LogManager::PersistAndStop() {
@@ -45,28 +68,37 @@ void LogManager::PersistAndStop() {
 
   // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to the
   // log file, and persisted. The order in which we shut down the tasks is important, we must first serialize, then
-  // shutdown the disk consumer task (reverse order of Start())
-  auto result UNUSED_ATTRIBUTE =
-      thread_registry_->StopTask(this, log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  TERRIER_ASSERT(result, "LogSerializerTask should have been stopped");
-
-  result = thread_registry_->StopTask(this, disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  TERRIER_ASSERT(result, "DiskLogConsumerTask should have been stopped");
-  TERRIER_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
-
-  // Close the buffers corresponding to the log file
-  for (auto buf : buffers_) {
-    buf.Close();
+  // shutdown the disk consumer task (reverse order of Start()). Consumers wait on each other to invoke commit
+  // callbacks, so we only stop them once every serializer is done.
+  for (auto &log_stream : streams_) {
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, log_stream->log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    TERRIER_ASSERT(result, "LogSerializerTask should have been stopped");
   }
-  // Clear buffer queues
-  empty_buffer_queue_.Clear();
-  filled_buffer_queue_.Clear();
-  buffers_.clear();
+
+  for (auto &log_stream : streams_) {
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, log_stream->disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    TERRIER_ASSERT(result, "DiskLogConsumerTask should have been stopped");
+    TERRIER_ASSERT(log_stream->filled_buffer_queue_.Empty(),
+                   "disk log consumer task should have processed all filled buffers\n");
+
+    // Close the buffers corresponding to the log file
+    for (auto buf : log_stream->buffers_) {
+      buf.Close();
+    }
+  }
+  // Clear buffers and their queues
+  streams_.clear();
+  streams_progress_.clear();
 }
 
-void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment) {
+void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment, const uint32_t stream) {
   TERRIER_ASSERT(run_log_manager_, "Must call Start on log manager before handing it buffers");
-  log_serializer_task_->AddBufferToFlushQueue(buffer_segment);
+  TERRIER_ASSERT(stream < num_streams_, "Log stream does not exist");
+  streams_[stream]->log_serializer_task_->AddBufferToFlushQueue(buffer_segment);
 }
 
+uint32_t LogManager::ThreadLogStream() const { return own_log_stream % num_streams_; }
+
 }  // namespace terrier::storage
@@ -42,6 +42,7 @@ bool LogSerializerTask::Process() {
   }
 
   bool buffers_processed = false;
+  uint64_t buffers_taken = 0;
 
   {
     common::SpinLatch::ScopedSpinLatch serialization_guard(&serialization_latch_);
@@ -62,6 +63,7 @@ bool LogSerializerTask::Process() {
 
         temp_flush_queue_ = std::move(flush_queue_);
         flush_queue_ = std::queue<RecordBufferSegment *>();
+        buffers_taken = progress_->added_.load();
       }
 
       // Loop over all the new buffers we found
@@ -86,6 +88,12 @@ bool LogSerializerTask::Process() {
     // Mark the last buffer that was written to as full
     if (filled_buffer_ != nullptr) HandFilledBufferToWriter();
 
+    // Everything we took is handed over to the consumer, which persists it right away if other streams wait on it
+    if (buffers_processed) {
+      progress_->serialized_.store(buffers_taken);
+      progress_->disk_log_writer_thread_cv_.notify_one();
+    }
+
     // Bulk remove all the transactions we serialized. This prevents having to take the TimestampManager's latch once
     // for each timestamp we remove.
     for (const auto &txns : serialized_txns_) {
@@ -124,7 +132,7 @@ void LogSerializerTask::HandFilledBufferToWriter() {
   // Hand over the filled buffer
   filled_buffer_queue_->Enqueue(std::make_pair(filled_buffer_, commits_in_buffer_));
   // Signal disk log consumer task thread that a buffer has been handed over
-  disk_log_writer_thread_cv_->notify_one();
+  progress_->disk_log_writer_thread_cv_.notify_one();
   // Mark that the task doesn't have a buffer in its possession to which it can write to
   commits_in_buffer_.clear();
   filled_buffer_ = nullptr;
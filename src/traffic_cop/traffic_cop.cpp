@@ -4,19 +4,23 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "binder/bind_node_visitor.h"
 #include "catalog/catalog.h"
 #include "catalog/catalog_accessor.h"
 #include "common/exception.h"
+#include "execution/compiler/constant_lifter.h"
 #include "execution/exec/execution_context.h"
 #include "execution/exec/output.h"
 #include "execution/executable_query.h"
+#include "execution/sql/bulk_loader.h"
 #include "execution/sql/ddl_executors.h"
 #include "execution/vm/module.h"
 #include "network/connection_context.h"
 #include "network/postgres/postgres_packet_writer.h"
 #include "optimizer/statistics/stats_storage.h"
+#include "parser/copy_statement.h"
 #include "parser/postgresparser.h"
 #include "planner/plannodes/abstract_plan_node.h"
 #include "traffic_cop/traffic_cop_defs.h"
@@ -227,6 +231,43 @@ void TrafficCop::ExecuteDropStatement(const common::ManagedPointer<network::Conn
   connection_ctx->Transaction()->SetMustAbort();
 }
 
+void TrafficCop::ExecuteCopyStatement(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                      const common::ManagedPointer<network::PostgresPacketWriter> out,
+                                      const common::ManagedPointer<parser::ParseResult> parse_result) const {
+  const auto copy_stmt = parse_result->GetStatement(0).CastManagedPointerTo<parser::CopyStatement>();
+  if (!copy_stmt->IsFrom() || copy_stmt->GetCopyTable() == nullptr) {
+    out->WriteErrorResponse("ERROR:  only COPY table FROM file is supported");
+    connection_ctx->Transaction()->SetMustAbort();
+    return;
+  }
+  if (copy_stmt->GetExternalFileFormat() != parser::ExternalFileFormat::CSV) {
+    out->WriteErrorResponse("ERROR:  COPY only supports the CSV format");
+    connection_ctx->Transaction()->SetMustAbort();
+    return;
+  }
+
+  const auto accessor = connection_ctx->Accessor();
+  const auto table_oid = accessor->GetTableOid(copy_stmt->GetCopyTable()->GetTableName());
+  if (table_oid == catalog::INVALID_TABLE_OID) {
+    out->WriteErrorResponse("ERROR:  relation \"" + copy_stmt->GetCopyTable()->GetTableName() + "\" does not exist");
+    connection_ctx->Transaction()->SetMustAbort();
+    return;
+  }
+
+  try {
+    execution::sql::BulkLoader loader(connection_ctx->Transaction(), accessor, connection_ctx->GetDatabaseOid(),
+                                      table_oid);
+    const uint64_t num_rows = loader.LoadCSV(copy_stmt->GetFilePath(), copy_stmt->GetDelimiter(),
+                                             copy_stmt->GetQuoteChar(), copy_stmt->GetEscapeChar());
+    out->WriteCommandComplete(network::QueryType::QUERY_COPY, static_cast<uint32_t>(num_rows));
+  } catch (const std::exception &e) {
+    // Malformed input, constraint violations and I/O errors all fail the statement
+    out->WriteErrorResponse(std::string("ERROR:  ") + e.what());
+    // Part of the file may already be in the table
+    connection_ctx->Transaction()->SetMustAbort();
+  }
+}
+
 std::unique_ptr<parser::ParseResult> TrafficCop::ParseQuery(
     const std::string &query, const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<network::PostgresPacketWriter> out) const {
@@ -276,7 +317,7 @@ void TrafficCop::ExecuteStatement(const common::ManagedPointer<network::Connecti
     return;
   }
 
-  if (query_type >= network::QueryType::QUERY_RENAME) {
+  if (query_type >= network::QueryType::QUERY_RENAME && query_type != network::QueryType::QUERY_COPY) {
     // We don't yet support query types with values greater than this
     // TODO(Matt): add a TRAFFIC_COP_LOG_INFO here
     out->WriteCommandComplete(query_type, 0);
@@ -290,8 +331,11 @@ void TrafficCop::ExecuteStatement(const common::ManagedPointer<network::Connecti
     BeginTransaction(connection_ctx);
   }
 
-  // Try to bind the parsed statement
-  if (BindStatement(connection_ctx, out, parse_result, query_type)) {
+  if (query_type == network::QueryType::QUERY_COPY) {
+    // COPY reads straight into the table, so there is nothing to bind or optimize
+    ExecuteCopyStatement(connection_ctx, out, parse_result);
+  } else if (BindStatement(connection_ctx, out, parse_result, query_type)) {
+    // Try to bind the parsed statement
     // Binding succeeded, optimize to generate a physical plan and then execute
     auto physical_plan = trafficcop::TrafficCopUtil::Optimize(connection_ctx->Transaction(), connection_ctx->Accessor(),
                                                               parse_result, stats_storage_, optimizer_timeout_);
@@ -306,6 +350,8 @@ void TrafficCop::ExecuteStatement(const common::ManagedPointer<network::Connecti
     } else if (query_type <= network::QueryType::QUERY_DROP_VIEW) {
       ExecuteDropStatement(connection_ctx, out, common::ManagedPointer(physical_plan), query_type,
                            single_statement_txn);
+      // Cached queries on the dropped objects can never run again
+      compiled_query_cache_->Clear();
     }
   }
 
@@ -329,13 +375,40 @@ void TrafficCop::CodegenAndRunPhysicalPlan(const common::ManagedPointer<network:
   auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
       connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), writer, physical_plan->GetOutputSchema().Get(),
       connection_ctx->Accessor());
-
-  auto exec_query = execution::ExecutableQuery(common::ManagedPointer(physical_plan), common::ManagedPointer(exec_ctx));
+  exec_ctx->SetParallelExecution(parallel_execution_);
+  exec_ctx->SetMemoryLimit(query_memory_limit_);
+
+  std::shared_ptr<execution::ExecutableQuery> exec_query;
+  const execution::compiler::ConstantLifter lifter(physical_plan);
+  if (lifter.IsCacheable()) {
+    // Parallel and serial code differ, and DML code maintains the indexes its tables had when it was generated
+    common::hash_t fingerprint =
+        common::HashUtil::CombineHashes(lifter.Fingerprint(), common::HashUtil::Hash(parallel_execution_));
+    std::string key = lifter.Key() + (parallel_execution_ ? "|parallel" : "|serial");
+    for (const auto table_oid : lifter.ModifiedTables()) {
+      for (const auto index_oid : connection_ctx->Accessor()->GetIndexOids(table_oid)) {
+        fingerprint = common::HashUtil::CombineHashes(fingerprint, common::HashUtil::Hash(index_oid));
+        key += "|" + std::to_string(!index_oid);
+      }
+    }
+    exec_query = compiled_query_cache_->Get(fingerprint, key);
+    if (exec_query == nullptr) {
+      exec_query = std::make_shared<execution::ExecutableQuery>(common::ManagedPointer(physical_plan),
+                                                                common::ManagedPointer(exec_ctx), &lifter);
+      if (exec_query->IsCompiled()) {
+        compiled_query_cache_->Put(fingerprint, std::move(key), exec_query, exec_query->GetCodeSizeInBytes());
+      }
+    }
+    exec_ctx->SetParams(std::vector<type::TransientValue>(lifter.Parameters()));
+  } else {
+    exec_query = std::make_shared<execution::ExecutableQuery>(common::ManagedPointer(physical_plan),
+                                                              common::ManagedPointer(exec_ctx));
+  }
 
   if (query_type == network::QueryType::QUERY_SELECT)
     out->WriteRowDescription(physical_plan->GetOutputSchema()->GetColumns());
 
-  exec_query.Run(common::ManagedPointer(exec_ctx), execution::vm::ExecutionMode::Interpret);
+  exec_query->Run(common::ManagedPointer(exec_ctx), execution::vm::ExecutionMode::Interpret);
 
   if (connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK) {
     // Execution didn't set us to FAIL state, go ahead and write command complete
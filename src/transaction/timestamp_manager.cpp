@@ -1,13 +1,49 @@
 #include "transaction/timestamp_manager.h"
 #include <algorithm>
+#include <array>
 #include <vector>
 
 namespace terrier::transaction {
 
+namespace {
+// Spreads the threads over begin slots, so that every thread usually finds its own slot free
+std::atomic<uint32_t> next_begin_slot{0};
+thread_local const uint32_t own_begin_slot = next_begin_slot++;
+}  // namespace
+
+timestamp_t TimestampManager::BeginTransaction() {
+  // There is a three-way race that needs to be prevented. Specifically, we cannot allow both a transaction to commit
+  // and the GC to poll for the oldest running transaction in between this transaction acquiring its begin timestamp
+  // and getting inserted into its shard. So before taking the timestamp, we announce a lower bound of it in a begin
+  // slot, which the GC reads before the shards.
+  const timestamp_t lower_bound = time_.load();
+  BeginSlot *slot = nullptr;
+  for (uint32_t i = own_begin_slot; slot == nullptr; i++) {
+    BeginSlot &candidate = begin_slots_[i % NUM_BEGIN_SLOTS];
+    timestamp_t expected = INVALID_TXN_TIMESTAMP;
+    if (candidate.start_time_.load(std::memory_order_relaxed) == INVALID_TXN_TIMESTAMP &&
+        candidate.start_time_.compare_exchange_strong(expected, lower_bound))
+      slot = &candidate;
+  }
+
+  const timestamp_t start_time = time_++;
+  Shard &shard = ShardOf(start_time);
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    const auto ret UNUSED_ATTRIBUTE = shard.txns_.emplace(start_time);
+    TERRIER_ASSERT(ret.second, "commit start time should be globally unique");
+    if (start_time < shard.oldest_.load()) shard.oldest_.store(start_time);
+  }
+  slot->start_time_.store(INVALID_TXN_TIMESTAMP);
+  return start_time;
+}
+
 timestamp_t TimestampManager::OldestTransactionStartTime() {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-  timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+  // Any txn that takes its start time after we read the time is newer than the result. Every other txn is either
+  // announced in a begin slot, or already in its shard by the time we are done with the slots.
+  timestamp_t result = time_.load();
+  for (const auto &slot : begin_slots_) result = std::min(result, slot.start_time_.load());
+  for (const auto &shard : shards_) result = std::min(result, shard.oldest_.load());
   cached_oldest_txn_start_time_.store(result);  // Cache the timestamp
   return result;
 }
@@ -15,17 +51,38 @@ timestamp_t TimestampManager::OldestTransactionStartTime() {
 timestamp_t TimestampManager::CachedOldestTransactionStartTime() { return cached_oldest_txn_start_time_.load(); }
 
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-  TERRIER_ASSERT(ret == 1, "erased timestamp did not exist");
+  Shard &shard = ShardOf(timestamp);
+  common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+  EraseFromShard(&shard, timestamp);
+  if (timestamp == shard.oldest_.load()) UpdateOldest(&shard);
 }
 
 void TimestampManager::RemoveTransactions(const std::vector<terrier::transaction::timestamp_t> &timestamps) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  for (const auto &timestamp : timestamps) {
-    const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-    TERRIER_ASSERT(ret == 1, "erased timestamp did not exist");
+  // Group the timestamps by shard
+  std::array<std::vector<timestamp_t>, NUM_SHARDS> shard_timestamps;
+  for (const auto &timestamp : timestamps) shard_timestamps[!timestamp % NUM_SHARDS].push_back(timestamp);
+
+  for (uint32_t i = 0; i < NUM_SHARDS; i++) {
+    if (shard_timestamps[i].empty()) continue;
+    Shard &shard = shards_[i];
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    bool removed_oldest = false;
+    for (const auto &timestamp : shard_timestamps[i]) {
+      EraseFromShard(&shard, timestamp);
+      removed_oldest = removed_oldest || timestamp == shard.oldest_.load();
+    }
+    if (removed_oldest) UpdateOldest(&shard);
   }
 }
 
+void TimestampManager::EraseFromShard(Shard *const shard, const timestamp_t timestamp) {
+  const size_t ret UNUSED_ATTRIBUTE = shard->txns_.erase(timestamp);
+  TERRIER_ASSERT(ret == 1, "erased timestamp did not exist");
+}
+
+void TimestampManager::UpdateOldest(Shard *const shard) {
+  const auto &oldest_txn = std::min_element(shard->txns_.cbegin(), shard->txns_.cend());
+  shard->oldest_.store(oldest_txn != shard->txns_.cend() ? *oldest_txn : INVALID_TXN_TIMESTAMP);
+}
+
 }  // namespace terrier::transaction
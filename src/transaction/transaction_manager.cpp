@@ -20,6 +20,9 @@ TransactionContext *TransactionManager::BeginTransaction() {
   if (txn_metrics_enabled) common::thread_context.resource_tracker_.Start();
   start_time = timestamp_manager_->BeginTransaction();
   result = new TransactionContext(start_time, start_time + INT64_MIN, buffer_pool_, log_manager_);
+  // Every txn running alongside this one is either accounted for in the cached value, or started after it was taken
+  result->oldest_active_time_ = timestamp_manager_->CachedOldestTransactionStartTime();
+  if (log_manager_ != DISABLED) result->synchronous_commit_ = log_manager_->SynchronousCommit();
   // Ensure we do not return from this function if there are ongoing write commits
   txn_gate_.Traverse();
 
@@ -35,21 +38,24 @@ TransactionContext *TransactionManager::BeginTransaction() {
 void TransactionManager::LogCommit(TransactionContext *const txn, const timestamp_t commit_time,
                                    const callback_fn commit_callback, void *const commit_callback_arg,
                                    const timestamp_t oldest_active_txn) {
+  // Without synchronous commit, we report the commit right away instead of when the commit record is persisted
+  const bool wait_for_persist = log_manager_ != DISABLED && txn->SynchronousCommit();
   if (log_manager_ != DISABLED) {
     // At this point the commit has already happened for the rest of the system.
     // Here we will manually add a commit record and flush the buffer to ensure the logger
     // sees this record.
     byte *const commit_record = txn->redo_buffer_.NewEntry(storage::CommitRecord::Size());
-    storage::CommitRecord::Initialize(commit_record, txn->StartTime(), commit_time, commit_callback,
-                                      commit_callback_arg, oldest_active_txn, txn->IsReadOnly(), txn,
-                                      timestamp_manager_.Get());
+    const callback_fn persist_callback = wait_for_persist ? commit_callback : TransactionUtil::EmptyCallback;
+    storage::CommitRecord::Initialize(commit_record, txn->StartTime(), commit_time, persist_callback,
+                                      wait_for_persist ? commit_callback_arg : nullptr, oldest_active_txn,
+                                      txn->IsReadOnly(), txn, timestamp_manager_.Get());
   } else {
     // Otherwise, logging is disabled. We should pretend to have serialized and flushed the record so the rest of the
     // system proceeds correctly
     timestamp_manager_->RemoveTransaction(txn->StartTime());
-    commit_callback(commit_callback_arg);
   }
   txn->redo_buffer_.Finalize(true);
+  if (!wait_for_persist) commit_callback(commit_callback_arg);
 }
 
 timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext *const txn) {
@@ -111,7 +117,7 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -188,7 +194,7 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -233,7 +239,7 @@ void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn) {
 }
 
 TransactionQueue TransactionManager::CompletedTransactionsForGC() {
-  common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+  common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
   return std::move(completed_txns_);
 }
 
@@ -244,7 +250,12 @@ void TransactionManager::Rollback(TransactionContext *txn, const storage::UndoRe
     // This UndoRecord was never installed in the version chain, so we can skip it
     return;
   }
-  const storage::TupleSlot slot = record.Slot();
+  // A bulk insert covers a run of slots, each of which has its own version chain
+  for (uint32_t i = 0; i < record.NumSlots(); i++) RollbackSlot(txn, table, record.Slot(i));
+}
+
+void TransactionManager::RollbackSlot(TransactionContext *txn, storage::DataTable *const table,
+                                      const storage::TupleSlot slot) const {
   const storage::TupleAccessStrategy &accessor = table->accessor_;
   storage::UndoRecord *undo_record = table->AtomicallyReadVersionPtr(slot, accessor);
   // In a loop, we will need to undo all updates belonging to this transaction. Because we do not unlink undo records,
@@ -262,8 +273,9 @@ void TransactionManager::Rollback(TransactionContext *txn, const storage::UndoRe
         }
         break;
       case storage::DeltaRecordType::INSERT:
+      case storage::DeltaRecordType::BULK_INSERT:
         // Same as update, need to deallocate possible varlens.
-        DeallocateInsertedTupleIfVarlen(txn, undo_record, accessor);
+        DeallocateInsertedTupleIfVarlen(txn, slot, accessor);
         accessor.SetNull(slot, storage::VERSION_POINTER_COLUMN_ID);
         accessor.Deallocate(slot);
         break;
@@ -291,13 +303,13 @@ void TransactionManager::DeallocateColumnUpdateIfVarlen(TransactionContext *txn,
   }
 }
 
-void TransactionManager::DeallocateInsertedTupleIfVarlen(TransactionContext *txn, storage::UndoRecord *undo,
+void TransactionManager::DeallocateInsertedTupleIfVarlen(TransactionContext *txn, const storage::TupleSlot slot,
                                                          const storage::TupleAccessStrategy &accessor) const {
   const storage::BlockLayout &layout = accessor.GetBlockLayout();
   for (uint16_t i = storage::NUM_RESERVED_COLUMNS; i < layout.NumColumns(); i++) {
     storage::col_id_t col_id(i);
     if (layout.IsVarlen(col_id)) {
-      auto *varlen = reinterpret_cast<storage::VarlenEntry *>(accessor.AccessWithNullCheck(undo->Slot(), col_id));
+      auto *varlen = reinterpret_cast<storage::VarlenEntry *>(accessor.AccessWithNullCheck(slot, col_id));
       if (varlen != nullptr) {
         if (varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
       }
@@ -0,0 +1,69 @@
+#include <functional>
+#include <limits>
+#include <string>
+
+#include "execution/tpl_test.h"
+
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+
+namespace terrier::execution::vm::test {
+
+class AdaptiveExecutionTest : public TplTest {
+ protected:
+  uint32_t Hotness(const Module &module, const std::string &func_name) {
+    return module.hotness_[module.GetFuncInfoByName(func_name)->Id()].load();
+  }
+
+  FunctionTier Tier(const Module &module, const std::string &func_name) {
+    return module.GetFunctionTier(module.GetFuncInfoByName(func_name)->Id());
+  }
+};
+
+constexpr const char *K_SOURCE = R"(
+    fun inc(a: int32) -> int32 { return a + 1 }
+    fun count(n: int32) -> int32 {
+      var c = 0
+      for (var idx = 0; idx < n; idx = idx + 1) {
+        c = inc(c)
+      }
+      return c
+    }
+)";
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveExecutionTest, InterpretDoesNotTrackHotnessTest) {
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(K_SOURCE);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  std::function<int32_t(int32_t)> count;
+  ASSERT_TRUE(module->GetFunction("count", ExecutionMode::Interpret, &count));
+  EXPECT_EQ(1000, count(1000));
+  EXPECT_EQ(0u, Hotness(*module, "count"));
+  EXPECT_EQ(0u, Hotness(*module, "inc"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdaptiveExecutionTest, HotnessTest) {
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(K_SOURCE);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  // Never reach the threshold, so that nothing is compiled
+  module->SetTieringPolicy(std::numeric_limits<uint32_t>::max(), true);
+  std::function<int32_t(int32_t)> count;
+  ASSERT_TRUE(module->GetFunction("count", ExecutionMode::Adaptive, &count));
+  EXPECT_EQ(1000, count(1000));
+
+  // Every call counts, and loop iterations are reported in batches
+  EXPECT_EQ(1000u, Hotness(*module, "inc"));
+  EXPECT_GT(Hotness(*module, "count"), 512u);
+  EXPECT_LE(Hotness(*module, "count"), 1001u);
+
+  EXPECT_EQ(FunctionTier::Interpreted, Tier(*module, "count"));
+  EXPECT_EQ(FunctionTier::Interpreted, Tier(*module, "inc"));
+  EXPECT_EQ(1000, count(1000));
+}
+
+}  // namespace terrier::execution::vm::test
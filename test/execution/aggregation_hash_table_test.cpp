@@ -465,4 +465,305 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   EXPECT_EQ(num_aggs, qstate.row_count_.load(std::memory_order_seq_cst));
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, SpilledParallelAggregationTest) {
+  const uint32_t num_aggs = 10000;
+  const uint32_t num_rows = 100000;
+
+  // Any allocation puts the query over this budget, so every flush spills
+  exec_ctx_->SetMemoryLimit(1);
+
+  auto init_ht = [](void *ctx, void *aht) {
+    auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+    new (aht) AggregationHashTable(exec_ctx->GetMemoryPool(), sizeof(AggTuple));
+  };
+
+  auto destroy_ht = [](void *ctx, void *aht) {
+    reinterpret_cast<AggregationHashTable *>(aht)->~AggregationHashTable();
+  };
+
+  auto build_agg_table = [&](AggregationHashTable *agg_table) {
+    for (uint32_t idx = 0; idx < num_rows; idx++) {
+      InputTuple input(idx % num_aggs, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->InsertPartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+  };
+
+  auto merge = [](void *ctx, AggregationHashTable *table, AggregationOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial_agg = iter->GetPayloadAs<AggTuple>();
+      auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetHash(), AggAggKeyEq, partial_agg));
+      if (existing != nullptr) {
+        existing->Merge(*partial_agg);
+      } else {
+        auto *new_agg = table->Insert(iter->GetHash());
+        new (new_agg) AggTuple(*partial_agg);
+      }
+    }
+  };
+
+  struct QS {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> count_sum_;
+  };
+
+  auto scan = [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+    auto *qs = reinterpret_cast<QS *>(query_state);
+    qs->row_count_ += static_cast<uint32_t>(agg_table->NumElements());
+    for (AggregationHashTableIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+      qs->count_sum_ += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+    }
+  };
+
+  QS qstate{0, 0};
+  ThreadStateContainer container(exec_ctx_->GetMemoryPool());
+
+  // Build thread-local tables
+  container.Reset(sizeof(AggregationHashTable), init_ht, destroy_ht, exec_ctx_.get());
+  auto aggs = {0, 1, 2, 3};
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for_each(aggs.begin(), aggs.end(), [&](UNUSED_ATTRIBUTE auto x) {
+    auto aht = container.AccessThreadStateOfCurrentThreadAs<AggregationHashTable>();
+    build_agg_table(aht);
+  });
+
+  AggregationHashTable main_table(exec_ctx_->GetMemoryPool(), sizeof(AggTuple));
+
+  // Move memory and spill files
+  main_table.TransferMemoryAndPartitions(&container, 0, merge);
+  container.Clear();
+  EXPECT_TRUE(main_table.HasSpilled());
+
+  // Scan
+  main_table.ExecuteParallelPartitionedScan(&qstate, &container, scan);
+
+  // Every group is found once, with all of its rows
+  EXPECT_EQ(num_aggs, qstate.row_count_.load(std::memory_order_seq_cst));
+  EXPECT_EQ(uint64_t{num_rows} * aggs.size(), qstate.count_sum_.load(std::memory_order_seq_cst));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, SpilledSerialAggregationTest) {
+  const uint32_t num_aggs = 10000;
+  const uint32_t num_rows = 100000;
+
+  // Any allocation puts the query over this budget, so the first insertion
+  // switches the table to partitioned mode
+  exec_ctx_->SetMemoryLimit(1);
+
+  auto merge = [](void *ctx, AggregationHashTable *table, AggregationOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial_agg = iter->GetPayloadAs<AggTuple>();
+      auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetHash(), AggAggKeyEq, partial_agg));
+      if (existing != nullptr) {
+        existing->Merge(*partial_agg);
+      } else {
+        auto *new_agg = table->Insert(iter->GetHash());
+        new (new_agg) AggTuple(*partial_agg);
+      }
+    }
+  };
+
+  AggregationHashTable agg_table(exec_ctx_->GetMemoryPool(), sizeof(AggTuple));
+  for (uint32_t idx = 0; idx < num_rows; idx++) {
+    InputTuple input(idx % num_aggs, 1);
+    auto *existing = reinterpret_cast<AggTuple *>(
+        agg_table.Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+    if (existing != nullptr) {
+      existing->Advance(input);
+    } else {
+      auto *new_agg = agg_table.Insert(input.Hash());
+      new (new_agg) AggTuple(input);
+    }
+  }
+  EXPECT_TRUE(agg_table.IsPartitioned());
+
+  // Merge the partitions, which reads the spilled ones back
+  agg_table.BuildAllPartitions(nullptr, merge);
+  EXPECT_TRUE(agg_table.HasSpilled());
+
+  // Every group is found once, with all of its rows
+  uint32_t num_groups = 0;
+  uint64_t count_sum = 0;
+  for (AggregationHashTableIterator iter(agg_table); iter.HasNext(); iter.Next()) {
+    num_groups++;
+    count_sum += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+  }
+  EXPECT_EQ(num_aggs, num_groups);
+  EXPECT_EQ(num_rows, count_sum);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, BypassedParallelAggregationTest) {
+  const uint32_t num_rows = 100000;
+
+  auto init_ht = [](void *ctx, void *aht) {
+    auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+    new (aht) AggregationHashTable(exec_ctx->GetMemoryPool(), sizeof(AggTuple));
+  };
+
+  auto destroy_ht = [](void *ctx, void *aht) {
+    reinterpret_cast<AggregationHashTable *>(aht)->~AggregationHashTable();
+  };
+
+  // Every key is unique within a thread, but each thread sees all of them
+  auto build_agg_table = [&](AggregationHashTable *agg_table) {
+    for (uint32_t idx = 0; idx < num_rows; idx++) {
+      InputTuple input(idx, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->InsertPartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+  };
+
+  auto merge = [](void *ctx, AggregationHashTable *table, AggregationOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial_agg = iter->GetPayloadAs<AggTuple>();
+      auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetHash(), AggAggKeyEq, partial_agg));
+      if (existing != nullptr) {
+        existing->Merge(*partial_agg);
+      } else {
+        auto *new_agg = table->Insert(iter->GetHash());
+        new (new_agg) AggTuple(*partial_agg);
+      }
+    }
+  };
+
+  struct QS {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> count_sum_;
+  };
+
+  auto scan = [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+    auto *qs = reinterpret_cast<QS *>(query_state);
+    qs->row_count_ += static_cast<uint32_t>(agg_table->NumElements());
+    for (AggregationHashTableIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+      qs->count_sum_ += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+    }
+  };
+
+  QS qstate{0, 0};
+  ThreadStateContainer container(exec_ctx_->GetMemoryPool());
+
+  // Build thread-local tables
+  container.Reset(sizeof(AggregationHashTable), init_ht, destroy_ht, exec_ctx_.get());
+  auto aggs = {0, 1, 2, 3};
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for_each(aggs.begin(), aggs.end(), [&](UNUSED_ATTRIBUTE auto x) {
+    auto aht = container.AccessThreadStateOfCurrentThreadAs<AggregationHashTable>();
+    build_agg_table(aht);
+  });
+
+  // No lookup ever found a group, so every table stopped pre-aggregating after filling up once
+  std::vector<AggregationHashTable *> tl_tables;
+  container.CollectThreadLocalStateElementsAs(&tl_tables, 0);
+  for (const auto *table : tl_tables) {
+    EXPECT_TRUE(table->IsBypassing());
+    EXPECT_EQ(0u, table->GetStats()->num_hits_);
+    EXPECT_GT(table->GetStats()->num_bypassed_, 0u);
+  }
+
+  AggregationHashTable main_table(exec_ctx_->GetMemoryPool(), sizeof(AggTuple));
+
+  // Move memory
+  main_table.TransferMemoryAndPartitions(&container, 0, merge);
+  container.Clear();
+
+  // Scan
+  main_table.ExecuteParallelPartitionedScan(&qstate, &container, scan);
+
+  // The partial aggregates of each group are merged
+  EXPECT_EQ(num_rows, qstate.row_count_.load(std::memory_order_seq_cst));
+  EXPECT_EQ(uint64_t{num_rows} * aggs.size(), qstate.count_sum_.load(std::memory_order_seq_cst));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, NoBypassWithRepeatedKeysTest) {
+  // Many groups in total, so the table fills up and flushes, but each one repeats twenty times before the next ones
+  AggregationHashTable agg_table(Memory(), sizeof(AggTuple));
+  for (uint32_t idx = 0; idx < 2000000; idx++) {
+    InputTuple input(idx % 100 + (idx / 2000) * 100, 1);
+    auto *existing = reinterpret_cast<AggTuple *>(
+        agg_table.Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+    if (existing != nullptr) {
+      existing->Advance(input);
+    } else {
+      auto *new_agg = agg_table.InsertPartitioned(input.Hash());
+      new (new_agg) AggTuple(input);
+    }
+  }
+  EXPECT_GT(agg_table.GetStats()->num_flushes_, 0u);
+  EXPECT_FALSE(agg_table.IsBypassing());
+  EXPECT_EQ(0u, agg_table.GetStats()->num_bypassed_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, BypassRevertsWithRepeatedKeysTest) {
+  const uint32_t num_unique = 200000;
+  const uint32_t num_repeated = 200000;
+
+  AggregationHashTable agg_table(Memory(), sizeof(AggTuple));
+  auto insert = [&](uint64_t key) {
+    InputTuple input(key, 1);
+    auto *existing = reinterpret_cast<AggTuple *>(
+        agg_table.Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+    if (existing != nullptr) {
+      existing->Advance(input);
+    } else {
+      auto *new_agg = agg_table.InsertPartitioned(input.Hash());
+      new (new_agg) AggTuple(input);
+    }
+  };
+
+  // Unique keys: lookups never find a group, so the table passes tuples through
+  for (uint32_t idx = 0; idx < num_unique; idx++) {
+    insert(idx);
+  }
+  EXPECT_TRUE(agg_table.IsBypassing());
+  EXPECT_EQ(0u, agg_table.GetStats()->num_hits_);
+
+  // Ten keys over and over: the next window sees few distinct hashes, so the table pre-aggregates again
+  for (uint32_t idx = 0; idx < num_repeated; idx++) {
+    insert(idx % 10);
+  }
+  EXPECT_FALSE(agg_table.IsBypassing());
+  EXPECT_GT(agg_table.GetStats()->num_hits_, 0u);
+
+  // The partial aggregates from both modes are merged
+  auto merge = [](void *ctx, AggregationHashTable *table, AggregationOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial_agg = iter->GetPayloadAs<AggTuple>();
+      auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetHash(), AggAggKeyEq, partial_agg));
+      if (existing != nullptr) {
+        existing->Merge(*partial_agg);
+      } else {
+        auto *new_agg = table->Insert(iter->GetHash());
+        new (new_agg) AggTuple(*partial_agg);
+      }
+    }
+  };
+  agg_table.BuildAllPartitions(nullptr, merge);
+
+  uint32_t num_groups = 0;
+  uint64_t count_sum = 0;
+  for (AggregationHashTableIterator iter(agg_table); iter.HasNext(); iter.Next()) {
+    num_groups++;
+    count_sum += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+  }
+  EXPECT_EQ(num_unique, num_groups);
+  EXPECT_EQ(uint64_t{num_unique} + num_repeated, count_sum);
+}
+
 }  // namespace terrier::execution::sql::test
@@ -0,0 +1,151 @@
+#include "execution/sql/bulk_loader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_accessor.h"
+#include "main/db_main.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+#include "type/transient_value_factory.h"
+
+namespace terrier::execution::sql::test {
+
+class BulkLoaderTests : public TerrierTest {
+ public:
+  void SetUp() override {
+    db_main_ = terrier::DBMain::Builder().SetUseGC(true).SetUseCatalog(true).Build();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+
+    // CREATE TABLE test_table (id INTEGER NOT NULL, name VARCHAR(20)) with a unique index on id
+    auto *txn = txn_manager_->BeginTransaction();
+    db_ = catalog_->GetDatabaseOid(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE);
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_);
+    std::vector<catalog::Schema::Column> cols;
+    cols.emplace_back("id", type::TypeId::INTEGER, false,
+                      parser::ConstantValueExpression(type::TransientValueFactory::GetNull(type::TypeId::INTEGER)));
+    cols.emplace_back("name", type::TypeId::VARCHAR, 20, true,
+                      parser::ConstantValueExpression(type::TransientValueFactory::GetNull(type::TypeId::VARCHAR)));
+    table_oid_ = accessor->CreateTable(accessor->GetDefaultNamespace(), "test_table", catalog::Schema(cols));
+    const auto &schema = accessor->GetSchema(table_oid_);
+    accessor->SetTablePointer(table_oid_,
+                              new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), schema));
+
+    std::vector<catalog::IndexSchema::Column> key_cols{catalog::IndexSchema::Column{
+        "id", type::TypeId::INTEGER, false,
+        parser::ColumnValueExpression(db_, table_oid_, schema.GetColumn("id").Oid())}};
+    const catalog::IndexSchema index_schema(key_cols, storage::index::IndexType::BWTREE, true, true, false, true);
+    const auto index_oid = accessor->CreateIndex(accessor->GetDefaultNamespace(), table_oid_, "test_index", index_schema);
+    storage::index::IndexBuilder index_builder;
+    index_builder.SetKeySchema(accessor->GetIndexSchema(index_oid));
+    accessor->SetIndexPointer(index_oid, index_builder.Build());
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+
+  void TearDown() override {
+    std::remove(FILE_NAME);
+    TerrierTest::TearDown();
+  }
+
+  // Overwrite the test file with the given contents
+  static void WriteFile(const std::string &contents) {
+    std::ofstream out(FILE_NAME, std::ios::binary | std::ios::trunc);
+    out << contents;
+  }
+
+  // Load the test file in a new transaction, which commits if the load succeeds and aborts otherwise
+  bool Load() {
+    auto *txn = txn_manager_->BeginTransaction();
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_);
+    try {
+      BulkLoader loader{common::ManagedPointer(txn), common::ManagedPointer(accessor), db_, table_oid_};
+      loader.LoadCSV(FILE_NAME, ',', '"', '"');
+    } catch (const std::exception &) {
+      txn_manager_->Abort(txn);
+      return false;
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return true;
+  }
+
+  // Count the visible rows of the test table
+  uint32_t CountRows() {
+    auto *txn = txn_manager_->BeginTransaction();
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_);
+    const auto table = accessor->GetTable(table_oid_);
+    const auto initializer = table->InitializerForProjectedRow({accessor->GetSchema(table_oid_).GetColumn("id").Oid()});
+    auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *row = initializer.InitializeRow(buffer);
+    uint32_t num_rows = 0;
+    for (auto it = table->begin(); it != table->end(); it++) {
+      if (table->Select(common::ManagedPointer(txn), *it, row)) num_rows++;
+    }
+    delete[] buffer;
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return num_rows;
+  }
+
+  static constexpr const char *FILE_NAME = "bulk_loader_test.csv";
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<catalog::Catalog> catalog_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  catalog::db_oid_t db_;
+  catalog::table_oid_t table_oid_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(BulkLoaderTests, LoadTest) {
+  constexpr uint32_t num_rows = 10000;
+  std::string contents;
+  for (uint32_t i = 0; i < num_rows; i++) {
+    // Every third name is NULL, and some are too long to be inlined
+    contents += std::to_string(i) + "," + (i % 3 == 0 ? "" : "name_of_row_" + std::to_string(i)) + "\n";
+  }
+  WriteFile(contents);
+  ASSERT_TRUE(Load());
+  EXPECT_EQ(num_rows, CountRows());
+
+  // The index was built from the loaded rows
+  auto *txn = txn_manager_->BeginTransaction();
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_);
+  const auto [index, index_schema] = accessor->GetIndexes(table_oid_)[0];
+  auto *buffer = common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+  auto *key = index->GetProjectedRowInitializer().InitializeRow(buffer);
+  *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = 4242;
+  std::vector<storage::TupleSlot> results;
+  index->ScanKey(*txn, *key, &results);
+  EXPECT_EQ(1u, results.size());
+  delete[] buffer;
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(BulkLoaderTests, DuplicateKeyTest) {
+  WriteFile("1,a\n2,b\n1,c\n");
+  EXPECT_FALSE(Load());
+  EXPECT_EQ(0u, CountRows());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BulkLoaderTests, BadRowTest) {
+  // NULL in a NOT NULL column
+  WriteFile("1,a\n,b\n");
+  EXPECT_FALSE(Load());
+  // Too many fields
+  WriteFile("1,a,extra\n");
+  EXPECT_FALSE(Load());
+  EXPECT_EQ(0u, CountRows());
+}
+
+}  // namespace terrier::execution::sql::test
@@ -0,0 +1,180 @@
+#include "execution/compiled_query_cache.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/compiler/constant_lifter.h"
+#include "execution/compiler/expression_util.h"
+#include "execution/compiler/output_checker.h"
+#include "execution/compiler/output_schema_util.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/output.h"
+#include "execution/executable_query.h"
+#include "execution/sql_test.h"  // NOLINT
+#include "execution/vm/module.h"
+#include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "type/transient_value_factory.h"
+
+namespace terrier::execution::compiler::test {
+
+class CompiledQueryCacheTest : public SqlBasedTest {
+ public:
+  void SetUp() override {
+    SqlBasedTest::SetUp();
+    // Make the test tables
+    auto exec_ctx = MakeExecCtx();
+    sql::TableGenerator table_generator{exec_ctx.get(), BlockStore(), NSOid()};
+    table_generator.GenerateTestTables(false);
+  }
+
+  // SELECT colA FROM test_1 WHERE colA < bound, or colA <= bound
+  std::unique_ptr<planner::AbstractPlanNode> MakeSeqScan(ExpressionMaker *expr_maker, int32_t bound,
+                                                         bool inclusive = false) {
+    auto accessor = MakeAccessor();
+    auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+    auto cola_oid = accessor->GetSchema(table_oid).GetColumn("colA").Oid();
+    auto col1 = expr_maker->CVE(cola_oid, type::TypeId::INTEGER);
+    OutputSchemaHelper seq_scan_out{0, expr_maker};
+    seq_scan_out.AddOutput("col1", col1);
+    auto predicate = inclusive ? expr_maker->ComparisonLe(col1, expr_maker->Constant(bound))
+                               : expr_maker->ComparisonLt(col1, expr_maker->Constant(bound));
+    planner::SeqScanPlanNode::Builder builder;
+    return builder.SetOutputSchema(seq_scan_out.MakeSchema())
+        .SetColumnOids({cola_oid})
+        .SetScanPredicate(predicate)
+        .SetIsForUpdateFlag(false)
+        .SetNamespaceOid(NSOid())
+        .SetTableOid(table_oid)
+        .Build();
+  }
+
+  // Run the query with the lifted constants of the given plan, and check the number of output rows. Returns the
+  // number of blocks the scan skipped.
+  uint64_t RunAndCheck(ExecutableQuery *query, const planner::AbstractPlanNode &plan, const ConstantLifter &lifter,
+                       int64_t expected_rows) {
+    NumChecker num_checker{expected_rows};
+    OutputStore store{&num_checker, plan.GetOutputSchema().Get()};
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), plan.GetOutputSchema().Get());
+    exec_ctx->SetParams(std::vector<type::TransientValue>(lifter.Parameters()));
+    query->Run(common::ManagedPointer(exec_ctx), vm::ExecutionMode::Interpret);
+    num_checker.CheckCorrectness();
+    return exec_ctx->SkippedBlocks();
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(CompiledQueryCacheTest, FingerprintTest) {
+  ExpressionMaker expr_maker;
+  auto plan_500 = MakeSeqScan(&expr_maker, 500);
+  auto plan_100 = MakeSeqScan(&expr_maker, 100);
+  auto plan_le = MakeSeqScan(&expr_maker, 500, true);
+  ConstantLifter lifter_500{common::ManagedPointer(plan_500)};
+  ConstantLifter lifter_100{common::ManagedPointer(plan_100)};
+  ConstantLifter lifter_le{common::ManagedPointer(plan_le)};
+
+  // Plans that only differ in their constants share a fingerprint
+  ASSERT_TRUE(lifter_500.IsCacheable());
+  ASSERT_TRUE(lifter_100.IsCacheable());
+  EXPECT_EQ(lifter_500.Fingerprint(), lifter_100.Fingerprint());
+  EXPECT_NE(lifter_500.Fingerprint(), lifter_le.Fingerprint());
+  EXPECT_EQ(lifter_500.Key(), lifter_100.Key());
+  EXPECT_NE(lifter_500.Key(), lifter_le.Key());
+  ASSERT_EQ(1, lifter_500.Parameters().size());
+  EXPECT_EQ(type::TransientValueFactory::GetInteger(500), lifter_500.Parameters()[0]);
+  EXPECT_EQ(type::TransientValueFactory::GetInteger(100), lifter_100.Parameters()[0]);
+
+  // Fingerprinting leaves the plan as it was
+  EXPECT_EQ(MakeSeqScan(&expr_maker, 500)->Hash(), plan_500->Hash());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompiledQueryCacheTest, ReuseTest) {
+  ExpressionMaker expr_maker;
+  auto plan_500 = MakeSeqScan(&expr_maker, 500);
+  auto plan_100 = MakeSeqScan(&expr_maker, 100);
+  ConstantLifter lifter_500{common::ManagedPointer(plan_500)};
+  ConstantLifter lifter_100{common::ManagedPointer(plan_100)};
+
+  // Code generated for one plan runs the other with its own constants
+  auto exec_ctx = MakeExecCtx(nullptr, plan_500->GetOutputSchema().Get());
+  auto query = std::make_shared<ExecutableQuery>(common::ManagedPointer(plan_500), common::ManagedPointer(exec_ctx),
+                                                 &lifter_500);
+  ASSERT_TRUE(query->IsCompiled());
+  RunAndCheck(query.get(), *plan_500, lifter_500, 500);
+  RunAndCheck(query.get(), *plan_100, lifter_100, 100);
+
+  CompiledQueryCache cache(query->GetCodeSizeInBytes());
+  cache.Put(lifter_500.Fingerprint(), lifter_500.Key(), query, query->GetCodeSizeInBytes());
+  EXPECT_EQ(query, cache.Get(lifter_100.Fingerprint(), lifter_100.Key()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompiledQueryCacheTest, ZoneMapReuseTest) {
+  // The zone maps of test_1 rule out colA < 0 in every block, and no block for colA < 500
+  ExpressionMaker expr_maker;
+  auto plan_0 = MakeSeqScan(&expr_maker, 0);
+  auto plan_500 = MakeSeqScan(&expr_maker, 500);
+  ConstantLifter lifter_0{common::ManagedPointer(plan_0)};
+  ConstantLifter lifter_500{common::ManagedPointer(plan_500)};
+  ASSERT_EQ(lifter_0.Fingerprint(), lifter_500.Fingerprint());
+  auto accessor = MakeAccessor();
+  const uint32_t num_blocks = accessor->GetTable(accessor->GetTableOid(NSOid(), "test_1"))->GetNumBlocks();
+  ASSERT_GT(num_blocks, 0);
+
+  // Code generated for one constant skips blocks by the constant each run is given, not the one it was generated for
+  auto exec_ctx = MakeExecCtx(nullptr, plan_0->GetOutputSchema().Get());
+  auto query = std::make_shared<ExecutableQuery>(common::ManagedPointer(plan_0), common::ManagedPointer(exec_ctx),
+                                                 &lifter_0);
+  ASSERT_TRUE(query->IsCompiled());
+  EXPECT_EQ(num_blocks, RunAndCheck(query.get(), *plan_0, lifter_0, 0));
+  EXPECT_EQ(0, RunAndCheck(query.get(), *plan_500, lifter_500, 500));
+  EXPECT_EQ(num_blocks, RunAndCheck(query.get(), *plan_0, lifter_0, 0));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompiledQueryCacheTest, EvictionTest) {
+  ExpressionMaker expr_maker;
+  auto plan = MakeSeqScan(&expr_maker, 500);
+  auto exec_ctx = MakeExecCtx(nullptr, plan->GetOutputSchema().Get());
+  std::vector<std::shared_ptr<ExecutableQuery>> queries;
+  for (uint32_t i = 0; i < 3; i++) {
+    queries.emplace_back(
+        std::make_shared<ExecutableQuery>(common::ManagedPointer(plan), common::ManagedPointer(exec_ctx)));
+  }
+  const uint64_t size = queries[0]->GetCodeSizeInBytes();
+
+  // Room for two queries
+  CompiledQueryCache cache(2 * size);
+  cache.Put(0, "0", queries[0], size);
+  cache.Put(1, "1", queries[1], size);
+  EXPECT_EQ(queries[0], cache.Get(0, "0"));
+  // Query 1 is now the least recently used one
+  cache.Put(2, "2", queries[2], size);
+  EXPECT_EQ(2, cache.NumEntries());
+  EXPECT_EQ(nullptr, cache.Get(1, "1"));
+  EXPECT_EQ(queries[0], cache.Get(0, "0"));
+  EXPECT_EQ(queries[2], cache.Get(2, "2"));
+
+  // Shrinking evicts, and a query larger than the cache is never added
+  cache.SetCapacity(size);
+  EXPECT_EQ(1, cache.NumEntries());
+  EXPECT_EQ(queries[2], cache.Get(2, "2"));
+  cache.Put(1, "1", queries[1], size + 1);
+  EXPECT_EQ(nullptr, cache.Get(1, "1"));
+
+  // A plan whose fingerprint collides with a cached one misses, and replaces it when added
+  EXPECT_EQ(nullptr, cache.Get(2, "collision"));
+  cache.Put(2, "collision", queries[1], size);
+  EXPECT_EQ(queries[1], cache.Get(2, "collision"));
+  EXPECT_EQ(nullptr, cache.Get(2, "2"));
+  EXPECT_EQ(1, cache.NumEntries());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.NumEntries());
+  EXPECT_EQ(0, cache.Size());
+}
+
+}  // namespace terrier::execution::compiler::test
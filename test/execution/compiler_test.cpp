@@ -1,6 +1,10 @@
+#include <cstdio>
+#include <fstream>
 #include <functional>
 #include <limits>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -14,8 +18,10 @@
 #include "execution/exec/execution_context.h"
 #include "execution/exec/output.h"
 #include "execution/executable_query.h"
+#include "execution/frozen_table_util.h"
 #include "execution/execution_util.h"
 #include "execution/sema/sema.h"
+#include "execution/sql/csv_reader.h"
 #include "execution/sql/value.h"
 #include "execution/sql_test.h"  // NOLINT
 #include "execution/vm/bytecode_generator.h"
@@ -23,18 +29,22 @@
 #include "execution/vm/llvm_engine.h"
 #include "execution/vm/module.h"
 #include "planner/plannodes/aggregate_plan_node.h"
+#include "planner/plannodes/csv_scan_plan_node.h"
 #include "planner/plannodes/delete_plan_node.h"
 #include "planner/plannodes/hash_join_plan_node.h"
 #include "planner/plannodes/index_join_plan_node.h"
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
+#include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "type/transient_value.h"
 #include "type/transient_value_factory.h"
 #include "type/type_id.h"
@@ -65,6 +75,42 @@ class CompilerTest : public SqlBasedTest {
     return set_a == set_b;
   }
 
+  // SELECT colA, colB FROM test_1 WHERE colA < col_a_bound
+  std::unique_ptr<planner::AbstractPlanNode> MakeTest1Scan(ExpressionMaker *expr_maker, OutputSchemaHelper *scan_out,
+                                                           int32_t col_a_bound) {
+    auto accessor = MakeAccessor();
+    auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+    auto table_schema = accessor->GetSchema(table_oid);
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto colb_oid = table_schema.GetColumn("colB").Oid();
+    auto col1 = expr_maker->CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker->CVE(colb_oid, type::TypeId::INTEGER);
+    scan_out->AddOutput("col1", col1);
+    scan_out->AddOutput("col2", col2);
+    auto predicate = expr_maker->ComparisonLt(col1, expr_maker->Constant(col_a_bound));
+    planner::SeqScanPlanNode::Builder builder;
+    return builder.SetOutputSchema(scan_out->MakeSchema())
+        .SetColumnOids({cola_oid, colb_oid})
+        .SetScanPredicate(predicate)
+        .SetIsForUpdateFlag(false)
+        .SetNamespaceOid(NSOid())
+        .SetTableOid(table_oid)
+        .Build();
+  }
+
+  // Compiles the plan with parallel execution enabled, so that every pipeline that can be parallel runs its scan over
+  // morsels in worker threads and merges their thread states, and runs it
+  void RunParallel(common::ManagedPointer<planner::AbstractPlanNode> plan, OutputChecker *checker) {
+    OutputStore store{checker, plan->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(plan->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), plan->GetOutputSchema().Get());
+    exec_ctx->SetParallelExecution(true);
+    auto executable = ExecutableQuery(plan, common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    checker->CheckCorrectness();
+  }
+
   static constexpr vm::ExecutionMode MODE = vm::ExecutionMode::Interpret;
 };
 
@@ -296,6 +342,86 @@ TEST_F(CompilerTest, SimpleSeqScanWithParamsTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, FrozenSeqScanTest) {
+  // SELECT col_a FROM frozen_table WHERE col_b < 150 AND 'cherry' = col_c AND col_a + col_b >= 1000
+  // The blocks of the table are frozen, and its columns compressed. The first two comparisons run as vectorized
+  // filters on the compressed columns, and the last one is checked a tuple at a time.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->CreateTable(NSOid(), "frozen_table", FrozenTableUtil::Schema(DummyCVE()));
+  auto table_schema = accessor->GetSchema(table_oid);
+  auto *sql_table = new storage::SqlTable(BlockStore(), table_schema);
+  accessor->SetTablePointer(table_oid, sql_table);
+  const uint32_t num_tuples = FrozenTableUtil::Populate(sql_table, table_schema, 2);
+
+  ExpressionMaker expr_maker;
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("col_a").Oid();
+    auto colb_oid = table_schema.GetColumn("col_b").Oid();
+    auto colc_oid = table_schema.GetColumn("col_c").Oid();
+    // Get Table columns
+    auto col_a = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col_b = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    auto col_c = expr_maker.CVE(colc_oid, type::TypeId::VARCHAR);
+    seq_scan_out.AddOutput("col_a", common::ManagedPointer(col_a));
+    auto schema = seq_scan_out.MakeSchema();
+    // Make predicate
+    auto cherry = expr_maker.MakeManaged(
+        std::make_unique<parser::ConstantValueExpression>(type::TransientValueFactory::GetVarChar("cherry")));
+    auto comp1 = expr_maker.ComparisonLt(col_b, expr_maker.Constant(150));
+    auto comp2 = expr_maker.ComparisonEq(cherry, col_c);
+    auto comp3 = expr_maker.ComparisonGe(expr_maker.OpSum(col_a, col_b), expr_maker.Constant(1000));
+    auto predicate = expr_maker.ConjunctionAnd(expr_maker.ConjunctionAnd(comp1, comp2), comp3);
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid, colb_oid, colc_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+
+  const auto selected = [](uint32_t i) {
+    const auto col_b = FrozenTableUtil::ColB(i);
+    const auto col_c = FrozenTableUtil::ColC(i);
+    return col_b.has_value() && *col_b < 150 && col_c.has_value() && *col_c == "cherry" &&
+           static_cast<int64_t>(i) + *col_b >= 1000;
+  };
+  int64_t num_expected = 0;
+  for (uint32_t i = 0; i < num_tuples; i++) num_expected += selected(i) ? 1 : 0;
+  ASSERT_GT(num_expected, 0);
+
+  // Scan the frozen blocks in place, and through the transactional path
+  for (const bool in_place : {true, false}) {
+    // Make the output checkers
+    NumChecker num_checker{num_expected};
+    GenericChecker row_checker(
+        [&](const std::vector<sql::Val *> &vals) {
+          auto col_a = static_cast<sql::Integer *>(vals[0]);
+          ASSERT_FALSE(col_a->is_null_);
+          EXPECT_TRUE(selected(static_cast<uint32_t>(col_a->val_)));
+        },
+        nullptr);
+    MultiChecker multi_checker{std::vector<OutputChecker *>{&num_checker, &row_checker}};
+
+    // Create the execution context
+    OutputStore store{&multi_checker, seq_scan->GetOutputSchema().Get()};
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), seq_scan->GetOutputSchema().Get());
+    exec_ctx->SetInPlaceReads(in_place);
+
+    // Run & Check
+    auto executable = ExecutableQuery(common::ManagedPointer(seq_scan), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    multi_checker.CheckCorrectness();
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleIndexScanTest) {
   // SELECT colA, colB FROM test_1 WHERE colA = 500;
@@ -1559,6 +1685,261 @@ TEST_F(CompilerTest, MultiWayHashJoinTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec2, exp_vec2));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleMergeJoinTest) {
+  // SELECT t1.col1, t2.col1, t2.col2, t1.col1 + t2.col2 FROM t1 INNER JOIN t2 ON t1.col1=t2.col1
+  // WHERE t1.col1 < 500 AND t2.col1 < 80
+  // The right side is ordered on its join key by an ORDER BY.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema1.GetColumn("colA").Oid();
+    auto colb_oid = table_schema1.GetColumn("colB").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out1.AddOutput("col1", col1);
+    seq_scan_out1.AddOutput("col2", col2);
+    auto schema = seq_scan_out1.MakeSchema();
+    // Make predicate
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(500));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid, colb_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid1)
+                    .Build();
+  }
+  // Make the second seq scan
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+  OutputSchemaHelper seq_scan_out2{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema2.GetColumn("col1").Oid();
+    auto colb_oid = table_schema2.GetColumn("col2").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::SMALLINT);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out2.AddOutput("col1", col1);
+    seq_scan_out2.AddOutput("col2", col2);
+    auto schema = seq_scan_out2.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(80));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan2 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid, colb_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid2)
+                    .Build();
+  }
+  // Order the second seq scan on its join key
+  std::unique_ptr<planner::AbstractPlanNode> order_by;
+  OutputSchemaHelper order_by_out{1, &expr_maker};
+  {
+    auto col1 = seq_scan_out2.GetOutput("col1");
+    auto col2 = seq_scan_out2.GetOutput("col2");
+    order_by_out.AddOutput("col1", col1);
+    order_by_out.AddOutput("col2", col2);
+    auto schema = order_by_out.MakeSchema();
+    // Build
+    planner::OrderByPlanNode::Builder builder;
+    order_by = builder.SetOutputSchema(std::move(schema))
+                   .AddChild(std::move(seq_scan2))
+                   .AddSortKey(col1, optimizer::OrderByOrderingType::ASC)
+                   .Build();
+  }
+  // Make merge join
+  std::unique_ptr<planner::AbstractPlanNode> merge_join;
+  OutputSchemaHelper merge_join_out{0, &expr_maker};
+  {
+    // t1.col1
+    auto t1_col1 = seq_scan_out1.GetOutput("col1");
+    // t2.col1 and t2.col2
+    auto t2_col1 = order_by_out.GetOutput("col1");
+    auto t2_col2 = order_by_out.GetOutput("col2");
+    // t1.col1 + t2.col2
+    auto sum = expr_maker.OpSum(t1_col1, t2_col2);
+    // Output Schema
+    merge_join_out.AddOutput("t1.col1", t1_col1);
+    merge_join_out.AddOutput("t2.col1", t2_col1);
+    merge_join_out.AddOutput("t2.col2", t2_col2);
+    merge_join_out.AddOutput("sum", sum);
+    auto schema = merge_join_out.MakeSchema();
+    // Predicate
+    auto predicate = expr_maker.ComparisonEq(t1_col1, t2_col1);
+    // Build
+    planner::MergeJoinPlanNode::Builder builder;
+    merge_join = builder.AddChild(std::move(seq_scan1))
+                     .AddChild(std::move(order_by))
+                     .SetOutputSchema(std::move(schema))
+                     .AddLeftMergeKey(t1_col1)
+                     .AddRightMergeKey(t2_col1)
+                     .SetKeyComparison(parser::ExpressionType::COMPARE_EQUAL)
+                     .SetJoinType(planner::LogicalJoinType::INNER)
+                     .SetJoinPredicate(predicate)
+                     .Build();
+  }
+  // Compile and Run
+  // 80 rows should be outputted because of the WHERE clause, in ascending order of the join key
+  // The joined cols should be equal
+  // The 4th column is the sum of the 1nd and 3rd columns
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows{80};
+  int64_t curr_col2{std::numeric_limits<int64_t>::min()};
+  RowChecker row_checker = [&num_output_rows, &curr_col2, num_expected_rows](const std::vector<sql::Val *> &vals) {
+    // Read cols
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    auto col3 = static_cast<sql::Integer *>(vals[2]);
+    auto col4 = static_cast<sql::Integer *>(vals[3]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_);
+    // Check join cols and their order
+    ASSERT_EQ(col1->val_, col2->val_);
+    ASSERT_LE(curr_col2, col2->val_);
+    curr_col2 = col2->val_;
+    // Check that col4 = col1 + col3
+    ASSERT_EQ(col4->val_, col1->val_ + col3->val_);
+    // Check the number of output row
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+  };
+  CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+
+  GenericChecker checker(row_checker, correcteness_fn);
+
+  OutputStore store{&checker, merge_join->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(merge_join->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), merge_join->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(merge_join), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, InequalityMergeJoinTest) {
+  // SELECT t1.colA, t2.colA FROM test_1 AS t1 INNER JOIN test_1 AS t2 ON t1.colA < t2.colA
+  // WHERE t1.colA < 100 AND t2.colA < 100
+  // The right side is ordered on its join key by an ORDER BY.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  auto cola_oid = table_schema.GetColumn("colA").Oid();
+
+  // Make both seq scans
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  OutputSchemaHelper seq_scan_out2{0, &expr_maker};
+  for (auto [seq_scan, seq_scan_out] : {std::make_pair(&seq_scan1, &seq_scan_out1),
+                                        std::make_pair(&seq_scan2, &seq_scan_out2)}) {
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out->AddOutput("col1", col1);
+    auto schema = seq_scan_out->MakeSchema();
+    // Make predicate
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(100));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    *seq_scan = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid)
+                    .Build();
+  }
+  // Order the second seq scan on its join key
+  std::unique_ptr<planner::AbstractPlanNode> order_by;
+  OutputSchemaHelper order_by_out{1, &expr_maker};
+  {
+    auto col1 = seq_scan_out2.GetOutput("col1");
+    order_by_out.AddOutput("col1", col1);
+    auto schema = order_by_out.MakeSchema();
+    // Build
+    planner::OrderByPlanNode::Builder builder;
+    order_by = builder.SetOutputSchema(std::move(schema))
+                   .AddChild(std::move(seq_scan2))
+                   .AddSortKey(col1, optimizer::OrderByOrderingType::ASC)
+                   .Build();
+  }
+  // Make merge join
+  std::unique_ptr<planner::AbstractPlanNode> merge_join;
+  OutputSchemaHelper merge_join_out{0, &expr_maker};
+  {
+    auto t1_col1 = seq_scan_out1.GetOutput("col1");
+    auto t2_col1 = order_by_out.GetOutput("col1");
+    // Output Schema
+    merge_join_out.AddOutput("t1.col1", t1_col1);
+    merge_join_out.AddOutput("t2.col1", t2_col1);
+    auto schema = merge_join_out.MakeSchema();
+    // Predicate
+    auto predicate = expr_maker.ComparisonLt(t1_col1, t2_col1);
+    // Build
+    planner::MergeJoinPlanNode::Builder builder;
+    merge_join = builder.AddChild(std::move(seq_scan1))
+                     .AddChild(std::move(order_by))
+                     .SetOutputSchema(std::move(schema))
+                     .AddLeftMergeKey(t1_col1)
+                     .AddRightMergeKey(t2_col1)
+                     .SetKeyComparison(parser::ExpressionType::COMPARE_LESS_THAN)
+                     .SetJoinType(planner::LogicalJoinType::INNER)
+                     .SetJoinPredicate(predicate)
+                     .Build();
+  }
+  // Compile and Run
+  // Every pair of distinct values below 100 should be outputted once, in ascending order of t2.colA
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows{100 * 99 / 2};
+  int64_t curr_col2{std::numeric_limits<int64_t>::min()};
+  RowChecker row_checker = [&num_output_rows, &curr_col2, num_expected_rows](const std::vector<sql::Val *> &vals) {
+    // Read cols
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_);
+    // Check join cols and their order
+    ASSERT_LT(col1->val_, col2->val_);
+    ASSERT_LT(col2->val_, 100);
+    ASSERT_LE(curr_col2, col2->val_);
+    curr_col2 = col2->val_;
+    // Check the number of output row
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+  };
+  CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+
+  GenericChecker checker(row_checker, correcteness_fn);
+
+  OutputStore store{&checker, merge_join->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(merge_join->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), merge_join->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(merge_join), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSortTest) {
   // SELECT col1, col2, col1 + col2 FROM test_1 WHERE col1 < 500 ORDER BY col2 ASC, col1 - col2 DESC
@@ -1861,6 +2242,816 @@ TEST_F(CompilerTest, SortWithLimitAndOffsetTest) {
   checker.CheckCorrectness();
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleWindowTest) {
+  // SELECT col1, col2, ROW_NUMBER() OVER w, RANK() OVER w, SUM(col1) OVER w,
+  //        MIN(col1) OVER (w ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING),
+  //        COUNT(col1) OVER (w ROWS BETWEEN 1 PRECEDING AND CURRENT ROW),
+  //        COUNT(*) OVER (w ROWS BETWEEN UNBOUNDED PRECEDING AND UNBOUNDED FOLLOWING)
+  // FROM test_1 WHERE col1 < 1000 WINDOW w AS (PARTITION BY col2 ORDER BY col1)
+  // The parser has no OVER clause yet, so the plan is built by hand. It runs serially, then in parallel.
+  for (const bool parallel : {false, true}) {
+    ExpressionMaker expr_maker;
+    OutputSchemaHelper seq_scan_out{0, &expr_maker};
+    auto seq_scan = MakeTest1Scan(&expr_maker, &seq_scan_out, 1000);
+    std::unique_ptr<planner::AbstractPlanNode> window;
+    OutputSchemaHelper window_out{0, &expr_maker};
+    {
+      auto col1 = seq_scan_out.GetOutput("col1");
+      auto col2 = seq_scan_out.GetOutput("col2");
+      auto sum = expr_maker.AggSum(col1).CastManagedPointerTo<parser::AbstractExpression>();
+      auto min = expr_maker.AggregateTerm(parser::ExpressionType::AGGREGATE_MIN, col1, false)
+                     .CastManagedPointerTo<parser::AbstractExpression>();
+      auto count = expr_maker.AggCount(col1).CastManagedPointerTo<parser::AbstractExpression>();
+      auto count_star = expr_maker.AggCount(expr_maker.Star()).CastManagedPointerTo<parser::AbstractExpression>();
+      window_out.AddOutput("col1", col1);
+      window_out.AddOutput("col2", col2);
+      const char *function_names[] = {"row_number", "rank", "sum", "min", "count", "count_star"};
+      for (int i = 0; i < 6; i++) {
+        window_out.AddOutput(function_names[i], expr_maker.DVE(type::TypeId::INTEGER, 1, i));
+      }
+      using Bound = planner::WindowFrameBoundType;
+      planner::WindowPlanNode::Builder builder;
+      window = builder.SetOutputSchema(window_out.MakeSchema())
+                   .AddChild(std::move(seq_scan))
+                   .AddPartitionByTerm(col2)
+                   .AddSortKey(col1, optimizer::OrderByOrderingType::ASC)
+                   .AddWindowFunction(planner::WindowFunction::Ranking(planner::WindowFunctionType::ROW_NUMBER))
+                   .AddWindowFunction(planner::WindowFunction::Ranking(planner::WindowFunctionType::RANK))
+                   .AddWindowFunction(planner::WindowFunction::Aggregate(sum))
+                   .AddWindowFunction(planner::WindowFunction::Aggregate(min, planner::WindowFrameMode::ROWS,
+                                                                         Bound::PRECEDING, 1, Bound::FOLLOWING, 1))
+                   .AddWindowFunction(planner::WindowFunction::Aggregate(count, planner::WindowFrameMode::ROWS,
+                                                                         Bound::PRECEDING, 1, Bound::CURRENT_ROW, 0))
+                   .AddWindowFunction(planner::WindowFunction::Aggregate(
+                       count_star, planner::WindowFrameMode::ROWS, Bound::UNBOUNDED_PRECEDING, 0,
+                       Bound::UNBOUNDED_FOLLOWING, 0))
+                   .Build();
+    }
+
+    // Rows come out partition by partition, ordered by col1 within each partition. col1 is unique, so every row is
+    // its own peer group.
+    struct Partition {
+      int64_t num_rows_{0};
+      int64_t last_col1_{-1};
+      int64_t sum_{0};
+      std::vector<int64_t> count_stars_;
+    };
+    std::map<int64_t, Partition> partitions;
+    int64_t curr_col2{std::numeric_limits<int64_t>::min()};
+    uint32_t num_output_rows{0};
+    uint32_t num_expected_rows{1000};
+    RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+      for (const auto *val : vals) ASSERT_FALSE(val->is_null_);
+      auto col1 = static_cast<sql::Integer *>(vals[0])->val_;
+      auto col2 = static_cast<sql::Integer *>(vals[1])->val_;
+      // Partitions are contiguous
+      ASSERT_LE(curr_col2, col2);
+      curr_col2 = col2;
+      auto &partition = partitions[col2];
+      ASSERT_LT(partition.last_col1_, col1);
+      partition.num_rows_++;
+      partition.sum_ += col1;
+      ASSERT_EQ(static_cast<sql::Integer *>(vals[2])->val_, partition.num_rows_);
+      ASSERT_EQ(static_cast<sql::Integer *>(vals[3])->val_, partition.num_rows_);
+      ASSERT_EQ(static_cast<sql::Integer *>(vals[4])->val_, partition.sum_);
+      // The sliding minimum is the previous row, if any
+      ASSERT_EQ(static_cast<sql::Integer *>(vals[5])->val_, partition.num_rows_ == 1 ? col1 : partition.last_col1_);
+      ASSERT_EQ(static_cast<sql::Integer *>(vals[6])->val_, std::min<int64_t>(partition.num_rows_, 2));
+      partition.count_stars_.emplace_back(static_cast<sql::Integer *>(vals[7])->val_);
+      partition.last_col1_ = col1;
+      num_output_rows++;
+      ASSERT_LE(num_output_rows, num_expected_rows);
+    };
+    CorrectnessFn correcteness_fn = [&]() {
+      ASSERT_EQ(num_output_rows, num_expected_rows);
+      ASSERT_EQ(partitions.size(), 10);
+      // COUNT(*) over the whole partition is its size on every row
+      for (const auto &partition : partitions) {
+        for (const auto count_star : partition.second.count_stars_) {
+          ASSERT_EQ(count_star, partition.second.num_rows_);
+        }
+      }
+    };
+    GenericChecker checker(row_checker, correcteness_fn);
+
+    if (parallel) {
+      RunParallel(common::ManagedPointer(window), &checker);
+      continue;
+    }
+
+    // Create exec ctx
+    OutputStore store{&checker, window->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(window->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), window->GetOutputSchema().Get());
+
+    // Run & Check
+    auto executable = ExecutableQuery(common::ManagedPointer(window), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+
+    // Pipeline Units
+    auto pipeline = executable.GetPipelineOperatingUnits();
+    EXPECT_EQ(pipeline->units_.size(), 2);
+
+    auto feature_vec0 = pipeline->GetPipelineFeatures(execution::pipeline_id_t(0));
+    auto feature_vec1 = pipeline->GetPipelineFeatures(execution::pipeline_id_t(1));
+    auto exp_vec0 = std::vector<brain::ExecutionOperatingUnitType>{
+        brain::ExecutionOperatingUnitType::SORT_BUILD, brain::ExecutionOperatingUnitType::SEQ_SCAN,
+        brain::ExecutionOperatingUnitType::OP_INTEGER_COMPARE};
+    auto exp_vec1 = std::vector<brain::ExecutionOperatingUnitType>{
+        brain::ExecutionOperatingUnitType::SORT_ITERATE, brain::ExecutionOperatingUnitType::OP_INTEGER_PLUS_OR_MINUS,
+        brain::ExecutionOperatingUnitType::OP_INTEGER_COMPARE};
+    EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
+    EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec1, exp_vec1));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, ParallelStaticAggregateTest) {
+  // SELECT COUNT(*), SUM(colA) FROM test_1 WHERE colA < TEST1_SIZE, with thread-local aggregates merged at the end
+  ExpressionMaker expr_maker;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  auto seq_scan = MakeTest1Scan(&expr_maker, &seq_scan_out, sql::TEST1_SIZE);
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    auto col1 = seq_scan_out.GetOutput("col1");
+    agg_out.AddAggTerm("count_star", expr_maker.AggCount(expr_maker.Star()));
+    agg_out.AddAggTerm("sum_col1", expr_maker.AggSum(col1));
+    agg_out.AddOutput("count_star", agg_out.GetAggTermForOutput("count_star"));
+    agg_out.AddOutput("sum_col1", agg_out.GetAggTermForOutput("sum_col1"));
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(agg_out.MakeSchema())
+              .AddAggregateTerm(agg_out.GetAggTerm("count_star"))
+              .AddAggregateTerm(agg_out.GetAggTerm("sum_col1"))
+              .AddChild(std::move(seq_scan))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+  NumChecker num_checker{1};
+  SingleIntComparisonChecker count_checker{std::equal_to<>(), 0, sql::TEST1_SIZE};
+  SingleIntComparisonChecker sum_checker{std::equal_to<>(), 1, sql::TEST1_SIZE * (sql::TEST1_SIZE - 1) / 2};
+  MultiChecker multi_checker{std::vector<OutputChecker *>{&num_checker, &count_checker, &sum_checker}};
+  RunParallel(common::ManagedPointer(agg), &multi_checker);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, ParallelAggregateTest) {
+  // SELECT key, COUNT(*), SUM(col1) FROM test_1 WHERE col1 < TEST1_SIZE GROUP BY key [ORDER BY key], with thread-local
+  // hash tables whose partitions are merged at the end. key is either col2 (few groups) or col1 (one group per row, so
+  // that the thread-local tables flush). Without the sort, the partitions are built at the end of the aggregation
+  // pipeline. With it, the sort's pipeline builds and scans them in parallel.
+  for (const std::string key : {"col2", "col1"}) {
+    for (const bool sorted : {false, true}) {
+      ExpressionMaker expr_maker;
+      OutputSchemaHelper seq_scan_out{0, &expr_maker};
+      auto seq_scan = MakeTest1Scan(&expr_maker, &seq_scan_out, sql::TEST1_SIZE);
+      std::unique_ptr<planner::AbstractPlanNode> agg;
+      OutputSchemaHelper agg_out{0, &expr_maker};
+      {
+        auto col1 = seq_scan_out.GetOutput("col1");
+        agg_out.AddGroupByTerm("key", seq_scan_out.GetOutput(key));
+        agg_out.AddAggTerm("count_star", expr_maker.AggCount(expr_maker.Star()));
+        agg_out.AddAggTerm("sum_col1", expr_maker.AggSum(col1));
+        agg_out.AddOutput("key", agg_out.GetGroupByTermForOutput("key"));
+        agg_out.AddOutput("count_star", agg_out.GetAggTermForOutput("count_star"));
+        agg_out.AddOutput("sum_col1", agg_out.GetAggTermForOutput("sum_col1"));
+        planner::AggregatePlanNode::Builder builder;
+        agg = builder.SetOutputSchema(agg_out.MakeSchema())
+                  .AddGroupByTerm(agg_out.GetGroupByTerm("key"))
+                  .AddAggregateTerm(agg_out.GetAggTerm("count_star"))
+                  .AddAggregateTerm(agg_out.GetAggTerm("sum_col1"))
+                  .AddChild(std::move(seq_scan))
+                  .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+                  .SetHavingClausePredicate(nullptr)
+                  .Build();
+      }
+      std::unique_ptr<planner::AbstractPlanNode> plan = std::move(agg);
+      if (sorted) {
+        OutputSchemaHelper order_by_out{0, &expr_maker};
+        order_by_out.AddOutput("key", agg_out.GetOutput("key"));
+        order_by_out.AddOutput("count_star", agg_out.GetOutput("count_star"));
+        order_by_out.AddOutput("sum_col1", agg_out.GetOutput("sum_col1"));
+        planner::OrderByPlanNode::Builder builder;
+        plan = builder.SetOutputSchema(order_by_out.MakeSchema())
+                   .AddChild(std::move(plan))
+                   .AddSortKey(agg_out.GetOutput("key"), optimizer::OrderByOrderingType::ASC)
+                   .Build();
+      }
+      // Every group must be output once, and the groups must cover every input row
+      std::vector<bool> seen(sql::TEST1_SIZE, false);
+      int64_t prev_key{-1};
+      int64_t num_groups{0}, total_count{0}, total_sum{0};
+      RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+        auto group_key = static_cast<sql::Integer *>(vals[0]);
+        auto count_star = static_cast<sql::Integer *>(vals[1]);
+        auto sum_col1 = static_cast<sql::Integer *>(vals[2]);
+        ASSERT_FALSE(group_key->is_null_ || count_star->is_null_ || sum_col1->is_null_);
+        ASSERT_GE(group_key->val_, 0);
+        ASSERT_LT(group_key->val_, sql::TEST1_SIZE);
+        ASSERT_FALSE(seen[group_key->val_]);
+        seen[group_key->val_] = true;
+        if (sorted) ASSERT_GT(group_key->val_, prev_key);
+        prev_key = group_key->val_;
+        num_groups++;
+        total_count += count_star->val_;
+        total_sum += sum_col1->val_;
+      };
+      CorrectnessFn correctness_fn = [&]() {
+        if (key == "col1") ASSERT_EQ(num_groups, sql::TEST1_SIZE);
+        ASSERT_EQ(total_count, sql::TEST1_SIZE);
+        ASSERT_EQ(total_sum, int64_t{sql::TEST1_SIZE} * (sql::TEST1_SIZE - 1) / 2);
+      };
+      GenericChecker checker(row_checker, correctness_fn);
+      RunParallel(common::ManagedPointer(plan), &checker);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SpilledAggregateTest) {
+  // SELECT col1, COUNT(*), SUM(col2) FROM test_1 GROUP BY col1, under a memory budget the query is always over. The
+  // serial build switches to partitioned mode and spills, and the parallel build spills its thread-local partitions.
+  for (const bool parallel : {false, true}) {
+    ExpressionMaker expr_maker;
+    OutputSchemaHelper seq_scan_out{0, &expr_maker};
+    auto seq_scan = MakeTest1Scan(&expr_maker, &seq_scan_out, sql::TEST1_SIZE);
+    std::unique_ptr<planner::AbstractPlanNode> agg;
+    OutputSchemaHelper agg_out{0, &expr_maker};
+    {
+      auto col1 = seq_scan_out.GetOutput("col1");
+      auto col2 = seq_scan_out.GetOutput("col2");
+      agg_out.AddGroupByTerm("col1", col1);
+      agg_out.AddAggTerm("count_star", expr_maker.AggCount(expr_maker.Star()));
+      agg_out.AddAggTerm("sum_col2", expr_maker.AggSum(col2));
+      agg_out.AddOutput("col1", agg_out.GetGroupByTermForOutput("col1"));
+      agg_out.AddOutput("count_star", agg_out.GetAggTermForOutput("count_star"));
+      agg_out.AddOutput("sum_col2", agg_out.GetAggTermForOutput("sum_col2"));
+      planner::AggregatePlanNode::Builder builder;
+      agg = builder.SetOutputSchema(agg_out.MakeSchema())
+                .AddGroupByTerm(agg_out.GetGroupByTerm("col1"))
+                .AddAggregateTerm(agg_out.GetAggTerm("count_star"))
+                .AddAggregateTerm(agg_out.GetAggTerm("sum_col2"))
+                .AddChild(std::move(seq_scan))
+                .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+                .SetHavingClausePredicate(nullptr)
+                .Build();
+    }
+    // col1 is unique, so every group has exactly one row, and col2 is in [0, 10)
+    std::vector<bool> seen(sql::TEST1_SIZE, false);
+    uint32_t num_groups{0};
+    RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+      auto col1 = static_cast<sql::Integer *>(vals[0]);
+      auto count_star = static_cast<sql::Integer *>(vals[1]);
+      auto sum_col2 = static_cast<sql::Integer *>(vals[2]);
+      ASSERT_FALSE(col1->is_null_ || count_star->is_null_ || sum_col2->is_null_);
+      ASSERT_GE(col1->val_, 0);
+      ASSERT_LT(col1->val_, sql::TEST1_SIZE);
+      ASSERT_FALSE(seen[col1->val_]);
+      seen[col1->val_] = true;
+      ASSERT_EQ(count_star->val_, 1);
+      ASSERT_GE(sum_col2->val_, 0);
+      ASSERT_LT(sum_col2->val_, 10);
+      num_groups++;
+    };
+    CorrectnessFn correctness_fn = [&]() { ASSERT_EQ(num_groups, sql::TEST1_SIZE); };
+    GenericChecker checker(row_checker, correctness_fn);
+
+    OutputStore store{&checker, agg->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(agg->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), agg->GetOutputSchema().Get());
+    exec_ctx->SetParallelExecution(parallel);
+    exec_ctx->SetMemoryLimit(1);
+    auto executable = ExecutableQuery(common::ManagedPointer(agg), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, ParallelSortTest) {
+  // SELECT col1, col2 FROM test_1 WHERE col1 < bound ORDER BY col1 [LIMIT k], with thread-local sorters merged at the
+  // end. The bounds cover rows spread over all threads, rows in a single block (so a single non-empty thread-local
+  // sorter), and no rows at all. With a limit, they cover both more and fewer rows than the limit.
+  for (const int32_t bound : {500, 3, 0}) {
+    for (const bool has_limit : {false, true}) {
+      const uint32_t limit = 10;
+      ExpressionMaker expr_maker;
+      OutputSchemaHelper seq_scan_out{0, &expr_maker};
+      auto seq_scan = MakeTest1Scan(&expr_maker, &seq_scan_out, bound);
+      std::unique_ptr<planner::AbstractPlanNode> order_by;
+      OutputSchemaHelper order_by_out{0, &expr_maker};
+      {
+        auto col1 = seq_scan_out.GetOutput("col1");
+        auto col2 = seq_scan_out.GetOutput("col2");
+        order_by_out.AddOutput("col1", col1);
+        order_by_out.AddOutput("col2", col2);
+        planner::OrderByPlanNode::Builder builder;
+        builder.SetOutputSchema(order_by_out.MakeSchema())
+            .AddChild(std::move(seq_scan))
+            .AddSortKey(col1, optimizer::OrderByOrderingType::ASC);
+        if (has_limit) builder.SetLimit(limit);
+        order_by = builder.Build();
+      }
+      // col1 is unique and starts at 0, so the output is exactly 0, 1, 2, ...
+      const uint32_t num_expected_rows =
+          has_limit ? std::min(limit, static_cast<uint32_t>(bound)) : static_cast<uint32_t>(bound);
+      uint32_t num_output_rows{0};
+      RowChecker row_checker = [&num_output_rows, num_expected_rows](const std::vector<sql::Val *> &vals) {
+        auto col1 = static_cast<sql::Integer *>(vals[0]);
+        ASSERT_FALSE(col1->is_null_);
+        ASSERT_EQ(col1->val_, num_output_rows);
+        num_output_rows++;
+        ASSERT_LE(num_output_rows, num_expected_rows);
+      };
+      CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows]() {
+        ASSERT_EQ(num_output_rows, num_expected_rows);
+      };
+      GenericChecker checker(row_checker, correcteness_fn);
+      RunParallel(common::ManagedPointer(order_by), &checker);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, ParallelHashJoinBuildTest) {
+  // SELECT t1.col1, t2.col1, t2.col2 FROM test_1 t1 INNER JOIN test_2 t2 ON t1.col1=t2.col1
+  // WHERE t1.col1 < 1000 AND t2.col1 < 80, with the build side inserted into thread-local hash tables
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  auto seq_scan1 = MakeTest1Scan(&expr_maker, &seq_scan_out1, 1000);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+  OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+  {
+    auto table_oid = accessor->GetTableOid(NSOid(), "test_2");
+    auto table_schema = accessor->GetSchema(table_oid);
+    auto cola_oid = table_schema.GetColumn("col1").Oid();
+    auto colb_oid = table_schema.GetColumn("col2").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::SMALLINT);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out2.AddOutput("col1", col1);
+    seq_scan_out2.AddOutput("col2", col2);
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan2 = builder.SetOutputSchema(seq_scan_out2.MakeSchema())
+                    .SetColumnOids({cola_oid, colb_oid})
+                    .SetScanPredicate(expr_maker.ComparisonLt(col1, expr_maker.Constant(80)))
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid)
+                    .Build();
+  }
+  std::unique_ptr<planner::AbstractPlanNode> hash_join;
+  OutputSchemaHelper hash_join_out{0, &expr_maker};
+  {
+    auto t1_col1 = seq_scan_out1.GetOutput("col1");
+    auto t2_col1 = seq_scan_out2.GetOutput("col1");
+    auto t2_col2 = seq_scan_out2.GetOutput("col2");
+    hash_join_out.AddOutput("t1.col1", t1_col1);
+    hash_join_out.AddOutput("t2.col1", t2_col1);
+    hash_join_out.AddOutput("t2.col2", t2_col2);
+    planner::HashJoinPlanNode::Builder builder;
+    hash_join = builder.AddChild(std::move(seq_scan1))
+                    .AddChild(std::move(seq_scan2))
+                    .SetOutputSchema(hash_join_out.MakeSchema())
+                    .AddLeftHashKey(t1_col1)
+                    .AddRightHashKey(t2_col1)
+                    .SetJoinType(planner::LogicalJoinType::INNER)
+                    .SetJoinPredicate(expr_maker.ComparisonEq(t1_col1, t2_col1))
+                    .Build();
+  }
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows{80};
+  RowChecker row_checker = [&num_output_rows, num_expected_rows](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_);
+    ASSERT_EQ(col1->val_, col2->val_);
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+  };
+  CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+  GenericChecker checker(row_checker, correcteness_fn);
+  RunParallel(common::ManagedPointer(hash_join), &checker);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, HashJoinRuntimeFilterTest) {
+  // SELECT t1.colA, t2.key FROM test_1 t1 INNER JOIN <probe table> t2 ON t1.colA=t2.key WHERE t1.colA < 50
+  // For every integer width of the probe key. The build keys are 0 to 49, so the runtime filter of the join must drop
+  // exactly the probe tuples whose key is NULL or out of that range. Its Bloom filter checks probe keys hashed by
+  // JoinHashTable::HashFilterKey() against the build tuple hashes from @hash(), so if the two disagreed, matching
+  // probe tuples would be dropped as well.
+  struct ProbeKey {
+    const char *table_;
+    const char *col_;
+    type::TypeId type_;
+  };
+  const std::vector<ProbeKey> probe_keys{{"all_types_table", "tinyint_col", type::TypeId::TINYINT},
+                                         {"test_2", "col1", type::TypeId::SMALLINT},
+                                         {"test_2", "col2", type::TypeId::INTEGER},
+                                         {"test_2", "col3", type::TypeId::BIGINT}};
+  const int32_t num_build_keys = 50;
+  auto accessor = MakeAccessor();
+  for (const auto &probe_key : probe_keys) {
+    ExpressionMaker expr_maker;
+    auto table_oid = accessor->GetTableOid(NSOid(), probe_key.table_);
+    auto key_oid = accessor->GetSchema(table_oid).GetColumn(probe_key.col_).Oid();
+    // SELECT key FROM <probe table>
+    const auto make_probe_scan = [&](OutputSchemaHelper *scan_out) -> std::unique_ptr<planner::AbstractPlanNode> {
+      scan_out->AddOutput("key", expr_maker.CVE(key_oid, probe_key.type_));
+      planner::SeqScanPlanNode::Builder builder;
+      return builder.SetOutputSchema(scan_out->MakeSchema())
+          .SetColumnOids({key_oid})
+          .SetIsForUpdateFlag(false)
+          .SetNamespaceOid(NSOid())
+          .SetTableOid(table_oid)
+          .Build();
+    };
+    // Runs the plan without parallelism, and returns the number of probe tuples the runtime filters dropped
+    const auto run = [&](common::ManagedPointer<planner::AbstractPlanNode> plan, OutputChecker *checker) {
+      OutputStore store{checker, plan->GetOutputSchema().Get()};
+      MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+      auto exec_ctx = MakeExecCtx(std::move(callback), plan->GetOutputSchema().Get());
+      auto executable = ExecutableQuery(plan, common::ManagedPointer(exec_ctx));
+      executable.Run(common::ManagedPointer(exec_ctx), MODE);
+      checker->CheckCorrectness();
+      return exec_ctx->JoinFilteredTuples();
+    };
+
+    // Count the probe tuples, and those that have a match, without the join
+    uint32_t num_probe_rows{0};
+    uint32_t num_matching_rows{0};
+    {
+      OutputSchemaHelper scan_out{0, &expr_maker};
+      auto probe_scan = make_probe_scan(&scan_out);
+      RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+        auto key = static_cast<sql::Integer *>(vals[0]);
+        num_probe_rows++;
+        if (!key->is_null_ && key->val_ >= 0 && key->val_ < num_build_keys) num_matching_rows++;
+      };
+      GenericChecker checker(row_checker, nullptr);
+      EXPECT_EQ(0, run(common::ManagedPointer(probe_scan), &checker));
+    }
+    ASSERT_LT(num_matching_rows, num_probe_rows) << "The probe keys of " << probe_key.col_ << " all have a match";
+
+    // Join
+    OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+    auto seq_scan1 = MakeTest1Scan(&expr_maker, &seq_scan_out1, num_build_keys);
+    OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+    auto seq_scan2 = make_probe_scan(&seq_scan_out2);
+    std::unique_ptr<planner::AbstractPlanNode> hash_join;
+    OutputSchemaHelper hash_join_out{0, &expr_maker};
+    {
+      auto t1_col1 = seq_scan_out1.GetOutput("col1");
+      auto t2_key = seq_scan_out2.GetOutput("key");
+      hash_join_out.AddOutput("t1.col1", t1_col1);
+      hash_join_out.AddOutput("t2.key", t2_key);
+      planner::HashJoinPlanNode::Builder builder;
+      hash_join = builder.AddChild(std::move(seq_scan1))
+                      .AddChild(std::move(seq_scan2))
+                      .SetOutputSchema(hash_join_out.MakeSchema())
+                      .AddLeftHashKey(t1_col1)
+                      .AddRightHashKey(t2_key)
+                      .SetJoinType(planner::LogicalJoinType::INNER)
+                      .SetJoinPredicate(expr_maker.ComparisonEq(t1_col1, t2_key))
+                      .Build();
+    }
+    uint32_t num_output_rows{0};
+    RowChecker row_checker = [&num_output_rows](const std::vector<sql::Val *> &vals) {
+      auto col1 = static_cast<sql::Integer *>(vals[0]);
+      auto col2 = static_cast<sql::Integer *>(vals[1]);
+      ASSERT_FALSE(col1->is_null_ || col2->is_null_);
+      ASSERT_EQ(col1->val_, col2->val_);
+      num_output_rows++;
+    };
+    CorrectnessFn correctness_fn = [&num_output_rows, num_matching_rows]() {
+      ASSERT_EQ(num_matching_rows, num_output_rows);
+    };
+    GenericChecker checker(row_checker, correctness_fn);
+    const uint64_t num_dropped = run(common::ManagedPointer(hash_join), &checker);
+
+    // Only the probe tuples without a match were dropped, before probing the hash table
+    EXPECT_EQ(num_probe_rows - num_matching_rows, num_dropped) << "Probe key " << probe_key.col_;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleSetOpTest) {
+  // SELECT colA FROM test_1 WHERE colA < 600
+  // <set op>
+  // SELECT colA FROM test_1 WHERE colA >= 400 AND colA < 1000
+  // Get accessor
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  auto cola_oid = table_schema.GetColumn("colA").Oid();
+
+  // The inputs share values in [400, 600), and are otherwise distinct
+  std::vector<std::pair<planner::SetOpType, int64_t>> cases = {
+      {planner::SetOpType::UNION, 1000},     {planner::SetOpType::UNION_ALL, 1200},
+      {planner::SetOpType::INTERSECT, 200},  {planner::SetOpType::INTERSECT_ALL, 200},
+      {planner::SetOpType::EXCEPT, 400},     {planner::SetOpType::EXCEPT_ALL, 400}};
+  for (const auto &[set_op, num_output] : cases) {
+    ExpressionMaker expr_maker;
+    // Scan colA in [lo, hi)
+    auto make_scan = [&](int32_t lo, int32_t hi) {
+      OutputSchemaHelper seq_scan_out{0, &expr_maker};
+      auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+      seq_scan_out.AddOutput("col1", col1);
+      auto schema = seq_scan_out.MakeSchema();
+      auto predicate = expr_maker.ConjunctionAnd(expr_maker.ComparisonGe(col1, expr_maker.Constant(lo)),
+                                                 expr_maker.ComparisonLt(col1, expr_maker.Constant(hi)));
+      planner::SeqScanPlanNode::Builder builder;
+      return builder.SetOutputSchema(std::move(schema))
+          .SetColumnOids({cola_oid})
+          .SetScanPredicate(predicate)
+          .SetIsForUpdateFlag(false)
+          .SetNamespaceOid(NSOid())
+          .SetTableOid(table_oid)
+          .Build();
+    };
+
+    // Make the set operation
+    std::unique_ptr<planner::AbstractPlanNode> set_op_node;
+    OutputSchemaHelper set_op_out{0, &expr_maker};
+    {
+      set_op_out.AddOutput("col1", expr_maker.DVE(type::TypeId::INTEGER, 0, 0));
+      auto schema = set_op_out.MakeSchema();
+      planner::SetOpPlanNode::Builder builder;
+      set_op_node = builder.SetOutputSchema(std::move(schema))
+                        .SetSetOp(set_op)
+                        .AddChild(make_scan(0, 600))
+                        .AddChild(make_scan(400, 1000))
+                        .Build();
+    }
+
+    // Make the checkers
+    NumChecker num_checker{num_output};
+    SingleIntComparisonChecker lower_checker{std::greater_equal<>(), 0, 0};
+    SingleIntComparisonChecker upper_checker{std::less<>(), 0, 1000};
+    MultiChecker multi_checker{std::vector<OutputChecker *>{&num_checker, &lower_checker, &upper_checker}};
+
+    // Compile and Run
+    OutputStore store{&multi_checker, set_op_node->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(set_op_node->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), set_op_node->GetOutputSchema().Get());
+    auto executable = ExecutableQuery(common::ManagedPointer(set_op_node), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    multi_checker.CheckCorrectness();
+
+    // One build pipeline per input, and the iteration
+    auto pipeline = executable.GetPipelineOperatingUnits();
+    EXPECT_EQ(pipeline->units_.size(), 3);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SetOpWithDuplicatesTest) {
+  // SELECT colA / 3 FROM test_1 WHERE colA < 600
+  // <set op>
+  // SELECT colA * colA / 1000 FROM test_1 WHERE colA < 400
+  // Every value of the left input has 3 copies. The right input has up to 32 copies of its small values, as little as
+  // 1 of its large ones, and none of the largest values of the left input, so EXCEPT ALL also sees values of which the
+  // right input has more copies than the left one.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  auto cola_oid = table_schema.GetColumn("colA").Oid();
+
+  // Count the copies of every value in each input
+  std::map<int64_t, int64_t> left_copies, right_copies;
+  for (int64_t col_a = 0; col_a < 600; col_a++) left_copies[col_a / 3]++;
+  for (int64_t col_a = 0; col_a < 400; col_a++) right_copies[col_a * col_a / 1000]++;
+
+  const std::vector<planner::SetOpType> set_ops = {planner::SetOpType::UNION,     planner::SetOpType::UNION_ALL,
+                                                   planner::SetOpType::INTERSECT, planner::SetOpType::INTERSECT_ALL,
+                                                   planner::SetOpType::EXCEPT,    planner::SetOpType::EXCEPT_ALL};
+  for (const auto set_op : set_ops) {
+    // The number of copies of every value in the output
+    std::map<int64_t, int64_t> expected_copies;
+    for (int64_t val = 0; val < 200; val++) {
+      const int64_t left = left_copies[val], right = right_copies[val];
+      int64_t copies = 0;
+      switch (set_op) {
+        case planner::SetOpType::UNION:
+          copies = (left + right > 0) ? 1 : 0;
+          break;
+        case planner::SetOpType::UNION_ALL:
+          copies = left + right;
+          break;
+        case planner::SetOpType::INTERSECT:
+          copies = (left > 0 && right > 0) ? 1 : 0;
+          break;
+        case planner::SetOpType::INTERSECT_ALL:
+          copies = std::min(left, right);
+          break;
+        case planner::SetOpType::EXCEPT:
+          copies = (left > 0 && right == 0) ? 1 : 0;
+          break;
+        default:
+          copies = std::max<int64_t>(left - right, 0);
+          break;
+      }
+      if (copies > 0) expected_copies[val] = copies;
+    }
+
+    ExpressionMaker expr_maker;
+    // Scan f(colA) for colA < hi
+    auto make_scan = [&](const auto &f, int32_t hi) {
+      OutputSchemaHelper seq_scan_out{0, &expr_maker};
+      auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+      seq_scan_out.AddOutput("col1", f(col1));
+      auto schema = seq_scan_out.MakeSchema();
+      planner::SeqScanPlanNode::Builder builder;
+      return builder.SetOutputSchema(std::move(schema))
+          .SetColumnOids({cola_oid})
+          .SetScanPredicate(expr_maker.ComparisonLt(col1, expr_maker.Constant(hi)))
+          .SetIsForUpdateFlag(false)
+          .SetNamespaceOid(NSOid())
+          .SetTableOid(table_oid)
+          .Build();
+    };
+
+    // Make the set operation
+    std::unique_ptr<planner::AbstractPlanNode> set_op_node;
+    OutputSchemaHelper set_op_out{0, &expr_maker};
+    {
+      set_op_out.AddOutput("col1", expr_maker.DVE(type::TypeId::INTEGER, 0, 0));
+      auto schema = set_op_out.MakeSchema();
+      auto left = [&](ExpressionMaker::ManagedExpression col) { return expr_maker.OpDiv(col, expr_maker.Constant(3)); };
+      auto right = [&](ExpressionMaker::ManagedExpression col) {
+        return expr_maker.OpDiv(expr_maker.OpMul(col, col), expr_maker.Constant(1000));
+      };
+      planner::SetOpPlanNode::Builder builder;
+      set_op_node = builder.SetOutputSchema(std::move(schema))
+                        .SetSetOp(set_op)
+                        .AddChild(make_scan(left, 600))
+                        .AddChild(make_scan(right, 400))
+                        .Build();
+    }
+
+    // Make the checker
+    std::map<int64_t, int64_t> output_copies;
+    RowChecker row_checker = [&output_copies](const std::vector<sql::Val *> &vals) {
+      auto col1 = static_cast<sql::Integer *>(vals[0]);
+      ASSERT_FALSE(col1->is_null_);
+      output_copies[col1->val_]++;
+    };
+    CorrectnessFn correctness_fn = [&]() {
+      EXPECT_EQ(expected_copies, output_copies) << "Set operation " << static_cast<int>(set_op);
+    };
+    GenericChecker checker(row_checker, correctness_fn);
+
+    // Compile and Run
+    OutputStore store{&checker, set_op_node->GetOutputSchema().Get()};
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), set_op_node->GetOutputSchema().Get());
+    auto executable = ExecutableQuery(common::ManagedPointer(set_op_node), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, CSVScanTest) {
+  // SELECT id, str, num FROM <csv file> [ORDER BY id], over a file of several chunks. Every kind of field appears in
+  // each chunk: unquoted and quoted integers, quoted strings holding the delimiter, escaped quotes and escaped escapes,
+  // empty quoted strings, and NULLs. Strings stay short enough to be inlined in the output, since longer ones would
+  // point into the file mapping, which is gone by the time the output is checked.
+  const char *const file_name = "compiler_test_csv_scan.csv";
+  const uint32_t num_rows = 600000;
+  const auto expected_str = [](uint32_t id) -> std::optional<std::string> {
+    const std::string suffix = std::to_string(id % 1000);
+    switch (id % 6) {
+      case 0:
+        return "r" + suffix;
+      case 1:
+        return "a," + suffix;
+      case 2:
+        return "q\"" + suffix + "\"";
+      case 3:
+        return "b\\" + suffix;
+      case 4:
+        return "";
+      default:
+        return std::nullopt;
+    }
+  };
+  const auto expected_num = [](uint32_t id) -> std::optional<int64_t> {
+    if (id % 4 == 0) return std::nullopt;
+    return static_cast<int64_t>(id) * 7 - 1000000;
+  };
+  {
+    std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+    for (uint32_t id = 0; id < num_rows; id++) {
+      const std::string suffix = std::to_string(id % 1000);
+      out << (id % 2 == 0 ? std::to_string(id) : "\"" + std::to_string(id) + "\"") << ',';
+      switch (id % 6) {
+        case 0:
+          out << "r" << suffix;
+          break;
+        case 1:
+          out << "\"a," << suffix << "\"";
+          break;
+        case 2:
+          out << "\"q\\\"" << suffix << "\\\"\"";
+          break;
+        case 3:
+          out << "\"b\\\\" << suffix << "\"";
+          break;
+        case 4:
+          out << "\"\"";
+          break;
+        default:
+          break;
+      }
+      out << ',';
+      if (const auto num = expected_num(id)) out << *num;
+      out << '\n';
+    }
+    ASSERT_GT(out.tellp(), 2 * sql::CSVReader::K_CHUNK_SIZE);
+  }
+
+  // Checks every row of the output, which must be in the order of the file
+  const auto make_checker = [&](uint32_t *num_output_rows) {
+    RowChecker row_checker = [=](const std::vector<sql::Val *> &vals) {
+      auto id = static_cast<sql::Integer *>(vals[0]);
+      auto str = static_cast<sql::StringVal *>(vals[1]);
+      auto num = static_cast<sql::Integer *>(vals[2]);
+      ASSERT_FALSE(id->is_null_);
+      ASSERT_EQ(*num_output_rows, id->val_);
+      const auto str_val = expected_str(*num_output_rows);
+      ASSERT_EQ(!str_val.has_value(), str->is_null_) << "Row " << *num_output_rows;
+      if (str_val.has_value()) ASSERT_EQ(*str_val, str->StringView()) << "Row " << *num_output_rows;
+      const auto num_val = expected_num(*num_output_rows);
+      ASSERT_EQ(!num_val.has_value(), num->is_null_) << "Row " << *num_output_rows;
+      if (num_val.has_value()) ASSERT_EQ(*num_val, num->val_) << "Row " << *num_output_rows;
+      (*num_output_rows)++;
+    };
+    CorrectnessFn correctness_fn = [=]() { ASSERT_EQ(num_rows, *num_output_rows); };
+    return GenericChecker(row_checker, correctness_fn);
+  };
+
+  for (const bool parallel : {false, true}) {
+    ExpressionMaker expr_maker;
+    std::unique_ptr<planner::AbstractPlanNode> csv_scan;
+    OutputSchemaHelper csv_scan_out{0, &expr_maker};
+    {
+      csv_scan_out.AddOutput("id", expr_maker.CVE(catalog::col_oid_t(0), type::TypeId::INTEGER));
+      csv_scan_out.AddOutput("str", expr_maker.CVE(catalog::col_oid_t(1), type::TypeId::VARCHAR));
+      csv_scan_out.AddOutput("num", expr_maker.CVE(catalog::col_oid_t(2), type::TypeId::INTEGER));
+      planner::CSVScanPlanNode::Builder builder;
+      csv_scan = builder.SetOutputSchema(csv_scan_out.MakeSchema())
+                     .SetFileName(file_name)
+                     .SetDelimiter(',')
+                     .SetQuote('"')
+                     .SetEscape('\\')
+                     .SetValueTypes({type::TypeId::INTEGER, type::TypeId::VARCHAR, type::TypeId::INTEGER})
+                     .SetIsForUpdateFlag(false)
+                     .SetNamespaceOid(NSOid())
+                     .Build();
+    }
+
+    uint32_t num_output_rows{0};
+    GenericChecker checker = make_checker(&num_output_rows);
+    if (!parallel) {
+      OutputStore store{&checker, csv_scan->GetOutputSchema().Get()};
+      MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+      auto exec_ctx = MakeExecCtx(std::move(callback), csv_scan->GetOutputSchema().Get());
+      auto executable = ExecutableQuery(common::ManagedPointer(csv_scan), common::ManagedPointer(exec_ctx));
+      executable.Run(common::ManagedPointer(exec_ctx), MODE);
+      checker.CheckCorrectness();
+      continue;
+    }
+
+    // The chunks are scanned in any order, so sort the rows back into the order of the file
+    std::unique_ptr<planner::AbstractPlanNode> order_by;
+    OutputSchemaHelper order_by_out{0, &expr_maker};
+    {
+      auto id = csv_scan_out.GetOutput("id");
+      order_by_out.AddOutput("id", id);
+      order_by_out.AddOutput("str", csv_scan_out.GetOutput("str"));
+      order_by_out.AddOutput("num", csv_scan_out.GetOutput("num"));
+      planner::OrderByPlanNode::Builder builder;
+      order_by = builder.SetOutputSchema(order_by_out.MakeSchema())
+                     .AddChild(std::move(csv_scan))
+                     .AddSortKey(id, optimizer::OrderByOrderingType::ASC)
+                     .Build();
+    }
+    RunParallel(common::ManagedPointer(order_by), &checker);
+  }
+
+  std::remove(file_name);
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, LimitAndOffsetTest) {
   // SELECT col1 FROM test_1 WHERE col1 < 500 LIMIT 100 OFFSET 100
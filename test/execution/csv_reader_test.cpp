@@ -0,0 +1,202 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "execution/tpl_test.h"
+
+#include "execution/sql/csv_reader.h"
+#include "execution/sql/memory_pool.h"
+#include "execution/sql/thread_state_container.h"
+
+namespace terrier::execution::sql::test {
+
+class CSVReaderTest : public TplTest {
+ public:
+  void TearDown() override {
+    std::remove(FILE_NAME);
+    TplTest::TearDown();
+  }
+
+  // Overwrite the test file with the given contents
+  static void WriteFile(const std::string &contents) {
+    std::ofstream out(FILE_NAME, std::ios::binary | std::ios::trunc);
+    out << contents;
+  }
+
+  static constexpr const char *FILE_NAME = "csv_reader_test.csv";
+};
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, SimpleTest) {
+  WriteFile("1,hello,2.5,t,2019-01-02\n-20,world,-1,false,2020-12-31\n");
+  CSVReader reader(FILE_NAME, ',', '"', '"');
+
+  ASSERT_TRUE(reader.Advance());
+  EXPECT_EQ(5u, reader.NumFields());
+  EXPECT_EQ(1, reader.GetInteger(0).val_);
+  EXPECT_EQ("hello", reader.GetVarlen(1).StringView());
+  EXPECT_DOUBLE_EQ(2.5, reader.GetReal(2).val_);
+  EXPECT_TRUE(reader.GetBool(3).val_);
+  EXPECT_EQ(Date::FromYMD(2019, 1, 2), reader.GetDate(4).val_);
+
+  ASSERT_TRUE(reader.Advance());
+  EXPECT_EQ(-20, reader.GetInteger(0).val_);
+  EXPECT_EQ("world", reader.GetVarlen(1).StringView());
+  EXPECT_DOUBLE_EQ(-1.0, reader.GetReal(2).val_);
+  EXPECT_FALSE(reader.GetBool(3).val_);
+  EXPECT_EQ(Date::FromYMD(2020, 12, 31), reader.GetDate(4).val_);
+
+  EXPECT_FALSE(reader.Advance());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, QuotedAndNullTest) {
+  WriteFile("\"a,b\",\"say \"\"hi\"\"\",,\"\"\r\n7\r\n");
+  CSVReader reader(FILE_NAME, ',', '"', '"');
+
+  ASSERT_TRUE(reader.Advance());
+  EXPECT_EQ(4u, reader.NumFields());
+  EXPECT_EQ("a,b", reader.GetVarlen(0).StringView());
+  EXPECT_EQ("say \"hi\"", reader.GetVarlen(1).StringView());
+  // An empty unquoted field is NULL, but an empty quoted field is the empty string
+  EXPECT_TRUE(reader.GetVarlen(2).is_null_);
+  EXPECT_FALSE(reader.GetVarlen(3).is_null_);
+  EXPECT_EQ(0u, reader.GetVarlen(3).len_);
+
+  // The carriage return is not part of the field. Missing fields are NULL.
+  ASSERT_TRUE(reader.Advance());
+  EXPECT_EQ(7, reader.GetInteger(0).val_);
+  EXPECT_TRUE(reader.GetInteger(1).is_null_);
+
+  EXPECT_FALSE(reader.Advance());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, BadValueTest) {
+  WriteFile("12a,99999999999999999999\n");
+  CSVReader reader(FILE_NAME, ',', '"', '"');
+  ASSERT_TRUE(reader.Advance());
+  EXPECT_THROW(reader.GetInteger(0), ConversionException);
+  EXPECT_THROW(reader.GetInteger(1), ConversionException);
+  EXPECT_THROW(reader.GetBool(0), ConversionException);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, EmptyFileTest) {
+  WriteFile("");
+  CSVReader reader(FILE_NAME, ',', '"', '"');
+  EXPECT_FALSE(reader.Advance());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, ParallelScanTest) {
+  //
+  // Sum a column from multiple threads. The file spans several chunks.
+  //
+
+  struct Counter {
+    uint64_t count_;
+    int64_t sum_;
+  };
+
+  const uint32_t num_rows = 1000000;
+  std::string contents;
+  int64_t expected_sum = 0;
+  for (uint32_t i = 0; i < num_rows; i++) {
+    contents += std::to_string(i) + ",row\n";
+    expected_sum += i;
+  }
+  ASSERT_GT(contents.size(), CSVReader::K_CHUNK_SIZE);
+  WriteFile(contents);
+
+  MemoryPool memory(nullptr);
+  ThreadStateContainer thread_states(&memory);
+  thread_states.Reset(
+      sizeof(Counter),
+      [](UNUSED_ATTRIBUTE auto *ctx, auto *s) {
+        reinterpret_cast<Counter *>(s)->count_ = 0;
+        reinterpret_cast<Counter *>(s)->sum_ = 0;
+      },
+      nullptr, nullptr);
+
+  auto scan_fn = [](UNUSED_ATTRIBUTE void *query_state, void *thread_state, CSVReader *reader) {
+    auto *counter = reinterpret_cast<Counter *>(thread_state);
+    while (reader->Advance()) {
+      counter->count_++;
+      counter->sum_ += reader->GetInteger(0).val_;
+    }
+  };
+
+  CSVReader::ParallelScan(FILE_NAME, ',', '"', '"', nullptr, &thread_states, scan_fn);
+
+  uint64_t count = 0;
+  int64_t sum = 0;
+  thread_states.ForEach<Counter>([&](Counter *counter) {
+    count += counter->count_;
+    sum += counter->sum_;
+  });
+  EXPECT_EQ(num_rows, count);
+  EXPECT_EQ(expected_sum, sum);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, ParallelScanQuotedNewlineTest) {
+  //
+  // Every row has newlines in a quoted field, so chunks must not be split at them. The file spans several chunks.
+  //
+
+  struct Counter {
+    uint64_t count_;
+    int64_t sum_;
+    uint64_t num_bad_;
+  };
+
+  const uint32_t num_rows = 500000;
+  std::string contents;
+  int64_t expected_sum = 0;
+  for (uint32_t i = 0; i < num_rows; i++) {
+    contents += "\"a\n\"\"b\"\"\n\"," + std::to_string(i) + "\n";
+    expected_sum += i;
+  }
+  ASSERT_GT(contents.size(), 2 * CSVReader::K_CHUNK_SIZE);
+  WriteFile(contents);
+
+  MemoryPool memory(nullptr);
+  ThreadStateContainer thread_states(&memory);
+  thread_states.Reset(
+      sizeof(Counter),
+      [](UNUSED_ATTRIBUTE auto *ctx, auto *s) {
+        reinterpret_cast<Counter *>(s)->count_ = 0;
+        reinterpret_cast<Counter *>(s)->sum_ = 0;
+        reinterpret_cast<Counter *>(s)->num_bad_ = 0;
+      },
+      nullptr, nullptr);
+
+  auto scan_fn = [](UNUSED_ATTRIBUTE void *query_state, void *thread_state, CSVReader *reader) {
+    auto *counter = reinterpret_cast<Counter *>(thread_state);
+    while (reader->Advance()) {
+      if (reader->NumFields() != 2 || reader->GetVarlen(0).StringView() != "a\n\"b\"\n") {
+        counter->num_bad_++;
+        continue;
+      }
+      counter->count_++;
+      counter->sum_ += reader->GetInteger(1).val_;
+    }
+  };
+
+  CSVReader::ParallelScan(FILE_NAME, ',', '"', '"', nullptr, &thread_states, scan_fn);
+
+  uint64_t count = 0;
+  int64_t sum = 0;
+  uint64_t num_bad = 0;
+  thread_states.ForEach<Counter>([&](Counter *counter) {
+    count += counter->count_;
+    sum += counter->sum_;
+    num_bad += counter->num_bad_;
+  });
+  EXPECT_EQ(0u, num_bad);
+  EXPECT_EQ(num_rows, count);
+  EXPECT_EQ(expected_sum, sum);
+}
+
+}  // namespace terrier::execution::sql::test
@@ -189,6 +189,38 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
   main_jht.MergeParallel(&container, 0);
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, RuntimeFilterTest) {
+  const uint32_t num_tuples = 1000;
+  const int64_t min_key = 100;
+
+  // Without filter keys, there is no runtime filter
+  JoinHashTable no_filter(Memory(), sizeof(Tuple));
+  PopulateJoinHashTable(&no_filter, num_tuples, 1);
+  no_filter.Build();
+  EXPECT_FALSE(no_filter.HasFilterKeys());
+  EXPECT_EQ(nullptr, no_filter.GetBloomFilter());
+
+  JoinHashTable join_hash_table(Memory(), sizeof(Tuple));
+  for (int64_t key = min_key; key < min_key + num_tuples; key++) {
+    auto *tuple = reinterpret_cast<Tuple *>(join_hash_table.AllocInputTuple(JoinHashTable::HashFilterKey(key)));
+    tuple->a_ = key;
+    join_hash_table.AddFilterKey(key);
+  }
+  join_hash_table.Build();
+
+  EXPECT_TRUE(join_hash_table.HasFilterKeys());
+  EXPECT_EQ(min_key, join_hash_table.GetMinFilterKey());
+  EXPECT_EQ(min_key + num_tuples - 1, join_hash_table.GetMaxFilterKey());
+
+  // There are no false negatives
+  const BloomFilter *bloom_filter = join_hash_table.GetBloomFilter();
+  ASSERT_NE(nullptr, bloom_filter);
+  for (int64_t key = min_key; key < min_key + num_tuples; key++) {
+    EXPECT_TRUE(bloom_filter->Contains(JoinHashTable::HashFilterKey(key)));
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, DISABLED_PerfTest) {
   const uint32_t num_tuples = 10000000;
@@ -0,0 +1,132 @@
+#include "execution/sql/like_pattern.h"
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "execution/tpl_test.h"
+
+namespace terrier::execution::sql::test {
+
+class LikePatternTest : public TplTest {
+ protected:
+  // A straightforward recursive matcher to check against
+  static bool ReferenceMatch(std::string_view str, std::string_view pattern, bool case_insensitive) {
+    if (pattern.empty()) return str.empty();
+    if (pattern[0] == '%') {
+      for (std::size_t i = 0; i <= str.size(); i++) {
+        if (ReferenceMatch(str.substr(i), pattern.substr(1), case_insensitive)) return true;
+      }
+      return false;
+    }
+    if (str.empty()) return false;
+    if (pattern[0] == '_') return ReferenceMatch(str.substr(1), pattern.substr(1), case_insensitive);
+    std::size_t len = 1;
+    char c = pattern[0];
+    if (c == LikePattern::K_DEFAULT_ESCAPE && pattern.size() > 1) {
+      c = pattern[1];
+      len = 2;
+    }
+    if (case_insensitive ? std::tolower(c) != std::tolower(str[0]) : c != str[0]) return false;
+    return ReferenceMatch(str.substr(1), pattern.substr(len), case_insensitive);
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, ClassifyTest) {
+  EXPECT_EQ(LikePattern::Kind::Exact, LikePattern("abc").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Exact, LikePattern("").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Prefix, LikePattern("abc%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Prefix, LikePattern("abc%%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Suffix, LikePattern("%abc").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Contains, LikePattern("%abc%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Contains, LikePattern("%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::General, LikePattern("a%c").GetKind());
+  EXPECT_EQ(LikePattern::Kind::General, LikePattern("a_c%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::General, LikePattern("%a\\%%").GetKind());
+
+  EXPECT_EQ("abc", LikePattern("%abc%").GetLiteral());
+  EXPECT_EQ("abc", LikePattern("abc%").GetLiteral());
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, MatchTest) {
+  EXPECT_TRUE(LikePattern("abc").Matches("abc"));
+  EXPECT_FALSE(LikePattern("abc").Matches("abcd"));
+  EXPECT_TRUE(LikePattern("").Matches(""));
+  EXPECT_FALSE(LikePattern("").Matches("a"));
+  EXPECT_TRUE(LikePattern("%").Matches(""));
+  EXPECT_TRUE(LikePattern("ab%").Matches("ab"));
+  EXPECT_FALSE(LikePattern("ab%").Matches("a"));
+  EXPECT_TRUE(LikePattern("%ab").Matches("cab"));
+  EXPECT_FALSE(LikePattern("%ab").Matches("abc"));
+  EXPECT_TRUE(LikePattern("%special%requests%").Matches("the special pending requests"));
+  EXPECT_FALSE(LikePattern("%special%requests%").Matches("requests are special"));
+  EXPECT_TRUE(LikePattern("a_c").Matches("abc"));
+  EXPECT_FALSE(LikePattern("a_c").Matches("ac"));
+  EXPECT_TRUE(LikePattern("%a%a%a").Matches("aaaa"));
+
+  // Escapes
+  EXPECT_TRUE(LikePattern("100\\%").Matches("100%"));
+  EXPECT_FALSE(LikePattern("100\\%").Matches("1000"));
+  EXPECT_TRUE(LikePattern("a\\_c").Matches("a_c"));
+  EXPECT_FALSE(LikePattern("a\\_c").Matches("abc"));
+  EXPECT_TRUE(LikePattern("a#%", false, '#').Matches("a%"));
+
+  // ILIKE
+  EXPECT_TRUE(LikePattern("%ABC%", true).Matches("xxabcxx"));
+  EXPECT_FALSE(LikePattern("%ABC%", false).Matches("xxabcxx"));
+  EXPECT_TRUE(LikePattern("A_c%", true).Matches("aBCd"));
+  EXPECT_TRUE(LikePattern("[", true).Matches("["));
+  EXPECT_FALSE(LikePattern("[", true).Matches("{"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, RandomMatchTest) {
+  // Small alphabets make matches, and near-matches, likely
+  std::mt19937 gen(std::random_device{}());
+  const std::string str_chars = "aAbB";
+  const std::string pattern_chars = "aAbB%_\\";
+  auto random_string = [&](const std::string &chars, std::size_t max_len) {
+    std::string str(std::uniform_int_distribution<std::size_t>(0, max_len)(gen), ' ');
+    for (auto &c : str) c = chars[std::uniform_int_distribution<std::size_t>(0, chars.size() - 1)(gen)];
+    return str;
+  };
+
+  for (uint32_t i = 0; i < 5000; i++) {
+    const std::string pattern = random_string(pattern_chars, 8);
+    // Long enough to exercise the SIMD search
+    const std::string str = random_string(str_chars, 80);
+    for (const bool case_insensitive : {false, true}) {
+      EXPECT_EQ(ReferenceMatch(str, pattern, case_insensitive), LikePattern(pattern, case_insensitive).Matches(str))
+          << "'" << str << "' LIKE '" << pattern << "', case insensitive: " << case_insensitive;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, FindTest) {
+  std::string haystack(200, 'x');
+  EXPECT_EQ(0u, LikePattern::Find<false>(haystack, ""));
+  EXPECT_EQ(std::string_view::npos, LikePattern::Find<false>(haystack, "y"));
+  EXPECT_EQ(std::string_view::npos, LikePattern::Find<false>("ab", "abc"));
+
+  // Place the needle at every position, so that it is found within, across, and after full blocks
+  for (const std::string needle : {"y", "yz", "yzy", "yxxxxxxxxz"}) {
+    std::string upper = needle;
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](char c) { return static_cast<char>(std::toupper(c)); });
+    for (std::size_t pos = 0; pos + needle.size() <= haystack.size(); pos++) {
+      std::string str = haystack;
+      str.replace(pos, needle.size(), needle);
+      EXPECT_EQ(pos, LikePattern::Find<false>(str, needle));
+      EXPECT_EQ(pos, LikePattern::Find<true>(str, upper));
+      // The part of the string before the needle does not hold it
+      EXPECT_EQ(std::string_view::npos, LikePattern::Find<false>(std::string_view(str).substr(0, pos), needle));
+    }
+  }
+}
+
+}  // namespace terrier::execution::sql::test
@@ -0,0 +1,93 @@
+#include "execution/vm/object_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "execution/tpl_test.h"
+
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+
+namespace terrier::execution::vm::test {
+
+class ObjectCacheTest : public TplTest {
+ public:
+  void SetUp() override {
+    TplTest::SetUp();
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("object_cache_test", directory_));
+    // Stand-in for the bytecode handlers bitcode, which only contributes to the keys
+    llvm::sys::path::append(handlers_path_, directory_, "handlers.bc");
+    std::error_code error;
+    llvm::raw_fd_ostream handlers(handlers_path_, error);
+    ASSERT_FALSE(error);
+    handlers << "handlers";
+  }
+
+  void TearDown() override {
+    llvm::sys::fs::remove_directories(directory_);
+    TplTest::TearDown();
+  }
+
+  std::unique_ptr<ObjectCache> MakeCache() {
+    llvm::SmallString<128> cache_path;
+    llvm::sys::path::append(cache_path, directory_, "cache");
+    return std::make_unique<ObjectCache>(std::string(cache_path.str()), std::string(handlers_path_.str()));
+  }
+
+ private:
+  llvm::SmallString<128> directory_;
+  llvm::SmallString<128> handlers_path_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ObjectCacheTest, StoreAndLookupTest) {
+  ModuleCompiler compiler;
+  auto add = compiler.CompileToModule("fun test(a: int32) -> int32 { return a + 1 }");
+  auto sub = compiler.CompileToModule("fun test(a: int32) -> int32 { return a - 1 }");
+  ASSERT_FALSE(compiler.HasErrors());
+  ASSERT_TRUE(ObjectCache::IsCacheable(*add->GetBytecodeModule()));
+
+  auto cache = MakeCache();
+  EXPECT_EQ(nullptr, cache->Lookup(*add->GetBytecodeModule()));
+
+  auto object_code = llvm::MemoryBuffer::getMemBufferCopy("object code");
+  cache->Store(*add->GetBytecodeModule(), *object_code);
+  auto hit = cache->Lookup(*add->GetBytecodeModule());
+  ASSERT_NE(nullptr, hit);
+  EXPECT_EQ(object_code->getBuffer(), hit->getBuffer());
+
+  // A module with different bytecode misses
+  EXPECT_EQ(nullptr, cache->Lookup(*sub->GetBytecodeModule()));
+
+  // Entries outlive the cache object, as they would a restart
+  cache = MakeCache();
+  hit = cache->Lookup(*add->GetBytecodeModule());
+  ASSERT_NE(nullptr, hit);
+  EXPECT_EQ(object_code->getBuffer(), hit->getBuffer());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ObjectCacheTest, NotCacheableTest) {
+  ModuleCompiler compiler;
+  auto module = compiler.CompileToModule(R"(
+    fun test() -> bool {
+      var str = @stringToSql("string")
+      return true
+    }
+  )");
+  ASSERT_FALSE(compiler.HasErrors());
+
+  // The bytecode holds the address of the literal, which is only valid in this process
+  EXPECT_FALSE(ObjectCache::IsCacheable(*module->GetBytecodeModule()));
+  auto cache = MakeCache();
+  cache->Store(*module->GetBytecodeModule(), *llvm::MemoryBuffer::getMemBufferCopy("object code"));
+  EXPECT_EQ(nullptr, cache->Lookup(*module->GetBytecodeModule()));
+}
+
+}  // namespace terrier::execution::vm::test
@@ -1,14 +1,19 @@
+#include <array>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <random>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "execution/sql_test.h"
 
 #include "catalog/catalog.h"
+#include "execution/frozen_table_util.h"
 #include "execution/sql/projected_columns_iterator.h"
+#include "type/transient_value_factory.h"
 
 namespace terrier::execution::sql::test {
 
@@ -452,4 +457,231 @@ TEST_F(ProjectedColumnsIteratorTest, MultipleVectorizedFilterTest) {
   EXPECT_LE(count, 10u);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, NullableVectorizedFilterTest) {
+  //
+  // Check that a vectorized filter on a nullable column never selects NULLs,
+  // whatever value their slots hold. Here we check col_b < 0
+  //
+
+  ProjectedColumnsIterator iter(GetProjectedColumn());
+  SetSize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  // Compute expected result
+  uint32_t expected = 0;
+  for (; iter.HasNext(); iter.Advance()) {
+    bool null = false;
+    auto val = *iter.Get<int32_t, true>(GetColOffset(ColId::col_b), &null);
+    if (!null && val < 0) {
+      expected++;
+    }
+  }
+
+  // Filter
+  iter.FilterColByVal<std::less>(GetColOffset(ColId::col_b), type::TypeId::INTEGER,
+                                 ProjectedColumnsIterator::FilterVal{.i_ = 0});
+
+  // Check
+  uint32_t count = 0;
+  for (; iter.HasNextFiltered(); iter.AdvanceFiltered()) {
+    bool null = false;
+    auto val = *iter.Get<int32_t, true>(GetColOffset(ColId::col_b), &null);
+    EXPECT_FALSE(null);
+    EXPECT_LT(val, 0);
+    count++;
+  }
+
+  EXPECT_EQ(expected, count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, ParamFilterTest) {
+  //
+  // Filter col_c by its comparison to query parameters. A parameter that
+  // cannot be compared in the column's type leaves every tuple selected, and
+  // a NULL parameter selects none.
+  //
+
+  const auto col_c = GetColOffset(ColId::col_c);
+  const auto count_filtered = [&](ProjectedColumnsIterator *iter) {
+    uint32_t count = 0;
+    for (; iter->HasNextFiltered(); iter->AdvanceFiltered()) count++;
+    return count;
+  };
+  SetSize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  // Compute expected result
+  uint32_t expected = 0;
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    for (; iter.HasNext(); iter.Advance()) {
+      expected += *iter.Get<int32_t, false>(col_c, nullptr) < 100 ? 1 : 0;
+    }
+  }
+
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    const auto param = type::TransientValueFactory::GetSmallInt(100);
+    EXPECT_EQ(expected, iter.FilterColByParam(col_c, type::TypeId::INTEGER,
+                                              parser::ExpressionType::COMPARE_LESS_THAN, param));
+    EXPECT_EQ(expected, count_filtered(&iter));
+  }
+
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    const auto param = type::TransientValueFactory::GetBigInt(std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(NumTuples(), iter.FilterColByParam(col_c, type::TypeId::INTEGER,
+                                                 parser::ExpressionType::COMPARE_LESS_THAN, param));
+    EXPECT_EQ(NumTuples(), count_filtered(&iter));
+  }
+
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    const auto param = type::TransientValueFactory::GetNull(type::TypeId::INTEGER);
+    EXPECT_EQ(0u, iter.FilterColByParam(col_c, type::TypeId::INTEGER, parser::ExpressionType::COMPARE_LESS_THAN,
+                                        param));
+    EXPECT_EQ(0u, count_filtered(&iter));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, FrozenBlockFilterTest) {
+  //
+  // Read compacted frozen blocks in place, and check that their bit-packed, run-length encoded, and dictionary
+  // compressed columns are decoded, and that filters on the compressed columns select the tuples that filters on the
+  // decoded values would
+  //
+
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->CreateTable(NSOid(), "frozen_table", FrozenTableUtil::Schema(DummyCVE()));
+  auto schema = accessor->GetSchema(table_oid);
+  auto *sql_table = new storage::SqlTable(BlockStore(), schema);
+  accessor->SetTablePointer(table_oid, sql_table);
+  const uint32_t num_tuples = FrozenTableUtil::Populate(sql_table, schema, 2);
+
+  std::vector<catalog::col_oid_t> col_oids;
+  for (const auto &col : schema.GetColumns()) col_oids.emplace_back(col.Oid());
+  auto pm = sql_table->ProjectionMapForOids(col_oids);
+  const uint16_t a = pm[schema.GetColumn("col_a").Oid()];
+  const uint16_t b = pm[schema.GetColumn("col_b").Oid()];
+  const uint16_t c = pm[schema.GetColumn("col_c").Oid()];
+  auto pc_init = sql_table->InitializerForProjectedColumns(col_oids, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  byte *buffer = common::AllocationUtil::AllocateAligned(pc_init.ProjectedColumnsSize());
+  storage::ProjectedColumns *pc = pc_init.Initialize(buffer);
+
+  // "blueberry" is not in the dictionary, and falls between two of its words
+  const auto varlen = [](std::string_view word) {
+    return storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(word.data()),
+                                              static_cast<uint32_t>(word.size()));
+  };
+  const storage::VarlenEntry banana = varlen("banana"), blueberry = varlen("blueberry"), cherry = varlen("cherry");
+  using FilterVal = ProjectedColumnsIterator::FilterVal;
+  const int32_t a_bound = static_cast<int32_t>(num_tuples) - 1000;
+  // Each filter runs on a PCI of its own, and the expected result on the decoded values of a tuple
+  const std::vector<std::pair<std::function<uint32_t(ProjectedColumnsIterator *)>,
+                              std::function<bool(int32_t, std::optional<int32_t>, std::optional<std::string_view>)>>>
+      filters{
+          {[&](auto *iter) { return iter->template FilterColByVal<std::greater_equal>(a, type::TypeId::INTEGER,
+                                                                                      FilterVal{.i_ = a_bound}); },
+           [&](auto col_a, auto, auto) { return col_a >= a_bound; }},
+          {[&](auto *iter) {
+             return iter->template FilterColByVal<std::less>(b, type::TypeId::INTEGER, FilterVal{.i_ = 150});
+           },
+           [](auto, auto col_b, auto) { return col_b.has_value() && *col_b < 150; }},
+          {[&](auto *iter) {
+             return iter->template FilterColByVal<std::equal_to>(b, type::TypeId::INTEGER, FilterVal{.i_ = 200});
+           },
+           [](auto, auto col_b, auto) { return col_b.has_value() && *col_b == 200; }},
+          {[&](auto *iter) {
+             return iter->template FilterColByVal<std::equal_to>(c, type::TypeId::VARCHAR, FilterVal{.str_ = &banana});
+           },
+           [](auto, auto, auto col_c) { return col_c.has_value() && *col_c == "banana"; }},
+          {[&](auto *iter) {
+             return iter->template FilterColByVal<std::less>(c, type::TypeId::VARCHAR, FilterVal{.str_ = &blueberry});
+           },
+           [](auto, auto, auto col_c) { return col_c.has_value() && *col_c < "blueberry"; }},
+          {[&](auto *iter) {
+             return iter->template FilterColByVal<std::greater_equal>(c, type::TypeId::VARCHAR,
+                                                                      FilterVal{.str_ = &blueberry});
+           },
+           [](auto, auto, auto col_c) { return col_c.has_value() && *col_c >= "blueberry"; }},
+          // Parameters reach the same filters on the compressed columns
+          {[&](auto *iter) {
+             return iter->FilterColByParam(b, type::TypeId::INTEGER, parser::ExpressionType::COMPARE_LESS_THAN,
+                                           type::TransientValueFactory::GetInteger(150));
+           },
+           [](auto, auto col_b, auto) { return col_b.has_value() && *col_b < 150; }},
+          {[&](auto *iter) {
+             return iter->FilterColByParam(c, type::TypeId::VARCHAR,
+                                           parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO,
+                                           type::TransientValueFactory::GetVarChar("blueberry"));
+           },
+           [](auto, auto, auto col_c) { return col_c.has_value() && *col_c >= "blueberry"; }},
+          // The second filter only looks at the tuples the first one selected
+          {[&](auto *iter) {
+             iter->template FilterColByVal<std::less>(b, type::TypeId::INTEGER, FilterVal{.i_ = 150});
+             return iter->template FilterColByVal<std::equal_to>(c, type::TypeId::VARCHAR,
+                                                                 FilterVal{.str_ = &cherry});
+           },
+           [](auto, auto col_b, auto col_c) {
+             return col_b.has_value() && *col_b < 150 && col_c.has_value() && *col_c == "cherry";
+           }},
+      };
+
+  uint32_t num_read = 0;
+  std::vector<uint32_t> num_selected(filters.size(), 0), num_expected(filters.size(), 0);
+  for (auto it = sql_table->begin(); it != sql_table->end();) {
+    storage::RawBlock *block = (*it).GetBlock();
+    if (!block->controller_.TryAcquireInPlaceRead()) break;
+    sql_table->ScanInPlace(&it, pc);
+    std::vector<const storage::ArrowColumnInfo *> frozen_columns;
+    for (uint16_t i = 0; i < pc->NumColumns(); i++) {
+      frozen_columns.push_back(&sql_table->GetArrowColumnInfo(block, pc->ColumnIds()[i]));
+    }
+
+    // The decoded values, NULLs included, are the ones that were inserted
+    ProjectedColumnsIterator iter(pc);
+    for (; iter.HasNext(); iter.Advance()) {
+      bool null = false;
+      const int32_t col_a = *iter.Get<int32_t, false>(a, nullptr);
+      const auto i = static_cast<uint32_t>(col_a);
+      const auto *col_b = iter.Get<int32_t, true>(b, &null);
+      ASSERT_EQ(FrozenTableUtil::ColB(i).has_value(), !null);
+      if (!null) EXPECT_EQ(*FrozenTableUtil::ColB(i), *col_b);
+      const auto *col_c = iter.Get<storage::VarlenEntry, true>(c, &null);
+      ASSERT_EQ(FrozenTableUtil::ColC(i).has_value(), !null);
+      if (!null) EXPECT_EQ(*FrozenTableUtil::ColC(i), col_c->StringView());
+
+      for (uint32_t f = 0; f < filters.size(); f++) {
+        num_expected[f] += filters[f].second(col_a, FrozenTableUtil::ColB(i), FrozenTableUtil::ColC(i)) ? 1 : 0;
+      }
+      num_read++;
+    }
+
+    for (uint32_t f = 0; f < filters.size(); f++) {
+      ProjectedColumnsIterator filtered(pc);
+      filtered.SetFrozenColumns(frozen_columns.data());
+      const uint32_t count = filters[f].first(&filtered);
+      num_selected[f] += count;
+      // The selected tuples pass the filter
+      uint32_t num_visited = 0;
+      for (; filtered.HasNextFiltered(); filtered.AdvanceFiltered()) {
+        const int32_t col_a = *filtered.Get<int32_t, false>(a, nullptr);
+        const auto i = static_cast<uint32_t>(col_a);
+        EXPECT_TRUE(filters[f].second(col_a, FrozenTableUtil::ColB(i), FrozenTableUtil::ColC(i)));
+        num_visited++;
+      }
+      EXPECT_EQ(count, num_visited);
+    }
+    block->controller_.ReleaseInPlaceRead();
+  }
+
+  EXPECT_EQ(num_tuples, num_read);
+  for (uint32_t f = 0; f < filters.size(); f++) {
+    EXPECT_EQ(num_expected[f], num_selected[f]) << "filter " << f;
+    EXPECT_GT(num_selected[f], 0) << "filter " << f;
+  }
+  delete[] buffer;
+}
+
 }  // namespace terrier::execution::sql::test
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <chrono>  // NOLINT
 #include <limits>
+#include <numeric>
 #include <queue>
 #include <random>
 #include <thread>  // NOLINT
@@ -168,7 +169,7 @@ struct TestTuple {
 // Generic function to perform a parallel sort. The input parameter indicates
 // the sizes_ of each thread-local sorter that will be created.
 template <uint32_t N>
-void TestParallelSort(const std::vector<uint32_t> &sorter_sizes_) {
+void TestParallelSort(const std::vector<uint32_t> &sorter_sizes_, const uint64_t memory_limit = 0) {
   // Comparison function
   static const auto cmp_fn = [](const void *left, const void *right) {
     const auto *l = reinterpret_cast<const TestTuple<N> *>(left);
@@ -184,6 +185,7 @@ void TestParallelSort(const std::vector<uint32_t> &sorter_sizes_) {
 
   // Create container
   exec::ExecutionContext exec_ctx(catalog::INVALID_DATABASE_OID, nullptr, nullptr, nullptr, nullptr);
+  exec_ctx.SetMemoryLimit(memory_limit);
   ThreadStateContainer container(exec_ctx.GetMemoryPool());
 
   container.Reset(sizeof(Sorter), init_sorter, destroy_sorter, &exec_ctx);
@@ -207,15 +209,19 @@ void TestParallelSort(const std::vector<uint32_t> &sorter_sizes_) {
   EXPECT_TRUE(main.IsSorted());
   EXPECT_EQ(expected_total_size, main.NumTuples());
 
-  // Ensure sortedness
-  const TestTuple<N> *prev = nullptr;
+  // Ensure sortedness. Rows merged from disk are only valid until the next
+  // one, so keep a copy of the previous row.
+  TestTuple<N> prev{};
+  uint32_t num_rows = 0;
   for (SorterIterator iter(&main); iter.HasNext(); iter.Next()) {
     auto *curr = iter.GetRowAs<TestTuple<N>>();
-    if (prev != nullptr) {
-      EXPECT_LE(cmp_fn(prev, curr), 0);
+    if (num_rows > 0) {
+      EXPECT_LE(cmp_fn(&prev, curr), 0);
     }
-    prev = curr;
+    prev = *curr;
+    num_rows++;
   }
+  EXPECT_EQ(expected_total_size, num_rows);
 }
 
 // NOLINTNEXTLINE
@@ -271,4 +277,130 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
   std::this_thread::sleep_for(std::chrono::milliseconds(50));
 }
 
+// Parallel top-K over thread-local sorters of the given sizes. Keys are unique
+// across sorters, so the result is exactly the smallest min(top_k, total) keys.
+void TestParallelTopKSort(const std::vector<uint32_t> &sorter_sizes, const uint64_t top_k) {
+  static const auto cmp_fn = [](const void *left, const void *right) {
+    const auto l = *reinterpret_cast<const uint32_t *>(left);
+    const auto r = *reinterpret_cast<const uint32_t *>(right);
+    return l < r ? -1 : (l == r ? 0 : 1);
+  };
+  const auto init_sorter = [](void *ctx, void *s) {
+    new (s) Sorter(reinterpret_cast<exec::ExecutionContext *>(ctx)->GetMemoryPool(), cmp_fn, sizeof(uint32_t));
+  };
+  const auto destroy_sorter = [](UNUSED_ATTRIBUTE void *ctx, void *s) { reinterpret_cast<Sorter *>(s)->~Sorter(); };
+
+  exec::ExecutionContext exec_ctx(catalog::INVALID_DATABASE_OID, nullptr, nullptr, nullptr, nullptr);
+  ThreadStateContainer container(exec_ctx.GetMemoryPool());
+  container.Reset(sizeof(Sorter), init_sorter, destroy_sorter, &exec_ctx);
+
+  // Sorter i holds the keys i, i + N, i + 2N, ... for N sorters
+  const auto num_sorters = static_cast<uint32_t>(sorter_sizes.size());
+  std::vector<uint32_t> sorter_idxs(num_sorters);
+  std::iota(sorter_idxs.begin(), sorter_idxs.end(), 0u);
+  tbb::parallel_for_each(sorter_idxs.begin(), sorter_idxs.end(), [&](const uint32_t sorter_idx) {
+    auto *sorter = container.AccessThreadStateOfCurrentThreadAs<Sorter>();
+    for (uint32_t i = 0; i < sorter_sizes[sorter_idx]; i++) {
+      *reinterpret_cast<uint32_t *>(sorter->AllocInputTupleTopK(top_k)) = sorter_idx + i * num_sorters;
+      sorter->AllocInputTupleTopKFinish(top_k);
+    }
+  });
+
+  Sorter main(exec_ctx.GetMemoryPool(), cmp_fn, sizeof(uint32_t));
+  main.SortTopKParallel(&container, 0, top_k);
+
+  const uint64_t total_size = std::accumulate(sorter_sizes.begin(), sorter_sizes.end(), uint64_t(0));
+  const uint64_t expected_size = std::min(top_k, total_size);
+  EXPECT_TRUE(main.IsSorted());
+  EXPECT_EQ(expected_size, main.NumTuples());
+
+  // The keys that survive are the smallest ones, in order, and none is null
+  std::vector<uint32_t> expected_keys;
+  for (uint32_t sorter_idx = 0; sorter_idx < num_sorters; sorter_idx++) {
+    for (uint32_t i = 0; i < sorter_sizes[sorter_idx]; i++) expected_keys.push_back(sorter_idx + i * num_sorters);
+  }
+  std::sort(expected_keys.begin(), expected_keys.end());
+  uint64_t num_rows = 0;
+  for (SorterIterator iter(&main); iter.HasNext(); iter.Next()) {
+    ASSERT_NE(nullptr, *iter);
+    EXPECT_EQ(expected_keys[num_rows], *reinterpret_cast<const uint32_t *>(*iter));
+    num_rows++;
+  }
+  EXPECT_EQ(expected_size, num_rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, TopKParallelSortTest) {
+  {
+    tbb::task_scheduler_init sched;
+    // Nothing to sort
+    TestParallelTopKSort({}, 10);
+    TestParallelTopKSort({0, 0}, 10);
+    // Fewer tuples than K, in one or more sorters
+    TestParallelTopKSort({3}, 10);
+    TestParallelTopKSort({3, 0, 4}, 10);
+    // Exactly K, and more than K
+    TestParallelTopKSort({5, 5}, 10);
+    TestParallelTopKSort({100}, 10);
+    TestParallelTopKSort({100, 1, 1000}, 10);
+  }
+  // HACK: ASAN complains that TBB leaks memory because it doesn't clean up
+  // memory right away when the tbb:task_scheduler goes out of scope. So we're
+  // just going to sleep for 50ms. This seems to be enough time.
+  // Without this sleep, then this test will fail randomly because of leaks.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillSortTest) {
+  // Any allocation puts the query over this budget, so the sorter spills as
+  // often as it can
+  exec::ExecutionContext exec_ctx(catalog::INVALID_DATABASE_OID, nullptr, nullptr, nullptr, nullptr);
+  exec_ctx.SetMemoryLimit(1);
+
+  const auto cmp_fn = [](const void *left, const void *right) -> int32_t {
+    const auto l = *reinterpret_cast<const uint32_t *>(left);
+    const auto r = *reinterpret_cast<const uint32_t *>(right);
+    return l < r ? -1 : (l == r ? 0 : 1);
+  };
+
+  const uint32_t num_elems = 100000;
+  std::vector<uint32_t> reference;
+  Sorter sorter(exec_ctx.GetMemoryPool(), cmp_fn, sizeof(uint32_t));
+  std::uniform_int_distribution<uint32_t> rng;
+  for (uint32_t i = 0; i < num_elems; i++) {
+    const uint32_t key = rng(generator_);
+    *reinterpret_cast<uint32_t *>(sorter.AllocInputTuple()) = key;
+    reference.push_back(key);
+  }
+  EXPECT_TRUE(sorter.HasSpilled());
+  EXPECT_EQ(num_elems, sorter.NumTuples());
+
+  sorter.Sort();
+  EXPECT_TRUE(sorter.IsSorted());
+
+  std::sort(reference.begin(), reference.end());
+  uint32_t idx = 0;
+  for (SorterIterator iter(&sorter); iter.HasNext(); iter.Next()) {
+    ASSERT_LT(idx, num_elems);
+    EXPECT_EQ(reference[idx++], *iter.GetRowAs<uint32_t>());
+  }
+  EXPECT_EQ(num_elems, idx);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillParallelSortTest) {
+  {
+    tbb::task_scheduler_init sched;
+    TestParallelSort<2>({5000}, 1);
+    TestParallelSort<2>({5000, 5000, 5000}, 1);
+    TestParallelSort<2>({0, 10, 5000}, 1);
+  }
+  // HACK: ASAN complains that TBB leaks memory because it doesn't clean up
+  // memory right away when the tbb:task_scheduler goes out of scope. So we're
+  // just going to sleep for 50ms. This seems to be enough time.
+  // Without this sleep, then this test will fail randomly because of leaks.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
 }  // namespace terrier::execution::sql::test
@@ -515,4 +515,40 @@ TEST_F(StringFunctionsTests, Trim) {
   EXPECT_TRUE(StringVal("test") == result);
 }
 
+// NOLINTNEXTLINE
+TEST_F(StringFunctionsTests, Like) {
+  // Nulls
+  {
+    auto result = BoolVal(false);
+    StringFunctions::Like(Ctx(), &result, StringVal::Null(), StringVal("%"));
+    EXPECT_TRUE(result.is_null_);
+
+    result = BoolVal(false);
+    StringFunctions::Like(Ctx(), &result, StringVal(test_string_2_), StringVal::Null());
+    EXPECT_TRUE(result.is_null_);
+  }
+
+  auto x = StringVal(test_string_1_);
+  auto result = BoolVal(false);
+
+  StringFunctions::Like(Ctx(), &result, x, StringVal("%love%bed%"));
+  EXPECT_FALSE(result.is_null_);
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(Ctx(), &result, x, StringVal("I only%"));
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(Ctx(), &result, x, StringVal("%SORRY"));
+  EXPECT_FALSE(result.val_);
+
+  StringFunctions::ILike(Ctx(), &result, x, StringVal("%SORRY"));
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(Ctx(), &result, StringVal(test_string_2_), StringVal("Dr_ke"));
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(Ctx(), &result, StringVal(test_string_2_), StringVal("Dr_k"));
+  EXPECT_FALSE(result.val_);
+}
+
 }  // namespace terrier::execution::sql::test
@@ -0,0 +1,115 @@
+#include "execution/vm/superinstructions.h"
+
+#include <functional>
+#include <string>
+
+#include "execution/tpl_test.h"
+
+#include "execution/vm/bytecode_module.h"
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+
+namespace terrier::execution::vm::test {
+
+class SuperinstructionsTest : public TplTest {
+ protected:
+  uint32_t Count(const Module &module, const std::string &func_name, const Bytecode bytecode) {
+    const BytecodeModule &bytecode_module = *module.GetBytecodeModule();
+    uint32_t count = 0;
+    for (auto iter = bytecode_module.BytecodeForFunction(*bytecode_module.GetFuncInfoByName(func_name));
+         !iter.Done(); iter.Advance()) {
+      count += static_cast<uint32_t>(iter.CurrentBytecode() == bytecode);
+    }
+    return count;
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(SuperinstructionsTest, FuseComparisonTest) {
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(R"(
+    fun count(n: int32) -> int32 {
+      var c = 0
+      for (var idx = 0; idx < n; idx = idx + 1) {
+        if (idx >= 10) {
+          c = c + 1
+        }
+      }
+      return c
+    }
+  )");
+  ASSERT_FALSE(compiler.HasErrors());
+
+  // The comparisons are fused with the jumps that follow them, which stay in the bytecode
+  EXPECT_EQ(1u, Count(*module, "count", Bytecode::LessThanJumpIfFalse_int32_t));
+  EXPECT_EQ(1u, Count(*module, "count", Bytecode::GreaterThanEqualJumpIfFalse_int32_t));
+  EXPECT_EQ(0u, Count(*module, "count", Bytecode::LessThan_int32_t));
+  EXPECT_EQ(0u, Count(*module, "count", Bytecode::GreaterThanEqual_int32_t));
+  EXPECT_EQ(2u, Count(*module, "count", Bytecode::JumpIfFalse));
+
+  std::function<int32_t(int32_t)> count;
+  ASSERT_TRUE(module->GetFunction("count", ExecutionMode::Interpret, &count));
+  EXPECT_EQ(0, count(0));
+  EXPECT_EQ(0, count(10));
+  EXPECT_EQ(90, count(100));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SuperinstructionsTest, FusedResultIsStoredTest) {
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(R"(
+    fun test(a: int32, b: int32) -> bool {
+      var lt = a < b
+      if (lt) {
+        return lt
+      }
+      return lt
+    }
+  )");
+  ASSERT_FALSE(compiler.HasErrors());
+
+  // The fused comparison still writes its result to the frame
+  EXPECT_EQ(1u, Count(*module, "test", Bytecode::LessThanJumpIfFalse_int32_t));
+  std::function<bool(int32_t, int32_t)> test;
+  ASSERT_TRUE(module->GetFunction("test", ExecutionMode::Interpret, &test));
+  EXPECT_TRUE(test(1, 2));
+  EXPECT_FALSE(test(2, 1));
+  EXPECT_FALSE(test(2, 2));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SuperinstructionsTest, ProfilePairsTest) {
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(R"(
+    fun test(n: int32) -> int32 {
+      var c = 0
+      for (var i = 0; i < n; i = i + 1) {
+        for (var j = 0; j < n; j = j + 1) {
+          c = c * 3
+        }
+      }
+      return c
+    }
+  )");
+  ASSERT_FALSE(compiler.HasErrors());
+
+  const auto profile = Superinstructions::ProfilePairs(*module->GetBytecodeModule());
+  ASSERT_FALSE(profile.empty());
+  for (std::size_t i = 1; i < profile.size(); i++) {
+    EXPECT_GE(profile[i - 1].weight_, profile[i].weight_);
+  }
+
+  // The multiplication only appears in the inner loop, so it is among the most frequent pairs
+  const uint64_t inner = Superinstructions::K_LOOP_WEIGHT * Superinstructions::K_LOOP_WEIGHT;
+  EXPECT_GE(profile[0].weight_, inner);
+  bool found_mul = false;
+  for (const auto &pair : profile) {
+    if (pair.first_ == Bytecode::Mul_int32_t || pair.second_ == Bytecode::Mul_int32_t) {
+      found_mul = true;
+      EXPECT_GE(pair.weight_, inner);
+    }
+  }
+  EXPECT_TRUE(found_mul);
+}
+
+}  // namespace terrier::execution::vm::test
@@ -1,12 +1,18 @@
 #include <array>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "execution/sql_test.h"
 
 #include "catalog/catalog_defs.h"
+#include "execution/frozen_table_util.h"
 #include "execution/sql/table_vector_iterator.h"
+#include "execution/sql/thread_state_container.h"
 #include "execution/util/timer.h"
+#include "type/transient_value_factory.h"
 
 namespace terrier::execution::sql::test {
 
@@ -129,4 +135,220 @@ TEST_F(TableVectorIteratorTest, IteratorColOidsTest) {
   EXPECT_EQ(sql::TEST2_SIZE, num_tuples);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, RangeIteratorTest) {
+  //
+  // Scanning disjoint block ranges should cover the whole table exactly once
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  std::array<uint32_t, 1> col_oids{1};
+  auto count_range = [&](uint32_t start, uint32_t end) {
+    TableVectorIterator iter(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+    iter.InitRange(start, end);
+    ProjectedColumnsIterator *pci = iter.GetProjectedColumnsIterator();
+    uint32_t num_tuples = 0;
+    while (iter.Advance()) {
+      for (; pci->HasNext(); pci->Advance()) {
+        num_tuples++;
+      }
+      pci->Reset();
+    }
+    return num_tuples;
+  };
+
+  EXPECT_EQ(sql::TEST1_SIZE, count_range(0, 1) + count_range(1, std::numeric_limits<uint32_t>::max()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, RestrictRangeTest) {
+  //
+  // Blocks whose zone maps rule out the range looked for are skipped, whether the range is given directly or as a
+  // comparison to a parameter. Skipping is only by block, so the tuples of the other blocks are all read.
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  const uint32_t num_blocks = exec_ctx_->GetAccessor()->GetTable(table_oid)->GetNumBlocks();
+  ASSERT_GT(num_blocks, 0);
+  std::array<uint32_t, 1> col_oids{1};
+  auto check_scan = [&](const std::function<void(TableVectorIterator *)> &restrict, bool skips_all) {
+    const uint64_t skipped_before = exec_ctx_->SkippedBlocks();
+    TableVectorIterator iter(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+    iter.Init();
+    restrict(&iter);
+    ProjectedColumnsIterator *pci = iter.GetProjectedColumnsIterator();
+    uint32_t num_tuples = 0;
+    while (iter.Advance()) {
+      for (; pci->HasNext(); pci->Advance()) {
+        num_tuples++;
+      }
+      pci->Reset();
+    }
+    EXPECT_EQ(skips_all ? num_blocks : 0, exec_ctx_->SkippedBlocks() - skipped_before);
+    EXPECT_EQ(skips_all ? 0 : sql::TEST1_SIZE, num_tuples);
+  };
+
+  // colA is 0, 1, ..., TEST1_SIZE - 1
+  check_scan([](TableVectorIterator *iter) { iter->RestrictRange(0, type::TypeId::INTEGER, 0, 99); }, false);
+  check_scan(
+      [](TableVectorIterator *iter) {
+        iter->RestrictRange(0, type::TypeId::INTEGER, sql::TEST1_SIZE, std::numeric_limits<int64_t>::max());
+      },
+      true);
+  check_scan(
+      [](TableVectorIterator *iter) {
+        iter->RestrictRange(0, type::TypeId::INTEGER, -100, 50);
+        iter->RestrictRange(0, type::TypeId::INTEGER, 60, 100);
+      },
+      true);
+
+  // The same comparison of colA to parameters of different values
+  const auto restrict_le_param = [](TableVectorIterator *iter) {
+    iter->RestrictRangeToParam(0, type::TypeId::INTEGER, parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO, 0);
+  };
+  exec_ctx_->SetParams({type::TransientValueFactory::GetInteger(-1)});
+  check_scan(restrict_le_param, true);
+  exec_ctx_->SetParams({type::TransientValueFactory::GetInteger(5)});
+  check_scan(restrict_le_param, false);
+  // A NULL parameter or a comparison that is not a range does not restrict the scan
+  exec_ctx_->SetParams({type::TransientValueFactory::GetNull(type::TypeId::INTEGER)});
+  check_scan(restrict_le_param, false);
+  exec_ctx_->SetParams({type::TransientValueFactory::GetInteger(-1)});
+  check_scan(
+      [](TableVectorIterator *iter) {
+        iter->RestrictRangeToParam(0, type::TypeId::INTEGER, parser::ExpressionType::COMPARE_NOT_EQUAL, 0);
+      },
+      false);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, FrozenBlockScanTest) {
+  //
+  // Scan compacted frozen blocks both in place and through the transactional path, and check that both see the same
+  // tuples, that filters on the compressed columns select the same ones, and that the in-place read lock on a block is
+  // held only until the iterator moves off of it
+  //
+
+  auto *accessor = exec_ctx_->GetAccessor();
+  auto table_oid = accessor->CreateTable(NSOid(), "frozen_table", FrozenTableUtil::Schema(DummyCVE()));
+  auto schema = accessor->GetSchema(table_oid);
+  auto *sql_table = new storage::SqlTable(BlockStore(), schema);
+  accessor->SetTablePointer(table_oid, sql_table);
+  const uint32_t num_tuples = FrozenTableUtil::Populate(sql_table, schema, 2);
+
+  std::vector<storage::RawBlock *> blocks;
+  for (auto it = sql_table->begin(); it != sql_table->end(); it++) {
+    if (blocks.empty() || blocks.back() != (*it).GetBlock()) blocks.push_back((*it).GetBlock());
+  }
+  const auto num_readers = [&] {
+    uint32_t readers = 0;
+    for (auto *block : blocks) readers += block->controller_.NumInPlaceReaders();
+    return readers;
+  };
+
+  std::array<uint32_t, 3> col_oids{};
+  std::vector<catalog::col_oid_t> oids;
+  for (uint32_t i = 0; i < col_oids.size(); i++) {
+    oids.emplace_back(schema.GetColumns()[i].Oid());
+    col_oids[i] = !oids.back();
+  }
+  auto pm = sql_table->ProjectionMapForOids(oids);
+  const uint16_t a = pm[schema.GetColumn("col_a").Oid()];
+  const uint16_t b = pm[schema.GetColumn("col_b").Oid()];
+  const uint16_t c = pm[schema.GetColumn("col_c").Oid()];
+  const auto cherry = storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>("cherry"), 6);
+  const auto selected = [](const uint32_t i) {
+    return FrozenTableUtil::ColB(i).has_value() && *FrozenTableUtil::ColB(i) < 150 &&
+           FrozenTableUtil::ColC(i).has_value() && *FrozenTableUtil::ColC(i) == "cherry";
+  };
+
+  using FilterVal = ProjectedColumnsIterator::FilterVal;
+  // Returns the number of tuples that pass col_b < 150 AND col_c = 'cherry'
+  const auto scan = [&](const bool in_place) {
+    exec_ctx_->SetInPlaceReads(in_place);
+    TableVectorIterator iter(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+    iter.Init();
+    ProjectedColumnsIterator *pci = iter.GetProjectedColumnsIterator();
+    uint32_t num_read = 0, num_selected = 0;
+    while (iter.Advance()) {
+      EXPECT_EQ(in_place ? 1 : 0, num_readers());
+      for (; pci->HasNext(); pci->Advance()) {
+        bool null = false;
+        const auto i = static_cast<uint32_t>(*pci->Get<int32_t, false>(a, nullptr));
+        const auto *col_c = pci->Get<storage::VarlenEntry, true>(c, &null);
+        EXPECT_EQ(FrozenTableUtil::ColC(i).has_value(), !null);
+        if (!null) EXPECT_EQ(*FrozenTableUtil::ColC(i), col_c->StringView());
+        num_read++;
+      }
+      pci->Reset();
+      pci->FilterColByVal<std::less>(b, type::TypeId::INTEGER, FilterVal{.i_ = 150});
+      pci->FilterColByVal<std::equal_to>(c, type::TypeId::VARCHAR, FilterVal{.str_ = &cherry});
+      for (; pci->HasNextFiltered(); pci->AdvanceFiltered()) {
+        EXPECT_TRUE(selected(static_cast<uint32_t>(*pci->Get<int32_t, false>(a, nullptr))));
+        num_selected++;
+      }
+    }
+    EXPECT_EQ(0, num_readers());
+    EXPECT_EQ(num_tuples, num_read);
+    return num_selected;
+  };
+
+  uint32_t num_expected = 0;
+  for (uint32_t i = 0; i < num_tuples; i++) num_expected += selected(i) ? 1 : 0;
+  EXPECT_GT(num_expected, 0);
+  EXPECT_EQ(num_expected, scan(true));
+  EXPECT_EQ(num_expected, scan(false));
+
+  // Stopping early releases the block, whether the iterator is reset or destroyed
+  exec_ctx_->SetInPlaceReads(true);
+  {
+    TableVectorIterator iter(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+    iter.Init();
+    ASSERT_TRUE(iter.Advance());
+    EXPECT_EQ(1, num_readers());
+    iter.Reset();
+    EXPECT_EQ(0, num_readers());
+    ASSERT_TRUE(iter.Advance());
+    EXPECT_EQ(1, num_readers());
+  }
+  EXPECT_EQ(0, num_readers());
+  exec_ctx_->SetInPlaceReads(false);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, ParallelScanTest) {
+  //
+  // Count the tuples of a table from multiple threads
+  //
+
+  struct Counter {
+    uint32_t c_;
+  };
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  std::array<uint32_t, 1> col_oids{1};
+  ThreadStateContainer thread_states(exec_ctx_->GetMemoryPool());
+  thread_states.Reset(
+      sizeof(Counter), [](UNUSED_ATTRIBUTE auto *ctx, auto *s) { reinterpret_cast<Counter *>(s)->c_ = 0; }, nullptr,
+      nullptr);
+
+  auto scan_fn = [](UNUSED_ATTRIBUTE void *query_state, void *thread_state, TableVectorIterator *tvi) {
+    auto *counter = reinterpret_cast<Counter *>(thread_state);
+    ProjectedColumnsIterator *pci = tvi->GetProjectedColumnsIterator();
+    while (tvi->Advance()) {
+      for (; pci->HasNext(); pci->Advance()) {
+        counter->c_++;
+      }
+      pci->Reset();
+    }
+  };
+
+  TableVectorIterator::ParallelScan(exec_ctx_.get(), !table_oid, col_oids.data(),
+                                    static_cast<uint32_t>(col_oids.size()), nullptr, &thread_states, scan_fn, 1);
+
+  uint32_t num_tuples = 0;
+  thread_states.ForEach<Counter>([&](Counter *counter) { num_tuples += counter->c_; });
+  EXPECT_EQ(sql::TEST1_SIZE, num_tuples);
+}
+
 }  // namespace terrier::execution::sql::test
@@ -1,6 +1,9 @@
 #include <sys/mman.h>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <random>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -480,6 +483,107 @@ TEST_F(VectorUtilTest, VectorVectorFilterTest) {
 #undef CHECK
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorUtilTest, DoubleFilterTest) {
+  constexpr const uint32_t num_elems = 2000;
+
+  std::vector<double> arr(num_elems);
+  std::mt19937 gen;
+  std::uniform_int_distribution<int32_t> dist(-40, 40);
+  for (auto &val : arr) val = dist(gen) / 4.0;
+  arr[7] = std::numeric_limits<double>::quiet_NaN();
+
+  // Filter all elements, and then every third one, and check with the scalar versions
+  std::vector<uint32_t> sel;
+  for (uint32_t i = 0; i < num_elems; i += 3) sel.push_back(i);
+  std::vector<uint32_t> out(num_elems);
+
+#define CHECK(vec_op, scalar_op)                                                                       \
+  for (const double val : {0.0, 2.5, -3.25, 100.0}) {                                                  \
+    auto found = VectorUtil::Filter##vec_op(arr.data(), num_elems, val, out.data(), nullptr);          \
+    std::vector<uint32_t> expected;                                                                    \
+    for (uint32_t i = 0; i < num_elems; i++) {                                                         \
+      if (arr[i] scalar_op val) expected.push_back(i);                                                 \
+    }                                                                                                  \
+    EXPECT_EQ(expected, std::vector<uint32_t>(out.begin(), out.begin() + found));                      \
+    found = VectorUtil::Filter##vec_op(arr.data(), static_cast<uint32_t>(sel.size()), val, out.data(), \
+                                       sel.data());                                                    \
+    expected.clear();                                                                                  \
+    for (const auto i : sel) {                                                                         \
+      if (arr[i] scalar_op val) expected.push_back(i);                                                 \
+    }                                                                                                  \
+    EXPECT_EQ(expected, std::vector<uint32_t>(out.begin(), out.begin() + found));                      \
+  }
+
+  CHECK(Eq, ==)
+  CHECK(Ge, >=)
+  CHECK(Gt, >)
+  CHECK(Le, <=)
+  CHECK(Lt, <)
+  CHECK(Ne, !=)
+
+#undef CHECK
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorUtilTest, VarlenFilterTest) {
+  constexpr const uint32_t num_elems = 2000;
+
+  // Short strings over a small alphabet, so that many share prefixes, and some are stored inline. The last character
+  // checks that prefixes are compared as unsigned bytes.
+  std::mt19937 gen;
+  const std::string alphabet = "ab\xff";
+  std::vector<std::string> strings(num_elems);
+  std::vector<storage::VarlenEntry> entries;
+  for (auto &str : strings) {
+    const uint32_t len = gen() % 18;
+    for (uint32_t i = 0; i < len; i++) str.push_back(alphabet[gen() % alphabet.size()]);
+    const auto *content = reinterpret_cast<const byte *>(str.data());
+    entries.push_back(str.size() <= storage::VarlenEntry::InlineThreshold()
+                          ? storage::VarlenEntry::CreateInline(content, str.size())
+                          : storage::VarlenEntry::Create(content, str.size(), false));
+  }
+
+  std::vector<uint32_t> sel;
+  for (uint32_t i = 0; i < num_elems; i += 3) sel.push_back(i);
+  std::vector<uint32_t> out(num_elems);
+
+#define CHECK(op, scalar_op)                                                                                      \
+  {                                                                                                               \
+    auto found = VectorUtil::FilterVarlenByVal<op>(entries.data(), num_elems, val, out.data(), nullptr);          \
+    std::vector<uint32_t> expected;                                                                               \
+    for (uint32_t i = 0; i < num_elems; i++) {                                                                    \
+      if (strings[i] scalar_op str) expected.push_back(i);                                                        \
+    }                                                                                                             \
+    EXPECT_EQ(expected, std::vector<uint32_t>(out.begin(), out.begin() + found));                                 \
+    found = VectorUtil::FilterVarlenByVal<op>(entries.data(), static_cast<uint32_t>(sel.size()), val, out.data(), \
+                                              sel.data());                                                        \
+    expected.clear();                                                                                             \
+    for (const auto i : sel) {                                                                                    \
+      if (strings[i] scalar_op str) expected.push_back(i);                                                        \
+    }                                                                                                             \
+    EXPECT_EQ(expected, std::vector<uint32_t>(out.begin(), out.begin() + found));                                 \
+  }
+
+  // Compare with strings from the input, and with some that fit into the prefix or are greater than all of them
+  std::vector<std::string> values = {"", "a", "b\xff", "zzz", std::string(16, 'a')};
+  for (uint32_t i = 0; i < 20; i++) values.push_back(strings[gen() % num_elems]);
+  for (const auto &str : values) {
+    const auto *content = reinterpret_cast<const byte *>(str.data());
+    const auto val = str.size() <= storage::VarlenEntry::InlineThreshold()
+                         ? storage::VarlenEntry::CreateInline(content, str.size())
+                         : storage::VarlenEntry::Create(content, str.size(), false);
+    CHECK(std::equal_to, ==)
+    CHECK(std::greater_equal, >=)
+    CHECK(std::greater, >)
+    CHECK(std::less_equal, <=)
+    CHECK(std::less, <)
+    CHECK(std::not_equal_to, !=)
+  }
+
+#undef CHECK
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorUtilTest, GatherTest) {
   auto array = AllocateArray<uint32_t>(800000);
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <limits>
+#include <random>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "execution/tpl_test.h"
+
+#include <tbb/tbb.h>  // NOLINT
+
+#include "execution/exec/execution_context.h"
+#include "execution/sql/aggregators.h"
+#include "execution/sql/sorter.h"
+#include "execution/sql/thread_state_container.h"
+#include "execution/sql/window_operator.h"
+
+namespace terrier::execution::sql::test {
+
+/**
+ * An input row, windowed by PARTITION BY part_ ORDER BY order_
+ */
+struct WindowRow {
+  int64_t part_, order_, val_;
+};
+
+static int32_t ComparePartition(const void *left, const void *right) {
+  const auto *l = reinterpret_cast<const WindowRow *>(left);
+  const auto *r = reinterpret_cast<const WindowRow *>(right);
+  return l->part_ < r->part_ ? -1 : (l->part_ == r->part_ ? 0 : 1);
+}
+
+static int32_t ComparePeer(const void *left, const void *right) {
+  if (const int32_t cmp = ComparePartition(left, right); cmp != 0) {
+    return cmp;
+  }
+  const auto *l = reinterpret_cast<const WindowRow *>(left);
+  const auto *r = reinterpret_cast<const WindowRow *>(right);
+  return l->order_ < r->order_ ? -1 : (l->order_ == r->order_ ? 0 : 1);
+}
+
+class WindowOperatorTest : public TplTest {
+ public:
+  // Fill the sorter with random rows, and return them sorted
+  std::vector<WindowRow> Fill(Sorter *sorter, uint32_t num_rows, int64_t num_parts, int64_t num_orders) {
+    std::vector<WindowRow> rows;
+    std::uniform_int_distribution<int64_t> part(0, num_parts - 1), order(0, num_orders - 1), val(-100, 100);
+    for (uint32_t i = 0; i < num_rows; i++) {
+      const WindowRow row{part(generator_), order(generator_), val(generator_)};
+      *reinterpret_cast<WindowRow *>(sorter->AllocInputTuple()) = row;
+      rows.push_back(row);
+    }
+    sorter->Sort();
+    // The sort is not stable, so take the rows in the sorter's order
+    uint32_t idx = 0;
+    for (SorterIterator iter(sorter); iter.HasNext(); iter.Next()) {
+      rows[idx++] = *iter.GetRowAs<WindowRow>();
+    }
+    return rows;
+  }
+
+  std::default_random_engine generator_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(WindowOperatorTest, EmptyTest) {
+  MemoryPool memory(nullptr);
+  Sorter sorter(&memory, ComparePeer, sizeof(WindowRow));
+  sorter.Sort();
+
+  WindowOperator window(sorter, ComparePartition, ComparePeer);
+  EXPECT_EQ(0u, window.NumRows());
+  EXPECT_EQ(0u, window.NumPartitions());
+  EXPECT_FALSE(WindowIterator(window).HasNext());
+}
+
+// NOLINTNEXTLINE
+TEST_F(WindowOperatorTest, RankingTest) {
+  MemoryPool memory(nullptr);
+  Sorter sorter(&memory, ComparePeer, sizeof(WindowRow));
+  const auto rows = Fill(&sorter, 5000, 20, 50);
+
+  WindowOperator window(sorter, ComparePartition, ComparePeer);
+  EXPECT_EQ(rows.size(), window.NumRows());
+
+  // Compute the ranking functions directly from the sorted rows
+  uint64_t num_parts = 0, row_number = 0, rank = 0, dense_rank = 0;
+  WindowIterator iter(window);
+  for (uint32_t i = 0; i < rows.size(); i++, iter.Next()) {
+    const bool new_part = i == 0 || ComparePartition(&rows[i - 1], &rows[i]) != 0;
+    if (new_part) {
+      num_parts++;
+      row_number = rank = dense_rank = 0;
+    }
+    row_number++;
+    if (new_part || ComparePeer(&rows[i - 1], &rows[i]) != 0) {
+      rank = row_number;
+      dense_rank++;
+    }
+
+    ASSERT_TRUE(iter.HasNext());
+    EXPECT_EQ(0, ComparePeer(&rows[i], iter.GetRow()));
+    EXPECT_EQ(new_part, iter.IsPartitionStart());
+    EXPECT_EQ(row_number, iter.GetRowNumber());
+    EXPECT_EQ(rank, iter.GetRank());
+    EXPECT_EQ(dense_rank, iter.GetDenseRank());
+  }
+  EXPECT_FALSE(iter.HasNext());
+  EXPECT_EQ(num_parts, window.NumPartitions());
+
+  // Without partitioning or ordering keys, all rows are one partition of peers
+  WindowOperator single(sorter, nullptr, nullptr);
+  EXPECT_EQ(1u, single.NumPartitions());
+  for (WindowIterator single_iter(single); single_iter.HasNext(); single_iter.Next()) {
+    EXPECT_EQ(rows.size(), single_iter.GetPartitionSize());
+    EXPECT_EQ(1u, single_iter.GetRank());
+    EXPECT_EQ(1u, single_iter.GetDenseRank());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(WindowOperatorTest, FrameAggregateTest) {
+  MemoryPool memory(nullptr);
+  Sorter sorter(&memory, ComparePeer, sizeof(WindowRow));
+  const auto rows = Fill(&sorter, 3000, 10, 100);
+  WindowOperator window(sorter, ComparePartition, ComparePeer);
+
+  using Bound = WindowFrame::Bound;
+  const std::vector<WindowFrame> frames = {
+      WindowFrame::Default(),
+      WindowFrame::WholePartition(),
+      WindowFrame::Sliding(3, 2),
+      WindowFrame::Sliding(0, 0),
+      {WindowFrame::Mode::Rows, Bound::UnboundedPreceding, 0, Bound::CurrentRow, 0},
+      {WindowFrame::Mode::Rows, Bound::Preceding, 5, Bound::Preceding, 2},
+      {WindowFrame::Mode::Rows, Bound::Following, 1, Bound::UnboundedFollowing, 0},
+      {WindowFrame::Mode::Rows, Bound::Following, 4, Bound::Following, 1},
+      {WindowFrame::Mode::Range, Bound::CurrentRow, 0, Bound::UnboundedFollowing, 0},
+  };
+
+  const auto advance_sum = [](IntegerSumAggregate *agg, const byte *row) {
+    agg->Advance(Integer(reinterpret_cast<const WindowRow *>(row)->val_));
+  };
+  const auto advance_max = [](IntegerMaxAggregate *agg, const byte *row) {
+    agg->Advance(Integer(reinterpret_cast<const WindowRow *>(row)->val_));
+  };
+
+  for (const auto &frame : frames) {
+    WindowSegmentTree<IntegerSumAggregate> sums;
+    WindowSegmentTree<IntegerMaxAggregate> maxes;
+    IntegerSumAggregate sum;
+    IntegerMaxAggregate max;
+
+    for (WindowIterator iter(window); iter.HasNext(); iter.Next()) {
+      if (iter.IsPartitionStart()) {
+        sums.Build(iter.GetPartitionRows(), iter.GetPartitionSize(), advance_sum);
+        maxes.Build(iter.GetPartitionRows(), iter.GetPartitionSize(), advance_max);
+      }
+      const auto [begin, end] = iter.GetFrame(frame);
+      ASSERT_LE(begin, end);
+      ASSERT_LE(end, iter.GetPartitionSize());
+
+      // Check against the aggregate of the frame computed row by row
+      const byte *const *part = iter.GetPartitionRows();
+      int64_t expected_sum = 0, expected_max = std::numeric_limits<int64_t>::min();
+      for (uint64_t i = begin; i < end; i++) {
+        const int64_t val = reinterpret_cast<const WindowRow *>(part[i])->val_;
+        expected_sum += val;
+        expected_max = std::max(expected_max, val);
+      }
+
+      sums.Query(begin, end, &sum);
+      maxes.Query(begin, end, &max);
+      EXPECT_EQ(begin == end, sum.GetResultSum().is_null_);
+      EXPECT_EQ(begin == end, max.GetResultMax().is_null_);
+      if (begin != end) {
+        EXPECT_EQ(expected_sum, sum.GetResultSum().val_);
+        EXPECT_EQ(expected_max, max.GetResultMax().val_);
+      }
+    }
+  }
+
+  // Spot check a few frames of the first row of a partition
+  WindowIterator iter(window);
+  ASSERT_TRUE(iter.HasNext());
+  EXPECT_EQ(std::make_pair(uint64_t{0}, uint64_t{3}), iter.GetFrame(WindowFrame::Sliding(3, 2)));
+  EXPECT_EQ(std::make_pair(uint64_t{0}, uint64_t{0}),
+            iter.GetFrame({WindowFrame::Mode::Rows, Bound::Preceding, 5, Bound::Preceding, 2}));
+  EXPECT_EQ(std::make_pair(uint64_t{0}, iter.GetPartitionSize()), iter.GetFrame(WindowFrame::WholePartition()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(WindowOperatorTest, ParallelScanTest) {
+  {
+    tbb::task_scheduler_init sched;
+
+    const auto init_sorter = [](void *ctx, void *s) {
+      new (s) Sorter(reinterpret_cast<exec::ExecutionContext *>(ctx)->GetMemoryPool(), ComparePeer, sizeof(WindowRow));
+    };
+    const auto destroy_sorter = [](UNUSED_ATTRIBUTE void *ctx, void *s) { reinterpret_cast<Sorter *>(s)->~Sorter(); };
+
+    exec::ExecutionContext exec_ctx(catalog::INVALID_DATABASE_OID, nullptr, nullptr, nullptr, nullptr);
+    ThreadStateContainer container(exec_ctx.GetMemoryPool());
+    container.Reset(sizeof(Sorter), init_sorter, destroy_sorter, &exec_ctx);
+
+    // Every thread inserts the same rows, so each one has four peers
+    const int64_t num_parts = 100, rows_per_part = 200;
+    const std::vector<uint32_t> threads = {0, 1, 2, 3};
+    tbb::parallel_for_each(threads.begin(), threads.end(), [&](UNUSED_ATTRIBUTE auto x) {
+      auto *sorter = container.AccessThreadStateOfCurrentThreadAs<Sorter>();
+      for (int64_t part = 0; part < num_parts; part++) {
+        for (int64_t order = 0; order < rows_per_part; order++) {
+          *reinterpret_cast<WindowRow *>(sorter->AllocInputTuple()) = {part, order, 1};
+        }
+      }
+    });
+
+    Sorter main(exec_ctx.GetMemoryPool(), ComparePeer, sizeof(WindowRow));
+    main.SortParallel(&container, 0);
+
+    WindowOperator window(main, ComparePartition, ComparePeer);
+    EXPECT_EQ(static_cast<uint64_t>(num_parts), window.NumPartitions());
+
+    // Each row checks that its rank follows from its position in the ordering,
+    // and that its running sum counts all rows up to and including its peers
+    struct QS {
+      std::atomic<uint64_t> num_rows_;
+      std::atomic<uint64_t> num_errors_;
+    };
+    QS qs{0, 0};
+    container.Clear();
+    window.ExecuteParallelScan(&qs, &container, [](void *query_state, void *thread_state, WindowIterator *iter) {
+      auto *qs = reinterpret_cast<QS *>(query_state);
+      WindowSegmentTree<CountStarAggregate> counts;
+      CountStarAggregate count;
+      for (; iter->HasNext(); iter->Next()) {
+        if (iter->IsPartitionStart()) {
+          counts.Build(iter->GetPartitionRows(), iter->GetPartitionSize(),
+                       [](CountStarAggregate *agg, const byte *row) { agg->Advance(Integer(1)); });
+        }
+        const auto order = static_cast<uint64_t>(iter->GetRowAs<WindowRow>()->order_);
+        const auto [begin, end] = iter->GetFrame(WindowFrame::Default());
+        counts.Query(begin, end, &count);
+        const bool ok = iter->GetRank() == order * 4 + 1 && iter->GetDenseRank() == order + 1 &&
+                        static_cast<uint64_t>(count.GetCountResult().val_) == (order + 1) * 4;
+        qs->num_errors_ += static_cast<uint64_t>(!ok);
+        qs->num_rows_++;
+      }
+    });
+
+    EXPECT_EQ(main.NumTuples(), qs.num_rows_.load());
+    EXPECT_EQ(0u, qs.num_errors_.load());
+  }
+  // HACK: ASAN complains that TBB leaks memory because it doesn't clean up
+  // memory right away when the tbb:task_scheduler goes out of scope. So we're
+  // just going to sleep for 50ms. This seems to be enough time.
+  // Without this sleep, then this test will fail randomly because of leaks.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+}  // namespace terrier::execution::sql::test
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "storage/block_compactor.h"
+#include "storage/garbage_collector.h"
+#include "storage/sql_table.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace terrier::execution {
+
+/**
+ * FrozenTableUtil fills a table whose blocks are then compacted and frozen with compressed columns, so that scans can
+ * read them in place. The values of a tuple only depend on its position i in the table:
+ *  - col_a INTEGER NOT NULL is i, and bit-packed
+ *  - col_b INTEGER is i / B_RUN_LENGTH, or NULL every B_NULL_EVERY tuples, and run-length encoded
+ *  - col_c VARCHAR is one of a few words, or NULL every C_NULL_EVERY tuples, and dictionary compressed
+ */
+class FrozenTableUtil {
+ public:
+  /** Length of the runs of col_b */
+  static constexpr uint32_t B_RUN_LENGTH = 100;
+  /** col_b is NULL in one tuple out of this many */
+  static constexpr uint32_t B_NULL_EVERY = 7;
+  /** col_c is NULL in one tuple out of this many */
+  static constexpr uint32_t C_NULL_EVERY = 5;
+
+  /**
+   * @param dummy default value of the columns
+   * @return schema of the table
+   */
+  static catalog::Schema Schema(const parser::AbstractExpression &dummy) {
+    return catalog::Schema({{"col_a", type::TypeId::INTEGER, false, dummy},
+                            {"col_b", type::TypeId::INTEGER, true, dummy},
+                            {"col_c", type::TypeId::VARCHAR, 64, true, dummy}});
+  }
+
+  /** @return value of col_b in the tuple at position i, if it is not NULL */
+  static std::optional<int32_t> ColB(const uint32_t i) {
+    if (i % B_NULL_EVERY == 0) return std::nullopt;
+    return static_cast<int32_t>(i / B_RUN_LENGTH);
+  }
+
+  /** @return value of col_c in the tuple at position i, if it is not NULL */
+  static std::optional<std::string_view> ColC(const uint32_t i) {
+    if (i % C_NULL_EVERY == 0) return std::nullopt;
+    return Words()[(i / 3) % Words().size()];
+  }
+
+  /** @return the words in col_c in sorted order. One of them is too long to be inlined in a VarlenEntry. */
+  static const std::vector<std::string_view> &Words() {
+    static const std::vector<std::string_view> words{"apple", "banana", "cherry", "durian-durian-durian"};
+    return words;
+  }
+
+  /**
+   * Fill the given number of blocks of the table, and freeze them
+   * @param table an empty table with the schema of Schema()
+   * @param schema the schema of the table, with column oids
+   * @param num_blocks number of blocks to fill
+   * @return number of tuples in the table
+   */
+  static uint32_t Populate(storage::SqlTable *table, const catalog::Schema &schema, const uint32_t num_blocks) {
+    // Blocks are only compacted when full
+    const uint32_t num_tuples = num_blocks * table->GetNumSlotsPerBlock();
+    std::vector<catalog::col_oid_t> col_oids;
+    for (const auto &col : schema.GetColumns()) col_oids.emplace_back(col.Oid());
+    const auto pri = table->InitializerForProjectedRow(col_oids);
+    auto pm = table->ProjectionMapForOids(col_oids);
+    const uint16_t a = pm[schema.GetColumn("col_a").Oid()];
+    const uint16_t b = pm[schema.GetColumn("col_b").Oid()];
+    const uint16_t c = pm[schema.GetColumn("col_c").Oid()];
+
+    // The table is filled and compacted by transactions of its own, which no other transaction holds back
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    storage::RecordBufferSegmentPool buffer_pool{100000, 100000};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool), true, DISABLED};
+    storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    auto *txn = txn_manager.BeginTransaction();
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto *redo = txn->StageWrite(catalog::db_oid_t(0), catalog::table_oid_t(0), pri);
+      *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(a)) = static_cast<int32_t>(i);
+      if (const auto col_b = ColB(i)) {
+        *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(b)) = *col_b;
+      } else {
+        redo->Delta()->SetNull(b);
+      }
+      if (const auto col_c = ColC(i)) {
+        const auto size = static_cast<uint32_t>(col_c->size());
+        const auto *content = reinterpret_cast<const byte *>(col_c->data());
+        storage::VarlenEntry entry;
+        if (size <= storage::VarlenEntry::InlineThreshold()) {
+          entry = storage::VarlenEntry::CreateInline(content, size);
+        } else {
+          auto *copy = common::AllocationUtil::AllocateAligned(size);
+          std::memcpy(copy, content, size);
+          entry = storage::VarlenEntry::Create(copy, size, true);
+        }
+        *reinterpret_cast<storage::VarlenEntry *>(redo->Delta()->AccessForceNotNull(c)) = entry;
+      } else {
+        redo->Delta()->SetNull(c);
+      }
+      table->Insert(common::ManagedPointer(txn), redo);
+    }
+    txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    // Unlink the versions of the inserts, which would stop compaction
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();
+
+    std::vector<storage::RawBlock *> blocks;
+    for (uint32_t i = 0; i < table->GetNumBlocks(); i++) {
+      storage::RawBlock *block = (*table->GetBlockIterator(i)).GetBlock();
+      if (block->GetInsertHead() == table->GetNumSlotsPerBlock()) blocks.emplace_back(block);
+    }
+
+    // Choose the encodings through the Arrow metadata of the blocks, which the gathering pass then applies
+    const auto pc_init = table->InitializerForProjectedColumns(col_oids, 1);
+    byte *buffer = common::AllocationUtil::AllocateAligned(pc_init.ProjectedColumnsSize());
+    const storage::ProjectedColumns *pc = pc_init.Initialize(buffer);
+    const std::vector<std::pair<uint16_t, storage::ArrowColumnType>> encodings{
+        {a, storage::ArrowColumnType::BIT_PACKED},
+        {b, storage::ArrowColumnType::RUN_LENGTH_ENCODED},
+        {c, storage::ArrowColumnType::DICTIONARY_COMPRESSED}};
+    for (storage::RawBlock *block : blocks) {
+      for (const auto &[idx, type] : encodings) {
+        const storage::ArrowColumnInfo &col_info = table->GetArrowColumnInfo(block, pc->ColumnIds()[idx]);
+        const_cast<storage::ArrowColumnInfo &>(col_info).Type() = type;  // NOLINT
+      }
+    }
+    delete[] buffer;
+
+    storage::BlockCompactor compactor;
+    for (storage::RawBlock *block : blocks) compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+    gc.PerformGarbageCollection();
+    for (storage::RawBlock *block : blocks) compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();  // Second call to deallocate.
+    return num_tuples;
+  }
+};
+
+}  // namespace terrier::execution
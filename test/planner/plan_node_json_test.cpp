@@ -40,6 +40,7 @@
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "type/transient_value.h"
 #include "type/transient_value_factory.h"
 #include "type/type_id.h"
@@ -919,4 +920,42 @@ TEST(PlanNodeJsonTest, UpdatePlanNodeJsonTest) {
   EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
 }
 
+// NOLINTNEXTLINE
+TEST(PlanNodeJsonTest, WindowPlanNodeJsonTest) {
+  // Construct WindowPlanNode
+  auto partition_term = std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 0);
+  auto sort_key = std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 1);
+  std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+  children.push_back(std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 1));
+  auto agg_term = std::make_unique<parser::AggregateExpression>(parser::ExpressionType::AGGREGATE_SUM,
+                                                                std::move(children), false);
+
+  WindowPlanNode::Builder builder;
+  auto plan_node =
+      builder.SetOutputSchema(PlanNodeJsonTest::BuildDummyOutputSchema())
+          .AddPartitionByTerm(common::ManagedPointer(partition_term).CastManagedPointerTo<parser::AbstractExpression>())
+          .AddSortKey(common::ManagedPointer(sort_key).CastManagedPointerTo<parser::AbstractExpression>(),
+                      optimizer::OrderByOrderingType::DESC)
+          .AddWindowFunction(WindowFunction::Ranking(WindowFunctionType::DENSE_RANK))
+          .AddWindowFunction(WindowFunction::Aggregate(
+              common::ManagedPointer(agg_term).CastManagedPointerTo<parser::AbstractExpression>(),
+              WindowFrameMode::ROWS, WindowFrameBoundType::PRECEDING, 2, WindowFrameBoundType::FOLLOWING, 1))
+          .Build();
+
+  // Serialize to Json
+  auto json = plan_node->ToJson();
+  EXPECT_FALSE(json.is_null());
+
+  // Deserialize plan node
+  auto deserialized = DeserializePlanNode(json);
+  auto deserialized_plan = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<WindowPlanNode>();
+  EXPECT_TRUE(deserialized_plan != nullptr);
+  EXPECT_EQ(PlanNodeType::WINDOW, deserialized_plan->GetPlanNodeType());
+  EXPECT_EQ(*plan_node, *deserialized_plan);
+  EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
+  EXPECT_EQ(2, deserialized_plan->GetWindowFunctions().size());
+  EXPECT_TRUE(deserialized_plan->GetWindowFunctions()[0].aggregate_ == nullptr);
+  EXPECT_EQ(2, deserialized_plan->GetWindowFunctions()[1].frame_start_offset_);
+}
+
 }  // namespace terrier::planner
@@ -0,0 +1,57 @@
+#include <unordered_set>
+#include <vector>
+
+#include "storage/storage_defs.h"
+#include "test_util/test_harness.h"
+
+namespace terrier {
+
+struct BlockAllocatorTests : public TerrierTest {};
+
+// Blocks mapped from the kernel are aligned, distinct, and writable whatever the huge page and NUMA settings, and are
+// placed on the nodes the policy asks for when the kernel supports NUMA
+// NOLINTNEXTLINE
+TEST_F(BlockAllocatorTests, MappedBlocksTest) {
+  const uint32_t num_blocks = 9;
+  for (bool huge_pages : {false, true}) {
+    for (storage::NumaPolicy numa_policy :
+         {storage::NumaPolicy::NONE, storage::NumaPolicy::INTERLEAVE, storage::NumaPolicy::LOCAL}) {
+      // No reuse, so that releasing blocks gives chunks back to the kernel
+      storage::BlockStore block_store(num_blocks, 0, storage::BlockAllocator(huge_pages, numa_policy));
+      std::vector<storage::RawBlock *> blocks;
+      std::unordered_set<storage::RawBlock *> distinct;
+      for (uint32_t i = 0; i < num_blocks; i++) {
+        storage::RawBlock *block = block_store.Get();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % common::Constants::BLOCK_SIZE, 0);
+        if (numa_policy == storage::NumaPolicy::NONE)
+          EXPECT_EQ(block->numa_node_, storage::BlockAllocator::UNKNOWN_NUMA_NODE);
+        block->content_[0] = static_cast<byte>(i);
+        block->content_[sizeof(block->content_) - 1] = static_cast<byte>(i);
+        blocks.push_back(block);
+        distinct.insert(block);
+      }
+      EXPECT_EQ(distinct.size(), num_blocks);
+
+      for (uint32_t i = 0; i < num_blocks; i++) {
+        EXPECT_EQ(blocks[i]->content_[0], static_cast<byte>(i));
+        EXPECT_EQ(blocks[i]->content_[sizeof(blocks[i]->content_) - 1], static_cast<byte>(i));
+      }
+
+      // Release every other block first, so that chunks are half-used for a while
+      for (uint32_t i = 0; i < num_blocks; i += 2) block_store.Release(blocks[i]);
+      for (uint32_t i = 1; i < num_blocks; i += 2) block_store.Release(blocks[i]);
+    }
+  }
+}
+
+// Blocks from the plain allocator do not know their NUMA node
+// NOLINTNEXTLINE
+TEST_F(BlockAllocatorTests, PlainBlocksTest) {
+  storage::BlockStore block_store(1, 1);
+  storage::RawBlock *block = block_store.Get();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % common::Constants::BLOCK_SIZE, 0);
+  EXPECT_EQ(block->numa_node_, storage::BlockAllocator::UNKNOWN_NUMA_NODE);
+  block_store.Release(block);
+}
+
+}  // namespace terrier
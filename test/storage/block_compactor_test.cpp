@@ -1,5 +1,6 @@
 #include "storage/block_compactor.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -387,4 +388,100 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
   }
 }
 
+// This tests generates random single blocks, gathers them with their integer columns run-length encoded or bit-packed,
+// and verifies that the encoded columns decode to the values in the block. We only test single blocks because
+// encoding happens block at a time.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, IntegerEncodingTest) {
+  uint32_t repeat = 10;
+  for (uint32_t iteration = 0; iteration < repeat; iteration++) {
+    storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator_);
+    storage::TupleAccessStrategy accessor(layout);
+    // Technically, the block above is not "in" the table, but since we don't sequential scan that does not matter
+    storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                             storage::layout_version_t(0));
+    storage::RawBlock *block = block_store_.Get();
+    accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+
+    // Enable GC to cleanup transactions started by the block compactor
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_), true, DISABLED};
+    storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_);
+
+    // Alternate between the two encodings across columns
+    auto &arrow_metadata = accessor.GetArrowBlockMetadata(block);
+    for (storage::col_id_t col_id : layout.AllColumns()) {
+      arrow_metadata.GetColumnInfo(layout, col_id).Type() = (!col_id + iteration) % 2 == 0
+                                                                 ? storage::ArrowColumnType::RUN_LENGTH_ENCODED
+                                                                 : storage::ArrowColumnType::BIT_PACKED;
+    }
+
+    storage::BlockCompactor compactor;
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+
+    // Need to prune the version chain in order to make sure that the second pass succeeds
+    gc.PerformGarbageCollection();
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+    EXPECT_EQ(arrow_metadata.NumRecords(), tuples.size());
+
+    for (storage::col_id_t col_id : layout.AllColumns()) {
+      const storage::ArrowColumnInfo &col_info = arrow_metadata.GetColumnInfo(layout, col_id);
+      const storage::EncodedIntegerColumn &encoded = col_info.EncodedColumn();
+      if (col_info.Type() == storage::ArrowColumnType::RUN_LENGTH_ENCODED) {
+        // Runs cover the whole block, and consecutive runs have different values
+        ASSERT_GT(encoded.NumRuns(), 0);
+        EXPECT_EQ(encoded.RunEnds()[encoded.NumRuns() - 1], arrow_metadata.NumRecords());
+        for (uint32_t run = 1; run < encoded.NumRuns(); run++) {
+          EXPECT_LT(encoded.RunEnds()[run - 1], encoded.RunEnds()[run]);
+          EXPECT_NE(encoded.RunValues()[run - 1], encoded.RunValues()[run]);
+        }
+      }
+
+      uint32_t run = 0;
+      bool has_value = false;
+      int64_t min = 0, max = 0;
+      for (uint32_t i = 0; i < arrow_metadata.NumRecords(); i++) {
+        const byte *value = accessor.AccessWithNullCheck({block, i}, col_id);
+        if (col_info.Type() == storage::ArrowColumnType::RUN_LENGTH_ENCODED && i == encoded.RunEnds()[run]) run++;
+        // NULL slots can hold any value in the encoded column
+        if (value == nullptr) continue;
+        const int64_t expected = storage::StorageUtil::ReadInteger(value, layout.AttrSize(col_id));
+        min = has_value ? std::min(min, expected) : expected;
+        max = has_value ? std::max(max, expected) : expected;
+        has_value = true;
+        if (col_info.Type() == storage::ArrowColumnType::RUN_LENGTH_ENCODED) {
+          EXPECT_EQ(encoded.RunValues()[run], expected);
+        } else {
+          EXPECT_EQ(encoded.Unpack(i), expected);
+        }
+      }
+
+      // Once frozen, zone maps hold the exact range of the values
+      const storage::ColumnZoneMap &zone_map = arrow_metadata.GetZoneMap(layout, col_id);
+      EXPECT_EQ(zone_map.Empty(), !has_value);
+      if (has_value) {
+        EXPECT_EQ(zone_map.Min(), min);
+        EXPECT_EQ(zone_map.Max(), max);
+      }
+    }
+
+    for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();  // Second call to deallocate.
+    for (storage::col_id_t col_id : layout.AllColumns()) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+    block_store_.Release(block);
+  }
+}
+
 }  // namespace terrier
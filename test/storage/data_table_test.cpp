@@ -267,6 +267,39 @@ TEST_F(DataTableTests, SimpleVersionChain) {
   }
 }
 
+// Inserts a tuple into an empty DataTable and randomly updates it num_updates times. Then checks that the zone maps of
+// the hot block cover every non-null value of every version of the tuple. Repeats for num_iterations.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, ZoneMapsCoverVersions) {
+  const uint32_t num_iterations = 50;
+  const uint32_t num_updates = 10;
+  const uint16_t max_columns = 100;
+
+  for (uint32_t iteration = 0; iteration < num_iterations; ++iteration) {
+    RandomDataTableTestObject tested(&block_store_, max_columns, null_ratio_(generator_), &generator_);
+    transaction::timestamp_t timestamp(0);
+
+    storage::TupleSlot tuple = tested.InsertRandomTuple(timestamp++, &generator_, &buffer_pool_);
+    for (uint32_t i = 0; i < num_updates; ++i)
+      tested.RandomlyUpdateTuple(timestamp++, tuple, &generator_, &buffer_pool_);
+
+    const storage::BlockLayout &layout = tested.Layout();
+    const storage::ArrowBlockMetadata &metadata = tested.GetTable().GetArrowBlockMetadata(tuple.GetBlock());
+    for (uint32_t i = 0; i < num_updates + 1; i++) {
+      const storage::ProjectedRow *version = tested.GetReferenceVersionedTuple(tuple, transaction::timestamp_t(i));
+      for (uint16_t j = 0; j < version->NumColumns(); j++) {
+        const byte *value = version->AccessWithNullCheck(j);
+        if (value == nullptr) continue;
+        const storage::col_id_t col_id = version->ColumnIds()[j];
+        const int64_t integer = storage::StorageUtil::ReadInteger(value, layout.AttrSize(col_id));
+        const storage::ColumnZoneMap &zone_map = metadata.GetZoneMap(layout, col_id);
+        EXPECT_LE(zone_map.Min(), integer);
+        EXPECT_GE(zone_map.Max(), integer);
+      }
+    }
+  }
+}
+
 // Generates a random table layout and coin flip bias for an attribute being null, inserts 1 random tuple into an empty
 // DataTable. Then, randomly updates the tuple with a negative timestamp, representing an uncommitted transaction. Then
 // a second update attempts to change the tuple and should fail. Then, the first transaction's timestamp is updated to a
@@ -699,4 +699,158 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
     EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
   }
 }
+
+// Updates a tuple while an old reader is running, then checks that readers and writers cut off the versions that the
+// oldest running txn cannot see anymore, and that the GC still processes the txns whose versions were cut off
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, InlineVersionChainPruning) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto timestamp_manager = db_main->GetTransactionLayer()->GetTimestampManager();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+    storage::TupleAccessStrategy accessor(tested.Layout());
+
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+
+    // insert the tuple to be Updated later
+    auto *txn = txn_manager->BeginTransaction();
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple);
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Unlink and reclaim the Insert
+    EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+
+    auto version_ptr = [&] {
+      return *reinterpret_cast<storage::UndoRecord **>(
+          accessor.AccessWithoutNullCheck(slot, storage::VERSION_POINTER_COLUMN_ID));
+    };
+
+    auto *old_txn = txn_manager->BeginTransaction();
+
+    storage::ProjectedRow *update0 = tested.GenerateRandomUpdate(&generator_);
+    auto *txn0 = txn_manager->BeginTransaction();
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn0), slot, *update0));
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+    auto *update_tuple0 = tested.GenerateVersionFromUpdate(*update0, *insert_tuple);
+
+    storage::ProjectedRow *update1 = tested.GenerateRandomUpdate(&generator_);
+    auto *txn1 = txn_manager->BeginTransaction();
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn1), slot, *update1));
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+    auto *update_tuple1 = tested.GenerateVersionFromUpdate(*update1, *update_tuple0);
+
+    // old_txn can still see the insert, so nothing can be cut off
+    timestamp_manager->OldestTransactionStartTime();
+    auto *txn2 = txn_manager->BeginTransaction();
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn2, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, update_tuple1));
+    ASSERT_NE(version_ptr(), nullptr);
+    EXPECT_NE(version_ptr()->Next().load(), nullptr);
+
+    select_tuple = tested.SelectIntoBuffer(old_txn, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+
+    txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+    txn_manager->Commit(old_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The writer cuts off everything below its own version
+    timestamp_manager->OldestTransactionStartTime();
+    storage::ProjectedRow *update2 = tested.GenerateRandomUpdate(&generator_);
+    auto *txn3 = txn_manager->BeginTransaction();
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn3), slot, *update2));
+    ASSERT_NE(version_ptr(), nullptr);
+    EXPECT_EQ(version_ptr()->Next().load(), nullptr);
+    txn_manager->Commit(txn3, transaction::TransactionUtil::EmptyCallback, nullptr);
+    auto *update_tuple2 = tested.GenerateVersionFromUpdate(*update2, *update_tuple1);
+
+    // The reader cuts off the whole version chain
+    timestamp_manager->OldestTransactionStartTime();
+    auto *txn4 = txn_manager->BeginTransaction();
+    select_tuple = tested.SelectIntoBuffer(txn4, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, update_tuple2));
+    EXPECT_EQ(version_ptr(), nullptr);
+    txn_manager->Commit(txn4, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Unlink all 6 txns, then deallocate the 3 update txns
+    EXPECT_EQ(std::make_pair(0U, 6U), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(3U, 0U), gc->PerformGarbageCollection());
+  }
+}
+
+// Builds a version chain whose first record invisible to everyone is deeper than a writer looks, then checks that the
+// writer leaves it to the GC, and that the next writer cuts it once it is right below its own version
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, BoundedVersionChainPruning) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto timestamp_manager = db_main->GetTransactionLayer()->GetTimestampManager();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+    storage::TupleAccessStrategy accessor(tested.Layout());
+
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+
+    // insert the tuple to be Updated later
+    auto *txn = txn_manager->BeginTransaction();
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple);
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Unlink and reclaim the Insert
+    EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+
+    auto chain_length = [&] {
+      uint32_t length = 0;
+      for (auto *record = *reinterpret_cast<storage::UndoRecord **>(
+               accessor.AccessWithoutNullCheck(slot, storage::VERSION_POINTER_COLUMN_ID));
+           record != nullptr; record = record->Next().load()) {
+        length++;
+      }
+      return length;
+    };
+    auto update = [&] {
+      storage::ProjectedRow *redo = tested.GenerateRandomUpdate(&generator_);
+      auto *update_txn = txn_manager->BeginTransaction();
+      EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(update_txn), slot, *redo));
+      txn_manager->Commit(update_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    };
+
+    // old_txn keeps every version alive while the chain grows. mid_txn starts after the first update, so once old_txn
+    // is done, only that first version is invisible to everyone.
+    auto *old_txn = txn_manager->BeginTransaction();
+    timestamp_manager->OldestTransactionStartTime();
+    update();
+    auto *mid_txn = txn_manager->BeginTransaction();
+    const uint32_t num_visible = 5;
+    for (uint32_t i = 0; i < num_visible; i++) update();
+    EXPECT_EQ(num_visible + 1, chain_length());
+    txn_manager->Commit(old_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The writer gives up before it reaches the first update's version
+    timestamp_manager->OldestTransactionStartTime();
+    update();
+    EXPECT_EQ(num_visible + 2, chain_length());
+    txn_manager->Commit(mid_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // With mid_txn done, the version right below the next writer's is invisible to everyone
+    timestamp_manager->OldestTransactionStartTime();
+    update();
+    EXPECT_EQ(1, chain_length());
+
+    // Unlink all 10 txns, then deallocate the 8 update txns
+    EXPECT_EQ(std::make_pair(0U, 10U), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(8U, 0U), gc->PerformGarbageCollection());
+  }
+}
 }  // namespace terrier
@@ -9,11 +9,12 @@
 namespace terrier {
 class LargeGCTests : public TerrierTest {
  public:
-  void RunTest(const LargeDataTableTestConfiguration &config) {
+  void RunTest(const LargeDataTableTestConfiguration &config, const uint32_t gc_num_threads = 1) {
     for (uint32_t iteration = 0; iteration < config.NumIterations(); iteration++) {
       std::default_random_engine generator;
 
-      auto db_main = DBMain::Builder().SetUseGC(true).SetUseGCThread(true).Build();
+      auto db_main =
+          DBMain::Builder().SetUseGC(true).SetUseGCThread(true).SetGCNumThreads(gc_num_threads).Build();
       auto *const tested = new LargeDataTableTestObject(config, db_main->GetStorageLayer()->GetBlockStore().Get(),
                                                         db_main->GetTransactionLayer()->GetTransactionManager().Get(),
                                                         &generator, DISABLED);
@@ -51,6 +52,23 @@ TEST_F(LargeGCTests, MixedReadWriteWithGC) {
   RunTest(config);
 }
 
+// Same as above, with the work of the GC shared by several threads
+// NOLINTNEXTLINE
+TEST_F(LargeGCTests, MixedReadWriteWithParallelGC) {
+  auto config = LargeDataTableTestConfiguration::Builder()
+                    .SetNumIterations(10)
+                    .SetNumTxns(1000)
+                    .SetBatchSize(100)
+                    .SetNumConcurrentTxns(MultiThreadTestUtil::HardwareConcurrency())
+                    .SetUpdateSelectRatio({0.5, 0.5})
+                    .SetTxnLength(10)
+                    .SetInitialTableSize(1000)
+                    .SetMaxColumns(20)
+                    .SetVarlenAllowed(true)
+                    .Build();
+  RunTest(config, 4);
+}
+
 // Double the thread count to force more thread swapping and try to capture unexpected races
 // NOLINTNEXTLINE
 TEST_F(LargeGCTests, MixedReadWriteHighThreadWithGC) {
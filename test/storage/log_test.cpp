@@ -451,4 +451,50 @@ TEST_F(WriteAheadLoggingTests, ReadOnlyCallbackTest) {
   // DeferredAction
   db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
 }
+
+// Verify that a txn without synchronous commit reports its commit right away, and still gets its logs persisted
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, AsynchronousCommitTest) {
+  // Create SQLTable
+  auto col = catalog::Schema::Column(
+      "attribute", type::TypeId::INTEGER, false,
+      parser::ConstantValueExpression(type::TransientValueFactory::GetNull(type::TypeId::INTEGER)));
+  StorageTestUtil::ForceOid(&(col), catalog::col_oid_t(0));
+  auto table_schema = catalog::Schema(std::vector<catalog::Schema::Column>({col}));
+  auto *const sql_table = new storage::SqlTable(store_, table_schema);
+  auto tuple_initializer = sql_table->InitializerForProjectedRow({catalog::col_oid_t(0)});
+
+  // Initialize the txn, this txn will write a single tuple
+  auto *const txn = txn_manager_->BeginTransaction();
+  EXPECT_TRUE(txn->SynchronousCommit());
+  txn->SetSynchronousCommit(false);
+  auto *insert_redo = txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer);
+  *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = 1;
+  sql_table->Insert(common::ManagedPointer(txn), insert_redo);
+
+  // The callback has to be invoked before Commit returns, since it does not wait for the log manager
+  std::promise<bool> promise;
+  auto future = promise.get_future();
+  txn_manager_->Commit(txn, TestCommitCallback, &promise);
+  EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+  EXPECT_TRUE(future.get());
+
+  // Shut down log manager
+  log_manager_->PersistAndStop();
+
+  // Read records, look for the commit record
+  bool found_commit_record = false;
+  storage::BufferedLogReader in(LOG_FILE_NAME);
+  while (in.HasMore()) {
+    storage::LogRecord *log_record = ReadNextRecord(&in);
+    if (log_record->RecordType() == LogRecordType::COMMIT && log_record->TxnBegin() == txn->StartTime())
+      found_commit_record = true;
+    delete[] reinterpret_cast<byte *>(log_record);
+  }
+  EXPECT_TRUE(found_commit_record);
+
+  // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
+  // DeferredAction
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
+}
 }  // namespace terrier::storage
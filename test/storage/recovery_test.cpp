@@ -10,6 +10,7 @@
 #include "storage/garbage_collector_thread.h"
 #include "storage/index/index_builder.h"
 #include "storage/recovery/disk_log_provider.h"
+#include "storage/recovery/merged_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "storage/sql_table.h"
 #include "storage/write_ahead_log/log_manager.h"
@@ -29,6 +30,8 @@ namespace terrier::storage {
 class RecoveryTests : public TerrierTest {
  protected:
   std::default_random_engine generator_;
+  uint32_t num_log_streams_ = 1;
+  uint32_t num_recovery_threads_ = 1;
 
   // Original Components
   std::unique_ptr<DBMain> db_main_;
@@ -46,11 +49,13 @@ class RecoveryTests : public TerrierTest {
   common::ManagedPointer<common::DedicatedThreadRegistry> recovery_thread_registry_;
 
   void SetUp() override {
-    // Unlink log file incase one exists from previous test iteration
-    unlink(LOG_FILE_NAME);
+    // Unlink log files incase they exist from previous test iteration
+    for (uint32_t stream = 0; stream < num_log_streams_; stream++)
+      unlink(LogManager::StreamLogFilePath(LOG_FILE_NAME, stream).c_str());
 
     db_main_ = terrier::DBMain::Builder()
                    .SetLogFilePath(LOG_FILE_NAME)
+                   .SetNumLogStreams(num_log_streams_)
                    .SetUseLogging(true)
                    .SetUseGC(true)
                    .SetUseGCThread(true)
@@ -76,8 +81,18 @@ class RecoveryTests : public TerrierTest {
   }
 
   void TearDown() override {
-    // Delete log file
-    unlink(LOG_FILE_NAME);
+    // Delete log files
+    for (uint32_t stream = 0; stream < num_log_streams_; stream++)
+      unlink(LogManager::StreamLogFilePath(LOG_FILE_NAME, stream).c_str());
+  }
+
+  // Provides the logs of all the log streams
+  std::unique_ptr<AbstractLogProvider> LogProvider() const {
+    if (num_log_streams_ == 1) return std::make_unique<DiskLogProvider>(LOG_FILE_NAME);
+    std::vector<std::unique_ptr<AbstractLogProvider>> sources;
+    for (uint32_t stream = 0; stream < num_log_streams_; stream++)
+      sources.emplace_back(std::make_unique<DiskLogProvider>(LogManager::StreamLogFilePath(LOG_FILE_NAME, stream)));
+    return std::make_unique<MergedLogProvider>(std::move(sources));
   }
 
   catalog::IndexSchema DummyIndexSchema() {
@@ -179,7 +194,8 @@ class RecoveryTests : public TerrierTest {
                                      recovery_txn_manager_,
                                      recovery_deferred_action_manager_,
                                      recovery_thread_registry_,
-                                     recovery_block_store_};
+                                     recovery_block_store_,
+                                     num_recovery_threads_};
     recovery_manager.StartRecovery();
     recovery_manager.WaitForRecoveryToFinish();
   }
@@ -193,13 +209,14 @@ class RecoveryTests : public TerrierTest {
     ShutdownAndRestartSystem();
 
     // Instantiate recovery manager, and recover the tables.
-    DiskLogProvider log_provider{LOG_FILE_NAME};
-    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+    auto log_provider = LogProvider();
+    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(log_provider.get()),
                                      recovery_catalog_,
                                      recovery_txn_manager_,
                                      recovery_deferred_action_manager_,
                                      recovery_thread_registry_,
-                                     recovery_block_store_};
+                                     recovery_block_store_,
+                                     num_recovery_threads_};
     recovery_manager.StartRecovery();
     recovery_manager.WaitForRecoveryToFinish();
 
@@ -283,6 +300,57 @@ TEST_F(RecoveryTests, MultiDatabaseTest) {
   RecoveryTests::RunTest(config);
 }
 
+// Logs to multiple streams, each written to its own log file
+class MultipleLogStreamsRecoveryTests : public RecoveryTests {
+ protected:
+  void SetUp() override {
+    num_log_streams_ = 4;
+    RecoveryTests::SetUp();
+  }
+};
+
+// This test runs a concurrent workload whose transactions log to different streams. It then recovers the tables from
+// the merged streams, and verifies that the recovered tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(MultipleLogStreamsRecoveryTests, MultiDatabaseTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.5, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+}
+
+// Replays changes to user tables with multiple threads
+class ParallelRecoveryTests : public RecoveryTests {
+ protected:
+  void SetUp() override {
+    num_recovery_threads_ = 4;
+    RecoveryTests::SetUp();
+  }
+};
+
+// This test inserts, updates and deletes tuples in tables across multiple databases. It then recovers the tables with
+// the changes to every table replayed by one of the threads, and verifies that the recovered tables are equal to the
+// test tables.
+// NOLINTNEXTLINE
+TEST_F(ParallelRecoveryTests, MultiDatabaseTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(3)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.5, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+}
+
 // Tests that we correctly process records corresponding to a drop database command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropDatabaseTest) {
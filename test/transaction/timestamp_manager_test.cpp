@@ -0,0 +1,55 @@
+#include "transaction/timestamp_manager.h"
+
+#include <deque>
+
+#include "common/worker_pool.h"
+#include "storage/record_buffer.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace terrier {
+
+struct TimestampManagerTests : public TerrierTest {
+  storage::RecordBufferSegmentPool buffer_pool_{100000, 10000};
+};
+
+// Threads concurrently begin txns, keep a few of them running, and commit them in order. The oldest txn start time
+// must never be newer than a txn that is still running, and is the current time once every txn is done.
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, ConcurrentOldestTransactionTest) {
+  const uint32_t num_threads = MultiThreadTestUtil::HardwareConcurrency();
+  const uint32_t num_txns = 10000;
+  const uint32_t num_running = 4;
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), false, DISABLED};
+
+  auto workload = [&](uint32_t /*unused*/) {
+    std::deque<transaction::TransactionContext *> running;
+    for (uint32_t i = 0; i < num_txns; i++) {
+      running.push_back(txn_manager.BeginTransaction());
+      EXPECT_LE(timestamp_manager.OldestTransactionStartTime(), running.front()->StartTime());
+      if (running.size() == num_running) {
+        txn_manager.Commit(running.front(), transaction::TransactionUtil::EmptyCallback, nullptr);
+        delete running.front();
+        running.pop_front();
+      }
+    }
+    for (auto *txn : running) {
+      txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      delete txn;
+    }
+  };
+  common::WorkerPool thread_pool(num_threads, {});
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+
+  EXPECT_EQ(timestamp_manager.OldestTransactionStartTime(), timestamp_manager.CurrentTime());
+  EXPECT_EQ(timestamp_manager.CachedOldestTransactionStartTime(), timestamp_manager.CurrentTime());
+}
+
+}  // namespace terrier
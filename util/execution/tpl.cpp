@@ -30,6 +30,7 @@
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/llvm_engine.h"
 #include "execution/vm/module.h"
+#include "execution/vm/superinstructions.h"
 #include "execution/vm/vm.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -54,6 +55,9 @@ llvm::cl::opt<bool> print_ast("print-ast", llvm::cl::desc("Print the programs AS
                               llvm::cl::cat(tpl_options_category));
 llvm::cl::opt<bool> print_tbc("print-tbc", llvm::cl::desc("Print the generated TPL Bytecode"),
                               llvm::cl::cat(tpl_options_category));
+llvm::cl::opt<bool> print_hot_pairs("print-hot-pairs",
+                                    llvm::cl::desc("Print the most frequent bytecode pairs, weighted by loop nesting"),
+                                    llvm::cl::cat(tpl_options_category));
 llvm::cl::opt<std::string> output_name("output-name", llvm::cl::desc("Print the output name"),
                                        llvm::cl::init("schema10"), llvm::cl::cat(tpl_options_category));
 llvm::cl::opt<bool> is_sql("sql", llvm::cl::desc("Is the input a SQL query?"), llvm::cl::cat(tpl_options_category));
@@ -189,6 +193,16 @@ static void CompileAndRun(const std::string &source, const std::string &name = "
     EXECUTION_LOG_INFO("\n{}", ss.str());
   }
 
+  // Dump candidates for superinstructions
+  if (print_hot_pairs) {
+    static constexpr std::size_t K_NUM_PAIRS = 20;
+    const auto profile = vm::Superinstructions::ProfilePairs(*bytecode_module);
+    for (std::size_t i = 0; i < std::min(K_NUM_PAIRS, profile.size()); i++) {
+      EXECUTION_LOG_INFO("{:>16} {} -> {}", profile[i].weight_, vm::Bytecodes::ToString(profile[i].first_),
+                         vm::Bytecodes::ToString(profile[i].second_));
+    }
+  }
+
   auto module = std::make_unique<vm::Module>(std::move(bytecode_module));
 
   //